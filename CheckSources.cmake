@@ -1,28 +1,79 @@
 set(CLAZY_CHECKS_SRCS ${CLAZY_CHECKS_SRCS}
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/algorithm-callable-by-value.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/assert-with-side-effects.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/atomic-false-sharing.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/atomic-memory-order.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/busy-polling.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/constexpr-lookup-table.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/container-inside-loop.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/detaching-lambda-capture.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/detaching-member.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/double-lookup.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/emplace-candidates.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/endl-in-loop.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/erase-in-loop.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/findchild-in-loop.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/function-args-sink.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/gui-thread-blocking.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/heap-allocated-small-trivial-type.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/heterogeneous-lookup.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/hot-path-allocations.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/ifndef-define-typo.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/ineffective-move.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/inefficient-qlist.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/invoke-method-by-name.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/isempty-vs-count.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/keyed-lookup-in-loop.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/large-signal-arguments.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/linear-search-in-loop.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/lookup-key-allocations.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/loop-invariant-call.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/make-shared-candidates.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/missing-move.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/model-signals-in-loop.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/move-not-noexcept.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/qdatetime-elapsed.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/qdebug-in-loop.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/qhash-allocations.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/qhash-with-char-pointer-key.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/qimage-pixel-in-loop.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/qobject-in-loop.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/qproperty-container-getter.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/qproperty-type-mismatch.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/qrequiredresult-candidates.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/qstring-split-single-use.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/qstring-varargs.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/qstringview-parameter.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/qt-keywords.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/qt4-qstring-from-array.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/qvariant-allocations.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/qvariant-template-instantiation.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/qvariantmap-as-struct.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/raw-environment-function.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/regex-from-literal.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/repeated-string-conversion.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/reserve-candidates.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/shared-pointer-copies.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/signal-with-return-value.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/small-local-vector.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/startup-latency.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/std-function-overhead.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/string-concatenation-in-loop.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/struct-padding.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/task-capture-copy.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/thread-with-slots.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/tr-non-literal.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/unconnected-signal-payload.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/unneeded-cast.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/unneeded-local-copy.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/unordered-map-candidates.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/virtual-call-in-loop.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/manuallevel/wide-lock-scope.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/checks/level0/connect-by-name.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/checks/level0/connect-non-signal.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/checks/level0/connect-not-normalized.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/checks/level0/container-anti-pattern.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/checks/level0/discarded-result.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/checks/level0/empty-qstringliteral.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/checks/level0/fully-qualified-moc-types.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/checks/level0/lambda-in-connect.cpp
@@ -1,18 +1,34 @@
 set(CLAZY_LIB_SRC
   ${CMAKE_CURRENT_LIST_DIR}/src/AccessSpecifierManager.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/Baseline.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/checkbase.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/checkmanager.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/SuppressionManager.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/ContextUtils.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/FixItUtils.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/FixItExporter.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/FunctionHotness.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/HeaderCache.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/JsonlExporter.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/LineFilter.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/LoopUtils.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/MiniAstIndex.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/PerfCounters.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/PreProcessorVisitor.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/PreprocessorDispatcher.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/QtRegistry.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/QtUtils.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/RunStats.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/SarifExporter.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/StmtFacts.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/StmtIndex.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/StringUtils.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/TemplateUtils.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/TraversalStack.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/TypeUtils.cpp
   ${CMAKE_CURRENT_LIST_DIR}/src/Utils.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/WarningDeduplicator.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/WasteReport.cpp
 )
 
 set(CLAZY_CHECKS_SRCS
@@ -33,13 +49,46 @@ set(CLAZY_PLUGIN_SRCS # Sources for the plugin
   ${CLAZY_SHARED_SRCS}
 )
 
+set(CLAZY_TIDY_MODULE_SRCS # Sources for the clang-tidy module, see CLAZY_BUILD_CLANG_TIDY_MODULE
+  ${CLAZY_SHARED_SRCS}
+  ${CMAKE_CURRENT_LIST_DIR}/src/ClazyTidyModule.cpp
+)
+
 if (MSVC)
   set(CLAZY_STANDALONE_SRCS
     ${CLAZY_SHARED_SRCS}
+    ${CMAKE_CURRENT_LIST_DIR}/src/AsyncDiagnosticPrinter.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/CheckHistory.cpp
     ${CMAKE_CURRENT_LIST_DIR}/src/ClazyStandaloneMain.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/GlobalChecks.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/HeaderTranslationUnits.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/MemoryBudget.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/PrefetchFileSystem.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/ResultCache.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/RewrittenCompilations.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/RunJournal.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/StandaloneServer.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/StandaloneWatch.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/StandaloneWorker.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/TranslationUnitSample.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/UnityTranslationUnits.cpp
   )
 else()
   set(CLAZY_STANDALONE_SRCS
+    ${CMAKE_CURRENT_LIST_DIR}/src/AsyncDiagnosticPrinter.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/CheckHistory.cpp
     ${CMAKE_CURRENT_LIST_DIR}/src/ClazyStandaloneMain.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/GlobalChecks.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/HeaderTranslationUnits.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/MemoryBudget.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/PrefetchFileSystem.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/ResultCache.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/RewrittenCompilations.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/RunJournal.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/StandaloneServer.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/StandaloneWatch.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/StandaloneWorker.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/TranslationUnitSample.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/UnityTranslationUnits.cpp
   )
 endif()
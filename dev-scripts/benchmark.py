@@ -0,0 +1,292 @@
+#!/usr/bin/env python3
+
+# Measures clazy's own performance on a generated, Qt-heavy corpus, see stress_code.py.
+#
+# The corpus doesn't depend on the installed Qt: it uses a small fake Qt header, so results only change when
+# clazy changes. Each level and each check is run with clazy-standalone, reporting translation units per second,
+# the time spent in each check (from -print-stats) and the peak RSS.
+#
+# Pass --save-baseline to store the results, later runs compare against it and fail if anything got slower
+# than --threshold. Usually invoked via "make clazy-bench".
+#
+# Pass --perf-counters to also record the instructions, cycles, cache and branch misses of each check, on Linux.
+#
+# Pass --update-costs checks.json to refresh the "cost" tier of each check, used by CLAZY_CHECKS="level1,cheap".
+#
+# Pass --scaling KIND to instead run --scaling-checks on one kind of stress code at each of --scaling-counts, printing
+# how clazy's time grows with the size of the code. Fails if it grows faster than linearly, by more than --max-exponent.
+
+import sys, os, json, argparse, math, re, subprocess
+
+from stress_code import GENERATORS, generate_corpus
+
+# Bump when changing the corpus, so old baselines aren't compared against a different workload
+CORPUS_VERSION = 2
+
+def supported_checks(clazy_standalone):
+    output = subprocess.check_output([clazy_standalone, '-supported-checks-json'])
+    return json.loads(output.decode('utf-8'))['checks']
+
+
+_stats_row_re = re.compile(r'^    (\S+)\s+([0-9.]+)\s+[0-9.]+\s+[0-9]+\s+[0-9.]+\s+[0-9]+\s+[0-9.]+\s+[0-9.]+\s+[0-9]+\s+[0-9.]+$')
+
+
+def parse_check_times(stderr):
+    # Sums the total(ms) column of every -print-stats table, one per translation unit
+    times = {}
+    for line in stderr.splitlines():
+        match = _stats_row_re.match(line)
+        if match and match.group(1) != 'check':
+            times[match.group(1)] = times.get(match.group(1), 0.0) + float(match.group(2))
+    return times
+
+
+_counters_row_re = re.compile(r'^    (\S+)\s+([0-9]+)\s+([0-9]+)\s+[0-9.]+\s+([0-9]+)\s+([0-9]+)$')
+_counter_names = ['instructions', 'cycles', 'llc_misses', 'branch_misses']
+
+
+def parse_check_counters(stderr):
+    # Sums the rows of every -perf-counters table, one per translation unit
+    counters = {}
+    for line in stderr.splitlines():
+        match = _counters_row_re.match(line)
+        if match:
+            check_counters = counters.setdefault(match.group(1), dict.fromkeys(_counter_names, 0))
+            for i, name in enumerate(_counter_names):
+                check_counters[name] += int(match.group(i + 2))
+    return counters
+
+
+def run_once(clazy_standalone, checks, filenames, include_dir, perf_counters):
+    cmd = [clazy_standalone, '-checks=' + checks, '-perf-counters' if perf_counters else '-print-stats'] + filenames
+    cmd += ['--', '-std=c++14', '-fsyntax-only', '-Wno-unused-value', '-DQT_CORE_LIB', '-isystem', include_dir]
+
+    with open(os.devnull, 'w') as devnull:
+        proc = subprocess.Popen(cmd, stdout=devnull, stderr=subprocess.PIPE, universal_newlines=True)
+        start = os.times()[4]
+        stderr = proc.stderr.read()
+        _, status, rusage = os.wait4(proc.pid, 0)
+        seconds = os.times()[4] - start
+        proc.returncode = status # Already reaped by wait4()
+
+    if ' error: ' in stderr:
+        print('Error: the corpus failed to compile with checks ' + checks + ':\n' + stderr)
+        sys.exit(1)
+
+    # ru_maxrss is in KiB on Linux and in bytes on macOS
+    peak_rss_kb = rusage.ru_maxrss // 1024 if sys.platform == 'darwin' else rusage.ru_maxrss
+    return seconds, peak_rss_kb, parse_check_times(stderr), parse_check_counters(stderr)
+
+
+def run_configuration(clazy_standalone, checks, filenames, include_dir, repeat, perf_counters):
+    # The fastest of several runs is the least noisy, but any run can set the peak memory
+    best = None
+    for _ in range(repeat):
+        seconds, peak_rss_kb, check_times, check_counters = run_once(clazy_standalone, checks, filenames, include_dir, perf_counters)
+        if best is None or seconds < best['seconds']:
+            best = { 'seconds': seconds, 'check_times_ms': check_times, 'peak_rss_kb': best['peak_rss_kb'] if best else 0 }
+            if perf_counters:
+                best['check_counters'] = check_counters
+        best['peak_rss_kb'] = max(best['peak_rss_kb'], peak_rss_kb)
+
+    best['tus_per_second'] = len(filenames) / best['seconds'] if best['seconds'] > 0 else 0
+    return best
+
+
+def compare(results, baseline, threshold, min_ms):
+    regressions = []
+    for config in sorted(results.keys()):
+        if config not in baseline:
+            continue
+
+        new = results[config]
+        old = baseline[config]
+        if new['seconds'] > old['seconds'] * (1 + threshold) and (new['seconds'] - old['seconds']) * 1000 > min_ms:
+            regressions.append('%s: %.2fs -> %.2fs' % (config, old['seconds'], new['seconds']))
+        if new['peak_rss_kb'] > old['peak_rss_kb'] * (1 + threshold):
+            regressions.append('%s: peak RSS %d KiB -> %d KiB' % (config, old['peak_rss_kb'], new['peak_rss_kb']))
+
+        for check, ms in sorted(new['check_times_ms'].items()):
+            old_ms = old['check_times_ms'].get(check)
+            if old_ms is not None and ms > old_ms * (1 + threshold) and ms - old_ms > min_ms:
+                regressions.append('%s: %s %.2fms -> %.2fms' % (config, check, old_ms, ms))
+
+    return regressions
+
+
+def print_comparison(results, baseline):
+    # For measuring a gain, like the one of a CLAZY_PGO build
+    print('\n%-45s %10s %10s %8s' % ('configuration', 'baseline', 'seconds', 'change'))
+    for level in ('level0', 'level1', 'level2'):
+        if level in results and level in baseline and baseline[level]['seconds'] > 0:
+            old = baseline[level]['seconds']
+            new = results[level]['seconds']
+            print('%-45s %10.2f %10.2f %+7.1f%%' % (level, old, new, (new - old) * 100 / old))
+
+
+def print_results(results):
+    print('%-45s %10s %10s %14s' % ('configuration', 'seconds', 'TU/sec', 'peak RSS(KiB)'))
+    for config in sorted(results.keys()):
+        r = results[config]
+        print('%-45s %10.2f %10.2f %14d' % (config, r['seconds'], r['tus_per_second'], r['peak_rss_kb']))
+
+    for level in ('level0', 'level1', 'level2'):
+        if level not in results:
+            continue
+        print('\nTime per check with %s (ms, all translation units):' % level)
+        for check, ms in sorted(results[level]['check_times_ms'].items(), key=lambda kv: -kv[1]):
+            print('    %-41s %10.2f' % (check, ms))
+
+
+def run_scaling(args):
+    kind = args.scaling
+    try:
+        counts = sorted(set(int(c) for c in args.scaling_counts.split(',')))
+    except ValueError:
+        print('Error: invalid --scaling-counts ' + args.scaling_counts)
+        sys.exit(1)
+
+    # Parsing is clang's, so the time inside the checks is what tells whether clazy scales
+    rows = []
+    for count in counts:
+        filenames, include_dir = generate_corpus(os.path.join(args.work_dir, 'scaling', '%s-%d' % (kind, count)), { kind: count })
+        result = run_configuration(args.clazy_standalone, args.scaling_checks, filenames, include_dir, max(1, args.repeat), args.perf_counters)
+        rows.append((count, result['seconds'], sum(result['check_times_ms'].values()), result['check_times_ms']))
+
+    print('%-10s %10s %12s %10s' % (kind, 'seconds', 'checks(ms)', 'exponent'))
+    problems = []
+    previous = None
+    for count, seconds, checks_ms, _ in rows:
+        exponent = ''
+        if previous and previous[2] > 0 and checks_ms > 0:
+            # The slope on a log-log plot, 1 when the time grows linearly with the size of the code
+            value = math.log(checks_ms / previous[2]) / math.log(float(count) / previous[0])
+            exponent = '%.2f' % value
+            if value > args.max_exponent and checks_ms - previous[2] > args.min_ms:
+                problems.append('%s: %d -> %d units, %.2fms -> %.2fms, exponent %.2f' % (kind, previous[0], count, previous[2], checks_ms, value))
+        print('%-10d %10.2f %12.2f %10s' % (count, seconds, checks_ms, exponent))
+        previous = (count, seconds, checks_ms)
+
+    if args.scaling_csv:
+        checks = sorted(set(check for row in rows for check in row[3].keys()))
+        with open(args.scaling_csv, 'w') as f:
+            f.write(','.join(['count', 'seconds', 'checks_ms'] + checks) + '\n')
+            for count, seconds, checks_ms, check_times in rows:
+                f.write(','.join(['%d' % count, '%.4f' % seconds, '%.4f' % checks_ms] + ['%.4f' % check_times.get(c, 0.0) for c in checks]) + '\n')
+        print('\nScaling curve written to ' + args.scaling_csv)
+
+    if problems:
+        print('\nNon-linear scaling:')
+        for problem in problems:
+            print('    ' + problem)
+        sys.exit(1)
+
+    sys.exit(0)
+
+
+def cost_tier(result, check):
+    # Share of the check's own run spent inside the check, the rest is parsing and is paid anyway
+    total_ms = result['seconds'] * 1000
+    share = result['check_times_ms'].get(check, 0.0) / total_ms if total_ms > 0 else 0
+    if share < 0.01:
+        return 'cheap'
+    if share < 0.05:
+        return 'moderate'
+    return 'expensive'
+
+
+def update_costs(checks_json, results):
+    # Edits the text instead of dumping the json, to keep its formatting
+    with open(checks_json, 'r') as f:
+        contents = f.read()
+
+    for check in sorted(results.keys()):
+        if check.startswith('level'):
+            continue
+        pattern = re.compile(r'("name"\s*:\s*"' + re.escape(check) + r'"[^{}]*?"cost"\s*:\s*")(\w+)(")')
+        contents, count = pattern.subn(lambda m: m.group(1) + cost_tier(results[check], check) + m.group(3), contents, count=1)
+        if count == 0:
+            print('Warning: %s has no cost in %s' % (check, checks_json))
+
+    with open(checks_json, 'w') as f:
+        f.write(contents)
+
+
+parser = argparse.ArgumentParser(description='Benchmarks clazy-standalone on a generated Qt-heavy corpus.')
+parser.add_argument('--clazy-standalone', default=os.environ.get('CLAZYSTANDALONE_CXX', 'clazy-standalone'),
+                    help='The clazy-standalone binary to benchmark')
+parser.add_argument('--work-dir', default='clazy-bench', help='Where the corpus is generated')
+parser.add_argument('--baseline', default='', help='JSON file with previous results to compare against')
+parser.add_argument('--save-baseline', action='store_true', help='Write the results to the --baseline file instead of comparing')
+parser.add_argument('--threshold', type=float, default=0.10, help='Relative slowdown considered a regression, default 0.10')
+parser.add_argument('--min-ms', type=float, default=5.0, help='Ignore slowdowns smaller than this, in milliseconds. Default 5')
+parser.add_argument('--repeat', type=int, default=3, help='Runs per configuration, the fastest one is kept. Default 3')
+parser.add_argument('--no-individual-checks', action='store_true', help='Only benchmark the levels, not each check on its own')
+parser.add_argument('--configurations', default='',
+                    help='Comma separated levels or checks to benchmark, instead of the levels and each check. For example level2')
+parser.add_argument('--perf-counters', action='store_true',
+                    help='Also record the hardware performance counters of each check, Linux only')
+parser.add_argument('--update-costs', default='', metavar='CHECKS_JSON',
+                    help='Write the cost tier of each check, measured on its own, into the given checks.json')
+parser.add_argument('--scaling', default='', choices=[''] + sorted(GENERATORS.keys()),
+                    help='Measure how the time grows with the size of this kind of stress code, instead of benchmarking the corpus')
+parser.add_argument('--scaling-counts', default='250,500,1000,2000', help='The sizes of the --scaling runs, in units of the kind. Default 250,500,1000,2000')
+parser.add_argument('--scaling-checks', default='level1', help='The checks of the --scaling runs. Default level1')
+parser.add_argument('--scaling-csv', default='', help='Also write the --scaling results, with the time of each check, to this CSV file, for plotting')
+parser.add_argument('--max-exponent', type=float, default=1.3,
+                    help='With --scaling, fail if time grows faster than the size of the code to this power. Default 1.3')
+args = parser.parse_args()
+
+if args.scaling:
+    run_scaling(args)
+
+if args.update_costs and (args.no_individual_checks or args.configurations):
+    print('Error: --update-costs requires benchmarking each check on its own')
+    sys.exit(1)
+
+filenames, include_dir = generate_corpus(args.work_dir)
+
+if args.configurations:
+    configurations = args.configurations.split(',')
+else:
+    configurations = ['level0', 'level1', 'level2']
+    if not args.no_individual_checks:
+        configurations += sorted(check['name'] for check in supported_checks(args.clazy_standalone))
+
+results = {}
+for config in configurations:
+    results[config] = run_configuration(args.clazy_standalone, config, filenames, include_dir, max(1, args.repeat), args.perf_counters)
+
+print_results(results)
+
+if args.update_costs:
+    update_costs(args.update_costs, results)
+    print('\nCosts written to ' + args.update_costs + ', run dev-scripts/generate.py --generate')
+output = { 'corpus_version': CORPUS_VERSION, 'results': results }
+
+if args.save_baseline:
+    if not args.baseline:
+        print('Error: --save-baseline requires --baseline')
+        sys.exit(1)
+    with open(args.baseline, 'w') as f:
+        json.dump(output, f, indent=4, sort_keys=True)
+    print('\nBaseline written to ' + args.baseline)
+    sys.exit(0)
+
+if args.baseline and os.path.exists(args.baseline):
+    with open(args.baseline, 'r') as f:
+        baseline = json.load(f)
+
+    if baseline.get('corpus_version') != CORPUS_VERSION:
+        print('\nBaseline was generated with a different corpus, run with --save-baseline again')
+        sys.exit(1)
+
+    print_comparison(results, baseline['results'])
+    regressions = compare(results, baseline['results'], args.threshold, args.min_ms)
+    if regressions:
+        print('\nPerformance regressions against ' + args.baseline + ':')
+        for regression in regressions:
+            print('    ' + regression)
+        sys.exit(1)
+
+    print('\nNo regressions against ' + args.baseline)
@@ -0,0 +1,218 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+// Compares the dispatch of AST nodes to the checks, see dev-scripts/README. Doesn't need clang:
+//
+//     c++ -std=c++11 -O2 dev-scripts/dispatch_bench.cpp -o dispatch_bench && ./dispatch_bench
+//
+// Models the level1 checks with the node classes checks.json gives them, fed a stream of statements with the class
+// distribution of a Qt translation unit. Each check returns right away, as most do for most nodes, so the numbers are
+// an upper bound of what the dispatch itself costs. Three designs are timed:
+//  - table:           ClazyASTConsumer's, a vector of checks per class, calling the virtual VisitStmt()
+//  - switch:          a generated switch on the class, calling each enabled check non-virtually, defined out of line
+//                     as it would be in its own translation unit
+//  - switch-inlined:  the same, with the checks' bodies inlined, as only LTO or header-only checks would allow
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+enum StmtClass {
+    NoStmtClass, // So the unused slots of s_checkClasses match nothing
+    CallExprClass,
+    CXXMemberCallExprClass,
+    CXXOperatorCallExprClass,
+    CXXConstructExprClass,
+    CXXStaticCastExprClass,
+    ImplicitCastExprClass,
+    DeclStmtClass,
+    ReturnStmtClass,
+    CXXForRangeStmtClass,
+    LambdaExprClass,
+    DeclRefExprClass,
+    MemberExprClass,
+    IntegerLiteralClass,
+    StringLiteralClass,
+    BinaryOperatorClass,
+    CompoundStmtClass,
+    IfStmtClass,
+    ParenExprClass,
+    NumStmtClasses
+};
+
+struct Stmt
+{
+    StmtClass stmtClass;
+    uint32_t payload;
+};
+
+// The classes the level1 checks of checks.json visit, -1 for all of them
+constexpr int s_checkClasses[][3] = {
+    { -1 }, { -1 }, { CallExprClass }, { CXXStaticCastExprClass }, { LambdaExprClass }, { CallExprClass },
+    { CXXMemberCallExprClass }, { CXXMemberCallExprClass }, { CallExprClass }, { -1 }, { DeclStmtClass },
+    { CXXMemberCallExprClass }, { CXXConstructExprClass, CallExprClass }, { -1 }, { -1 }, { -1 },
+    { CallExprClass, CXXForRangeStmtClass }, { CXXOperatorCallExprClass, ImplicitCastExprClass }, { CallExprClass },
+    { -1 }, { CXXMemberCallExprClass }, { CXXMemberCallExprClass }, { CXXMemberCallExprClass }, { DeclStmtClass },
+    { -1 }, { CXXMemberCallExprClass }, { CXXConstructExprClass }, { CallExprClass }, { -1 }, { CallExprClass },
+    { -1 }, { CallExprClass }, { -1 }, { CXXMemberCallExprClass }, { -1 }, { CXXMemberCallExprClass }, { -1 },
+    { CallExprClass }, { CXXMemberCallExprClass }, { CXXConstructExprClass }, { -1 }, { CXXMemberCallExprClass },
+    { CXXForRangeStmtClass }, { ReturnStmtClass, DeclStmtClass }, { -1 }, { -1 }, { -1 }, { -1 }, { -1 },
+    { CXXMemberCallExprClass },
+};
+constexpr int s_numChecks = sizeof(s_checkClasses) / sizeof(s_checkClasses[0]);
+
+// Percentages of each class in a Qt translation unit's function bodies
+const int s_classWeights[NumStmtClasses] = { 0, 6, 8, 3, 5, 1, 14, 5, 2, 1, 1, 18, 9, 5, 3, 6, 4, 3, 6 };
+
+constexpr bool visits(int check, int stmtClass, int slot = 0)
+{
+    return slot < 3 && (s_checkClasses[check][slot] == -1 || s_checkClasses[check][slot] == stmtClass
+                        || visits(check, stmtClass, slot + 1));
+}
+
+uint64_t s_sink = 0;
+
+// table
+struct CheckBase
+{
+    explicit CheckBase(uint32_t id) : m_id(id) {}
+    virtual ~CheckBase() = default;
+    virtual void VisitStmt(const Stmt *stmt);
+    uint32_t m_id;
+};
+
+__attribute__((noinline)) void CheckBase::VisitStmt(const Stmt *stmt)
+{
+    if (stmt->payload == m_id) // Almost never, like the early returns of the checks
+        s_sink++;
+}
+
+// switch and switch-inlined
+template <int Id>
+struct StaticCheck
+{
+    __attribute__((noinline)) void visitOutOfLine(const Stmt *stmt)
+    {
+        if (stmt->payload == Id)
+            s_sink++;
+    }
+
+    void visitInline(const Stmt *stmt)
+    {
+        if (stmt->payload == Id)
+            s_sink++;
+    }
+};
+
+// Calls the checks before Id which visit Class
+template <int Class, int Id, bool Inline>
+struct Dispatcher
+{
+    static void dispatch(const bool *enabled, const Stmt *stmt)
+    {
+        Dispatcher<Class, Id - 1, Inline>::dispatch(enabled, stmt);
+        if (!visits(Id - 1, Class) || !enabled[Id - 1])
+            return;
+        StaticCheck<Id - 1> check;
+        if (Inline)
+            check.visitInline(stmt);
+        else
+            check.visitOutOfLine(stmt);
+    }
+};
+
+template <int Class, bool Inline>
+struct Dispatcher<Class, 0, Inline>
+{
+    static void dispatch(const bool *, const Stmt *) {}
+};
+
+template <bool Inline>
+void switchDispatch(const bool *enabled, const Stmt *stmt)
+{
+    switch (stmt->stmtClass) {
+#define CASE(CLASS) case CLASS: Dispatcher<CLASS, s_numChecks, Inline>::dispatch(enabled, stmt); break;
+    CASE(CallExprClass) CASE(CXXMemberCallExprClass) CASE(CXXOperatorCallExprClass) CASE(CXXConstructExprClass)
+    CASE(CXXStaticCastExprClass) CASE(ImplicitCastExprClass) CASE(DeclStmtClass) CASE(ReturnStmtClass)
+    CASE(CXXForRangeStmtClass) CASE(LambdaExprClass) CASE(DeclRefExprClass) CASE(MemberExprClass)
+    CASE(IntegerLiteralClass) CASE(StringLiteralClass) CASE(BinaryOperatorClass) CASE(CompoundStmtClass)
+    CASE(IfStmtClass) CASE(ParenExprClass)
+#undef CASE
+    default:
+        break;
+    }
+}
+
+template <typename F>
+double nsPerNode(const std::vector<Stmt> &stmts, F f)
+{
+    double best = 1e99;
+    for (int run = 0; run < 7; ++run) {
+        const auto start = std::chrono::steady_clock::now();
+        for (const Stmt &stmt : stmts)
+            f(&stmt);
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count() / stmts.size());
+    }
+    return best;
+}
+
+}
+
+int main()
+{
+    std::mt19937 random(42);
+    std::discrete_distribution<int> classes(std::begin(s_classWeights), std::end(s_classWeights));
+    std::vector<Stmt> stmts(4000000);
+    for (Stmt &stmt : stmts)
+        stmt = { StmtClass(classes(random)), uint32_t(random() % 1000 + 1000) };
+
+    std::vector<std::unique_ptr<CheckBase>> checks;
+    std::vector<std::vector<CheckBase *>> table(NumStmtClasses);
+    bool enabled[s_numChecks];
+    for (int i = 0; i < s_numChecks; ++i) {
+        checks.emplace_back(new CheckBase(i));
+        enabled[i] = true; // All of level1, but only known at runtime
+        for (int c = 0; c < NumStmtClasses; ++c) {
+            if (visits(i, c))
+                table[c].push_back(checks.back().get());
+        }
+    }
+
+    const double tableTime = nsPerNode(stmts, [&table](const Stmt *stmt) {
+        for (CheckBase *check : table[stmt->stmtClass])
+            check->VisitStmt(stmt);
+    });
+    const double switchTime = nsPerNode(stmts, [&enabled](const Stmt *stmt) { switchDispatch<false>(enabled, stmt); });
+    const double inlinedTime = nsPerNode(stmts, [&enabled](const Stmt *stmt) { switchDispatch<true>(enabled, stmt); });
+
+    printf("%d checks, %zu statements, sink %llu\n", s_numChecks, stmts.size(), (unsigned long long)s_sink);
+    printf("table:          %6.2f ns/node\n", tableTime);
+    printf("switch:         %6.2f ns/node (%+.0f%%)\n", switchTime, (switchTime / tableTime - 1) * 100);
+    printf("switch-inlined: %6.2f ns/node (%+.0f%%)\n", inlinedTime, (inlinedTime / tableTime - 1) * 100);
+    return 0;
+}
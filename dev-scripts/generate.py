@@ -31,6 +31,7 @@ CHECKS_FILENAME = 'checks.json'
 _checks = []
 _specified_check_names = []
 _available_categories = []
+_available_costs = ['cheap', 'moderate', 'expensive'] # See dev-scripts/benchmark.py --update-costs
 
 def checkSortKey(check):
     return str(check.level) + check.name
@@ -43,6 +44,9 @@ def level_num_to_enum(n):
 
     return 'CheckLevelUndefined'
 
+def cost_to_enum(cost):
+    return 'RegisteredCheck::Cost_' + cost.capitalize()
+
 def level_num_to_name(n):
     if n == -1:
         return 'Manual Level'
@@ -93,11 +97,17 @@ class Check:
         self.name = ""
         self.class_name = ""
         self.level = 0
+        self.cost = "moderate"
         self.categories = []
         self.minimum_qt_version = 40000 # Qt 4.0.0
         self.fixits = []
         self.visits_stmts = False
         self.visits_decls = False
+        self.visits_stmt_classes = []
+        self.visits_decl_classes = []
+        self.needs_parent_map = False
+        self.ignores_function_bodies = False
+        self.cache_safe = False
         self.ifndef = ""
 
     def include(self): # Returns for example: "returning-void-expression.h"
@@ -219,6 +229,12 @@ def load_json(filename):
         if _specified_check_names and c.name not in _specified_check_names:
             continue
 
+        if 'cost' in check:
+            c.cost = check['cost']
+            if c.cost not in _available_costs:
+                print('Unknown cost %s for %s' % (c.cost, c.name))
+                return False
+
         if 'class_name' in check:
             c.class_name = check['class_name']
 
@@ -234,6 +250,23 @@ def load_json(filename):
         if 'visits_decls' in check:
             c.visits_decls = check['visits_decls']
 
+        if 'visits_stmt_classes' in check:
+            c.visits_stmt_classes = check['visits_stmt_classes']
+            c.visits_stmts = True
+
+        if 'visits_decl_classes' in check:
+            c.visits_decl_classes = check['visits_decl_classes']
+            c.visits_decls = True
+
+        if 'needs_parent_map' in check:
+            c.needs_parent_map = check['needs_parent_map']
+
+        if 'ignores_function_bodies' in check:
+            c.ignores_function_bodies = check['ignores_function_bodies']
+
+        if 'cache_safe' in check:
+            c.cache_safe = check['cache_safe']
+
         if 'fixits' in check:
             for fixit in check['fixits']:
                 if 'name' not in fixit:
@@ -249,6 +282,9 @@ def load_json(filename):
     _checks = sorted(_checks, key=checkSortKey)
     return True
 
+def cpp_string_list(strings):
+    return '{' + ', '.join('"' + s + '"' for s in strings) + '}'
+
 def print_checks(checks):
     for c in checks:
         print(c.name + " " + str(c.level) + " " + str(c.categories))
@@ -261,10 +297,11 @@ def generate_register_checks(checks):
     text += \
 """
 template <typename T>
-RegisteredCheck check(const char *name, CheckLevel level, RegisteredCheck::Options options = RegisteredCheck::Option_None)
+RegisteredCheck check(const char *name, CheckLevel level, RegisteredCheck::Cost cost, RegisteredCheck::Options options = RegisteredCheck::Option_None,
+                      const std::vector<std::string> &stmtClasses = {}, const std::vector<std::string> &declClasses = {})
 {
     auto factoryFuntion = [name](ClazyContext *context){ return new T(name, context); };
-    return RegisteredCheck{name, level, factoryFuntion, options};
+    return RegisteredCheck{name, level, cost, factoryFuntion, options, stmtClasses, declClasses};
 }
 
 void CheckManager::registerChecks()
@@ -280,13 +317,26 @@ void CheckManager::registerChecks()
             qt4flag += " | RegisteredCheck::Option_VisitsStmts"
         if c.visits_decls:
             qt4flag += " | RegisteredCheck::Option_VisitsDecls"
+        if c.needs_parent_map:
+            qt4flag += " | RegisteredCheck::Option_NeedsParentMap"
+        if c.ignores_function_bodies:
+            qt4flag += " | RegisteredCheck::Option_IgnoresFunctionBodies"
+        if c.cache_safe:
+            qt4flag += " | RegisteredCheck::Option_CacheSafe"
+        if 'performance' in c.categories:
+            qt4flag += " | RegisteredCheck::Option_Performance"
 
         qt4flag = qt4flag.replace("RegisteredCheck::Option_None |", "")
 
         if c.ifndef:
             text += "#ifndef " + c.ifndef + "\n"
 
-        text += '    registerCheck(check<%s>("%s", %s, %s));\n' % (c.get_class_name(), c.name, level_num_to_enum(c.level), qt4flag)
+        if c.visits_decl_classes:
+            qt4flag += ", " + cpp_string_list(c.visits_stmt_classes) + ", " + cpp_string_list(c.visits_decl_classes)
+        elif c.visits_stmt_classes:
+            qt4flag += ", " + cpp_string_list(c.visits_stmt_classes)
+
+        text += '    registerCheck(check<%s>("%s", %s, %s, %s));\n' % (c.get_class_name(), c.name, level_num_to_enum(c.level), cost_to_enum(c.cost), qt4flag)
 
         fixitID = 1
         for fixit in c.fixits:
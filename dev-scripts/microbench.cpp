@@ -0,0 +1,344 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+// Microbenchmarks of the helpers the checks share, see dev-scripts/README.
+//
+// Each snippet is parsed once per size, then each helper is called in a loop on it, doubling the number of calls until a
+// batch takes -min-time. Unlike benchmark.py, which times whole checks, this isolates a helper, so optimizing it can be
+// shown with before and after numbers: run with -save=before.txt, change the helper, then run with -baseline=before.txt.
+
+#include "ClazyContext.h"
+#include "FixItUtils.h"
+#include "HierarchyUtils.h"
+#include "QtUtils.h"
+#include "SourceCompatibilityHelpers.h"
+#include "StmtBodyRange.h"
+#include "StmtIndex.h"
+#include "TypeUtils.h"
+#include "Utils.h"
+
+#include <clang/AST/ASTConsumer.h>
+#include <clang/AST/ASTContext.h>
+#include <clang/AST/Decl.h>
+#include <clang/AST/Expr.h>
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Frontend/FrontendAction.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Format.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+using namespace clang;
+using namespace llvm;
+
+static cl::opt<std::string> s_filter("filter", cl::desc("Only run the benchmarks whose name contains this"), cl::init(""));
+static cl::opt<double> s_minTime("min-time", cl::desc("Seconds each benchmark runs for at least. Default 0.2."), cl::init(0.2));
+static cl::opt<std::string> s_save("save", cl::desc(R"(Write one "<ns per call> <benchmark>" line per benchmark to this file)"), cl::init(""));
+static cl::opt<std::string> s_baseline("baseline", cl::desc("File written by -save before a change, to print how much each benchmark changed"),
+                                       cl::init(""));
+
+static const unsigned int s_sizes[] = { 10, 100, 1000 };
+
+static volatile size_t s_sink = 0; // Results are added to it, so the calls aren't optimized out
+
+struct Result {
+    std::string name; // "<helper>/<size>"
+    double nanoseconds; // Per call
+    uint64_t calls;
+};
+
+// size statements calling functions in body(), and size functions taking parameters of the kinds
+// classifyQualType() tells apart
+static std::string snippet(unsigned int size)
+{
+    std::string code = R"(
+namespace std { template <typename T> class vector { T *b, *e, *c; public: vector(); vector(const vector &); ~vector(); }; }
+class QString { void *d; public: QString(); QString(const QString &); ~QString(); int size() const; };
+struct Big { char data[64]; };
+struct Small { int a; int b; };
+void byValue(int);
+void byRef(int &);
+void byPtr(int *);
+)";
+
+    for (unsigned int i = 0; i < size; ++i) {
+        const std::string n = std::to_string(i);
+        code += "void f" + n + "(QString s, const QString &r, Big b, Small m, std::vector<int> v, int &i) {}\n";
+    }
+
+    // w is only passed by value, so searching for it by reference or pointer has to walk everything
+    code += "void body()\n{\n    int v = 0;\n    int w = 0;\n";
+    for (unsigned int i = 0; i < size; ++i) {
+        const std::string n = std::to_string(i);
+        code += "    byValue(w + " + n + ");\n    if (v > " + n + ")\n        byRef(v);\n";
+    }
+    code += "    byPtr(&v);\n}\n";
+
+    return code;
+}
+
+template <typename T>
+static T *findDecl(ASTContext &ctx, StringRef name)
+{
+    for (Decl *decl : ctx.getTranslationUnitDecl()->decls()) {
+        auto named = dyn_cast<T>(decl);
+        if (named && named->getName() == name)
+            return named;
+    }
+
+    return nullptr;
+}
+
+static void measure(const std::string &name, const std::function<size_t()> &op, std::vector<Result> &results)
+{
+    if (!s_filter.getValue().empty() && name.find(s_filter.getValue()) == std::string::npos)
+        return;
+
+    uint64_t calls = 1;
+    for (;;) {
+        const auto start = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < calls; ++i)
+            s_sink += op();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (seconds >= s_minTime.getValue() || calls >= (1ULL << 32)) {
+            results.push_back({ name, seconds * 1e9 / calls, calls });
+            return;
+        }
+        calls *= 2;
+    }
+}
+
+static void runBenchmarks(const CompilerInstance &ci, ASTContext &ctx, unsigned int size, std::vector<Result> &results)
+{
+    FunctionDecl *bodyFunc = findDecl<FunctionDecl>(ctx, "body");
+    Stmt *body = bodyFunc ? bodyFunc->getBody() : nullptr;
+    if (!body) {
+        llvm::errs() << "clazy-microbench: The snippet didn't parse\n";
+        return;
+    }
+
+    VarDecl *w = nullptr;
+    for (DeclStmt *declStmt : clazy::getStatements<DeclStmt>(body)) {
+        auto var = declStmt->isSingleDecl() ? dyn_cast<VarDecl>(declStmt->getSingleDecl()) : nullptr;
+        if (var && var->getName() == "w")
+            w = var;
+    }
+
+    std::vector<ParmVarDecl *> params;
+    for (unsigned int i = 0; i < size; ++i) {
+        if (FunctionDecl *func = findDecl<FunctionDecl>(ctx, "f" + std::to_string(i)))
+            params.insert(params.end(), func->param_begin(), func->param_end());
+    }
+
+    const std::vector<CallExpr *> calls = clazy::getStatements<CallExpr>(body);
+    const std::string suffix = "/" + std::to_string(size);
+    ClazyContext context(ci, /*headerFilter=*/ "", /*ignoreDirs=*/ "", /*exportFixesFilename=*/ "", /*translationUnitPaths=*/ {});
+
+    measure("getStatements<CallExpr>" + suffix, [body] {
+        return clazy::getStatements<CallExpr>(body).size();
+    }, results);
+
+    measure("isPassedToFunction" + suffix, [body, w] {
+        return size_t(Utils::isPassedToFunction(StmtBodyRange(body), w, /*byRefOrPtrOnly=*/ true));
+    }, results);
+
+    // What checks get from ClazyContext::functionStmtIndex(), includes building it, as it's built once per function
+    measure("isPassedToFunction+StmtIndex" + suffix, [body, w] {
+        const StmtIndex index(body);
+        return size_t(Utils::isPassedToFunction(StmtBodyRange(body, nullptr, {}, &index), w, /*byRefOrPtrOnly=*/ true));
+    }, results);
+
+    measure("classifyQualType/cold" + suffix, [&context, &params] {
+        context.qualTypeClassifications.clear();
+        size_t numBig = 0;
+        for (ParmVarDecl *param : params) {
+            clazy::QualTypeClassification classification;
+            if (clazy::classifyQualType(&context, param->getType(), param, classification))
+                numBig += classification.isBig;
+        }
+        return numBig;
+    }, results);
+
+    measure("classifyQualType/cached" + suffix, [&context, &params] {
+        size_t numBig = 0;
+        for (ParmVarDecl *param : params) {
+            clazy::QualTypeClassification classification;
+            if (clazy::classifyQualType(&context, param->getType(), param, classification))
+                numBig += classification.isBig;
+        }
+        return numBig;
+    }, results);
+
+    measure("detachingMethods" + suffix, [&calls] {
+        static const char *const classNames[] = { "QList", "QVector", "QMap", "QHash", "QString", "QByteArray", "Foo" };
+        size_t found = 0;
+        for (size_t i = 0; i < calls.size(); ++i)
+            found += clazy::detachingMethods().count(classNames[i % (sizeof(classNames) / sizeof(classNames[0]))]);
+
+        return found;
+    }, results);
+
+    // cold forgets the memoized tokens first, like at the start of each translation unit
+    for (const bool cold : { true, false }) {
+        const std::string kind = cold ? "/cold" : "/cached";
+        measure("locForEndOfToken" + kind + suffix, [&ctx, &calls, cold] {
+            if (cold)
+                clazy::clearTokenCache();
+            size_t valid = 0;
+            for (CallExpr *call : calls)
+                valid += clazy::locForEndOfToken(&ctx, clazy::getLocStart(call)).isValid();
+            return valid;
+        }, results);
+
+        measure("locForNextToken" + kind + suffix, [&ctx, &calls, cold] {
+            if (cold)
+                clazy::clearTokenCache();
+            size_t valid = 0;
+            for (CallExpr *call : calls)
+                valid += clazy::locForNextToken(&ctx, clazy::getLocStart(call), tok::semi).isValid();
+            return valid;
+        }, results);
+    }
+}
+
+class MicroBenchConsumer : public ASTConsumer
+{
+public:
+    MicroBenchConsumer(const CompilerInstance &ci, unsigned int size, std::vector<Result> &results)
+        : m_ci(ci)
+        , m_size(size)
+        , m_results(results)
+    {
+    }
+
+    void HandleTranslationUnit(ASTContext &ctx) override
+    {
+        runBenchmarks(m_ci, ctx, m_size, m_results);
+    }
+
+private:
+    const CompilerInstance &m_ci;
+    const unsigned int m_size;
+    std::vector<Result> &m_results;
+};
+
+class MicroBenchAction : public ASTFrontendAction
+{
+public:
+    MicroBenchAction(unsigned int size, std::vector<Result> &results)
+        : m_size(size)
+        , m_results(results)
+    {
+    }
+
+protected:
+    std::unique_ptr<ASTConsumer> CreateASTConsumer(CompilerInstance &ci, StringRef) override
+    {
+        return std::unique_ptr<ASTConsumer>(new MicroBenchConsumer(ci, m_size, m_results));
+    }
+
+private:
+    const unsigned int m_size;
+    std::vector<Result> &m_results;
+};
+
+static std::unordered_map<std::string, double> readBaseline(const std::string &filename)
+{
+    std::unordered_map<std::string, double> baseline;
+    auto buffer = llvm::MemoryBuffer::getFile(filename);
+    if (!buffer) {
+        llvm::errs() << "clazy-microbench: Failed to read " << filename << "\n";
+        return baseline;
+    }
+
+    llvm::SmallVector<StringRef, 64> lines;
+    (*buffer)->getBuffer().split(lines, '\n', -1, /*KeepEmpty=*/ false);
+    for (StringRef line : lines) {
+        StringRef nsStr, name;
+        std::tie(nsStr, name) = line.trim().split(' ');
+        double ns = 0;
+        if (!nsStr.getAsDouble(ns))
+            baseline[name.trim().str()] = ns;
+    }
+
+    return baseline;
+}
+
+int main(int argc, const char **argv)
+{
+    cl::ParseCommandLineOptions(argc, argv, "Microbenchmarks of the helpers shared by clazy's checks\n");
+
+    std::vector<Result> results;
+    for (unsigned int size : s_sizes) {
+        const std::vector<std::string> args = { "-std=c++14", "-fsyntax-only" };
+        auto action = new MicroBenchAction(size, results);
+#if LLVM_VERSION_MAJOR >= 10
+        const bool ok = tooling::runToolOnCodeWithArgs(std::unique_ptr<FrontendAction>(action), snippet(size), args, "microbench.cpp");
+#else
+        const bool ok = tooling::runToolOnCodeWithArgs(action, snippet(size), args, "microbench.cpp");
+#endif
+        if (!ok) {
+            llvm::errs() << "clazy-microbench: Failed to parse the snippet of size " << size << "\n";
+            return 1;
+        }
+    }
+
+    const std::unordered_map<std::string, double> baseline = s_baseline.getValue().empty() ? std::unordered_map<std::string, double>()
+                                                                                           : readBaseline(s_baseline.getValue());
+
+    llvm::outs() << llvm::format("%-40s %14s %12s", "benchmark", "ns/call", "calls") << (baseline.empty() ? "\n" : "       change\n");
+    for (const Result &result : results) {
+        llvm::outs() << llvm::format("%-40s %14.1f %12llu", result.name.c_str(), result.nanoseconds,
+                                     static_cast<unsigned long long>(result.calls));
+        auto it = baseline.find(result.name);
+        if (it != baseline.end() && it->second > 0)
+            llvm::outs() << llvm::format(" %+11.1f%%", (result.nanoseconds / it->second - 1) * 100);
+        llvm::outs() << "\n";
+    }
+
+    if (!s_save.getValue().empty()) {
+        std::error_code ec;
+        llvm::raw_fd_ostream os(s_save.getValue(), ec, llvm::sys::fs::F_None);
+        if (ec) {
+            llvm::errs() << "clazy-microbench: Failed to write " << s_save.getValue() << "\n";
+            return 1;
+        }
+
+        for (const Result &result : results)
+            os << llvm::format("%.1f", result.nanoseconds) << ' ' << result.name << '\n';
+    }
+
+    return 0;
+}
@@ -0,0 +1,622 @@
+#!/usr/bin/env python3
+
+# Generates C++ sources stressing specific parts of clazy, at a given scale, for benchmarking it.
+#
+# Each kind of source targets a code path: QObject hierarchies for the AccessSpecifierManager and the signal/slot
+# checks, macros for the preprocessor callbacks, huge macro expansions for the deduplication of warnings in macro
+# arguments, templates, long functions and nested loops for the loop and container checks, and literal-heavy UI code
+# for qstring-allocations. The sources only include a small fake Qt header, so they don't depend on the installed Qt.
+#
+# Used by benchmark.py, also on its own, for example to profile clazy on a single kind of code:
+#     stress_code.py out-dir --kind qobject_hierarchy=5000
+
+import os, argparse
+
+FAKE_QT_HEADER = r"""
+#ifndef FAKE_QT_H
+#define FAKE_QT_H
+
+#define QT_VERSION_MAJOR 5
+#define QT_VERSION_MINOR 15
+#define QT_VERSION_PATCH 2
+#define QT_VERSION 0x050f02
+#define QT_BEGIN_NAMESPACE
+#define QT_END_NAMESPACE
+
+#define Q_OBJECT \
+public: \
+    static const QMetaObject staticMetaObject; \
+    virtual const QMetaObject *metaObject() const; \
+    virtual void *qt_metacast(const char *); \
+    virtual int qt_metacall(QMetaObject::Call, int, void **); \
+private:
+#define Q_GADGET \
+public: \
+    static const QMetaObject staticMetaObject; \
+private:
+#define signals public
+#define slots
+#define Q_SIGNALS public
+#define Q_SLOTS
+#define Q_SIGNAL
+#define Q_SLOT
+#define Q_INVOKABLE
+#define emit
+#define Q_EMIT
+#define Q_PROPERTY(...)
+#define Q_ENUMS(x)
+#define Q_ENUM(x)
+#define SIGNAL(a) "2"#a
+#define SLOT(a) "1"#a
+#define QStringLiteral(str) QString(str)
+#define Q_OS_LINUX
+
+typedef decltype(sizeof(0)) size_t;
+
+QT_BEGIN_NAMESPACE
+
+struct QMetaObject { enum Call { InvokeMetaMethod, ReadProperty, WriteProperty }; };
+
+class QLatin1String
+{
+public:
+    explicit QLatin1String(const char *s) : m_data(s) {}
+    const char *data() const { return m_data; }
+private:
+    const char *m_data;
+};
+
+class QChar
+{
+public:
+    QChar(char c = 0) : m_c(c) {}
+    bool isSpace() const;
+private:
+    char m_c;
+};
+
+class QString
+{
+public:
+    QString();
+    QString(const char *);
+    QString(QLatin1String);
+    QString(const QString &);
+    ~QString();
+    QString &operator=(const QString &);
+    QString &operator+=(const QString &);
+    QString arg(const QString &) const;
+    QString arg(int) const;
+    QString mid(int, int = -1) const;
+    QString left(int) const;
+    QString toLower() const;
+    QString trimmed() const;
+    QString &append(const QString &);
+    bool isEmpty() const;
+    bool startsWith(const QString &) const;
+    bool operator==(const QString &) const;
+    int size() const;
+    int count() const;
+    int indexOf(const QString &) const;
+    QChar at(int) const;
+    static QString number(int);
+    static QString fromLatin1(const char *);
+};
+QString operator+(const QString &, const QString &);
+QString operator+(const QString &, const char *);
+
+template <typename T>
+class QList
+{
+public:
+    QList();
+    QList(const QList &);
+    ~QList();
+    QList &operator=(const QList &);
+    typedef T *iterator;
+    typedef const T *const_iterator;
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+    void append(const T &);
+    void push_back(const T &);
+    void reserve(int);
+    void clear();
+    int size() const;
+    int count() const;
+    bool isEmpty() const;
+    bool contains(const T &) const;
+    const T &at(int) const;
+    T &operator[](int);
+    const T &operator[](int) const;
+    const T &first() const;
+    const T &last() const;
+};
+
+template <typename T>
+class QVector
+{
+public:
+    QVector();
+    QVector(const QVector &);
+    ~QVector();
+    QVector &operator=(const QVector &);
+    typedef T *iterator;
+    typedef const T *const_iterator;
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    void append(const T &);
+    void push_back(const T &);
+    void reserve(int);
+    int size() const;
+    int count() const;
+    bool isEmpty() const;
+    const T &at(int) const;
+    T &operator[](int);
+    const T &operator[](int) const;
+};
+
+template <typename K, typename V>
+class QMap
+{
+public:
+    QMap();
+    QMap(const QMap &);
+    ~QMap();
+    QMap &operator=(const QMap &);
+    typedef V *iterator;
+    typedef const V *const_iterator;
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    QList<K> keys() const;
+    QList<V> values() const;
+    V value(const K &) const;
+    V &operator[](const K &);
+    void insert(const K &, const V &);
+    bool contains(const K &) const;
+    int size() const;
+    int count() const;
+    bool isEmpty() const;
+};
+
+template <typename K, typename V>
+class QHash
+{
+public:
+    QHash();
+    QHash(const QHash &);
+    ~QHash();
+    QList<K> keys() const;
+    QList<V> values() const;
+    V value(const K &) const;
+    V &operator[](const K &);
+    void insert(const K &, const V &);
+    bool contains(const K &) const;
+    int size() const;
+    bool isEmpty() const;
+};
+
+typedef QList<QString> QStringList;
+
+class QEvent
+{
+public:
+    enum Type { None, Timer, ChildAdded, ChildRemoved };
+    Type type() const;
+};
+
+class QObject
+{
+    Q_OBJECT
+public:
+    explicit QObject(QObject *parent = nullptr);
+    virtual ~QObject();
+    virtual bool event(QEvent *);
+    virtual bool eventFilter(QObject *, QEvent *);
+    void setParent(QObject *);
+    QObject *parent() const;
+    void setObjectName(const QString &);
+    QString objectName() const;
+    const QList<QObject *> &children() const;
+    void deleteLater();
+    static bool connect(const QObject *, const char *, const QObject *, const char *);
+    template <typename Func1, typename Func2>
+    static bool connect(const QObject *, Func1, const QObject *, Func2) { return true; }
+    template <typename Func1, typename Func2>
+    static bool connect(const QObject *, Func1, Func2) { return true; }
+    static bool disconnect(const QObject *, const char *, const QObject *, const char *);
+signals:
+    void destroyed(QObject * = nullptr);
+    void objectNameChanged(const QString &);
+};
+
+template <typename T>
+T qobject_cast(QObject *);
+
+QT_END_NAMESPACE
+
+#endif
+"""
+
+
+def generate_qobject_hierarchy(num_classes):
+    # Long chains of QObjects with signals, slots, properties and connects
+    out = ['#include <fake_qt.h>', '']
+    for i in range(num_classes):
+        base = 'QObject' if i % 10 == 0 else 'Object%d' % (i - 1)
+        out.append('class Object%d : public %s' % (i, base))
+        out.append('{')
+        out.append('    Q_OBJECT')
+        out.append('    Q_PROPERTY(QString name%d READ name%d WRITE setName%d NOTIFY name%dChanged)' % (i, i, i, i))
+        out.append('    Q_PROPERTY(int value%d READ value%d)' % (i, i))
+        out.append('public:')
+        out.append('    explicit Object%d(QObject *parent = nullptr) : %s(parent) {}' % (i, base))
+        out.append('    QString name%d() const { return m_name; }' % i)
+        out.append('    int value%d() const { return m_value; }' % i)
+        out.append('    void setName%d(const QString &name) { if (name == m_name) return; m_name = name; emit name%dChanged(name); }' % (i, i))
+        out.append('    bool event(QEvent *e) override { return QObject::event(e); }')
+        out.append('signals:')
+        out.append('    void name%dChanged(const QString &);' % i)
+        out.append('    void valueChanged%d(int);' % i)
+        out.append('public slots:')
+        out.append('    void onValue%d(int v) { m_value = v; Q_EMIT valueChanged%d(v); }' % (i, i))
+        out.append('    void onName%d(QString name) { setName%d(name + "-" + QString::number(m_value)); }' % (i, i))
+        out.append('private:')
+        out.append('    QString m_name;')
+        out.append('    int m_value = 0;')
+        out.append('};')
+        out.append('')
+
+    out.append('void connectAll(QObject *root)')
+    out.append('{')
+    for i in range(1, num_classes):
+        out.append('    auto o%d = new Object%d(root);' % (i, i))
+        out.append('    QObject::connect(o%d, &Object%d::valueChanged%d, o%d, &Object%d::onValue%d);' % (i, i, i, i, i, i))
+        if i % 5 == 0:
+            out.append('    QObject::connect(o%d, SIGNAL(name%dChanged(QString)), root, SLOT(deleteLater()));' % (i, i))
+            out.append('    QObject::connect(o%d, &Object%d::destroyed, [o%d] { o%d->setObjectName("gone"); });' % (i, i, i - 1, i - 1))
+        if i % 7 == 0:
+            out.append('    Object%d *c%d = qobject_cast<Object%d *>(root->children().first());' % (i, i, i))
+            out.append('    if (c%d) c%d->setName%d(QString("child") + QString::number(%d));' % (i, i, i, i))
+    out.append('}')
+    return '\n'.join(out) + '\n'
+
+
+def generate_macro_heavy(num_macros):
+    # Many definitions, expansions and conditionals, exercising the preprocessor callbacks
+    out = ['#include <fake_qt.h>', '']
+    for i in range(num_macros):
+        out.append('#ifndef BENCH_GUARD_%d' % i)
+        out.append('#define BENCH_GUARD_%d' % i)
+        out.append('#define BENCH_VALUE_%d(x) ((x) * %d + BENCH_VALUE_BASE)' % (i, i))
+        out.append('#define BENCH_STR_%d "value %d"' % (i, i))
+        out.append('#endif')
+        out.append('#if defined(Q_OS_LINUX) && BENCH_LEVEL > %d' % (i % 3))
+        out.append('#define BENCH_ENABLED_%d 1' % i)
+        out.append('#elif defined(Q_OS_WIN)')
+        out.append('#define BENCH_ENABLED_%d 2' % i)
+        out.append('#else')
+        out.append('#define BENCH_ENABLED_%d 0' % i)
+        out.append('#endif')
+    out.append('')
+    out.append('#define BENCH_VALUE_BASE 1')
+    out.append('#define BENCH_LEVEL 2')
+    out.append('')
+    out.append('class MacroUser : public QObject')
+    out.append('{')
+    out.append('    Q_OBJECT')
+    out.append('public:')
+    out.append('    enum Mode { ModeA, ModeB };')
+    out.append('    Q_ENUMS(Mode)')
+    out.append('signals:')
+    out.append('    void changed(int);')
+    out.append('public:')
+    out.append('    int compute(int v)')
+    out.append('    {')
+    out.append('        int sum = 0;')
+    for i in range(num_macros):
+        out.append('#ifdef BENCH_GUARD_%d' % i)
+        out.append('        sum += BENCH_VALUE_%d(v) + BENCH_ENABLED_%d;' % (i, i))
+        out.append('        if (sum > %d) Q_EMIT changed(sum);' % (i * 10))
+        out.append('#endif')
+    out.append('        return sum;')
+    out.append('    }')
+    out.append('    QString describe() const')
+    out.append('    {')
+    out.append('        QString result;')
+    for i in range(0, num_macros, 4):
+        out.append('        result += QString(BENCH_STR_%d) + QLatin1String(BENCH_STR_%d);' % (i, i))
+    out.append('        return result;')
+    out.append('    }')
+    out.append('};')
+    return '\n'.join(out) + '\n'
+
+
+def generate_template_heavy(num_templates):
+    # Nested container instantiations and recursive templates
+    out = ['#include <fake_qt.h>', '']
+    out.append('template <int N> struct Fib { static const int value = Fib<N - 1>::value + Fib<N - 2>::value; };')
+    out.append('template <> struct Fib<1> { static const int value = 1; };')
+    out.append('template <> struct Fib<0> { static const int value = 0; };')
+    out.append('')
+    out.append('template <typename T, int Depth> struct Nest { typedef QVector<typename Nest<T, Depth - 1>::type> type; };')
+    out.append('template <typename T> struct Nest<T, 0> { typedef T type; };')
+    out.append('')
+    for i in range(num_templates):
+        out.append('template <typename T, typename U>')
+        out.append('class Holder%d' % i)
+        out.append('{')
+        out.append('public:')
+        out.append('    void add(const T &t, const U &u) { m_map.insert(t, m_list); m_list.append(u); }')
+        out.append('    QList<U> all() const { QList<U> result; for (auto u : m_list) result.append(u); return result; }')
+        out.append('    int total() const { int n = 0; for (const T &k : m_map.keys()) n += m_map.value(k).size(); return n + Fib<%d>::value; }' % (i % 20))
+        out.append('private:')
+        out.append('    QMap<T, QList<U>> m_map;')
+        out.append('    QList<U> m_list;')
+        out.append('    typename Nest<U, %d>::type m_nested;' % (i % 6))
+        out.append('};')
+        out.append('')
+    out.append('int useHolders()')
+    out.append('{')
+    out.append('    int n = 0;')
+    for i in range(num_templates):
+        key = ['int', 'QString'][i % 2]
+        value = ['QString', 'QVector<int>', 'QMap<int, QString>', 'QHash<QString, QStringList>'][i % 4]
+        out.append('    { Holder%d<%s, %s> h; h.add(%s(), %s()); n += h.total() + h.all().size(); }' % (i, key, value, key, value))
+    out.append('    return n;')
+    out.append('}')
+    return '\n'.join(out) + '\n'
+
+
+def generate_long_functions(num_functions, loops_per_function):
+    # Long function bodies with many loops over containers, exercising the loop and container checks
+    out = ['#include <fake_qt.h>', '']
+    for f in range(num_functions):
+        out.append('QStringList process%d(const QStringList &input, QMap<QString, int> &counts, QObject *obj)' % f)
+        out.append('{')
+        out.append('    QStringList result;')
+        out.append('    QVector<int> sizes;')
+        for l in range(loops_per_function):
+            kind = l % 5
+            if kind == 0:
+                out.append('    for (QString s : input) {')
+                out.append('        if (!s.isEmpty() && s.startsWith("x%d"))' % l)
+                out.append('            result.append(s.mid(1).toLower() + QString::number(%d));' % l)
+                out.append('    }')
+            elif kind == 1:
+                out.append('    for (int i = 0; i < input.size(); ++i) {')
+                out.append('        QStringList tmp;')
+                out.append('        tmp.append(input.at(i));')
+                out.append('        sizes.push_back(tmp.count() + input[i].size());')
+                out.append('    }')
+            elif kind == 2:
+                out.append('    for (const QString &k : counts.keys()) {')
+                out.append('        counts[k] += counts.value(k) + %d;' % l)
+                out.append('        if (counts.contains(k + "%d")) result.append(k);' % l)
+                out.append('    }')
+            elif kind == 3:
+                out.append('    int total%d = 0;' % l)
+                out.append('    while (total%d < sizes.size()) {' % l)
+                out.append('        total%d += sizes.at(total%d) > 0 ? 1 : 2;' % (l, l))
+                out.append('        if (obj->children().isEmpty()) break;')
+                out.append('    }')
+            else:
+                out.append('    for (auto c : obj->children()) {')
+                out.append('        QString name = c->objectName();')
+                out.append('        if (name.indexOf(QLatin1String("%d")) != -1)' % l)
+                out.append('            result.append(name.trimmed().arg(%d));' % l)
+                out.append('    }')
+        out.append('    return result;')
+        out.append('}')
+        out.append('')
+    return '\n'.join(out) + '\n'
+
+
+def write_if_changed(filename, contents):
+    if os.path.exists(filename):
+        with open(filename, 'r') as f:
+            if f.read() == contents:
+                return
+    with open(filename, 'w') as f:
+        f.write(contents)
+
+
+
+def generate_macro_expansions(num_uses):
+    # Big macros whose arguments are expanded several times, so warnings inside them need deduplicating
+    out = ['#include <fake_qt.h>', '']
+    out.append('#define BENCH_FOUR(x) x; x; x; x')
+    out.append('#define BENCH_CHECK(cond, msg) do { if (!(cond)) qWarningBench(QString(msg)); } while (0)')
+    out.append('#define BENCH_BIG_BODY(obj, list, name) \\')
+    out.append('    do { \\')
+    out.append('        QString prefix_##name = QString("prefix ") + QString::number(__LINE__); \\')
+    out.append('        for (QObject *c : (obj)->children()) { \\')
+    out.append('            BENCH_CHECK(c != nullptr, "null child"); \\')
+    out.append('            if (c->objectName() == QString(#name)) \\')
+    out.append('                (list).append(prefix_##name + c->objectName()); \\')
+    out.append('        } \\')
+    out.append('        BENCH_FOUR((list).append(QString(#name))); \\')
+    out.append('        BENCH_CHECK((list).size() > 0, "empty " #name); \\')
+    out.append('    } while (0)')
+    out.append('')
+    out.append('void qWarningBench(const QString &);')
+    out.append('')
+    for f in range(0, num_uses, 50):
+        out.append('QStringList expand%d(QObject *obj)' % f)
+        out.append('{')
+        out.append('    QStringList result;')
+        for i in range(f, min(f + 50, num_uses)):
+            out.append('    BENCH_BIG_BODY(obj, result, item%d);' % i)
+            out.append('    BENCH_FOUR(result.append(QString("literal %d") + QString::number(%d)));' % (i, i))
+        out.append('    return result;')
+        out.append('}')
+        out.append('')
+    return '\n'.join(out) + '\n'
+
+
+def generate_nested_loops(num_functions, depth=5):
+    # Deeply nested loops, declaring containers inside them and filling others without reserving
+    out = ['#include <fake_qt.h>', '']
+    variables = 'abcdefghij'
+    for f in range(num_functions):
+        out.append('QVector<int> nested%d(const QVector<int> &input, const QStringList &names)' % f)
+        out.append('{')
+        out.append('    QVector<int> result;')
+        out.append('    QStringList labels;')
+        indent = '    '
+        for d in range(depth):
+            v = variables[d]
+            if d % 2 == 0:
+                out.append('%sfor (int %s = 0; %s < input.size(); ++%s) {' % (indent, v, v, v))
+            else:
+                out.append('%sfor (const QString &name%s : names) {' % (indent, v))
+            indent += '    '
+            out.append('%sQVector<int> tmp%s;' % (indent, v))
+            out.append('%sQStringList parts%s;' % (indent, v))
+            if d % 2 == 0:
+                out.append('%stmp%s.append(input.at(%s) + %d);' % (indent, v, v, f))
+                out.append('%sresult.push_back(input[%s] * %d);' % (indent, v, d + 1))
+            else:
+                out.append('%sparts%s.append(name%s.left(%d));' % (indent, v, v, d))
+                out.append('%slabels.append(name%s + QString::number(tmp%s.size()));' % (indent, v, v))
+        for d in range(depth):
+            indent = indent[:-4]
+            out.append('%s}' % indent)
+        out.append('    for (int i = 0; i < labels.size(); ++i)')
+        out.append('        result.append(labels.at(i).size());')
+        out.append('    return result;')
+        out.append('}')
+        out.append('')
+    return '\n'.join(out) + '\n'
+
+
+def generate_ui_literals(num_widgets):
+    # Hand-written UI setup code, with a string literal in almost every statement
+    out = ['#include <fake_qt.h>', '']
+    out.append('class BenchLabel : public QObject')
+    out.append('{')
+    out.append('    Q_OBJECT')
+    out.append('public:')
+    out.append('    explicit BenchLabel(QObject *parent = nullptr) : QObject(parent) {}')
+    out.append('    void setText(const QString &);')
+    out.append('    void setToolTip(const QString &);')
+    out.append('    QString text() const;')
+    out.append('};')
+    out.append('')
+    for w in range(num_widgets):
+        out.append('class Widget%d : public QObject' % w)
+        out.append('{')
+        out.append('    Q_OBJECT')
+        out.append('public:')
+        out.append('    explicit Widget%d(QObject *parent = nullptr) : QObject(parent) { setupUi(); }' % w)
+        out.append('    void setupUi();')
+        out.append('    void retranslate(const QString &language);')
+        out.append('private:')
+        out.append('    BenchLabel *m_title = nullptr;')
+        out.append('    BenchLabel *m_status = nullptr;')
+        out.append('    QMap<QString, QString> m_toolTips;')
+        out.append('};')
+        out.append('')
+        out.append('void Widget%d::setupUi()' % w)
+        out.append('{')
+        out.append('    setObjectName("widget%d");' % w)
+        out.append('    m_title = new BenchLabel(this);')
+        out.append('    m_title->setObjectName("title%d");' % w)
+        out.append('    m_title->setText("Widget number %d");' % w)
+        out.append('    m_title->setToolTip(QString("Tooltip of ") + "widget %d");' % w)
+        out.append('    m_status = new BenchLabel(this);')
+        out.append('    m_status->setText(QString("Ready") + QLatin1String(" (%d)"));' % w)
+        out.append('    QStringList items;')
+        for i in range(6):
+            out.append('    items.append("item %d of widget %d");' % (i, w))
+        out.append('    m_toolTips.insert("open", "Open a file");')
+        out.append('    m_toolTips.insert("save", QString("Save widget ") + QString::number(%d));' % w)
+        out.append('}')
+        out.append('')
+        out.append('void Widget%d::retranslate(const QString &language)' % w)
+        out.append('{')
+        out.append('    if (language == "de")')
+        out.append('        m_title->setText("Fenster %d");' % w)
+        out.append('    else if (language.startsWith("fr"))')
+        out.append('        m_title->setText(QString("Fenetre ") + "%d");' % w)
+        out.append('    else if (m_title->text() == QString("Widget number %d"))' % w)
+        out.append('        m_status->setText(QLatin1String("unchanged"));')
+        out.append('    m_status->setToolTip(m_toolTips.value("open") + m_toolTips.value(QStringLiteral("save")));')
+        out.append('}')
+        out.append('')
+    return '\n'.join(out) + '\n'
+
+
+# The kinds of sources, with the number of units each has in the default corpus. What a unit is depends on the kind:
+# a class, a macro, a use of a macro, a template, a function or a widget.
+GENERATORS = {
+    'qobject_hierarchy': (generate_qobject_hierarchy, 300),
+    'macro_heavy': (generate_macro_heavy, 400),
+    'macro_expansions': (generate_macro_expansions, 200),
+    'template_heavy': (generate_template_heavy, 150),
+    'long_functions': (lambda n: generate_long_functions(n, 60), 40),
+    'nested_loops': (generate_nested_loops, 60),
+    'ui_literals': (generate_ui_literals, 150),
+}
+
+
+def default_counts(scale=1.0):
+    return dict((kind, max(1, int(count * scale))) for kind, (_, count) in GENERATORS.items())
+
+
+def generate_corpus(work_dir, counts=None):
+    # counts maps kinds to their number of units, all kinds at their default size if None.
+    # Returns the generated files and the directory of the fake Qt header.
+    if counts is None:
+        counts = default_counts()
+
+    corpus_dir = os.path.join(work_dir, 'corpus')
+    include_dir = os.path.join(corpus_dir, 'include')
+    if not os.path.isdir(include_dir):
+        os.makedirs(include_dir)
+
+    write_if_changed(os.path.join(include_dir, 'fake_qt.h'), FAKE_QT_HEADER)
+
+    filenames = []
+    for kind in sorted(counts.keys()):
+        filename = os.path.join(corpus_dir, kind + '.cpp')
+        write_if_changed(filename, GENERATORS[kind][0](counts[kind]))
+        filenames.append(filename)
+
+    return filenames, include_dir
+
+
+def parse_kind(spec):
+    # KIND or KIND=COUNT
+    kind, _, count = spec.partition('=')
+    if kind not in GENERATORS:
+        raise argparse.ArgumentTypeError('unknown kind %s, expected one of %s' % (kind, ', '.join(sorted(GENERATORS.keys()))))
+    try:
+        return kind, int(count) if count else None
+    except ValueError:
+        raise argparse.ArgumentTypeError('invalid count in ' + spec)
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Generates C++ sources stressing clazy, see the comment at the top.')
+    parser.add_argument('output_dir', help='Where the sources are written, in a corpus/ subdirectory')
+    parser.add_argument('--scale', type=float, default=1.0, help='Multiplies the default number of units of each kind. Default 1')
+    parser.add_argument('--kind', type=parse_kind, action='append', default=[], metavar='KIND[=COUNT]',
+                        help='Only generate this kind, with COUNT units instead of the scaled default. Can be repeated. Kinds: '
+                             + ', '.join(sorted(GENERATORS.keys())))
+    args = parser.parse_args()
+
+    counts = default_counts(args.scale)
+    if args.kind:
+        counts = dict((kind, counts[kind] if count is None else count) for kind, count in args.kind)
+    filenames, include_dir = generate_corpus(args.output_dir, counts)
+    print('-isystem ' + include_dir)
+    for filename in filenames:
+        print(filename)
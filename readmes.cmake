@@ -1,24 +1,74 @@
 SET(README_manuallevel_FILES
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-algorithm-callable-by-value.md
     ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-assert-with-side-effects.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-atomic-false-sharing.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-atomic-memory-order.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-busy-polling.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-constexpr-lookup-table.md
     ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-container-inside-loop.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-detaching-lambda-capture.md
     ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-detaching-member.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-double-lookup.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-emplace-candidates.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-endl-in-loop.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-erase-in-loop.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-findchild-in-loop.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-function-args-sink.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-gui-thread-blocking.md
     ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-heap-allocated-small-trivial-type.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-heterogeneous-lookup.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-hot-path-allocations.md
     ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-ifndef-define-typo.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-ineffective-move.md
     ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-inefficient-qlist.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-invoke-method-by-name.md
     ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-isempty-vs-count.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-keyed-lookup-in-loop.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-large-signal-arguments.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-linear-search-in-loop.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-lookup-key-allocations.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-loop-invariant-call.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-make-shared-candidates.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-missing-move.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-model-signals-in-loop.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-move-not-noexcept.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-qdatetime-elapsed.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-qdebug-in-loop.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-qhash-allocations.md
     ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-qhash-with-char-pointer-key.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-qimage-pixel-in-loop.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-qobject-in-loop.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-qproperty-container-getter.md
     ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-qproperty-type-mismatch.md
     ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-qrequiredresult-candidates.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-qstring-split-single-use.md
     ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-qstring-varargs.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-qstringview-parameter.md
     ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-qt-keywords.md
     ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-qt4-qstring-from-array.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-qvariant-allocations.md
     ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-qvariant-template-instantiation.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-qvariantmap-as-struct.md
     ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-raw-environment-function.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-regex-from-literal.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-repeated-string-conversion.md
     ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-reserve-candidates.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-shared-pointer-copies.md
     ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-signal-with-return-value.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-small-local-vector.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-startup-latency.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-std-function-overhead.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-string-concatenation-in-loop.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-struct-padding.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-task-capture-copy.md
     ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-thread-with-slots.md
     ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-tr-non-literal.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-unconnected-signal-payload.md
     ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-unneeded-cast.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-unneeded-local-copy.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-unordered-map-candidates.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-virtual-call-in-loop.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-wide-lock-scope.md
 )
 
 SET(README_LEVEL0_FILES
@@ -26,6 +76,7 @@ SET(README_LEVEL0_FILES
     ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-connect-non-signal.md
     ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-connect-not-normalized.md
     ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-container-anti-pattern.md
+    ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-discarded-result.md
     ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-empty-qstringliteral.md
     ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-fully-qualified-moc-types.md
     ${CMAKE_CURRENT_LIST_DIR}/docs/checks/README-lambda-in-connect.md
@@ -21,11 +21,14 @@
 */
 
 #include "AccessSpecifierManager.h"
+#include "ClazyContext.h"
+#include "PreprocessorDispatcher.h"
 #include "QtUtils.h"
 #include "SourceCompatibilityHelpers.h"
 #include "Utils.h"
 
 #include <clang/Basic/SourceManager.h>
+#include <clang/AST/Attr.h>
 #include <clang/AST/DeclCXX.h>
 #include <clang/AST/DeclBase.h>
 #include <clang/AST/DeclTemplate.h>
@@ -34,7 +37,9 @@
 #include <clang/Frontend/CompilerInstance.h>
 #include <clang/Lex/PPCallbacks.h>
 #include <clang/Lex/Preprocessor.h>
+#include <clang/Lex/PreprocessorOptions.h>
 #include <clang/Lex/Token.h>
+#include <llvm/ADT/SmallVector.h>
 #include <llvm/Support/Casting.h>
 
 #include <algorithm>
@@ -69,6 +74,36 @@ static bool accessSpecifierCompare(const ClazyAccessSpecifier &lhs, const ClazyA
     return lhs.loc < rhs.loc;
 }
 
+// Qt's QT_ANNOTATE_ACCESS_SPECIFIER and QT_ANNOTATE_FUNCTION macros can make Q_SIGNALS, Q_SLOT and such
+// leave an annotate attribute in the AST, which survives in modules and PCHs, unlike macro expansions
+static bool hasAnnotation(const Decl *decl, llvm::StringRef annotation)
+{
+    if (!decl->hasAttrs())
+        return false;
+
+    for (const auto *attr : decl->specific_attrs<AnnotateAttr>()) {
+        if (attr->getAnnotation() == annotation)
+            return true;
+    }
+
+    return false;
+}
+
+static QtAccessSpecifierType annotatedType(const Decl *decl)
+{
+    if (!decl->hasAttrs())
+        return QtAccessSpecifier_None;
+
+    if (hasAnnotation(decl, "qt_signal"))
+        return QtAccessSpecifier_Signal;
+    if (hasAnnotation(decl, "qt_slot"))
+        return QtAccessSpecifier_Slot;
+    if (hasAnnotation(decl, "qt_invokable"))
+        return QtAccessSpecifier_Invokable;
+
+    return QtAccessSpecifier_None;
+}
+
 static void sorted_insert(ClazySpecifierList &v, const ClazyAccessSpecifier &item, const clang::SourceManager &sm)
 {
     auto pred = [&sm] (const ClazyAccessSpecifier &lhs, const ClazyAccessSpecifier &rhs) {
@@ -82,28 +117,49 @@ class AccessSpecifierPreprocessorCallbacks
 {
     AccessSpecifierPreprocessorCallbacks(const AccessSpecifierPreprocessorCallbacks &) = delete;
 public:
-    AccessSpecifierPreprocessorCallbacks(const clang::CompilerInstance &ci)
+    AccessSpecifierPreprocessorCallbacks(const clang::Preprocessor &pp)
         : clang::PPCallbacks()
-        , m_ci(ci)
+        , m_pp(pp)
     {
         m_qtAccessSpecifiers.reserve(30); // bootstrap it
+
+        // The identifiers are unique per translation unit, so comparing them is a pointer compare
+        for (const char *name : s_qtClassMacros)
+            m_qtClassMacros.push_back(pp.getIdentifierInfo(name));
+        m_slots = pp.getIdentifierInfo("slots");
+        m_qSlots = pp.getIdentifierInfo("Q_SLOTS");
+        m_signals = pp.getIdentifierInfo("signals");
+        m_qSignals = pp.getIdentifierInfo("Q_SIGNALS");
+        m_qSlot = pp.getIdentifierInfo("Q_SLOT");
+        m_qSignal = pp.getIdentifierInfo("Q_SIGNAL");
+        m_qInvokable = pp.getIdentifierInfo("Q_INVOKABLE");
+        m_qScriptable = pp.getIdentifierInfo("Q_SCRIPTABLE");
+
+        // QObject could come from a PCH or module, whose Q_OBJECT we never see expanding
+        m_sawQtClass = !pp.getPreprocessorOpts().ImplicitPCHInclude.empty() || pp.getLangOpts().Modules;
     }
 
     void MacroExpands(const Token &MacroNameTok, const MacroDefinition &,
                       SourceRange range, const MacroArgs *) override
     {
-        IdentifierInfo *ii = MacroNameTok.getIdentifierInfo();
+        const IdentifierInfo *ii = MacroNameTok.getIdentifierInfo();
         if (!ii)
             return;
 
-        auto name = ii->getName();
-        const bool isSlots = name == "slots" || name == "Q_SLOTS";
-        const bool isSignals = isSlots ? false : (name == "signals" || name == "Q_SIGNALS");
+        // Signals and slots only exist in classes with Q_OBJECT, which qobject.h's QObject has too, or Q_GADGET.
+        // Until then, only watch for those. Translation units without QObjects never record anything.
+        if (!m_sawQtClass) {
+            m_sawQtClass = std::find(m_qtClassMacros.cbegin(), m_qtClassMacros.cend(), ii) != m_qtClassMacros.cend();
+            return;
+        }
 
-        const bool isSlot = (isSlots || isSignals) ? false : name == "Q_SLOT";
-        const bool isSignal = (isSlots || isSignals || isSlot) ? false : name == "Q_SIGNAL";
-        const bool isInvokable = (isSlots || isSignals || isSlot || isSignal) ? false : name == "Q_INVOKABLE";
-        const bool isScriptable = (isSlot || isSignal || isInvokable) ? false : name == "Q_SCRIPTABLE";
+        // Only the macros subscribed to in AccessSpecifierManager's constructor get here
+        const bool isSlots = ii == m_slots || ii == m_qSlots;
+        const bool isSignals = ii == m_signals || ii == m_qSignals;
+        const bool isSlot = ii == m_qSlot;
+        const bool isSignal = ii == m_qSignal;
+        const bool isInvokable = ii == m_qInvokable;
+        const bool isScriptable = ii == m_qScriptable;
         if (!isSlots && !isSignals && !isSlot && !isSignal && !isInvokable && !isScriptable)
             return;
 
@@ -111,13 +167,14 @@ public:
         if (loc.isMacroID())
             return;
 
+        m_sorted = false;
         if (isSignals || isSlots) {
             QtAccessSpecifierType qtAccessSpecifier = isSlots ? QtAccessSpecifier_Slot
                                                               : QtAccessSpecifier_Signal;
             m_qtAccessSpecifiers.push_back( { loc, clang::AS_none, qtAccessSpecifier } );
         } else {
             // Get the location of the method declaration, so we can compare directly when we visit methods
-            loc = Utils::locForNextToken(loc, m_ci.getSourceManager(), m_ci.getLangOpts());
+            loc = Utils::locForNextToken(loc, m_pp.getSourceManager(), m_pp.getLangOpts());
             if (loc.isInvalid())
                 return;
             if (isSignal) {
@@ -132,20 +189,61 @@ public:
         }
     }
 
+    // Sorts by location, so the AST side can binary search. Cheap to call often, as the
+    // preprocessor is done by the time the AST is visited.
+    void sort()
+    {
+        if (m_sorted)
+            return;
+
+        std::sort(m_individualSignals.begin(), m_individualSignals.end());
+        std::sort(m_individualSlots.begin(), m_individualSlots.end());
+        std::sort(m_invokables.begin(), m_invokables.end());
+        std::sort(m_scriptables.begin(), m_scriptables.end());
+        std::stable_sort(m_qtAccessSpecifiers.begin(), m_qtAccessSpecifiers.end(), [] (const ClazyAccessSpecifier &lhs, const ClazyAccessSpecifier &rhs) {
+            return lhs.loc < rhs.loc; // Only file locations, see MacroExpands()
+        });
+        m_sorted = true;
+    }
+
     vector<unsigned> m_individualSignals; // Q_SIGNAL
     vector<unsigned> m_individualSlots;   // Q_SLOT
     vector<unsigned> m_invokables; // Q_INVOKABLE
     vector<unsigned> m_scriptables; // Q_SCRIPTABLE
-    const CompilerInstance &m_ci;
-    ClazySpecifierList m_qtAccessSpecifiers;
+    const Preprocessor &m_pp;
+    ClazySpecifierList m_qtAccessSpecifiers; // Q_SLOTS and Q_SIGNALS not yet assigned to a class
+    bool m_sorted = true;
+    bool m_sawQtClass = false; // A Q_OBJECT or Q_GADGET was expanded
+
+    static const char *const s_qtClassMacros[3];
+
+private:
+    llvm::SmallVector<const IdentifierInfo *, 3> m_qtClassMacros;
+    const IdentifierInfo *m_slots = nullptr;
+    const IdentifierInfo *m_qSlots = nullptr;
+    const IdentifierInfo *m_signals = nullptr;
+    const IdentifierInfo *m_qSignals = nullptr;
+    const IdentifierInfo *m_qSlot = nullptr;
+    const IdentifierInfo *m_qSignal = nullptr;
+    const IdentifierInfo *m_qInvokable = nullptr;
+    const IdentifierInfo *m_qScriptable = nullptr;
 };
 
-AccessSpecifierManager::AccessSpecifierManager(const clang::CompilerInstance &ci)
-    : m_ci(ci)
-    , m_preprocessorCallbacks(new AccessSpecifierPreprocessorCallbacks(ci))
+// Qt 6's Q_GADGET expands to Q_GADGET_EXPORT()
+const char *const AccessSpecifierPreprocessorCallbacks::s_qtClassMacros[3] = { "Q_OBJECT", "Q_GADGET", "Q_GADGET_EXPORT" };
+
+AccessSpecifierManager::AccessSpecifierManager(const ClazyContext *context)
+    : m_sm(context->sm)
+    , m_specifiersMap(0, std::hash<const CXXRecordDecl *>(), std::equal_to<const CXXRecordDecl *>(), context->arena)
+    , m_preprocessorCallbacks(new AccessSpecifierPreprocessorCallbacks(context->pp))
 {
-    Preprocessor &pi = m_ci.getPreprocessor();
-    pi.addPPCallbacks(unique_ptr<PPCallbacks>(m_preprocessorCallbacks));
+    // The dispatcher owns the callbacks
+    // Subscribed to all of them upfront, the dispatcher only costs a lookup per macro whatever the number of names,
+    // but can't take new ones while dispatching
+    context->preprocessorDispatcher()->subscribe(m_preprocessorCallbacks, PreprocessorEvent_MacroExpands,
+                                                 { "Q_OBJECT", "Q_GADGET", "Q_GADGET_EXPORT",
+                                                   "slots", "Q_SLOTS", "signals", "Q_SIGNALS",
+                                                   "Q_SLOT", "Q_SIGNAL", "Q_INVOKABLE", "Q_SCRIPTABLE" });
 }
 
 ClazySpecifierList& AccessSpecifierManager::entryForClassDefinition(CXXRecordDecl *classDecl)
@@ -154,36 +252,40 @@ ClazySpecifierList& AccessSpecifierManager::entryForClassDefinition(CXXRecordDec
     return specifiers;
 }
 
-const CXXRecordDecl *AccessSpecifierManager::classDefinitionForLoc(SourceLocation loc) const
+bool AccessSpecifierManager::sawQtClass() const
 {
-    for (const auto &it : m_specifiersMap) {
-        const CXXRecordDecl *record = it.first;
-        if (clazy::getLocStart(record) < loc && loc < clazy::getLocEnd(record))
-            return record;
-    }
-    return nullptr;
+    return m_preprocessorCallbacks->m_sawQtClass;
 }
 
 void AccessSpecifierManager::VisitDeclaration(Decl *decl)
 {
+    // Nothing was recorded, and classes from modules are handled by qtAccessSpecifierType() through their annotations
+    if (!m_preprocessorCallbacks->m_sawQtClass)
+        return;
+
     auto record = dyn_cast<CXXRecordDecl>(decl);
     if (!clazy::isQObject(record))
         return;
 
-    const auto &sm = m_ci.getSourceManager();
-
     // We got a new record, lets fetch signals and slots that the pre-processor gathered
     ClazySpecifierList &specifiers = entryForClassDefinition(record);
 
-    auto it = m_preprocessorCallbacks->m_qtAccessSpecifiers.begin();
-    while (it != m_preprocessorCallbacks->m_qtAccessSpecifiers.end()) {
-        if (classDefinitionForLoc((*it).loc) == record) {
-            sorted_insert(specifiers, *it, sm);
-            it = m_preprocessorCallbacks->m_qtAccessSpecifiers.erase(it);
-        } else {
-            ++it;
-        }
-    }
+    // They're sorted by location, so the ones inside the class are a contiguous range.
+    // Records are visited outer first, so nested classes' ones go to the outer class, as they're already taken.
+    m_preprocessorCallbacks->sort();
+    ClazySpecifierList &pending = m_preprocessorCallbacks->m_qtAccessSpecifiers;
+    const SourceLocation recordStart = clazy::getLocStart(record);
+    const SourceLocation recordEnd = clazy::getLocEnd(record);
+    auto first = std::upper_bound(pending.begin(), pending.end(), recordStart, [] (SourceLocation loc, const ClazyAccessSpecifier &specifier) {
+        return loc < specifier.loc;
+    });
+    auto last = std::lower_bound(first, pending.end(), recordEnd, [] (const ClazyAccessSpecifier &specifier, SourceLocation loc) {
+        return specifier.loc < loc;
+    });
+
+    for (auto it = first; it != last; ++it)
+        sorted_insert(specifiers, *it, m_sm);
+    pending.erase(first, last);
 
     // Now lets add the normal C++ access specifiers (public, private etc.)
 
@@ -192,7 +294,7 @@ void AccessSpecifierManager::VisitDeclaration(Decl *decl)
         if (!accessSpec || accessSpec->getDeclContext() != record)
             continue;
         ClazySpecifierList &specifiers = entryForClassDefinition(record);
-        sorted_insert(specifiers, {clazy::getLocStart(accessSpec), accessSpec->getAccess(), QtAccessSpecifier_None }, sm);
+        sorted_insert(specifiers, {clazy::getLocStart(accessSpec), accessSpec->getAccess(), annotatedType(accessSpec) }, m_sm);
     }
 }
 
@@ -209,25 +311,37 @@ QtAccessSpecifierType AccessSpecifierManager::qtAccessSpecifierType(const CXXMet
     if (!record || isa<clang::ClassTemplateSpecializationDecl>(record))
         return QtAccessSpecifier_None;
 
+    const QtAccessSpecifierType annotated = annotatedType(method);
+    if (annotated != QtAccessSpecifier_None)
+        return annotated;
+
+    // Classes imported from a module or PCH weren't seen by our preprocessor callbacks, only the annotations can tell
+    if (record->isFromASTFile()) {
+        QtAccessSpecifierType type = QtAccessSpecifier_None;
+        for (const Decl *decl : record->decls()) {
+            if (decl == method)
+                return type;
+            if (auto accessSpec = dyn_cast<AccessSpecDecl>(decl))
+                type = annotatedType(accessSpec);
+        }
+
+        return QtAccessSpecifier_None;
+    }
+
     const SourceLocation methodLoc = clazy::getLocStart(method);
+    m_preprocessorCallbacks->sort();
 
     // Process Q_SIGNAL:
-    for (auto signalLoc : m_preprocessorCallbacks->m_individualSignals) {
-        if (signalLoc == methodLoc.getRawEncoding())
-            return QtAccessSpecifier_Signal;
-    }
+    if (std::binary_search(m_preprocessorCallbacks->m_individualSignals.cbegin(), m_preprocessorCallbacks->m_individualSignals.cend(), methodLoc.getRawEncoding()))
+        return QtAccessSpecifier_Signal;
 
     // Process Q_SLOT:
-    for (auto slotLoc : m_preprocessorCallbacks->m_individualSlots) {
-        if (slotLoc == methodLoc.getRawEncoding())
-            return QtAccessSpecifier_Slot;
-    }
+    if (std::binary_search(m_preprocessorCallbacks->m_individualSlots.cbegin(), m_preprocessorCallbacks->m_individualSlots.cend(), methodLoc.getRawEncoding()))
+        return QtAccessSpecifier_Slot;
 
     // Process Q_INVOKABLE:
-    for (auto loc : m_preprocessorCallbacks->m_invokables) {
-        if (loc == methodLoc.getRawEncoding())
-            return QtAccessSpecifier_Invokable;
-    }
+    if (std::binary_search(m_preprocessorCallbacks->m_invokables.cbegin(), m_preprocessorCallbacks->m_invokables.cend(), methodLoc.getRawEncoding()))
+        return QtAccessSpecifier_Invokable;
 
     // Process Q_SLOTS and Q_SIGNALS:
 
@@ -238,7 +352,7 @@ QtAccessSpecifierType AccessSpecifierManager::qtAccessSpecifierType(const CXXMet
     const ClazySpecifierList &accessSpecifiers = it->second;
 
     auto pred = [this] (const ClazyAccessSpecifier &lhs, const ClazyAccessSpecifier &rhs) {
-        return accessSpecifierCompare(lhs, rhs, m_ci.getSourceManager());
+        return accessSpecifierCompare(lhs, rhs, m_sm);
     };
 
     const ClazyAccessSpecifier dummy = { methodLoc, // we're only interested in the location
@@ -253,21 +367,31 @@ QtAccessSpecifierType AccessSpecifierManager::qtAccessSpecifierType(const CXXMet
     return (*i).qtAccessSpecifier;
 }
 
+size_t AccessSpecifierManager::numSpecifiers() const
+{
+    size_t count = m_preprocessorCallbacks->m_qtAccessSpecifiers.size() + m_preprocessorCallbacks->m_individualSignals.size()
+                   + m_preprocessorCallbacks->m_individualSlots.size() + m_preprocessorCallbacks->m_invokables.size()
+                   + m_preprocessorCallbacks->m_scriptables.size();
+    for (const auto &it : m_specifiersMap)
+        count += it.second.size();
+
+    return count;
+}
+
 bool AccessSpecifierManager::isScriptable(const CXXMethodDecl *method) const
 {
     if (!method)
         return false;
 
+    if (hasAnnotation(method->getCanonicalDecl(), "qt_scriptable"))
+        return true;
+
     const SourceLocation methodLoc = clazy::getLocStart(method);
      if (methodLoc.isMacroID())
          return false;
 
-    for (auto loc : m_preprocessorCallbacks->m_scriptables) {
-        if (loc == methodLoc.getRawEncoding())
-            return true;
-    }
-
-    return false;
+    m_preprocessorCallbacks->sort();
+    return std::binary_search(m_preprocessorCallbacks->m_scriptables.cbegin(), m_preprocessorCallbacks->m_scriptables.cend(), methodLoc.getRawEncoding());
 }
 
 llvm::StringRef AccessSpecifierManager::qtAccessSpecifierTypeStr(QtAccessSpecifierType t) const
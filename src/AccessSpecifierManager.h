@@ -23,6 +23,7 @@
 #ifndef CLAZY_ACCESS_SPECIFIER_MANAGER_H
 #define CLAZY_ACCESS_SPECIFIER_MANAGER_H
 
+#include "ArenaAllocator.h"
 #include "checkbase.h"
 
 #include <clang/Frontend/CompilerInstance.h>
@@ -43,6 +44,9 @@
 
    After that we just need to merge the two lists, and sort by source location. All the info is kept
    inside m_specifiersMap, which is indexed by the class definition.
+
+   Classes imported from a module or PCH don't go through the pre-processor, there we rely on the annotate
+   attributes which Qt's macros leave when QT_ANNOTATE_ACCESS_SPECIFIER and QT_ANNOTATE_FUNCTION are defined.
 */
 
 namespace clang
@@ -57,6 +61,7 @@ class CompilerInstance;
 }
 
 class AccessSpecifierPreprocessorCallbacks;
+class ClazyContext;
 
 enum QtAccessSpecifierType
 {
@@ -79,9 +84,15 @@ using ClazySpecifierList = std::vector<ClazyAccessSpecifier>;
 class AccessSpecifierManager
 {
 public:
-    explicit AccessSpecifierManager(const clang::CompilerInstance &ci);
+    explicit AccessSpecifierManager(const ClazyContext *context);
     void VisitDeclaration(clang::Decl *decl);
 
+    /**
+     * Returns false if no Q_OBJECT or Q_GADGET was expanded in the translation unit, then VisitDeclaration() has
+     * nothing to do. Always true with a PCH or modules. Only final once the preprocessor is done.
+     */
+    bool sawQtClass() const;
+
     /**
      * Returns if a method is a signal, a slot, or neither.
      */
@@ -97,11 +108,14 @@ public:
      */
     llvm::StringRef qtAccessSpecifierTypeStr(QtAccessSpecifierType) const;
 
+    // For the print-stats option
+    size_t numClasses() const { return m_specifiersMap.size(); }
+    size_t numSpecifiers() const;
+
 private:
     ClazySpecifierList &entryForClassDefinition(clang::CXXRecordDecl*);
-    const clang::CompilerInstance &m_ci;
-    const clang::CXXRecordDecl *classDefinitionForLoc(clang::SourceLocation loc) const;
-    std::unordered_map<const clang::CXXRecordDecl*, ClazySpecifierList> m_specifiersMap;
+    const clang::SourceManager &m_sm;
+    clazy::ArenaUnorderedMap<const clang::CXXRecordDecl*, ClazySpecifierList> m_specifiersMap;
     AccessSpecifierPreprocessorCallbacks *const m_preprocessorCallbacks;
 };
 
@@ -0,0 +1,50 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+
+#ifndef CLAZY_ACTION_FACTORY_CREATOR_H
+#define CLAZY_ACTION_FACTORY_CREATOR_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace clang {
+namespace tooling {
+class CompilationDatabase;
+class FrontendActionFactory;
+}
+}
+
+/**
+ * Creates the factory of the clazy action analyzing paths with checks, configured by clazy-standalone's options.
+ * If preambleCompilations is non-null, a precompiled preamble of each file is kept and reused while its includes
+ * don't change, see -reuse-preambles.
+ *
+ * Lets the long-running modes, like -server, -worker and -watch, live outside of ClazyStandaloneMain.cpp.
+ */
+typedef std::function<std::unique_ptr<clang::tooling::FrontendActionFactory>(
+    const std::vector<std::string> &paths, const std::string &checks,
+    const clang::tooling::CompilationDatabase *preambleCompilations)> ActionFactoryCreator;
+
+#endif
@@ -0,0 +1,119 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_ARENA_ALLOCATOR_H
+#define CLAZY_ARENA_ALLOCATOR_H
+
+#include <llvm/Support/Allocator.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace clazy {
+
+/**
+ * STL allocator for containers holding per translation unit state, see ClazyContext::arena.
+ *
+ * Allocating is a pointer bump and deallocating does nothing, the memory is only released when
+ * the ClazyContext is destroyed. So containers using it must not outlive the ClazyContext, which
+ * excludes anything owned by the Preprocessor, like PPCallbacks.
+ */
+template <typename T>
+class ArenaAllocator
+{
+public:
+    typedef T value_type;
+
+    // So an emptied container can be moved to another translation unit's arena, see CheckBase::reset()
+    typedef std::true_type propagate_on_container_move_assignment;
+
+    // Implicit, so containers can be constructed directly with the arena.
+    // If bytesAllocated is set, it's incremented by each allocation, for the print-stats option
+    ArenaAllocator(llvm::BumpPtrAllocator &arena, uint64_t *bytesAllocated = nullptr)
+        : m_arena(&arena)
+        , m_bytesAllocated(bytesAllocated)
+    {
+    }
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other)
+        : m_arena(other.arena())
+        , m_bytesAllocated(other.bytesAllocated())
+    {
+    }
+
+    T *allocate(std::size_t n)
+    {
+        if (m_bytesAllocated)
+            *m_bytesAllocated += n * sizeof(T);
+        return static_cast<T *>(m_arena->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *, std::size_t)
+    {
+    }
+
+    llvm::BumpPtrAllocator *arena() const
+    {
+        return m_arena;
+    }
+
+    uint64_t *bytesAllocated() const
+    {
+        return m_bytesAllocated;
+    }
+
+private:
+    llvm::BumpPtrAllocator *m_arena;
+    uint64_t *m_bytesAllocated;
+};
+
+template <typename T, typename U>
+inline bool operator==(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b)
+{
+    return a.arena() == b.arena();
+}
+
+template <typename T, typename U>
+inline bool operator!=(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b)
+{
+    return a.arena() != b.arena();
+}
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+template <typename Key, typename T>
+using ArenaUnorderedMap = std::unordered_map<Key, T, std::hash<Key>, std::equal_to<Key>, ArenaAllocator<std::pair<const Key, T>>>;
+
+template <typename T>
+using ArenaUnorderedSet = std::unordered_set<T, std::hash<T>, std::equal_to<T>, ArenaAllocator<T>>;
+
+}
+
+#endif
@@ -0,0 +1,248 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "AsyncDiagnosticPrinter.h"
+
+#include <clang/Basic/DiagnosticIDs.h>
+#include <clang/Basic/SourceLocation.h>
+#include <clang/Basic/SourceManager.h>
+#include <clang/Lex/Lexer.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <tuple>
+
+using namespace clang;
+using namespace std;
+
+AsyncDiagnosticPrinter::AsyncDiagnosticPrinter(llvm::raw_ostream &os)
+    : m_os(os)
+    , m_thread(&AsyncDiagnosticPrinter::run, this)
+{
+}
+
+AsyncDiagnosticPrinter::~AsyncDiagnosticPrinter()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+    }
+
+    m_condition.notify_all();
+    m_thread.join();
+}
+
+void AsyncDiagnosticPrinter::BeginSourceFile(const LangOptions &langOpts, const Preprocessor *)
+{
+    m_langOpts = &langOpts;
+}
+
+void AsyncDiagnosticPrinter::EndSourceFile()
+{
+    m_langOpts = nullptr;
+}
+
+void AsyncDiagnosticPrinter::HandleDiagnostic(DiagnosticsEngine::Level level, const Diagnostic &info)
+{
+    DiagnosticConsumer::HandleDiagnostic(level, info); // Counts the warnings and errors
+
+    Record record;
+    record.level = level;
+
+    llvm::SmallString<256> message;
+    info.FormatDiagnostic(message);
+    record.message = message.str().str();
+
+    // Clazy's own diagnostics have the flag in the message already
+    const llvm::StringRef flag = DiagnosticIDs::getWarningOptionForDiag(info.getID());
+    if (!flag.empty() && (level == DiagnosticsEngine::Warning || level == DiagnosticsEngine::Error))
+        record.message += (level == DiagnosticsEngine::Error ? " [-Werror,-W" : " [-W") + flag.str() + ']';
+
+    if (info.getLocation().isValid() && info.hasSourceManager())
+        resolveSourceLine(info, record);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(std::move(record));
+        m_numPending++;
+    }
+
+    m_condition.notify_all();
+}
+
+void AsyncDiagnosticPrinter::resolveSourceLine(const Diagnostic &info, Record &record) const
+{
+    const SourceManager &sm = info.getSourceManager();
+    const SourceLocation loc = sm.getExpansionLoc(info.getLocation());
+    const PresumedLoc presumed = sm.getPresumedLoc(loc);
+    if (presumed.isInvalid())
+        return;
+
+    record.filename = presumed.getFilename();
+    record.line = presumed.getLine();
+    record.column = presumed.getColumn();
+
+    FileID fid;
+    unsigned int offset = 0;
+    std::tie(fid, offset) = sm.getDecomposedLoc(loc);
+    bool invalid = false;
+    const llvm::StringRef buffer = sm.getBufferData(fid, &invalid);
+    if (invalid || offset > buffer.size())
+        return;
+
+    const size_t newline = buffer.rfind('\n', offset); // Before offset
+    const size_t lineStart = newline == llvm::StringRef::npos ? 0 : newline + 1;
+    const size_t lineEnd = std::min(buffer.find_first_of("\r\n", offset), buffer.size());
+    record.sourceLine = buffer.slice(lineStart, lineEnd).str();
+
+    // Offsets within the diagnostic's line, the parts on other lines aren't shown
+    auto lineOffset = [&](SourceLocation l, unsigned int &result) {
+        l = sm.getExpansionLoc(l);
+        FileID lfid;
+        unsigned int loffset = 0;
+        std::tie(lfid, loffset) = sm.getDecomposedLoc(l);
+        if (lfid != fid || loffset < lineStart || loffset > lineEnd)
+            return false;
+        result = loffset - lineStart;
+        return true;
+    };
+
+    for (const CharSourceRange &range : info.getRanges()) {
+        unsigned int begin = 0;
+        unsigned int end = 0;
+        if (!lineOffset(range.getBegin(), begin) || !lineOffset(range.getEnd(), end))
+            continue;
+
+        if (range.isTokenRange() && m_langOpts)
+            end += Lexer::MeasureTokenLength(sm.getExpansionLoc(range.getEnd()), sm, *m_langOpts);
+        if (end > begin)
+            record.ranges.push_back({ begin, std::min<unsigned int>(end, record.sourceLine.size()) });
+    }
+
+    for (const FixItHint &fixit : info.getFixItHints()) {
+        unsigned int begin = 0;
+        if (!fixit.CodeToInsert.empty() && lineOffset(fixit.RemoveRange.getBegin(), begin))
+            record.fixits.push_back({ begin, fixit.CodeToInsert });
+    }
+
+    record.ranges.push_back({ offset - lineStart, offset - lineStart + 1 }); // The caret, last
+}
+
+static const char *levelName(DiagnosticsEngine::Level level)
+{
+    switch (level) {
+    case DiagnosticsEngine::Note:
+        return "note";
+    case DiagnosticsEngine::Remark:
+        return "remark";
+    case DiagnosticsEngine::Warning:
+        return "warning";
+    case DiagnosticsEngine::Error:
+        return "error";
+    case DiagnosticsEngine::Fatal:
+        return "fatal error";
+    default:
+        return "ignored";
+    }
+}
+
+// Expands the tabs to the next multiple of 8, as TextDiagnostic does, returning the column of each byte
+static std::string expandTabs(const std::string &line, std::vector<unsigned int> &columns)
+{
+    std::string expanded;
+    columns.clear();
+    for (char c : line) {
+        columns.push_back(expanded.size());
+        if (c == '\t') {
+            expanded.append(8 - expanded.size() % 8, ' ');
+        } else {
+            expanded += c;
+        }
+    }
+
+    columns.push_back(expanded.size());
+    return expanded;
+}
+
+void AsyncDiagnosticPrinter::render(const Record &record)
+{
+    if (!record.filename.empty())
+        m_os << record.filename << ':' << record.line << ':' << record.column << ": ";
+    m_os << levelName(record.level) << ": " << record.message << '\n';
+
+    if (record.ranges.empty())
+        return; // No source line
+
+    std::vector<unsigned int> columns;
+    const std::string line = expandTabs(record.sourceLine, columns);
+    m_os << line << '\n';
+
+    std::string caretLine(line.size() + 1, ' ');
+    for (size_t i = 0; i < record.ranges.size(); ++i) {
+        const bool isCaret = i == record.ranges.size() - 1;
+        const unsigned int begin = columns[std::min<size_t>(record.ranges[i].first, columns.size() - 1)];
+        const unsigned int end = columns[std::min<size_t>(record.ranges[i].second, columns.size() - 1)];
+        for (unsigned int column = begin; column < std::max(end, begin + 1) && column < caretLine.size(); ++column)
+            caretLine[column] = isCaret ? '^' : '~';
+    }
+    m_os << llvm::StringRef(caretLine).rtrim() << '\n';
+
+    if (!record.fixits.empty()) {
+        std::string fixitLine;
+        for (const auto &fixit : record.fixits) {
+            const unsigned int column = columns[std::min<size_t>(fixit.first, columns.size() - 1)];
+            if (fixitLine.size() < column)
+                fixitLine.resize(column, ' ');
+            else if (!fixitLine.empty())
+                fixitLine += ' ';
+            fixitLine += fixit.second;
+        }
+        m_os << fixitLine << '\n';
+    }
+}
+
+void AsyncDiagnosticPrinter::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_condition.wait(lock, [this] { return m_quit || !m_queue.empty(); });
+        if (m_queue.empty())
+            return; // m_quit, and everything was written
+
+        const Record record = std::move(m_queue.front());
+        m_queue.pop_front();
+        lock.unlock();
+        render(record);
+        lock.lock();
+
+        if (--m_numPending == 0)
+            m_condition.notify_all();
+    }
+}
+
+void AsyncDiagnosticPrinter::finish()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_condition.wait(lock, [this] { return m_numPending == 0; });
+    m_os.flush();
+}
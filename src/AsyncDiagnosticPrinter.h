@@ -0,0 +1,93 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_ASYNC_DIAGNOSTIC_PRINTER_H
+#define CLAZY_ASYNC_DIAGNOSTIC_PRINTER_H
+
+#include <clang/Basic/Diagnostic.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace clang {
+class LangOptions;
+class Preprocessor;
+}
+
+namespace llvm {
+class raw_ostream;
+}
+
+/**
+ * A DiagnosticConsumer which renders the diagnostics on a thread of its own, used by clazy-standalone -async-diagnostics.
+ *
+ * The analysis thread only resolves what needs the SourceManager: the formatted message, the presumed location and the
+ * columns of the source line's ranges and fixits. Building the snippet, caret and fixit lines and writing them is left
+ * to the printer thread. Unlike TextDiagnosticPrinter, include stacks and macro expansion notes aren't printed.
+ */
+class AsyncDiagnosticPrinter : public clang::DiagnosticConsumer
+{
+public:
+    explicit AsyncDiagnosticPrinter(llvm::raw_ostream &os);
+    ~AsyncDiagnosticPrinter() override;
+
+    void BeginSourceFile(const clang::LangOptions &langOpts, const clang::Preprocessor *pp) override;
+    void EndSourceFile() override;
+    void HandleDiagnostic(clang::DiagnosticsEngine::Level level, const clang::Diagnostic &info) override;
+
+    /**
+     * Waits until every diagnostic so far was written, the stream can then be read.
+     */
+    void finish();
+
+private:
+    struct Record {
+        clang::DiagnosticsEngine::Level level;
+        std::string message;
+        std::string filename; // Empty if there's no location
+        unsigned int line = 0;
+        unsigned int column = 0;
+        std::string sourceLine;
+        std::vector<std::pair<unsigned int, unsigned int>> ranges; // Half open byte ranges within sourceLine
+        std::vector<std::pair<unsigned int, std::string>> fixits; // Byte offset within sourceLine and inserted text
+    };
+
+    void resolveSourceLine(const clang::Diagnostic &info, Record &record) const;
+    void render(const Record &record);
+    void run();
+
+    llvm::raw_ostream &m_os;
+    const clang::LangOptions *m_langOpts = nullptr;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<Record> m_queue;
+    size_t m_numPending = 0; // Queued or being rendered
+    bool m_quit = false;
+    std::thread m_thread; // Last, started once the rest is initialized
+};
+
+#endif
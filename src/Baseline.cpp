@@ -0,0 +1,189 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "Baseline.h"
+
+#include <clang/Basic/SourceManager.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Format.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <system_error>
+
+using namespace clang;
+using namespace std;
+
+// Absolute, without "." or "..", and with forward slashes, so fingerprints are the same on every platform
+static string normalizedPath(llvm::StringRef path)
+{
+    llvm::SmallString<256> result(path);
+    llvm::sys::fs::make_absolute(result);
+    llvm::sys::path::remove_dots(result, /*remove_dot_dot=*/ true);
+    std::replace(result.begin(), result.end(), '\\', '/');
+    return result.str().str();
+}
+
+static string directoryOf(const string &filename)
+{
+    return llvm::sys::path::parent_path(normalizedPath(filename)).str();
+}
+
+const Baseline *Baseline::instance()
+{
+    // Thread-safe initialization, and nothing changes afterwards
+    static const unique_ptr<const Baseline> s_baseline = [] {
+        unique_ptr<Baseline> baseline;
+        const char *filename = getenv("CLAZY_BASELINE");
+        if (filename && *filename) {
+            baseline.reset(new Baseline());
+            if (!baseline->read(filename)) {
+                llvm::errs() << "clazy: Failed to read baseline " << filename << "\n";
+                baseline.reset();
+            }
+        }
+
+        return unique_ptr<const Baseline>(std::move(baseline));
+    }();
+
+    return s_baseline.get();
+}
+
+bool Baseline::read(const string &filename)
+{
+    auto buffer = llvm::MemoryBuffer::getFile(filename);
+    if (!buffer)
+        return false;
+
+    m_rootDir = directoryOf(filename);
+
+    llvm::SmallVector<llvm::StringRef, 16> lines;
+    (*buffer)->getBuffer().split(lines, '\n', -1, /*KeepEmpty=*/ false);
+    m_fingerprints.reserve(lines.size());
+    for (llvm::StringRef line : lines) {
+        line = line.trim();
+        if (line.empty() || line.startswith("#"))
+            continue;
+
+        uint64_t fingerprint = 0;
+        if (line.split(' ').first.getAsInteger(16, fingerprint)) {
+            llvm::errs() << "clazy: Invalid line in baseline " << filename << ": " << line << "\n";
+            continue;
+        }
+
+        m_fingerprints.insert(fingerprint);
+    }
+
+    return true;
+}
+
+string Baseline::relativePath(const SourceManager &sm, SourceLocation loc, llvm::StringRef rootDir)
+{
+    const FileEntry *entry = sm.getFileEntryForID(sm.getFileID(sm.getExpansionLoc(loc)));
+    if (!entry)
+        return {};
+
+    string path = normalizedPath(entry->getName());
+    if (!rootDir.empty() && path.size() > rootDir.size() && llvm::StringRef(path).startswith(rootDir) && path[rootDir.size()] == '/')
+        path.erase(0, rootDir.size() + 1);
+
+    return path;
+}
+
+uint64_t Baseline::fingerprint(const SourceManager &sm, SourceLocation loc, llvm::StringRef checkName,
+                               llvm::StringRef message, llvm::StringRef rootDir)
+{
+    llvm::MD5 hash;
+    const llvm::StringRef separator("\0", 1);
+    hash.update(checkName);
+    hash.update(separator);
+    hash.update(relativePath(sm, loc, rootDir));
+    hash.update(separator);
+    hash.update(message);
+    hash.update(separator);
+
+    // The line of code instead of its number, so lines added above don't invalidate the baseline
+    const std::pair<FileID, unsigned> decomposed = sm.getDecomposedExpansionLoc(loc);
+    bool invalid = false;
+    const llvm::StringRef buffer = decomposed.first.isValid() ? sm.getBufferData(decomposed.first, &invalid) : llvm::StringRef();
+    if (!invalid && decomposed.second <= buffer.size()) {
+        const size_t lineStart = buffer.rfind('\n', decomposed.second) + 1; // npos + 1 is 0
+        const size_t lineEnd = std::min(buffer.find('\n', decomposed.second), buffer.size());
+        llvm::SmallString<128> line;
+        for (char c : buffer.slice(lineStart, lineEnd)) {
+            if (!isspace(static_cast<unsigned char>(c)))
+                line.push_back(c);
+        }
+        hash.update(line);
+    }
+
+    llvm::MD5::MD5Result result;
+    hash.final(result);
+
+    uint64_t fingerprint = 0;
+    for (int i = 0; i < 8; ++i)
+        fingerprint = (fingerprint << 8) | result[i];
+
+    return fingerprint;
+}
+
+BaselineExporter::BaselineExporter(const SourceManager &sm, const string &filename)
+    : m_sm(sm)
+    , m_rootDir(directoryOf(filename))
+{
+    error_code ec;
+#if LLVM_VERSION_MAJOR >= 9
+    const auto flags = llvm::sys::fs::OF_Append;
+#else
+    const auto flags = llvm::sys::fs::F_Append;
+#endif
+    m_stream.reset(new llvm::raw_fd_ostream(filename, ec, flags));
+    if (ec) {
+        llvm::errs() << "clazy: Failed to open " << filename << ": " << ec.message() << "\n";
+        m_stream.reset();
+        return;
+    }
+
+    m_stream->SetUnbuffered(); // We write whole lines at once
+}
+
+BaselineExporter::~BaselineExporter() = default;
+
+void BaselineExporter::write(uint64_t fingerprint, llvm::StringRef checkName, SourceLocation loc)
+{
+    if (!m_stream)
+        return;
+
+    string line;
+    llvm::raw_string_ostream os(line);
+    os << llvm::format_hex_no_prefix(fingerprint, 16) << ' ' << checkName << ' '
+       << Baseline::relativePath(m_sm, loc, m_rootDir) << '\n';
+    *m_stream << os.str();
+}
@@ -0,0 +1,120 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_BASELINE_H
+#define CLAZY_BASELINE_H
+
+#include <clang/Basic/SourceLocation.h>
+#include <llvm/ADT/StringRef.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_set>
+
+namespace clang {
+class SourceManager;
+}
+
+namespace llvm {
+class raw_fd_ostream;
+}
+
+/**
+ * Warnings accepted as known, which aren't emitted again. For legacy code bases with too many warnings to fix at once.
+ *
+ * Each line of the file is the fingerprint of a warning, followed by its check and file, which are only there for humans:
+ *     5f2e0c9a41d7b3e8 qdeleteall src/widgets/view.cpp
+ *
+ * The fingerprint hashes the check, the path relative to the directory containing the file, the warning's message
+ * and its line of code without whitespace, instead of the line number, so it survives unrelated edits to the file.
+ * Identical warnings on identical lines of the same file share the fingerprint.
+ *
+ * Enabled by setting CLAZY_BASELINE to the file name. Generate one with CLAZY_EXPORT_BASELINE, see BaselineExporter.
+ */
+class Baseline
+{
+public:
+    /**
+     * Returns the baseline CLAZY_BASELINE points to, read once and shared by every translation unit of the process.
+     * Returns nullptr if it's not set or can't be read.
+     */
+    static const Baseline *instance();
+
+    /**
+     * Returns the fingerprint of a warning, paths are made relative to rootDir.
+     */
+    static uint64_t fingerprint(const clang::SourceManager &sm, clang::SourceLocation loc, llvm::StringRef checkName,
+                                llvm::StringRef message, llvm::StringRef rootDir);
+
+    /**
+     * Returns the path of loc's file relative to rootDir, with forward slashes. Absolute if it's not inside rootDir.
+     */
+    static std::string relativePath(const clang::SourceManager &sm, clang::SourceLocation loc, llvm::StringRef rootDir);
+
+    bool contains(uint64_t fingerprint) const
+    {
+        return m_fingerprints.count(fingerprint) != 0;
+    }
+
+    const std::string &rootDir() const
+    {
+        return m_rootDir;
+    }
+
+private:
+    Baseline() = default;
+    bool read(const std::string &filename);
+
+    std::unordered_set<uint64_t> m_fingerprints;
+    std::string m_rootDir;
+};
+
+/**
+ * Appends a baseline line for each warning, to create the file CLAZY_BASELINE reads. The paths are relative to the
+ * directory the file is in, so it should go in the same place as the baseline.
+ *
+ * Like JsonlExporter, every line is a single write() to a file opened for appending, so parallel builds can share it.
+ * Duplicates from headers included by several translation units are harmless, but can be removed with "sort -u".
+ *
+ * Enabled by setting CLAZY_EXPORT_BASELINE to the file name.
+ */
+class BaselineExporter
+{
+public:
+    BaselineExporter(const clang::SourceManager &sm, const std::string &filename);
+    ~BaselineExporter();
+
+    const std::string &rootDir() const
+    {
+        return m_rootDir;
+    }
+
+    void write(uint64_t fingerprint, llvm::StringRef checkName, clang::SourceLocation loc);
+
+private:
+    const clang::SourceManager &m_sm;
+    std::string m_rootDir;
+    std::unique_ptr<llvm::raw_fd_ostream> m_stream;
+};
+
+#endif
@@ -0,0 +1,217 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "CheckHistory.h"
+
+#include <clang/Tooling/CompilationDatabase.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+
+using namespace std;
+
+static const char s_magic[] = "clazy-check-history-1";
+
+static string directoryOf(const string &file)
+{
+    const llvm::StringRef directory = llvm::sys::path::parent_path(file);
+    return directory.empty() ? "." : directory.str();
+}
+
+CheckHistory::CheckHistory(const string &filename, unsigned int quietRuns, unsigned int rerunInterval)
+    : m_filename(filename)
+    , m_quietRuns(quietRuns)
+    , m_rerunInterval(rerunInterval)
+{
+}
+
+// Format: magic, "runs <number>", then a "dir <stamp> <directory>" line per directory, followed by
+// a "<quiet runs> <check>" line per check which ran there
+void CheckHistory::load(const clang::tooling::CompilationDatabase &compilations, const vector<string> &files)
+{
+    // The content of each source file, so touching it doesn't count as a change
+    map<string, llvm::MD5> hashes;
+    vector<string> sortedFiles = files;
+    std::sort(sortedFiles.begin(), sortedFiles.end());
+    for (const string &file : sortedFiles) {
+        llvm::MD5 &hash = hashes[directoryOf(file)];
+        hash.update(file);
+        if (auto buffer = llvm::MemoryBuffer::getFile(file))
+            hash.update((*buffer)->getBuffer());
+        for (const clang::tooling::CompileCommand &command : compilations.getCompileCommands(file)) {
+            for (const string &arg : command.CommandLine) {
+                hash.update("\n");
+                hash.update(arg);
+            }
+        }
+    }
+
+    for (auto &it : hashes) {
+        llvm::MD5::MD5Result result;
+        it.second.final(result);
+        llvm::SmallString<32> hexHash;
+        llvm::MD5::stringifyResult(result, hexHash);
+        m_currentStamps[it.first] = hexHash.str().str();
+    }
+
+    auto buffer = llvm::MemoryBuffer::getFile(m_filename);
+    if (!buffer)
+        return;
+
+    llvm::SmallVector<llvm::StringRef, 256> lines;
+    (*buffer)->getBuffer().split(lines, '\n', -1, /*KeepEmpty=*/ false);
+    if (lines.size() < 2 || lines[0] != s_magic || !lines[1].consume_front("runs ") || lines[1].getAsInteger(10, m_numRuns)
+        || !readDirectories(llvm::ArrayRef<llvm::StringRef>(lines).drop_front(2))) {
+        llvm::errs() << "clazy-standalone: Ignoring corrupt " << m_filename << "\n";
+        m_numRuns = 0;
+        m_directories.clear();
+    }
+}
+
+bool CheckHistory::readDirectories(llvm::ArrayRef<llvm::StringRef> lines)
+{
+    Directory *directory = nullptr;
+    for (llvm::StringRef line : lines) {
+        llvm::StringRef first, rest;
+        std::tie(first, rest) = line.split(' ');
+        if (first == "dir") {
+            llvm::StringRef stamp, name;
+            std::tie(stamp, name) = rest.split(' ');
+            if (name.empty())
+                return false;
+            directory = &m_directories[name.str()];
+            directory->stamp = stamp.str();
+            continue;
+        }
+
+        unsigned int quietRuns = 0;
+        if (!directory || rest.empty() || first.getAsInteger(10, quietRuns))
+            return false;
+        directory->quietRuns[rest.str()] = quietRuns;
+    }
+
+    return true;
+}
+
+bool CheckHistory::isFullRun() const
+{
+    return m_rerunInterval > 0 && m_numRuns % m_rerunInterval == 0;
+}
+
+string CheckHistory::checksFor(const string &file, const string &checks) const
+{
+    string result = checks.empty() ? "level1" : checks; // clazy-standalone's default, "no-" alone would disable everything
+    if (isFullRun())
+        return result;
+
+    const string name = directoryOf(file);
+    auto it = m_directories.find(name);
+    auto stampIt = m_currentStamps.find(name);
+    if (it == m_directories.end() || stampIt == m_currentStamps.end() || stampIt->second != it->second.stamp)
+        return result;
+
+    for (const auto &check : it->second.quietRuns) {
+        if (check.second >= m_quietRuns)
+            result += ",no-" + check.first;
+    }
+
+    return result;
+}
+
+size_t CheckHistory::numSkippedChecks() const
+{
+    size_t count = 0;
+    for (const auto &it : m_currentStamps) {
+        // Same condition as checksFor()
+        auto dirIt = m_directories.find(it.first);
+        if (isFullRun() || dirIt == m_directories.end() || dirIt->second.stamp != it.second)
+            continue;
+
+        count += std::count_if(dirIt->second.quietRuns.cbegin(), dirIt->second.quietRuns.cend(),
+                               [this](const pair<const string, unsigned int> &check) { return check.second >= m_quietRuns; });
+    }
+
+    return count;
+}
+
+void CheckHistory::record(const string &file, const vector<TranslationUnitStats::Check> &checks)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    map<string, uint64_t> &warnings = m_warnings[directoryOf(file)];
+    for (const TranslationUnitStats::Check &check : checks)
+        warnings[check.name] += check.warnings;
+}
+
+bool CheckHistory::write() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Skipped checks, and directories not analyzed this time, keep their previous count
+    map<string, Directory> directories = m_directories;
+    for (const auto &it : m_warnings) {
+        Directory &directory = directories[it.first];
+        for (const auto &check : it.second) {
+            unsigned int &quietRuns = directory.quietRuns[check.first];
+            quietRuns = check.second == 0 ? quietRuns + 1 : 0;
+        }
+    }
+
+    for (const auto &it : m_currentStamps)
+        directories[it.first].stamp = it.second;
+
+    // Several shards might be recording into the same file, don't let them read a partial one
+    int fd = -1;
+    llvm::SmallString<128> tmpFilename;
+    if (llvm::sys::fs::createUniqueFile(m_filename + "-%%%%%%", fd, tmpFilename))
+        return false;
+
+    llvm::raw_fd_ostream os(fd, /*shouldClose=*/ true);
+    os << s_magic << '\n' << "runs " << m_numRuns + 1 << '\n';
+    for (const auto &it : directories) {
+        os << "dir " << it.second.stamp << ' ' << it.first << '\n';
+        for (const auto &check : it.second.quietRuns)
+            os << check.second << ' ' << check.first << '\n';
+    }
+    os.close();
+
+    if (os.has_error()) {
+        os.clear_error(); // Or its destructor aborts
+        llvm::sys::fs::remove(tmpFilename);
+        return false;
+    }
+
+    if (llvm::sys::fs::rename(tmpFilename, m_filename)) {
+        llvm::sys::fs::remove(tmpFilename);
+        return false;
+    }
+
+    return true;
+}
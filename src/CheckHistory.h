@@ -0,0 +1,97 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_CHECK_HISTORY_H
+#define CLAZY_CHECK_HISTORY_H
+
+#include "RunStats.h"
+
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/StringRef.h>
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace clang {
+namespace tooling {
+class CompilationDatabase;
+}
+}
+
+/**
+ * Which checks warned in each directory over the previous runs, for clazy-standalone -check-history.
+ *
+ * A check which didn't warn in a directory for quietRuns runs in a row is skipped there, until one of the
+ * directory's source files or compile commands changes. Every rerunInterval-th run analyzes with all checks,
+ * so warnings caused by headers outside of the directory aren't missed forever.
+ *
+ * record() is thread-safe, as -j records from several threads.
+ */
+class CheckHistory
+{
+public:
+    CheckHistory(const std::string &filename, unsigned int quietRuns, unsigned int rerunInterval);
+
+    /**
+     * Reads the history, if there's one, and computes the current state of the directories of files.
+     * An unreadable or corrupt history is ignored, all checks run then.
+     */
+    void load(const clang::tooling::CompilationDatabase &compilations, const std::vector<std::string> &files);
+
+    /**
+     * Returns checks, with the ones to skip for this file disabled.
+     */
+    std::string checksFor(const std::string &file, const std::string &checks) const;
+
+    void record(const std::string &file, const std::vector<TranslationUnitStats::Check> &checks);
+
+    /**
+     * Writes the updated history. Returns false on failure.
+     */
+    bool write() const;
+
+    bool isFullRun() const;
+    size_t numSkippedChecks() const; // Summed over the directories
+
+private:
+    struct Directory {
+        std::string stamp; // MD5 of the source files and their compile commands
+        std::map<std::string, unsigned int> quietRuns; // By check name, runs in a row without warnings
+    };
+
+    bool readDirectories(llvm::ArrayRef<llvm::StringRef> lines);
+
+    const std::string m_filename;
+    const unsigned int m_quietRuns;
+    const unsigned int m_rerunInterval;
+    unsigned int m_numRuns = 0; // Before this one
+    std::map<std::string, Directory> m_directories; // Sorted, so the file can be diffed
+    std::map<std::string, std::string> m_currentStamps; // Of the directories analyzed by this run
+
+    mutable std::mutex m_mutex;
+    std::map<std::string, std::map<std::string, uint64_t>> m_warnings; // Of this run, by directory and check
+};
+
+#endif
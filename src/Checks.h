@@ -27,30 +27,81 @@
  */
 
 #include "checkmanager.h"
+#include "checks/manuallevel/algorithm-callable-by-value.h"
 #include "checks/manuallevel/assert-with-side-effects.h"
+#include "checks/manuallevel/atomic-false-sharing.h"
+#include "checks/manuallevel/atomic-memory-order.h"
+#include "checks/manuallevel/busy-polling.h"
+#include "checks/manuallevel/constexpr-lookup-table.h"
 #include "checks/manuallevel/container-inside-loop.h"
+#include "checks/manuallevel/detaching-lambda-capture.h"
 #include "checks/manuallevel/detaching-member.h"
+#include "checks/manuallevel/double-lookup.h"
+#include "checks/manuallevel/emplace-candidates.h"
+#include "checks/manuallevel/endl-in-loop.h"
+#include "checks/manuallevel/erase-in-loop.h"
+#include "checks/manuallevel/findchild-in-loop.h"
+#include "checks/manuallevel/function-args-sink.h"
+#include "checks/manuallevel/gui-thread-blocking.h"
 #include "checks/manuallevel/heap-allocated-small-trivial-type.h"
+#include "checks/manuallevel/heterogeneous-lookup.h"
+#include "checks/manuallevel/hot-path-allocations.h"
 #include "checks/manuallevel/ifndef-define-typo.h"
+#include "checks/manuallevel/ineffective-move.h"
 #include "checks/manuallevel/inefficient-qlist.h"
+#include "checks/manuallevel/invoke-method-by-name.h"
 #include "checks/manuallevel/isempty-vs-count.h"
+#include "checks/manuallevel/keyed-lookup-in-loop.h"
+#include "checks/manuallevel/large-signal-arguments.h"
+#include "checks/manuallevel/linear-search-in-loop.h"
+#include "checks/manuallevel/lookup-key-allocations.h"
+#include "checks/manuallevel/loop-invariant-call.h"
+#include "checks/manuallevel/make-shared-candidates.h"
+#include "checks/manuallevel/missing-move.h"
+#include "checks/manuallevel/model-signals-in-loop.h"
+#include "checks/manuallevel/move-not-noexcept.h"
+#include "checks/manuallevel/qdatetime-elapsed.h"
+#include "checks/manuallevel/qdebug-in-loop.h"
+#include "checks/manuallevel/qhash-allocations.h"
 #include "checks/manuallevel/qhash-with-char-pointer-key.h"
+#include "checks/manuallevel/qimage-pixel-in-loop.h"
+#include "checks/manuallevel/qobject-in-loop.h"
+#include "checks/manuallevel/qproperty-container-getter.h"
 #include "checks/manuallevel/qproperty-type-mismatch.h"
 #include "checks/manuallevel/qrequiredresult-candidates.h"
+#include "checks/manuallevel/qstring-split-single-use.h"
 #include "checks/manuallevel/qstring-varargs.h"
+#include "checks/manuallevel/qstringview-parameter.h"
 #include "checks/manuallevel/qt-keywords.h"
 #include "checks/manuallevel/qt4-qstring-from-array.h"
+#include "checks/manuallevel/qvariant-allocations.h"
 #include "checks/manuallevel/qvariant-template-instantiation.h"
+#include "checks/manuallevel/qvariantmap-as-struct.h"
 #include "checks/manuallevel/raw-environment-function.h"
+#include "checks/manuallevel/regex-from-literal.h"
+#include "checks/manuallevel/repeated-string-conversion.h"
 #include "checks/manuallevel/reserve-candidates.h"
+#include "checks/manuallevel/shared-pointer-copies.h"
 #include "checks/manuallevel/signal-with-return-value.h"
+#include "checks/manuallevel/small-local-vector.h"
+#include "checks/manuallevel/startup-latency.h"
+#include "checks/manuallevel/std-function-overhead.h"
+#include "checks/manuallevel/string-concatenation-in-loop.h"
+#include "checks/manuallevel/struct-padding.h"
+#include "checks/manuallevel/task-capture-copy.h"
 #include "checks/manuallevel/thread-with-slots.h"
 #include "checks/manuallevel/tr-non-literal.h"
+#include "checks/manuallevel/unconnected-signal-payload.h"
 #include "checks/manuallevel/unneeded-cast.h"
+#include "checks/manuallevel/unneeded-local-copy.h"
+#include "checks/manuallevel/unordered-map-candidates.h"
+#include "checks/manuallevel/virtual-call-in-loop.h"
+#include "checks/manuallevel/wide-lock-scope.h"
 #include "checks/level0/connect-by-name.h"
 #include "checks/level0/connect-non-signal.h"
 #include "checks/level0/connect-not-normalized.h"
 #include "checks/level0/container-anti-pattern.h"
+#include "checks/level0/discarded-result.h"
 #include "checks/level0/empty-qstringliteral.h"
 #include "checks/level0/fully-qualified-moc-types.h"
 #include "checks/level0/lambda-in-connect.h"
@@ -113,111 +164,183 @@
 #include "checks/level2/virtual-call-ctor.h"
 
 template <typename T>
-RegisteredCheck check(const char *name, CheckLevel level, RegisteredCheck::Options options = RegisteredCheck::Option_None)
+RegisteredCheck check(const char *name, CheckLevel level, RegisteredCheck::Cost cost, RegisteredCheck::Options options = RegisteredCheck::Option_None,
+                      const std::vector<std::string> &stmtClasses = {}, const std::vector<std::string> &declClasses = {})
 {
     auto factoryFuntion = [name](ClazyContext *context){ return new T(name, context); };
-    return RegisteredCheck{name, level, factoryFuntion, options};
+    return RegisteredCheck{name, level, cost, factoryFuntion, options, stmtClasses, declClasses};
 }
 
 void CheckManager::registerChecks()
 {
-    registerCheck(check<AssertWithSideEffects>("assert-with-side-effects", ManualCheckLevel,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<ContainerInsideLoop>("container-inside-loop", ManualCheckLevel,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<DetachingMember>("detaching-member", ManualCheckLevel,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<HeapAllocatedSmallTrivialType>("heap-allocated-small-trivial-type", ManualCheckLevel,  RegisteredCheck::Option_VisitsDecls));
-    registerCheck(check<IfndefDefineTypo>("ifndef-define-typo", ManualCheckLevel, RegisteredCheck::Option_None));
-    registerCheck(check<InefficientQList>("inefficient-qlist", ManualCheckLevel,  RegisteredCheck::Option_VisitsDecls));
-    registerCheck(check<IsEmptyVSCount>("isempty-vs-count", ManualCheckLevel,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<QHashWithCharPointerKey>("qhash-with-char-pointer-key", ManualCheckLevel,  RegisteredCheck::Option_VisitsDecls));
-    registerCheck(check<QPropertyTypeMismatch>("qproperty-type-mismatch", ManualCheckLevel,  RegisteredCheck::Option_VisitsDecls));
-    registerCheck(check<QRequiredResultCandidates>("qrequiredresult-candidates", ManualCheckLevel,  RegisteredCheck::Option_VisitsDecls));
-    registerCheck(check<QStringVarargs>("qstring-varargs", ManualCheckLevel,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<QtKeywords>("qt-keywords", ManualCheckLevel, RegisteredCheck::Option_None));
+    registerCheck(check<AlgorithmCallableByValue>("algorithm-callable-by-value", ManualCheckLevel, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CallExpr"}));
+    registerFixIt(1, "fix-algorithm-callable-by-value", "algorithm-callable-by-value");
+    registerCheck(check<AssertWithSideEffects>("assert-with-side-effects", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts));
+    registerCheck(check<AtomicFalseSharing>("atomic-false-sharing", ManualCheckLevel, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_Performance, {}, {"CXXRecordDecl", "FieldDecl", "VarDecl"}));
+    registerCheck(check<AtomicMemoryOrder>("atomic-memory-order", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CallExpr", "DoStmt", "ForStmt", "WhileStmt"}));
+    registerCheck(check<BusyPolling>("busy-polling", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CXXMemberCallExpr", "WhileStmt", "DoStmt", "ForStmt"}));
+    registerCheck(check<ConstexprLookupTable>("constexpr-lookup-table", ManualCheckLevel, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_Performance, {}, {"VarDecl"}));
+    registerCheck(check<ContainerInsideLoop>("container-inside-loop", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_NeedsParentMap | RegisteredCheck::Option_Performance, {"CXXConstructExpr"}));
+    registerFixIt(1, "fix-container-inside-loop", "container-inside-loop");
+    registerCheck(check<DetachingLambdaCapture>("detaching-lambda-capture", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_NeedsParentMap | RegisteredCheck::Option_Performance, {"LambdaExpr"}));
+    registerCheck(check<DetachingMember>("detaching-member", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CallExpr"}));
+    registerCheck(check<DoubleLookup>("double-lookup", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CXXMemberCallExpr"}));
+    registerCheck(check<EmplaceCandidates>("emplace-candidates", ManualCheckLevel, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CXXMemberCallExpr"}));
+    registerFixIt(1, "fix-emplace-candidates", "emplace-candidates");
+    registerCheck(check<EndlInLoop>("endl-in-loop", ManualCheckLevel, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CXXOperatorCallExpr", "CXXMemberCallExpr"}));
+    registerFixIt(1, "fix-endl-in-loop", "endl-in-loop");
+    registerCheck(check<EraseInLoop>("erase-in-loop", ManualCheckLevel, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CXXMemberCallExpr"}));
+    registerCheck(check<FindchildInLoop>("findchild-in-loop", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CXXMemberCallExpr"}));
+    registerCheck(check<FunctionArgsSink>("function-args-sink", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_Performance));
+    registerFixIt(1, "fix-function-args-sink", "function-args-sink");
+    registerCheck(check<GuiThreadBlocking>("gui-thread-blocking", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_Performance));
+    registerCheck(check<HeapAllocatedSmallTrivialType>("heap-allocated-small-trivial-type", ManualCheckLevel, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_Performance, {}, {"VarDecl", "FieldDecl"}));
+    registerCheck(check<HeterogeneousLookup>("heterogeneous-lookup", ManualCheckLevel, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_NeedsParentMap | RegisteredCheck::Option_Performance, {"CXXMemberCallExpr"}));
+    registerFixIt(1, "fix-heterogeneous-lookup", "heterogeneous-lookup");
+    registerCheck(check<HotPathAllocations>("hot-path-allocations", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_Performance));
+    registerCheck(check<IfndefDefineTypo>("ifndef-define-typo", ManualCheckLevel, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_IgnoresFunctionBodies));
+    registerCheck(check<IneffectiveMove>("ineffective-move", ManualCheckLevel, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_Performance, {"CallExpr", "ReturnStmt"}, {"FunctionDecl"}));
+    registerFixIt(1, "fix-ineffective-move", "ineffective-move");
+    registerCheck(check<InefficientQList>("inefficient-qlist", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_Performance));
+    registerCheck(check<InvokeMethodByName>("invoke-method-by-name", ManualCheckLevel, RegisteredCheck::Cost_Cheap, RegisteredCheck::Option_Qt4Incompatible | RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CallExpr"}));
+    registerFixIt(1, "fix-invoke-method-by-name", "invoke-method-by-name");
+    registerCheck(check<IsEmptyVSCount>("isempty-vs-count", ManualCheckLevel, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts, {"ImplicitCastExpr", "UnaryOperator", "BinaryOperator", "CXXMemberCallExpr"}));
+    registerFixIt(1, "fix-isempty-vs-count", "isempty-vs-count");
+    registerCheck(check<KeyedLookupInLoop>("keyed-lookup-in-loop", ManualCheckLevel, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CXXConstructExpr", "CallExpr"}));
+    registerCheck(check<LargeSignalArguments>("large-signal-arguments", ManualCheckLevel, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_Performance, {"CallExpr"}, {"CXXMethodDecl"}));
+    registerCheck(check<LinearSearchInLoop>("linear-search-in-loop", ManualCheckLevel, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CallExpr"}));
+    registerCheck(check<LookupKeyAllocations>("lookup-key-allocations", ManualCheckLevel, RegisteredCheck::Cost_Expensive,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance));
+    registerCheck(check<LoopInvariantCall>("loop-invariant-call", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CallExpr"}));
+    registerCheck(check<MakeSharedCandidates>("make-shared-candidates", ManualCheckLevel, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_NeedsParentMap | RegisteredCheck::Option_Performance, {"CXXConstructExpr", "CXXTemporaryObjectExpr"}));
+    registerFixIt(1, "fix-make-shared-candidates", "make-shared-candidates");
+    registerCheck(check<MissingMove>("missing-move", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_NeedsParentMap | RegisteredCheck::Option_Performance, {"CXXConstructExpr", "CXXOperatorCallExpr"}));
+    registerFixIt(1, "fix-missing-move", "missing-move");
+    registerCheck(check<ModelSignalsInLoop>("model-signals-in-loop", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CXXMemberCallExpr"}));
+    registerCheck(check<MoveNotNoexcept>("move-not-noexcept", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_Performance));
+    registerFixIt(1, "fix-move-not-noexcept", "move-not-noexcept");
+    registerCheck(check<QDatetimeElapsed>("qdatetime-elapsed", ManualCheckLevel, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CXXMemberCallExpr", "BinaryOperator", "CXXOperatorCallExpr"}));
+    registerCheck(check<QDebugInLoop>("qdebug-in-loop", ManualCheckLevel, RegisteredCheck::Cost_Expensive,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance));
+    registerCheck(check<QHashAllocations>("qhash-allocations", ManualCheckLevel, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_Performance, {}, {"FunctionDecl", "CXXMethodDecl"}));
+    registerCheck(check<QHashWithCharPointerKey>("qhash-with-char-pointer-key", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsDecls));
+    registerCheck(check<QImagePixelInLoop>("qimage-pixel-in-loop", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CXXMemberCallExpr"}));
+    registerCheck(check<QObjectInLoop>("qobject-in-loop", ManualCheckLevel, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CXXNewExpr", "CXXConstructExpr", "CallExpr"}));
+    registerCheck(check<QPropertyContainerGetter>("qproperty-container-getter", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_Performance));
+    registerCheck(check<QPropertyTypeMismatch>("qproperty-type-mismatch", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsDecls));
+    registerCheck(check<QRequiredResultCandidates>("qrequiredresult-candidates", ManualCheckLevel, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsDecls, {}, {"CXXMethodDecl"}));
+    registerCheck(check<QStringSplitSingleUse>("qstring-split-single-use", ManualCheckLevel, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_NeedsParentMap | RegisteredCheck::Option_Performance, {"CXXMemberCallExpr"}));
+    registerCheck(check<QStringVarargs>("qstring-varargs", ManualCheckLevel, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts, {"BinaryOperator"}));
+    registerCheck(check<QStringviewParameter>("qstringview-parameter", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_NeedsParentMap | RegisteredCheck::Option_Performance));
+    registerCheck(check<QtKeywords>("qt-keywords", ManualCheckLevel, RegisteredCheck::Cost_Cheap, RegisteredCheck::Option_None));
     registerFixIt(1, "fix-qt-keywords", "qt-keywords");
-    registerCheck(check<Qt4QStringFromArray>("qt4-qstring-from-array", ManualCheckLevel,  RegisteredCheck::Option_VisitsStmts));
+    registerCheck(check<Qt4QStringFromArray>("qt4-qstring-from-array", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_NeedsParentMap, {"CXXConstructExpr", "CXXOperatorCallExpr", "CXXMemberCallExpr"}));
     registerFixIt(1, "fix-qt4-qstring-from-array", "qt4-qstring-from-array");
-    registerCheck(check<QVariantTemplateInstantiation>("qvariant-template-instantiation", ManualCheckLevel,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<RawEnvironmentFunction>("raw-environment-function", ManualCheckLevel,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<ReserveCandidates>("reserve-candidates", ManualCheckLevel,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<SignalWithReturnValue>("signal-with-return-value", ManualCheckLevel,  RegisteredCheck::Option_VisitsDecls));
-    registerCheck(check<ThreadWithSlots>("thread-with-slots", ManualCheckLevel,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_VisitsDecls));
-    registerCheck(check<TrNonLiteral>("tr-non-literal", ManualCheckLevel,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<UnneededCast>("unneeded-cast", ManualCheckLevel,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<ConnectByName>("connect-by-name", CheckLevel0,  RegisteredCheck::Option_VisitsDecls));
-    registerCheck(check<ConnectNonSignal>("connect-non-signal", CheckLevel0, RegisteredCheck::Option_Qt4Incompatible | RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<ConnectNotNormalized>("connect-not-normalized", CheckLevel0,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<ContainerAntiPattern>("container-anti-pattern", CheckLevel0,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<EmptyQStringliteral>("empty-qstringliteral", CheckLevel0,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<FullyQualifiedMocTypes>("fully-qualified-moc-types", CheckLevel0,  RegisteredCheck::Option_VisitsDecls));
-    registerCheck(check<LambdaInConnect>("lambda-in-connect", CheckLevel0,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<LambdaUniqueConnection>("lambda-unique-connection", CheckLevel0,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<LowercaseQMlTypeName>("lowercase-qml-type-name", CheckLevel0,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<MutableContainerKey>("mutable-container-key", CheckLevel0,  RegisteredCheck::Option_VisitsDecls));
-    registerCheck(check<OverloadedSignal>("overloaded-signal", CheckLevel0,  RegisteredCheck::Option_VisitsDecls));
+    registerCheck(check<QVariantAllocations>("qvariant-allocations", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CXXConstructExpr", "CallExpr"}));
+    registerCheck(check<QVariantTemplateInstantiation>("qvariant-template-instantiation", ManualCheckLevel, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts, {"CXXMemberCallExpr"}));
+    registerCheck(check<QVariantmapAsStruct>("qvariantmap-as-struct", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_NeedsParentMap | RegisteredCheck::Option_Performance, {"DeclStmt"}));
+    registerCheck(check<RawEnvironmentFunction>("raw-environment-function", ManualCheckLevel, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts, {"CallExpr"}));
+    registerCheck(check<RegexFromLiteral>("regex-from-literal", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_NeedsParentMap | RegisteredCheck::Option_Performance, {"CXXConstructExpr"}));
+    registerFixIt(1, "fix-regex-from-literal", "regex-from-literal");
+    registerCheck(check<RepeatedStringConversion>("repeated-string-conversion", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_NeedsParentMap | RegisteredCheck::Option_Performance, {"CallExpr"}));
+    registerCheck(check<ReserveCandidates>("reserve-candidates", ManualCheckLevel, RegisteredCheck::Cost_Expensive,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_NeedsParentMap | RegisteredCheck::Option_Performance));
+    registerFixIt(1, "fix-reserve-candidates", "reserve-candidates");
+    registerCheck(check<SharedPointerCopies>("shared-pointer-copies", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_NeedsParentMap | RegisteredCheck::Option_Performance, {"LambdaExpr", "CXXForRangeStmt"}, {"FunctionDecl"}));
+    registerFixIt(1, "fix-shared-pointer-copies", "shared-pointer-copies");
+    registerCheck(check<SignalWithReturnValue>("signal-with-return-value", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsDecls));
+    registerCheck(check<SmallLocalVector>("small-local-vector", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_Performance, {}, {"VarDecl"}));
+    registerCheck(check<StartupLatency>("startup-latency", ManualCheckLevel, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_Performance, {}, {"VarDecl", "FunctionDecl"}));
+    registerCheck(check<StdFunctionOverhead>("std-function-overhead", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_Performance, {"CXXOperatorCallExpr"}));
+    registerCheck(check<StringConcatenationInLoop>("string-concatenation-in-loop", ManualCheckLevel, RegisteredCheck::Cost_Expensive,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance));
+    registerCheck(check<StructPadding>("struct-padding", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_Performance));
+    registerCheck(check<TaskCaptureCopy>("task-capture-copy", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CallExpr", "CXXConstructExpr"}));
+    registerCheck(check<ThreadWithSlots>("thread-with-slots", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_VisitsDecls));
+    registerCheck(check<TrNonLiteral>("tr-non-literal", ManualCheckLevel, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts, {"CallExpr"}));
+    registerCheck(check<UnconnectedSignalPayload>("unconnected-signal-payload", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_NeedsParentMap | RegisteredCheck::Option_Performance, {"CXXMemberCallExpr"}));
+    registerCheck(check<UnneededCast>("unneeded-cast", ManualCheckLevel, RegisteredCheck::Cost_Expensive,  RegisteredCheck::Option_VisitsStmts));
+    registerCheck(check<UnneededLocalCopy>("unneeded-local-copy", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_NeedsParentMap | RegisteredCheck::Option_Performance, {"DeclStmt"}));
+    registerFixIt(1, "fix-unneeded-local-copy", "unneeded-local-copy");
+    registerCheck(check<UnorderedMapCandidates>("unordered-map-candidates", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_Performance));
+    registerCheck(check<VirtualCallInLoop>("virtual-call-in-loop", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CXXMemberCallExpr"}));
+    registerCheck(check<WideLockScope>("wide-lock-scope", ManualCheckLevel, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_NeedsParentMap | RegisteredCheck::Option_Performance, {"DeclStmt"}));
+    registerCheck(check<ConnectByName>("connect-by-name", CheckLevel0, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_IgnoresFunctionBodies, {}, {"CXXRecordDecl"}));
+    registerCheck(check<ConnectNonSignal>("connect-non-signal", CheckLevel0, RegisteredCheck::Cost_Cheap, RegisteredCheck::Option_Qt4Incompatible | RegisteredCheck::Option_VisitsStmts, {"CallExpr"}));
+    registerCheck(check<ConnectNotNormalized>("connect-not-normalized", CheckLevel0, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_NeedsParentMap | RegisteredCheck::Option_Performance, {"CXXConstructExpr", "CallExpr"}));
+    registerCheck(check<ContainerAntiPattern>("container-anti-pattern", CheckLevel0, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance));
+    registerFixIt(1, "fix-container-anti-pattern", "container-anti-pattern");
+    registerCheck(check<DiscardedResult>("discarded-result", CheckLevel0, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CXXMemberCallExpr"}));
+    registerCheck(check<EmptyQStringliteral>("empty-qstringliteral", CheckLevel0, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"DeclStmt"}));
+    registerCheck(check<FullyQualifiedMocTypes>("fully-qualified-moc-types", CheckLevel0, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsDecls, {}, {"CXXMethodDecl"}));
+    registerCheck(check<LambdaInConnect>("lambda-in-connect", CheckLevel0, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts, {"LambdaExpr"}));
+    registerCheck(check<LambdaUniqueConnection>("lambda-unique-connection", CheckLevel0, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts, {"CallExpr"}));
+    registerCheck(check<LowercaseQMlTypeName>("lowercase-qml-type-name", CheckLevel0, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts, {"CallExpr"}));
+    registerCheck(check<MutableContainerKey>("mutable-container-key", CheckLevel0, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsDecls));
+    registerCheck(check<OverloadedSignal>("overloaded-signal", CheckLevel0, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsDecls));
 #ifndef CLAZY_DISABLE_AST_MATCHERS
-    registerCheck(check<QColorFromLiteral>("qcolor-from-literal", CheckLevel0,  RegisteredCheck::Option_VisitsStmts));
+    registerCheck(check<QColorFromLiteral>("qcolor-from-literal", CheckLevel0, RegisteredCheck::Cost_Expensive,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CXXMemberCallExpr"}));
 #endif
-    registerCheck(check<QDateTimeUtc>("qdatetime-utc", CheckLevel0,  RegisteredCheck::Option_VisitsStmts));
+    registerCheck(check<QDateTimeUtc>("qdatetime-utc", CheckLevel0, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CXXMemberCallExpr"}));
     registerFixIt(1, "fix-qdatetime-utc", "qdatetime-utc");
-    registerCheck(check<QEnums>("qenums", CheckLevel0, RegisteredCheck::Option_Qt4Incompatible));
-    registerCheck(check<QFileInfoExists>("qfileinfo-exists", CheckLevel0,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<QGetEnv>("qgetenv", CheckLevel0, RegisteredCheck::Option_Qt4Incompatible | RegisteredCheck::Option_VisitsStmts));
+    registerCheck(check<QEnums>("qenums", CheckLevel0, RegisteredCheck::Cost_Cheap, RegisteredCheck::Option_Qt4Incompatible | RegisteredCheck::Option_IgnoresFunctionBodies));
+    registerCheck(check<QFileInfoExists>("qfileinfo-exists", CheckLevel0, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_CacheSafe | RegisteredCheck::Option_Performance, {"CXXMemberCallExpr"}));
+    registerCheck(check<QGetEnv>("qgetenv", CheckLevel0, RegisteredCheck::Cost_Cheap, RegisteredCheck::Option_Qt4Incompatible | RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CXXMemberCallExpr"}));
     registerFixIt(1, "fix-qgetenv", "qgetenv");
-    registerCheck(check<QMapWithPointerKey>("qmap-with-pointer-key", CheckLevel0,  RegisteredCheck::Option_VisitsDecls));
-    registerCheck(check<QStringArg>("qstring-arg", CheckLevel0,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<QStringInsensitiveAllocation>("qstring-insensitive-allocation", CheckLevel0,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<StringRefCandidates>("qstring-ref", CheckLevel0,  RegisteredCheck::Option_VisitsStmts));
+    registerCheck(check<QMapWithPointerKey>("qmap-with-pointer-key", CheckLevel0, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_CacheSafe | RegisteredCheck::Option_Performance));
+    registerCheck(check<QStringArg>("qstring-arg", CheckLevel0, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CXXMemberCallExpr"}));
+    registerFixIt(1, "fix-qstring-arg", "qstring-arg");
+    registerCheck(check<QStringInsensitiveAllocation>("qstring-insensitive-allocation", CheckLevel0, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CallExpr"}));
+    registerCheck(check<StringRefCandidates>("qstring-ref", CheckLevel0, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_NeedsParentMap | RegisteredCheck::Option_Performance, {"CallExpr", "CXXForRangeStmt"}));
     registerFixIt(1, "fix-missing-qstringref", "qstring-ref");
-    registerCheck(check<QtMacros>("qt-macros", CheckLevel0, RegisteredCheck::Option_None));
-    registerCheck(check<StrictIterators>("strict-iterators", CheckLevel0,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<TemporaryIterator>("temporary-iterator", CheckLevel0,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<UnusedNonTrivialVariable>("unused-non-trivial-variable", CheckLevel0,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<WritingToTemporary>("writing-to-temporary", CheckLevel0,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<WrongQEventCast>("wrong-qevent-cast", CheckLevel0,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<WrongQGlobalStatic>("wrong-qglobalstatic", CheckLevel0,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<AutoUnexpectedQStringBuilder>("auto-unexpected-qstringbuilder", CheckLevel1,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_VisitsDecls));
+    registerCheck(check<QtMacros>("qt-macros", CheckLevel0, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_IgnoresFunctionBodies));
+    registerCheck(check<StrictIterators>("strict-iterators", CheckLevel0, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_NeedsParentMap | RegisteredCheck::Option_Performance, {"CXXOperatorCallExpr", "ImplicitCastExpr"}));
+    registerCheck(check<TemporaryIterator>("temporary-iterator", CheckLevel0, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_NeedsParentMap, {"CXXMemberCallExpr"}));
+    registerCheck(check<UnusedNonTrivialVariable>("unused-non-trivial-variable", CheckLevel0, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts, {"DeclStmt"}));
+    registerCheck(check<WritingToTemporary>("writing-to-temporary", CheckLevel0, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts, {"CallExpr"}));
+    registerCheck(check<WrongQEventCast>("wrong-qevent-cast", CheckLevel0, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_NeedsParentMap, {"CXXStaticCastExpr"}));
+    registerCheck(check<WrongQGlobalStatic>("wrong-qglobalstatic", CheckLevel0, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CXXConstructExpr"}));
+    registerCheck(check<AutoUnexpectedQStringBuilder>("auto-unexpected-qstringbuilder", CheckLevel1, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_VisitsDecls));
     registerFixIt(1, "fix-auto-unexpected-qstringbuilder", "auto-unexpected-qstringbuilder");
-    registerCheck(check<ChildEventQObjectCast>("child-event-qobject-cast", CheckLevel1,  RegisteredCheck::Option_VisitsDecls));
-    registerCheck(check<Connect3ArgLambda>("connect-3arg-lambda", CheckLevel1,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<ConstSignalOrSlot>("const-signal-or-slot", CheckLevel1,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_VisitsDecls));
-    registerCheck(check<DetachingTemporary>("detaching-temporary", CheckLevel1,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<Foreach>("foreach", CheckLevel1,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<IncorrectEmit>("incorrect-emit", CheckLevel1,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<InefficientQListSoft>("inefficient-qlist-soft", CheckLevel1,  RegisteredCheck::Option_VisitsDecls));
-    registerCheck(check<InstallEventFilter>("install-event-filter", CheckLevel1,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<NonPodGlobalStatic>("non-pod-global-static", CheckLevel1,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<OverriddenSignal>("overridden-signal", CheckLevel1,  RegisteredCheck::Option_VisitsDecls));
-    registerCheck(check<PostEvent>("post-event", CheckLevel1,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<QDeleteAll>("qdeleteall", CheckLevel1,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<QHashNamespace>("qhash-namespace", CheckLevel1,  RegisteredCheck::Option_VisitsDecls));
-    registerCheck(check<QLatin1StringNonAscii>("qlatin1string-non-ascii", CheckLevel1,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<QPropertyWithoutNotify>("qproperty-without-notify", CheckLevel1,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<QStringLeft>("qstring-left", CheckLevel1,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<RangeLoop>("range-loop", CheckLevel1,  RegisteredCheck::Option_VisitsStmts));
+    registerCheck(check<ChildEventQObjectCast>("child-event-qobject-cast", CheckLevel1, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsDecls, {}, {"CXXMethodDecl"}));
+    registerCheck(check<Connect3ArgLambda>("connect-3arg-lambda", CheckLevel1, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts, {"CallExpr"}));
+    registerCheck(check<ConstSignalOrSlot>("const-signal-or-slot", CheckLevel1, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_VisitsDecls));
+    registerCheck(check<DetachingTemporary>("detaching-temporary", CheckLevel1, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CallExpr"}));
+    registerCheck(check<Foreach>("foreach", CheckLevel1, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance));
+    registerFixIt(1, "fix-foreach", "foreach");
+    registerCheck(check<IncorrectEmit>("incorrect-emit", CheckLevel1, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts, {"CXXMemberCallExpr"}));
+    registerCheck(check<InefficientQListSoft>("inefficient-qlist-soft", CheckLevel1, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_Performance));
+    registerCheck(check<InstallEventFilter>("install-event-filter", CheckLevel1, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts, {"CXXMemberCallExpr"}));
+    registerCheck(check<NonPodGlobalStatic>("non-pod-global-static", CheckLevel1, RegisteredCheck::Cost_Expensive,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance));
+    registerFixIt(1, "fix-non-pod-global-static", "non-pod-global-static");
+    registerCheck(check<OverriddenSignal>("overridden-signal", CheckLevel1, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsDecls));
+    registerCheck(check<PostEvent>("post-event", CheckLevel1, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts, {"CallExpr"}));
+    registerCheck(check<QDeleteAll>("qdeleteall", CheckLevel1, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CXXMemberCallExpr"}));
+    registerCheck(check<QHashNamespace>("qhash-namespace", CheckLevel1, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_IgnoresFunctionBodies, {}, {"FunctionDecl"}));
+    registerCheck(check<QLatin1StringNonAscii>("qlatin1string-non-ascii", CheckLevel1, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_CacheSafe, {"CXXConstructExpr"}));
+    registerCheck(check<QPropertyWithoutNotify>("qproperty-without-notify", CheckLevel1, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts));
+    registerCheck(check<QStringLeft>("qstring-left", CheckLevel1, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_CacheSafe | RegisteredCheck::Option_Performance, {"CXXMemberCallExpr"}));
+    registerCheck(check<RangeLoop>("range-loop", CheckLevel1, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CXXForRangeStmt"}));
     registerFixIt(1, "fix-range-loop-add-ref", "range-loop");
     registerFixIt(2, "fix-range-loop-add-qasconst", "range-loop");
-    registerCheck(check<ReturningDataFromTemporary>("returning-data-from-temporary", CheckLevel1,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<RuleOfTwoSoft>("rule-of-two-soft", CheckLevel1,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<SkippedBaseMethod>("skipped-base-method", CheckLevel1,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<VirtualSignal>("virtual-signal", CheckLevel1,  RegisteredCheck::Option_VisitsDecls));
-    registerCheck(check<BaseClassEvent>("base-class-event", CheckLevel2,  RegisteredCheck::Option_VisitsDecls));
-    registerCheck(check<CopyablePolymorphic>("copyable-polymorphic", CheckLevel2,  RegisteredCheck::Option_VisitsDecls));
-    registerCheck(check<CtorMissingParentArgument>("ctor-missing-parent-argument", CheckLevel2,  RegisteredCheck::Option_VisitsDecls));
-    registerCheck(check<FunctionArgsByRef>("function-args-by-ref", CheckLevel2,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_VisitsDecls));
+    registerCheck(check<ReturningDataFromTemporary>("returning-data-from-temporary", CheckLevel1, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts, {"ReturnStmt", "DeclStmt"}));
+    registerCheck(check<RuleOfTwoSoft>("rule-of-two-soft", CheckLevel1, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts));
+    registerCheck(check<SkippedBaseMethod>("skipped-base-method", CheckLevel1, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts, {"CXXMemberCallExpr"}));
+    registerCheck(check<VirtualSignal>("virtual-signal", CheckLevel1, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_IgnoresFunctionBodies, {}, {"CXXMethodDecl"}));
+    registerCheck(check<BaseClassEvent>("base-class-event", CheckLevel2, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsDecls, {}, {"CXXMethodDecl"}));
+    registerCheck(check<CopyablePolymorphic>("copyable-polymorphic", CheckLevel2, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_IgnoresFunctionBodies, {}, {"CXXRecordDecl"}));
+    registerCheck(check<CtorMissingParentArgument>("ctor-missing-parent-argument", CheckLevel2, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_IgnoresFunctionBodies));
+    registerCheck(check<FunctionArgsByRef>("function-args-by-ref", CheckLevel2, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_Performance));
     registerFixIt(1, "fix-function-args-by-ref", "function-args-by-ref");
-    registerCheck(check<FunctionArgsByValue>("function-args-by-value", CheckLevel2,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_VisitsDecls));
-    registerCheck(check<GlobalConstCharPointer>("global-const-char-pointer", CheckLevel2,  RegisteredCheck::Option_VisitsDecls));
-    registerCheck(check<ImplicitCasts>("implicit-casts", CheckLevel2,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<MissingQObjectMacro>("missing-qobject-macro", CheckLevel2,  RegisteredCheck::Option_VisitsDecls));
-    registerCheck(check<MissingTypeInfo>("missing-typeinfo", CheckLevel2,  RegisteredCheck::Option_VisitsDecls));
-    registerCheck(check<OldStyleConnect>("old-style-connect", CheckLevel2, RegisteredCheck::Option_Qt4Incompatible | RegisteredCheck::Option_VisitsStmts));
+    registerCheck(check<FunctionArgsByValue>("function-args-by-value", CheckLevel2, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_Performance));
+    registerCheck(check<GlobalConstCharPointer>("global-const-char-pointer", CheckLevel2, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_IgnoresFunctionBodies | RegisteredCheck::Option_CacheSafe | RegisteredCheck::Option_Performance, {}, {"VarDecl"}));
+    registerCheck(check<ImplicitCasts>("implicit-casts", CheckLevel2, RegisteredCheck::Cost_Expensive,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_NeedsParentMap));
+    registerCheck(check<MissingQObjectMacro>("missing-qobject-macro", CheckLevel2, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_IgnoresFunctionBodies, {}, {"CXXRecordDecl"}));
+    registerCheck(check<MissingTypeInfo>("missing-typeinfo", CheckLevel2, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_Performance));
+    registerCheck(check<OldStyleConnect>("old-style-connect", CheckLevel2, RegisteredCheck::Cost_Cheap, RegisteredCheck::Option_Qt4Incompatible | RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_Performance, {"CallExpr", "CXXConstructExpr"}));
     registerFixIt(1, "fix-old-style-connect", "old-style-connect");
-    registerCheck(check<QStringAllocations>("qstring-allocations", CheckLevel2, RegisteredCheck::Option_Qt4Incompatible | RegisteredCheck::Option_VisitsStmts));
+    registerCheck(check<QStringAllocations>("qstring-allocations", CheckLevel2, RegisteredCheck::Cost_Expensive, RegisteredCheck::Option_Qt4Incompatible | RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_NeedsParentMap | RegisteredCheck::Option_Performance));
     registerFixIt(1, "fix-qlatin1string-allocations", "qstring-allocations");
     registerFixIt(2, "fix-fromLatin1_fromUtf8-allocations", "qstring-allocations");
     registerFixIt(4, "fix-fromCharPtrAllocations", "qstring-allocations");
-    registerCheck(check<ReturningVoidExpression>("returning-void-expression", CheckLevel2,  RegisteredCheck::Option_VisitsStmts));
-    registerCheck(check<RuleOfThree>("rule-of-three", CheckLevel2,  RegisteredCheck::Option_VisitsDecls));
-    registerCheck(check<StaticPmf>("static-pmf", CheckLevel2,  RegisteredCheck::Option_VisitsDecls));
-    registerCheck(check<VirtualCallCtor>("virtual-call-ctor", CheckLevel2,  RegisteredCheck::Option_VisitsDecls));
+    registerCheck(check<ReturningVoidExpression>("returning-void-expression", CheckLevel2, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsStmts | RegisteredCheck::Option_CacheSafe, {"ReturnStmt"}));
+    registerCheck(check<RuleOfThree>("rule-of-three", CheckLevel2, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsDecls, {}, {"CXXRecordDecl"}));
+    registerCheck(check<StaticPmf>("static-pmf", CheckLevel2, RegisteredCheck::Cost_Cheap,  RegisteredCheck::Option_VisitsDecls | RegisteredCheck::Option_CacheSafe, {}, {"VarDecl"}));
+    registerCheck(check<VirtualCallCtor>("virtual-call-ctor", CheckLevel2, RegisteredCheck::Cost_Moderate,  RegisteredCheck::Option_VisitsDecls));
 }
@@ -29,6 +29,11 @@
 #include "AccessSpecifierManager.h"
 #include "SourceCompatibilityHelpers.h"
 #include "FixItExporter.h"
+#include "HeaderCache.h"
+#include "PerfCounters.h"
+#include "RunStats.h"
+#include "SuppressionManager.h"
+#include "TraversalStack.h"
 
 #include <clang/Frontend/FrontendPluginRegistry.h>
 #include <clang/Frontend/CompilerInstance.h>
@@ -38,18 +43,33 @@
 #include <clang/AST/Decl.h>
 #include <clang/AST/DeclBase.h>
 #include <clang/AST/DeclCXX.h>
+#include <clang/AST/DeclTemplate.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
 #include <clang/AST/Stmt.h>
 #include <clang/AST/StmtCXX.h>
 #include <clang/Basic/Diagnostic.h>
+#include <clang/Basic/FileManager.h>
 #include <clang/Basic/LLVM.h>
 #include <clang/Basic/SourceLocation.h>
 #include <clang/Basic/SourceManager.h>
 #include <clang/Frontend/FrontendAction.h>
+#include <clang/Lex/Preprocessor.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Config/llvm-config.h>
 #include <llvm/Support/raw_ostream.h>
 #include <llvm/Support/Casting.h>
+#include <llvm/Support/Format.h>
+#include <llvm/Support/Process.h>
 
+#include <algorithm>
+#include <chrono>
 #include <stdlib.h>
-#include <mutex>
+#include <unordered_map>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
 
 using namespace clang;
 using namespace std;
@@ -68,40 +88,456 @@ static void manuallyPopulateParentMap(ParentMap *map, Stmt *s)
     }
 }
 
+static size_t countStmts(const Stmt *s)
+{
+    if (!s)
+        return 0;
+
+    size_t count = 1;
+    for (const Stmt *child : s->children())
+        count += countStmts(child);
+
+    return count;
+}
+
+// First and last enumerator covered by an AST class name, so subclasses are included
+using NodeClassRange = std::pair<int, int>;
+using NodeClassRanges = std::unordered_map<std::string, NodeClassRange>;
+
+static const NodeClassRanges &stmtClassRanges()
+{
+    static const NodeClassRanges ranges = [] {
+        NodeClassRanges result;
+#define STMT(CLASS, PARENT) result[#CLASS] = { Stmt::CLASS##Class, Stmt::CLASS##Class };
+#define ABSTRACT_STMT(STMT)
+#define STMT_RANGE(BASE, FIRST, LAST) result[#BASE] = { Stmt::FIRST##Class, Stmt::LAST##Class };
+#define LAST_STMT_RANGE(BASE, FIRST, LAST) STMT_RANGE(BASE, FIRST, LAST)
+#include <clang/AST/StmtNodes.inc>
+        return result;
+    }();
+
+    return ranges;
+}
+
+static const NodeClassRanges &declClassRanges()
+{
+    static const NodeClassRanges ranges = [] {
+        NodeClassRanges result;
+#define DECL(DERIVED, BASE) result[#DERIVED "Decl"] = { Decl::DERIVED, Decl::DERIVED };
+#define ABSTRACT_DECL(DECL)
+#define DECL_RANGE(BASE, START, END) result[#BASE "Decl"] = { Decl::START, Decl::END };
+#define LAST_DECL_RANGE(BASE, START, END) DECL_RANGE(BASE, START, END)
+#include <clang/AST/DeclNodes.inc>
+        return result;
+    }();
+
+    return ranges;
+}
+
+static const int s_numStmtClasses = 1 // NoStmtClass
+#define STMT(CLASS, PARENT) + 1
+#define ABSTRACT_STMT(STMT)
+#include <clang/AST/StmtNodes.inc>
+    ;
+
+static const int s_numDeclKinds = 0
+#define DECL(DERIVED, BASE) + 1
+#define ABSTRACT_DECL(DECL)
+#include <clang/AST/DeclNodes.inc>
+    ;
+
+// The table is the switch on StmtClass or Decl::Kind: a node only reaches the checks which declared its class
+// in checks.json. The checks are picked at runtime, so a generated compile-time switch would still need to test
+// each one, and their Visit functions live in other translation units, so devirtualizing wouldn't inline them.
+// dev-scripts/dispatch_bench.cpp times both: such a switch is slower, only inlining every check's body would win.
+static void addToDispatchTable(std::vector<CheckBase::List> &table, CheckBase *check,
+                               const std::vector<std::string> &classNames, const NodeClassRanges &ranges)
+{
+    auto addRange = [&table, check] (int first, int last) {
+        for (int i = first; i <= last; ++i) {
+            CheckBase::List &checks = table[i];
+            if (checks.empty() || checks.back() != check) // Overlapping classes, such as CallExpr and CXXMemberCallExpr
+                checks.push_back(check);
+        }
+    };
+
+    if (classNames.empty()) {
+        addRange(0, table.size() - 1);
+        return;
+    }
+
+    for (const std::string &className : classNames) {
+        auto it = ranges.find(className);
+        if (it == ranges.cend()) {
+            llvm::errs() << "clazy: Unknown AST class " << className << " requested by " << check->name() << "\n";
+            addRange(0, table.size() - 1);
+            return;
+        }
+
+        addRange(it->second.first, it->second.second);
+    }
+}
+
 ClazyASTConsumer::ClazyASTConsumer(ClazyContext *context)
     : m_context(context)
+    , m_checksToVisitStmts(s_numStmtClasses)
+    , m_checksToVisitDecls(s_numDeclKinds)
 {
-#ifndef CLAZY_DISABLE_AST_MATCHERS
-    m_matchFinder = new clang::ast_matchers::MatchFinder();
-#endif
 }
 
 void ClazyASTConsumer::addCheck(const std::pair<CheckBase *, RegisteredCheck> &check)
 {
     CheckBase *checkBase = check.first;
-#ifndef CLAZY_DISABLE_AST_MATCHERS
-    checkBase->registerASTMatchers(*m_matchFinder);
-#endif
-    //m_createdChecks.push_back(checkBase);
+    m_createdChecks.push_back(checkBase); // Their matchers are registered by createMatchFinder()
 
     const RegisteredCheck &rcheck = check.second;
 
+    if (rcheck.options & RegisteredCheck::Option_NeedsParentMap)
+        m_needsParentMap = true;
+
+    if (rcheck.options & RegisteredCheck::Option_CacheSafe)
+        m_hasCacheSafeChecks = true;
+
+    if (m_context->headerCache)
+        m_context->headerCache->addToConfiguration(rcheck.name);
+
+    if (m_context->sarifExporter)
+        m_context->sarifExporter->addRule(rcheck);
+
     if (rcheck.options & RegisteredCheck::Option_VisitsStmts)
-        m_checksToVisitStmts.push_back(checkBase);
+        addToDispatchTable(m_checksToVisitStmts, checkBase, rcheck.visitedStmtClasses, stmtClassRanges());
 
     if (rcheck.options & RegisteredCheck::Option_VisitsDecls)
-        m_checksToVisitDecls.push_back(checkBase);
+        addToDispatchTable(m_checksToVisitDecls, checkBase, rcheck.visitedDeclClasses, declClassRanges());
 
 }
 
 ClazyASTConsumer::~ClazyASTConsumer()
 {
 #ifndef CLAZY_DISABLE_AST_MATCHERS
-    delete m_matchFinder;
+    // The matchers hold their checks as callbacks, so they can only outlive the translation unit together
+    const bool matchFinderIsReusable = m_matchFinder && m_reusableMatchFinder && !m_context->collectsStats()
+                                       && std::all_of(m_createdChecks.cbegin(), m_createdChecks.cend(),
+                                                      [](CheckBase *check) { return check->isReusable(); });
+    if (matchFinderIsReusable) {
+        m_reusableMatchFinder->finder.reset(m_matchFinder);
+        m_reusableMatchFinder->checks = m_createdChecks;
+    } else {
+        delete m_matchFinder;
+    }
 #endif
+
+    if (m_reusableChecks) {
+        for (CheckBase *check : m_createdChecks) {
+            if (check->isReusable()) {
+                check->endTranslationUnit();
+                (*m_reusableChecks)[check->name()] = check;
+            }
+        }
+    }
+
     delete m_context;
 }
 
+void ClazyASTConsumer::resetParentMap(Stmt *root)
+{
+    delete m_context->parentMap;
+    m_context->parentMap = nullptr;
+    m_parentMapRoot = root;
+    lastStm = nullptr;
+
+    // ParentMap sometimes crashes when there were errors. Doesn't like a botched AST.
+    if (root && !m_context->pp.getDiagnostics().hasUnrecoverableErrorOccurred()) {
+        CLAZY_TIME_TRACE_SCOPE("clazy ParentMap", "");
+        m_context->parentMap = new ParentMap(root);
+        if (m_context->collectsStats())
+            m_parentMapPeakStmts = std::max(m_parentMapPeakStmts, countStmts(root));
+    }
+}
+
+#ifndef CLAZY_DISABLE_AST_MATCHERS
+void ClazyASTConsumer::createMatchFinder()
+{
+    // Building the matchers of many checks is measurable, reuse the previous translation unit's when possible.
+    // With print-stats the finder reports to this consumer's m_matcherTimes, so it's never shared.
+    if (m_reusableMatchFinder && m_reusableMatchFinder->finder && !m_context->collectsStats()
+        && m_reusableMatchFinder->checks == m_createdChecks) {
+        m_matchFinder = m_reusableMatchFinder->finder.release();
+        m_reusableMatchFinder->checks.clear();
+        return;
+    }
+
+    clang::ast_matchers::MatchFinder::MatchFinderOptions matchFinderOptions;
+    if (m_context->collectsStats())
+        matchFinderOptions.CheckProfiling.emplace(m_matcherTimes);
+    m_matchFinder = new clang::ast_matchers::MatchFinder(matchFinderOptions);
+
+    for (CheckBase *check : m_createdChecks)
+        check->registerASTMatchers(*m_matchFinder);
+}
+
+template <typename T>
+void ClazyASTConsumer::matchInTraversal(const T &node)
+{
+    const bool collectStats = m_context->collectsStats();
+    ClazyStatTimer timer(collectStats ? &m_matching : nullptr);
+    m_matchFinder->match(node, m_context->astContext);
+
+    if (collectStats) {
+        // m_matcherTimes only holds the times of the last match() call
+        for (const auto &it : m_matcherTimes)
+            m_traversalMatcherTimes[it.getKey()] += it.getValue();
+    }
+}
+#endif
+
+bool ClazyASTConsumer::isPrunable(Decl *decl) const
+{
+    if (!decl || isa<TranslationUnitDecl>(decl))
+        return false;
+
+    // Namespaces and extern "C" blocks can wrap an #include of a non-system header, decide per child instead.
+    // Still cheap, RecursiveASTVisitor does little more than iterating them.
+    if (isa<NamespaceDecl>(decl) || isa<LinkageSpecDecl>(decl))
+        return false;
+
+    // Deserialized from a PCH or module, so not in the main file
+    if (m_prunesAstFileDecls && decl->isFromASTFile())
+        return true;
+
+    // A declaration starting and ending in the same system header only contains nodes VisitDecl() and VisitStmt() reject
+    const SourceManager &sm = m_context->sm;
+    const SourceLocation begin = sm.getExpansionLoc(clazy::getLocStart(decl));
+    const SourceLocation end = sm.getExpansionLoc(clazy::getLocEnd(decl));
+    if (begin.isInvalid() || end.isInvalid() || sm.getFileID(begin) != sm.getFileID(end))
+        return false;
+
+    if (sm.isInSystemHeader(begin))
+        return true;
+
+    // Same for files excluded by CLAZY_IGNORE_DIRS, CLAZY_HEADER_FILTER or the line filter, none of their warnings
+    // would be emitted. Decided once per FileID, by fileInfo().
+    return m_prunesIgnoredFileDecls && m_context->shouldIgnoreFile(begin);
+}
+
+void ClazyASTConsumer::visitPrunedDecls(Decl *decl)
+{
+    // Without these, VisitDecl() has nothing to do with pruned declarations
+    const bool feedsAccessSpecifiers = m_context->accessSpecifierManager && m_context->accessSpecifierManager->sawQtClass();
+    if (!feedsAccessSpecifiers && !m_context->visitsAllTypedefs())
+        return;
+
+    if (auto classTemplate = dyn_cast<ClassTemplateDecl>(decl))
+        decl = classTemplate->getTemplatedDecl();
+    else if (auto aliasTemplate = dyn_cast<TypeAliasTemplateDecl>(decl))
+        decl = aliasTemplate->getTemplatedDecl();
+
+    auto record = dyn_cast<CXXRecordDecl>(decl);
+    if ((record && record->isThisDeclarationADefinition() && feedsAccessSpecifiers)
+        || (isa<TypedefNameDecl>(decl) && m_context->visitsAllTypedefs()))
+        VisitDecl(decl);
+
+    // Declarations inside function bodies aren't looked for
+    auto context = dyn_cast<DeclContext>(decl);
+    if (!context || isa<FunctionDecl>(decl) || isa<EnumDecl>(decl))
+        return;
+
+    for (Decl *child : context->decls())
+        visitPrunedDecls(child);
+}
+
+bool ClazyASTConsumer::TraverseDecl(Decl *decl)
+{
+    // Returning false stops the whole traversal
+    if (exceedsTimeBudget() || m_context->reachedMaxWarnings())
+        return false;
+
+    // Don't walk millions of nodes which would be rejected one by one. Only the record definitions, for the
+    // AccessSpecifierManager, and the typedefs, if visited, are still visited.
+    if (isPrunable(decl)) {
+        if (m_context->collectsStats())
+            m_numPrunedDecls++;
+        visitPrunedDecls(decl);
+        return true;
+    }
+
+    auto fdecl = dyn_cast_or_null<FunctionDecl>(decl);
+    Stmt *body = fdecl && fdecl->doesThisDeclarationHaveABody() ? fdecl->getBody() : nullptr;
+
+    // No warning would pass the line filter, so don't even visit the function
+    if (body && !m_context->passesLineFilter(fdecl->getSourceRange()))
+        return true;
+
+    // Most bodies contain nothing the enabled checks visit, so don't walk them. The function itself is still visited.
+    if (body && m_prescreensBodies && !mayInterestChecks(fdecl, body)) {
+        if (m_context->collectsStats())
+            m_numPrescreenedBodies++;
+
+        // Checks visiting the function might still look into its body
+        const bool needsParentMap = m_needsParentMap && !m_insideFunctionBody && !m_checksToVisitDecls[decl->getKind()].empty();
+        if (needsParentMap)
+            resetParentMap(body);
+        VisitDecl(decl);
+        if (needsParentMap)
+            resetParentMap(nullptr);
+        return true;
+    }
+
+    // Lambda call operators are only traversed with implicit code, their body is already below the LambdaExpr
+    auto method = dyn_cast_or_null<CXXMethodDecl>(fdecl);
+    const bool isLambdaBody = method && method->getParent()->isLambda();
+    TraversalStack::FunctionScope functionScope(m_context->traversalStack, body && !isLambdaBody ? fdecl : nullptr);
+
+    if (!m_needsParentMap || !body || m_insideFunctionBody || m_context->sm.isInSystemHeader(clazy::getLocStart(body)))
+        return RecursiveASTVisitor::TraverseDecl(decl);
+
+    // The ParentMap is one of our biggest memory consumers, so instead of growing one for the whole TU
+    // build it per function and drop it when done. Building it before visiting the FunctionDecl means
+    // VisitDecl() can also query the body's parents.
+    resetParentMap(body);
+    m_insideFunctionBody = true;
+    const bool result = RecursiveASTVisitor::TraverseDecl(decl);
+    m_insideFunctionBody = false;
+    resetParentMap(nullptr);
+
+    return result;
+}
+
+bool ClazyASTConsumer::shouldSkipFunctionBody(Decl *decl)
+{
+    return m_skipsHeaderFunctionBodies && !m_context->isMainFile(decl->getLocation());
+}
+
+bool ClazyASTConsumer::mayInterestChecks(const FunctionDecl *fdecl, const Stmt *body) const
+{
+    // Besides the body, RecursiveASTVisitor traverses the parameters and constructor initializers
+    for (const ParmVarDecl *param : fdecl->parameters()) {
+        if (param->hasDefaultArg() || !m_checksToVisitDecls[param->getKind()].empty())
+            return true;
+    }
+
+#if LLVM_VERSION_MAJOR >= 10
+    if (fdecl->getTrailingRequiresClause())
+        return true;
+#endif
+
+    if (auto ctor = dyn_cast<CXXConstructorDecl>(fdecl)) {
+        for (const CXXCtorInitializer *init : ctor->inits()) {
+            if (mayInterestChecks(init->getInit()))
+                return true;
+        }
+    }
+
+    return mayInterestChecks(body);
+}
+
+bool ClazyASTConsumer::mayInterestChecks(const Stmt *root) const
+{
+    // Much cheaper than a RecursiveASTVisitor traversal. Expressions only reachable through TypeLocs,
+    // like decltype() operands, aren't looked at, they're unevaluated anyway.
+    llvm::SmallVector<const Stmt *, 64> worklist = { root };
+    while (!worklist.empty()) {
+        const Stmt *stmt = worklist.pop_back_val();
+        if (!stmt)
+            continue;
+
+        if (!m_checksToVisitStmts[stmt->getStmtClass()].empty())
+            return true;
+
+        if (auto declStmt = dyn_cast<DeclStmt>(stmt)) {
+            for (const Decl *decl : declStmt->decls()) {
+                if (!isa<VarDecl>(decl) || !m_checksToVisitDecls[decl->getKind()].empty())
+                    return true; // Local classes and such have bodies of their own
+            }
+        } else if (isa<LambdaExpr>(stmt) || isa<BlockExpr>(stmt)) {
+            return true; // Traversed through their Decls too
+        } else if (auto catchStmt = dyn_cast<CXXCatchStmt>(stmt)) {
+            const VarDecl *exceptionDecl = catchStmt->getExceptionDecl();
+            if (exceptionDecl && !m_checksToVisitDecls[exceptionDecl->getKind()].empty())
+                return true;
+        } else if (auto initList = dyn_cast<InitListExpr>(stmt)) {
+            worklist.push_back(initList->getSyntacticForm()); // Both forms are traversed
+        }
+
+        for (const Stmt *child : stmt->children())
+            worklist.push_back(child);
+    }
+
+    return false;
+}
+
+bool ClazyASTConsumer::exceedsTimeBudget()
+{
+    if (m_context->timeBudget == 0)
+        return false;
+
+    if (m_exceededTimeBudget)
+        return true;
+
+    // Reading the clock for every node shows in the profile, and 256 nodes take far less than a millisecond
+    if (++m_nodesSinceTimeBudgetCheck < 256)
+        return false;
+    m_nodesSinceTimeBudgetCheck = 0;
+
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - m_traversalStart;
+    if (elapsed.count() <= m_context->timeBudget)
+        return false;
+
+    m_exceededTimeBudget = true;
+    llvm::errs() << "clazy: the analysis of " << mainFileName() << " exceeded its time budget of " << m_context->timeBudget
+                 << " ms; remaining checks were skipped\n";
+    return true;
+}
+
+void ClazyASTConsumer::enforceCheckTimeBudget(CheckBase *check)
+{
+    const CheckStats &stats = check->stats();
+    if ((stats.visitStmt.seconds + stats.visitDecl.seconds) * 1000 <= m_context->checkTimeBudget)
+        return;
+
+    check->disable();
+    llvm::errs() << "clazy: " << check->name() << " exceeded its time budget of " << m_context->checkTimeBudget
+                 << " ms; it was skipped for the rest of " << mainFileName() << "\n";
+}
+
+std::string ClazyASTConsumer::mainFileName() const
+{
+    const FileEntry *entry = m_context->sm.getFileEntryForID(m_context->sm.getMainFileID());
+    return entry ? entry->getName().str() : std::string();
+}
+
+// Instantiations are checked with the template arguments of the translation unit, their warnings in a header can't be cached
+static bool isInTemplateInstantiation(const Decl *decl)
+{
+    const DeclContext *context = decl ? dyn_cast<DeclContext>(decl) : nullptr;
+    if (decl && !context)
+        context = decl->getDeclContext();
+
+    for (; context; context = context->getParent()) {
+        if (auto func = dyn_cast<FunctionDecl>(context)) {
+            if (func->getTemplateInstantiationPattern())
+                return true;
+        } else if (auto record = dyn_cast<CXXRecordDecl>(context)) {
+            if (record->getTemplateInstantiationPattern())
+                return true;
+        }
+    }
+
+    return false;
+}
+
+bool ClazyASTConsumer::enterCacheableNode(SourceLocation loc, const Decl *enclosingDecl)
+{
+    HeaderCache *headerCache = m_context->headerCache;
+    if (!headerCache || isInTemplateInstantiation(enclosingDecl)) {
+        m_context->cacheableNodeLoc = SourceLocation();
+        return false;
+    }
+
+    m_context->cacheableNodeLoc = loc;
+    return m_hasCacheSafeChecks && headerCache->isCached(loc);
+}
+
 bool ClazyASTConsumer::VisitDecl(Decl *decl)
 {
     if (AccessSpecifierManager *a = m_context->accessSpecifierManager) // Needs to visit system headers too (qobject.h for example)
@@ -112,8 +548,6 @@ bool ClazyASTConsumer::VisitDecl(Decl *decl)
     if (locStart.isInvalid() || (m_context->sm.isInSystemHeader(locStart) && !isTypeDefToVisit))
         return true;
 
-    const bool isFromIgnorableInclude = m_context->ignoresIncludedFiles() && !Utils::isMainFile(m_context->sm, locStart);
-
     m_context->lastDecl = decl;
 
     if (auto fdecl = dyn_cast<FunctionDecl>(decl)) {
@@ -122,48 +556,98 @@ bool ClazyASTConsumer::VisitDecl(Decl *decl)
             m_context->lastMethodDecl = mdecl;
     }
 
-    for (CheckBase *check : m_checksToVisitDecls) {
-        if (!(isFromIgnorableInclude && check->canIgnoreIncludes()))
-            check->VisitDecl(decl);
+#ifndef CLAZY_DISABLE_AST_MATCHERS
+    if (m_context->runsMatchersInTraversal())
+        matchInTraversal(*decl);
+#endif
+
+    const CheckBase::List &checks = m_checksToVisitDecls[decl->getKind()];
+    if (checks.empty())
+        return true;
+
+    const bool isFromIgnorableInclude = m_context->ignoresIncludedFiles() && !m_context->isMainFile(locStart);
+    const bool isReplayedFromCache = enterCacheableNode(locStart, decl);
+    const bool timesChecks = m_context->collectsStats() || m_context->checkTimeBudget > 0 || m_tracesChecks;
+    for (CheckBase *check : checks) {
+        if (!(isFromIgnorableInclude && check->canIgnoreIncludes()) && !check->isDisabled()
+            && !(isReplayedFromCache && check->isCacheSafe())) {
+            {
+                ClazyStatTimer timer(timesChecks ? &check->stats().visitDecl : nullptr, m_context->perfCounters);
+                check->VisitDecl(decl);
+            }
+
+            if (m_context->checkTimeBudget > 0)
+                enforceCheckTimeBudget(check);
+        }
     }
 
+    m_context->cacheableNodeLoc = SourceLocation();
     return true;
 }
 
 bool ClazyASTConsumer::VisitStmt(Stmt *stm)
 {
+    // A single huge function body can take longer than the whole budget, so it's checked per statement too
+    if (exceedsTimeBudget() || m_context->reachedMaxWarnings())
+        return false;
+
     const SourceLocation locStart = clazy::getLocStart(stm);
     if (locStart.isInvalid() || m_context->sm.isInSystemHeader(locStart))
         return true;
 
     if (!m_context->parentMap) {
-        if (m_context->ci.getDiagnostics().hasUnrecoverableErrorOccurred())
+        if (m_context->pp.getDiagnostics().hasUnrecoverableErrorOccurred())
             return false; // ParentMap sometimes crashes when there were errors. Doesn't like a botched AST.
 
-        m_context->parentMap = new ParentMap(stm);
+        if (m_needsParentMap)
+            resetParentMap(stm);
     }
 
-    ParentMap *parentMap = m_context->parentMap;
+    if (ParentMap *parentMap = m_context->parentMap) {
+        // Workaround llvm bug: Crashes creating a parent map when encountering Catch Statements.
+        if (lastStm && isa<CXXCatchStmt>(lastStm) && !parentMap->hasParent(stm)) {
+            parentMap->setParent(stm, lastStm);
+            manuallyPopulateParentMap(parentMap, stm);
+        }
+
+        lastStm = stm;
 
-    // Workaround llvm bug: Crashes creating a parent map when encountering Catch Statements.
-    if (lastStm && isa<CXXCatchStmt>(lastStm) && !parentMap->hasParent(stm)) {
-        parentMap->setParent(stm, lastStm);
-        manuallyPopulateParentMap(parentMap, stm);
+        // clang::ParentMap takes a root statement, but there's no root statement in the AST, the root is a declaration
+        // So add to parent map each time we go into a different hierarchy
+        if (stm != m_parentMapRoot && !parentMap->hasParent(stm)) {
+            CLAZY_TIME_TRACE_SCOPE("clazy ParentMap", "");
+            parentMap->addStmt(stm);
+        }
     }
 
-    lastStm = stm;
+#ifndef CLAZY_DISABLE_AST_MATCHERS
+    if (m_context->runsMatchersInTraversal())
+        matchInTraversal(*stm);
+#endif
+
+    const CheckBase::List &checks = m_checksToVisitStmts[stm->getStmtClass()];
+    if (checks.empty())
+        return true;
 
-    // clang::ParentMap takes a root statement, but there's no root statement in the AST, the root is a declaration
-    // So add to parent map each time we go into a different hierarchy
-    if (!parentMap->hasParent(stm))
-        parentMap->addStmt(stm);
+    m_context->stmtFacts.reset(stm);
+    const bool isFromIgnorableInclude = m_context->ignoresIncludedFiles() && !m_context->isMainFile(locStart);
+    const Decl *enclosingDecl = m_context->traversalStack.function() ? m_context->traversalStack.function() : m_context->lastDecl;
+    const bool isReplayedFromCache = enterCacheableNode(locStart, enclosingDecl);
+    const bool timesChecks = m_context->collectsStats() || m_context->checkTimeBudget > 0 || m_tracesChecks;
+    for (CheckBase *check : checks) {
+        if (!(isFromIgnorableInclude && check->canIgnoreIncludes()) && !check->isDisabled()
+            && !(isReplayedFromCache && check->isCacheSafe())) {
+            {
+                ClazyStatTimer timer(timesChecks ? &check->stats().visitStmt : nullptr, m_context->perfCounters);
+                check->VisitStmt(stm);
+            }
 
-    const bool isFromIgnorableInclude = m_context->ignoresIncludedFiles() && !Utils::isMainFile(m_context->sm, locStart);
-    for (CheckBase *check : m_checksToVisitStmts) {
-        if (!(isFromIgnorableInclude && check->canIgnoreIncludes()))
-            check->VisitStmt(stm);
+            if (m_context->checkTimeBudget > 0)
+                enforceCheckTimeBudget(check);
+        }
     }
 
+    m_context->cacheableNodeLoc = SourceLocation();
     return true;
 }
 
@@ -176,13 +660,245 @@ void ClazyASTConsumer::HandleTranslationUnit(ASTContext &ctx)
     if ((m_context->options & ClazyContext::ClazyOption_OnlyQt) && !m_context->isQt())
         return;
 
-    // Run our RecursiveAstVisitor based checks:
-    TraverseDecl(ctx.getTranslationUnitDecl());
+    const bool collectStats = m_context->collectsStats();
+    ClazyStat traversal;
+
+#ifndef CLAZY_DISABLE_AST_MATCHERS
+    createMatchFinder();
+#endif
+
+    if (m_context->headerCache)
+        m_context->headerCache->load();
+
+    // The pre-screen is only worth it if some statement classes aren't visited by any check.
+    // Implicit code and matchers run in the traversal need every node.
+    m_prescreensBodies = !m_context->isVisitImplicitCode() && !m_context->runsMatchersInTraversal()
+                         && std::any_of(m_checksToVisitStmts.cbegin(), m_checksToVisitStmts.cend(),
+                                        [](const CheckBase::List &checks) { return checks.empty(); });
+
+    // With ignore-included-files, content from a PCH or module is of no interest if every check ignores includes
+    const bool checksCanIgnoreIncludes = !m_context->runsMatchersInTraversal()
+                                         && std::all_of(m_createdChecks.cbegin(), m_createdChecks.cend(),
+                                                        [](CheckBase *check) { return check->canIgnoreIncludes(); });
+    m_prunesAstFileDecls = m_context->ignoresIncludedFiles() && checksCanIgnoreIncludes;
+
+    // Ignored files can still declare what a check needs to warn in the others, unless no check looks at includes
+    m_prunesIgnoredFileDecls = checksCanIgnoreIncludes;
+
+    m_tracesChecks = CLAZY_TIME_TRACE_ENABLED();
+    m_traversalStart = std::chrono::steady_clock::now();
+
+    {
+        // Run our RecursiveAstVisitor based checks:
+        ClazyStatTimer timer(collectStats ? &traversal : nullptr);
+        CLAZY_TIME_TRACE_SCOPE("clazy AST traversal", "");
+        TraverseDecl(ctx.getTranslationUnitDecl());
+    }
+
+#ifndef CLAZY_DISABLE_AST_MATCHERS
+    if (!m_context->runsMatchersInTraversal() && !m_exceededTimeBudget && !m_context->reachedMaxWarnings()) {
+        // Run our AstMatcher base checks:
+        ClazyStatTimer timer(collectStats ? &m_matching : nullptr);
+        CLAZY_TIME_TRACE_SCOPE("clazy AST matchers", "");
+        m_matchFinder->matchAST(ctx);
+    }
+#endif
+
+    if (m_tracesChecks)
+        emitTimeTraceEvents();
+
+    if (m_context->deduplicator)
+        emitDeferredWarnings();
+
+    if (m_context->printsStats())
+        printStats(traversal);
+
+    if (m_context->options & ClazyContext::ClazyOption_CollectStats)
+        recordRunStats();
+
+    // The diagnostics are out, don't hold on to the last function's ParentMap and to the access specifiers until
+    // the CompilerInstance is destroyed. clazy-standalone -max-memory starts the next translation units sooner.
+    resetParentMap(nullptr);
+    delete m_context->accessSpecifierManager;
+    m_context->accessSpecifierManager = nullptr;
+}
+
+static void sortInSourceOrder(const SourceManager &sm, std::vector<std::pair<CheckBase *, CheckBase::BufferedWarning>> &warnings)
+{
+    std::stable_sort(warnings.begin(), warnings.end(),
+                     [&sm](const std::pair<CheckBase *, CheckBase::BufferedWarning> &w1,
+                           const std::pair<CheckBase *, CheckBase::BufferedWarning> &w2) {
+                         const SourceLocation loc1 = w1.second.loc;
+                         const SourceLocation loc2 = w2.second.loc;
+                         if (loc1.isInvalid() || loc2.isInvalid())
+                             return loc1.isInvalid() && loc2.isValid();
+                         return sm.isBeforeInTranslationUnit(loc1, loc2);
+                     });
+}
+
+void ClazyASTConsumer::emitDeferredWarnings()
+{
+    std::vector<std::pair<CheckBase *, CheckBase::BufferedWarning>> warnings;
+    for (CheckBase *check : m_createdChecks) {
+        for (CheckBase::BufferedWarning &warning : check->takeBufferedWarnings())
+            warnings.push_back({ check, std::move(warning) });
+    }
+
+    sortInSourceOrder(m_context->sm, warnings);
+    for (const auto &warning : warnings)
+        warning.first->emitDeferredWarning(warning.second);
+}
 
+double ClazyASTConsumer::matchersSeconds(const CheckBase *check) const
+{
 #ifndef CLAZY_DISABLE_AST_MATCHERS
-    // Run our AstMatcher base checks:
-    m_matchFinder->matchAST(ctx);
+    const auto &matcherTimes = m_context->runsMatchersInTraversal() ? m_traversalMatcherTimes : m_matcherTimes;
+    auto it = matcherTimes.find(check->name());
+    if (it != matcherTimes.end())
+        return it->second.getWallTime();
+#else
+    (void)check;
 #endif
+    return 0;
+}
+
+// A scope per visited node would be as many events as nodes, each shorter than -ftime-trace-granularity,
+// so each check's time is accumulated over the translation unit instead
+void ClazyASTConsumer::emitTimeTraceEvents() const
+{
+    for (const CheckBase *check : m_createdChecks) {
+        const CheckStats &stats = check->stats();
+        const uint64_t calls = stats.visitStmt.calls + stats.visitDecl.calls;
+        if (calls == 0)
+            continue;
+
+        std::string detail;
+        llvm::raw_string_ostream(detail) << llvm::format("%.2fms in %llu visits", (stats.visitStmt.seconds + stats.visitDecl.seconds) * 1000,
+                                                         static_cast<unsigned long long>(calls));
+        CLAZY_TIME_TRACE_EVENT(check->name(), detail);
+    }
+}
+
+void ClazyASTConsumer::recordRunStats() const
+{
+    TranslationUnitStats stats;
+    stats.file = mainFileName();
+    stats.arenaBytes = m_context->arena.getBytesAllocated();
+    if (const HeaderCache *headerCache = m_context->headerCache) {
+        stats.headerCacheHits = headerCache->numHits();
+        stats.headerCacheMisses = headerCache->numMisses();
+    }
+
+    stats.checks.reserve(m_createdChecks.size());
+    for (const CheckBase *check : m_createdChecks) {
+        const CheckStats &checkStats = check->stats();
+        stats.arenaBytes += checkStats.arenaBytes;
+        stats.checks.push_back({ check->name(), checkStats.visitStmt.seconds + checkStats.visitDecl.seconds
+                                 + checkStats.preprocessor.seconds + matchersSeconds(check), checkStats.warnings });
+    }
+
+    // The AST only grows, so what's held now is close to the peak. A ParentMap's DenseMap is at most 3/4 full.
+    const SourceManager &sm = m_context->sm;
+    const SourceManager::MemoryBufferSizes buffers = sm.getMemoryBufferSizes();
+    stats.memoryBytes = m_context->astContext.getASTAllocatedMemory() + m_context->astContext.getSideTableAllocatedMemory()
+                        + sm.getContentCacheSize() + sm.getDataStructureSizes() + buffers.malloc_bytes + buffers.mmap_bytes
+                        + m_context->pp.getTotalMemory() + stats.arenaBytes
+                        + m_parentMapPeakStmts * 2 * sizeof(std::pair<Stmt *, Stmt *>);
+
+    RunStats::recordTranslationUnit(std::move(stats));
+}
+
+void ClazyASTConsumer::printStats(const ClazyStat &traversal) const
+{
+    struct Row {
+        const CheckBase *check;
+        double matchersSeconds;
+        double totalSeconds;
+    };
+
+    std::vector<Row> rows;
+    rows.reserve(m_createdChecks.size());
+    for (const CheckBase *check : m_createdChecks) {
+        const double matchersSeconds = this->matchersSeconds(check);
+        const CheckStats &stats = check->stats();
+        const double total = stats.visitStmt.seconds + stats.visitDecl.seconds + stats.preprocessor.seconds + matchersSeconds;
+        rows.push_back({ check, matchersSeconds, total });
+    }
+
+    std::stable_sort(rows.begin(), rows.end(), [](const Row &r1, const Row &r2) {
+        return r1.totalSeconds > r2.totalSeconds;
+    });
+
+    const FileEntry *mainFile = m_context->sm.getFileEntryForID(m_context->sm.getMainFileID());
+    llvm::raw_ostream &os = llvm::errs();
+    os << "clazy stats for " << (mainFile ? mainFile->getName() : "<unknown>") << ":\n";
+    double matchingSeconds = 0;
+#ifndef CLAZY_DISABLE_AST_MATCHERS
+    matchingSeconds = m_matching.seconds;
+#endif
+    // With matchers-in-traversal the traversal time includes the matchers
+    os << llvm::format("    Traversal: %.2fms, AST matchers: %.2fms\n", traversal.seconds * 1000, matchingSeconds * 1000);
+    os << llvm::format("    %-40s %10s %12s %10s %12s %10s %12s %12s %10s %10s\n", "check", "total(ms)",
+                       "VisitStmt(ms)", "calls", "VisitDecl(ms)", "calls", "matchers(ms)", "preproc(ms)", "calls", "arena(KB)");
+    for (const Row &row : rows) {
+        const CheckStats &stats = row.check->stats();
+        os << llvm::format("    %-40s %10.2f %12.2f %10llu %12.2f %10llu %12.2f %12.2f %10llu %10.1f\n",
+                           row.check->name().c_str(), row.totalSeconds * 1000,
+                           stats.visitStmt.seconds * 1000, static_cast<unsigned long long>(stats.visitStmt.calls),
+                           stats.visitDecl.seconds * 1000, static_cast<unsigned long long>(stats.visitDecl.calls),
+                           row.matchersSeconds * 1000, stats.preprocessor.seconds * 1000,
+                           static_cast<unsigned long long>(stats.preprocessor.calls), stats.arenaBytes / 1024.0);
+    }
+
+    if (m_context->perfCounters && m_context->perfCounters->isValid()) {
+        os << "    Hardware counters, in user space, excluding AST matchers:\n";
+        os << llvm::format("    %-40s %16s %16s %6s %14s %14s\n", "check", "instructions", "cycles", "IPC", "LLC misses", "branch misses");
+        for (const Row &row : rows) {
+            const CheckStats &stats = row.check->stats();
+            uint64_t values[PerfCounterValues::NumCounters];
+            for (int i = 0; i < PerfCounterValues::NumCounters; ++i)
+                values[i] = stats.visitStmt.counters.values[i] + stats.visitDecl.counters.values[i] + stats.preprocessor.counters.values[i];
+
+            const uint64_t cycles = values[PerfCounterValues::Cycles];
+            os << llvm::format("    %-40s %16llu %16llu %6.2f %14llu %14llu\n", row.check->name().c_str(),
+                               static_cast<unsigned long long>(values[PerfCounterValues::Instructions]), static_cast<unsigned long long>(cycles),
+                               cycles > 0 ? double(values[PerfCounterValues::Instructions]) / cycles : 0.0,
+                               static_cast<unsigned long long>(values[PerfCounterValues::CacheMisses]),
+                               static_cast<unsigned long long>(values[PerfCounterValues::BranchMisses]));
+        }
+    }
+
+    if (m_prescreensBodies)
+        os << llvm::format("    Function bodies skipped by the pre-screen: %llu\n", static_cast<unsigned long long>(m_numPrescreenedBodies));
+    os << llvm::format("    Declarations pruned, from system headers, PCHs or ignored files: %llu\n", static_cast<unsigned long long>(m_numPrunedDecls));
+
+    // What each feature holds at the end of the translation unit, to know what to disable when hitting memory limits
+    os << "    Memory:\n";
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+        const double peakRssMB = usage.ru_maxrss / (1024.0 * 1024.0); // In bytes
+#else
+        const double peakRssMB = usage.ru_maxrss / 1024.0; // In KB
+#endif
+        os << llvm::format("        peak RSS: %.1fMB\n", peakRssMB);
+    }
+#endif
+    os << llvm::format("        malloc: %.1fMB\n", llvm::sys::Process::GetMallocUsage() / (1024.0 * 1024.0));
+    os << llvm::format("        arena: %.1fKB allocated, %.1fKB reserved\n", m_context->arena.getBytesAllocated() / 1024.0,
+                       m_context->arena.getTotalMemory() / 1024.0);
+    if (m_needsParentMap)
+        os << llvm::format("        ParentMap: %llu statements in the largest one\n", static_cast<unsigned long long>(m_parentMapPeakStmts));
+    if (const AccessSpecifierManager *a = m_context->accessSpecifierManager)
+        os << llvm::format("        AccessSpecifierManager: %llu classes, %llu specifiers\n",
+                           static_cast<unsigned long long>(a->numClasses()), static_cast<unsigned long long>(a->numSpecifiers()));
+    os << llvm::format("        SuppressionManager: %llu files, %llu suppressions\n",
+                       static_cast<unsigned long long>(m_context->suppressionManager.numFiles()),
+                       static_cast<unsigned long long>(m_context->suppressionManager.numSuppressions()));
+    if (const FixItExporter *exporter = m_context->exporter)
+        os << llvm::format("        FixItExporter: %llu diagnostics, %.1fKB\n", static_cast<unsigned long long>(exporter->numDiagnostics()),
+                           exporter->diagnosticsBytes() / 1024.0);
 }
 
 static bool parseArgument(const string &arg, vector<string> &args)
@@ -202,14 +918,18 @@ ClazyASTAction::ClazyASTAction()
 {
 }
 
-std::unique_ptr<clang::ASTConsumer> ClazyASTAction::CreateASTConsumer(CompilerInstance &, llvm::StringRef)
+std::unique_ptr<clang::ASTConsumer> ClazyASTAction::CreateASTConsumer(CompilerInstance &ci, llvm::StringRef)
 {
     // NOTE: This method needs to be kept reentrant (but not necessarily thread-safe)
     // Might be called from multiple threads via libclang, each thread operates on a different instance though
 
-    std::lock_guard<std::mutex> lock(CheckManager::lock());
-
     auto astConsumer = std::unique_ptr<ClazyASTConsumer>(new ClazyASTConsumer(m_context));
+
+    // As a plugin we can't prevent the parsing, but we don't need to create the checks
+    // HandleTranslationUnit() bails out early too
+    if ((m_options & ClazyContext::ClazyOption_OnlyQt) && !ClazyContext::isQtTranslationUnit(ci.getPreprocessorOpts()))
+        return std::unique_ptr<clang::ASTConsumer>(astConsumer.release());
+
     auto createdChecks = m_checkManager->createChecks(m_checks, m_context);
     for (auto check : createdChecks) {
         astConsumer->addCheck(check);
@@ -262,19 +982,35 @@ bool ClazyASTAction::ParseArgs(const CompilerInstance &ci, const std::vector<std
     if (parseArgument("ignore-included-files", args))
         m_options |= ClazyContext::ClazyOption_IgnoreIncludedFiles;
 
+    if (parseArgument("print-stats", args))
+        m_options |= ClazyContext::ClazyOption_PrintStats;
+
+    if (parseArgument("perf-counters", args))
+        m_options |= ClazyContext::ClazyOption_PrintStats | ClazyContext::ClazyOption_PerfCounters;
+
+    if (parseArgument("matchers-in-traversal", args))
+        m_options |= ClazyContext::ClazyOption_MatchersInTraversal;
+
+    if (parseArgument("deduplicate-warnings", args))
+        m_options |= ClazyContext::ClazyOption_DeduplicateWarnings;
+
     if (parseArgument("export-fixes", args))
         exportFixesFilename = args.at(0);
 
-    m_context = new ClazyContext(ci, headerFilter, ignoreDirs, exportFixesFilename, {}, m_options);
+    LineFilter lineFilter;
+    std::string lineFilterError;
+    const string lineFilterJson = getEnvVariable("CLAZY_LINE_FILTER");
+    if (!lineFilterJson.empty() && !lineFilter.parse(lineFilterJson, lineFilterError)) {
+        llvm::errs() << "Invalid CLAZY_LINE_FILTER: " << lineFilterError << "\n";
+        return false;
+    }
+
+    m_context = new ClazyContext(ci, headerFilter, ignoreDirs, exportFixesFilename, {}, m_options, std::move(lineFilter));
 
     // This argument is for debugging purposes
     const bool dbgPrintRequestedChecks = parseArgument("print-requested-checks", args);
 
-    {
-        std::lock_guard<std::mutex> lock(CheckManager::lock());
-        m_checks = m_checkManager->requestedChecks(args,
-                                                   m_options & ClazyContext::ClazyOption_Qt4Compat);
-    }
+    m_checks = m_checkManager->requestedChecks(args, m_options & ClazyContext::ClazyOption_Qt4Compat);
 
     if (args.size() > 1) {
         // Too many arguments.
@@ -315,7 +1051,6 @@ void ClazyASTAction::printRequestedChecks() const
 
 void ClazyASTAction::PrintHelp(llvm::raw_ostream &ros) const
 {
-    std::lock_guard<std::mutex> lock(CheckManager::lock());
     RegisteredCheck::List checks = m_checkManager->availableChecks(MaxCheckLevel);
 
     clazy::sort(checks, checkLessThanByLevel);
@@ -362,7 +1097,8 @@ void ClazyASTAction::PrintHelp(llvm::raw_ostream &ros) const
     ros << "To specify which checks to enable set the CLAZY_CHECKS env variable, for example:\n";
     ros << "    export CLAZY_CHECKS=\"level0\"\n";
     ros << "    export CLAZY_CHECKS=\"level0,reserve-candidates,qstring-allocations\"\n";
-    ros << "    export CLAZY_CHECKS=\"reserve-candidates\"\n\n";
+    ros << "    export CLAZY_CHECKS=\"reserve-candidates\"\n";
+    ros << "    export CLAZY_CHECKS=\"level1,cheap\"\n\n";
     ros << "or pass as compiler arguments, for example:\n";
     ros << "    -Xclang -plugin-arg-clazy -Xclang reserve-candidates,qstring-allocations\n";
     ros << "\n";
@@ -373,7 +1109,8 @@ ClazyStandaloneASTAction::ClazyStandaloneASTAction(const string &checkList,
                                                    const string &ignoreDirs,
                                                    const string &exportFixesFilename,
                                                    const std::vector<string> &translationUnitPaths,
-                                                   ClazyContext::ClazyOptions options)
+                                                   ClazyContext::ClazyOptions options,
+                                                   const LineFilter &lineFilter)
     : clang::ASTFrontendAction()
     , m_checkList(checkList.empty() ? "level1" : checkList)
     , m_headerFilter(headerFilter.empty() ? getEnvVariable("CLAZY_HEADER_FILTER") : headerFilter)
@@ -381,14 +1118,21 @@ ClazyStandaloneASTAction::ClazyStandaloneASTAction(const string &checkList,
     , m_exportFixesFilename(exportFixesFilename)
     , m_translationUnitPaths(translationUnitPaths)
     , m_options(options)
+    , m_lineFilter(lineFilter)
 {
 }
 
 unique_ptr<ASTConsumer> ClazyStandaloneASTAction::CreateASTConsumer(CompilerInstance &ci, llvm::StringRef)
 {
-    auto context = new ClazyContext(ci, m_headerFilter, m_ignoreDirs, m_exportFixesFilename, m_translationUnitPaths, m_options);
+    // Called concurrently when clazy-standalone runs with -j. The CheckManager is read-only, so no locking needed.
+    auto context = new ClazyContext(ci, m_headerFilter, m_ignoreDirs, m_exportFixesFilename, m_translationUnitPaths, m_options, m_lineFilter);
     auto astConsumer = new ClazyASTConsumer(context);
 
+    // The context is still created, as the YAML export counts the translation units
+    m_skipsTranslationUnit = (m_options & ClazyContext::ClazyOption_OnlyQt) && !ClazyContext::isQtTranslationUnit(ci.getPreprocessorOpts());
+    if (m_skipsTranslationUnit)
+        return unique_ptr<ASTConsumer>(astConsumer);
+
     auto cm = CheckManager::instance();
 
     vector<string> checks; checks.push_back(m_checkList);
@@ -400,14 +1144,55 @@ unique_ptr<ASTConsumer> ClazyStandaloneASTAction::CreateASTConsumer(CompilerInst
         return nullptr;
     }
 
-    auto createdChecks = cm->createChecks(requestedChecks, context);
+    // Checks are per worker thread, same as the translation unit they are bound to
+    static thread_local ReusableChecks s_reusableChecks;
+    astConsumer->setReusableChecks(&s_reusableChecks);
+#ifndef CLAZY_DISABLE_AST_MATCHERS
+    static thread_local ReusableMatchFinder s_reusableMatchFinder;
+    astConsumer->setReusableMatchFinder(&s_reusableMatchFinder);
+#endif
+
+    auto createdChecks = cm->createChecks(requestedChecks, context, &s_reusableChecks);
     for (const auto &check : createdChecks) {
         astConsumer->addCheck(check);
     }
 
+    // An AST file, from clang -emit-ast, is deserialized instead of parsed, so the checks would silently miss warnings
+    if (isCurrentFileAST()) {
+        DiagnosticsEngine &engine = ci.getDiagnostics();
+        const unsigned int id = engine.getCustomDiagID(DiagnosticsEngine::Error, "clazy: %0 needs the preprocessor, so it doesn't run on AST files");
+        for (const auto &check : createdChecks) {
+            if (check.first->visitsPreprocessor())
+                engine.Report(id) << check.first->name();
+        }
+    }
+
+    // Parsing and Sema of the inline functions of every included header is most of the time spent
+    // when only declarations are checked. Unlike the plugin we do the parsing, so we can skip them.
+    const bool ignoresFunctionBodies = std::all_of(requestedChecks.cbegin(), requestedChecks.cend(), [](const RegisteredCheck &check) {
+        return check.options & RegisteredCheck::Option_IgnoresFunctionBodies;
+    });
+    if (ignoresFunctionBodies) {
+        ci.getFrontendOpts().SkipFunctionBodies = true;
+        astConsumer->setSkipsHeaderFunctionBodies(true);
+    }
+
     return unique_ptr<ASTConsumer>(astConsumer);
 }
 
+void ClazyStandaloneASTAction::ExecuteAction()
+{
+    if (!m_skipsTranslationUnit) {
+        ASTFrontendAction::ExecuteAction();
+        return;
+    }
+
+    // Don't even parse it. HandleTranslationUnit() only does its bookkeeping for non-Qt translation units.
+    CompilerInstance &ci = getCompilerInstance();
+    if (ci.hasASTConsumer() && ci.hasASTContext())
+        ci.getASTConsumer().HandleTranslationUnit(ci.getASTContext());
+}
+
 volatile int ClazyPluginAnchorSource = 0;
 
 static FrontendPluginRegistry::Add<ClazyASTAction>
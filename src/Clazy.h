@@ -32,8 +32,12 @@
 #include <clang/AST/ASTConsumer.h>
 #include <clang/Frontend/FrontendAction.h>
 #include <clang/AST/RecursiveASTVisitor.h>
+#include <llvm/ADT/StringMap.h>
 #include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Timer.h>
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <string>
@@ -71,7 +75,7 @@ private:
     void printRequestedChecks() const;
     RegisteredCheck::List m_checks;
     ClazyContext::ClazyOptions m_options = 0;
-    CheckManager *const m_checkManager;
+    const CheckManager *const m_checkManager;
     ClazyContext *m_context = nullptr;
 };
 
@@ -87,9 +91,11 @@ public:
                                       const std::string &ignoreDirs,
                                       const std::string &exportFixesFilename,
                                       const std::vector<std::string> &translationUnitPaths,
-                                      ClazyContext::ClazyOptions = ClazyContext::ClazyOption_None);
+                                      ClazyContext::ClazyOptions = ClazyContext::ClazyOption_None,
+                                      const LineFilter &lineFilter = LineFilter());
 protected:
     std::unique_ptr<clang::ASTConsumer> CreateASTConsumer(clang::CompilerInstance &ci, llvm::StringRef) override;
+    void ExecuteAction() override;
 private:
     const std::string m_checkList;
     const std::string m_headerFilter;
@@ -97,8 +103,23 @@ private:
     const std::string m_exportFixesFilename;
     const std::vector<std::string> m_translationUnitPaths;
     const ClazyContext::ClazyOptions m_options;
+    const LineFilter m_lineFilter;
+    bool m_skipsTranslationUnit = false; // Not Qt, with ClazyOption_OnlyQt
 };
 
+#ifndef CLAZY_DISABLE_AST_MATCHERS
+/**
+ * A MatchFinder that clazy-standalone keeps between the translation units of a worker thread, so the matchers
+ * are only built once. Only reused by a consumer with exactly the same check instances, which means all of them
+ * were reusable checks.
+ */
+struct ReusableMatchFinder
+{
+    std::unique_ptr<clang::ast_matchers::MatchFinder> finder;
+    CheckBase::List checks; // The checks whose matchers finder has
+};
+#endif
+
 /**
  * Clazy's AST Consumer.
  */
@@ -111,22 +132,137 @@ public:
     ~ClazyASTConsumer() override;
     bool shouldVisitImplicitCode() const { return m_context->isVisitImplicitCode(); }
 
+    bool TraverseDecl(clang::Decl *decl);
     bool VisitDecl(clang::Decl *decl);
     bool VisitStmt(clang::Stmt *stm);
+
+    // RecursiveASTVisitor calls these around each statement and its children, they maintain ClazyContext::traversalStack
+    bool dataTraverseStmtPre(clang::Stmt *stmt)
+    {
+        m_context->traversalStack.push(stmt);
+        return true;
+    }
+
+    bool dataTraverseStmtPost(clang::Stmt *)
+    {
+        m_context->traversalStack.pop();
+        return true;
+    }
+
     void HandleTranslationUnit(clang::ASTContext &ctx) override;
     void addCheck(const std::pair<CheckBase *, RegisteredCheck> &check);
 
+    /**
+     * Called by Sema, when FrontendOptions::SkipFunctionBodies is set, for each function body it could skip parsing.
+     */
+    bool shouldSkipFunctionBody(clang::Decl *decl) override;
+
+    /**
+     * Skips parsing function bodies outside of the main file. Only for checks with Option_IgnoresFunctionBodies,
+     * clazy-standalone also needs to set FrontendOptions::SkipFunctionBodies.
+     */
+    void setSkipsHeaderFunctionBodies(bool skips) { m_skipsHeaderFunctionBodies = skips; }
+
+    /**
+     * The reusable checks are given back to reusableChecks when the translation unit is done.
+     */
+    void setReusableChecks(ReusableChecks *reusableChecks) { m_reusableChecks = reusableChecks; }
+
+#ifndef CLAZY_DISABLE_AST_MATCHERS
+    /**
+     * The MatchFinder is taken from reusableMatchFinder if it was built for the same checks, and given back
+     * to it when the translation unit is done, if all checks are reusable.
+     */
+    void setReusableMatchFinder(ReusableMatchFinder *reusableMatchFinder) { m_reusableMatchFinder = reusableMatchFinder; }
+#endif
+
     ClazyContext *context() const { return m_context; }
 
 private:
     ClazyASTConsumer(const ClazyASTConsumer &) = delete;
+    void printStats(const ClazyStat &traversal) const;
+    void recordRunStats() const; // For clazy-standalone's -stats-json
+    void emitTimeTraceEvents() const; // For clang's -ftime-trace
+    double matchersSeconds(const CheckBase *check) const;
+    void resetParentMap(clang::Stmt *root);
+
+    /**
+     * Returns false if no enabled check visits any node in the function's body, parameters or initializers,
+     * which can then be skipped. Conservative.
+     */
+    bool mayInterestChecks(const clang::FunctionDecl *fdecl, const clang::Stmt *body) const;
+    bool mayInterestChecks(const clang::Stmt *root) const;
+
+    /**
+     * Returns true if decl and its children would all be rejected by VisitDecl() and VisitStmt(),
+     * because it's inside a system header, came from a PCH or module and m_prunesAstFileDecls is set,
+     * or is inside a file excluded by the ignore-dirs, the header filter or the line filter and m_prunesIgnoredFileDecls is set.
+     * Namespaces aren't pruned, but their children are, by our TraverseDecl().
+     */
+    bool isPrunable(clang::Decl *decl) const;
+
+    /**
+     * Visits the record definitions and typedefs of a pruned declaration, which VisitDecl() handles even in
+     * system headers, without a full traversal.
+     */
+    void visitPrunedDecls(clang::Decl *decl);
+
+    /**
+     * Sets ClazyContext::cacheableNodeLoc to loc, unless enclosingDecl is part of a template instantiation. Returns true
+     * if the node is in a header whose warnings were replayed from the header cache, so the cache_safe checks can skip it.
+     */
+    bool enterCacheableNode(clang::SourceLocation loc, const clang::Decl *enclosingDecl);
+
+    /**
+     * Returns true once the AST traversal took longer than CLAZY_TIME_BUDGET, reporting it the first time.
+     * The clock is only read every 256 calls, and never without a budget.
+     */
+    bool exceedsTimeBudget();
+
+    /**
+     * Disables check for the rest of the translation unit, with a warning, if its visits took longer
+     * than CLAZY_CHECK_TIME_BUDGET.
+     */
+    void enforceCheckTimeBudget(CheckBase *check);
+    std::string mainFileName() const;
+
+    /**
+     * With deduplicate-warnings, emits the deferred warnings of the overlapping checks, in source order, once it's
+     * known which ones aren't shadowed by a preferred check.
+     */
+    void emitDeferredWarnings();
+#ifndef CLAZY_DISABLE_AST_MATCHERS
+    template <typename T>
+    void matchInTraversal(const T &node);
+    void createMatchFinder();
+#endif
     clang::Stmt *lastStm = nullptr;
+    clang::Stmt *m_parentMapRoot = nullptr;
+    bool m_needsParentMap = false; // True if any check uses ClazyContext::parentMap
+    bool m_insideFunctionBody = false;
+    bool m_prescreensBodies = false; // See mayInterestChecks()
+    bool m_tracesChecks = false; // If clang's -ftime-trace is on
+    bool m_skipsHeaderFunctionBodies = false;
+    bool m_prunesAstFileDecls = false; // See isPrunable()
+    bool m_prunesIgnoredFileDecls = false; // See isPrunable()
+    bool m_exceededTimeBudget = false; // See exceedsTimeBudget()
+    unsigned int m_nodesSinceTimeBudgetCheck = 0; // See exceedsTimeBudget()
+    bool m_hasCacheSafeChecks = false; // See enterCacheableNode()
+    std::chrono::steady_clock::time_point m_traversalStart;
+    uint64_t m_numPrescreenedBodies = 0; // Only counted with print-stats
+    uint64_t m_numPrunedDecls = 0; // Only counted with print-stats
+    size_t m_parentMapPeakStmts = 0; // Largest ParentMap built, only counted with print-stats
     ClazyContext *const m_context;
-    //CheckBase::List m_createdChecks;
-    CheckBase::List m_checksToVisitStmts;
-    CheckBase::List m_checksToVisitDecls;
+    CheckBase::List m_createdChecks;
+    ReusableChecks *m_reusableChecks = nullptr;
+    std::vector<CheckBase::List> m_checksToVisitStmts; // Indexed by Stmt::StmtClass
+    std::vector<CheckBase::List> m_checksToVisitDecls; // Indexed by Decl::Kind
 #ifndef CLAZY_DISABLE_AST_MATCHERS
-    clang::ast_matchers::MatchFinder *m_matchFinder = nullptr;
+    clang::ast_matchers::MatchFinder *m_matchFinder = nullptr; // Created when all checks were added
+    ReusableMatchFinder *m_reusableMatchFinder = nullptr;
+    llvm::StringMap<llvm::TimeRecord> m_matcherTimes; // Filled by m_matchFinder with print-stats
+    llvm::StringMap<llvm::TimeRecord> m_traversalMatcherTimes; // Sum of m_matcherTimes over every matchInTraversal() call
+    ClazyStat m_matching;
 #endif
 };
 
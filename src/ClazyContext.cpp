@@ -20,34 +20,83 @@
 */
 
 #include "AccessSpecifierManager.h"
+#include "Baseline.h"
 #include "ClazyContext.h"
 #include "FixItExporter.h"
+#include "FixItUtils.h"
+#include "FunctionHotness.h"
+#include "HeaderCache.h"
+#include "JsonlExporter.h"
+#include "PerfCounters.h"
+#include "PreprocessorDispatcher.h"
+#include "QtRegistry.h"
+#include "SarifExporter.h"
+#include "StmtIndex.h"
+#include "WarningDeduplicator.h"
+#include "WasteReport.h"
 #include "PreProcessorVisitor.h"
 
+#include <clang/AST/Decl.h>
+#include <clang/AST/Mangle.h>
 #include <clang/AST/ParentMap.h>
 #include <clang/Frontend/CompilerInstance.h>
+#include <clang/Lex/Preprocessor.h>
 #include <clang/Lex/PreprocessorOptions.h>
 #include <clang/Rewrite/Frontend/FixItRewriter.h>
+#include <llvm/ADT/StringRef.h>
 #include <llvm/Support/Regex.h>
+#include <llvm/Support/raw_ostream.h>
 
 #include <stdlib.h>
 
+#include <atomic>
+
 using namespace std;
 using namespace clang;
 
 
+static unsigned int numberFromEnv(const char *name, const char *unit)
+{
+    unsigned int number = 0;
+    const char *value = getenv(name);
+    if (value && llvm::StringRef(value).getAsInteger(10, number))
+        llvm::errs() << "clazy: Invalid " << name << ", expected " << unit << ": " << value << "\n";
+
+    return number;
+}
+
+static std::atomic<uint64_t> s_numEmittedWarnings(0);
+static unsigned int s_maxWarnings = 0; // Set by setMaxWarnings()
+
 ClazyContext::ClazyContext(const clang::CompilerInstance &compiler,
                            const string &headerFilter, const string &ignoreDirs,
                            string exportFixesFilename,
-                           const std::vector<string> &translationUnitPaths, ClazyOptions opts)
-    : ci(compiler)
-    , astContext(ci.getASTContext())
-    , sm(ci.getSourceManager())
+                           const std::vector<string> &translationUnitPaths, ClazyOptions opts,
+                           LineFilter lineFilter_)
+    : ClazyContext(compiler.getASTContext(), compiler.getPreprocessor(), headerFilter, ignoreDirs,
+                   std::move(exportFixesFilename), translationUnitPaths, opts, std::move(lineFilter_))
+{
+}
+
+ClazyContext::ClazyContext(clang::ASTContext &context, clang::Preprocessor &preprocessor,
+                           const string &headerFilter, const string &ignoreDirs,
+                           string exportFixesFilename,
+                           const std::vector<string> &translationUnitPaths, ClazyOptions opts,
+                           LineFilter lineFilter_)
+    : pp(preprocessor)
+    , astContext(context)
+    , sm(context.getSourceManager())
     , m_noWerror(getenv("CLAZY_NO_WERROR") != nullptr) // Allows user to make clazy ignore -Werror
     , options(opts)
     , extraOptions(clazy::splitString(getenv("CLAZY_EXTRA_OPTIONS"), ','))
+    , checkTimeBudget(numberFromEnv("CLAZY_CHECK_TIME_BUDGET", "milliseconds"))
+    , timeBudget(numberFromEnv("CLAZY_TIME_BUDGET", "milliseconds"))
+    , maxWarnings(s_maxWarnings > 0 ? s_maxWarnings : numberFromEnv("CLAZY_MAX_WARNINGS", "a number of warnings"))
+    , lineFilter(std::move(lineFilter_))
     , m_translationUnitPaths(translationUnitPaths)
 {
+    clazy::clearTokenCache(); // Its ASTContext could be at the address of a previous translation unit's
+
     if (!headerFilter.empty())
         headerFilterRegex = std::unique_ptr<llvm::Regex>(new llvm::Regex(headerFilter));
 
@@ -55,17 +104,56 @@ ClazyContext::ClazyContext(const clang::CompilerInstance &compiler,
         ignoreDirsRegex = std::unique_ptr<llvm::Regex>(new llvm::Regex(ignoreDirs));
 
     if (exportFixesEnabled()) {
-        if (exportFixesFilename.empty()) {
-            // Only clazy-standalone sets the filename by argument.
+        if (exportFixesFilename.empty() && !(options & ClazyOption_ApplyFixes)) {
+            // Only clazy-standalone sets the filename by argument, or none if it applies the fixes itself.
             // clazy plugin sets it automatically here:
             const FileEntry *fileEntry = sm.getFileEntryForID(sm.getMainFileID());
             exportFixesFilename = fileEntry->getName().str() + ".clazy.yaml";
         }
 
         const bool isClazyStandalone = !translationUnitPaths.empty();
-        exporter = new FixItExporter(ci.getDiagnostics(), sm, ci.getLangOpts(),
+        exporter = new FixItExporter(pp.getDiagnostics(), sm, pp.getLangOpts(),
                                      exportFixesFilename, isClazyStandalone);
     }
+
+    if (options & ClazyOption_IndexOnly)
+        return;
+
+    const char *jsonlFilename = getenv("CLAZY_EXPORT_JSONL");
+    if (jsonlFilename && *jsonlFilename)
+        jsonlExporter = new JsonlExporter(sm, pp.getLangOpts(), jsonlFilename);
+
+    const char *sarifDir = getenv("CLAZY_EXPORT_SARIF");
+    if (sarifDir && *sarifDir)
+        sarifExporter = new SarifExporter(sm, pp.getLangOpts(), sarifDir);
+
+    baseline = Baseline::instance();
+    hotness = FunctionHotness::instance();
+
+    const char *baselineFilename = getenv("CLAZY_EXPORT_BASELINE");
+    if (baselineFilename && *baselineFilename)
+        baselineExporter = new BaselineExporter(sm, baselineFilename);
+
+    if (options & ClazyOption_PerfCounters)
+        perfCounters = new PerfCounters();
+
+    if (options & ClazyOption_DeduplicateWarnings)
+        deduplicator = new WarningDeduplicator(sm);
+
+    // Cached warnings can't carry fixits or check names, and there's nothing to cache if headers are ignored.
+    // With a line filter, a baseline, a hotness profile, a time budget or a maximum of warnings, the warnings can be incomplete.
+    // The waste report needs the estimates of the warnings, which aren't cached.
+    const char *headerCacheDir = getenv("CLAZY_HEADER_CACHE_DIR");
+    const bool usesHeaderCache = (headerCacheDir && *headerCacheDir) || HeaderCache::isInMemory();
+    if (usesHeaderCache && !exportFixesEnabled() && !jsonlExporter && !sarifExporter && !ignoresIncludedFiles() && lineFilter.isEmpty()
+        && !baseline && !baselineExporter && !hotness && !WasteReport::instance() && checkTimeBudget == 0 && timeBudget == 0 && maxWarnings == 0) {
+        headerCache = new HeaderCache(pp, preprocessorDispatcher(), headerCacheDir ? headerCacheDir : "");
+        headerCache->addToConfiguration(to_string(options & ~(ClazyOption_PrintStats | ClazyOption_PerfCounters | ClazyOption_CollectStats))); // Stats don't change the warnings
+        headerCache->addToConfiguration(headerFilter);
+        headerCache->addToConfiguration(ignoreDirs);
+        for (const string &extraOption : extraOptions)
+            headerCache->addToConfiguration(extraOption);
+    }
 }
 
 ClazyContext::~ClazyContext()
@@ -73,16 +161,26 @@ ClazyContext::~ClazyContext()
     //delete preprocessorVisitor; // we don't own it
     delete accessSpecifierManager;
     delete parentMap;
-
-    static unsigned long count = 0;
-    count++;
+    delete headerCache;
+    delete jsonlExporter;
+    delete sarifExporter;
+    delete baselineExporter;
+    delete perfCounters;
+    delete deduplicator;
+    delete m_qtRegistry;
+    delete m_stmtIndex;
+    delete m_mangleContext;
 
     if (exporter) {
+        // Atomic, as clazy-standalone -j destroys contexts from several threads
+        static std::atomic<unsigned long> s_count(0);
+        const unsigned long count = ++s_count;
+
         // With clazy-standalone we use the same YAML file for all translation-units, so only
-        // write out the last one. With clazy-plugin there's a YAML file per translation unit.
+        // write out the last one. With clazy-plugin, or when exporting to a directory, there's a YAML file per translation unit.
         const bool isClazyPlugin = m_translationUnitPaths.empty();
         const bool isLast = count == m_translationUnitPaths.size();
-        if (isLast || isClazyPlugin)
+        if (isLast || isClazyPlugin || exporter->exportsPerTranslationUnit())
             exporter->Export();
         delete exporter;
     }
@@ -90,18 +188,166 @@ ClazyContext::~ClazyContext()
     preprocessorVisitor = nullptr;
     accessSpecifierManager = nullptr;
     parentMap = nullptr;
+    headerCache = nullptr;
+    jsonlExporter = nullptr;
+    sarifExporter = nullptr;
+    baseline = nullptr;
+    baselineExporter = nullptr;
+    hotness = nullptr;
+    perfCounters = nullptr;
+    deduplicator = nullptr;
+    m_preprocessorDispatcher = nullptr;
+    m_qtRegistry = nullptr;
+    m_stmtIndex = nullptr;
+    m_mangleContext = nullptr;
+}
+
+const ClazyContext::FileInfo &ClazyContext::fileInfo(SourceLocation loc) const
+{
+    const FileID fid = loc.isValid() ? sm.getDecomposedExpansionLoc(loc).first : FileID();
+    if (m_lastFileInfo && fid == m_lastFileID)
+        return *m_lastFileInfo;
+
+    auto it = m_fileInfos.find(fid.getHashValue());
+    if (it == m_fileInfos.end()) {
+        it = m_fileInfos.insert({ fid.getHashValue(), FileInfo() }).first;
+        computeFileInfo(fid, it->second);
+    }
+
+    m_lastFileID = fid;
+    m_lastFileInfo = &it->second;
+    return it->second;
+}
+
+void ClazyContext::computeFileInfo(FileID fid, FileInfo &info) const
+{
+    const FileEntry *file = fid.isValid() ? sm.getFileEntryForID(fid) : nullptr;
+    if (!file)
+        return;
+
+    info.name = llvm::StringRef(file->getName()).str();
+    info.isMainFile = fid == sm.getMainFileID() || (isUnityBuild() && sm.getFileID(sm.getIncludeLoc(fid)) == sm.getMainFileID());
+
+    // 0. Files not listed in the line filter get no warnings at all
+    if (!lineFilter.isEmpty()) {
+        info.lineFilter = lineFilter.fileFor(info.name);
+        if (!info.lineFilter) {
+            info.isIgnored = true;
+            return;
+        }
+    }
+
+    // 1. Warnings in system headers are never wanted, as with clang's own warnings
+    if (sm.isInSystemHeader(sm.getLocForStartOfFile(fid))) {
+        info.isIgnored = true;
+        return;
+    }
+
+    // 2. Process the regexp that excludes files
+    if (ignoreDirsRegex && ignoreDirsRegex->match(info.name)) {
+        info.isIgnored = true;
+        return;
+    }
+
+    // 3. Process the regexp that includes files. Has lower priority.
+    info.isIgnored = headerFilterRegex && !info.isMainFile && !headerFilterRegex->match(info.name);
+}
+
+bool ClazyContext::passesLineFilter(SourceRange range) const
+{
+    if (lineFilter.isEmpty() || range.isInvalid())
+        return true;
+
+    const SourceLocation begin = sm.getExpansionLoc(range.getBegin());
+    const SourceLocation end = sm.getExpansionLoc(range.getEnd());
+    if (sm.getFileID(begin) != sm.getFileID(end))
+        return true;
+
+    const FileInfo &info = fileInfo(begin);
+    if (!info.lineFilter)
+        return info.name.empty(); // Not listed, unless it's not a file
+
+    return LineFilter::overlaps(*info.lineFilter, sm.getExpansionLineNumber(begin), sm.getExpansionLineNumber(end));
+}
+
+PreprocessorDispatcher *ClazyContext::preprocessorDispatcher() const
+{
+    if (!m_preprocessorDispatcher) {
+        m_preprocessorDispatcher = new PreprocessorDispatcher(pp);
+        pp.addPPCallbacks(std::unique_ptr<PPCallbacks>(m_preprocessorDispatcher));
+    }
+
+    return m_preprocessorDispatcher;
+}
+
+const QtRegistry &ClazyContext::qtRegistry() const
+{
+    if (!m_qtRegistry)
+        m_qtRegistry = new QtRegistry(astContext);
+
+    return *m_qtRegistry;
+}
+
+const StmtIndex *ClazyContext::functionStmtIndex(Stmt *stmt) const
+{
+    Stmt *body = lastFunctionDecl ? lastFunctionDecl->getBody() : nullptr;
+    if (!body || !stmt)
+        return nullptr;
+
+    if (!m_stmtIndex || m_stmtIndex->root() != body) {
+        delete m_stmtIndex;
+        m_stmtIndex = new StmtIndex(body);
+    }
+
+    return m_stmtIndex->contains(stmt) ? m_stmtIndex : nullptr;
+}
+
+const FunctionDecl *ClazyContext::enclosingFunction(SourceLocation loc) const
+{
+    const FunctionDecl *func = lastFunctionDecl;
+    if (!func || !func->getBody() || loc.isInvalid())
+        return nullptr;
+
+    const SourceLocation expansionLoc = sm.getExpansionLoc(loc);
+    const SourceRange range = func->getSourceRange();
+    if (sm.isBeforeInTranslationUnit(expansionLoc, sm.getExpansionLoc(range.getBegin()))
+        || sm.isBeforeInTranslationUnit(sm.getExpansionLoc(range.getEnd()), expansionLoc))
+        return nullptr;
+
+    return func;
+}
+
+bool ClazyContext::enclosingFunctionHotness(SourceLocation loc, uint64_t &count) const
+{
+    const FunctionDecl *func = hotness ? enclosingFunction(loc) : nullptr;
+    if (!func)
+        return false;
+
+    // Checks warn several times per function, mangle it once
+    if (func != m_hotnessFunction) {
+        if (!m_mangleContext)
+            m_mangleContext = astContext.createMangleContext();
+
+        const string name = FunctionHotness::mangledName(*m_mangleContext, func);
+        m_hotnessFunction = func;
+        m_hotnessFunctionFound = !name.empty();
+        m_hotnessFunctionCount = m_hotnessFunctionFound ? hotness->count(name) : 0;
+    }
+
+    count = m_hotnessFunctionCount;
+    return m_hotnessFunctionFound;
 }
 
 void ClazyContext::enableAccessSpecifierManager()
 {
     if (!accessSpecifierManager && !usingPreCompiledHeaders())
-        accessSpecifierManager = new AccessSpecifierManager(ci);
+        accessSpecifierManager = new AccessSpecifierManager(this);
 }
 
 void ClazyContext::enablePreprocessorVisitor()
 {
     if (!preprocessorVisitor && !usingPreCompiledHeaders())
-        preprocessorVisitor = new PreProcessorVisitor(ci);
+        preprocessorVisitor = new PreProcessorVisitor(this);
 }
 
 void ClazyContext::enableVisitallTypeDefs()
@@ -118,13 +364,30 @@ bool ClazyContext::visitsAllTypedefs() const
 
 bool ClazyContext::isQt() const
 {
-    static const bool s_isQt = [this] {
-                                   for (auto s : ci.getPreprocessorOpts().Macros) {
-                                       if (s.first == "QT_CORE_LIB")
-                                           return true;
-                                   }
-                                   return false;
-                               } ();
+    return isQtTranslationUnit(pp.getPreprocessorOpts());
+}
+
+uint64_t ClazyContext::numEmittedWarnings()
+{
+    return s_numEmittedWarnings.load(std::memory_order_relaxed);
+}
+
+void ClazyContext::countEmittedWarning()
+{
+    s_numEmittedWarnings.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ClazyContext::setMaxWarnings(unsigned int max)
+{
+    s_maxWarnings = max;
+}
+
+bool ClazyContext::isQtTranslationUnit(const clang::PreprocessorOptions &preprocessorOptions)
+{
+    for (const auto &macro : preprocessorOptions.Macros) {
+        if (!macro.second && macro.first == "QT_CORE_LIB")
+            return true;
+    }
 
-    return s_isQt;
+    return false;
 }
@@ -22,18 +22,27 @@
 #ifndef CLAZY_CONTEXT_H
 #define CLAZY_CONTEXT_H
 
+#include "LineFilter.h"
+#include "StmtFacts.h"
 #include "SuppressionManager.h"
+#include "TraversalStack.h"
+#include "TypeUtils.h"
 #include "clazy_stl.h"
 
 #include <clang/Frontend/CompilerInstance.h>
+#include <clang/Lex/Preprocessor.h>
 #include <clang/Lex/PreprocessorOptions.h>
 #include <clang/Basic/FileManager.h>
 #include <clang/Basic/SourceLocation.h>
 #include <clang/Basic/SourceManager.h>
+#include <llvm/Support/Allocator.h>
 #include <llvm/Support/Regex.h>
 #include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Path.h>
 
+#include <cstdint>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 #include <utility>
@@ -47,11 +56,26 @@ class ParentMap;
 class SourceManager;
 class CXXMethodDecl;
 class Decl;
+class FunctionDecl;
+class MangleContext;
+class StringLiteral;
 }
 
 class AccessSpecifierManager;
 class PreProcessorVisitor;
+class PreprocessorDispatcher;
+class Baseline;
+class BaselineExporter;
 class FixItExporter;
+class FunctionHotness;
+class HeaderCache;
+class JsonlExporter;
+class PerfCounters;
+class QtRegistry;
+class StmtIndex;
+class SarifExporter;
+class WarningDeduplicator;
+class WarningSink;
 
 class ClazyContext
 {
@@ -63,7 +87,15 @@ public:
         ClazyOption_OnlyQt = 4, // Ignore non-Qt files. This is done by bailing out if QT_CORE_LIB is not set.
         ClazyOption_QtDeveloper = 8, // For running clazy on Qt itself, optional, but honours specific guidelines
         ClazyOption_VisitImplicitCode = 16, // Inspect compiler generated code aswell, useful for custom checks, if they need it
-        ClazyOption_IgnoreIncludedFiles = 32 // Only warn for the current file being compiled, not on includes (useful for performance reasons)
+        ClazyOption_IgnoreIncludedFiles = 32, // Only warn for the current file being compiled, not on includes (useful for performance reasons)
+        ClazyOption_PrintStats = 64, // Print how much time each check took, at the end of each translation unit
+        ClazyOption_MatchersInTraversal = 128, // Run AST matchers on the nodes of our traversal, instead of doing a second one
+        ClazyOption_ApplyFixes = 256, // clazy-standalone applies the exported fixits itself at the end of the run
+        ClazyOption_UnityBuild = 512, // The main file only includes the files to analyze, which are treated as main files
+        ClazyOption_IndexOnly = 1024, // For the clazyMiniAstDumper plugin, which emits no warnings, so needs no exporters or header cache
+        ClazyOption_PerfCounters = 2048, // Also print the hardware performance counters of each check, with ClazyOption_PrintStats
+        ClazyOption_CollectStats = 4096, // Collect the stats without printing them, for clazy-standalone's -stats-json
+        ClazyOption_DeduplicateWarnings = 8192 // Only keep the preferred warning of overlapping checks, see WarningDeduplicator
     };
     typedef int ClazyOptions;
 
@@ -72,12 +104,26 @@ public:
                           const std::string &ignoreDirs,
                           std::string exportFixesFilename,
                           const std::vector<std::string> &translationUnitPaths,
-                          ClazyOptions = ClazyOption_None);
+                          ClazyOptions = ClazyOption_None,
+                          LineFilter lineFilter = LineFilter());
+
+    /**
+     * For hosts which only expose the parts of a CompilerInstance, like the clang-tidy module.
+     * pp must be the preprocessor which produced astContext.
+     */
+    ClazyContext(clang::ASTContext &astContext,
+                 clang::Preprocessor &pp,
+                 const std::string &headerFilter,
+                 const std::string &ignoreDirs,
+                 std::string exportFixesFilename,
+                 const std::vector<std::string> &translationUnitPaths,
+                 ClazyOptions = ClazyOption_None,
+                 LineFilter lineFilter = LineFilter());
     ~ClazyContext();
 
     bool usingPreCompiledHeaders() const
     {
-        return !ci.getPreprocessorOpts().ImplicitPCHInclude.empty();
+        return !pp.getPreprocessorOpts().ImplicitPCHInclude.empty();
     }
 
     bool userDisabledWError() const
@@ -105,57 +151,71 @@ public:
         return options & ClazyContext::ClazyOption_VisitImplicitCode;
     }
 
-    bool isOptionSet(const std::string &optionName) const
+    bool printsStats() const
     {
-        return clazy::contains(extraOptions, optionName);
+        return options & ClazyOption_PrintStats;
     }
 
-    bool fileMatchesLoc(const std::unique_ptr<llvm::Regex> &regex, clang::SourceLocation loc,  const clang::FileEntry **file) const
+    bool collectsStats() const
     {
-        if (!regex)
-            return false;
-
-        if (!(*file)) {
-            clang::FileID fid = sm.getDecomposedExpansionLoc(loc).first;
-            *file = sm.getFileEntryForID(fid);
-            if (!(*file)) {
-                return false;
-            }
-        }
+        return options & (ClazyOption_PrintStats | ClazyOption_CollectStats);
+    }
 
-        llvm::StringRef fileName((*file)->getName());
-        return regex->match(fileName);
+    bool runsMatchersInTraversal() const
+    {
+        return options & ClazyOption_MatchersInTraversal;
     }
 
-    bool shouldIgnoreFile(clang::SourceLocation loc) const
+    bool isUnityBuild() const
     {
-        // 1. Process the regexp that excludes files
-        const clang::FileEntry *file = nullptr;
-        if (ignoreDirsRegex) {
-            const bool matches = fileMatchesLoc(ignoreDirsRegex, loc, &file);
-            if (matches)
-                return true;
-        }
+        return options & ClazyOption_UnityBuild;
+    }
+
+    bool isOptionSet(const std::string &optionName) const
+    {
+        return clazy::contains(extraOptions, optionName);
+    }
 
-        // 2. Process the regexp that includes files. Has lower priority.
-        if (!headerFilterRegex || isMainFile(loc))
-            return false;
+    // What we need to know about the file a location expands into. Computed once per FileID, see fileInfo().
+    struct FileInfo
+    {
+        std::string name; // Empty if not a file, like <scratch space>
+        bool isMainFile = false; // Also true for the files included by the main file of a unity build
+        bool isIgnored = false; // In a system header, filtered by CLAZY_IGNORE_DIRS or CLAZY_HEADER_FILTER, or not in the line filter
+        const LineFilter::File *lineFilter = nullptr; // This file's entry in the line filter, if there's one
+
+        llvm::StringRef basename() const
+        {
+            return llvm::sys::path::filename(name);
+        }
+    };
 
-        const bool matches = fileMatchesLoc(headerFilterRegex, loc, &file);
-        if (!file)
-            return false;
+    /**
+     * Returns the information about the file loc expands into, cached by FileID.
+     * Prefer it over querying the SourceManager for each location.
+     */
+    const FileInfo &fileInfo(clang::SourceLocation loc) const;
 
-        return !matches;
+    /**
+     * Returns true if warnings shouldn't be emitted for loc, because it's in a system header,
+     * due to CLAZY_IGNORE_DIRS or CLAZY_HEADER_FILTER, or because the line filter doesn't list its file.
+     */
+    bool shouldIgnoreFile(clang::SourceLocation loc) const
+    {
+        return fileInfo(loc).isIgnored;
     }
 
     bool isMainFile(clang::SourceLocation loc) const
     {
-        if (loc.isMacroID())
-            loc = sm.getExpansionLoc(loc);
-
-        return sm.isInFileID(loc, sm.getMainFileID());
+        return fileInfo(loc).isMainFile;
     }
 
+    /**
+     * Returns false if there's a line filter and none of the lines range expands into passes it.
+     * A location converts to a range of one line. Ranges spanning several files always pass.
+     */
+    bool passesLineFilter(clang::SourceRange range) const;
+
     /**
      * We only enable it if a check needs it, for performance reasons
      */
@@ -166,8 +226,61 @@ public:
 
     bool isQt() const;
 
+    /**
+     * Returns true if QT_CORE_LIB is defined in the command line. Only needs the compiler invocation's options,
+     * so ClazyOption_OnlyQt can be honoured before parsing.
+     */
+    static bool isQtTranslationUnit(const clang::PreprocessorOptions &preprocessorOptions);
+
+    /**
+     * The warnings emitted by the whole process so far, including the ones of other translation units, but not the
+     * suppressed or baselined ones. Thread-safe.
+     */
+    static uint64_t numEmittedWarnings();
+    static void countEmittedWarning();
+
+    /**
+     * Overrides CLAZY_MAX_WARNINGS, for clazy-standalone's -max-warnings. Only affects contexts created afterwards.
+     */
+    static void setMaxWarnings(unsigned int max);
+
+    // The analysis stops once this many warnings were emitted, see maxWarnings
+    bool reachedMaxWarnings() const
+    {
+        return maxWarnings > 0 && numEmittedWarnings() >= maxWarnings;
+    }
+
+    /**
+     * Returns the PPCallbacks which checks and helpers subscribe to, instead of each adding its own to the Preprocessor.
+     * Created and added to the Preprocessor on first use, which owns it.
+     */
+    PreprocessorDispatcher *preprocessorDispatcher() const;
+
+    /**
+     * Returns the Qt classes and methods resolved for this translation unit. Created on first use.
+     */
+    const QtRegistry &qtRegistry() const;
+
+    /**
+     * Returns the index of the body of the function being visited, if stmt is inside it, otherwise nullptr.
+     * It's built on first use and shared by all checks until we move to another function.
+     */
+    const StmtIndex *functionStmtIndex(clang::Stmt *stmt) const;
+
+    /**
+     * Returns the function being visited, if loc is inside it, otherwise nullptr.
+     */
+    const clang::FunctionDecl *enclosingFunction(clang::SourceLocation loc) const;
+
+    /**
+     * Returns true and sets count to the execution count CLAZY_HOTNESS_PROFILE has for the function being visited,
+     * if loc is inside it. Returns false without a profile, or if the function can't be looked up, as for templates.
+     */
+    bool enclosingFunctionHotness(clang::SourceLocation loc, uint64_t &count) const;
+
     // TODO: More things will follow
-    const clang::CompilerInstance &ci;
+    mutable llvm::BumpPtrAllocator arena; // Per translation unit state, see clazy::ArenaAllocator
+    clang::Preprocessor &pp;
     clang::ASTContext &astContext;
     clang::SourceManager &sm;
     AccessSpecifierManager *accessSpecifierManager = nullptr;
@@ -176,15 +289,47 @@ public:
     const bool m_noWerror;
     bool m_visitsAllTypeDefs = false;
     clang::ParentMap *parentMap = nullptr;
+    TraversalStack traversalStack; // Ancestors of the statement being visited, see clazy::parent(const ClazyContext *, ...)
+    StmtFacts stmtFacts { this }; // Of the statement being visited, reset before the checks visit it
     const ClazyOptions options;
     const std::vector<std::string> extraOptions;
+    const unsigned int checkTimeBudget; // Milliseconds each check may spend visiting a translation unit, 0 unless CLAZY_CHECK_TIME_BUDGET is set
+    const unsigned int timeBudget; // Milliseconds the AST traversal of a translation unit may take, 0 unless CLAZY_TIME_BUDGET is set
+    const unsigned int maxWarnings; // Per process, 0 unless CLAZY_MAX_WARNINGS or setMaxWarnings() is set
     FixItExporter *exporter = nullptr;
+    HeaderCache *headerCache = nullptr; // Only set if CLAZY_HEADER_CACHE_DIR or -in-memory-header-cache is
+    // The location of the node the checks are visiting, unless it's part of a template instantiation. Invalid outside
+    // of VisitDecl() and VisitStmt(). The header cache only stores the warnings in the same file, see CheckBase::isCacheableWarning().
+    clang::SourceLocation cacheableNodeLoc;
+    JsonlExporter *jsonlExporter = nullptr; // Only set if CLAZY_EXPORT_JSONL is
+    SarifExporter *sarifExporter = nullptr; // Only set if CLAZY_EXPORT_SARIF is
+    const Baseline *baseline = nullptr; // Only set if CLAZY_BASELINE is, shared by the whole process
+    BaselineExporter *baselineExporter = nullptr; // Only set if CLAZY_EXPORT_BASELINE is
+    const FunctionHotness *hotness = nullptr; // Only set if CLAZY_HOTNESS_PROFILE is, shared by the whole process
+    WarningDeduplicator *deduplicator = nullptr; // Only set with ClazyOption_DeduplicateWarnings, on the main thread
+    WarningSink *warningSink = nullptr; // Not owned, gets the warnings instead of the DiagnosticsEngine if set
+    PerfCounters *perfCounters = nullptr; // Only set with ClazyOption_PerfCounters, measures the main thread
+    const LineFilter lineFilter; // Empty unless -line-filter or CLAZY_LINE_FILTER is set
     clang::CXXMethodDecl *lastMethodDecl = nullptr;
     clang::FunctionDecl *lastFunctionDecl = nullptr;
     clang::Decl *lastDecl = nullptr;
     std::unique_ptr<llvm::Regex> headerFilterRegex;
     std::unique_ptr<llvm::Regex> ignoreDirsRegex;
     const std::vector<std::string> m_translationUnitPaths;
+    mutable std::unordered_map<void *, clazy::QualTypeClassification> qualTypeClassifications; // Cache for clazy::classifyQualType(), by canonical type
+    mutable std::unordered_map<const clang::StringLiteral *, unsigned int> literalClassifications; // Cache for Utils::classifyLiteral()
+private:
+    void computeFileInfo(clang::FileID fid, FileInfo &info) const;
+    mutable std::unordered_map<unsigned, FileInfo> m_fileInfos; // By FileID hash value
+    mutable clang::FileID m_lastFileID;
+    mutable const FileInfo *m_lastFileInfo = nullptr;
+    mutable PreprocessorDispatcher *m_preprocessorDispatcher = nullptr;
+    mutable QtRegistry *m_qtRegistry = nullptr;
+    mutable StmtIndex *m_stmtIndex = nullptr;
+    mutable clang::MangleContext *m_mangleContext = nullptr; // For enclosingFunctionHotness(), created on first use
+    mutable const clang::FunctionDecl *m_hotnessFunction = nullptr; // The last one enclosingFunctionHotness() looked up
+    mutable bool m_hotnessFunctionFound = false;
+    mutable uint64_t m_hotnessFunctionCount = 0;
 };
 
 #endif
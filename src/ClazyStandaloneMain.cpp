@@ -21,19 +21,76 @@
 
 // clazy:excludeall=non-pod-global-static
 
+#include "AsyncDiagnosticPrinter.h"
+#include "CheckHistory.h"
 #include "Clazy.h"
 #include "ClazyContext.h"
+#include "FixItExporter.h"
+#include "FunctionHotness.h"
+#include "GlobalChecks.h"
+#include "HeaderCache.h"
+#include "HeaderTranslationUnits.h"
+#include "LineFilter.h"
+#include "MemoryBudget.h"
+#include "MiniAstIndex.h"
+#include "PrefetchFileSystem.h"
+#include "ResultCache.h"
+#include "RewrittenCompilations.h"
+#include "RunJournal.h"
+#include "RunStats.h"
+#include "StandaloneServer.h"
+#include "StandaloneWatch.h"
+#include "StandaloneWorker.h"
+#include "WasteReport.h"
+#include "TranslationUnitSample.h"
+#include "UnityTranslationUnits.h"
 
 #include "checks.json.h"
 
+#include <clang/Basic/Diagnostic.h>
+#include <clang/Basic/DiagnosticOptions.h>
+#include <clang/Basic/FileManager.h>
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Frontend/CompilerInvocation.h>
+#include <clang/Frontend/TextDiagnosticPrinter.h>
 #include <clang/Tooling/CommonOptionsParser.h>
+#include <clang/Tooling/CompilationDatabase.h>
+#include <clang/Tooling/Core/Diagnostic.h>
+#include <clang/Tooling/DiagnosticsYaml.h>
 #include <clang/Tooling/Tooling.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Support/Chrono.h>
 #include <llvm/Support/CommandLine.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Format.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/YAMLTraits.h>
+#include <llvm/Support/raw_ostream.h>
 #include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/SmallVector.h>
 #include <llvm/ADT/StringRef.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <tuple>
 #include <iostream>
+#include <iterator>
 #include <string>
+#include <thread>
+#include <vector>
+
+#if LLVM_VERSION_MAJOR >= 12
+# include <clang/Frontend/PrecompiledPreamble.h>
+# define CLAZY_HAS_PRECOMPILED_PREAMBLE
+#endif
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <unordered_map>
 
 namespace clang {
 class FrontendAction;
@@ -47,13 +104,16 @@ static llvm::cl::OptionCategory s_clazyCategory("clazy options");
 static cl::opt<std::string> s_checks("checks", cl::desc("Comma-separated list of clazy checks. Default is level1"),
                                      cl::init(""), cl::cat(s_clazyCategory));
 
-static cl::opt<std::string> s_exportFixes("export-fixes", cl::desc("YAML file to store suggested fixes in. The stored fixes can be applied to the input source code with clang-apply-replacements."),
+static cl::opt<std::string> s_exportFixes("export-fixes", cl::desc("YAML file to store suggested fixes in. The stored fixes can be applied to the input source code with clang-apply-replacements. If it's an existing directory, a YAML file per translation unit is written there as soon as it's done, using less memory."),
                                           cl::init(""), cl::cat(s_clazyCategory));
 
+static cl::opt<bool> s_applyFixes("apply-fixes", cl::desc("Apply the suggested fixes to the source files at the end of the run, without going through YAML files and clang-apply-replacements. Fixes conflicting with others are skipped."),
+                                  cl::init(false), cl::cat(s_clazyCategory));
+
 static cl::opt<bool> s_qt4Compat("qt4-compat", cl::desc("Turns off checks not compatible with Qt 4"),
                                  cl::init(false), cl::cat(s_clazyCategory));
 
-static cl::opt<bool> s_onlyQt("only-qt", cl::desc("Won't emit warnings for non-Qt files, or in other words, if -DQT_CORE_LIB is missing."),
+static cl::opt<bool> s_onlyQt("only-qt", cl::desc("Won't emit warnings for non-Qt files, or in other words, if -DQT_CORE_LIB is missing. Such files are not even parsed."),
                               cl::init(false), cl::cat(s_clazyCategory));
 
 static cl::opt<bool> s_qtDeveloper("qt-developer", cl::desc("For running clazy on Qt itself, optional, but honours specific guidelines"),
@@ -65,6 +125,39 @@ static cl::opt<bool> s_visitImplicitCode("visit-implicit-code", cl::desc("For vi
 static cl::opt<bool> s_ignoreIncludedFiles("ignore-included-files", cl::desc("Only emit warnings for the current file being compiled and ignore any includes. Useful for performance reasons."),
                                            cl::init(false), cl::cat(s_clazyCategory));
 
+static cl::opt<bool> s_analyzeHeaders("analyze-headers", cl::desc(R"(Analyze each project header once, in a translation unit of its own which only includes it,
+instead of in every translation unit including it. Source files then only get warnings for themselves.
+Headers are searched below the directory containing all source files and filtered by -header-filter and -ignore-dirs.)"),
+                                      cl::init(false), cl::cat(s_clazyCategory));
+
+static cl::opt<unsigned int> s_unityBatchSize("unity-batch-size", cl::desc(R"(Analyze up to this many source files with the same compile command in one translation unit
+including all of them, like a unity build does, so the headers they share are parsed once. Uses more memory.
+Files must compile together, for example without clashing static functions. 0, the default, analyzes each file alone.)"),
+                                               cl::init(0), cl::cat(s_clazyCategory));
+
+static cl::opt<bool> s_printStats("print-stats", cl::desc("Print how much time each check took, at the end of each translation unit."),
+                                   cl::init(false), cl::cat(s_clazyCategory));
+
+static cl::opt<bool> s_perfCounters("perf-counters", cl::desc("Like -print-stats, but also print the instructions, cycles, last level cache misses and branch misses of each check. Linux only."),
+                                    cl::init(false), cl::cat(s_clazyCategory));
+
+static cl::opt<std::string> s_statsJson("stats-json", cl::desc(R"(Write statistics aggregated over all the translation units of the run to this JSON file: the time
+and warnings of each check, with their p50, p95 and max per translation unit, the header and -cache-dir hit rates, the
+peak memory and the slowest translation units, with the check which took the longest in each.)"),
+                                        cl::init(""), cl::cat(s_clazyCategory));
+
+static cl::opt<unsigned int> s_statsSlowest("stats-slowest", cl::desc("How many of the slowest translation units -stats-json lists. Default 10."),
+                                            cl::init(10), cl::cat(s_clazyCategory));
+
+static cl::opt<bool> s_asyncDiagnostics("async-diagnostics", cl::desc("Render the diagnostics on a separate thread, so it overlaps with the analysis. Include stacks and macro expansion notes aren't printed."),
+                                        cl::init(false), cl::cat(s_clazyCategory));
+
+static cl::opt<bool> s_matchersInTraversal("matchers-in-traversal", cl::desc("Run the AST matchers of matcher based checks on the nodes clazy visits, instead of doing a second AST traversal. Template instantiations aren't matched."),
+                                           cl::init(false), cl::cat(s_clazyCategory));
+
+static cl::opt<bool> s_deduplicateWarnings("deduplicate-warnings", cl::desc("Of checks warning about the same code, like qlatin1string-non-ascii and qstring-allocations, only keep the more specific warning on a line."),
+                                           cl::init(false), cl::cat(s_clazyCategory));
+
 static cl::opt<std::string> s_headerFilter("header-filter", cl::desc(R"(Regular expression matching the names of the
 headers to output diagnostics from. Diagnostics
 from the main file of each translation unit are
@@ -75,6 +168,145 @@ static cl::opt<std::string> s_ignoreDirs("ignore-dirs", cl::desc(R"(Regular expr
 directories for which diagnostics should never be emitted. Useful for ignoring 3rdparty code.)"),
                                          cl::init(""), cl::cat(s_clazyCategory));
 
+static cl::opt<std::string> s_lineFilter("line-filter", cl::desc(R"(Only emit warnings for these lines, using clang-tidy's JSON format:
+  [{"name":"file1.cpp","lines":[[1,3],[5,7]]},{"name":"file2.h"}]
+Files not listed get no warnings, and function bodies outside of the lines aren't analyzed.
+Defaults to the CLAZY_LINE_FILTER env variable.)"),
+                                         cl::init(""), cl::cat(s_clazyCategory));
+
+static cl::opt<unsigned int> s_jobs("j", cl::desc("Number of translation units to analyze in parallel. Diagnostics are still printed in the order the files were passed."),
+                                     cl::init(1), cl::cat(s_clazyCategory));
+
+static cl::alias s_jobsAlias("jobs", cl::desc("Alias for -j"), cl::aliasopt(s_jobs), cl::cat(s_clazyCategory));
+
+static cl::opt<std::string> s_server("server", cl::desc(R"(Keep running and analyze the files requested via the specified Unix socket.
+Each request is an optional "checks=<checks>" line followed by one file per line
+and an empty line. The diagnostics are sent back followed by "exit: <code>".)"),
+                                     cl::init(""), cl::cat(s_clazyCategory));
+
+static cl::opt<std::string> s_worker("worker", cl::desc(R"(<host>:<port>. Keep running and analyze the translation units sent over TCP by a coordinator, for distributing
+a run across a build farm. Requires -worker-secret-file. Each connection starts with a "secret=<secret>" line.
+Each request has "key=value" lines, "directory=", "main=" and one "arg=" per compiler flag, of which only include paths,
+macros, the language standard and warning flags are accepted, plus "file=<md5> <path>" for each input file. Files this
+worker doesn't have yet must be sent with "blob=<md5> <size>" followed by the contents. The request ends with an empty line.
+The reply has a JSON line per diagnostic followed by "exit: <code>", or "missing=<md5>" lines and "exit: 2" if contents
+are missing. Anyone able to connect can read the files the worker can read, through the include paths and the diagnostics,
+and the connection isn't encrypted. See README.md.)"),
+                                     cl::init(""), cl::cat(s_clazyCategory));
+
+static cl::opt<std::string> s_workerSecretFile("worker-secret-file", cl::desc(R"(File with the secret the coordinators of -worker must send. Only its first line is used.)"),
+                                               cl::init(""), cl::cat(s_clazyCategory));
+
+static cl::opt<bool> s_workerAllowRemote("worker-allow-remote", cl::desc(R"(Let -worker listen on addresses other than the loopback ones. Only do this on a trusted network.)"),
+                                         cl::init(false), cl::cat(s_clazyCategory));
+
+static cl::opt<unsigned int> s_workerReadTimeout("worker-read-timeout", cl::desc(R"(Seconds after which -worker closes a connection not sending anything, as connections are handled one
+at a time. 0 never closes them. Default 30.)"),
+                                                  cl::init(30), cl::cat(s_clazyCategory));
+
+static cl::opt<bool> s_reusePreambles("reuse-preambles", cl::desc(R"(With -server or -watch, keep a precompiled preamble of each file's includes and reuse it while
+they don't change, so only the rest of the file is parsed again. Preprocessor based checks don't see the macros of the included headers.)"),
+                                      cl::init(false), cl::cat(s_clazyCategory));
+
+static cl::opt<bool> s_watch("watch", cl::desc(R"(Keep running after analyzing the files, and re-analyze the ones depending on each file modified,
+the most recently edited first. Combine with -reuse-preambles for faster re-analyses.)"),
+                           cl::init(false), cl::cat(s_clazyCategory));
+
+static cl::opt<std::string> s_cacheDir("cache-dir", cl::desc(R"(Directory where to store the results of each translation unit. Translation units whose
+compile command and input files didn't change since the last successful run print the stored results without being parsed again.)"),
+                                       cl::init(""), cl::cat(s_clazyCategory));
+
+static cl::opt<std::string> s_stateDir("state-dir", cl::desc(R"(Directory where to journal the diagnostics of each translation unit as soon as it's done. A run which was
+interrupted, then started again with the same arguments, only analyzes the translation units it didn't finish. The journal
+is removed once the run completes.)"),
+                                       cl::init(""), cl::cat(s_clazyCategory));
+
+static cl::opt<unsigned int> s_prefetchFiles("prefetch-files", cl::desc(R"(Keep the status and the contents of the files read in memory for the whole run, shared by the -j workers,
+so headers are only looked up and read once, and read the files the -cache-dir entries depend on ahead with this
+many threads. For sources on network file systems. Files must not change during the run. Needs clang >= 12.)"),
+                                           cl::init(0), cl::cat(s_clazyCategory));
+
+static cl::opt<bool> s_inMemoryHeaderCache("in-memory-header-cache", cl::desc(R"(Like CLAZY_HEADER_CACHE_DIR, but in memory, for the run: once a translation unit analyzed a project header,
+the next ones including it print its warnings instead of emitting them again. Only the cache_safe checks skip the header.
+Also speeds up CLAZY_HEADER_CACHE_DIR.)"),
+                                           cl::init(false), cl::cat(s_clazyCategory));
+
+static cl::list<std::string> s_removeArgPrefix("remove-arg-prefix", cl::desc(R"(Removes the arguments starting with this prefix from the compile commands, can be repeated.
+If an argument is the whole prefix, the next one is removed too, unless it's an option, as in "-include foo.h".
+Use -extra-arg to add arguments.)"),
+                                               cl::cat(s_clazyCategory));
+
+static cl::opt<bool> s_stripPch("strip-pch", cl::desc(R"(Removes the precompiled header options from the compile commands, like -include-pch,
+-include of a PCH and clang-cl's /Yu, for PCHs built by another compiler.)"),
+                                cl::init(false), cl::cat(s_clazyCategory));
+
+static cl::opt<std::string> s_shard("shard", cl::desc(R"(K/N: Only analyze the K-th of N shards of the files, for distributing a run across machines.
+If no files are given, all files in the compilation database are sharded. Shards are balanced by -shard-costs, or by file size.)"),
+                                    cl::init(""), cl::cat(s_clazyCategory));
+
+static cl::opt<double> s_sample("sample", cl::desc(R"(<P>: Only analyze a deterministic pseudo-random fraction P of the files of each directory, 0 < P <= 1,
+and print the estimated number of warnings per check for all files. If no files are given, all files in the compilation database are sampled.)"),
+                               cl::init(0), cl::cat(s_clazyCategory));
+
+static cl::opt<std::string> s_costs("costs", cl::desc(R"(File with one "<cost> <filename>" line per file, for example the seconds each file took in a previous run.
+Used to balance -shard and, with -j, to start the most expensive files first. Without it, file sizes are used.)"),
+                                    cl::init(""), cl::cat(s_clazyCategory));
+
+static cl::alias s_shardCostsAlias("shard-costs", cl::desc("Alias for -costs"), cl::aliasopt(s_costs), cl::cat(s_clazyCategory));
+
+static cl::opt<std::string> s_recordCosts("record-costs", cl::desc(R"(Updates this file with the seconds each file took to analyze, in the format expected by -costs.
+Files not analyzed in this run keep their previous cost.)"),
+                                          cl::init(""), cl::cat(s_clazyCategory));
+
+static cl::opt<unsigned int> s_maxMemory("max-memory", cl::desc(R"(With -j, only start a translation unit when the memory it's expected to need fits in this many MB, next to the
+ones running. One always starts when none runs. Expectations come from -memory-costs, else from the translation units done so far.)"),
+                                         cl::init(0), cl::cat(s_clazyCategory));
+
+static cl::opt<std::string> s_memoryCosts("memory-costs", cl::desc(R"(File with one "<MB> <filename>" line per file, the memory it took to analyze, for -max-memory.
+Updated at the end of the run, files not analyzed in this run keep their previous value.)"),
+                                          cl::init(""), cl::cat(s_clazyCategory));
+
+static cl::opt<unsigned int> s_maxWarnings("max-warnings", cl::desc(R"(Stop the analysis as soon as this many warnings were emitted, not counting suppressed or baselined ones,
+and exit with 1. For pre-merge gating, where any warning fails the run. Defaults to the CLAZY_MAX_WARNINGS env variable.)"),
+                                           cl::init(0), cl::cat(s_clazyCategory));
+
+static cl::opt<std::string> s_hotnessProfile("hotness-profile", cl::desc(R"(Execution counts per mangled function name, from "llvm-profdata show -all-functions", a text sample profile
+or "<name> <count>" lines. The warnings of performance checks then say how often their function ran.
+Defaults to the CLAZY_HOTNESS_PROFILE env variable.)"),
+                                              cl::init(""), cl::cat(s_clazyCategory));
+
+static cl::opt<unsigned long long> s_minHotness("min-hotness", cl::desc(R"(With -hotness-profile, drop the warnings of performance checks in functions which ran fewer times.
+Defaults to the CLAZY_MIN_HOTNESS env variable.)"),
+                                                cl::init(0), cl::cat(s_clazyCategory));
+
+static cl::opt<std::string> s_wasteReport("waste-report", cl::desc(R"(Write a JSON file ranking the files and functions of the run by the estimated waste of the warnings of performance checks:
+their allocations and bytes copied, multiplied by 10 for each loop they're in, and by the execution count of their function with
+-hotness-profile. Translation units resumed by -state-dir aren't counted.)"),
+                                          cl::init(""), cl::cat(s_clazyCategory));
+
+static cl::opt<unsigned int> s_wasteReportTop("waste-report-top", cl::desc("How many of the most wasteful files and functions -waste-report lists. Default 50."),
+                                              cl::init(50), cl::cat(s_clazyCategory));
+
+static cl::opt<std::string> s_checkHistory("check-history", cl::desc(R"(Reads and updates this file with the checks which warned in each directory in the previous runs,
+and skips the ones which didn't in the last -check-history-runs runs, while the directory's source files and compile
+commands stay the same. Warnings from headers outside of the directory can be missed until the next full run.)"),
+                                          cl::init(""), cl::cat(s_clazyCategory));
+
+static cl::opt<unsigned int> s_checkHistoryRuns("check-history-runs", cl::desc("After how many runs without warnings in a directory -check-history skips a check there. Default 5."),
+                                                cl::init(5), cl::cat(s_clazyCategory));
+
+static cl::opt<unsigned int> s_checkHistoryRerun("check-history-rerun", cl::desc("With -check-history, every N-th run analyzes with all checks. 0 never does. Default 10."),
+                                                 cl::init(10), cl::cat(s_clazyCategory));
+
+static cl::opt<std::string> s_mergeFixes("merge-fixes", cl::desc("Merges the -export-fixes YAML files passed instead of source files, for example one per shard, into this file and exits."),
+                                         cl::init(""), cl::cat(s_clazyCategory));
+
+static cl::opt<std::string> s_mergeIndex("merge-index", cl::desc("Merges the indexes written by the clazyMiniAstDumper plugin, passed instead of source files, into this whole-program index and exits."),
+                                         cl::init(""), cl::cat(s_clazyCategory));
+
+static cl::opt<std::string> s_globalChecks("global-checks", cl::desc("Runs the checks which can look at the whole program over this index, made by -merge-index, and exits."),
+                                          cl::init(""), cl::cat(s_clazyCategory));
+
 static cl::opt<bool> s_supportedChecks("supported-checks-json", cl::desc("Dump meta information about supported checks in JSON format."),
                                        cl::init(false), cl::cat(s_clazyCategory));
 
@@ -83,23 +315,76 @@ static cl::opt<bool> s_listEnabledChecks("list-checks", cl::desc("List all enabl
 
 static cl::extrahelp s_commonHelp(CommonOptionsParser::HelpMessage);
 
+static LineFilter s_parsedLineFilter; // From -line-filter or CLAZY_LINE_FILTER, parsed once by main()
+static unsigned int s_parsedMaxWarnings = 0; // From -max-warnings or CLAZY_MAX_WARNINGS, parsed once by main()
+
+#ifdef CLAZY_HAS_PREFETCH_FILE_SYSTEM
+static llvm::IntrusiveRefCntPtr<PrefetchFileSystem> s_prefetchFileSystem; // With -prefetch-files, created by main()
+
+// The file system the translation units are read from
+static llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> baseFileSystem()
+{
+    if (s_prefetchFileSystem)
+        return s_prefetchFileSystem;
+    return llvm::vfs::getRealFileSystem();
+}
+#endif
+
+static bool reachedMaxWarnings()
+{
+    return s_parsedMaxWarnings > 0 && ClazyContext::numEmittedWarnings() >= s_parsedMaxWarnings;
+}
+
 class ClazyToolActionFactory
     : public clang::tooling::FrontendActionFactory
 {
 public:
-    ClazyToolActionFactory(std::vector<std::string> paths)
+    ClazyToolActionFactory(std::vector<std::string> paths, std::string checks = s_checks.getValue(),
+                           const CompilationDatabase *preambleCompilations = nullptr)
         : FrontendActionFactory()
         , m_paths(std::move(paths))
+        , m_checks(std::move(checks))
+        , m_preambleCompilations(preambleCompilations)
+        , m_lineFilter(s_parsedLineFilter)
+        , m_ignoresIncludedFiles(s_ignoreIncludedFiles.getValue())
     {
     }
 
+    void setLineFilter(const LineFilter &lineFilter)
+    {
+        m_lineFilter = lineFilter;
+    }
+
+    void setIgnoresIncludedFiles(bool ignores)
+    {
+        m_ignoresIncludedFiles = ignores;
+    }
+
+    void setUnityBuild(bool unityBuild)
+    {
+        m_unityBuild = unityBuild;
+    }
+
+    bool runInvocation(std::shared_ptr<CompilerInvocation> invocation, FileManager *files,
+                       std::shared_ptr<PCHContainerOperations> pchContainerOps, DiagnosticConsumer *diagConsumer) override
+    {
+#ifdef CLAZY_HAS_PRECOMPILED_PREAMBLE
+        if (m_preambleCompilations && invocation->getFrontendOpts().Inputs.size() == 1)
+            addPreamble(*invocation, *files, pchContainerOps);
+#endif
+        return FrontendActionFactory::runInvocation(std::move(invocation), files, std::move(pchContainerOps), diagConsumer);
+    }
+
     FrontendAction *create() override
     {
         ClazyContext::ClazyOptions options = ClazyContext::ClazyOption_None;
 
-        if (!s_exportFixes.getValue().empty())
+        if (!s_exportFixes.getValue().empty() || s_applyFixes.getValue())
             options |= ClazyContext::ClazyOption_ExportFixes;
 
+        if (s_applyFixes.getValue())
+            options |= ClazyContext::ClazyOption_ApplyFixes;
+
         if (s_qt4Compat.getValue())
             options |= ClazyContext::ClazyOption_Qt4Compat;
 
@@ -112,21 +397,513 @@ public:
         if (s_visitImplicitCode.getValue())
             options |= ClazyContext::ClazyOption_VisitImplicitCode;
 
-        if (s_ignoreIncludedFiles.getValue())
+        if (m_ignoresIncludedFiles)
             options |= ClazyContext::ClazyOption_IgnoreIncludedFiles;
 
+        if (s_printStats.getValue())
+            options |= ClazyContext::ClazyOption_PrintStats;
+
+        if (s_perfCounters.getValue())
+            options |= ClazyContext::ClazyOption_PrintStats | ClazyContext::ClazyOption_PerfCounters;
+
+        if (!s_statsJson.getValue().empty() || !s_checkHistory.getValue().empty() || s_maxMemory.getValue() > 0
+            || !s_memoryCosts.getValue().empty())
+            options |= ClazyContext::ClazyOption_CollectStats;
+
+        if (m_unityBuild)
+            options |= ClazyContext::ClazyOption_UnityBuild;
+
+        if (s_matchersInTraversal.getValue())
+            options |= ClazyContext::ClazyOption_MatchersInTraversal;
+
+        if (s_deduplicateWarnings.getValue())
+            options |= ClazyContext::ClazyOption_DeduplicateWarnings;
+
         // TODO: We need to agregate the fixes with previous run
-        return new ClazyStandaloneASTAction(s_checks.getValue(), s_headerFilter.getValue(),
+        return new ClazyStandaloneASTAction(m_checks, s_headerFilter.getValue(),
                                             s_ignoreDirs.getValue(), s_exportFixes.getValue(),
-                                            m_paths, options);
+                                            m_paths, options, m_lineFilter);
     }
     std::vector<std::string> m_paths;
+    std::string m_checks;
+
+private:
+#ifdef CLAZY_HAS_PRECOMPILED_PREAMBLE
+    void addPreamble(CompilerInvocation &invocation, FileManager &files, std::shared_ptr<PCHContainerOperations> pchContainerOps) const;
+#endif
+    const CompilationDatabase *const m_preambleCompilations; // Non-null if preambles should be reused
+    LineFilter m_lineFilter;
+    bool m_ignoresIncludedFiles;
+    bool m_unityBuild = false;
 };
 
+#ifdef CLAZY_HAS_PRECOMPILED_PREAMBLE
+// Keyed by file name and compile command. Only used by -server and -watch, which analyze one file at a time.
+static std::unordered_map<std::string, std::unique_ptr<PrecompiledPreamble>> s_preambles;
+
+void ClazyToolActionFactory::addPreamble(CompilerInvocation &invocation, FileManager &files,
+                                         std::shared_ptr<PCHContainerOperations> pchContainerOps) const
+{
+    const std::string mainFile = invocation.getFrontendOpts().Inputs[0].getFile().str();
+    auto buffer = files.getBufferForFile(mainFile);
+    if (!buffer)
+        return;
+
+    std::string key = mainFile;
+    for (const CompileCommand &command : m_preambleCompilations->getCompileCommands(mainFile)) {
+        for (const std::string &arg : command.CommandLine) {
+            key += '\n';
+            key += arg;
+        }
+    }
+
+    // CanReuse() checks that the includes at the top of the file, and the files they include, didn't change
+    const PreambleBounds bounds = ComputePreambleBounds(*invocation.getLangOpts(), (*buffer)->getMemBufferRef(), /*MaxLines=*/ 0);
+    IntrusiveRefCntPtr<llvm::vfs::FileSystem> vfs(&files.getVirtualFileSystem());
+    std::unique_ptr<PrecompiledPreamble> &preamble = s_preambles[key];
+    if (!preamble || !preamble->CanReuse(invocation, (*buffer)->getMemBufferRef(), bounds, *vfs)) {
+        preamble.reset();
+
+        // Errors in the headers will be reported when parsing the whole file instead
+        IntrusiveRefCntPtr<DiagnosticsEngine> diagnostics = CompilerInstance::createDiagnostics(&invocation.getDiagnosticOpts(), new IgnoringDiagConsumer());
+        PreambleCallbacks callbacks;
+        auto result = PrecompiledPreamble::Build(invocation, buffer->get(), bounds, *diagnostics, vfs, pchContainerOps,
+                                                 /*StoreInMemory=*/ false, callbacks);
+        if (!result)
+            return;
+
+        preamble.reset(new PrecompiledPreamble(std::move(*result)));
+    }
+
+    preamble->AddImplicitPreamble(invocation, vfs, buffer->get());
+}
+#endif
+
+// Reads a file with one "<cost> <filename>" line per file
+static bool readCosts(const std::string &costsFilename, std::unordered_map<std::string, double> &costs)
+{
+    auto buffer = llvm::MemoryBuffer::getFile(costsFilename);
+    if (!buffer)
+        return false;
+
+    llvm::SmallVector<llvm::StringRef, 256> lines;
+    (*buffer)->getBuffer().split(lines, '\n', -1, /*KeepEmpty=*/ false);
+    for (llvm::StringRef line : lines) {
+        llvm::StringRef costStr, filename;
+        std::tie(costStr, filename) = line.trim().split(' ');
+        double cost = 0;
+        if (!costStr.getAsDouble(cost))
+            costs[filename.trim().str()] = cost;
+    }
+
+    return true;
+}
+
+// Returns the cost of each file, from the costs file if there's one, otherwise its size
+static std::vector<double> estimateCosts(const std::vector<std::string> &files, const std::string &costsFilename)
+{
+    std::unordered_map<std::string, double> costs;
+    if (!costsFilename.empty() && !readCosts(costsFilename, costs))
+        llvm::errs() << "clazy-standalone: Failed to read " << costsFilename << "\n";
+
+    // Files missing from the costs file, like new ones, get the average cost
+    double averageCost = 0;
+    for (const auto &it : costs)
+        averageCost += it.second / costs.size();
+
+    std::vector<double> result;
+    result.reserve(files.size());
+    for (const std::string &file : files) {
+        double cost = averageCost;
+        auto it = costs.find(file);
+        uint64_t size = 0;
+        if (it != costs.end())
+            cost = it->second;
+        else if (costs.empty() && !llvm::sys::fs::file_size(file, size))
+            cost = size;
+        result.push_back(cost);
+    }
+
+    return result;
+}
+
+// Returns the indexes of files sorted by decreasing cost, ties are broken by name so the order is deterministic
+static std::vector<size_t> longestFirst(const std::vector<std::string> &files, const std::vector<double> &costs)
+{
+    std::vector<size_t> order(files.size());
+    for (size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+
+    std::sort(order.begin(), order.end(), [&files, &costs](size_t a, size_t b) {
+        return costs[a] != costs[b] ? costs[a] > costs[b] : files[a] < files[b];
+    });
+
+    return order;
+}
+
+// Merges the seconds each file took into the costs file, keeping the costs of the files not analyzed this time
+static void recordCosts(const std::string &costsFilename, const std::vector<std::string> &files, const std::vector<double> &seconds)
+{
+    std::unordered_map<std::string, double> costs;
+    readCosts(costsFilename, costs); // Fine if it doesn't exist yet
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (seconds[i] >= 0)
+            costs[files[i]] = seconds[i];
+    }
+
+    std::vector<std::pair<std::string, double>> sortedCosts(costs.cbegin(), costs.cend());
+    std::sort(sortedCosts.begin(), sortedCosts.end());
+
+    // Several shards might be recording into the same file, don't let them read a partial one
+    int fd = -1;
+    llvm::SmallString<128> tmpFilename;
+    if (llvm::sys::fs::createUniqueFile(costsFilename + "-%%%%%%", fd, tmpFilename)) {
+        llvm::errs() << "clazy-standalone: Failed to write " << costsFilename << "\n";
+        return;
+    }
+
+    {
+        llvm::raw_fd_ostream os(fd, /*shouldClose=*/ true);
+        for (const auto &it : sortedCosts)
+            os << llvm::format("%.3f", it.second) << ' ' << it.first << '\n';
+    }
+
+    if (llvm::sys::fs::rename(tmpFilename, costsFilename))
+        llvm::sys::fs::remove(tmpFilename);
+}
+
+// The memory each file took in a previous run, 0 for the ones missing from the -memory-costs file
+static std::vector<uint64_t> estimateMemory(const std::vector<std::string> &files, const std::string &memoryCostsFilename)
+{
+    std::unordered_map<std::string, double> megabytes;
+    if (!memoryCostsFilename.empty())
+        readCosts(memoryCostsFilename, megabytes); // Fine if it doesn't exist yet
+
+    std::vector<uint64_t> result;
+    result.reserve(files.size());
+    for (const std::string &file : files) {
+        auto it = megabytes.find(file);
+        result.push_back(it == megabytes.end() ? 0 : static_cast<uint64_t>(it->second * 1024 * 1024));
+    }
+
+    return result;
+}
+
+// headerUnits is non-null with -analyze-headers and unityUnits with -unity-batch-size, compilations then being it.
+// sample is non-null with -sample, sourcePaths then being its files. runStats is non-null with -stats-json
+// and history with -check-history. journal is non-null with -state-dir.
+static int runInParallel(const CompilationDatabase &compilations, const std::vector<std::string> &sourcePaths,
+                         unsigned int numJobs, const ResultCache *cache, const HeaderTranslationUnits *headerUnits = nullptr,
+                         const UnityTranslationUnits *unityUnits = nullptr, const TranslationUnitSample *sample = nullptr,
+                         RunStats *runStats = nullptr, CheckHistory *history = nullptr, RunJournal *journal = nullptr)
+{
+    const size_t numSources = sourcePaths.size();
+
+    // Each worker runs one translation unit at a time, with its own ClangTool and CompilerInstance.
+    // Diagnostics are buffered per translation unit and printed at the end, so output doesn't interleave.
+    std::vector<std::string> outputs(numSources);
+    std::vector<int> results(numSources, 0);
+    std::vector<double> seconds(numSources, -1); // -1 if not analyzed, like cached ones
+    std::vector<double> megabytes(numSources, -1);
+
+    std::unique_ptr<MemoryBudget> memoryBudget;
+    std::vector<uint64_t> memoryEstimates;
+    if (s_maxMemory.getValue() > 0) {
+        memoryBudget.reset(new MemoryBudget(uint64_t(s_maxMemory.getValue()) * 1024 * 1024, numJobs));
+        memoryEstimates = estimateMemory(sourcePaths, s_memoryCosts.getValue());
+    }
+
+    // Idle workers take the next most expensive file from the shared queue, so a big file
+    // doesn't start last and keep a single core busy while the others are done.
+    const std::vector<size_t> order = longestFirst(sourcePaths, estimateCosts(sourcePaths, s_costs.getValue()));
+    std::atomic<size_t> nextSource(0);
+
+    auto worker = [&] {
+        for (size_t next = nextSource++; next < numSources && !reachedMaxWarnings(); next = nextSource++) {
+            const size_t i = order[next];
+            if (journal && journal->lookup(i, outputs[i], results[i]))
+                continue;
+
+            std::string cacheKey;
+            if (cache) {
+                cacheKey = cache->keyFor(sourcePaths[i], compilations.getCompileCommands(sourcePaths[i]));
+                const bool cached = cache->lookup(cacheKey, outputs[i], results[i]);
+                if (runStats && cached)
+                    runStats->addCachedTranslationUnit();
+                else if (runStats)
+                    runStats->addUncachedTranslationUnit();
+                if (cached)
+                    continue;
+            }
+
+            // Waits for memory before the clock starts, and is released once the AST and the tool are destroyed
+            MemoryBudget::Reservation reservation(memoryBudget.get(), memoryBudget ? memoryEstimates[i] : 0);
+            const auto start = std::chrono::steady_clock::now();
+
+            llvm::raw_string_ostream os(outputs[i]);
+            std::unique_ptr<DiagnosticConsumer> diagnosticPrinter;
+            if (s_asyncDiagnostics.getValue())
+                diagnosticPrinter.reset(new AsyncDiagnosticPrinter(os));
+            else
+                diagnosticPrinter.reset(new TextDiagnosticPrinter(os, new DiagnosticOptions()));
+            ClazyToolActionFactory factory(sourcePaths, history ? history->checksFor(sourcePaths[i], s_checks.getValue())
+                                                                : s_checks.getValue());
+
+#ifdef CLAZY_HAS_PREFETCH_FILE_SYSTEM
+            ClangTool tool(compilations, { sourcePaths[i] }, std::make_shared<PCHContainerOperations>(), baseFileSystem());
+#else
+            ClangTool tool(compilations, { sourcePaths[i] });
+#endif
+            tool.setDiagnosticConsumer(diagnosticPrinter.get());
+            if (headerUnits) {
+                const std::string header = headerUnits->headerFor(sourcePaths[i]);
+                if (header.empty()) {
+                    factory.setIgnoresIncludedFiles(true); // Its headers have their own translation units
+                } else {
+                    // Only warn about the header, not about the ones it includes
+                    tool.mapVirtualFile(sourcePaths[i], HeaderTranslationUnits::contentsFor(header));
+                    LineFilter headerOnly;
+                    headerOnly.addFile({ header, {} });
+                    factory.setLineFilter(headerOnly);
+                }
+            }
+
+            if (unityUnits && unityUnits->filesFor(sourcePaths[i])) {
+                tool.mapVirtualFile(sourcePaths[i], unityUnits->contentsFor(sourcePaths[i]));
+                factory.setUnityBuild(true);
+            }
+            results[i] = tool.run(&factory);
+            if (s_asyncDiagnostics.getValue())
+                static_cast<AsyncDiagnosticPrinter *>(diagnosticPrinter.get())->finish();
+            os.flush();
+            seconds[i] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            if (runStats || history || memoryBudget || !s_memoryCosts.getValue().empty()) {
+                // Several compile commands for the same file share its time, but run one after the other, so need
+                // the memory of the biggest
+                std::vector<TranslationUnitStats> recorded = RunStats::takeTranslationUnits();
+                uint64_t memoryBytes = 0;
+                for (TranslationUnitStats &stats : recorded) {
+                    if (history)
+                        history->record(sourcePaths[i], stats.checks);
+                    memoryBytes = std::max(memoryBytes, stats.memoryBytes);
+                    stats.seconds = seconds[i] / recorded.size();
+                    if (runStats)
+                        runStats->add(std::move(stats));
+                }
+
+                reservation.setMeasuredBytes(memoryBytes);
+                if (memoryBytes > 0)
+                    megabytes[i] = memoryBytes / (1024.0 * 1024.0);
+            }
+
+            // Failed runs aren't stored, a missing header might show up later
+            if (cache && results[i] == 0)
+                cache->store(cacheKey, tool.getFiles(), outputs[i], results[i]);
+
+            if (journal)
+                journal->record(i, outputs[i], results[i]);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numJobs);
+    for (unsigned int i = 0; i < numJobs; ++i)
+        threads.emplace_back(worker);
+
+    for (std::thread &t : threads)
+        t.join();
+
+    if (journal)
+        journal->finish();
+
+    if (!s_recordCosts.getValue().empty())
+        recordCosts(s_recordCosts.getValue(), sourcePaths, seconds);
+
+    if (!s_memoryCosts.getValue().empty())
+        recordCosts(s_memoryCosts.getValue(), sourcePaths, megabytes);
+
+    // Tells whether the budget, rather than -j, limited the throughput
+    if (memoryBudget && memoryBudget->numDelayed() > 0)
+        llvm::errs() << "clazy-standalone: -max-memory delayed " << memoryBudget->numDelayed() << " of " << numSources
+                     << " translation units\n";
+
+    int result = 0;
+    for (size_t i = 0; i < numSources; ++i) {
+        llvm::errs() << outputs[i];
+        result = std::max(result, results[i]);
+    }
+
+    // The translation units being analyzed at that point stopped too
+    if (reachedMaxWarnings()) {
+        llvm::errs() << "clazy-standalone: Stopped after " << ClazyContext::numEmittedWarnings() << " warnings, see -max-warnings\n";
+        result = std::max(result, 1);
+    }
+
+    if (sample)
+        sample->printEstimates(outputs, llvm::errs());
+
+    return result;
+}
+
+// The factory of the clazy action, for the modes living outside of this file
+static std::unique_ptr<FrontendActionFactory> createActionFactory(const std::vector<std::string> &paths, const std::string &checks,
+                                                                  const CompilationDatabase *preambleCompilations)
+{
+    return std::unique_ptr<FrontendActionFactory>(new ClazyToolActionFactory(paths, checks, preambleCompilations));
+}
+
+// Returns false if spec isn't a valid "K/N"
+static bool parseShard(llvm::StringRef spec, unsigned int &shard, unsigned int &numShards)
+{
+    llvm::StringRef shardStr, numShardsStr;
+    std::tie(shardStr, numShardsStr) = spec.split('/');
+    return !shardStr.getAsInteger(10, shard) && !numShardsStr.getAsInteger(10, numShards)
+           && numShards > 0 && shard >= 1 && shard <= numShards;
+}
+
+// Splits files into numShards groups of similar cost and returns the shard-th one (1-based).
+// Deterministic, so every machine computes the same split.
+static std::vector<std::string> filesForShard(const std::vector<std::string> &files, unsigned int shard, unsigned int numShards)
+{
+    const std::vector<double> costs = estimateCosts(files, s_costs.getValue());
+
+    // Largest first, each into the currently cheapest shard
+    std::vector<double> shardCosts(numShards, 0);
+    std::vector<std::string> result;
+    for (size_t i : longestFirst(files, costs)) {
+        const size_t cheapest = std::min_element(shardCosts.cbegin(), shardCosts.cend()) - shardCosts.cbegin();
+        shardCosts[cheapest] += costs[i];
+        if (cheapest == shard - 1)
+            result.push_back(files[i]);
+    }
+
+    return result;
+}
+
+static int mergeFixes(const std::vector<std::string> &inputs, const std::string &output)
+{
+    tooling::TranslationUnitDiagnostics merged;
+    for (const std::string &input : inputs) {
+        auto buffer = llvm::MemoryBuffer::getFile(input);
+        if (!buffer) {
+            llvm::errs() << "clazy-standalone: Failed to read " << input << "\n";
+            return 1;
+        }
+
+        tooling::TranslationUnitDiagnostics tuDiag;
+        llvm::yaml::Input yaml((*buffer)->getBuffer());
+        yaml >> tuDiag;
+        if (yaml.error()) {
+            llvm::errs() << "clazy-standalone: Failed to parse " << input << "\n";
+            return 1;
+        }
+
+        if (merged.MainSourceFile.empty())
+            merged.MainSourceFile = tuDiag.MainSourceFile;
+        std::move(tuDiag.Diagnostics.begin(), tuDiag.Diagnostics.end(), std::back_inserter(merged.Diagnostics));
+    }
+
+    // Same order FixItExporter::Export() uses
+    std::stable_sort(merged.Diagnostics.begin(), merged.Diagnostics.end(),
+                     [](const tooling::Diagnostic &d1, const tooling::Diagnostic &d2) {
+                         if (d1.Message.FilePath != d2.Message.FilePath)
+                             return d1.Message.FilePath < d2.Message.FilePath;
+                         return d1.Message.FileOffset < d2.Message.FileOffset;
+                     });
+
+    std::error_code ec;
+    llvm::raw_fd_ostream os(output, ec, llvm::sys::fs::F_None);
+    if (ec) {
+        llvm::errs() << "clazy-standalone: Failed to write " << output << "\n";
+        return 1;
+    }
+
+    llvm::yaml::Output yaml(os);
+    yaml << merged;
+    return 0;
+}
+
+static int runGlobalChecks(const std::string &indexFilename)
+{
+    std::string error;
+    std::unique_ptr<MiniAstIndex> index = MiniAstIndex::open(indexFilename, error);
+    if (!index) {
+        llvm::errs() << "clazy-standalone: Failed to read " << indexFilename << ": " << error << "\n";
+        return 1;
+    }
+
+    std::vector<std::string> checks = { s_checks.getValue().empty() ? "level1" : s_checks.getValue() };
+    std::vector<std::string> checkNames;
+    for (const RegisteredCheck &check : CheckManager::instance()->requestedChecks(checks, s_qt4Compat.getValue()))
+        checkNames.push_back(check.name);
+
+    for (const GlobalWarning &warning : GlobalCheck::run(*index, GlobalCheck::create(checkNames), std::max(1u, s_jobs.getValue()))) {
+        llvm::errs() << warning.file << ':' << warning.line << ':' << warning.column << ": warning: "
+                     << warning.message << " [-Wclazy-" << warning.check << "]\n";
+    }
+
+    return 0;
+}
+
+// Everything besides the compile command and input files that affects the results
+static std::string cacheConfiguration(const char *argv0)
+{
+    std::string configuration = "checks=" + s_checks.getValue() + "\nheader-filter=" + s_headerFilter.getValue()
+                                + "\nignore-dirs=" + s_ignoreDirs.getValue() + "\nline-filter=" + s_lineFilter.getValue();
+
+    const bool flags[] = { s_qt4Compat.getValue(), s_onlyQt.getValue(), s_qtDeveloper.getValue(),
+                           s_visitImplicitCode.getValue(), s_ignoreIncludedFiles.getValue(), s_analyzeHeaders.getValue(),
+                           s_asyncDiagnostics.getValue() };
+    configuration += "\nunity-batch-size=" + std::to_string(s_unityBatchSize.getValue());
+    configuration += "\nflags=";
+    for (bool flag : flags)
+        configuration += flag ? '1' : '0';
+
+    std::vector<std::string> checks = { s_checks.getValue().empty() ? "level1" : s_checks.getValue() };
+    for (const RegisteredCheck &check : CheckManager::instance()->requestedChecks(checks, s_qt4Compat.getValue()))
+        configuration += "\n" + check.name;
+
+    for (const char *name : { "CLAZY_CHECKS", "CLAZY_EXTRA_OPTIONS", "CLAZY_NO_WERROR", "CLAZY_HEADER_FILTER", "CLAZY_IGNORE_DIRS",
+                              "CLAZY_LINE_FILTER", "CLAZY_BASELINE", "CLAZY_HOTNESS_PROFILE", "CLAZY_MIN_HOTNESS" }) {
+        const char *value = getenv(name);
+        configuration += std::string("\n") + name + '=' + (value ? value : "");
+    }
+
+    // Editing the baseline or the hotness profile changes which warnings are emitted
+    llvm::sys::fs::file_status baselineStatus;
+    const char *baseline = getenv("CLAZY_BASELINE");
+    if (baseline && !llvm::sys::fs::status(baseline, baselineStatus)) {
+        configuration += "\nbaseline=" + std::to_string(baselineStatus.getSize())
+                         + ' ' + std::to_string(llvm::sys::toTimeT(baselineStatus.getLastModificationTime()));
+    }
+
+    const char *hotnessProfileEnv = getenv("CLAZY_HOTNESS_PROFILE");
+    const std::string hotnessProfile = !s_hotnessProfile.getValue().empty() ? s_hotnessProfile.getValue()
+                                                                            : std::string(hotnessProfileEnv ? hotnessProfileEnv : "");
+    llvm::sys::fs::file_status hotnessStatus;
+    configuration += "\nmin-hotness=" + std::to_string(s_minHotness.getValue());
+    if (!hotnessProfile.empty() && !llvm::sys::fs::status(hotnessProfile, hotnessStatus)) {
+        configuration += "\nhotness-profile=" + hotnessProfile + ' ' + std::to_string(hotnessStatus.getSize())
+                         + ' ' + std::to_string(llvm::sys::toTimeT(hotnessStatus.getLastModificationTime()));
+    }
+
+    // A different clazy build can give different results, even without new checks
+    const std::string executable = llvm::sys::fs::getMainExecutable(argv0, reinterpret_cast<void *>(reinterpret_cast<intptr_t>(&cacheConfiguration)));
+    llvm::sys::fs::file_status status;
+    if (!llvm::sys::fs::status(executable, status)) {
+        configuration += "\n" + executable + ' ' + std::to_string(status.getSize())
+                         + ' ' + std::to_string(llvm::sys::toTimeT(status.getLastModificationTime()));
+    }
+
+    return configuration;
+}
+
 int main(int argc, const char **argv)
 {
     CommonOptionsParser optionsParser(argc, argv, s_clazyCategory, cl::ZeroOrMore);
     // llvm::errs() << optionsParser.getSourcePathList().size() << "\n";
+    const RewrittenCompilations rewrittenCompilations(optionsParser.getCompilations(), s_removeArgPrefix, s_stripPch.getValue());
 
     if (s_supportedChecks.getValue()) {
         std::cout << SUPPORTED_CHECKS_JSON_STR;
@@ -150,7 +927,346 @@ int main(int argc, const char **argv)
         return 0;
     }
 
-    ClangTool tool(optionsParser.getCompilations(), optionsParser.getSourcePathList());
+    const char *lineFilterEnv = getenv("CLAZY_LINE_FILTER");
+    const std::string lineFilterJson = s_lineFilter.getValue().empty() && lineFilterEnv ? lineFilterEnv : s_lineFilter.getValue();
+    std::string lineFilterError;
+    if (!lineFilterJson.empty() && !s_parsedLineFilter.parse(lineFilterJson, lineFilterError)) {
+        llvm::errs() << "clazy-standalone: Invalid -line-filter: " << lineFilterError << "\n";
+        return 1;
+    }
+
+    s_parsedMaxWarnings = s_maxWarnings.getValue();
+    const char *maxWarningsEnv = getenv("CLAZY_MAX_WARNINGS");
+    if (s_parsedMaxWarnings == 0 && maxWarningsEnv && llvm::StringRef(maxWarningsEnv).getAsInteger(10, s_parsedMaxWarnings))
+        s_parsedMaxWarnings = 0; // ClazyContext reports it
+    ClazyContext::setMaxWarnings(s_parsedMaxWarnings);
+    FunctionHotness::setProfileFilename(s_hotnessProfile.getValue());
+    FunctionHotness::setMinHotness(s_minHotness.getValue());
+    if (!s_wasteReport.getValue().empty())
+        WasteReport::enable();
+
+    // Files changing while it runs would be stale
+    if (s_prefetchFiles.getValue() > 0 && (!s_server.getValue().empty() || !s_worker.getValue().empty() || s_watch.getValue())) {
+        llvm::errs() << "clazy-standalone: -prefetch-files can't be used with -server, -worker or -watch\n";
+        return 1;
+    }
+
+#ifndef CLAZY_HAS_PREFETCH_FILE_SYSTEM
+    if (s_prefetchFiles.getValue() > 0)
+        llvm::errs() << "clazy-standalone: -prefetch-files requires clazy to be built against clang >= 12, ignoring\n";
+#else
+    if (s_prefetchFiles.getValue() > 0)
+        s_prefetchFileSystem = new PrefetchFileSystem(llvm::vfs::getRealFileSystem());
+#endif
+
+    HeaderCache::setInMemory(s_inMemoryHeaderCache.getValue());
+
+    // Those analyze one translation unit at a time
+    if ((s_maxMemory.getValue() > 0 || !s_memoryCosts.getValue().empty())
+        && (!s_server.getValue().empty() || !s_worker.getValue().empty() || s_watch.getValue())) {
+        llvm::errs() << "clazy-standalone: -max-memory and -memory-costs can't be used with -server, -worker or -watch\n";
+        return 1;
+    }
+
+    if (!s_stateDir.getValue().empty()) {
+        if (!s_server.getValue().empty() || !s_worker.getValue().empty() || s_watch.getValue()) {
+            llvm::errs() << "clazy-standalone: -state-dir can't be used with -server, -worker or -watch\n";
+            return 1;
+        }
+
+        // What the resumed translation units exported or recorded was lost with the interrupted run, only the
+        // per translation unit fixes of -export-fixes=<directory> are already on disk
+        if ((!s_exportFixes.getValue().empty() && !llvm::sys::fs::is_directory(s_exportFixes.getValue())) || s_applyFixes.getValue()
+            || !s_checkHistory.getValue().empty() || s_parsedMaxWarnings > 0) {
+            llvm::errs() << "clazy-standalone: -state-dir can only be used with -export-fixes=<directory>, and not with -apply-fixes, -check-history or -max-warnings\n";
+            return 1;
+        }
+
+        if (getenv("CLAZY_EXPORT_JSONL") || getenv("CLAZY_EXPORT_SARIF") || getenv("CLAZY_EXPORT_BASELINE")) {
+            llvm::errs() << "clazy-standalone: -state-dir can't be used with CLAZY_EXPORT_JSONL, CLAZY_EXPORT_SARIF or CLAZY_EXPORT_BASELINE\n";
+            return 1;
+        }
+    }
+
+    // The warnings are counted for the whole process
+    if (s_parsedMaxWarnings > 0 && (!s_server.getValue().empty() || !s_worker.getValue().empty() || s_watch.getValue())) {
+        llvm::errs() << "clazy-standalone: -max-warnings and CLAZY_MAX_WARNINGS can't be used with -server, -worker or -watch\n";
+        return 1;
+    }
+
+#ifndef CLAZY_HAS_PRECOMPILED_PREAMBLE
+    if (s_reusePreambles.getValue())
+        llvm::errs() << "clazy-standalone: -reuse-preambles requires clazy to be built against clang >= 12, ignoring\n";
+#endif
+
+    if (s_applyFixes.getValue() && (!s_server.getValue().empty() || !s_cacheDir.getValue().empty() || s_watch.getValue()
+                                    || llvm::sys::fs::is_directory(s_exportFixes.getValue()))) {
+        llvm::errs() << "clazy-standalone: -apply-fixes can't be used with -server, -cache-dir, -watch or -export-fixes=<directory>\n";
+        return 1;
+    }
+
+    if (!s_server.getValue().empty()) {
+#ifdef _WIN32
+        llvm::errs() << "clazy-standalone: -server is not supported on Windows\n";
+        return 1;
+#else
+        if (!s_exportFixes.getValue().empty() && !llvm::sys::fs::is_directory(s_exportFixes.getValue())) {
+            llvm::errs() << "clazy-standalone: -server can only be used with -export-fixes=<directory>\n";
+            return 1;
+        }
+
+        StandaloneServer server(rewrittenCompilations, s_checks.getValue(), createActionFactory, s_reusePreambles.getValue());
+        return server.run(s_server.getValue());
+#endif
+    }
+
+    if (!s_worker.getValue().empty()) {
+#ifdef CLAZY_HAS_WORKER
+        StandaloneWorker worker(s_checks.getValue(), createActionFactory);
+        return worker.run(s_worker.getValue(), s_workerSecretFile.getValue(), s_workerAllowRemote.getValue(),
+                          s_workerReadTimeout.getValue());
+#else
+        llvm::errs() << "clazy-standalone: -worker requires clazy to be built against clang >= 12 and isn't supported on Windows\n";
+        return 1;
+#endif
+    }
+
+    if (!s_mergeFixes.getValue().empty())
+        return mergeFixes(optionsParser.getSourcePathList(), s_mergeFixes.getValue());
+
+    if (!s_mergeIndex.getValue().empty()) {
+        std::string error;
+        if (!MiniAstIndex::merge(optionsParser.getSourcePathList(), s_mergeIndex.getValue(), error)) {
+            llvm::errs() << "clazy-standalone: Failed to merge the indexes: " << error << "\n";
+            return 1;
+        }
+
+        return 0;
+    }
+
+    if (!s_globalChecks.getValue().empty())
+        return runGlobalChecks(s_globalChecks.getValue());
+
+    if (s_analyzeHeaders.getValue() && !s_parsedLineFilter.isEmpty()) {
+        llvm::errs() << "clazy-standalone: -analyze-headers can't be used with -line-filter or CLAZY_LINE_FILTER\n";
+        return 1;
+    }
+
+    if (s_analyzeHeaders.getValue() && s_unityBatchSize.getValue() > 0) {
+        llvm::errs() << "clazy-standalone: -analyze-headers can't be used with -unity-batch-size\n";
+        return 1;
+    }
+
+    const bool sampling = s_sample.getNumOccurrences() > 0;
+    if (sampling && !(s_sample.getValue() > 0 && s_sample.getValue() <= 1)) {
+        llvm::errs() << "clazy-standalone: Invalid -sample, expected 0 < P <= 1\n";
+        return 1;
+    }
+
+    // The estimation needs the warnings of each source file on their own
+    if (sampling && (s_analyzeHeaders.getValue() || s_unityBatchSize.getValue() > 1)) {
+        llvm::errs() << "clazy-standalone: -sample can't be used with -analyze-headers or -unity-batch-size\n";
+        return 1;
+    }
+
+    if (s_watch.getValue()) {
+        // Fixes are only written at exit, which doesn't happen
+        if (!s_exportFixes.getValue().empty() && !llvm::sys::fs::is_directory(s_exportFixes.getValue())) {
+            llvm::errs() << "clazy-standalone: -watch can only be used with -export-fixes=<directory>\n";
+            return 1;
+        }
+
+        if (s_analyzeHeaders.getValue() || s_unityBatchSize.getValue() > 1 || sampling || !s_statsJson.getValue().empty()
+            || !s_wasteReport.getValue().empty()) {
+            llvm::errs() << "clazy-standalone: -watch can't be used with -analyze-headers, -unity-batch-size, -sample, -stats-json or -waste-report\n";
+            return 1;
+        }
+    }
+
+    // The checks are chosen per source file, and cached results don't say which ones ran
+    if (!s_checkHistory.getValue().empty() && (s_analyzeHeaders.getValue() || s_unityBatchSize.getValue() > 1 || sampling
+                                               || s_watch.getValue() || !s_cacheDir.getValue().empty())) {
+        llvm::errs() << "clazy-standalone: -check-history can't be used with -analyze-headers, -unity-batch-size, -sample, -watch or -cache-dir\n";
+        return 1;
+    }
+
+    std::vector<std::string> sourcePaths = optionsParser.getSourcePathList();
+    if (sourcePaths.empty() && (!s_shard.getValue().empty() || s_analyzeHeaders.getValue() || sampling))
+        sourcePaths = rewrittenCompilations.getAllFiles();
+
+    // Found before sharding, so each shard borrows the same compile command for the same header
+    std::vector<std::string> headers;
+    std::unique_ptr<HeaderTranslationUnits> headerUnits;
+    if (s_analyzeHeaders.getValue()) {
+        headers = HeaderTranslationUnits::findHeaders(sourcePaths, s_headerFilter.getValue(), s_ignoreDirs.getValue());
+        headerUnits.reset(new HeaderTranslationUnits(rewrittenCompilations, sourcePaths, headers));
+    }
+
+    if (!s_shard.getValue().empty()) {
+        unsigned int shard = 0;
+        unsigned int numShards = 0;
+        if (!parseShard(s_shard.getValue(), shard, numShards)) {
+            llvm::errs() << "clazy-standalone: Invalid -shard, expected K/N with 1 <= K <= N\n";
+            return 1;
+        }
+
+        sourcePaths = filesForShard(sourcePaths, shard, numShards);
+        headers = filesForShard(headers, shard, numShards);
+    }
+
+    std::unique_ptr<TranslationUnitSample> sample;
+    if (sampling) {
+        sample.reset(new TranslationUnitSample(sourcePaths, s_sample.getValue()));
+        sourcePaths = sample->files();
+    }
+
+    if (headerUnits) {
+        for (const std::string &header : headers)
+            sourcePaths.push_back(HeaderTranslationUnits::pathFor(header));
+    }
+
+    // Batched after sharding, each shard has its own batches
+    std::unique_ptr<UnityTranslationUnits> unityUnits;
+    if (s_unityBatchSize.getValue() > 1) {
+        unityUnits.reset(new UnityTranslationUnits(rewrittenCompilations, sourcePaths, s_unityBatchSize.getValue()));
+        sourcePaths = unityUnits->getAllFiles();
+    }
+
+    const CompilationDatabase &compilations = headerUnits ? *headerUnits
+                                            : unityUnits ? static_cast<const CompilationDatabase &>(*unityUnits)
+                                                         : rewrittenCompilations;
+
+    const size_t numSources = sourcePaths.size();
+    const unsigned int numJobs = std::min<size_t>(s_jobs.getValue(), numSources);
+
+    std::unique_ptr<RunStats> runStats;
+    if (!s_statsJson.getValue().empty())
+        runStats.reset(new RunStats());
+
+    // Files are journaled by their index, so the run is identified by the files and their compile commands too
+    std::unique_ptr<RunJournal> journal;
+    if (!s_stateDir.getValue().empty()) {
+        std::string runKey = cacheConfiguration(argv[0]);
+        for (const std::string &path : sourcePaths) {
+            runKey += "\nfile=" + path;
+            for (const CompileCommand &command : compilations.getCompileCommands(path)) {
+                runKey += "\ndirectory=" + command.Directory;
+                for (const std::string &arg : command.CommandLine)
+                    runKey += "\narg=" + arg;
+            }
+        }
+
+        journal.reset(new RunJournal(s_stateDir.getValue(), runKey));
+        if (!journal->open()) {
+            llvm::errs() << "clazy-standalone: Failed to write the journal in " << s_stateDir.getValue() << "\n";
+            return 1;
+        }
+
+        if (const size_t numResumed = journal->numResumed())
+            llvm::errs() << "clazy-standalone: -state-dir resumes an interrupted run, " << numResumed << " of " << numSources
+                         << " translation units were already done\n";
+    }
+
+    std::unique_ptr<CheckHistory> history;
+    if (!s_checkHistory.getValue().empty()) {
+        history.reset(new CheckHistory(s_checkHistory.getValue(), s_checkHistoryRuns.getValue(), s_checkHistoryRerun.getValue()));
+        history->load(compilations, sourcePaths);
+        if (const size_t numSkipped = history->numSkippedChecks())
+            llvm::errs() << "clazy-standalone: -check-history skips " << numSkipped << " checks which didn't warn recently\n";
+    }
+
+    if (!s_cacheDir.getValue().empty()) {
+        if (!s_exportFixes.getValue().empty()) {
+            llvm::errs() << "clazy-standalone: -cache-dir can't be used with -export-fixes\n";
+            return 1;
+        }
+
+        // Cached results are printed without running clazy, so they wouldn't be exported
+        if (getenv("CLAZY_EXPORT_JSONL") || getenv("CLAZY_EXPORT_SARIF") || getenv("CLAZY_EXPORT_BASELINE") || !s_wasteReport.getValue().empty()) {
+            llvm::errs() << "clazy-standalone: -cache-dir can't be used with CLAZY_EXPORT_JSONL, CLAZY_EXPORT_SARIF, CLAZY_EXPORT_BASELINE or -waste-report\n";
+            return 1;
+        }
+
+        // A translation unit cut short by its budget would be cached with the warnings it had so far
+        if (getenv("CLAZY_CHECK_TIME_BUDGET") || getenv("CLAZY_TIME_BUDGET") || s_parsedMaxWarnings > 0) {
+            llvm::errs() << "clazy-standalone: -cache-dir can't be used with CLAZY_CHECK_TIME_BUDGET, CLAZY_TIME_BUDGET or -max-warnings\n";
+            return 1;
+        }
+
+        const ResultCache cache(s_cacheDir.getValue(), cacheConfiguration(argv[0]));
+        if (s_watch.getValue())
+            return StandaloneWatch(compilations, sourcePaths, s_checks.getValue(), createActionFactory).run(&cache, s_reusePreambles.getValue());
+
+#ifdef CLAZY_HAS_PREFETCH_FILE_SYSTEM
+        // What the translation units read last time is the best guess of what they'll read now. As the
+        // entries of unchanged ones are replayed, only stale entries are worth prefetching, but telling
+        // them apart means reading the files anyway.
+        if (s_prefetchFileSystem) {
+            std::vector<std::string> files;
+            for (const std::string &path : sourcePaths) {
+                const std::vector<std::string> dependencies = cache.storedDependencies(cache.keyFor(path, compilations.getCompileCommands(path)));
+                files.insert(files.end(), dependencies.cbegin(), dependencies.cend());
+            }
+            std::sort(files.begin(), files.end());
+            files.erase(std::unique(files.begin(), files.end()), files.end());
+            s_prefetchFileSystem->prefetch(std::move(files), s_prefetchFiles.getValue());
+        }
+#endif
+
+        const int result = runInParallel(compilations, sourcePaths, std::max(numJobs, 1u), &cache, headerUnits.get(),
+                                         unityUnits.get(), sample.get(), runStats.get(), nullptr, journal.get());
+#ifdef CLAZY_HAS_PREFETCH_FILE_SYSTEM
+        if (s_prefetchFileSystem)
+            s_prefetchFileSystem->stopPrefetching();
+#endif
+        if (runStats && !runStats->writeJson(s_statsJson.getValue(), s_statsSlowest.getValue())) {
+            llvm::errs() << "clazy-standalone: Failed to write " << s_statsJson.getValue() << "\n";
+            return 1;
+        }
+        return result;
+    }
+
+    if (s_watch.getValue())
+        return StandaloneWatch(compilations, sourcePaths, s_checks.getValue(), createActionFactory).run(nullptr, s_reusePreambles.getValue());
+
+    int result = 0;
+    if (numJobs > 1 || !s_recordCosts.getValue().empty() || headerUnits || unityUnits || sample || runStats || history
+        || s_parsedMaxWarnings > 0 || s_prefetchFiles.getValue() > 0 || s_maxMemory.getValue() > 0 || !s_memoryCosts.getValue().empty()
+        || journal) {
+        result = runInParallel(compilations, sourcePaths, std::max(numJobs, 1u), nullptr, headerUnits.get(), unityUnits.get(),
+                               sample.get(), runStats.get(), history.get(), journal.get());
+    } else {
+        ClangTool tool(rewrittenCompilations, sourcePaths);
+        std::unique_ptr<AsyncDiagnosticPrinter> diagnosticPrinter;
+        if (s_asyncDiagnostics.getValue()) {
+            diagnosticPrinter.reset(new AsyncDiagnosticPrinter(llvm::errs()));
+            tool.setDiagnosticConsumer(diagnosticPrinter.get());
+        }
+        result = tool.run(new ClazyToolActionFactory(sourcePaths));
+        if (diagnosticPrinter)
+            diagnosticPrinter->finish();
+    }
+
+    if (s_applyFixes.getValue() && !FixItExporter::applyFixes())
+        result = 1;
+
+    if (runStats && !runStats->writeJson(s_statsJson.getValue(), s_statsSlowest.getValue())) {
+        llvm::errs() << "clazy-standalone: Failed to write " << s_statsJson.getValue() << "\n";
+        result = 1;
+    }
+
+    if (WasteReport *wasteReport = WasteReport::instance()) {
+        if (!wasteReport->writeJson(s_wasteReport.getValue(), s_wasteReportTop.getValue())) {
+            llvm::errs() << "clazy-standalone: Failed to write " << s_wasteReport.getValue() << "\n";
+            result = 1;
+        }
+    }
+
+    // A stopped run doesn't say which checks would have warned in the files it didn't finish
+    if (history && !reachedMaxWarnings() && !history->write()) {
+        llvm::errs() << "clazy-standalone: Failed to write " << s_checkHistory.getValue() << "\n";
+        result = 1;
+    }
 
-    return tool.run(new ClazyToolActionFactory(optionsParser.getSourcePathList()));
+    return result;
 }
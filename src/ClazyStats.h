@@ -0,0 +1,91 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#ifndef CLAZY_STATS_H
+#define CLAZY_STATS_H
+
+#include "PerfCounters.h"
+
+#include <chrono>
+#include <cstdint>
+
+// Wall time and number of calls accumulated for the print-stats option
+struct ClazyStat
+{
+    double seconds = 0;
+    uint64_t calls = 0;
+    PerfCounterValues counters; // Only with the perf-counters option
+};
+
+struct CheckStats
+{
+    ClazyStat visitStmt;
+    ClazyStat visitDecl;
+    ClazyStat preprocessor;
+    uint64_t arenaBytes = 0; // Allocated through CheckBase::arenaAllocator()
+    uint64_t warnings = 0; // Emitted, only counted when collecting stats
+};
+
+/**
+ * Adds the time elapsed during its lifetime to a ClazyStat, and the hardware counter deltas if counters is valid.
+ * Does nothing if stat is nullptr, so callers don't need two code paths when stats are disabled.
+ */
+class ClazyStatTimer
+{
+public:
+    explicit ClazyStatTimer(ClazyStat *stat, const PerfCounters *counters = nullptr)
+        : m_stat(stat)
+        , m_counters(stat && counters && counters->isValid() ? counters : nullptr)
+    {
+        if (m_counters && !m_counters->read(m_startCounters))
+            m_counters = nullptr;
+        if (m_stat)
+            m_start = std::chrono::steady_clock::now();
+    }
+
+    ~ClazyStatTimer()
+    {
+        if (m_stat) {
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_start;
+            m_stat->seconds += elapsed.count();
+            m_stat->calls++;
+        }
+
+        if (m_counters) {
+            PerfCounterValues endCounters;
+            if (m_counters->read(endCounters)) {
+                for (int i = 0; i < PerfCounterValues::NumCounters; ++i)
+                    m_stat->counters.values[i] += endCounters.values[i] - m_startCounters.values[i];
+            }
+        }
+    }
+
+    ClazyStatTimer(const ClazyStatTimer &) = delete;
+    ClazyStatTimer& operator=(const ClazyStatTimer &) = delete;
+
+private:
+    ClazyStat *const m_stat;
+    const PerfCounters *m_counters;
+    PerfCounterValues m_startCounters;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+#endif
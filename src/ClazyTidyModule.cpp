@@ -0,0 +1,181 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+// Runs the clazy checks as clang-tidy checks, so clangd or clang-tidy (with --load) can use the AST they already built.
+// Each clazy check becomes a "clazy-<name>" check, see "clang-tidy module" in README.md.
+
+#include "Clazy.h"
+#include "ClazyContext.h"
+#include "HeaderCache.h"
+#include "WarningSink.h"
+#include "checkbase.h"
+#include "checkmanager.h"
+
+#include <clang-tidy/ClangTidyCheck.h>
+#include <clang-tidy/ClangTidyModule.h>
+#include <clang-tidy/ClangTidyModuleRegistry.h>
+#include <clang/AST/ASTContext.h>
+#include <clang/ASTMatchers/ASTMatchFinder.h>
+#include <clang/ASTMatchers/ASTMatchers.h>
+#include <clang/Basic/SourceManager.h>
+#include <clang/Lex/Preprocessor.h>
+#include <llvm/ADT/StringRef.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace clang;
+using namespace clang::ast_matchers;
+using namespace clang::tidy;
+
+namespace {
+
+class ClazyTidyCheck;
+
+// The clazy checks clang-tidy created and didn't destroy yet. clang-tidy creates them for each translation unit,
+// clangd for each AST it builds, with a ClangTidyContext of its own, possibly on several threads.
+std::mutex s_liveChecksMutex;
+std::vector<ClazyTidyCheck *> s_liveChecks;
+
+// Reports the warnings of the clazy checks as the clang-tidy check of the same name
+class TidyWarningSink : public WarningSink
+{
+public:
+    void warn(llvm::StringRef checkName, SourceLocation loc, llvm::StringRef message, const std::vector<FixItHint> &fixits) override;
+
+    std::map<std::string, ClazyTidyCheck *> checks; // By clazy check name, sorted so the checks run in a stable order
+};
+
+class ClazyTidyCheck : public ClangTidyCheck
+{
+public:
+    ClazyTidyCheck(llvm::StringRef name, ClangTidyContext *context, const RegisteredCheck &check)
+        : ClangTidyCheck(name, context)
+        , m_tidyContext(context)
+        , m_check(check)
+    {
+        std::lock_guard<std::mutex> lock(s_liveChecksMutex);
+        s_liveChecks.push_back(this);
+    }
+
+    ~ClazyTidyCheck() override
+    {
+        std::lock_guard<std::mutex> lock(s_liveChecksMutex);
+        s_liveChecks.erase(std::find(s_liveChecks.begin(), s_liveChecks.end(), this));
+    }
+
+    void registerPPCallbacks(const SourceManager &, Preprocessor *pp, Preprocessor *) override
+    {
+        m_preprocessor = pp;
+    }
+
+    void registerMatchers(MatchFinder *finder) override
+    {
+        // The clazy checks traverse the whole translation unit themselves, with their own matchers
+        finder->addMatcher(translationUnitDecl().bind("tu"), this);
+    }
+
+    // The first enabled clazy check to be called runs all of them, with a single ClazyASTConsumer, so the AST
+    // is only traversed once. The others then have nothing left to do.
+    void check(const MatchFinder::MatchResult &result) override
+    {
+        if (m_done || !m_preprocessor)
+            return;
+
+        TidyWarningSink sink;
+        {
+            std::lock_guard<std::mutex> lock(s_liveChecksMutex);
+            for (ClazyTidyCheck *check : s_liveChecks) {
+                if (check->m_tidyContext == m_tidyContext && !check->m_done) {
+                    check->m_done = true;
+                    sink.checks[check->m_check.name] = check;
+                }
+            }
+        }
+
+        // The consumer deletes the context
+        auto context = new ClazyContext(*result.Context, *m_preprocessor, /*headerFilter=*/ {}, /*ignoreDirs=*/ {},
+                                        /*exportFixesFilename=*/ {}, /*translationUnitPaths=*/ {}, ClazyContext::ClazyOption_None);
+        context->warningSink = &sink;
+
+        // Cached warnings would be replayed through the DiagnosticsEngine, bypassing clang-tidy
+        delete context->headerCache;
+        context->headerCache = nullptr;
+
+        std::unique_ptr<ClazyASTConsumer> consumer(new ClazyASTConsumer(context));
+        std::vector<std::unique_ptr<CheckBase>> checks;
+        for (const auto &it : sink.checks) {
+            const RegisteredCheck &registeredCheck = it.second->m_check;
+            checks.emplace_back(registeredCheck.factory(context));
+            consumer->addCheck({ checks.back().get(), registeredCheck });
+        }
+        consumer->HandleTranslationUnit(*result.Context);
+
+        // Before their context, whose arena they use
+        checks.clear();
+        consumer.reset();
+    }
+
+private:
+    friend class TidyWarningSink;
+
+    ClangTidyContext *const m_tidyContext;
+    const RegisteredCheck m_check;
+    Preprocessor *m_preprocessor = nullptr;
+    bool m_done = false; // Ran, by this check or another one of the same translation unit
+};
+
+void TidyWarningSink::warn(llvm::StringRef checkName, SourceLocation loc, llvm::StringRef message, const std::vector<FixItHint> &fixits)
+{
+    auto it = checks.find(checkName.str());
+    if (it == checks.end())
+        return;
+
+    DiagnosticBuilder builder = it->second->diag(loc, "%0") << message;
+    for (const FixItHint &fixit : fixits) {
+        if (!fixit.isNull())
+            builder << fixit;
+    }
+}
+
+class ClazyTidyModule : public ClangTidyModule
+{
+public:
+    void addCheckFactories(ClangTidyCheckFactories &factories) override
+    {
+        for (const RegisteredCheck &check : CheckManager::instance()->availableChecks(ManualCheckLevel)) {
+            factories.registerCheckFactory("clazy-" + check.name, [check](llvm::StringRef name, ClangTidyContext *context) {
+                return std::unique_ptr<ClangTidyCheck>(new ClazyTidyCheck(name, context, check));
+            });
+        }
+    }
+};
+
+}
+
+static ClangTidyModuleRegistry::Add<ClazyTidyModule> s_clazyTidyModule("clazy-module", "Adds the clazy checks.");
+
+// For linking the module statically, into clangd for example
+volatile int ClazyTidyModuleAnchorSource = 0;
@@ -23,9 +23,23 @@
 #include "SourceCompatibilityHelpers.h"
 
 #include <clang/Frontend/FrontendDiagnostic.h>
+#include <clang/Tooling/Core/Replacement.h>
 #include <clang/Tooling/DiagnosticsYaml.h>
 #include <clang/Basic/SourceManager.h>
 #include <clang/Rewrite/Frontend/FixItRewriter.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_set>
 
 // #define DEBUG_FIX_IT_EXPORTER
 
@@ -37,6 +51,48 @@ static clang::tooling::TranslationUnitDiagnostics& getTuDiag()
     return s_tudiag;
 }
 
+// clazy-standalone -j runs translation units in parallel, each with its own exporter
+static std::mutex &tuDiagLock()
+{
+    static std::mutex s_lock;
+    return s_lock;
+}
+
+// Keys of the diagnostics exported so far by clazy-standalone, see dedupKey(). Protected by tuDiagLock()
+static std::unordered_set<std::string> &exportedDiagnostics()
+{
+    static std::unordered_set<std::string> s_keys;
+    return s_keys;
+}
+
+static unsigned long s_numDuplicates = 0;
+
+// Every translation unit including a header emits the same warnings and fixits for it, these identify them
+static std::string dedupKey(const tooling::Diagnostic &diag)
+{
+    std::string key = diag.DiagnosticName + '\0' + diag.Message.FilePath + '\0' + std::to_string(diag.Message.FileOffset);
+    for (const auto &fix : clazy::DiagnosticFixes(diag)) {
+        for (const tooling::Replacement &replacement : fix.getValue()) {
+            key += '\0' + replacement.getFilePath().str() + '\0' + std::to_string(replacement.getOffset())
+                   + '\0' + std::to_string(replacement.getLength()) + '\0' + replacement.getReplacementText().str();
+        }
+    }
+
+    return key;
+}
+
+// Removes the diagnostics already exported, by other translation units or earlier in this one. Must be called with tuDiagLock() held.
+static void removeDuplicates(std::vector<tooling::Diagnostic> &diagnostics)
+{
+    auto &exported = exportedDiagnostics();
+    auto it = std::remove_if(diagnostics.begin(), diagnostics.end(), [&exported](const tooling::Diagnostic &diag) {
+        return !exported.insert(dedupKey(diag)).second;
+    });
+
+    s_numDuplicates += diagnostics.end() - it;
+    diagnostics.erase(it, diagnostics.end());
+}
+
 FixItExporter::FixItExporter(DiagnosticsEngine &DiagEngine, SourceManager &SourceMgr,
                              const LangOptions &LangOpts, const std::string &exportFixes,
                              bool isClazyStandalone)
@@ -44,10 +100,14 @@ FixItExporter::FixItExporter(DiagnosticsEngine &DiagEngine, SourceManager &Sourc
     , SourceMgr(SourceMgr)
     , LangOpts(LangOpts)
     , exportFixes(exportFixes)
+    , m_isClazyStandalone(isClazyStandalone)
+    , m_exportsPerTranslationUnit(isClazyStandalone && llvm::sys::fs::is_directory(exportFixes))
 {
     if (!isClazyStandalone) {
         // When using clazy as plugin each translation unit fixes goes to a separate YAML file
+        std::lock_guard<std::mutex> lock(tuDiagLock());
         getTuDiag().Diagnostics.clear();
+        exportedDiagnostics().clear();
     }
 
     Owner = DiagEngine.takeClient();
@@ -57,10 +117,27 @@ FixItExporter::FixItExporter(DiagnosticsEngine &DiagEngine, SourceManager &Sourc
 
 FixItExporter::~FixItExporter()
 {
+    if (!m_exportsPerTranslationUnit)
+        mergeDiagnostics();
+
     if (Client)
         DiagEngine.setClient(Client, Owner.release() != nullptr);
 }
 
+size_t FixItExporter::diagnosticsBytes() const
+{
+    size_t bytes = 0;
+    for (const tooling::Diagnostic &diag : m_diagnostics) {
+        bytes += sizeof(diag) + diag.DiagnosticName.size() + diag.Message.Message.size() + diag.Message.FilePath.size();
+        for (const auto &fix : clazy::DiagnosticFixes(diag)) {
+            for (const tooling::Replacement &replacement : fix.getValue())
+                bytes += sizeof(replacement) + replacement.getFilePath().size() + replacement.getReplacementText().size();
+        }
+    }
+
+    return bytes;
+}
+
 void FixItExporter::BeginSourceFile(const LangOptions &LangOpts, const Preprocessor *PP)
 {
     if (Client)
@@ -68,7 +145,12 @@ void FixItExporter::BeginSourceFile(const LangOptions &LangOpts, const Preproces
 
     const auto id = SourceMgr.getMainFileID();
     const auto entry = SourceMgr.getFileEntryForID(id);
-    getTuDiag().MainSourceFile = entry->getName();
+    m_mainSourceFile = entry->getName().str();
+    if (m_exportsPerTranslationUnit)
+        return;
+
+    std::lock_guard<std::mutex> lock(tuDiagLock());
+    getTuDiag().MainSourceFile = m_mainSourceFile;
 }
 
 bool FixItExporter::IncludeInDiagnosticCounts() const
@@ -169,7 +251,7 @@ void FixItExporter::HandleDiagnostic(DiagnosticsEngine::Level DiagLevel, const D
                 Diag(Info.getLocation(), diag::note_fixit_failed);
             }
         }
-        getTuDiag().Diagnostics.push_back(ToolingDiag);
+        m_diagnostics.push_back(ToolingDiag);
         m_recordNotes = true;
     }
     // FIXME: We do not receive notes.
@@ -178,7 +260,7 @@ void FixItExporter::HandleDiagnostic(DiagnosticsEngine::Level DiagLevel, const D
         const auto FileName = SourceMgr.getFilename(Info.getLocation());
         llvm::errs() << "Handling Note for " << FileName.str() << "\n";
 #endif
-        auto diags = getTuDiag().Diagnostics.back();
+        auto &diags = m_diagnostics.back();
         auto diag = ConvertDiagnostic(Info);
         diags.Notes.append(1, diag.Message);
     }
@@ -187,15 +269,194 @@ void FixItExporter::HandleDiagnostic(DiagnosticsEngine::Level DiagLevel, const D
     }
 }
 
+void FixItExporter::mergeDiagnostics()
+{
+    if (m_diagnostics.empty())
+        return;
+
+    // Also with the plugin, where an unguarded header included twice emits the same fixits twice
+    std::lock_guard<std::mutex> lock(tuDiagLock());
+    removeDuplicates(m_diagnostics);
+    auto &diagnostics = getTuDiag().Diagnostics;
+    diagnostics.insert(diagnostics.end(), m_diagnostics.begin(), m_diagnostics.end());
+    m_diagnostics.clear();
+}
+
 void FixItExporter::Export()
 {
-    auto tuDiag = getTuDiag();
-    if (!tuDiag.Diagnostics.empty()) {
-        std::error_code EC;
-        llvm::raw_fd_ostream OS(exportFixes, EC, llvm::sys::fs::F_None);
-        llvm::yaml::Output YAML(OS);
-        YAML << getTuDiag();
+    CLAZY_TIME_TRACE_SCOPE("clazy FixItExporter::Export", exportFixes);
+
+    if (m_exportsPerTranslationUnit) {
+        if (m_diagnostics.empty())
+            return;
+
+        // The name must be unique, as different directories can have files with the same name
+        llvm::MD5 hash;
+        hash.update(m_mainSourceFile);
+        llvm::MD5::MD5Result result;
+        hash.final(result);
+        llvm::SmallString<32> hexHash;
+        llvm::MD5::stringifyResult(result, hexHash);
+
+        tooling::TranslationUnitDiagnostics tuDiag;
+        tuDiag.MainSourceFile = m_mainSourceFile;
+        tuDiag.Diagnostics = std::move(m_diagnostics);
+        m_diagnostics.clear();
+        {
+            std::lock_guard<std::mutex> lock(tuDiagLock());
+            removeDuplicates(tuDiag.Diagnostics);
+        }
+
+        if (tuDiag.Diagnostics.empty())
+            return;
+
+        writeYaml(tuDiag, exportFixes + '/' + llvm::sys::path::filename(m_mainSourceFile).str() + '-' + hexHash.str().str() + ".yaml");
+        return;
     }
+
+    mergeDiagnostics();
+
+    std::lock_guard<std::mutex> lock(tuDiagLock());
+    auto &tuDiag = getTuDiag();
+    if (!tuDiag.Diagnostics.empty() && !exportFixes.empty()) // Empty with -apply-fixes only
+        writeYaml(tuDiag, exportFixes);
+
+    if (s_numDuplicates > 0)
+        llvm::errs() << "clazy: Skipped exporting " << s_numDuplicates << " duplicate diagnostics from shared headers\n";
+}
+
+// Writes to a temporary next to the file and renames it over, so an interrupted run never leaves a truncated source file
+static bool writeFileAtomically(const std::string &filename, llvm::StringRef contents)
+{
+    // Replace the file a symlink points to, not the symlink
+    llvm::SmallString<128> realFilename;
+    if (llvm::sys::fs::real_path(filename, realFilename))
+        realFilename = filename;
+
+    llvm::sys::fs::file_status status;
+    if (llvm::sys::fs::status(realFilename, status))
+        return false;
+
+    int fd = -1;
+    llvm::SmallString<128> tmpFilename;
+    if (llvm::sys::fs::createUniqueFile(realFilename.str() + "-%%%%%%", fd, tmpFilename))
+        return false;
+
+    llvm::sys::fs::setPermissions(tmpFilename, status.permissions());
+    llvm::raw_fd_ostream os(fd, /*shouldClose=*/ true);
+    os << contents;
+    os.close();
+
+    if (os.has_error()) {
+        os.clear_error(); // Or its destructor aborts
+        llvm::sys::fs::remove(tmpFilename);
+        return false;
+    }
+
+    if (llvm::sys::fs::rename(tmpFilename, realFilename)) {
+        llvm::sys::fs::remove(tmpFilename);
+        return false;
+    }
+
+    return true;
+}
+
+bool FixItExporter::applyFixes()
+{
+    CLAZY_TIME_TRACE_SCOPE("clazy FixItExporter::applyFixes", "");
+    std::lock_guard<std::mutex> lock(tuDiagLock());
+
+    // A diagnostic's fixit is applied entirely or not at all, so check it against a copy first.
+    // Replacements already added by another diagnostic are skipped, two identical insertions would both be applied.
+    std::map<std::string, tooling::Replacements> replacementsByFile;
+    std::unordered_set<std::string> addedReplacements;
+    unsigned int numConflicts = 0;
+    for (const tooling::Diagnostic &diag : getTuDiag().Diagnostics) {
+        std::map<std::string, tooling::Replacements> updated;
+        std::vector<std::string> added;
+        bool conflicts = false;
+        for (const auto &fix : clazy::DiagnosticFixes(diag)) {
+            tooling::Replacements replacements = replacementsByFile[fix.getKey()];
+            for (const tooling::Replacement &replacement : fix.getValue()) {
+                std::string key = replacement.getFilePath().str() + '\0' + std::to_string(replacement.getOffset()) + '\0'
+                                  + std::to_string(replacement.getLength()) + '\0' + replacement.getReplacementText().str();
+                if (addedReplacements.count(key) > 0 || std::find(added.cbegin(), added.cend(), key) != added.cend())
+                    continue;
+                added.push_back(std::move(key));
+
+                if (llvm::Error error = replacements.add(replacement)) {
+                    llvm::consumeError(std::move(error));
+                    conflicts = true;
+                    break;
+                }
+            }
+
+            if (conflicts)
+                break;
+            updated[fix.getKey()] = std::move(replacements);
+        }
+
+        if (conflicts) {
+            ++numConflicts;
+            continue;
+        }
+
+        for (auto &it : updated)
+            replacementsByFile[it.first] = std::move(it.second);
+        addedReplacements.insert(added.begin(), added.end());
+    }
+
+    bool success = true;
+    unsigned int numModifiedFiles = 0;
+    for (const auto &it : replacementsByFile) {
+        if (it.second.empty())
+            continue;
+
+        auto buffer = llvm::MemoryBuffer::getFile(it.first);
+        if (!buffer) {
+            llvm::errs() << "clazy: Failed to read " << it.first << "\n";
+            success = false;
+            continue;
+        }
+
+        llvm::Expected<std::string> code = tooling::applyAllReplacements((*buffer)->getBuffer(), it.second);
+        if (!code) {
+            llvm::errs() << "clazy: Failed to apply fixes to " << it.first << ": " << llvm::toString(code.takeError()) << "\n";
+            success = false;
+            continue;
+        }
+
+        if (!writeFileAtomically(it.first, *code)) {
+            llvm::errs() << "clazy: Failed to write " << it.first << "\n";
+            success = false;
+            continue;
+        }
+
+        ++numModifiedFiles;
+    }
+
+    llvm::errs() << "clazy: Applied fixes to " << numModifiedFiles << " files";
+    if (numConflicts > 0)
+        llvm::errs() << ", skipped " << numConflicts << " conflicting fixes";
+    llvm::errs() << "\n";
+
+    return success;
+}
+
+void FixItExporter::writeYaml(tooling::TranslationUnitDiagnostics &tuDiag, const std::string &filename) const
+{
+    // Translation units might have finished in any order, keep the output deterministic
+    std::stable_sort(tuDiag.Diagnostics.begin(), tuDiag.Diagnostics.end(),
+                     [](const tooling::Diagnostic &d1, const tooling::Diagnostic &d2) {
+                         if (d1.Message.FilePath != d2.Message.FilePath)
+                             return d1.Message.FilePath < d2.Message.FilePath;
+                         return d1.Message.FileOffset < d2.Message.FileOffset;
+                     });
+
+    std::error_code EC;
+    llvm::raw_fd_ostream OS(filename, EC, llvm::sys::fs::F_None);
+    llvm::yaml::Output YAML(OS);
+    YAML << tuDiag;
 }
 
 void FixItExporter::Diag(SourceLocation Loc, unsigned DiagID)
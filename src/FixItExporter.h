@@ -25,6 +25,8 @@
 #include <clang/Basic/Diagnostic.h>
 #include <clang/Tooling/Core/Diagnostic.h>
 
+#include <vector>
+
 namespace clang {
 class FixItOptions;
 }
@@ -51,6 +53,23 @@ public:
 
     void Export();
 
+    /**
+     * Applies the fixits collected from all translation units to the source files, writing each file once.
+     * For clazy-standalone -apply-fixes, call after the last translation unit. Fixits conflicting with
+     * previous ones are skipped. Returns false if a file couldn't be modified.
+     */
+    static bool applyFixes();
+
+    /**
+     * Returns true if exportFixes is a directory, in which case each translation unit writes its own YAML file
+     * there as soon as it's done, instead of keeping everything in memory until the last one.
+     */
+    bool exportsPerTranslationUnit() const { return m_exportsPerTranslationUnit; }
+
+    // Diagnostics of this translation unit not yet merged or exported, and the bytes of their strings. For the print-stats option
+    size_t numDiagnostics() const { return m_diagnostics.size(); }
+    size_t diagnosticsBytes() const;
+
     /// Emit a diagnostic via the adapted diagnostic client.
     void Diag(clang::SourceLocation Loc, unsigned DiagID);
 
@@ -59,9 +78,15 @@ private:
     clang::SourceManager &SourceMgr;
     const clang::LangOptions &LangOpts;
     const std::string exportFixes;
+    const bool m_isClazyStandalone;
+    const bool m_exportsPerTranslationUnit;
+    std::string m_mainSourceFile;
     DiagnosticConsumer *Client = nullptr;
     std::unique_ptr<DiagnosticConsumer> Owner;
     bool m_recordNotes = false;
+    std::vector<clang::tooling::Diagnostic> m_diagnostics; // Merged into the shared YAML output on export
+    void mergeDiagnostics();
+    void writeYaml(clang::tooling::TranslationUnitDiagnostics &tuDiag, const std::string &filename) const;
     clang::tooling::Diagnostic ConvertDiagnostic(const clang::Diagnostic &Info);
     clang::tooling::Replacement ConvertFixIt(const clang::FixItHint &Hint);
 };
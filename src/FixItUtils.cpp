@@ -33,11 +33,56 @@
 #include <clang/Basic/SourceLocation.h>
 #include <clang/Basic/SourceManager.h>
 #include <clang/Lex/Token.h>
+#include <llvm/ADT/DenseMap.h>
+
+#include <utility>
 
 using namespace clazy;
 using namespace clang;
 using namespace std;
 
+namespace {
+// Token boundaries, which fixits of several checks ask for again and again. Keyed by raw location plus offset, or token kind.
+struct TokenCache
+{
+    const ASTContext *context = nullptr;
+    llvm::DenseMap<std::pair<unsigned int, int>, unsigned int> endOfToken;
+    llvm::DenseMap<std::pair<unsigned int, int>, unsigned int> nextToken;
+};
+}
+
+// Per thread, as -j analyzes a translation unit per thread, cleared by clearTokenCache() when one starts
+static thread_local TokenCache s_tokenCache;
+
+static TokenCache &tokenCache(const ASTContext *context)
+{
+    if (s_tokenCache.context != context) { // A translation unit not announced by clearTokenCache()
+        clazy::clearTokenCache();
+        s_tokenCache.context = context;
+    }
+
+    return s_tokenCache;
+}
+
+void clazy::clearTokenCache()
+{
+    s_tokenCache.context = nullptr;
+    s_tokenCache.endOfToken.clear();
+    s_tokenCache.nextToken.clear();
+}
+
+SourceLocation clazy::locForEndOfToken(const ASTContext *context, SourceLocation start, int offset)
+{
+    auto &cache = tokenCache(context).endOfToken;
+    auto it = cache.find({ start.getRawEncoding(), offset });
+    if (it != cache.end())
+        return SourceLocation::getFromRawEncoding(it->second);
+
+    const SourceLocation end = Lexer::getLocForEndOfToken(start, offset, context->getSourceManager(), context->getLangOpts());
+    cache[{ start.getRawEncoding(), offset }] = end.getRawEncoding();
+    return end;
+}
+
 clang::FixItHint clazy::createReplacement(clang::SourceRange range, const std::string &replacement)
 {
     if (range.getBegin().isInvalid()) {
@@ -70,9 +115,7 @@ SourceRange clazy::rangeForLiteral(const ASTContext *context, StringLiteral *lt)
     SourceRange range;
     range.setBegin(clazy::getLocStart(lt));
 
-    SourceLocation end = Lexer::getLocForEndOfToken(lastTokenLoc, 0,
-                                                    context->getSourceManager(),
-                                                    context->getLangOpts()); // For some reason getLocStart(lt) is == to getLocEnd(lt)
+    SourceLocation end = locForEndOfToken(context, lastTokenLoc); // For some reason getLocStart(lt) is == to getLocEnd(lt)
 
     if (!end.isValid()) {
         return {};
@@ -109,17 +152,25 @@ SourceLocation clazy::locForNextToken(const ASTContext *context, SourceLocation
     if (!start.isValid())
         return {};
 
+    auto &cache = tokenCache(context).nextToken;
+    auto it = cache.find({ start.getRawEncoding(), kind });
+    if (it != cache.end())
+        return SourceLocation::getFromRawEncoding(it->second);
+
+    SourceLocation found;
     Token result;
     Lexer::getRawToken(start, result, context->getSourceManager(), context->getLangOpts());
+    if (result.getKind() == kind) {
+        found = start;
+    } else {
+        auto nextStart = locForEndOfToken(context, start);
+        if (nextStart.getRawEncoding() != start.getRawEncoding())
+            found = locForNextToken(context, nextStart, kind);
+    }
 
-    if (result.getKind() == kind)
-        return start;
-
-    auto nextStart = Lexer::getLocForEndOfToken(start, 0, context->getSourceManager(), context->getLangOpts());
-    if (nextStart.getRawEncoding() == start.getRawEncoding())
-        return {};
-
-    return locForNextToken(context, nextStart, kind);
+    // Inserted after the recursion, which can grow the map
+    cache[{ start.getRawEncoding(), kind }] = found.getRawEncoding();
+    return found;
 }
 
 SourceLocation clazy::biggestSourceLocationInStmt(const SourceManager &sm, Stmt *stmt)
@@ -138,11 +189,6 @@ SourceLocation clazy::biggestSourceLocationInStmt(const SourceManager &sm, Stmt
     return biggestLoc;
 }
 
-SourceLocation clazy::locForEndOfToken(const ASTContext *context, SourceLocation start, int offset)
-{
-    return Lexer::getLocForEndOfToken(start, offset, context->getSourceManager(), context->getLangOpts());
-}
-
 bool clazy::transformTwoCallsIntoOne(const ASTContext *context, CallExpr *call1, CXXMemberCallExpr *call2,
                                      const string &replacement, vector<FixItHint> &fixits)
 {
@@ -193,7 +239,7 @@ FixItHint clazy::fixItReplaceWordWithWord(const ASTContext *context, clang::Stmt
 {
     auto &sm = context->getSourceManager();
     SourceLocation rangeStart = clazy::getLocStart(begin);
-    SourceLocation rangeEnd = Lexer::getLocForEndOfToken(rangeStart, -1, sm, context->getLangOpts());
+    SourceLocation rangeEnd = locForEndOfToken(context, rangeStart, -1);
 
     if (rangeEnd.isInvalid()) {
         // Fallback. Have seen a case in the wild where the above would fail, it's very rare
@@ -201,7 +247,7 @@ FixItHint clazy::fixItReplaceWordWithWord(const ASTContext *context, clang::Stmt
         if (rangeEnd.isInvalid()) {
             clazy::printLocation(sm, rangeStart);
             clazy::printLocation(sm, rangeEnd);
-            clazy::printLocation(sm, Lexer::getLocForEndOfToken(rangeStart, 0, sm, context->getLangOpts()));
+            clazy::printLocation(sm, locForEndOfToken(context, rangeStart));
             return {};
         }
     }
@@ -212,8 +258,7 @@ FixItHint clazy::fixItReplaceWordWithWord(const ASTContext *context, clang::Stmt
 vector<FixItHint> clazy::fixItRemoveToken(const ASTContext *context, Stmt *stmt, bool removeParenthesis)
 {
     SourceLocation start = clazy::getLocStart(stmt);
-    SourceLocation end = Lexer::getLocForEndOfToken(start, removeParenthesis ? 0 : -1,
-                                                    context->getSourceManager(), context->getLangOpts());
+    SourceLocation end = locForEndOfToken(context, start, removeParenthesis ? 0 : -1);
 
     vector<FixItHint> fixits;
 
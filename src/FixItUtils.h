@@ -105,6 +105,12 @@ bool transformTwoCallsIntoOneV2(const clang::ASTContext *context, clang::CXXMemb
 clang::FixItHint fixItReplaceWordWithWord(const clang::ASTContext *context, clang::Stmt *begin,
                                           const std::string &replacement, const std::string &replacee);
 
+/**
+ * locForEndOfToken() and locForNextToken() memoize their results for the translation unit being analyzed.
+ * Forgets them, for the calling thread. Called when a translation unit starts.
+ */
+void clearTokenCache();
+
 std::vector<clang::FixItHint> fixItRemoveToken(const clang::ASTContext *context,
                                                clang::Stmt *stmt,
                                                bool removeParenthesis);
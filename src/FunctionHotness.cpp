@@ -0,0 +1,176 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "FunctionHotness.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/GlobalDecl.h>
+#include <clang/AST/Mangle.h>
+#include <clang/Basic/ABI.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Support/Casting.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <stdlib.h>
+#include <memory>
+#include <tuple>
+
+using namespace clang;
+using namespace std;
+
+static string s_profileFilename; // Set by setProfileFilename()
+static uint64_t s_minHotness = 0; // Set by setMinHotness()
+
+const FunctionHotness *FunctionHotness::instance()
+{
+    // Thread-safe initialization, and nothing changes afterwards
+    static const unique_ptr<const FunctionHotness> s_hotness = [] {
+        const char *filenameEnv = getenv("CLAZY_HOTNESS_PROFILE");
+        const string filename = !s_profileFilename.empty() ? s_profileFilename : string(filenameEnv ? filenameEnv : "");
+        unique_ptr<FunctionHotness> hotness;
+        if (!filename.empty()) {
+            hotness.reset(new FunctionHotness());
+            if (!hotness->read(filename)) {
+                llvm::errs() << "clazy: Failed to read hotness profile " << filename << "\n";
+                hotness.reset();
+            }
+        }
+
+        if (hotness) {
+            hotness->m_minHotness = s_minHotness;
+            const char *minHotnessEnv = getenv("CLAZY_MIN_HOTNESS");
+            if (s_minHotness == 0 && minHotnessEnv && llvm::StringRef(minHotnessEnv).getAsInteger(10, hotness->m_minHotness)) {
+                llvm::errs() << "clazy: Invalid CLAZY_MIN_HOTNESS, expected an execution count: " << minHotnessEnv << "\n";
+                hotness->m_minHotness = 0;
+            }
+        }
+
+        return unique_ptr<const FunctionHotness>(std::move(hotness));
+    }();
+
+    return s_hotness.get();
+}
+
+void FunctionHotness::setProfileFilename(const string &filename)
+{
+    s_profileFilename = filename;
+}
+
+void FunctionHotness::setMinHotness(uint64_t minHotness)
+{
+    s_minHotness = minHotness;
+}
+
+bool FunctionHotness::read(const string &filename)
+{
+    auto buffer = llvm::MemoryBuffer::getFile(filename);
+    if (!buffer)
+        return false;
+
+    llvm::SmallVector<llvm::StringRef, 16> lines;
+    (*buffer)->getBuffer().split(lines, '\n', -1, /*KeepEmpty=*/ false);
+
+    llvm::StringRef profdataFunction;
+    for (llvm::StringRef line : lines) {
+        const bool indented = line.startswith(" ") || line.startswith("\t");
+        line = line.trim();
+        if (line.empty() || line.startswith("#"))
+            continue;
+
+        uint64_t count = 0;
+        if (indented) {
+            // llvm-profdata show: "  _Z3foov:", then "    Function count: 100" among other fields
+            if (line.endswith(":") && line.find(' ') == llvm::StringRef::npos) {
+                profdataFunction = line.drop_back();
+            } else if (line.startswith("Function count:") && !profdataFunction.empty()) {
+                if (!line.drop_front(15).trim().getAsInteger(10, count))
+                    add(profdataFunction, count);
+                profdataFunction = {};
+            }
+
+            continue; // Or the lines and callees of a function in a sample profile
+        }
+
+        // "<mangled name> <count>"
+        llvm::StringRef name, countStr;
+        std::tie(name, countStr) = line.rsplit(' ');
+        if (!countStr.empty()) {
+            name = name.rtrim();
+            if (name.find(' ') == llvm::StringRef::npos && !countStr.getAsInteger(10, count))
+                add(name, count);
+            continue; // Or the summary of llvm-profdata show, like "Total functions: 3"
+        }
+
+        // Sample profile: "_Z3foov:1234:10", with the samples in the function and in its entry
+        llvm::StringRef headSamples, totalSamples;
+        std::tie(name, headSamples) = line.rsplit(':');
+        std::tie(name, totalSamples) = name.rsplit(':');
+        if (!name.empty() && !headSamples.empty() && !totalSamples.getAsInteger(10, count))
+            add(name, count);
+    }
+
+    return true;
+}
+
+void FunctionHotness::add(llvm::StringRef name, uint64_t count)
+{
+    // Functions with internal linkage are prefixed with their file, as in "main.cpp:_ZL3foov", mangled names have no ':'
+    const size_t colon = name.rfind(':');
+    if (colon != llvm::StringRef::npos)
+        name = name.drop_front(colon + 1);
+
+    if (!name.empty())
+        m_counts[name] += count;
+}
+
+string FunctionHotness::mangledName(MangleContext &mangleContext, const FunctionDecl *func)
+{
+    // Templates aren't in the profile, only their instantiations
+    if (!func || func->isDependentContext() || isa<CXXDeductionGuideDecl>(func))
+        return {};
+
+    if (!mangleContext.shouldMangleDeclName(func))
+        return func->getIdentifier() ? func->getName().str() : string();
+
+    string name;
+    llvm::raw_string_ostream stream(name);
+#if LLVM_VERSION_MAJOR >= 11
+    if (auto ctor = dyn_cast<CXXConstructorDecl>(func))
+        mangleContext.mangleName(GlobalDecl(ctor, Ctor_Complete), stream);
+    else if (auto dtor = dyn_cast<CXXDestructorDecl>(func))
+        mangleContext.mangleName(GlobalDecl(dtor, Dtor_Complete), stream);
+    else
+        mangleContext.mangleName(GlobalDecl(func), stream);
+#else
+    if (auto ctor = dyn_cast<CXXConstructorDecl>(func))
+        mangleContext.mangleCXXCtor(ctor, Ctor_Complete, stream);
+    else if (auto dtor = dyn_cast<CXXDestructorDecl>(func))
+        mangleContext.mangleCXXDtor(dtor, Dtor_Complete, stream);
+    else
+        mangleContext.mangleName(func, stream);
+#endif
+
+    return stream.str();
+}
@@ -0,0 +1,92 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_FUNCTION_HOTNESS_H
+#define CLAZY_FUNCTION_HOTNESS_H
+
+#include <llvm/ADT/StringMap.h>
+#include <llvm/ADT/StringRef.h>
+
+#include <cstdint>
+#include <string>
+
+namespace clang {
+class FunctionDecl;
+class MangleContext;
+}
+
+/**
+ * Execution counts of functions, by mangled name, so the warnings of performance checks can be prioritized.
+ * A warning in a function which ran once at startup matters less than one in a function which ran a million times.
+ *
+ * The file can be the output of "llvm-profdata show -all-functions" for an instrumented build, a text sample
+ * profile, as written by "llvm-profdata merge -sample -text" from perf data, whose counts are samples instead, or
+ * have a "<mangled name> <count>" line per function, for other profilers. Functions missing from it count as never
+ * executed. Constructors and destructors are looked up by their complete object variant, C1 and D1.
+ *
+ * Enabled by setting CLAZY_HOTNESS_PROFILE to the file name. The warnings of checks in the performance category then
+ * say how often their function ran, and with CLAZY_MIN_HOTNESS the ones in functions which ran fewer times are dropped.
+ */
+class FunctionHotness
+{
+public:
+    /**
+     * Returns the profile CLAZY_HOTNESS_PROFILE points to, read once and shared by every translation unit of the process.
+     * Returns nullptr if it's not set or can't be read.
+     */
+    static const FunctionHotness *instance();
+
+    /**
+     * Override CLAZY_HOTNESS_PROFILE and CLAZY_MIN_HOTNESS, for clazy-standalone's -hotness-profile and -min-hotness.
+     * Only have an effect before the first call to instance().
+     */
+    static void setProfileFilename(const std::string &filename);
+    static void setMinHotness(uint64_t minHotness);
+
+    /**
+     * Returns the name func has in the profile, or an empty string if it can't be mangled, as for templates.
+     */
+    static std::string mangledName(clang::MangleContext &mangleContext, const clang::FunctionDecl *func);
+
+    // Returns the execution count of the function, 0 if it's not in the profile
+    uint64_t count(llvm::StringRef mangledName) const
+    {
+        auto it = m_counts.find(mangledName);
+        return it == m_counts.end() ? 0 : it->second;
+    }
+
+    // Warnings in functions with a lower count are dropped
+    uint64_t minHotness() const
+    {
+        return m_minHotness;
+    }
+
+private:
+    FunctionHotness() = default;
+    bool read(const std::string &filename);
+    void add(llvm::StringRef name, uint64_t count);
+
+    llvm::StringMap<uint64_t> m_counts;
+    uint64_t m_minHotness = 0;
+};
+
+#endif
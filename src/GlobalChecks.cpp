@@ -0,0 +1,356 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "GlobalChecks.h"
+#include "MiniAstIndex.h"
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/DenseSet.h>
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <thread>
+#include <tuple>
+
+using namespace std;
+
+GlobalCheck::GlobalCheck(const char *name)
+    : m_name(name)
+{
+}
+
+GlobalCheck::~GlobalCheck()
+{
+}
+
+static GlobalWarning makeWarning(const MiniAstIndex &index, const MiniAstIndex::Location &location,
+                                 const GlobalCheck *check, const std::string &message)
+{
+    return { index.string(location.file).str(), location.line, location.column, check->name(), message };
+}
+
+// "(int, const QString &)" for "void (int, const QString &) const", what two methods must share to override one another
+static llvm::StringRef parameters(llvm::StringRef type)
+{
+    const size_t close = type.rfind(')');
+    if (close == llvm::StringRef::npos)
+        return type;
+
+    int depth = 0;
+    for (size_t i = close + 1; i-- > 0;) {
+        if (type[i] == ')') {
+            depth++;
+        } else if (type[i] == '(' && --depth == 0) {
+            return type.slice(i, close + 1);
+        }
+    }
+
+    return type;
+}
+
+namespace {
+
+// Base for the checks that walk the class hierarchies
+class HierarchyCheck : public GlobalCheck
+{
+public:
+    using GlobalCheck::GlobalCheck;
+
+    void prepare(const MiniAstIndex &index) override
+    {
+        for (const MiniAstIndex::Class &c : index.classes())
+            m_classes[c.name] = &c;
+    }
+
+    size_t numItems(const MiniAstIndex &index) const override
+    {
+        return index.classes().size();
+    }
+
+protected:
+    // Like clazy::getQObjectBaseClass(). Only QObjects are indexed, so it's the first base that is.
+    const MiniAstIndex::Class *qobjectBase(const MiniAstIndex &index, const MiniAstIndex::Class &c) const
+    {
+        for (uint32_t base : index.bases(c)) {
+            auto it = m_classes.find(base);
+            if (it != m_classes.end())
+                return it->second;
+        }
+
+        return nullptr;
+    }
+
+    bool hasNonQObjectBase(const MiniAstIndex &index, const MiniAstIndex::Class &c) const
+    {
+        for (uint32_t base : index.bases(c)) {
+            if (!m_classes.count(base))
+                return true;
+        }
+
+        return false;
+    }
+
+    // Strings are interned, so methods are compared by offset, except for the type
+    const MiniAstIndex::Method *findOverridden(const MiniAstIndex &index, const MiniAstIndex::Class &base,
+                                               const MiniAstIndex::Method &method) const
+    {
+        const llvm::StringRef params = parameters(index.string(method.type));
+        for (const MiniAstIndex::Method &baseMethod : index.methods(base)) {
+            if (baseMethod.name == method.name && parameters(index.string(baseMethod.type)) == params)
+                return &baseMethod;
+        }
+
+        return nullptr;
+    }
+
+    llvm::DenseMap<uint32_t, const MiniAstIndex::Class *> m_classes; // By name
+};
+
+class OverriddenSignalGlobal : public HierarchyCheck
+{
+public:
+    OverriddenSignalGlobal()
+        : HierarchyCheck("overridden-signal")
+    {
+    }
+
+    void map(const MiniAstIndex &index, size_t begin, size_t end, std::vector<GlobalWarning> &warnings) const override
+    {
+        for (const MiniAstIndex::Class &c : index.classes().slice(begin, end - begin)) {
+            if (c.flags & MiniAstIndex::Class_SystemHeader)
+                continue;
+
+            const std::string className = index.string(c.name).str();
+            for (const MiniAstIndex::Method &method : index.methods(c)) {
+                const bool methodIsSignal = method.flags & MiniAstIndex::Method_Signal;
+                const std::string qualifiedName = className + "::" + index.string(method.name).str();
+
+                // Bounded, in case a corrupt index has a cycle
+                const MiniAstIndex::Class *base = qobjectBase(index, c);
+                for (size_t depth = 0; base && depth < m_classes.size(); ++depth, base = qobjectBase(index, *base)) {
+                    const MiniAstIndex::Method *baseMethod = findOverridden(index, *base, method);
+                    if (!baseMethod)
+                        continue;
+
+                    const bool baseMethodIsSignal = baseMethod->flags & MiniAstIndex::Method_Signal;
+                    std::string message;
+                    if (methodIsSignal && baseMethodIsSignal) {
+                        message = "Overriding signal with signal: " + qualifiedName;
+                    } else if (methodIsSignal) {
+                        message = "Overriding non-signal with signal: " + qualifiedName;
+                    } else if (baseMethodIsSignal) {
+                        message = "Overriding signal with non-signal: " + qualifiedName;
+                    }
+
+                    if (!message.empty()) {
+                        warnings.push_back(makeWarning(index, method.location, this, message));
+                        break;
+                    }
+                }
+            }
+        }
+    }
+};
+
+class VirtualSignalGlobal : public HierarchyCheck
+{
+public:
+    VirtualSignalGlobal()
+        : HierarchyCheck("virtual-signal")
+    {
+    }
+
+    void map(const MiniAstIndex &index, size_t begin, size_t end, std::vector<GlobalWarning> &warnings) const override
+    {
+        for (const MiniAstIndex::Class &c : index.classes().slice(begin, end - begin)) {
+            if (c.flags & MiniAstIndex::Class_SystemHeader)
+                continue;
+
+            // The signal might override a method of a non-QObject interface, which the index doesn't have
+            bool hasInterface = hasNonQObjectBase(index, c);
+            const MiniAstIndex::Class *base = qobjectBase(index, c);
+            for (size_t depth = 0; base && !hasInterface && depth < m_classes.size(); ++depth, base = qobjectBase(index, *base))
+                hasInterface = hasNonQObjectBase(index, *base);
+            if (hasInterface)
+                continue;
+
+            for (const MiniAstIndex::Method &method : index.methods(c)) {
+                const uint32_t virtualSignal = MiniAstIndex::Method_Virtual | MiniAstIndex::Method_Signal;
+                if ((method.flags & virtualSignal) == virtualSignal)
+                    warnings.push_back(makeWarning(index, method.location, this, "signal is virtual"));
+            }
+        }
+    }
+};
+
+class MissingTypeInfoGlobal : public GlobalCheck
+{
+public:
+    MissingTypeInfoGlobal()
+        : GlobalCheck("missing-typeinfo")
+    {
+    }
+
+    void prepare(const MiniAstIndex &index) override
+    {
+        for (const MiniAstIndex::TypeInfo &typeInfo : index.typeInfos())
+            m_typeInfos.insert(typeInfo.type);
+    }
+
+    size_t numItems(const MiniAstIndex &index) const override
+    {
+        return index.containerUses().size();
+    }
+
+    // Same conditions as the per translation unit check, but a Q_DECLARE_TYPEINFO anywhere in the program counts
+    void map(const MiniAstIndex &index, size_t begin, size_t end, std::vector<GlobalWarning> &warnings) const override
+    {
+        for (const MiniAstIndex::ContainerUse &use : index.containerUses().slice(begin, end - begin)) {
+            const bool isQList = index.string(use.container) == "QList";
+            if (!(use.flags & MiniAstIndex::ContainerUse_TriviallyCopyable)
+                || (isQList && !(use.flags & MiniAstIndex::ContainerUse_TooBigForQList)))
+                continue;
+
+            const llvm::StringRef typeName = index.string(use.type);
+            if (m_typeInfos.count(use.type) || typeName == "QPair")
+                continue;
+
+            warnings.push_back(makeWarning(index, use.location, this, "Missing Q_DECLARE_TYPEINFO: " + typeName.str()));
+        }
+    }
+
+private:
+    llvm::DenseSet<uint32_t> m_typeInfos; // Type names
+};
+
+class VirtualCallInLoopGlobal : public GlobalCheck
+{
+public:
+    VirtualCallInLoopGlobal()
+        : GlobalCheck("virtual-call-in-loop")
+    {
+    }
+
+    void prepare(const MiniAstIndex &index) override
+    {
+        for (const MiniAstIndex::Derivation &derivation : index.derivations())
+            m_subclassed.insert(derivation.base);
+        for (const MiniAstIndex::Override &o : index.overrides())
+            m_overridden.insert(o.overridden);
+    }
+
+    size_t numItems(const MiniAstIndex &index) const override
+    {
+        return index.virtualCalls().size();
+    }
+
+    // Unlike the per translation unit check, the static class can be defined in any header
+    void map(const MiniAstIndex &index, size_t begin, size_t end, std::vector<GlobalWarning> &warnings) const override
+    {
+        for (const MiniAstIndex::VirtualCall &call : index.virtualCalls().slice(begin, end - begin)) {
+            const std::string callee = index.string(call.calleeName).str();
+            if (!m_subclassed.count(call.staticClass)) {
+                warnings.push_back(makeWarning(index, call.location, this, "Virtual call to " + callee + " in a loop, but "
+                                               + index.string(call.staticClass).str()
+                                               + " has no subclasses; mark it final so the compiler can devirtualize the call"));
+            } else if ((call.flags & MiniAstIndex::VirtualCall_CalleeInClass) && !m_overridden.count(call.callee)) {
+                warnings.push_back(makeWarning(index, call.location, this, "Virtual call to " + callee
+                                               + " in a loop, but nothing overrides it; mark it final so the compiler can devirtualize the call"));
+            }
+        }
+    }
+
+private:
+    llvm::DenseSet<uint32_t> m_subclassed; // Class names
+    llvm::DenseSet<uint32_t> m_overridden; // Function keys
+};
+
+}
+
+GlobalCheck::List GlobalCheck::create(const std::vector<std::string> &checkNames)
+{
+    List checks;
+    for (const std::string &name : checkNames) {
+        if (name == "overridden-signal")
+            checks.emplace_back(new OverriddenSignalGlobal());
+        else if (name == "virtual-signal")
+            checks.emplace_back(new VirtualSignalGlobal());
+        else if (name == "missing-typeinfo")
+            checks.emplace_back(new MissingTypeInfoGlobal());
+        else if (name == "virtual-call-in-loop")
+            checks.emplace_back(new VirtualCallInLoopGlobal());
+    }
+
+    return checks;
+}
+
+std::vector<GlobalWarning> GlobalCheck::run(const MiniAstIndex &index, const List &checks, unsigned int numThreads)
+{
+    for (const auto &check : checks)
+        check->prepare(index);
+
+    // Several chunks per thread, so a slow one doesn't keep the others waiting
+    struct Chunk {
+        const GlobalCheck *check;
+        size_t begin;
+        size_t end;
+    };
+    std::vector<Chunk> chunks;
+    const size_t chunksPerCheck = std::max(numThreads, 1u) * 4;
+    for (const auto &check : checks) {
+        const size_t numItems = check->numItems(index);
+        const size_t chunkSize = std::max<size_t>(1, (numItems + chunksPerCheck - 1) / chunksPerCheck);
+        for (size_t begin = 0; begin < numItems; begin += chunkSize)
+            chunks.push_back({ check.get(), begin, std::min(begin + chunkSize, numItems) });
+    }
+
+    std::vector<std::vector<GlobalWarning>> results(chunks.size());
+    std::atomic<size_t> nextChunk(0);
+    auto worker = [&] {
+        for (size_t i = nextChunk++; i < chunks.size(); i = nextChunk++)
+            chunks[i].check->map(index, chunks[i].begin, chunks[i].end, results[i]);
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < numThreads; ++i)
+        threads.emplace_back(worker);
+    worker();
+    for (std::thread &t : threads)
+        t.join();
+
+    std::vector<GlobalWarning> warnings;
+    for (std::vector<GlobalWarning> &result : results)
+        std::move(result.begin(), result.end(), std::back_inserter(warnings));
+
+    auto key = [] (const GlobalWarning &w) {
+        return std::tie(w.file, w.line, w.column, w.check, w.message);
+    };
+    std::sort(warnings.begin(), warnings.end(), [&key] (const GlobalWarning &w1, const GlobalWarning &w2) {
+        return key(w1) < key(w2);
+    });
+    warnings.erase(std::unique(warnings.begin(), warnings.end(), [&key] (const GlobalWarning &w1, const GlobalWarning &w2) {
+        return key(w1) == key(w2);
+    }), warnings.end());
+
+    return warnings;
+}
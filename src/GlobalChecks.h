@@ -0,0 +1,78 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_GLOBAL_CHECKS_H
+#define CLAZY_GLOBAL_CHECKS_H
+
+#include <llvm/ADT/StringRef.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class MiniAstIndex;
+
+struct GlobalWarning
+{
+    std::string file;
+    unsigned int line;
+    unsigned int column;
+    std::string check;
+    std::string message;
+};
+
+/**
+ * A check that runs once over the merged whole-program MiniAstIndex, for what a single translation unit can't see,
+ * like whether a Q_DECLARE_TYPEINFO exists anywhere or the whole class hierarchy.
+ *
+ * prepare() builds lookup tables single-threaded. The work is then split into ranges of items, which map() processes
+ * concurrently, so it must only read what prepare() built. The warnings are then merged, sorted and deduplicated.
+ */
+class GlobalCheck
+{
+public:
+    typedef std::vector<std::unique_ptr<GlobalCheck>> List;
+
+    explicit GlobalCheck(const char *name);
+    virtual ~GlobalCheck();
+
+    const char *name() const { return m_name; }
+
+    virtual void prepare(const MiniAstIndex &) {}
+    virtual size_t numItems(const MiniAstIndex &index) const = 0;
+    virtual void map(const MiniAstIndex &index, size_t begin, size_t end, std::vector<GlobalWarning> &warnings) const = 0;
+
+    /**
+     * Creates the global variants of the checks named, ignoring the checks which don't have one.
+     */
+    static List create(const std::vector<std::string> &checkNames);
+
+    /**
+     * Runs checks over index using numThreads threads and returns their warnings, sorted by location.
+     */
+    static std::vector<GlobalWarning> run(const MiniAstIndex &index, const List &checks, unsigned int numThreads);
+
+private:
+    const char *const m_name;
+};
+
+#endif
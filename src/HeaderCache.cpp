@@ -0,0 +1,415 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#include "HeaderCache.h"
+#include "PreprocessorDispatcher.h"
+
+#include <clang/Basic/Diagnostic.h>
+#include <clang/Basic/DiagnosticIDs.h>
+#include <clang/Basic/FileManager.h>
+#include <clang/Basic/SourceManager.h>
+#include <clang/Basic/TargetInfo.h>
+#include <clang/Lex/Lexer.h>
+#include <clang/Lex/MacroInfo.h>
+#include <clang/Lex/PPCallbacks.h>
+#include <clang/Lex/Preprocessor.h>
+#include <clang/Lex/PreprocessorOptions.h>
+#include <clang/Lex/Token.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <mutex>
+#include <stdlib.h>
+#include <tuple>
+#include <utility>
+
+using namespace clang;
+using namespace std;
+
+static bool s_inMemory = false;
+static std::mutex s_inMemoryMutex; // Protects HeaderCache::inMemoryEntries()
+
+// FNV-1a, cheap enough for every macro definition of the translation unit
+static uint64_t fnv1a(llvm::StringRef str, uint64_t hash = 14695981039346656037ULL)
+{
+    for (char c : str) {
+        hash ^= uint8_t(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Follows the macro definitions, to know which were defined when each file was included
+class HeaderCache::Callbacks
+    : public PPCallbacks
+{
+public:
+    explicit Callbacks(HeaderCache &cache)
+        : m_cache(cache)
+    {
+    }
+
+    void MacroDefined(const Token &macroNameTok, const MacroDirective *directive) override
+    {
+        const IdentifierInfo *ii = macroNameTok.getIdentifierInfo();
+        if (!ii)
+            return;
+
+        // The tokens from the name to the end of the definition, with the parameters. Built-in macros have no location.
+        llvm::StringRef definition;
+        const MacroInfo *info = directive ? directive->getMacroInfo() : nullptr;
+        if (info && info->getDefinitionLoc().isValid()) {
+            const CharSourceRange range = CharSourceRange::getTokenRange(info->getDefinitionLoc(), info->getDefinitionEndLoc());
+            definition = Lexer::getSourceText(range, m_cache.m_sm, m_cache.m_pp.getLangOpts());
+        }
+
+        m_cache.setMacroHash(ii, fnv1a(definition, fnv1a(ii->getName())));
+    }
+
+    void MacroUndefined(const Token &macroNameTok, const MacroDefinition &, const MacroDirective *) override
+    {
+        if (const IdentifierInfo *ii = macroNameTok.getIdentifierInfo())
+            m_cache.setMacroHash(ii, 0);
+    }
+
+    void FileChanged(SourceLocation loc, FileChangeReason reason, SrcMgr::CharacteristicKind, FileID) override
+    {
+        if (reason == EnterFile)
+            m_cache.enterFile(m_cache.m_sm.getFileID(loc));
+    }
+
+private:
+    HeaderCache &m_cache;
+};
+
+HeaderCache::HeaderCache(const Preprocessor &pp, PreprocessorDispatcher *dispatcher, const string &cacheDir)
+    : m_pp(pp)
+    , m_sm(pp.getSourceManager())
+    , m_cacheDir(cacheDir)
+    , m_configuration("clazy-header-cache-3\n" + pp.getTargetInfo().getTriple().str())
+{
+    // Headers expand differently depending on the macros passed via command line
+    for (const auto &macro : pp.getPreprocessorOpts().Macros)
+        addToConfiguration((macro.second ? "-U" : "-D") + macro.first);
+
+    dispatcher->subscribe(new Callbacks(*this),
+                          PreprocessorEvent_MacroDefined | PreprocessorEvent_MacroUndefined | PreprocessorEvent_FileChanged);
+
+    if (!m_cacheDir.empty())
+        llvm::sys::fs::create_directories(m_cacheDir);
+}
+
+HeaderCache::~HeaderCache()
+{
+    // A botched AST doesn't produce the same warnings, don't cache it.
+    // With -Werror our own warnings are errors too, so only bail out on fatal ones, like missing includes.
+    const DiagnosticsEngine &engine = m_pp.getDiagnostics();
+    if (engine.hasFatalErrorOccurred() || (!engine.getWarningsAsErrors() && engine.hasErrorOccurred()))
+        return;
+
+    for (const auto &it : m_headers) {
+        if (!it.second.cached)
+            writeCacheFile(it.second);
+    }
+}
+
+void HeaderCache::setInMemory(bool inMemory)
+{
+    s_inMemory = inMemory;
+}
+
+bool HeaderCache::isInMemory()
+{
+    return s_inMemory;
+}
+
+unordered_map<string, vector<HeaderCache::CachedWarning>> &HeaderCache::inMemoryEntries()
+{
+    static unordered_map<string, vector<CachedWarning>> s_entries;
+    return s_entries;
+}
+
+void HeaderCache::addToConfiguration(const string &str)
+{
+    m_configuration += '\n';
+    m_configuration += str;
+}
+
+void HeaderCache::setMacroHash(const IdentifierInfo *macro, uint64_t hash)
+{
+    uint64_t &previousHash = m_macroHashes[macro];
+    m_macroState ^= previousHash ^ hash;
+    previousHash = hash;
+}
+
+void HeaderCache::enterFile(FileID fid)
+{
+    // A header without include guard gets a FileID per inclusion, but is cached by its first one, see load()
+    m_macroStates[fid.getHashValue()] = m_macroState;
+    m_enteredFiles.push_back(fid);
+}
+
+bool HeaderCache::isCacheable(FileID fid) const
+{
+    return fid != m_sm.getMainFileID() && !m_sm.isInSystemHeader(m_sm.getLocForStartOfFile(fid));
+}
+
+string HeaderCache::fileHash(FileID fid, const FileEntry *entry) const
+{
+    // System headers are only told apart by their size and modification time, hashing all of Qt's would cost more than
+    // the cache saves. They aren't edited in place anyway.
+    if (!isCacheable(fid))
+        return entry->getName().str() + ':' + to_string(entry->getSize()) + ':' + to_string(entry->getModificationTime());
+
+    bool invalid = false;
+    const llvm::StringRef contents = m_sm.getBufferData(fid, &invalid);
+    if (invalid)
+        return {};
+
+    llvm::MD5 hash;
+    hash.update(contents);
+    llvm::MD5::MD5Result result;
+    hash.final(result);
+    llvm::SmallString<32> hexHash;
+    llvm::MD5::stringifyResult(result, hexHash);
+    return hexHash.str().str();
+}
+
+void HeaderCache::load()
+{
+    // The hashes of the files each file included, directly or not, in include order
+    std::unordered_map<unsigned int, string> includedHashes;
+    std::unordered_map<unsigned int, string> contentsHashes;
+    for (FileID fid : m_enteredFiles) {
+        const FileEntry *entry = m_sm.getFileEntryForID(fid);
+        if (!entry)
+            continue; // <built-in> or <command line>, their macros are in the states already
+
+        const string hash = fileHash(fid, entry);
+        contentsHashes[fid.getHashValue()] = hash;
+        for (FileID includer = m_sm.getFileID(m_sm.getIncludeLoc(fid)); includer.isValid();
+             includer = m_sm.getFileID(m_sm.getIncludeLoc(includer))) {
+            string &hashes = includedHashes[includer.getHashValue()];
+            hashes += hash;
+            hashes += '\n';
+        }
+    }
+
+    for (FileID fid : m_enteredFiles) {
+        const FileEntry *entry = m_sm.getFileEntryForID(fid);
+        Header *header = nullptr;
+        if (entry && isCacheable(fid)) {
+            auto it = m_headers.find(entry);
+            if (it == m_headers.end()) {
+                const string &contentsHash = contentsHashes[fid.getHashValue()];
+                if (!contentsHash.empty()) {
+                    createHeader(fid, entry, contentsHash, m_macroStates[fid.getHashValue()], includedHashes[fid.getHashValue()]);
+                    header = &m_headers[entry];
+                }
+            } else {
+                header = &it->second;
+            }
+        }
+
+        m_headersByFileId[fid.getHashValue()] = header;
+    }
+
+    m_lastFileId = FileID();
+    m_lastHeader = nullptr;
+}
+
+bool HeaderCache::isCached(SourceLocation loc)
+{
+    Header *header = headerForLoc(loc);
+    return header && header->cached;
+}
+
+void HeaderCache::recordWarning(SourceLocation loc, const string &message)
+{
+    Header *header = headerForLoc(loc);
+    if (!header || header->cached)
+        return;
+
+    header->warnings.push_back({ m_sm.getExpansionLineNumber(loc), m_sm.getExpansionColumnNumber(loc), message });
+}
+
+size_t HeaderCache::numHits() const
+{
+    return std::count_if(m_headers.cbegin(), m_headers.cend(),
+                         [](const std::pair<const FileEntry *const, Header> &it) { return it.second.cached; });
+}
+
+size_t HeaderCache::numMisses() const
+{
+    return m_headers.size() - numHits();
+}
+
+HeaderCache::Header *HeaderCache::headerForLoc(SourceLocation loc)
+{
+    if (loc.isInvalid())
+        return nullptr;
+
+    const FileID fid = m_sm.getFileID(m_sm.getExpansionLoc(loc));
+    if (fid == m_lastFileId)
+        return m_lastHeader;
+
+    // Files which weren't entered, like those of a PCH, aren't cached
+    auto it = m_headersByFileId.find(fid.getHashValue());
+    m_lastFileId = fid;
+    m_lastHeader = it == m_headersByFileId.end() ? nullptr : it->second;
+    return m_lastHeader;
+}
+
+void HeaderCache::createHeader(FileID fid, const FileEntry *entry, const string &contentsHash, uint64_t macroState,
+                               const string &includedHashes)
+{
+    llvm::MD5 hash;
+    hash.update(m_configuration);
+    hash.update(contentsHash);
+    hash.update(to_string(macroState));
+    hash.update(includedHashes);
+    llvm::MD5::MD5Result result;
+    hash.final(result);
+    llvm::SmallString<32> hexHash;
+    llvm::MD5::stringifyResult(result, hexHash);
+
+    Header &header = m_headers[entry];
+    header.fileId = fid;
+    header.key = llvm::sys::path::filename(entry->getName()).str() + '-' + hexHash.str().str();
+    if (!m_cacheDir.empty())
+        header.cacheFilename = m_cacheDir + '/' + header.key + ".clazy-cache";
+    header.cached = readCacheFile(header);
+    if (header.cached)
+        replay(header);
+}
+
+bool HeaderCache::readCacheFile(Header &header)
+{
+    if (s_inMemory) {
+        std::lock_guard<std::mutex> lock(s_inMemoryMutex);
+        auto it = inMemoryEntries().find(header.key);
+        if (it != inMemoryEntries().end()) {
+            header.warnings = it->second;
+            return true;
+        }
+    }
+
+    if (header.cacheFilename.empty())
+        return false;
+
+    auto buffer = llvm::MemoryBuffer::getFile(header.cacheFilename);
+    if (!buffer)
+        return false;
+
+    // Each line is: <line>:<column>:<message>, followed by end:<number of warnings>
+    llvm::SmallVector<llvm::StringRef, 16> lines;
+    (*buffer)->getBuffer().split(lines, '\n', -1, /*KeepEmpty=*/ false);
+
+    // Entries are only renamed into place once complete, but after a power loss, or on network file systems, the file can
+    // still be cut short. A line-based format wouldn't notice if that happened at the end of a line.
+    unsigned int count = 0;
+    if (lines.empty() || !lines.back().startswith("end:") || lines.back().drop_front(4).getAsInteger(10, count)
+        || count != lines.size() - 1) {
+        llvm::sys::fs::remove(header.cacheFilename); // Corrupt, so writeCacheFile() replaces it
+        return false;
+    }
+    lines.pop_back();
+
+    for (llvm::StringRef line : lines) {
+        llvm::StringRef lineStr, columnStr, message;
+        std::tie(lineStr, message) = line.split(':');
+        std::tie(columnStr, message) = message.split(':');
+
+        CachedWarning warning;
+        if (lineStr.getAsInteger(10, warning.line) || columnStr.getAsInteger(10, warning.column) || message.empty()) {
+            header.warnings.clear();
+            llvm::sys::fs::remove(header.cacheFilename); // Corrupt, so writeCacheFile() replaces it
+            return false;
+        }
+
+        warning.message = message.str();
+        header.warnings.push_back(std::move(warning));
+    }
+
+    if (s_inMemory) {
+        std::lock_guard<std::mutex> lock(s_inMemoryMutex);
+        inMemoryEntries().insert({ header.key, header.warnings });
+    }
+
+    return true;
+}
+
+void HeaderCache::writeCacheFile(const Header &header) const
+{
+    if (s_inMemory) {
+        // Translation units analyzing the header at the same time produce the same warnings, keep the first ones
+        std::lock_guard<std::mutex> lock(s_inMemoryMutex);
+        inMemoryEntries().insert({ header.key, header.warnings });
+    }
+
+    if (header.cacheFilename.empty())
+        return;
+
+    // With make -j, the compiler processes which missed the entry at the same time all get here. The entry is the same
+    // for all of them, as it's addressed by the contents, so only the first one needs to write it.
+    if (llvm::sys::fs::exists(header.cacheFilename))
+        return;
+
+    // Write to a temporary first, so concurrent clazy processes never read a partial file
+    int fd = -1;
+    llvm::SmallString<128> tmpFilename;
+    if (llvm::sys::fs::createUniqueFile(header.cacheFilename + "-%%%%%%", fd, tmpFilename))
+        return;
+
+    llvm::raw_fd_ostream os(fd, /*shouldClose=*/ true);
+    for (const CachedWarning &warning : header.warnings)
+        os << warning.line << ':' << warning.column << ':' << warning.message << '\n';
+    os << "end:" << header.warnings.size() << '\n';
+    os.close();
+
+    // Renaming over an entry another process just wrote is fine, readers keep the file they opened
+    if (os.has_error()) {
+        os.clear_error(); // Or its destructor aborts
+        llvm::sys::fs::remove(tmpFilename);
+    } else if (llvm::sys::fs::rename(tmpFilename, header.cacheFilename)) {
+        llvm::sys::fs::remove(tmpFilename);
+    }
+}
+
+void HeaderCache::replay(const Header &header) const
+{
+    DiagnosticsEngine &engine = m_pp.getDiagnostics();
+    const bool warningsAsErrors = engine.getWarningsAsErrors() && getenv("CLAZY_NO_WERROR") == nullptr;
+    const auto severity = warningsAsErrors ? DiagnosticIDs::Error : DiagnosticIDs::Warning;
+
+    for (const CachedWarning &warning : header.warnings) {
+        const SourceLocation loc = m_sm.translateLineCol(header.fileId, warning.line, warning.column);
+        const unsigned id = engine.getDiagnosticIDs()->getCustomDiagID(severity, warning.message);
+        engine.Report(loc, id);
+    }
+}
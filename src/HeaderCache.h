@@ -0,0 +1,156 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#ifndef CLAZY_HEADER_CACHE_H
+#define CLAZY_HEADER_CACHE_H
+
+#include <clang/Basic/SourceLocation.h>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace clang {
+class Preprocessor;
+class FileEntry;
+class IdentifierInfo;
+class SourceManager;
+}
+
+class PreprocessorDispatcher;
+
+/**
+ * Persistent cache of the warnings emitted for project headers, shared by all translation units. It's a cache of warnings,
+ * not of the analysis: only the cache_safe checks skip the cached headers, the others still visit them.
+ *
+ * Each header is keyed by a hash of its contents, the macros defined when it was included, the headers it includes
+ * in turn, and the clazy configuration (enabled checks, options and command line macros). The first translation unit
+ * including a header records its warnings, which are written to disk at the end. Later translation units replay them.
+ *
+ * Checks still visit cached headers, as they can gather state there which their warnings in other files depend on, like
+ * the Q_DECLARE_TYPEINFO of missing-typeinfo. Only the warnings found again in a cached header aren't emitted twice.
+ * Warnings emitted while visiting a template instantiation, or outside of a visit, like from preprocessor callbacks or at
+ * the end of the translation unit, can depend on the rest of the translation unit: they're neither cached nor suppressed.
+ * The checks marked cache_safe in checks.json don't visit the other nodes of cached headers at all. They're the only
+ * ones the cache saves time for.
+ *
+ * The directory is safe to share between concurrent compiler processes, like the plugin under make -j or ninja, without
+ * a daemon or locks: entries are content-addressed, written to a unique temporary and renamed into place, so readers
+ * only ever see complete ones. Processes missing the same entry at the same time analyze the header and race to write
+ * identical contents.
+ *
+ * Enabled by setting CLAZY_HEADER_CACHE_DIR. clazy-standalone can also keep the entries in memory, see setInMemory().
+ */
+class HeaderCache
+{
+public:
+    /**
+     * cacheDir can be empty, if the cache is in memory only. Follows the preprocessor through dispatcher, so must be
+     * created before the translation unit is parsed.
+     */
+    HeaderCache(const clang::Preprocessor &pp, PreprocessorDispatcher *dispatcher, const std::string &cacheDir);
+    ~HeaderCache();
+
+    /**
+     * For clazy-standalone -in-memory-header-cache: the entries are also kept in memory, shared by the translation
+     * units the process analyzes, including those on other threads. Then a cache directory isn't needed.
+     * Must be called before the first HeaderCache is created.
+     */
+    static void setInMemory(bool inMemory);
+    static bool isInMemory();
+
+    /**
+     * Adds a string that must match for cached results to be reused, for example a check name.
+     * Must be called before load().
+     */
+    void addToConfiguration(const std::string &str);
+
+    /**
+     * Looks up the headers the translation unit included and emits the warnings of those which were in the cache.
+     * Must be called once the translation unit is parsed, before the AST is traversed.
+     */
+    void load();
+
+    /**
+     * Returns true if loc is inside a header whose warnings came from the cache, so its cacheable warnings were
+     * already emitted.
+     */
+    bool isCached(clang::SourceLocation loc);
+
+    /**
+     * Records a cacheable warning, so it gets written to the cache, if it's inside a header.
+     */
+    void recordWarning(clang::SourceLocation loc, const std::string &message);
+
+    /**
+     * Returns how many of the headers seen so far had their warnings in the cache, and how many didn't.
+     */
+    size_t numHits() const;
+    size_t numMisses() const;
+
+private:
+    class Callbacks;
+
+    struct CachedWarning {
+        unsigned int line;
+        unsigned int column;
+        std::string message;
+    };
+
+    struct Header {
+        bool cached = false;
+        std::string key; // The header's basename and hash
+        std::string cacheFilename; // Empty without a cache directory
+        clang::FileID fileId;
+        std::vector<CachedWarning> warnings;
+    };
+
+    Header *headerForLoc(clang::SourceLocation loc);
+    bool isCacheable(clang::FileID fid) const;
+    std::string fileHash(clang::FileID fid, const clang::FileEntry *entry) const;
+    void createHeader(clang::FileID fid, const clang::FileEntry *entry, const std::string &contentsHash,
+                      uint64_t macroState, const std::string &includedHashes);
+    bool readCacheFile(Header &header);
+    void writeCacheFile(const Header &header) const;
+    void replay(const Header &header) const;
+    static std::unordered_map<std::string, std::vector<CachedWarning>> &inMemoryEntries(); // By Header::key
+
+    // Called by Callbacks while the translation unit is preprocessed
+    void setMacroHash(const clang::IdentifierInfo *macro, uint64_t hash);
+    void enterFile(clang::FileID fid);
+
+    const clang::Preprocessor &m_pp;
+    clang::SourceManager &m_sm;
+    const std::string m_cacheDir;
+    std::string m_configuration;
+    std::unordered_map<const clang::FileEntry *, Header> m_headers;
+    std::unordered_map<unsigned int, Header *> m_headersByFileId; // nullptr for files which aren't cacheable
+    clang::FileID m_lastFileId;
+    Header *m_lastHeader = nullptr;
+
+    std::vector<clang::FileID> m_enteredFiles; // In the order they were included
+    std::unordered_map<unsigned int, uint64_t> m_macroStates; // By FileID, m_macroState when it was entered
+    std::unordered_map<const clang::IdentifierInfo *, uint64_t> m_macroHashes; // Of the name and definition, 0 if undefined
+    uint64_t m_macroState = 0; // Xor of m_macroHashes, so undefining a macro restores the previous state
+};
+
+#endif
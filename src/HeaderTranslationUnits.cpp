@@ -0,0 +1,197 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "HeaderTranslationUnits.h"
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/Regex.h>
+
+#include <algorithm>
+#include <memory>
+#include <system_error>
+
+using namespace clang::tooling;
+using namespace std;
+
+static string absolutePath(llvm::StringRef path, llvm::StringRef directory = {})
+{
+    llvm::SmallString<256> result(path);
+    if (directory.empty())
+        llvm::sys::fs::make_absolute(result);
+    else
+        llvm::sys::fs::make_absolute(directory, result);
+    llvm::sys::path::remove_dots(result, /*remove_dot_dot=*/ true);
+    return result.str().str();
+}
+
+// Returns the number of leading characters of a and b that are the same, up to the last common separator
+static size_t commonDirectoryLength(llvm::StringRef a, llvm::StringRef b)
+{
+    size_t length = 0;
+    for (size_t i = 0; i < a.size() && i < b.size() && a[i] == b[i]; ++i) {
+        if (llvm::sys::path::is_separator(a[i]))
+            length = i + 1;
+    }
+
+    return length;
+}
+
+static bool isHeader(llvm::StringRef filename)
+{
+    const llvm::StringRef extension = llvm::sys::path::extension(filename);
+    return extension == ".h" || extension == ".hh" || extension == ".hpp" || extension == ".hxx" || extension == ".h++";
+}
+
+HeaderTranslationUnits::HeaderTranslationUnits(const CompilationDatabase &compilations,
+                                               const vector<string> &sources, const vector<string> &headers)
+    : m_compilations(compilations)
+{
+    if (sources.empty())
+        return;
+
+    vector<string> absoluteSources;
+    unordered_map<string, vector<size_t>> sourcesByDirectory;
+    absoluteSources.reserve(sources.size());
+    for (size_t i = 0; i < sources.size(); ++i) {
+        absoluteSources.push_back(absolutePath(sources[i]));
+        sourcesByDirectory[llvm::sys::path::parent_path(absoluteSources.back()).str()].push_back(i);
+    }
+
+    m_paths.reserve(headers.size());
+    for (const string &header : headers) {
+        const llvm::StringRef directory = llvm::sys::path::parent_path(header);
+        const llvm::StringRef stem = llvm::sys::path::stem(header);
+
+        size_t source = 0;
+        auto it = sourcesByDirectory.find(directory.str());
+        if (it != sourcesByDirectory.end()) {
+            source = it->second.front();
+            for (size_t candidate : it->second) {
+                if (llvm::sys::path::stem(absoluteSources[candidate]) == stem) {
+                    source = candidate;
+                    break;
+                }
+            }
+        } else {
+            size_t longest = 0;
+            for (size_t i = 0; i < absoluteSources.size(); ++i) {
+                const size_t length = commonDirectoryLength(header, absoluteSources[i]);
+                if (length > longest) {
+                    longest = length;
+                    source = i;
+                }
+            }
+        }
+
+        string path = pathFor(header);
+        m_units[path] = { header, sources[source] };
+        m_paths.push_back(std::move(path));
+    }
+}
+
+vector<string> HeaderTranslationUnits::findHeaders(const vector<string> &sources,
+                                                   const string &headerFilter, const string &ignoreDirs)
+{
+    vector<string> headers;
+    if (sources.empty())
+        return headers;
+
+    string root = llvm::sys::path::parent_path(absolutePath(sources.front())).str();
+    for (const string &source : sources) {
+        const string path = absolutePath(source);
+        root.resize(std::min(root.size(), commonDirectoryLength(root + '/', path)));
+    }
+
+    if (llvm::sys::path::relative_path(root).empty())
+        return headers; // Nothing in common, we won't scan the whole file system
+
+    std::unique_ptr<llvm::Regex> headerFilterRegex(headerFilter.empty() ? nullptr : new llvm::Regex(headerFilter));
+    std::unique_ptr<llvm::Regex> ignoreDirsRegex(ignoreDirs.empty() ? nullptr : new llvm::Regex(ignoreDirs));
+
+    std::error_code ec;
+    for (llvm::sys::fs::recursive_directory_iterator it(root, ec), end; it != end && !ec; it.increment(ec)) {
+        const string &path = it->path();
+        if (llvm::sys::path::filename(path).startswith(".")) {
+            it.no_push(); // .git and such
+            continue;
+        }
+
+        if (!isHeader(path) || !llvm::sys::fs::is_regular_file(path))
+            continue;
+
+        if ((headerFilterRegex && !headerFilterRegex->match(path)) || (ignoreDirsRegex && ignoreDirsRegex->match(path)))
+            continue;
+
+        headers.push_back(path);
+    }
+
+    std::sort(headers.begin(), headers.end());
+    return headers;
+}
+
+string HeaderTranslationUnits::headerFor(llvm::StringRef filename) const
+{
+    auto it = m_units.find(filename.str());
+    return it == m_units.end() ? string() : it->second.header;
+}
+
+string HeaderTranslationUnits::pathFor(llvm::StringRef header)
+{
+    return header.str() + ".clazy.cpp";
+}
+
+string HeaderTranslationUnits::contentsFor(llvm::StringRef header)
+{
+    return "#include \"" + header.str() + "\"\n";
+}
+
+void HeaderTranslationUnits::replaceInputFile(CompileCommand &command, llvm::StringRef file, const string &replacement)
+{
+    const string absoluteFile = absolutePath(file, command.Directory);
+    bool replaced = false;
+    for (string &arg : command.CommandLine) {
+        if (arg == command.Filename || arg == file
+            || (!llvm::StringRef(arg).startswith("-") && absolutePath(arg, command.Directory) == absoluteFile)) {
+            arg = replacement;
+            replaced = true;
+        }
+    }
+
+    if (!replaced)
+        command.CommandLine.push_back(replacement);
+    command.Filename = replacement;
+}
+
+vector<CompileCommand> HeaderTranslationUnits::getCompileCommands(llvm::StringRef filename) const
+{
+    auto it = m_units.find(filename.str());
+    if (it == m_units.end())
+        return m_compilations.getCompileCommands(filename);
+
+    vector<CompileCommand> commands = m_compilations.getCompileCommands(it->second.source);
+    for (CompileCommand &command : commands)
+        replaceInputFile(command, it->second.source, it->first);
+
+    return commands;
+}
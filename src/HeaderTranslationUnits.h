@@ -0,0 +1,91 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_HEADER_TRANSLATION_UNITS_H
+#define CLAZY_HEADER_TRANSLATION_UNITS_H
+
+#include <clang/Tooling/CompilationDatabase.h>
+#include <llvm/ADT/StringRef.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * The synthetic translation units of clazy-standalone -analyze-headers, one per project header, which only
+ * include it. So each header is analyzed once, instead of once per translation unit including it.
+ *
+ * A synthetic translation unit borrows the compile command of a source file: the one in the same directory
+ * with the same base name, otherwise any in the same directory, otherwise the one sharing the longest path.
+ * The files of the wrapped database keep their own compile commands.
+ */
+class HeaderTranslationUnits
+    : public clang::tooling::CompilationDatabase
+{
+public:
+    HeaderTranslationUnits(const clang::tooling::CompilationDatabase &compilations,
+                           const std::vector<std::string> &sources, const std::vector<std::string> &headers);
+
+    /**
+     * Returns the headers below the deepest directory containing all sources, skipping hidden directories,
+     * whose absolute path matches headerFilter and doesn't match ignoreDirs. Empty regular expressions don't filter.
+     */
+    static std::vector<std::string> findHeaders(const std::vector<std::string> &sources,
+                                                const std::string &headerFilter, const std::string &ignoreDirs);
+
+    /**
+     * Returns the header included by the synthetic translation unit filename, or an empty string if it isn't one.
+     */
+    std::string headerFor(llvm::StringRef filename) const;
+
+    /**
+     * Returns the path of the synthetic translation unit of header.
+     */
+    static std::string pathFor(llvm::StringRef header);
+
+    /**
+     * Returns the contents of the synthetic translation unit of header, which doesn't exist on disk.
+     */
+    static std::string contentsFor(llvm::StringRef header);
+
+    /**
+     * Replaces the arguments of command naming file, its input file, with replacement.
+     * Appends replacement if none does.
+     */
+    static void replaceInputFile(clang::tooling::CompileCommand &command, llvm::StringRef file, const std::string &replacement);
+
+    // The paths of the synthetic translation units
+    std::vector<std::string> getAllFiles() const override { return m_paths; }
+    std::vector<clang::tooling::CompileCommand> getCompileCommands(llvm::StringRef filename) const override;
+
+private:
+    struct Unit {
+        std::string header;
+        std::string source; // Whose compile command is borrowed
+    };
+
+    const clang::tooling::CompilationDatabase &m_compilations;
+    std::unordered_map<std::string, Unit> m_units; // By path
+    std::vector<std::string> m_paths;
+};
+
+#endif
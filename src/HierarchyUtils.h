@@ -35,6 +35,8 @@
 #include <clang/AST/ExprCXX.h>
 #include <clang/AST/ParentMap.h>
 
+class ClazyContext;
+
 namespace clazy {
 
 enum IgnoreStmt {
@@ -160,6 +162,29 @@ T* getFirstParentOfType(clang::ParentMap *pmap, clang::Stmt *s, unsigned int dep
     return getFirstParentOfType<T>(pmap, parent(pmap, s), depth);
 }
 
+/**
+ * Like parent(ParentMap*, ...), but constant time for the statement being visited, as its ancestors are
+ * on ClazyContext::traversalStack. Other statements are looked up in the ParentMap, which is only built
+ * for checks with "needs_parent_map", otherwise nullptr is returned.
+ */
+clang::Stmt *parent(const ClazyContext *context, clang::Stmt *s, unsigned int depth = 1);
+
+// Returns the first parent of type T, with max depth depth, see parent(const ClazyContext *, ...)
+template <typename T>
+T* getFirstParentOfType(const ClazyContext *context, clang::Stmt *s, unsigned int depth = -1)
+{
+    for (; s; s = parent(context, s)) {
+        if (auto t = clang::dyn_cast<T>(s))
+            return t;
+
+        if (depth == 0)
+            return nullptr;
+        --depth;
+    }
+
+    return nullptr;
+}
+
 inline clang::Stmt *getFirstChild(clang::Stmt *parent)
 {
     if (!parent)
@@ -0,0 +1,154 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "JsonlExporter.h"
+#include "StringUtils.h"
+
+#include <clang/Basic/Diagnostic.h>
+#include <clang/Basic/LangOptions.h>
+#include <clang/Basic/SourceManager.h>
+#include <clang/Tooling/Core/Replacement.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <cstring>
+#include <system_error>
+
+using namespace clang;
+using namespace std;
+
+JsonlExporter::JsonlExporter(const SourceManager &sm, const LangOptions &lo, const string &filename)
+    : m_sm(sm)
+    , m_lo(lo)
+{
+    error_code ec;
+#if LLVM_VERSION_MAJOR >= 9
+    const auto flags = llvm::sys::fs::OF_Append;
+#else
+    const auto flags = llvm::sys::fs::F_Append;
+#endif
+    m_stream.reset(new llvm::raw_fd_ostream(filename, ec, flags));
+    if (ec) {
+        llvm::errs() << "clazy: Failed to open " << filename << ": " << ec.message() << "\n";
+        m_stream.reset();
+        return;
+    }
+
+    m_stream->SetUnbuffered(); // We write whole lines at once
+}
+
+JsonlExporter::~JsonlExporter() = default;
+
+void JsonlExporter::write(SourceLocation loc, llvm::StringRef checkName, llvm::StringRef message,
+                          const vector<FixItHint> &fixits)
+{
+    if (m_stream)
+        *m_stream << formatLine(m_sm, m_lo, loc, checkName, message, fixits);
+}
+
+string JsonlExporter::formatLine(const SourceManager &sm, const LangOptions &lo, SourceLocation loc,
+                                 llvm::StringRef checkName, llvm::StringRef message, llvm::ArrayRef<FixItHint> fixits)
+{
+    const SourceLocation expansionLoc = sm.getExpansionLoc(loc);
+    string line = "{\"file\":";
+    clazy::appendJsonString(line, sm.getFilename(expansionLoc));
+    line += ",\"line\":" + to_string(sm.getExpansionLineNumber(loc));
+    line += ",\"column\":" + to_string(sm.getExpansionColumnNumber(loc));
+    line += ",\"check\":";
+    clazy::appendJsonString(line, checkName);
+    line += ",\"message\":";
+    clazy::appendJsonString(line, message);
+    line += ",\"fixits\":[";
+    bool first = true;
+    for (const FixItHint &fixit : fixits) {
+        if (fixit.isNull())
+            continue;
+
+        const tooling::Replacement replacement(sm, fixit.RemoveRange, fixit.CodeToInsert, lo);
+        line += first ? "{\"file\":" : ",{\"file\":";
+        clazy::appendJsonString(line, replacement.getFilePath());
+        line += ",\"offset\":" + to_string(replacement.getOffset());
+        line += ",\"length\":" + to_string(replacement.getLength());
+        line += ",\"text\":";
+        clazy::appendJsonString(line, replacement.getReplacementText());
+        line += '}';
+        first = false;
+    }
+    line += "]}\n";
+
+    return line;
+}
+
+JsonlDiagnosticConsumer::JsonlDiagnosticConsumer(string &output)
+    : m_output(output)
+{
+}
+
+void JsonlDiagnosticConsumer::BeginSourceFile(const LangOptions &lo, const Preprocessor *)
+{
+    m_lo = &lo;
+}
+
+void JsonlDiagnosticConsumer::HandleDiagnostic(DiagnosticsEngine::Level level, const Diagnostic &info)
+{
+    DiagnosticConsumer::HandleDiagnostic(level, info); // Counts the errors and warnings
+
+    llvm::SmallString<256> formatted;
+    info.FormatDiagnostic(formatted);
+    llvm::StringRef message = formatted;
+
+    // Our warnings end with " [-Wclazy-<check>]"
+    string checkName;
+    const size_t tagStart = message.rfind(" [-Wclazy-");
+    if (tagStart != llvm::StringRef::npos && message.endswith("]")) {
+        checkName = message.slice(tagStart + strlen(" [-Wclazy-"), message.size() - 1).str();
+        message = message.take_front(tagStart);
+    } else {
+        switch (level) {
+        case DiagnosticsEngine::Note:
+            checkName = "clang-diagnostic-note";
+            break;
+        case DiagnosticsEngine::Error:
+        case DiagnosticsEngine::Fatal:
+            checkName = "clang-diagnostic-error";
+            break;
+        default:
+            checkName = "clang-diagnostic-warning";
+            break;
+        }
+    }
+
+    if (info.hasSourceManager() && info.getLocation().isValid() && m_lo) {
+        m_output += JsonlExporter::formatLine(info.getSourceManager(), *m_lo, info.getLocation(), checkName, message, info.getFixItHints());
+        return;
+    }
+
+    // Not in a file, like errors about the command line
+    string line = "{\"file\":\"\",\"line\":0,\"column\":0,\"check\":";
+    clazy::appendJsonString(line, checkName);
+    line += ",\"message\":";
+    clazy::appendJsonString(line, message);
+    line += ",\"fixits\":[]}\n";
+    m_output += line;
+}
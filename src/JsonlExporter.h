@@ -0,0 +1,94 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_JSONL_EXPORTER_H
+#define CLAZY_JSONL_EXPORTER_H
+
+#include <clang/Basic/Diagnostic.h>
+#include <clang/Basic/SourceLocation.h>
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/StringRef.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace clang {
+class FixItHint;
+class LangOptions;
+class Preprocessor;
+class SourceManager;
+}
+
+namespace llvm {
+class raw_fd_ostream;
+}
+
+/**
+ * Appends each warning as a line of JSON to a file, for tools collecting results from many builds.
+ * For example:
+ * {"file":"foo.cpp","line":10,"column":5,"check":"qdeleteall","message":"...","fixits":[{"file":"foo.cpp","offset":120,"length":3,"text":"..."}]}
+ *
+ * Each line is written with a single write() to a file opened for appending, so several clazy processes can share it,
+ * and it can be read while the build is still running.
+ *
+ * Enabled by setting CLAZY_EXPORT_JSONL to the file name.
+ */
+class JsonlExporter
+{
+public:
+    JsonlExporter(const clang::SourceManager &sm, const clang::LangOptions &lo, const std::string &filename);
+    ~JsonlExporter();
+
+    void write(clang::SourceLocation loc, llvm::StringRef checkName, llvm::StringRef message,
+               const std::vector<clang::FixItHint> &fixits);
+
+    /**
+     * Returns the JSON line for a warning, including the trailing newline.
+     */
+    static std::string formatLine(const clang::SourceManager &sm, const clang::LangOptions &lo, clang::SourceLocation loc,
+                                  llvm::StringRef checkName, llvm::StringRef message, llvm::ArrayRef<clang::FixItHint> fixits);
+
+private:
+    const clang::SourceManager &m_sm;
+    const clang::LangOptions &m_lo;
+    std::unique_ptr<llvm::raw_fd_ostream> m_stream;
+};
+
+/**
+ * Writes every diagnostic of the translation unit in the same format, including clang's own, which get
+ * "clang-diagnostic-<level>" as check name. Used by clazy-standalone's -worker, to send back the results.
+ */
+class JsonlDiagnosticConsumer : public clang::DiagnosticConsumer
+{
+public:
+    explicit JsonlDiagnosticConsumer(std::string &output);
+
+    void BeginSourceFile(const clang::LangOptions &lo, const clang::Preprocessor *pp) override;
+    void HandleDiagnostic(clang::DiagnosticsEngine::Level level, const clang::Diagnostic &info) override;
+
+private:
+    std::string &m_output;
+    const clang::LangOptions *m_lo = nullptr;
+};
+
+#endif
@@ -0,0 +1,177 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "LineFilter.h"
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/Casting.h>
+#include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/YAMLParser.h>
+
+using namespace std;
+
+static void storeFirstError(const llvm::SMDiagnostic &diag, void *context)
+{
+    auto error = static_cast<string *>(context);
+    if (error->empty())
+        *error = diag.getMessage().str();
+}
+
+static bool parseLineNumber(llvm::yaml::Node *node, unsigned int &line)
+{
+    auto scalar = llvm::dyn_cast_or_null<llvm::yaml::ScalarNode>(node);
+    if (!scalar)
+        return false;
+
+    llvm::SmallString<16> storage;
+    return !scalar->getValue(storage).getAsInteger(10, line) && line > 0;
+}
+
+static bool parseLineRange(llvm::yaml::Node *node, LineFilter::LineRange &range)
+{
+    auto sequence = llvm::dyn_cast_or_null<llvm::yaml::SequenceNode>(node);
+    if (!sequence)
+        return false;
+
+    vector<unsigned int> lines;
+    for (llvm::yaml::Node &lineNode : *sequence) {
+        unsigned int line = 0;
+        if (!parseLineNumber(&lineNode, line))
+            return false;
+        lines.push_back(line);
+    }
+
+    if (lines.size() != 2 || lines[0] > lines[1])
+        return false;
+
+    range = { lines[0], lines[1] };
+    return true;
+}
+
+static bool parseFile(llvm::yaml::Node *node, LineFilter::File &file, string &error)
+{
+    auto mapping = llvm::dyn_cast_or_null<llvm::yaml::MappingNode>(node);
+    if (!mapping) {
+        error = "expected an object with \"name\" and optional \"lines\"";
+        return false;
+    }
+
+    for (llvm::yaml::KeyValueNode &keyValue : *mapping) {
+        auto key = llvm::dyn_cast_or_null<llvm::yaml::ScalarNode>(keyValue.getKey());
+        if (!key) {
+            error = "expected a string key";
+            return false;
+        }
+
+        llvm::SmallString<16> keyStorage;
+        const llvm::StringRef keyName = key->getValue(keyStorage);
+        if (keyName == "name") {
+            auto value = llvm::dyn_cast_or_null<llvm::yaml::ScalarNode>(keyValue.getValue());
+            llvm::SmallString<128> valueStorage;
+            if (value)
+                file.name = value->getValue(valueStorage).str();
+        } else if (keyName == "lines") {
+            auto ranges = llvm::dyn_cast_or_null<llvm::yaml::SequenceNode>(keyValue.getValue());
+            if (!ranges) {
+                error = "\"lines\" must be an array of [first, last] pairs";
+                return false;
+            }
+
+            for (llvm::yaml::Node &rangeNode : *ranges) {
+                LineFilter::LineRange range;
+                if (!parseLineRange(&rangeNode, range)) {
+                    error = "\"lines\" must be an array of [first, last] pairs";
+                    return false;
+                }
+                file.lines.push_back(range);
+            }
+        } else {
+            keyValue.skip();
+        }
+    }
+
+    if (file.name.empty()) {
+        error = "missing \"name\"";
+        return false;
+    }
+
+    return true;
+}
+
+bool LineFilter::parse(llvm::StringRef json, string &error)
+{
+    m_files.clear();
+    error.clear();
+
+    // JSON is valid YAML, and unlike llvm/Support/JSON.h the YAML parser is available in every LLVM we support
+    llvm::SourceMgr sourceManager;
+    sourceManager.setDiagHandler(storeFirstError, &error);
+    llvm::yaml::Stream stream(json, sourceManager);
+
+    llvm::yaml::document_iterator document = stream.begin();
+    auto files = document == stream.end() ? nullptr
+                                          : llvm::dyn_cast_or_null<llvm::yaml::SequenceNode>(document->getRoot());
+    if (!files) {
+        if (error.empty())
+            error = "expected an array of files";
+        return false;
+    }
+
+    for (llvm::yaml::Node &fileNode : *files) {
+        File file;
+        if (!parseFile(&fileNode, file, error))
+            break;
+        m_files.push_back(std::move(file));
+    }
+
+    if (!error.empty() || stream.failed()) {
+        if (error.empty())
+            error = "invalid JSON";
+        m_files.clear();
+        return false;
+    }
+
+    return true;
+}
+
+const LineFilter::File *LineFilter::fileFor(llvm::StringRef filename) const
+{
+    for (const File &file : m_files) {
+        if (filename.endswith(file.name))
+            return &file;
+    }
+
+    return nullptr;
+}
+
+bool LineFilter::overlaps(const File &file, unsigned int first, unsigned int last)
+{
+    if (file.lines.empty())
+        return true;
+
+    for (const LineRange &range : file.lines) {
+        if (range.first <= last && first <= range.second)
+            return true;
+    }
+
+    return false;
+}
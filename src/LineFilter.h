@@ -0,0 +1,83 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_LINE_FILTER_H
+#define CLAZY_LINE_FILTER_H
+
+#include <llvm/ADT/StringRef.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Restricts the warnings to some lines of some files, for example the ones changed by a patch.
+ *
+ * Accepts the same JSON as clang-tidy's -line-filter:
+ *     [{"name":"file1.cpp","lines":[[1,3],[5,7]]},{"name":"file2.h"}]
+ *
+ * A file matches an entry if its name ends with it. A file without "lines" passes entirely,
+ * files not listed don't pass at all. An empty filter lets everything through.
+ */
+class LineFilter
+{
+public:
+    typedef std::pair<unsigned int, unsigned int> LineRange; // First and last line, inclusive
+
+    struct File {
+        std::string name;
+        std::vector<LineRange> lines; // All lines if empty
+    };
+
+    /**
+     * Replaces the filter with the one in json. Returns false and sets error if it's malformed.
+     */
+    bool parse(llvm::StringRef json, std::string &error);
+
+    /**
+     * Lets the lines of file through, like a JSON entry would.
+     */
+    void addFile(File file)
+    {
+        m_files.push_back(std::move(file));
+    }
+
+    bool isEmpty() const
+    {
+        return m_files.empty();
+    }
+
+    /**
+     * Returns the entry matching filename, or nullptr if it's not listed.
+     */
+    const File *fileFor(llvm::StringRef filename) const;
+
+    /**
+     * Returns true if any line between first and last, inclusive, passes the filter of file.
+     */
+    static bool overlaps(const File &file, unsigned int first, unsigned int last);
+
+private:
+    std::vector<File> m_files;
+};
+
+#endif
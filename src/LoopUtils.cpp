@@ -23,10 +23,16 @@
 */
 
 #include "LoopUtils.h"
+#include "ClazyContext.h"
+#include "HierarchyUtils.h"
+#include "StmtBodyRange.h"
 #include "StringUtils.h"
+#include "Utils.h"
 #include "clazy_stl.h"
 #include "SourceCompatibilityHelpers.h"
+#include "StmtIndex.h"
 
+#include <clang/AST/ASTContext.h>
 #include <clang/AST/ParentMap.h>
 #include <clang/Basic/SourceLocation.h>
 #include <clang/AST/ExprCXX.h>
@@ -36,6 +42,8 @@
 #include <clang/Basic/LLVM.h>
 #include <llvm/ADT/StringRef.h>
 
+#include <algorithm>
+
 namespace clang {
 class CXXConstructorDecl;
 }  // namespace clang
@@ -87,6 +95,26 @@ bool clazy::loopCanBeInterrupted(clang::Stmt *stmt, const clang::SourceManager &
     });
 }
 
+bool clazy::loopCanBeInterrupted(const StmtIndex *index, clang::Stmt *stmt, const clang::SourceManager &sm,
+                                 clang::SourceLocation onlyBeforeThisLoc)
+{
+    if (!index || !index->contains(stmt))
+        return loopCanBeInterrupted(stmt, sm, onlyBeforeThisLoc);
+
+    auto isBefore = [&sm, onlyBeforeThisLoc](Stmt *s) {
+        if (onlyBeforeThisLoc.isInvalid())
+            return true;
+
+        FullSourceLoc sourceLoc(clazy::getLocStart(s), sm);
+        FullSourceLoc otherSourceLoc(onlyBeforeThisLoc, sm);
+        return sourceLoc.isBeforeInTranslationUnitThan(otherSourceLoc);
+    };
+
+    return clazy::any_of(index->statementsOfType<ReturnStmt>(stmt), isBefore)
+        || clazy::any_of(index->statementsOfType<BreakStmt>(stmt), isBefore)
+        || clazy::any_of(index->statementsOfType<ContinueStmt>(stmt), isBefore);
+}
+
 clang::Expr *clazy::containerExprForLoop(Stmt *loop)
 {
     if (!loop)
@@ -124,6 +152,71 @@ VarDecl* clazy::containerDeclForLoop(clang::Stmt *loop)
     return valueDecl ? dyn_cast<VarDecl>(valueDecl) : nullptr;
 }
 
+static bool integerLiteralValue(const Expr *expr, int64_t &value)
+{
+    auto literal = expr ? dyn_cast<IntegerLiteral>(expr->IgnoreParenImpCasts()) : nullptr;
+    if (!literal || literal->getValue().getActiveBits() > 62)
+        return false;
+
+    value = static_cast<int64_t>(literal->getValue().getZExtValue());
+    return true;
+}
+
+static bool refersTo(Expr *expr, const VarDecl *varDecl)
+{
+    auto declRef = expr ? dyn_cast<DeclRefExpr>(expr->IgnoreParenImpCasts()) : nullptr;
+    return declRef && declRef->getDecl() == varDecl;
+}
+
+int64_t clazy::constantTripCount(Stmt *loop, const ASTContext &astContext)
+{
+    if (auto rangeLoop = dyn_cast<CXXForRangeStmt>(loop)) {
+        Expr *rangeInit = rangeLoop->getRangeInit() ? rangeLoop->getRangeInit()->IgnoreImplicit() : nullptr;
+        if (!rangeInit)
+            return -1;
+
+        if (auto initList = dyn_cast<CXXStdInitializerListExpr>(rangeInit))
+            rangeInit = initList->getSubExpr()->IgnoreImplicit();
+
+        if (auto initList = dyn_cast<InitListExpr>(rangeInit))
+            return initList->getNumInits();
+
+        const ConstantArrayType *arrayType = astContext.getAsConstantArrayType(rangeInit->getType());
+        return arrayType ? static_cast<int64_t>(arrayType->getSize().getZExtValue()) : -1;
+    }
+
+    auto forStmt = dyn_cast<ForStmt>(loop);
+    auto declStmt = forStmt ? dyn_cast_or_null<DeclStmt>(forStmt->getInit()) : nullptr;
+    auto var = declStmt && declStmt->isSingleDecl() ? dyn_cast<VarDecl>(declStmt->getSingleDecl()) : nullptr;
+    int64_t start = 0;
+    if (!var || !integerLiteralValue(var->getInit(), start))
+        return -1;
+
+    auto cond = dyn_cast_or_null<BinaryOperator>(forStmt->getCond());
+    auto inc = dyn_cast_or_null<UnaryOperator>(forStmt->getInc());
+    int64_t end = 0;
+    if (!cond || !inc || !refersTo(cond->getLHS(), var) || !refersTo(inc->getSubExpr(), var)
+        || !integerLiteralValue(cond->getRHS(), end))
+        return -1;
+
+    // With != the loop only ends if it starts on the right side
+    const int64_t distance = inc->isIncrementOp() ? end - start : start - end;
+    switch (cond->getOpcode()) {
+    case BO_NE:
+        return distance >= 0 ? distance : -1;
+    case BO_LT:
+        return inc->isIncrementOp() ? std::max<int64_t>(distance, 0) : -1;
+    case BO_LE:
+        return inc->isIncrementOp() ? std::max<int64_t>(distance + 1, 0) : -1;
+    case BO_GT:
+        return inc->isDecrementOp() ? std::max<int64_t>(distance, 0) : -1;
+    case BO_GE:
+        return inc->isDecrementOp() ? std::max<int64_t>(distance + 1, 0) : -1;
+    default:
+        return -1;
+    }
+}
+
 Stmt* clazy::isInLoop(clang::ParentMap *pmap, clang::Stmt *stmt)
 {
     if (!stmt)
@@ -138,3 +231,110 @@ Stmt* clazy::isInLoop(clang::ParentMap *pmap, clang::Stmt *stmt)
 
     return nullptr;
 }
+
+Stmt* clazy::isInLoop(const ClazyContext *context, Stmt *stmt)
+{
+    if (context->traversalStack.contains(stmt))
+        return context->traversalStack.enclosingLoop(stmt);
+
+    return context->parentMap ? isInLoop(context->parentMap, stmt) : nullptr;
+}
+
+Stmt *clazy::loopRunningOnEachIteration(const ClazyContext *context, Stmt *stmt)
+{
+    Stmt *child = stmt;
+    for (Stmt *parent = clazy::parent(context, stmt); parent; child = parent, parent = clazy::parent(context, parent)) {
+        if (isa<LambdaExpr>(parent))
+            return nullptr;
+
+        if (auto forStmt = dyn_cast<ForStmt>(parent)) {
+            if (child != forStmt->getInit())
+                return parent;
+        } else if (auto rangeLoop = dyn_cast<CXXForRangeStmt>(parent)) {
+            if (child == rangeLoop->getBody() || child == rangeLoop->getLoopVarStmt())
+                return parent;
+        } else if (isa<WhileStmt>(parent) || isa<DoStmt>(parent)) {
+            return parent;
+        }
+    }
+
+    return nullptr;
+}
+
+unsigned int clazy::loopDepth(const ClazyContext *context, Stmt *stmt)
+{
+    unsigned int depth = 0;
+    while ((stmt = loopRunningOnEachIteration(context, stmt)))
+        ++depth;
+
+    return depth;
+}
+
+static bool isIncrementedOrDecremented(Stmt *body, const VarDecl *varDecl)
+{
+    for (UnaryOperator *op : clazy::getStatements<UnaryOperator>(body)) {
+        auto declRef = op->isIncrementDecrementOp() ? dyn_cast<DeclRefExpr>(op->getSubExpr()->IgnoreParenImpCasts()) : nullptr;
+        if (declRef && declRef->getDecl() == varDecl)
+            return true;
+    }
+
+    return false;
+}
+
+bool clazy::isUnmodifiedInLoop(const ClazyContext *context, VarDecl *varDecl, Stmt *loop)
+{
+    // Variables declared inside the loop, like its counter, can have a different value on each iteration
+    if (context->sm.isBeforeInTranslationUnit(clazy::getLocStart(loop), clazy::getLocStart(varDecl)))
+        return false;
+
+    if (varDecl->getType().isConstQualified())
+        return true;
+
+    if (varDecl->hasGlobalStorage())
+        return false;
+
+    return !Utils::containsNonConstMemberCall(context->parentMap, loop, varDecl)
+           && !Utils::isPassedToFunction(StmtBodyRange(loop, nullptr, {}, context->functionStmtIndex(loop)), varDecl, true)
+           && !isIncrementedOrDecremented(loop, varDecl);
+}
+
+bool clazy::isLoopInvariant(const ClazyContext *context, Stmt *stmt, Stmt *loop)
+{
+    if (!stmt)
+        return true;
+
+    // QStringLiteral builds its string inside a lambda without captures
+    if (auto lambda = dyn_cast<LambdaExpr>(stmt))
+        return lambda->capture_size() == 0;
+
+    if (auto declRef = dyn_cast<DeclRefExpr>(stmt)) {
+        ValueDecl *decl = declRef->getDecl();
+        if (auto varDecl = dyn_cast<VarDecl>(decl))
+            return isUnmodifiedInLoop(context, varDecl, loop);
+        return isa<EnumConstantDecl>(decl) || isa<FunctionDecl>(decl);
+    }
+
+    // Members can be changed by any function called in the loop, methods are checked with their call below
+    if (auto memberExpr = dyn_cast<MemberExpr>(stmt))
+        return isa<CXXMethodDecl>(memberExpr->getMemberDecl()) && isLoopInvariant(context, memberExpr->getBase(), loop);
+
+    if (isa<CXXThisExpr>(stmt))
+        return false;
+
+    if (auto binaryOp = dyn_cast<BinaryOperator>(stmt)) {
+        if (binaryOp->isAssignmentOp())
+            return false;
+    } else if (auto unaryOp = dyn_cast<UnaryOperator>(stmt)) {
+        if (unaryOp->isIncrementDecrementOp())
+            return false;
+    } else if (auto call = dyn_cast<CallExpr>(stmt)) {
+        // Non-const methods can change the result, and functions without arguments, like QDateTime::currentDateTime(),
+        // are likely to return something new
+        auto method = dyn_cast_or_null<CXXMethodDecl>(call->getDirectCallee());
+        const bool isInstanceMethod = method && !method->isStatic();
+        if (!call->getDirectCallee() || (isInstanceMethod && !method->isConst()) || (!isInstanceMethod && call->getNumArgs() == 0))
+            return false;
+    }
+
+    return clazy::all_of(stmt->children(), [context, loop](Stmt *child) { return isLoopInvariant(context, child, loop); });
+}
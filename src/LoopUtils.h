@@ -31,7 +31,10 @@
 #include <clang/AST/Stmt.h>
 #include <llvm/Support/Casting.h>
 
+#include <cstdint>
+
 namespace clang {
+class ASTContext;
 class Stmt;
 class SourceManager;
 class SourceLocation;
@@ -40,6 +43,9 @@ class ParentMap;
 class VarDecl;
 }
 
+class ClazyContext;
+class StmtIndex;
+
 namespace clazy {
 /**
  * Returns the body of a for, range-foor, while or do-while loop
@@ -54,6 +60,21 @@ clang::Stmt *bodyFromLoop(clang::Stmt *);
 bool loopCanBeInterrupted(clang::Stmt *loop, const clang::SourceManager &sm,
                           clang::SourceLocation onlyBeforeThisLoc);
 
+/**
+ * Overload which searches index instead of walking loop, if loop is in it.
+ */
+bool loopCanBeInterrupted(const StmtIndex *index, clang::Stmt *loop, const clang::SourceManager &sm,
+                          clang::SourceLocation onlyBeforeThisLoc);
+
+/**
+ * Returns the number of iterations of loop if it's a compile-time constant, -1 otherwise.
+ *
+ * Supports for (int i = 0; i < 3; ++i), counting up or down with <, <=, >, >= or !=, and range-loops over an
+ * initializer list or an array of constant size. It's an upper bound, break and return statements aren't
+ * looked at, nor assignments to the loop variable inside the body.
+ */
+int64_t constantTripCount(clang::Stmt *loop, const clang::ASTContext &astContext);
+
 /**
  * Returns true if stmt is a for, while or do-while loop
  */
@@ -82,6 +103,37 @@ clang::VarDecl* containerDeclForLoop(clang::Stmt *loop);
  * If yes, returns the loop statement, otherwise nullptr.
  */
 clang::Stmt* isInLoop(clang::ParentMap *pmap, clang::Stmt *stmt);
+
+/**
+ * Overload which asks ClazyContext::traversalStack if stmt is being visited, or one of its ancestors,
+ * and the ParentMap otherwise, if there's one.
+ */
+clang::Stmt* isInLoop(const ClazyContext *context, clang::Stmt *stmt);
+
+/**
+ * Returns the innermost loop which runs stmt on each of its iterations, or nullptr.
+ * The init statement of a for loop and the range of a range-loop only run once, so don't count. Stops at lambdas,
+ * as a lambda defined inside a loop doesn't run there.
+ */
+clang::Stmt *loopRunningOnEachIteration(const ClazyContext *context, clang::Stmt *stmt);
+
+/**
+ * Returns how many loops run stmt on each of their iterations, as found by loopRunningOnEachIteration().
+ */
+unsigned int loopDepth(const ClazyContext *context, clang::Stmt *stmt);
+
+/**
+ * Returns true if varDecl is a local variable declared before loop, which loop doesn't modify.
+ * Non-const globals and static locals can be modified by any function called in the loop, so never are.
+ */
+bool isUnmodifiedInLoop(const ClazyContext *context, clang::VarDecl *varDecl, clang::Stmt *loop);
+
+/**
+ * Returns true if stmt has the same value on every iteration of loop: literals, QStringLiteral, and variables
+ * unmodified by the loop, possibly passed through const methods or functions taking arguments.
+ * Members aren't, as any function called in the loop can change them.
+ */
+bool isLoopInvariant(const ClazyContext *context, clang::Stmt *stmt, clang::Stmt *loop);
 }
 
 #endif
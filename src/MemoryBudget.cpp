@@ -0,0 +1,127 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "MemoryBudget.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+#if defined(__linux__)
+# include <unistd.h>
+#endif
+
+#if defined(__GLIBC__)
+# include <malloc.h>
+#endif
+
+using namespace std;
+
+MemoryBudget::MemoryBudget(uint64_t maxBytes, unsigned int numJobs)
+    : m_maxBytes(maxBytes)
+    , m_defaultEstimate(maxBytes / std::max(numJobs, 1u))
+    , m_baselineBytes(residentBytes())
+{
+}
+
+MemoryBudget::Reservation::Reservation(MemoryBudget *budget, uint64_t estimatedBytes)
+    : m_budget(budget)
+{
+    if (m_budget)
+        m_reservedBytes = m_budget->acquire(estimatedBytes);
+}
+
+MemoryBudget::Reservation::~Reservation()
+{
+    if (m_budget)
+        m_budget->release(m_reservedBytes, m_measuredBytes);
+}
+
+uint64_t MemoryBudget::numDelayed() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_numDelayed;
+}
+
+uint64_t MemoryBudget::residentBytes()
+{
+#if defined(__linux__)
+    FILE *file = fopen("/proc/self/statm", "r");
+    if (!file)
+        return 0;
+
+    unsigned long long totalPages = 0;
+    unsigned long long residentPages = 0;
+    const bool ok = fscanf(file, "%llu %llu", &totalPages, &residentPages) == 2;
+    fclose(file);
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    return ok && pageSize > 0 ? residentPages * pageSize : 0;
+#else
+    return 0;
+#endif
+}
+
+uint64_t MemoryBudget::acquire(uint64_t estimatedBytes)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (estimatedBytes == 0)
+        estimatedBytes = m_numMeasured > 0 ? m_measuredBytes / m_numMeasured : m_defaultEstimate;
+
+    if (m_numRunning > 0 && !fits(estimatedBytes)) {
+        m_numDelayed++;
+        // Also polled, as the resident set can shrink while others run
+        while (m_numRunning > 0 && !fits(estimatedBytes))
+            m_released.wait_for(lock, std::chrono::milliseconds(100));
+    }
+
+    m_numRunning++;
+    m_reservedBytes += estimatedBytes;
+    return estimatedBytes;
+}
+
+void MemoryBudget::release(uint64_t reservedBytes, uint64_t measuredBytes)
+{
+#if defined(__GLIBC__)
+    // The AST and the SourceManager buffers were just freed, but glibc keeps the memory for reuse. Give it back,
+    // otherwise the resident set never goes down and the next translation units would wait for nothing.
+    malloc_trim(0);
+#endif
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_numRunning--;
+        m_reservedBytes -= reservedBytes;
+        if (measuredBytes > 0) {
+            m_measuredBytes += measuredBytes;
+            m_numMeasured++;
+        }
+    }
+
+    m_released.notify_all();
+}
+
+bool MemoryBudget::fits(uint64_t bytes) const
+{
+    // The reservations count the translation units which didn't reach their peak yet, the resident set the ones above their estimate
+    const uint64_t projected = std::max(m_baselineBytes + m_reservedBytes, residentBytes()) + bytes;
+    return projected <= m_maxBytes;
+}
@@ -0,0 +1,92 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_MEMORY_BUDGET_H
+#define CLAZY_MEMORY_BUDGET_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+/**
+ * Admission control for clazy-standalone -j with -max-memory: a translation unit only starts once the memory
+ * it's expected to need fits in the budget, next to the ones already running. One always starts when nothing
+ * else runs, so a translation unit bigger than the budget is still analyzed, alone.
+ *
+ * The workers are threads of the same process, so the resident set size can't be told apart per worker. Each
+ * running translation unit reserves its estimate instead, and the process's resident set, where it can be read,
+ * catches the estimates which were too low.
+ */
+class MemoryBudget
+{
+public:
+    // Without estimates, and until some translation unit was measured, each one is expected to need maxBytes / numJobs
+    MemoryBudget(uint64_t maxBytes, unsigned int numJobs);
+
+    /**
+     * Reserves the memory of a translation unit for as long as it lives, blocking until it fits.
+     * The analysis must be destroyed first, so declare it before the ClangTool and the diagnostics consumer.
+     * Does nothing if budget is nullptr.
+     */
+    class Reservation
+    {
+    public:
+        // estimatedBytes is 0 if unknown, then the average of the ones measured so far is used
+        Reservation(MemoryBudget *budget, uint64_t estimatedBytes);
+        ~Reservation();
+
+        // What the translation unit turned out to need, for the estimates of the next ones
+        void setMeasuredBytes(uint64_t bytes) { m_measuredBytes = bytes; }
+
+        Reservation(const Reservation &) = delete;
+        Reservation& operator=(const Reservation &) = delete;
+
+    private:
+        MemoryBudget *const m_budget;
+        uint64_t m_reservedBytes = 0;
+        uint64_t m_measuredBytes = 0;
+    };
+
+    // How many translation units had to wait for memory, to tell whether the budget limits the throughput
+    uint64_t numDelayed() const;
+
+    // The resident set size of the process, 0 if unknown, like on Windows and macOS
+    static uint64_t residentBytes();
+
+private:
+    uint64_t acquire(uint64_t estimatedBytes);
+    void release(uint64_t reservedBytes, uint64_t measuredBytes);
+    bool fits(uint64_t bytes) const;
+
+    const uint64_t m_maxBytes;
+    const uint64_t m_defaultEstimate;
+    const uint64_t m_baselineBytes; // Held by the process before the first translation unit, like the compilation database
+    mutable std::mutex m_mutex;
+    std::condition_variable m_released;
+    unsigned int m_numRunning = 0;
+    uint64_t m_reservedBytes = 0;
+    uint64_t m_measuredBytes = 0; // Sum of the translation units measured so far
+    uint64_t m_numMeasured = 0;
+    uint64_t m_numDelayed = 0;
+};
+
+#endif
@@ -21,55 +21,376 @@
 */
 
 #include "MiniAstDumper.h"
+#include "AccessSpecifierManager.h"
+#include "ClazyContext.h"
+#include "QtUtils.h"
+#include "SourceCompatibilityHelpers.h"
+#include "StringUtils.h"
+#include "TemplateUtils.h"
+#include "Utils.h"
 
+#include <clang/AST/ASTContext.h>
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/DeclTemplate.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/StmtCXX.h>
+#include <clang/Basic/SourceManager.h>
 #include <clang/Frontend/CompilerInstance.h>
 #include <clang/Frontend/FrontendPluginRegistry.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/raw_ostream.h>
 
 using namespace clang;
 using namespace std;
 
+std::string clazy::functionKey(const FunctionDecl *func)
+{
+    return func->getQualifiedNameAsString() + ' ' + func->getType().getAsString();
+}
+
 MiniAstDumperASTAction::MiniAstDumperASTAction()
 {
 }
 
-bool MiniAstDumperASTAction::ParseArgs(const CompilerInstance &, const std::vector<string> &)
+bool MiniAstDumperASTAction::ParseArgs(const CompilerInstance &, const std::vector<string> &args)
 {
+    const llvm::StringRef indexDirArg = "index-dir=";
+    for (const string &arg : args) {
+        if (llvm::StringRef(arg).startswith(indexDirArg))
+            m_indexDir = arg.substr(indexDirArg.size());
+    }
+
     return true;
 }
 
-std::unique_ptr<ASTConsumer> MiniAstDumperASTAction::CreateASTConsumer(CompilerInstance &, llvm::StringRef)
+std::unique_ptr<ASTConsumer> MiniAstDumperASTAction::CreateASTConsumer(CompilerInstance &ci, llvm::StringRef)
 {
-    return std::unique_ptr<MiniASTDumperConsumer>(new MiniASTDumperConsumer());
+    return std::unique_ptr<MiniASTDumperConsumer>(new MiniASTDumperConsumer(ci, m_indexDir));
 }
 
-MiniASTDumperConsumer::MiniASTDumperConsumer()
+MiniASTDumperConsumer::MiniASTDumperConsumer(CompilerInstance &ci, const std::string &indexDir)
+    : m_ci(ci)
+    , m_indexDir(indexDir)
+    , m_context(new ClazyContext(ci, /*headerFilter=*/ "", /*ignoreDirs=*/ "", /*exportFixesFilename=*/ "",
+                                 /*translationUnitPaths=*/ {}, ClazyContext::ClazyOption_IndexOnly))
 {
+    // Before parsing, as it catches Q_SIGNALS and such in the preprocessor
+    m_context->enableAccessSpecifierManager();
 }
 
 MiniASTDumperConsumer::~MiniASTDumperConsumer()
 {
 }
 
+bool MiniASTDumperConsumer::TraverseDecl(Decl *decl)
+{
+    // Calls are attributed to the function whose body they're in
+    auto func = dyn_cast_or_null<FunctionDecl>(decl);
+    if (!func || !func->doesThisDeclarationHaveABody() || isInSystemHeader(clazy::getLocStart(func)))
+        return RecursiveASTVisitor::TraverseDecl(decl);
+
+    const FunctionDecl *outerFunction = m_currentFunction;
+    const unsigned int outerLoopDepth = m_loopDepth;
+    m_currentFunction = func;
+    m_loopDepth = 0;
+    m_writer.functions.push_back({ function(func), location(func->getLocation()) });
+    const bool result = RecursiveASTVisitor::TraverseDecl(decl);
+    m_currentFunction = outerFunction;
+    m_loopDepth = outerLoopDepth;
+    return result;
+}
+
+bool MiniASTDumperConsumer::TraverseForStmt(ForStmt *stmt)
+{
+    ++m_loopDepth;
+    const bool result = RecursiveASTVisitor::TraverseForStmt(stmt);
+    --m_loopDepth;
+    return result;
+}
+
+bool MiniASTDumperConsumer::TraverseCXXForRangeStmt(CXXForRangeStmt *stmt)
+{
+    ++m_loopDepth;
+    const bool result = RecursiveASTVisitor::TraverseCXXForRangeStmt(stmt);
+    --m_loopDepth;
+    return result;
+}
+
+bool MiniASTDumperConsumer::TraverseWhileStmt(WhileStmt *stmt)
+{
+    ++m_loopDepth;
+    const bool result = RecursiveASTVisitor::TraverseWhileStmt(stmt);
+    --m_loopDepth;
+    return result;
+}
+
+bool MiniASTDumperConsumer::TraverseDoStmt(DoStmt *stmt)
+{
+    ++m_loopDepth;
+    const bool result = RecursiveASTVisitor::TraverseDoStmt(stmt);
+    --m_loopDepth;
+    return result;
+}
+
 bool MiniASTDumperConsumer::VisitDecl(Decl *decl)
 {
-    if (auto rec = dyn_cast<CXXRecordDecl>(decl)) {
-        llvm::errs() << "Found record: " << rec->getQualifiedNameAsString() << "\n";
-    }
+    if (AccessSpecifierManager *a = m_context->accessSpecifierManager) // Needs to visit system headers too
+        a->VisitDeclaration(decl);
 
+    auto record = dyn_cast<CXXRecordDecl>(decl);
+    if (record && record->isThisDeclarationADefinition() && !isa<ClassTemplatePartialSpecializationDecl>(record)
+        && clazy::isQObject(record))
+        addClass(record);
+
+    if (isInSystemHeader(clazy::getLocStart(decl)))
+        return true;
+
+    addQTypeInfo(decl);
+    addContainerUse(decl);
+    addHierarchy(decl);
     return true;
 }
 
-bool MiniASTDumperConsumer::VisitStmt(Stmt *)
+bool MiniASTDumperConsumer::VisitStmt(Stmt *stm)
 {
+    auto call = dyn_cast<CallExpr>(stm);
+    if (!call || !m_currentFunction)
+        return true;
+
+    addCall(call);
+    addConnect(call);
+    if (m_loopDepth > 0)
+        addVirtualCall(call);
     return true;
 }
 
+void MiniASTDumperConsumer::addClass(CXXRecordDecl *record)
+{
+    MiniAstIndex::Class c = {};
+    c.name = m_writer.string(record->getQualifiedNameAsString());
+    c.location = location(record->getLocation());
+    c.flags = MiniAstIndex::Class_QObject;
+    if (isInSystemHeader(record->getLocation()))
+        c.flags |= MiniAstIndex::Class_SystemHeader;
+
+    c.firstBase = m_writer.bases.size();
+    for (const CXXBaseSpecifier &base : record->bases()) {
+        const CXXRecordDecl *baseRecord = base.getType()->getAsCXXRecordDecl();
+        if (baseRecord)
+            m_writer.bases.push_back(m_writer.string(baseRecord->getQualifiedNameAsString()));
+    }
+    c.numBases = m_writer.bases.size() - c.firstBase;
+
+    const AccessSpecifierManager *a = m_context->accessSpecifierManager;
+    c.firstMethod = m_writer.methods.size();
+    for (const CXXMethodDecl *method : record->methods()) {
+        if (method->isImplicit())
+            continue;
+
+        MiniAstIndex::Method m = {};
+        m.name = m_writer.string(method->getNameAsString());
+        m.type = m_writer.string(method->getType().getAsString());
+        m.location = location(method->getLocation());
+        if (method->isVirtual())
+            m.flags |= MiniAstIndex::Method_Virtual;
+        if (method->isStatic())
+            m.flags |= MiniAstIndex::Method_Static;
+
+        switch (a ? a->qtAccessSpecifierType(method) : QtAccessSpecifier_Unknown) {
+        case QtAccessSpecifier_Signal:
+            m.flags |= MiniAstIndex::Method_Signal;
+            break;
+        case QtAccessSpecifier_Slot:
+            m.flags |= MiniAstIndex::Method_Slot;
+            break;
+        case QtAccessSpecifier_Invokable:
+            m.flags |= MiniAstIndex::Method_Invokable;
+            break;
+        case QtAccessSpecifier_None:
+        case QtAccessSpecifier_Unknown:
+            break;
+        }
+
+        m_writer.methods.push_back(m);
+    }
+    c.numMethods = m_writer.methods.size() - c.firstMethod;
+
+    m_writer.classes.push_back(c);
+}
+
+void MiniASTDumperConsumer::addQTypeInfo(Decl *decl)
+{
+    auto specialization = dyn_cast<ClassTemplateSpecializationDecl>(decl);
+    if (!specialization || !clazy::classNameIs(specialization, "QTypeInfo"))
+        return;
+
+    const CXXRecordDecl *record = clazy::getTemplateArgumentRecord(specialization, 0);
+    if (record && m_typeInfos.insert(record).second)
+        m_writer.typeInfos.push_back({ m_writer.string(record->getQualifiedNameAsString()), location(decl->getLocation()) });
+}
+
+void MiniASTDumperConsumer::addContainerUse(Decl *decl)
+{
+    ClassTemplateSpecializationDecl *container = clazy::templateDecl(decl);
+    const bool isQList = container && clazy::classNameIs(container, "QList");
+    if (!container || (!isQList && !clazy::classNameIs(container, "QVector")))
+        return;
+
+    const QualType type = clazy::getTemplateArgumentType(container, 0);
+    const CXXRecordDecl *record = type.isNull() ? nullptr : type->getAsCXXRecordDecl();
+    if (!record || !record->getDefinition() || type->isDependentType() || isInSystemHeader(record->getLocation()))
+        return;
+
+    const uint32_t containerName = m_writer.string(isQList ? "QList" : "QVector");
+    const uint32_t typeName = m_writer.string(record->getQualifiedNameAsString());
+    if (!m_containerUses.insert({ containerName, typeName }).second)
+        return;
+
+    const ASTContext &astContext = m_ci.getASTContext();
+    MiniAstIndex::ContainerUse use = { containerName, typeName, location(record->getLocation()),
+                                       uint32_t(astContext.getTypeSizeInChars(type).getQuantity()), 0 };
+    if (type.isTriviallyCopyableType(astContext))
+        use.flags |= MiniAstIndex::ContainerUse_TriviallyCopyable;
+    if (clazy::isTooBigForQList(type, &astContext))
+        use.flags |= MiniAstIndex::ContainerUse_TooBigForQList;
+    m_writer.containerUses.push_back(use);
+}
+
+void MiniASTDumperConsumer::addHierarchy(Decl *decl)
+{
+    auto record = dyn_cast<CXXRecordDecl>(decl);
+    if (!record || !record->isThisDeclarationADefinition() || !record->isPolymorphic())
+        return;
+
+    const uint32_t derived = m_writer.string(record->getQualifiedNameAsString());
+    for (const CXXBaseSpecifier &base : record->bases()) {
+        const CXXRecordDecl *baseRecord = base.getType()->getAsCXXRecordDecl();
+        if (baseRecord)
+            m_writer.derivations.push_back({ m_writer.string(baseRecord->getQualifiedNameAsString()), derived });
+    }
+
+    for (const CXXMethodDecl *method : record->methods()) {
+        for (const CXXMethodDecl *overridden : method->overridden_methods())
+            m_writer.overrides.push_back({ function(overridden), function(method) });
+    }
+}
+
+void MiniASTDumperConsumer::addVirtualCall(CallExpr *call)
+{
+    auto memberCall = dyn_cast<CXXMemberCallExpr>(call);
+    const CXXMethodDecl *callee = nullptr;
+    const CXXRecordDecl *record = memberCall ? Utils::virtualCallClass(memberCall, m_currentFunction, callee) : nullptr;
+    if (!record || isInSystemHeader(record->getLocation()))
+        return;
+
+    MiniAstIndex::VirtualCall virtualCall = { function(callee), m_writer.string(callee->getQualifiedNameAsString()),
+                                              m_writer.string(record->getQualifiedNameAsString()),
+                                              location(clazy::getLocStart(call)), 0 };
+    if (callee->getParent()->getCanonicalDecl() == record->getCanonicalDecl())
+        virtualCall.flags |= MiniAstIndex::VirtualCall_CalleeInClass;
+    m_writer.virtualCalls.push_back(virtualCall);
+}
+
+void MiniASTDumperConsumer::addCall(CallExpr *call)
+{
+    const FunctionDecl *callee = call->getDirectCallee();
+    if (!callee)
+        return;
+
+    const MiniAstIndex::Call edge = { function(m_currentFunction), function(callee) };
+    if (m_calls.insert({ edge.caller, edge.callee }).second)
+        m_writer.calls.push_back(edge);
+}
+
+void MiniASTDumperConsumer::addConnect(CallExpr *call)
+{
+    FunctionDecl *callee = call->getDirectCallee();
+    if (!callee || !clazy::isConnect(callee) || !clazy::connectHasPMFStyle(callee))
+        return;
+
+    const CXXMethodDecl *signal = clazy::pmfFromConnect(call, 1);
+    if (!signal)
+        return;
+
+    const CXXMethodDecl *slot = clazy::receiverMethodForConnect(call);
+    m_writer.connects.push_back({ function(signal), slot ? function(slot) : 0, location(clazy::getLocStart(call)) });
+}
+
+uint32_t MiniASTDumperConsumer::function(const FunctionDecl *func)
+{
+    return m_writer.string(clazy::functionKey(func));
+}
+
+MiniAstIndex::Location MiniASTDumperConsumer::location(SourceLocation loc)
+{
+    const SourceManager &sm = m_ci.getSourceManager();
+    loc = sm.getExpansionLoc(loc);
+    if (loc.isInvalid())
+        return {};
+
+    // Absolute, so the same file has the same name in every translation unit
+    const FileID fid = sm.getFileID(loc);
+    auto it = m_fileNames.find(fid.getHashValue());
+    if (it == m_fileNames.end()) {
+        const FileEntry *entry = sm.getFileEntryForID(fid);
+        llvm::SmallString<256> path(entry ? entry->getName() : llvm::StringRef());
+        if (!path.empty()) {
+            llvm::sys::fs::make_absolute(path);
+            llvm::sys::path::remove_dots(path, /*remove_dot_dot=*/ true);
+        }
+        it = m_fileNames.insert({ fid.getHashValue(), m_writer.string(path) }).first;
+    }
+
+    return { it->second, sm.getExpansionLineNumber(loc), sm.getExpansionColumnNumber(loc) };
+}
+
+bool MiniASTDumperConsumer::isInSystemHeader(SourceLocation loc) const
+{
+    return loc.isInvalid() || m_ci.getSourceManager().isInSystemHeader(loc);
+}
+
+std::string MiniASTDumperConsumer::indexFilename() const
+{
+    const SourceManager &sm = m_ci.getSourceManager();
+    const FileEntry *mainFile = sm.getFileEntryForID(sm.getMainFileID());
+    if (!mainFile)
+        return {};
+
+    llvm::SmallString<256> mainPath(mainFile->getName());
+    llvm::sys::fs::make_absolute(mainPath);
+    if (m_indexDir.empty())
+        return mainPath.str().str() + ".clazy-index";
+
+    // Files with the same name in different directories mustn't overwrite each other
+    llvm::MD5 hash;
+    hash.update(mainPath.str());
+    llvm::MD5::MD5Result result;
+    hash.final(result);
+    llvm::SmallString<32> hexHash;
+    llvm::MD5::stringifyResult(result, hexHash);
+
+    llvm::sys::fs::create_directories(m_indexDir);
+    return m_indexDir + '/' + llvm::sys::path::filename(mainPath).str() + '-' + hexHash.str().str() + ".clazy-index";
+}
+
 void MiniASTDumperConsumer::HandleTranslationUnit(ASTContext &ctx)
 {
-    auto &sm = ctx.getSourceManager();
-    const FileEntry *fileEntry = sm.getFileEntryForID(sm.getMainFileID());
-    llvm::errs() << "Found TU: " << fileEntry->getName() << "\n";
+    // A botched AST would give a partial index
+    if (m_ci.getDiagnostics().hasErrorOccurred())
+        return;
+
     TraverseDecl(ctx.getTranslationUnitDecl());
+
+    const std::string filename = indexFilename();
+    std::string error;
+    if (!filename.empty() && !m_writer.write(filename, error))
+        llvm::errs() << "clazy: Failed to write the index: " << error << "\n";
 }
 
 static FrontendPluginRegistry::Add<MiniAstDumperASTAction>
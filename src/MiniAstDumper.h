@@ -23,12 +23,18 @@
 #ifndef CLAZY_MINI_AST_DUMPER
 #define CLAZY_MINI_AST_DUMPER
 
+#include "MiniAstIndex.h"
+
 #include <clang/AST/ASTConsumer.h>
+#include <clang/Basic/SourceLocation.h>
 #include <clang/Frontend/FrontendAction.h>
 #include <clang/AST/RecursiveASTVisitor.h>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/DenseSet.h>
 #include <llvm/ADT/StringRef.h>
 
 #include <memory>
+#include <set>
 #include <vector>
 #include <string>
 #include <utility>
@@ -36,10 +42,30 @@
 namespace clang {
 class CompilerInstance;
 class ASTContext;
+class CallExpr;
+class CXXForRangeStmt;
+class CXXRecordDecl;
+class DoStmt;
+class ForStmt;
+class WhileStmt;
 class Decl;
+class FunctionDecl;
 class Stmt;
 }
 
+class ClazyContext;
+
+namespace clazy {
+/**
+ * Returns how the index names a function, its qualified name followed by its type, for example "Foo::bar void (int) const".
+ */
+std::string functionKey(const clang::FunctionDecl *func);
+}
+
+/**
+ * Writes the MiniAstIndex of each translation unit. With the "index-dir=<dir>" plugin argument it's written into dir,
+ * otherwise next to the main file, as <main file>.clazy-index.
+ */
 class MiniAstDumperASTAction : public clang::PluginASTAction
 {
 public:
@@ -47,6 +73,8 @@ public:
 protected:
     bool ParseArgs(const clang::CompilerInstance &ci, const std::vector<std::string> &args_) override;
     std::unique_ptr<clang::ASTConsumer> CreateASTConsumer(clang::CompilerInstance &ci, llvm::StringRef) override;
+private:
+    std::string m_indexDir;
 };
 
 class MiniASTDumperConsumer
@@ -54,15 +82,42 @@ class MiniASTDumperConsumer
     , public clang::RecursiveASTVisitor<MiniASTDumperConsumer>
 {
 public:
-    explicit MiniASTDumperConsumer();
+    MiniASTDumperConsumer(clang::CompilerInstance &ci, const std::string &indexDir);
     ~MiniASTDumperConsumer() override;
 
+    bool TraverseDecl(clang::Decl *decl);
+    bool TraverseForStmt(clang::ForStmt *stmt);
+    bool TraverseCXXForRangeStmt(clang::CXXForRangeStmt *stmt);
+    bool TraverseWhileStmt(clang::WhileStmt *stmt);
+    bool TraverseDoStmt(clang::DoStmt *stmt);
     bool VisitDecl(clang::Decl *decl);
     bool VisitStmt(clang::Stmt *stm);
     void HandleTranslationUnit(clang::ASTContext &ctx) override;
 
 private:
     MiniASTDumperConsumer(const MiniASTDumperConsumer &) = delete;
+    void addClass(clang::CXXRecordDecl *record);
+    void addQTypeInfo(clang::Decl *decl);
+    void addContainerUse(clang::Decl *decl);
+    void addHierarchy(clang::Decl *decl);
+    void addVirtualCall(clang::CallExpr *call);
+    void addCall(clang::CallExpr *call);
+    void addConnect(clang::CallExpr *call);
+    uint32_t function(const clang::FunctionDecl *func);
+    MiniAstIndex::Location location(clang::SourceLocation loc);
+    bool isInSystemHeader(clang::SourceLocation loc) const;
+    std::string indexFilename() const;
+
+    clang::CompilerInstance &m_ci;
+    const std::string m_indexDir;
+    std::unique_ptr<ClazyContext> m_context; // For the AccessSpecifierManager
+    MiniAstIndexWriter m_writer;
+    const clang::FunctionDecl *m_currentFunction = nullptr; // Being traversed, if it's outside of system headers
+    unsigned int m_loopDepth = 0; // Of the loops being traversed, inside m_currentFunction
+    llvm::DenseMap<unsigned, uint32_t> m_fileNames; // String offsets by FileID hash value
+    std::set<std::pair<uint32_t, uint32_t>> m_calls;
+    std::set<std::pair<uint32_t, uint32_t>> m_containerUses; // Container and type names
+    llvm::DenseSet<const clang::CXXRecordDecl *> m_typeInfos;
 };
 
 #endif
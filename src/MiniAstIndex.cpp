@@ -0,0 +1,307 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "MiniAstIndex.h"
+
+#include <llvm/ADT/DenseSet.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <set>
+#include <system_error>
+#include <tuple>
+#include <utility>
+
+using namespace std;
+
+MiniAstIndex::MiniAstIndex(std::unique_ptr<llvm::MemoryBuffer> buffer)
+    : m_buffer(std::move(buffer))
+{
+}
+
+std::unique_ptr<MiniAstIndex> MiniAstIndex::open(const std::string &filename, std::string &error)
+{
+    auto buffer = llvm::MemoryBuffer::getFile(filename);
+    if (!buffer) {
+        error = filename + ": " + buffer.getError().message();
+        return nullptr;
+    }
+
+    std::unique_ptr<MiniAstIndex> index(new MiniAstIndex(std::move(*buffer)));
+    if (!index->isValid(error)) {
+        error = filename + ": " + error;
+        return nullptr;
+    }
+
+    return index;
+}
+
+bool MiniAstIndex::isValid(std::string &error) const
+{
+    const size_t size = m_buffer->getBufferSize();
+    if (size < sizeof(Header) || header().magic != Magic) {
+        error = "Not a clazy index";
+        return false;
+    }
+
+    if (header().version != Version) {
+        error = "Unsupported index version " + to_string(header().version);
+        return false;
+    }
+
+    static const size_t elementSizes[Section_Count] = { 1, sizeof(Class), sizeof(uint32_t), sizeof(Method), sizeof(Function),
+                                                        sizeof(Call), sizeof(Connect), sizeof(TypeInfo), sizeof(ContainerUse),
+                                                        sizeof(Derivation), sizeof(Override), sizeof(VirtualCall) };
+    for (int s = 0; s < Section_Count; ++s) {
+        const uint64_t offset = header().sections[s].offset;
+        const uint64_t bytes = uint64_t(header().sections[s].count) * elementSizes[s];
+        if (offset % 4 != 0 || offset < sizeof(Header) || offset + bytes > size) {
+            error = "Corrupt section " + to_string(s);
+            return false;
+        }
+    }
+
+    // string() relies on the string section starting with the empty string and ending with a null
+    const llvm::ArrayRef<char> strings = section<char>(Section_Strings);
+    if (strings.empty() || strings.front() != '\0' || strings.back() != '\0') {
+        error = "Corrupt string section";
+        return false;
+    }
+
+    const size_t numBases = section<uint32_t>(Section_Bases).size();
+    const size_t numMethods = section<Method>(Section_Methods).size();
+    for (const Class &c : classes()) {
+        if (uint64_t(c.firstBase) + c.numBases > numBases || uint64_t(c.firstMethod) + c.numMethods > numMethods) {
+            error = "Corrupt class " + string(c.name).str();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+llvm::StringRef MiniAstIndex::string(uint32_t offset) const
+{
+    const llvm::ArrayRef<char> strings = section<char>(Section_Strings);
+    if (offset >= strings.size())
+        return {};
+
+    return llvm::StringRef(strings.data() + offset); // Null terminated, see isValid()
+}
+
+namespace {
+// What makes the entries of each section the same, once their strings are in the merged string section
+typedef std::tuple<uint32_t, uint32_t, uint32_t, uint32_t, uint32_t> EntryKey;
+
+EntryKey keyOf(uint32_t a, uint32_t b, const MiniAstIndex::Location &location)
+{
+    return EntryKey(a, b, location.file, location.line, location.column);
+}
+}
+
+bool MiniAstIndex::merge(const std::vector<std::string> &inputs, const std::string &output, std::string &error)
+{
+    MiniAstIndexWriter writer;
+    llvm::DenseSet<uint32_t> classNames;
+    llvm::DenseSet<uint32_t> functionKeys;
+    llvm::DenseSet<uint32_t> typeInfoTypes;
+    std::set<std::pair<uint32_t, uint32_t>> calls;
+    std::set<EntryKey> connects;
+    std::set<EntryKey> containerUses;
+    std::set<std::pair<uint32_t, uint32_t>> derivations;
+    std::set<std::pair<uint32_t, uint32_t>> overrides;
+    std::set<EntryKey> virtualCalls;
+
+    for (const std::string &input : inputs) {
+        std::unique_ptr<MiniAstIndex> index = open(input, error);
+        if (!index)
+            return false;
+
+        auto str = [&writer, &index] (uint32_t offset) {
+            return writer.string(index->string(offset));
+        };
+
+        auto location = [&str] (const Location &l) {
+            return Location { str(l.file), l.line, l.column };
+        };
+
+        // A class defined in a header is in the index of each translation unit including it
+        for (const Class &c : index->classes()) {
+            Class merged = c;
+            merged.name = str(c.name);
+            if (!classNames.insert(merged.name).second)
+                continue;
+
+            merged.location = location(c.location);
+            merged.firstBase = writer.bases.size();
+            for (uint32_t base : index->bases(c))
+                writer.bases.push_back(str(base));
+
+            merged.firstMethod = writer.methods.size();
+            for (const Method &method : index->methods(c))
+                writer.methods.push_back({ str(method.name), str(method.type), location(method.location), method.flags });
+
+            writer.classes.push_back(merged);
+        }
+
+        for (const Function &function : index->functions()) {
+            const uint32_t key = str(function.key);
+            if (functionKeys.insert(key).second)
+                writer.functions.push_back({ key, location(function.location) });
+        }
+
+        for (const Call &call : index->calls()) {
+            const Call merged = { str(call.caller), str(call.callee) };
+            if (calls.insert({ merged.caller, merged.callee }).second)
+                writer.calls.push_back(merged);
+        }
+
+        for (const Connect &connect : index->connects()) {
+            const Connect merged = { str(connect.signal), str(connect.slot), location(connect.location) };
+            if (connects.insert(keyOf(merged.signal, merged.slot, merged.location)).second)
+                writer.connects.push_back(merged);
+        }
+
+        for (const TypeInfo &typeInfo : index->typeInfos()) {
+            const TypeInfo merged = { str(typeInfo.type), location(typeInfo.location) };
+            if (typeInfoTypes.insert(merged.type).second)
+                writer.typeInfos.push_back(merged);
+        }
+
+        for (const ContainerUse &use : index->containerUses()) {
+            const ContainerUse merged = { str(use.container), str(use.type), location(use.location), use.typeSize, use.flags };
+            if (containerUses.insert(keyOf(merged.container, merged.type, merged.location)).second)
+                writer.containerUses.push_back(merged);
+        }
+
+        for (const Derivation &derivation : index->derivations()) {
+            const Derivation merged = { str(derivation.base), str(derivation.derived) };
+            if (derivations.insert({ merged.base, merged.derived }).second)
+                writer.derivations.push_back(merged);
+        }
+
+        for (const Override &o : index->overrides()) {
+            const Override merged = { str(o.overridden), str(o.overrider) };
+            if (overrides.insert({ merged.overridden, merged.overrider }).second)
+                writer.overrides.push_back(merged);
+        }
+
+        for (const VirtualCall &call : index->virtualCalls()) {
+            const VirtualCall merged = { str(call.callee), str(call.calleeName), str(call.staticClass), location(call.location), call.flags };
+            if (virtualCalls.insert(keyOf(merged.callee, merged.staticClass, merged.location)).second)
+                writer.virtualCalls.push_back(merged);
+        }
+    }
+
+    return writer.write(output, error);
+}
+
+MiniAstIndexWriter::MiniAstIndexWriter()
+    : m_strings(1, '\0') // Offset 0 is the empty string
+{
+    m_stringOffsets[""] = 0;
+}
+
+uint32_t MiniAstIndexWriter::string(llvm::StringRef str)
+{
+    auto result = m_stringOffsets.insert({ str, uint32_t(m_strings.size()) });
+    if (result.second) {
+        m_strings.append(str.data(), str.size());
+        m_strings += '\0';
+    }
+
+    return result.first->getValue();
+}
+
+template <typename T>
+static void writeSection(llvm::raw_ostream &os, MiniAstIndex::Header &header, MiniAstIndex::Section s,
+                         const T *data, size_t count, uint64_t &offset)
+{
+    header.sections[s].offset = offset;
+    header.sections[s].count = count;
+    const size_t bytes = count * sizeof(T);
+    os.write(reinterpret_cast<const char *>(data), bytes);
+    offset += bytes;
+
+    // Keeps the next section aligned
+    for (; offset % 4 != 0; ++offset)
+        os << '\0';
+}
+
+bool MiniAstIndexWriter::write(const std::string &filename, std::string &error) const
+{
+    int fd = -1;
+    llvm::SmallString<128> tmpFilename;
+    if (std::error_code ec = llvm::sys::fs::createUniqueFile(filename + "-%%%%%%", fd, tmpFilename)) {
+        error = filename + ": " + ec.message();
+        return false;
+    }
+
+    MiniAstIndex::Header header = {};
+    header.magic = MiniAstIndex::Magic;
+    header.version = MiniAstIndex::Version;
+
+    {
+        llvm::raw_fd_ostream os(fd, /*shouldClose=*/ true);
+        // The offsets are only known once the sections are written, so the header is rewritten at the end
+        os.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        uint64_t offset = sizeof(header);
+        writeSection(os, header, MiniAstIndex::Section_Strings, m_strings.data(), m_strings.size(), offset);
+        writeSection(os, header, MiniAstIndex::Section_Classes, classes.data(), classes.size(), offset);
+        writeSection(os, header, MiniAstIndex::Section_Bases, bases.data(), bases.size(), offset);
+        writeSection(os, header, MiniAstIndex::Section_Methods, methods.data(), methods.size(), offset);
+        writeSection(os, header, MiniAstIndex::Section_Functions, functions.data(), functions.size(), offset);
+        writeSection(os, header, MiniAstIndex::Section_Calls, calls.data(), calls.size(), offset);
+        writeSection(os, header, MiniAstIndex::Section_Connects, connects.data(), connects.size(), offset);
+        writeSection(os, header, MiniAstIndex::Section_TypeInfos, typeInfos.data(), typeInfos.size(), offset);
+        writeSection(os, header, MiniAstIndex::Section_ContainerUses, containerUses.data(), containerUses.size(), offset);
+        writeSection(os, header, MiniAstIndex::Section_Derivations, derivations.data(), derivations.size(), offset);
+        writeSection(os, header, MiniAstIndex::Section_Overrides, overrides.data(), overrides.size(), offset);
+        writeSection(os, header, MiniAstIndex::Section_VirtualCalls, virtualCalls.data(), virtualCalls.size(), offset);
+
+        if (offset > UINT32_MAX) {
+            error = filename + ": Index too big";
+            os.close();
+            llvm::sys::fs::remove(tmpFilename);
+            return false;
+        }
+
+        os.seek(0);
+        os.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        if (os.has_error()) {
+            error = filename + ": Write error";
+            os.clear_error();
+            os.close();
+            llvm::sys::fs::remove(tmpFilename);
+            return false;
+        }
+    }
+
+    if (std::error_code ec = llvm::sys::fs::rename(tmpFilename, filename)) {
+        llvm::sys::fs::remove(tmpFilename);
+        error = filename + ": " + ec.message();
+        return false;
+    }
+
+    return true;
+}
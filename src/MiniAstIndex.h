@@ -0,0 +1,253 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_MINI_AST_INDEX_H
+#define CLAZY_MINI_AST_INDEX_H
+
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * The binary index written by the clazyMiniAstDumper plugin, one per translation unit, and merged into a
+ * whole-program one by clazy-standalone -merge-index.
+ *
+ * It's memory-mapped and used in place, so it's only made of arrays of the structs below, all of them 32-bit fields,
+ * in the host's byte order. The header gives the offset and size of each section. Names are offsets into the string
+ * section, where offset 0 is the empty string. Functions and methods are named by clazy::functionKey(), for example
+ * "Foo::bar void (int) const", so that they can be matched across translation units.
+ */
+class MiniAstIndex
+{
+public:
+    static const uint32_t Magic = 0x495a4c43; // "CLZI"
+    static const uint32_t Version = 2;
+
+    enum Section {
+        Section_Strings,
+        Section_Classes,
+        Section_Bases,
+        Section_Methods,
+        Section_Functions,
+        Section_Calls,
+        Section_Connects,
+        Section_TypeInfos,
+        Section_ContainerUses,
+        Section_Derivations,
+        Section_Overrides,
+        Section_VirtualCalls,
+        Section_Count
+    };
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        struct {
+            uint32_t offset; // In bytes, from the start of the file
+            uint32_t count; // Of elements, bytes for Section_Strings
+        } sections[Section_Count];
+    };
+
+    struct Location {
+        uint32_t file;
+        uint32_t line;
+        uint32_t column;
+    };
+
+    enum ClassFlag {
+        Class_QObject = 1,
+        Class_SystemHeader = 2
+    };
+
+    struct Class {
+        uint32_t name; // Qualified
+        Location location;
+        uint32_t firstBase; // Into Section_Bases, which holds class names
+        uint32_t numBases;
+        uint32_t firstMethod; // Into Section_Methods
+        uint32_t numMethods;
+        uint32_t flags;
+    };
+
+    enum MethodFlag {
+        Method_Signal = 1,
+        Method_Slot = 2,
+        Method_Invokable = 4,
+        Method_Virtual = 8,
+        Method_Static = 16
+    };
+
+    struct Method {
+        uint32_t name; // Unqualified
+        uint32_t type; // For example "void (int) const"
+        Location location;
+        uint32_t flags;
+    };
+
+    // A function or method defined outside of system headers
+    struct Function {
+        uint32_t key;
+        Location location;
+    };
+
+    struct Call {
+        uint32_t caller;
+        uint32_t callee;
+    };
+
+    // A connect() with member function pointers
+    struct Connect {
+        uint32_t signal;
+        uint32_t slot; // Empty if it's not a method, like a lambda
+        Location location;
+    };
+
+    // A QTypeInfo specialization, like Q_DECLARE_TYPEINFO() gives
+    struct TypeInfo {
+        uint32_t type; // Qualified class name
+        Location location;
+    };
+
+    enum ContainerUseFlag {
+        ContainerUse_TriviallyCopyable = 1,
+        ContainerUse_TooBigForQList = 2 // As clazy::isTooBigForQList() says, for the target it was compiled for
+    };
+
+    // A QList or QVector of a class type, outside of system headers
+    struct ContainerUse {
+        uint32_t container; // "QList" or "QVector"
+        uint32_t type; // Qualified class name
+        Location location; // Where the class is declared
+        uint32_t typeSize; // In bytes
+        uint32_t flags;
+    };
+
+    // A polymorphic class and one of its bases, outside of system headers
+    struct Derivation {
+        uint32_t base; // Qualified class names
+        uint32_t derived;
+    };
+
+    // A method and one it overrides, outside of system headers
+    struct Override {
+        uint32_t overridden; // Function keys
+        uint32_t overrider;
+    };
+
+    enum VirtualCallFlag {
+        VirtualCall_CalleeInClass = 1 // The callee is declared in the static class, not inherited from one of its bases
+    };
+
+    // A call through the vtable inside a loop, as Utils::virtualCallClass() finds them, outside of system headers
+    struct VirtualCall {
+        uint32_t callee; // Function key
+        uint32_t calleeName; // Qualified
+        uint32_t staticClass; // Qualified class name
+        Location location;
+        uint32_t flags;
+    };
+
+    /**
+     * Maps filename and checks its structure. Returns nullptr and sets error if it's not a valid index.
+     */
+    static std::unique_ptr<MiniAstIndex> open(const std::string &filename, std::string &error);
+
+    llvm::StringRef string(uint32_t offset) const;
+
+    llvm::ArrayRef<Class> classes() const { return section<Class>(Section_Classes); }
+    llvm::ArrayRef<uint32_t> bases(const Class &c) const { return section<uint32_t>(Section_Bases).slice(c.firstBase, c.numBases); }
+    llvm::ArrayRef<Method> methods(const Class &c) const { return section<Method>(Section_Methods).slice(c.firstMethod, c.numMethods); }
+    llvm::ArrayRef<Function> functions() const { return section<Function>(Section_Functions); }
+    llvm::ArrayRef<Call> calls() const { return section<Call>(Section_Calls); }
+    llvm::ArrayRef<Connect> connects() const { return section<Connect>(Section_Connects); }
+    llvm::ArrayRef<TypeInfo> typeInfos() const { return section<TypeInfo>(Section_TypeInfos); }
+    llvm::ArrayRef<ContainerUse> containerUses() const { return section<ContainerUse>(Section_ContainerUses); }
+    llvm::ArrayRef<Derivation> derivations() const { return section<Derivation>(Section_Derivations); }
+    llvm::ArrayRef<Override> overrides() const { return section<Override>(Section_Overrides); }
+    llvm::ArrayRef<VirtualCall> virtualCalls() const { return section<VirtualCall>(Section_VirtualCalls); }
+
+    /**
+     * Merges the indexes of several translation units into output, dropping what's repeated, like the
+     * classes of headers included by many of them. Returns false and sets error on failure.
+     */
+    static bool merge(const std::vector<std::string> &inputs, const std::string &output, std::string &error);
+
+private:
+    explicit MiniAstIndex(std::unique_ptr<llvm::MemoryBuffer> buffer);
+    bool isValid(std::string &error) const;
+
+    template <typename T>
+    llvm::ArrayRef<T> section(Section s) const
+    {
+        const char *start = m_buffer->getBufferStart() + header().sections[s].offset;
+        return llvm::ArrayRef<T>(reinterpret_cast<const T *>(start), header().sections[s].count);
+    }
+
+    const Header &header() const
+    {
+        return *reinterpret_cast<const Header *>(m_buffer->getBufferStart());
+    }
+
+    std::unique_ptr<llvm::MemoryBuffer> m_buffer;
+};
+
+/**
+ * Builds an index in memory and writes it.
+ */
+class MiniAstIndexWriter
+{
+public:
+    MiniAstIndexWriter();
+
+    // Returns the offset of str in the string section, adding it if it's new
+    uint32_t string(llvm::StringRef str);
+
+    /**
+     * Writes the index, through a temporary file so that readers never see a partial one.
+     * Returns false and sets error on failure.
+     */
+    bool write(const std::string &filename, std::string &error) const;
+
+    std::vector<MiniAstIndex::Class> classes;
+    std::vector<uint32_t> bases;
+    std::vector<MiniAstIndex::Method> methods;
+    std::vector<MiniAstIndex::Function> functions;
+    std::vector<MiniAstIndex::Call> calls;
+    std::vector<MiniAstIndex::Connect> connects;
+    std::vector<MiniAstIndex::TypeInfo> typeInfos;
+    std::vector<MiniAstIndex::ContainerUse> containerUses;
+    std::vector<MiniAstIndex::Derivation> derivations;
+    std::vector<MiniAstIndex::Override> overrides;
+    std::vector<MiniAstIndex::VirtualCall> virtualCalls;
+
+private:
+    std::string m_strings;
+    llvm::StringMap<uint32_t> m_stringOffsets;
+};
+
+#endif
@@ -0,0 +1,120 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "PerfCounters.h"
+
+#include <llvm/Support/raw_ostream.h>
+
+#ifdef __linux__
+# include <linux/perf_event.h>
+# include <sys/ioctl.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+#endif
+
+#include <atomic>
+#include <cstring>
+
+#ifdef __linux__
+static int openCounter(uint64_t config, int groupFd)
+{
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = groupFd == -1; // The leader enables the whole group
+    attr.exclude_kernel = 1; // Allowed with the default perf_event_paranoid
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, /*pid=*/ 0, /*cpu=*/ -1, groupFd, 0));
+}
+#endif
+
+PerfCounters::PerfCounters()
+{
+    for (int &fd : m_fds)
+        fd = -1;
+
+#ifdef __linux__
+    static const uint64_t configs[PerfCounterValues::NumCounters] = {
+        PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+    };
+
+    for (int i = 0; i < PerfCounterValues::NumCounters; ++i) {
+        m_fds[i] = openCounter(configs[i], m_fds[0]);
+        if (m_fds[i] == -1)
+            break;
+    }
+
+    if (m_fds[PerfCounterValues::NumCounters - 1] != -1) {
+        m_groupFd = m_fds[0];
+        ioctl(m_groupFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(m_groupFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        return;
+    }
+
+    for (int &fd : m_fds) {
+        if (fd != -1)
+            close(fd);
+        fd = -1;
+    }
+#endif
+
+    // Once per process, not once per translation unit
+    static std::atomic<bool> s_warned(false);
+    if (!s_warned.exchange(true))
+        llvm::errs() << "clazy: Hardware performance counters aren't available, see /proc/sys/kernel/perf_event_paranoid\n";
+}
+
+PerfCounters::~PerfCounters()
+{
+#ifdef __linux__
+    for (int fd : m_fds) {
+        if (fd != -1)
+            close(fd);
+    }
+#endif
+}
+
+bool PerfCounters::read(PerfCounterValues &values) const
+{
+#ifdef __linux__
+    if (m_groupFd == -1)
+        return false;
+
+    // The PERF_FORMAT_GROUP layout: the number of counters, followed by their values
+    struct {
+        uint64_t nr;
+        uint64_t values[PerfCounterValues::NumCounters];
+    } buffer;
+
+    if (::read(m_groupFd, &buffer, sizeof(buffer)) != static_cast<ssize_t>(sizeof(buffer)) || buffer.nr != PerfCounterValues::NumCounters)
+        return false;
+
+    memcpy(values.values, buffer.values, sizeof(values.values));
+    return true;
+#else
+    (void)values;
+    return false;
+#endif
+}
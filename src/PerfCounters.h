@@ -0,0 +1,73 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_PERF_COUNTERS_H
+#define CLAZY_PERF_COUNTERS_H
+
+#include <cstdint>
+
+// Hardware counter values accumulated for the perf-counters option
+struct PerfCounterValues
+{
+    enum Counter {
+        Instructions = 0,
+        Cycles,
+        CacheMisses, // Last level cache
+        BranchMisses,
+        NumCounters
+    };
+
+    uint64_t values[NumCounters] = {};
+};
+
+/**
+ * A group of hardware performance counters measuring the calling thread, in user space only.
+ * Uses perf_event_open(), so it's only valid on Linux, and only if the kernel grants access to the counters,
+ * see /proc/sys/kernel/perf_event_paranoid. Virtual machines often don't expose them either.
+ *
+ * The counters are read as a group, so they all cover the same interval.
+ */
+class PerfCounters
+{
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    bool isValid() const
+    {
+        return m_groupFd != -1;
+    }
+
+    /**
+     * Reads the current values, returns false if the counters aren't valid or reading failed.
+     */
+    bool read(PerfCounterValues &values) const;
+
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters& operator=(const PerfCounters &) = delete;
+
+private:
+    int m_fds[PerfCounterValues::NumCounters];
+    int m_groupFd = -1;
+};
+
+#endif
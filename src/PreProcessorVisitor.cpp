@@ -21,6 +21,8 @@
 
 #include "PreProcessorVisitor.h"
 #include "MacroUtils.h"
+#include "ClazyContext.h"
+#include "PreprocessorDispatcher.h"
 
 #include <clang/Frontend/CompilerInstance.h>
 #include <clang/Lex/Preprocessor.h>
@@ -33,21 +35,58 @@
 #include <llvm/ADT/ArrayRef.h>
 
 #include <stdlib.h>
+#include <algorithm>
 #include <memory>
 
 using namespace clang;
 using namespace std;
 
-PreProcessorVisitor::PreProcessorVisitor(const clang::CompilerInstance &ci)
+PreProcessorVisitor::PreProcessorVisitor(const ClazyContext *context)
     : clang::PPCallbacks()
-    , m_ci(ci)
-    , m_sm(ci.getSourceManager())
+    , m_pp(context->pp)
+    , m_sm(context->sm)
 {
-    Preprocessor &pi = m_ci.getPreprocessor();
-    pi.addPPCallbacks(std::unique_ptr<PPCallbacks>(this));
+    // The dispatcher owns us
+    context->preprocessorDispatcher()->subscribe(this, PreprocessorEvent_MacroExpands,
+                                                 { "QT_BEGIN_NAMESPACE", "QT_END_NAMESPACE", "QT_NO_KEYWORDS",
+                                                   "QT_VERSION_MAJOR", "QT_VERSION_MINOR", "QT_VERSION_PATCH" });
 
     // This catches -DQT_NO_KEYWORDS passed to compiler. In MacroExpands() we catch when defined via in code
-    m_isQtNoKeywords = clazy::isPredefined(ci.getPreprocessorOpts(), "QT_NO_KEYWORDS");
+    m_isQtNoKeywords = clazy::isPredefined(m_pp.getPreprocessorOpts(), "QT_NO_KEYWORDS");
+}
+
+static int stringToNumber(const string &str)
+{
+    if (str.empty())
+        return -1;
+
+    return atoi(str.c_str());
+}
+
+void MacroDelimitedRegions::begin(unsigned int offset)
+{
+    m_regions.push_back({ offset, 0 });
+}
+
+void MacroDelimitedRegions::end(unsigned int offset)
+{
+    // Nested begins aren't tracked, the last end closes the last region, as before
+    if (!m_regions.empty() && offset > m_regions.back().begin)
+        m_regions.back().end = offset;
+}
+
+bool MacroDelimitedRegions::contains(unsigned int offset) const
+{
+    // The last region beginning before offset is the only candidate, regions don't overlap
+    auto it = std::lower_bound(m_regions.cbegin(), m_regions.cend(), offset, [](const Region &region, unsigned int offset) {
+        return region.begin < offset;
+    });
+
+    if (it == m_regions.cbegin())
+        return false;
+
+    --it;
+    return it->end != 0 && offset < it->end;
 }
 
 bool PreProcessorVisitor::isBetweenQtNamespaceMacros(SourceLocation loc)
@@ -55,39 +94,46 @@ bool PreProcessorVisitor::isBetweenQtNamespaceMacros(SourceLocation loc)
     if (loc.isInvalid())
         return false;
 
-    if (loc.isMacroID())
-        loc = m_sm.getExpansionLoc(loc);
-
-    uint fileId = m_sm.getFileID(loc).getHashValue();
+    const std::pair<FileID, unsigned> decomposed = m_sm.getDecomposedExpansionLoc(loc);
+    auto it = m_q_namespace_macro_locations.find(decomposed.first.getHashValue());
+    return it != m_q_namespace_macro_locations.end() && it->second.contains(decomposed.second);
+}
 
-    vector<SourceRange> &pairs = m_q_namespace_macro_locations[fileId];
-    for (SourceRange &pair : pairs) {
-        if (pair.getBegin().isInvalid() || pair.getEnd().isInvalid()) {
-            //llvm::errs() << "PreProcessorVisitor::isBetweenQtNamespaceMacros Found invalid location\n";
-            continue; // shouldn't happen
-        }
+int PreProcessorVisitor::qtVersion() const
+{
+    if (m_qtVersion != -1)
+        return m_qtVersion;
+
+    // Qt headers imported from a module or PCH don't expand their macros through our callbacks,
+    // but their definitions are still in the preprocessor's macro table
+    const int major = versionMacroFromMacroTable("QT_VERSION_MAJOR");
+    const int minor = versionMacroFromMacroTable("QT_VERSION_MINOR");
+    const int patch = versionMacroFromMacroTable("QT_VERSION_PATCH");
+    if (major == -1 || minor == -1 || patch == -1)
+        return -1;
 
-        if (m_sm.isBeforeInSLocAddrSpace(pair.getBegin(), loc) &&
-            m_sm.isBeforeInSLocAddrSpace(loc, pair.getEnd()))
-            return true;
-    }
+    return patch + minor * 100 + major * 10000;
+}
 
-    return false;
+bool PreProcessorVisitor::isQT_NO_KEYWORDS() const
+{
+    // Also asks the macro table, for definitions imported from a module
+    return m_isQtNoKeywords || m_pp.isMacroDefined("QT_NO_KEYWORDS");
 }
 
-std::string PreProcessorVisitor::getTokenSpelling(const MacroDefinition &def) const
+int PreProcessorVisitor::versionMacroFromMacroTable(llvm::StringRef name) const
 {
-    if (!def)
-        return {};
+    return stringToNumber(getTokenSpelling(m_pp.getMacroInfo(m_pp.getIdentifierInfo(name))));
+}
 
-    MacroInfo *info = def.getMacroInfo();
+std::string PreProcessorVisitor::getTokenSpelling(const MacroInfo *info) const
+{
     if (!info)
         return {};
 
-    const Preprocessor &pp = m_ci.getPreprocessor();
     string result;
     for (const auto &tok : info->tokens())
-        result += pp.getSpelling(tok);
+        result += m_pp.getSpelling(tok);
 
     return result;
 }
@@ -103,32 +149,12 @@ void PreProcessorVisitor::updateQtVersion()
 
 void PreProcessorVisitor::handleQtNamespaceMacro(SourceLocation loc, StringRef name)
 {
-    const bool isBegin = name == "QT_BEGIN_NAMESPACE";
-    uint fileId = m_sm.getFileID(loc).getHashValue();
-    vector<SourceRange> &pairs = m_q_namespace_macro_locations[fileId];
-
-    if (isBegin) {
-        pairs.push_back(SourceRange(loc, {}));
-    } else {
-        if (pairs.empty()) {
-            // llvm::errs() << "FOO Received end!!";
-        } else {
-            SourceRange &range = pairs[pairs.size() - 1];
-            if (range.getBegin().isInvalid()) {
-                // llvm::errs() << "FOO Error received end before a begin\n";
-            } else {
-                range.setEnd(loc);
-            }
-        }
-    }
-}
-
-static int stringToNumber(const string &str)
-{
-    if (str.empty())
-        return -1;
-
-    return atoi(str.c_str());
+    const std::pair<FileID, unsigned> decomposed = m_sm.getDecomposedExpansionLoc(loc);
+    MacroDelimitedRegions &regions = m_q_namespace_macro_locations[decomposed.first.getHashValue()];
+    if (name == "QT_BEGIN_NAMESPACE")
+        regions.begin(decomposed.second);
+    else
+        regions.end(decomposed.second);
 }
 
 void PreProcessorVisitor::MacroExpands(const Token &MacroNameTok, const MacroDefinition &def,
@@ -153,17 +179,17 @@ void PreProcessorVisitor::MacroExpands(const Token &MacroNameTok, const MacroDef
 
     auto name = ii->getName();
     if (name == "QT_VERSION_MAJOR") {
-        m_qtMajorVersion = stringToNumber(getTokenSpelling(def));
+        m_qtMajorVersion = stringToNumber(getTokenSpelling(def.getMacroInfo()));
         updateQtVersion();
     }
 
     if (name == "QT_VERSION_MINOR") {
-        m_qtMinorVersion = stringToNumber(getTokenSpelling(def));
+        m_qtMinorVersion = stringToNumber(getTokenSpelling(def.getMacroInfo()));
         updateQtVersion();
     }
 
     if (name == "QT_VERSION_PATCH") {
-        m_qtPatchVersion = stringToNumber(getTokenSpelling(def));
+        m_qtPatchVersion = stringToNumber(getTokenSpelling(def.getMacroInfo()));
         updateQtVersion();
     }
 }
@@ -37,49 +37,74 @@
 #include <vector>
 
 namespace clang {
-class CompilerInstance;
+class Preprocessor;
 class SourceManager;
 class SourceRange;
 class Token;
 class MacroDefinition;
 class MacroArgs;
+class MacroInfo;
 class SourceLocation;
 }
 
+class ClazyContext;
+
 using uint = unsigned;
 
+/**
+ * The regions of a file between two macros, like QT_BEGIN_NAMESPACE and QT_END_NAMESPACE, as file offsets.
+ * The macros are expanded in order, so regions are added sorted and lookups are a binary search.
+ */
+class MacroDelimitedRegions
+{
+public:
+    void begin(unsigned int offset);
+    void end(unsigned int offset); // Ends the last region, an end without a begin is ignored
+
+    // Returns true if offset is strictly inside a region which was ended
+    bool contains(unsigned int offset) const;
+
+private:
+    struct Region {
+        unsigned int begin;
+        unsigned int end; // 0 while open
+    };
+    std::vector<Region> m_regions;
+};
+
 class PreProcessorVisitor
     : public clang::PPCallbacks
 {
     PreProcessorVisitor(const PreProcessorVisitor &) = delete;
 public:
-    explicit PreProcessorVisitor(const clang::CompilerInstance &ci);
+    explicit PreProcessorVisitor(const ClazyContext *context);
 
     // Returns for example 050601 (Qt 5.6.1), or -1 if we don't know the version
-    int qtVersion() const { return m_qtVersion; }
+    int qtVersion() const;
 
     bool isBetweenQtNamespaceMacros(clang::SourceLocation loc);
 
     // Returns true if QT_NO_KEYWORDS is defined
-    bool isQT_NO_KEYWORDS() const { return m_isQtNoKeywords; }
+    bool isQT_NO_KEYWORDS() const;
 
 protected:
     void MacroExpands(const clang::Token &MacroNameTok, const clang::MacroDefinition &,
                       clang::SourceRange range, const clang::MacroArgs *) override;
 private:
-    std::string getTokenSpelling(const clang::MacroDefinition &) const;
+    std::string getTokenSpelling(const clang::MacroInfo *) const;
+    int versionMacroFromMacroTable(llvm::StringRef name) const;
     void updateQtVersion();
     void handleQtNamespaceMacro(clang::SourceLocation loc, clang::StringRef name);
 
-    const clang::CompilerInstance &m_ci;
+    clang::Preprocessor &m_pp;
     int m_qtMajorVersion  = -1;
     int m_qtMinorVersion  = -1;
     int m_qtPatchVersion = -1;
     int m_qtVersion = -1;
     bool m_isQtNoKeywords = false;
 
-    // Indexed by FileId, has a list of QT_BEGIN_NAMESPACE/QT_END_NAMESPACE location
-    std::unordered_map<uint, std::vector<clang::SourceRange>> m_q_namespace_macro_locations;
+    // Indexed by FileId, the regions between QT_BEGIN_NAMESPACE and QT_END_NAMESPACE
+    std::unordered_map<uint, MacroDelimitedRegions> m_q_namespace_macro_locations;
     const clang::SourceManager &m_sm;
 };
 
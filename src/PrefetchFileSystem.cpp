@@ -0,0 +1,175 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "PrefetchFileSystem.h"
+
+#ifdef CLAZY_HAS_PREFETCH_FILE_SYSTEM
+
+#include <llvm/Support/Path.h>
+
+#include <utility>
+
+using namespace std;
+
+namespace {
+
+// A file whose contents were already read, the buffers handed out reference the entry's
+class CachedFile : public llvm::vfs::File
+{
+public:
+    CachedFile(llvm::vfs::Status status, const llvm::MemoryBuffer &contents)
+        : m_status(std::move(status))
+        , m_contents(contents)
+    {
+    }
+
+    llvm::ErrorOr<llvm::vfs::Status> status() override
+    {
+        return m_status;
+    }
+
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> getBuffer(const llvm::Twine &name, int64_t, bool requiresNullTerminator,
+                                                                 bool) override
+    {
+        // MemoryBuffer::getFile() null-terminates them
+        return llvm::MemoryBuffer::getMemBuffer(m_contents.getBuffer(), name.str(), requiresNullTerminator);
+    }
+
+    std::error_code close() override
+    {
+        return {};
+    }
+
+private:
+    const llvm::vfs::Status m_status;
+    const llvm::MemoryBuffer &m_contents;
+};
+
+}
+
+PrefetchFileSystem::PrefetchFileSystem(llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fs)
+    : ProxyFileSystem(std::move(fs))
+    , m_nextPrefetchedFile(0)
+{
+}
+
+PrefetchFileSystem::~PrefetchFileSystem()
+{
+    stopPrefetching();
+}
+
+static bool isRegularFile(const llvm::ErrorOr<llvm::vfs::Status> &status)
+{
+    return status && status->isRegularFile();
+}
+
+llvm::ErrorOr<llvm::vfs::Status> PrefetchFileSystem::lookup(const string &path, const llvm::MemoryBuffer **contents)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(path);
+        if (it != m_entries.end() && (!contents || it->second->contents || !isRegularFile(it->second->status))) {
+            if (contents)
+                *contents = it->second->contents.get();
+            return it->second->status;
+        }
+    }
+
+    // Done unlocked, other threads keep being served. If two of them miss the same file, both read it.
+    std::unique_ptr<Entry> entry(new Entry { ProxyFileSystem::status(path), nullptr });
+    if (contents && isRegularFile(entry->status)) {
+        auto buffer = getUnderlyingFS().getBufferForFile(path);
+        if (buffer)
+            entry->contents = std::move(*buffer);
+    }
+
+    // Entries are never replaced, and their contents are only set once, so what was handed out stays valid
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_ptr<Entry> &stored = m_entries[path];
+    if (!stored)
+        stored = std::move(entry);
+    else if (!stored->contents && entry->contents)
+        stored->contents = std::move(entry->contents);
+
+    if (contents)
+        *contents = stored->contents.get();
+    return stored->status;
+}
+
+llvm::ErrorOr<llvm::vfs::Status> PrefetchFileSystem::status(const llvm::Twine &path)
+{
+    const string pathStr = path.str();
+    if (!llvm::sys::path::is_absolute(pathStr))
+        return ProxyFileSystem::status(path); // Depends on the working directory
+
+    return lookup(pathStr, nullptr);
+}
+
+llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>> PrefetchFileSystem::openFileForRead(const llvm::Twine &path)
+{
+    const string pathStr = path.str();
+    if (!llvm::sys::path::is_absolute(pathStr))
+        return ProxyFileSystem::openFileForRead(path);
+
+    const llvm::MemoryBuffer *contents = nullptr;
+    const llvm::ErrorOr<llvm::vfs::Status> status = lookup(pathStr, &contents);
+    if (!status)
+        return status.getError();
+    if (!contents)
+        return ProxyFileSystem::openFileForRead(path); // Not a regular file, or it failed to read
+
+    return std::unique_ptr<llvm::vfs::File>(new CachedFile(*status, *contents));
+}
+
+void PrefetchFileSystem::prefetch(vector<string> files, unsigned int numThreads)
+{
+    stopPrefetching();
+    m_prefetchedFiles = std::move(files);
+    m_nextPrefetchedFile = 0;
+
+    for (unsigned int i = 0; i < numThreads; ++i) {
+        m_prefetchThreads.emplace_back([this] {
+            for (size_t next = m_nextPrefetchedFile++; next < m_prefetchedFiles.size(); next = m_nextPrefetchedFile++) {
+                const string &file = m_prefetchedFiles[next];
+                const llvm::MemoryBuffer *contents = nullptr;
+                if (llvm::sys::path::is_absolute(file))
+                    lookup(file, &contents);
+            }
+        });
+    }
+}
+
+void PrefetchFileSystem::stopPrefetching()
+{
+    m_nextPrefetchedFile = m_prefetchedFiles.size();
+    for (std::thread &thread : m_prefetchThreads)
+        thread.join();
+    m_prefetchThreads.clear();
+}
+
+size_t PrefetchFileSystem::numCachedFiles() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+#endif
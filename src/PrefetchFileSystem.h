@@ -0,0 +1,96 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_PREFETCH_FILE_SYSTEM_H
+#define CLAZY_PREFETCH_FILE_SYSTEM_H
+
+#include <llvm/Config/llvm-config.h>
+
+#if LLVM_VERSION_MAJOR >= 12
+# define CLAZY_HAS_PREFETCH_FILE_SYSTEM // Needs ClangTool's BaseFS
+
+#include <llvm/ADT/IntrusiveRefCntPtr.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/ADT/Twine.h>
+#include <llvm/Support/ErrorOr.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/VirtualFileSystem.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * File system for clazy-standalone -prefetch-files, shared by the ClangTools of all -j workers.
+ *
+ * The status and the contents of files read by absolute path are kept in memory for the whole run, missing files
+ * included, so the headers shared by translation units are only looked up and read once. On network file systems
+ * each of those is a round trip. prefetch() reads files on threads of its own, ahead of the translation units
+ * needing them. Files aren't expected to change during the run.
+ *
+ * Thread-safe.
+ */
+class PrefetchFileSystem : public llvm::vfs::ProxyFileSystem
+{
+public:
+    explicit PrefetchFileSystem(llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fs);
+    ~PrefetchFileSystem() override;
+
+    llvm::ErrorOr<llvm::vfs::Status> status(const llvm::Twine &path) override;
+    llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>> openFileForRead(const llvm::Twine &path) override;
+
+    /**
+     * Starts reading files with numThreads threads, returns immediately. Relative paths are ignored.
+     */
+    void prefetch(std::vector<std::string> files, unsigned int numThreads);
+
+    // Stops reading files ahead, the ones already read stay available
+    void stopPrefetching();
+
+    size_t numCachedFiles() const;
+
+private:
+    struct Entry {
+        llvm::ErrorOr<llvm::vfs::Status> status;
+        std::unique_ptr<llvm::MemoryBuffer> contents; // Null if not read yet, or not a regular file
+    };
+
+    /**
+     * Returns the status of an absolute path. If contents is non-null, the file is read too, and contents set
+     * to them, or to nullptr if it isn't a regular file or failed to read. They live as long as the file system.
+     */
+    llvm::ErrorOr<llvm::vfs::Status> lookup(const std::string &path, const llvm::MemoryBuffer **contents);
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, std::unique_ptr<Entry>> m_entries; // Never removed
+    std::vector<std::string> m_prefetchedFiles;
+    std::atomic<size_t> m_nextPrefetchedFile;
+    std::vector<std::thread> m_prefetchThreads;
+};
+
+#endif
+
+#endif
@@ -0,0 +1,155 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "PreprocessorDispatcher.h"
+
+#include <clang/Basic/IdentifierTable.h>
+#include <clang/Lex/Preprocessor.h>
+#include <clang/Lex/Token.h>
+
+using namespace clang;
+using namespace std;
+
+enum {
+    MacroExpandsIndex = 0,
+    MacroDefinedIndex,
+    DefinedIndex,
+    IfdefIndex,
+    IfndefIndex,
+    IfIndex,
+    ElifIndex,
+    ElseIndex,
+    EndifIndex,
+    MacroUndefinedIndex,
+    FileChangedIndex
+};
+
+PreprocessorDispatcher::PreprocessorDispatcher(Preprocessor &pp)
+    : m_pp(pp)
+{
+}
+
+void PreprocessorDispatcher::subscribe(PPCallbacks *callbacks, PreprocessorEvents events, llvm::ArrayRef<llvm::StringRef> macroNames)
+{
+    m_callbacks.push_back(std::unique_ptr<PPCallbacks>(callbacks));
+
+    for (int i = 0; i < NumEvents; ++i) {
+        if (!(events & (1 << i)))
+            continue;
+
+        EventSubscribers &subscribers = m_subscribers[i];
+        const bool isMacroEvent = i <= IfndefIndex || i == MacroUndefinedIndex;
+        if (!isMacroEvent || macroNames.empty()) {
+            subscribers.all.push_back(callbacks);
+            continue;
+        }
+
+        for (llvm::StringRef name : macroNames)
+            subscribers.byMacro[m_pp.getIdentifierInfo(name)].push_back(callbacks);
+    }
+}
+
+template <typename Func>
+void PreprocessorDispatcher::dispatch(int eventIndex, const Token &macroNameTok, Func func) const
+{
+    const EventSubscribers &subscribers = m_subscribers[eventIndex];
+    for (PPCallbacks *callbacks : subscribers.all)
+        func(callbacks);
+
+    if (subscribers.byMacro.empty())
+        return;
+
+    const IdentifierInfo *ii = macroNameTok.getIdentifierInfo();
+    if (!ii)
+        return;
+
+    auto it = subscribers.byMacro.find(ii);
+    if (it == subscribers.byMacro.end())
+        return;
+
+    for (PPCallbacks *callbacks : it->second)
+        func(callbacks);
+}
+
+template <typename Func>
+void PreprocessorDispatcher::dispatch(int eventIndex, Func func) const
+{
+    for (PPCallbacks *callbacks : m_subscribers[eventIndex].all)
+        func(callbacks);
+}
+
+void PreprocessorDispatcher::MacroExpands(const Token &macroNameTok, const MacroDefinition &md,
+                                          SourceRange range, const MacroArgs *args)
+{
+    dispatch(MacroExpandsIndex, macroNameTok, [&] (PPCallbacks *c) { c->MacroExpands(macroNameTok, md, range, args); });
+}
+
+void PreprocessorDispatcher::MacroDefined(const Token &macroNameTok, const MacroDirective *md)
+{
+    dispatch(MacroDefinedIndex, macroNameTok, [&] (PPCallbacks *c) { c->MacroDefined(macroNameTok, md); });
+}
+
+void PreprocessorDispatcher::MacroUndefined(const Token &macroNameTok, const MacroDefinition &md, const MacroDirective *undef)
+{
+    dispatch(MacroUndefinedIndex, macroNameTok, [&] (PPCallbacks *c) { c->MacroUndefined(macroNameTok, md, undef); });
+}
+
+void PreprocessorDispatcher::Defined(const Token &macroNameTok, const MacroDefinition &md, SourceRange range)
+{
+    dispatch(DefinedIndex, macroNameTok, [&] (PPCallbacks *c) { c->Defined(macroNameTok, md, range); });
+}
+
+void PreprocessorDispatcher::Ifdef(SourceLocation loc, const Token &macroNameTok, const MacroDefinition &md)
+{
+    dispatch(IfdefIndex, macroNameTok, [&] (PPCallbacks *c) { c->Ifdef(loc, macroNameTok, md); });
+}
+
+void PreprocessorDispatcher::Ifndef(SourceLocation loc, const Token &macroNameTok, const MacroDefinition &md)
+{
+    dispatch(IfndefIndex, macroNameTok, [&] (PPCallbacks *c) { c->Ifndef(loc, macroNameTok, md); });
+}
+
+void PreprocessorDispatcher::If(SourceLocation loc, SourceRange conditionRange, PPCallbacks::ConditionValueKind conditionValue)
+{
+    dispatch(IfIndex, [&] (PPCallbacks *c) { c->If(loc, conditionRange, conditionValue); });
+}
+
+void PreprocessorDispatcher::Elif(SourceLocation loc, SourceRange conditionRange, PPCallbacks::ConditionValueKind conditionValue, SourceLocation ifLoc)
+{
+    dispatch(ElifIndex, [&] (PPCallbacks *c) { c->Elif(loc, conditionRange, conditionValue, ifLoc); });
+}
+
+void PreprocessorDispatcher::Else(SourceLocation loc, SourceLocation ifLoc)
+{
+    dispatch(ElseIndex, [&] (PPCallbacks *c) { c->Else(loc, ifLoc); });
+}
+
+void PreprocessorDispatcher::Endif(SourceLocation loc, SourceLocation ifLoc)
+{
+    dispatch(EndifIndex, [&] (PPCallbacks *c) { c->Endif(loc, ifLoc); });
+}
+
+void PreprocessorDispatcher::FileChanged(SourceLocation loc, PPCallbacks::FileChangeReason reason,
+                                         SrcMgr::CharacteristicKind fileType, FileID prevFid)
+{
+    dispatch(FileChangedIndex, [&] (PPCallbacks *c) { c->FileChanged(loc, reason, fileType, prevFid); });
+}
@@ -0,0 +1,117 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_PREPROCESSOR_DISPATCHER_H
+#define CLAZY_PREPROCESSOR_DISPATCHER_H
+
+#include <clang/Lex/PPCallbacks.h>
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringRef.h>
+
+#include <memory>
+#include <vector>
+
+namespace clang {
+class IdentifierInfo;
+class Preprocessor;
+class Token;
+}
+
+enum PreprocessorEvent {
+    PreprocessorEvent_MacroExpands = 1,
+    PreprocessorEvent_MacroDefined = 2,
+    PreprocessorEvent_Defined = 4,
+    PreprocessorEvent_Ifdef = 8,
+    PreprocessorEvent_Ifndef = 16,
+    PreprocessorEvent_If = 32,
+    PreprocessorEvent_Elif = 64,
+    PreprocessorEvent_Else = 128,
+    PreprocessorEvent_Endif = 256,
+    PreprocessorEvent_MacroUndefined = 512,
+    PreprocessorEvent_FileChanged = 1024,
+    PreprocessorEvent_All = 2047
+};
+typedef int PreprocessorEvents;
+
+/**
+ * The only PPCallbacks clazy adds to the Preprocessor. It forwards each event to the callbacks subscribed to it,
+ * instead of going through a chain with one PPCallbacks per check.
+ *
+ * The events about a macro (MacroExpands, MacroDefined, MacroUndefined, Defined, Ifdef and Ifndef) can be restricted to
+ * some macro names, so a macro nobody is interested in costs one lookup. If, Elif, Else, Endif and FileChanged go to every
+ * subscriber.
+ *
+ * Owned by the Preprocessor, see ClazyContext::preprocessorDispatcher().
+ */
+class PreprocessorDispatcher
+    : public clang::PPCallbacks
+{
+public:
+    PreprocessorDispatcher(const PreprocessorDispatcher &) = delete;
+    explicit PreprocessorDispatcher(clang::Preprocessor &pp);
+
+    /**
+     * Forwards events to callbacks, which is now owned by the dispatcher.
+     * If macroNames isn't empty, the macro events are only forwarded for those macros.
+     */
+    void subscribe(clang::PPCallbacks *callbacks, PreprocessorEvents events, llvm::ArrayRef<llvm::StringRef> macroNames = {});
+
+    void MacroExpands(const clang::Token &macroNameTok, const clang::MacroDefinition &,
+                      clang::SourceRange, const clang::MacroArgs *) override;
+    void MacroDefined(const clang::Token &macroNameTok, const clang::MacroDirective *) override;
+    void MacroUndefined(const clang::Token &macroNameTok, const clang::MacroDefinition &, const clang::MacroDirective *) override;
+    void Defined(const clang::Token &macroNameTok, const clang::MacroDefinition &, clang::SourceRange) override;
+    void Ifdef(clang::SourceLocation, const clang::Token &macroNameTok, const clang::MacroDefinition &) override;
+    void Ifndef(clang::SourceLocation, const clang::Token &macroNameTok, const clang::MacroDefinition &) override;
+    void If(clang::SourceLocation, clang::SourceRange, clang::PPCallbacks::ConditionValueKind) override;
+    void Elif(clang::SourceLocation, clang::SourceRange, clang::PPCallbacks::ConditionValueKind, clang::SourceLocation ifLoc) override;
+    void Else(clang::SourceLocation, clang::SourceLocation ifLoc) override;
+    void Endif(clang::SourceLocation, clang::SourceLocation ifLoc) override;
+    void FileChanged(clang::SourceLocation, clang::PPCallbacks::FileChangeReason, clang::SrcMgr::CharacteristicKind,
+                     clang::FileID prevFid) override;
+
+private:
+    enum {
+        NumEvents = 11
+    };
+
+    typedef llvm::SmallVector<clang::PPCallbacks *, 2> Subscribers;
+
+    struct EventSubscribers {
+        Subscribers all; // Not restricted to any macro
+        llvm::DenseMap<const clang::IdentifierInfo *, Subscribers> byMacro;
+    };
+
+    template <typename Func>
+    void dispatch(int eventIndex, const clang::Token &macroNameTok, Func func) const;
+
+    template <typename Func>
+    void dispatch(int eventIndex, Func func) const;
+
+    clang::Preprocessor &m_pp;
+    EventSubscribers m_subscribers[NumEvents]; // Indexed by the PreprocessorEvent's bit
+    std::vector<std::unique_ptr<clang::PPCallbacks>> m_callbacks;
+};
+
+#endif
@@ -0,0 +1,111 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "QtRegistry.h"
+#include "QtUtils.h"
+#include "clazy_stl.h"
+
+#include <clang/AST/ASTContext.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/Basic/IdentifierTable.h>
+#include <clang/Basic/OperatorKinds.h>
+
+#include <string>
+#include <unordered_map>
+
+using namespace clang;
+using namespace std;
+
+QtRegistry::QtRegistry(ASTContext &context)
+    : m_context(context)
+{
+    for (const auto &it : clazy::detachingMethodsWithConstCounterParts()) {
+        DetachingMethods &methods = m_detachingMethods[&m_context.Idents.get(it.first)];
+        for (StringRef name : it.second)
+            methods.withConstCounterParts.push_back(declarationName(name));
+    }
+
+    for (const auto &it : clazy::detachingMethods()) {
+        DetachingMethods &methods = m_detachingMethods[&m_context.Idents.get(it.first)];
+        for (StringRef name : it.second) {
+            const DeclarationName declName = declarationName(name);
+            if (!clazy::contains(methods.withConstCounterParts, declName))
+                methods.others.push_back(declName);
+        }
+    }
+
+    for (StringRef name : clazy::qtContainers())
+        m_iterableClasses.insert(&m_context.Idents.get(name));
+
+    for (StringRef name : clazy::qtCOWContainers())
+        m_cowClasses.insert(&m_context.Idents.get(name));
+}
+
+DeclarationName QtRegistry::declarationName(StringRef name) const
+{
+    if (name == "operator[]")
+        return m_context.DeclarationNames.getCXXOperatorName(OO_Subscript);
+
+    return DeclarationName(&m_context.Idents.get(name));
+}
+
+// Returns the identifier of a class declared at global scope, as QtUtils matches classes by qualified name
+const IdentifierInfo *QtRegistry::globalIdentifier(const CXXRecordDecl *record)
+{
+    if (!record || !record->getDeclContext()->getRedeclContext()->isTranslationUnit())
+        return nullptr;
+
+    return record->getIdentifier();
+}
+
+bool QtRegistry::isDetachingMethod(const CXXRecordDecl *record, DeclarationName methodName,
+                                   bool onlyWithConstCounterParts) const
+{
+    // Matched by unqualified name, like clazy::detachingMethods() users do
+    if (!record || !record->getIdentifier())
+        return false;
+
+    auto it = m_detachingMethods.find(record->getIdentifier());
+    if (it == m_detachingMethods.end())
+        return false;
+
+    const DetachingMethods &methods = it->second;
+    return clazy::contains(methods.withConstCounterParts, methodName)
+           || (!onlyWithConstCounterParts && clazy::contains(methods.others, methodName));
+}
+
+bool QtRegistry::isQtIterableClass(const CXXRecordDecl *record) const
+{
+    const IdentifierInfo *identifier = globalIdentifier(record);
+    return identifier && m_iterableClasses.count(identifier);
+}
+
+bool QtRegistry::isQtCOWIterableClass(const CXXRecordDecl *record) const
+{
+    const IdentifierInfo *identifier = globalIdentifier(record);
+    return identifier && m_cowClasses.count(identifier);
+}
+
+bool QtRegistry::isQtCOWIterator(const CXXRecordDecl *itRecord) const
+{
+    return itRecord && isQtCOWIterableClass(llvm::dyn_cast<CXXRecordDecl>(itRecord->getParent()));
+}
@@ -0,0 +1,91 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_QT_REGISTRY_H
+#define CLAZY_QT_REGISTRY_H
+
+#include <clang/AST/DeclarationName.h>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/SmallPtrSet.h>
+#include <llvm/ADT/StringRef.h>
+
+#include <vector>
+
+namespace clang {
+class ASTContext;
+class CXXRecordDecl;
+class IdentifierInfo;
+class NamedDecl;
+}
+
+/**
+ * The Qt classes and methods most queried by the checks, resolved to identifiers once per translation unit.
+ *
+ * Queries compare pointers instead of strings and don't allocate, unlike the name based helpers in QtUtils.h,
+ * which are still the reference for which classes and methods are listed.
+ *
+ * Get it with ClazyContext::qtRegistry().
+ */
+class QtRegistry
+{
+public:
+    explicit QtRegistry(clang::ASTContext &context);
+
+    /**
+     * Returns true if calling a method named methodName on a non-const record detaches it.
+     * If onlyWithConstCounterParts is true, only methods which have a const overload are considered.
+     * Equivalent to looking up clazy::detachingMethods() or clazy::detachingMethodsWithConstCounterParts().
+     */
+    bool isDetachingMethod(const clang::CXXRecordDecl *record, clang::DeclarationName methodName,
+                           bool onlyWithConstCounterParts = false) const;
+
+    /**
+     * Equivalent to clazy::isQtIterableClass(), without building the qualified name.
+     */
+    bool isQtIterableClass(const clang::CXXRecordDecl *record) const;
+
+    /**
+     * Equivalent to clazy::isQtCOWIterableClass(), without building the qualified name.
+     */
+    bool isQtCOWIterableClass(const clang::CXXRecordDecl *record) const;
+
+    /**
+     * Equivalent to clazy::isQtCOWIterator(), without building the qualified name.
+     */
+    bool isQtCOWIterator(const clang::CXXRecordDecl *itRecord) const;
+
+private:
+    struct DetachingMethods {
+        std::vector<clang::DeclarationName> withConstCounterParts;
+        std::vector<clang::DeclarationName> others;
+    };
+
+    clang::DeclarationName declarationName(llvm::StringRef name) const;
+    static const clang::IdentifierInfo *globalIdentifier(const clang::CXXRecordDecl *record);
+
+    clang::ASTContext &m_context;
+    llvm::DenseMap<const clang::IdentifierInfo *, DetachingMethods> m_detachingMethods;
+    llvm::SmallPtrSet<const clang::IdentifierInfo *, 32> m_iterableClasses;
+    llvm::SmallPtrSet<const clang::IdentifierInfo *, 32> m_cowClasses;
+};
+
+#endif
@@ -59,21 +59,21 @@ const vector<StringRef> & clazy::qtCOWContainers()
 }
 
 
-std::unordered_map<string, std::vector<StringRef>> clazy::detachingMethods()
+const std::unordered_map<string, std::vector<StringRef>> & clazy::detachingMethods()
 {
-    static std::unordered_map<string, std::vector<StringRef>> map;
-    if (map.empty()) {
-        map = detachingMethodsWithConstCounterParts();
+    static const std::unordered_map<string, std::vector<StringRef>> s_map = [] {
+        auto map = detachingMethodsWithConstCounterParts();
         map["QVector"].push_back("fill");
-    }
+        return map;
+    }();
 
-    return map;
+    return s_map;
 }
 
-std::unordered_map<string, std::vector<StringRef>> clazy::detachingMethodsWithConstCounterParts()
+const std::unordered_map<string, std::vector<StringRef>> & clazy::detachingMethodsWithConstCounterParts()
 {
-    static std::unordered_map<string, std::vector<StringRef>> map;
-    if (map.empty()) {
+    static const std::unordered_map<string, std::vector<StringRef>> s_map = [] {
+        std::unordered_map<string, std::vector<StringRef>> map;
         map["QList"] = {"first", "last", "begin", "end", "front", "back", "operator[]"};
         map["QVector"] = {"first", "last", "begin", "end", "front", "back", "data", "operator[]" };
         map["QMap"] = {"begin", "end", "first", "find", "last", "operator[]", "lowerBound", "upperBound" };
@@ -89,9 +89,10 @@ std::unordered_map<string, std::vector<StringRef>> clazy::detachingMethodsWithCo
         map["QString"] = {"begin", "end", "data", "operator[]"};
         map["QByteArray"] = {"data", "operator[]"};
         map["QImage"] = {"bits", "scanLine"};
-    }
+        return map;
+    }();
 
-    return map;
+    return s_map;
 }
 
 bool clazy::isQtCOWIterableClass(clang::CXXRecordDecl *record)
@@ -140,6 +141,58 @@ bool clazy::isQObject(clang::QualType qt)
     return t ? isQObject(t->getAsCXXRecordDecl()) : false;
 }
 
+bool clazy::isGuiClass(const CXXRecordDecl *record)
+{
+    return clazy::derivesFrom(record, "QWidget") || clazy::derivesFrom(record, "QQuickItem")
+        || clazy::derivesFrom(record, "QWindow");
+}
+
+namespace {
+
+struct HotMethod {
+    const char *className;
+    const char *methodName;
+    bool returnsText;
+};
+
+}
+
+bool clazy::isHotMethod(const CXXMethodDecl *method, bool *returnsText)
+{
+    static const HotMethod hotMethods[] = {
+        { "QWidget", "paintEvent", false },
+        { "QWidget", "resizeEvent", false },
+        { "QGraphicsItem", "paint", false },
+        { "QAbstractItemDelegate", "paint", false },
+        { "QAbstractItemDelegate", "sizeHint", false },
+        { "QStyledItemDelegate", "initStyleOption", false },
+        { "QStyle", "drawPrimitive", false },
+        { "QStyle", "drawControl", false },
+        { "QStyle", "drawComplexControl", false },
+        { "QQuickItem", "updatePaintNode", false },
+        { "QQuickPaintedItem", "paint", false },
+        { "QAbstractItemModel", "data", true },
+        { "QAbstractItemModel", "headerData", true }
+    };
+
+    const StringRef methodName = clazy::name(method);
+    const StringRef className = clazy::name(method->getParent());
+    for (const HotMethod &hot : hotMethods) {
+        if (methodName == hot.methodName && className == hot.className) {
+            if (returnsText)
+                *returnsText = hot.returnsText;
+            return true;
+        }
+    }
+
+    for (const CXXMethodDecl *overridden : method->overridden_methods()) {
+        if (isHotMethod(overridden, returnsText))
+            return true;
+    }
+
+    return false;
+}
+
 bool clazy::isConvertibleTo(const Type *source, const Type *target)
 {
     if (!source || !target)
@@ -234,7 +287,7 @@ clang::CXXRecordDecl *clazy::getQObjectBaseClass(clang::CXXRecordDecl *recordDec
 
 bool clazy::isConnect(FunctionDecl *func)
 {
-    return func && func->getQualifiedNameAsString() == "QObject::connect";
+    return clazy::qualifiedNameIs(func, "QObject::connect");
 }
 
 bool clazy::connectHasPMFStyle(FunctionDecl *func)
@@ -125,14 +125,15 @@ const std::vector<llvm::StringRef> & qtCOWContainers();
 
 /**
  * Returns a map with the list of method names that detach each container.
+ * For queries on AST nodes prefer ClazyContext::qtRegistry(), which doesn't compare strings.
  */
-std::unordered_map<std::string, std::vector<llvm::StringRef>> detachingMethods();
+const std::unordered_map<std::string, std::vector<llvm::StringRef>> & detachingMethods();
 
 /**
  * Returns a map with the list of method names that detach each container, but only those methods
  * with const counterparts.
  */
-std::unordered_map<std::string, std::vector<llvm::StringRef>> detachingMethodsWithConstCounterParts();
+const std::unordered_map<std::string, std::vector<llvm::StringRef>> & detachingMethodsWithConstCounterParts();
 
 /**
  * Returns true if a type represents a Qt container class.
@@ -160,6 +161,18 @@ bool isQObject(const clang::CXXRecordDecl *decl);
  */
 bool isQObject(clang::QualType);
 
+/**
+ * Returns true if record is or derives from QWidget, QQuickItem or QWindow, which live in the GUI thread
+ */
+bool isGuiClass(const clang::CXXRecordDecl *record);
+
+/**
+ * Returns true if method is, or overrides, one of the virtuals Qt calls very often, usually once per frame
+ * or once per visible item on every repaint, like QWidget::paintEvent() or QAbstractItemModel::data().
+ * returnsText is set to whether returning text is its job, as for data().
+ */
+bool isHotMethod(const clang::CXXMethodDecl *method, bool *returnsText = nullptr);
+
 /**
  * Convertible means that a signal with of type source can connect to a signal/slot of type target
  */
@@ -307,10 +320,14 @@ inline bool is_qobject_cast(clang::Stmt *s, clang::CXXRecordDecl **castTo = null
     return false;
 }
 
+inline bool isUIFile(llvm::StringRef filename)
+{
+    return filename.startswith("ui_") && filename.endswith(".h");
+}
+
 inline bool isUIFile(clang::SourceLocation loc, const clang::SourceManager &sm)
 {
-    const std::string filename = Utils::filenameForLoc(loc, sm);
-    return clazy::startsWith(filename, "ui_") && clazy::endsWith(filename, ".h");
+    return isUIFile(Utils::filenameForLoc(loc, sm));
 }
 
 }
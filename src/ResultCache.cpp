@@ -0,0 +1,207 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "ResultCache.h"
+
+#include <clang/Basic/FileManager.h>
+#include <clang/Tooling/CompilationDatabase.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <tuple>
+#include <utility>
+
+using namespace clang;
+using namespace std;
+
+static const char s_magic[] = "clazy-result-1";
+
+static string md5(llvm::StringRef contents)
+{
+    llvm::MD5 hash;
+    hash.update(contents);
+    llvm::MD5::MD5Result result;
+    hash.final(result);
+    llvm::SmallString<32> hexHash;
+    llvm::MD5::stringifyResult(result, hexHash);
+    return hexHash.str().str();
+}
+
+// Returns an empty string if the file can't be read
+static string md5OfFile(llvm::StringRef filename)
+{
+    auto buffer = llvm::MemoryBuffer::getFile(filename);
+    return buffer ? md5((*buffer)->getBuffer()) : string();
+}
+
+ResultCache::ResultCache(const string &cacheDir, const string &configuration)
+    : m_cacheDir(cacheDir)
+    , m_configuration(configuration)
+{
+    llvm::sys::fs::create_directories(m_cacheDir);
+}
+
+string ResultCache::keyFor(const string &filename, const vector<tooling::CompileCommand> &commands) const
+{
+    string key = m_configuration + '\n' + filename;
+    for (const tooling::CompileCommand &command : commands) {
+        key += '\n' + command.Directory;
+        for (const string &arg : command.CommandLine)
+            key += '\n' + arg;
+    }
+
+    return md5(key);
+}
+
+string ResultCache::filenameFor(const string &key) const
+{
+    return m_cacheDir + '/' + key + ".clazy-result";
+}
+
+bool ResultCache::lookup(const string &key, string &output, int &result, vector<string> *dependencies) const
+{
+    auto buffer = llvm::MemoryBuffer::getFile(filenameFor(key));
+    if (!buffer)
+        return false;
+
+    // Format: magic, exit code, number of dependencies, one "<md5> <filename>" line per dependency, then the output
+    llvm::StringRef contents = (*buffer)->getBuffer();
+    llvm::StringRef line;
+    std::tie(line, contents) = contents.split('\n');
+    if (line != s_magic)
+        return false;
+
+    std::tie(line, contents) = contents.split('\n');
+    int storedResult = 0;
+    if (line.getAsInteger(10, storedResult))
+        return false;
+
+    std::tie(line, contents) = contents.split('\n');
+    unsigned int numDependencies = 0;
+    if (line.getAsInteger(10, numDependencies))
+        return false;
+
+    vector<string> filenames;
+    filenames.reserve(numDependencies);
+    for (unsigned int i = 0; i < numDependencies; ++i) {
+        std::tie(line, contents) = contents.split('\n');
+        llvm::StringRef hash, filename;
+        std::tie(hash, filename) = line.split(' ');
+        if (filename.empty() || md5OfFile(filename) != hash)
+            return false;
+        filenames.push_back(filename.str());
+    }
+
+    if (dependencies)
+        *dependencies = std::move(filenames);
+
+    output = contents.str();
+    result = storedResult;
+    return true;
+}
+
+vector<string> ResultCache::storedDependencies(const string &key) const
+{
+    vector<string> filenames;
+    auto buffer = llvm::MemoryBuffer::getFile(filenameFor(key));
+    if (!buffer)
+        return filenames;
+
+    // Same format as for lookup()
+    llvm::StringRef contents = (*buffer)->getBuffer();
+    llvm::StringRef line;
+    std::tie(line, contents) = contents.split('\n');
+    if (line != s_magic)
+        return filenames;
+
+    contents = contents.split('\n').second; // The exit code
+    std::tie(line, contents) = contents.split('\n');
+    unsigned int numDependencies = 0;
+    if (line.getAsInteger(10, numDependencies))
+        return filenames;
+
+    filenames.reserve(numDependencies);
+    for (unsigned int i = 0; i < numDependencies && !contents.empty(); ++i) {
+        std::tie(line, contents) = contents.split('\n');
+        const llvm::StringRef filename = line.split(' ').second;
+        if (!filename.empty())
+            filenames.push_back(filename.str());
+    }
+
+    return filenames;
+}
+
+vector<string> ResultCache::dependenciesOf(const FileManager &files)
+{
+    llvm::SmallVector<const FileEntry *, 128> entries;
+    files.GetUniqueIDMapping(entries);
+
+    vector<string> names;
+    names.reserve(entries.size());
+    for (const FileEntry *entry : entries) {
+        if (!entry)
+            continue;
+
+        // The name can be relative to the compile command's directory
+        llvm::StringRef name = entry->tryGetRealPathName();
+        if (name.empty())
+            name = entry->getName();
+        names.push_back(name.str());
+    }
+
+    return names;
+}
+
+void ResultCache::store(const string &key, const FileManager &files, const string &output, int result) const
+{
+    string contents = string(s_magic) + '\n' + std::to_string(result) + '\n';
+    string dependencies;
+    unsigned int numDependencies = 0;
+    for (const string &name : dependenciesOf(files)) {
+        const string hash = md5OfFile(name);
+        if (hash.empty())
+            return; // Not a real file, we can't tell if it changed
+        dependencies += hash + ' ' + name + '\n';
+        ++numDependencies;
+    }
+    contents += std::to_string(numDependencies) + '\n' + dependencies + output;
+
+    // Write to a temporary first, so concurrent clazy processes never read a partial file
+    const string filename = filenameFor(key);
+    int fd = -1;
+    llvm::SmallString<128> tmpFilename;
+    if (llvm::sys::fs::createUniqueFile(filename + "-%%%%%%", fd, tmpFilename))
+        return;
+
+    {
+        llvm::raw_fd_ostream os(fd, /*shouldClose=*/ true);
+        os << contents;
+    }
+
+    if (llvm::sys::fs::rename(tmpFilename, filename))
+        llvm::sys::fs::remove(tmpFilename);
+}
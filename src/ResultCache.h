@@ -0,0 +1,82 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_RESULT_CACHE_H
+#define CLAZY_RESULT_CACHE_H
+
+#include <string>
+#include <vector>
+
+namespace clang {
+class FileManager;
+namespace tooling {
+struct CompileCommand;
+}
+}
+
+/**
+ * Cache of whole translation unit results, used by clazy-standalone -cache-dir.
+ *
+ * An entry is keyed by the clazy configuration plus the file's compile commands, and stores the
+ * printed diagnostics, the exit code and the content hash of every file the translation unit read.
+ * If none of those files changed the diagnostics are printed again without parsing anything.
+ *
+ * Methods are thread-safe, as -j uses the same cache from several threads.
+ */
+class ResultCache
+{
+public:
+    ResultCache(const std::string &cacheDir, const std::string &configuration);
+
+    std::string keyFor(const std::string &filename, const std::vector<clang::tooling::CompileCommand> &commands) const;
+
+    /**
+     * Returns true if there's a stored result under key and its input files didn't change.
+     * If dependencies is non-null it's set to the names of those files.
+     */
+    bool lookup(const std::string &key, std::string &output, int &result,
+                std::vector<std::string> *dependencies = nullptr) const;
+
+    /**
+     * Stores the result of a translation unit. files must be the FileManager it was parsed with.
+     */
+    void store(const std::string &key, const clang::FileManager &files, const std::string &output, int result) const;
+
+    /**
+     * Returns the names of the files the translation unit stored under key read, whether they changed since or not.
+     * Empty if there's no such entry.
+     */
+    std::vector<std::string> storedDependencies(const std::string &key) const;
+
+    /**
+     * Returns the names of the files a translation unit read, files being the FileManager it was parsed with.
+     */
+    static std::vector<std::string> dependenciesOf(const clang::FileManager &files);
+
+private:
+    std::string filenameFor(const std::string &key) const;
+
+    const std::string m_cacheDir;
+    const std::string m_configuration;
+};
+
+#endif
@@ -0,0 +1,149 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "RewrittenCompilations.h"
+#include "UnityTranslationUnits.h"
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+
+#include <algorithm>
+#include <unordered_set>
+#include <utility>
+
+using namespace clang::tooling;
+using namespace std;
+
+RewrittenCompilations::RewrittenCompilations(const CompilationDatabase &compilations,
+                                             const vector<string> &removedArgPrefixes, bool stripPch)
+    : m_compilations(compilations)
+    , m_removedArgPrefixes(removedArgPrefixes)
+    , m_stripPch(stripPch)
+{
+}
+
+bool RewrittenCompilations::isPrecompiledHeader(llvm::StringRef arg, const string &directory)
+{
+    if (arg.endswith(".pch") || arg.endswith(".gch") || arg.contains("cmake_pch") || arg.startswith(".pch/") || arg.contains("/.pch/"))
+        return true;
+
+    // gcc looks for foo.h.gch when including foo.h, clang for foo.h.pch
+    llvm::SmallString<256> path(arg);
+    llvm::sys::fs::make_absolute(directory, path);
+    return llvm::sys::fs::exists(path.str() + ".gch") || llvm::sys::fs::exists(path.str() + ".pch");
+}
+
+// Returns how many arguments, starting at i, make an option using a precompiled header, 0 if it's not one
+static size_t precompiledHeaderArgs(const vector<string> &args, size_t i, const string &directory)
+{
+    const llvm::StringRef arg(args[i]);
+    const size_t remaining = args.size() - i;
+
+    if (arg == "-Xclang" && remaining >= 4 && args[i + 2] == "-Xclang") {
+        if (args[i + 1] == "-include-pch")
+            return 4;
+        if (args[i + 1] == "-include" && RewrittenCompilations::isPrecompiledHeader(args[i + 3], directory))
+            return 4;
+        return 0;
+    }
+
+    if (arg == "-include-pch")
+        return std::min<size_t>(remaining, 2);
+
+    if (arg == "-include")
+        return remaining >= 2 && RewrittenCompilations::isPrecompiledHeader(args[i + 1], directory) ? 2 : 0;
+
+    if (arg.startswith("-include") && !arg.startswith("-include-") && RewrittenCompilations::isPrecompiledHeader(arg.drop_front(8), directory))
+        return 1;
+
+    // clang-cl's /Yc, /Yu and /Fp, which also accepts them with a dash
+    if (arg.size() > 2 && (arg[0] == '/' || arg[0] == '-')) {
+        const llvm::StringRef flag = arg.substr(1, 2);
+        if (flag == "Yc" || flag == "Yu" || flag == "Fp")
+            return 1;
+    }
+
+    return 0;
+}
+
+bool RewrittenCompilations::isRemoved(llvm::StringRef arg) const
+{
+    return std::any_of(m_removedArgPrefixes.cbegin(), m_removedArgPrefixes.cend(), [arg](const string &prefix) {
+        return arg.startswith(prefix);
+    });
+}
+
+void RewrittenCompilations::rewrite(CompileCommand &command) const
+{
+    const vector<string> &args = command.CommandLine;
+    vector<string> result;
+    result.reserve(args.size());
+    for (size_t i = 0; i < args.size(); ++i) {
+        const llvm::StringRef arg(args[i]);
+        if (i == 0 || arg == command.Filename) { // The compiler and the input file
+            result.push_back(args[i]);
+            continue;
+        }
+
+        if (m_stripPch) {
+            const size_t numArgs = precompiledHeaderArgs(args, i, command.Directory);
+            if (numArgs > 0) {
+                i += numArgs - 1;
+                continue;
+            }
+        }
+
+        if (isRemoved(arg)) {
+            // The prefix is the whole option, so the next argument can be its value, like in "-include foo.h"
+            const bool isWholeOption = std::find(m_removedArgPrefixes.cbegin(), m_removedArgPrefixes.cend(), arg) != m_removedArgPrefixes.cend();
+            if (isWholeOption && i + 1 < args.size() && !llvm::StringRef(args[i + 1]).startswith("-") && args[i + 1] != command.Filename)
+                ++i;
+            continue;
+        }
+
+        result.push_back(args[i]);
+    }
+
+    command.CommandLine = std::move(result);
+}
+
+vector<CompileCommand> RewrittenCompilations::getCompileCommands(llvm::StringRef filename) const
+{
+    vector<CompileCommand> commands = m_compilations.getCompileCommands(filename);
+    const bool rewrites = m_stripPch || !m_removedArgPrefixes.empty();
+    if (commands.size() == 1 && !rewrites)
+        return commands;
+
+    // Only the files written differ when a build compiles a file twice, for example into a static and a shared library
+    unordered_set<string> keys;
+    vector<CompileCommand> result;
+    result.reserve(commands.size());
+    for (CompileCommand &command : commands) {
+        if (rewrites)
+            rewrite(command);
+        if (keys.insert(UnityTranslationUnits::commandKey(command, filename)).second)
+            result.push_back(std::move(command));
+    }
+
+    return result;
+}
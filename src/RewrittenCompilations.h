@@ -0,0 +1,64 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_REWRITTEN_COMPILATIONS_H
+#define CLAZY_REWRITTEN_COMPILATIONS_H
+
+#include <clang/Tooling/CompilationDatabase.h>
+#include <llvm/ADT/StringRef.h>
+
+#include <string>
+#include <vector>
+
+/**
+ * The compilation database clazy-standalone analyzes with, after applying -remove-arg-prefix and -strip-pch.
+ *
+ * Commands are rewritten when asked for, the database is never copied, so there's no preprocessing step even for
+ * huge databases. A file compiled several times with the same command, besides the files written, only gets
+ * one command, so it's not analyzed twice.
+ */
+class RewrittenCompilations
+    : public clang::tooling::CompilationDatabase
+{
+public:
+    RewrittenCompilations(const clang::tooling::CompilationDatabase &compilations,
+                          const std::vector<std::string> &removedArgPrefixes, bool stripPch);
+
+    /**
+     * Returns true if arg, the argument of an -include like option, names a precompiled header, such as CMake's
+     * cmake_pch.hxx or qmake's .pch/ files. directory is the one the command runs in.
+     */
+    static bool isPrecompiledHeader(llvm::StringRef arg, const std::string &directory);
+
+    std::vector<std::string> getAllFiles() const override { return m_compilations.getAllFiles(); }
+    std::vector<clang::tooling::CompileCommand> getCompileCommands(llvm::StringRef filename) const override;
+
+private:
+    void rewrite(clang::tooling::CompileCommand &command) const;
+    bool isRemoved(llvm::StringRef arg) const;
+
+    const clang::tooling::CompilationDatabase &m_compilations;
+    const std::vector<std::string> m_removedArgPrefixes;
+    const bool m_stripPch;
+};
+
+#endif
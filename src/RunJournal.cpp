@@ -0,0 +1,159 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "RunJournal.h"
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <system_error>
+#include <tuple>
+#include <utility>
+
+using namespace std;
+
+static const char s_magic[] = "clazy-journal-1\n";
+
+static string journalFilename(const string &stateDir, llvm::StringRef runKey)
+{
+    llvm::MD5 hash;
+    hash.update(runKey);
+    llvm::MD5::MD5Result result;
+    hash.final(result);
+    llvm::SmallString<32> hexHash;
+    llvm::MD5::stringifyResult(result, hexHash);
+    return stateDir + "/clazy-run-" + hexHash.str().str() + ".journal";
+}
+
+// "<index> <result> <size>\n" followed by the output and a newline, which tells a complete record apart
+static string formatRecord(size_t index, const string &output, int result)
+{
+    return to_string(index) + ' ' + to_string(result) + ' ' + to_string(output.size()) + '\n' + output + '\n';
+}
+
+RunJournal::RunJournal(const string &stateDir, const string &runKey)
+    : m_filename(journalFilename(stateDir, runKey))
+{
+    llvm::sys::fs::create_directories(stateDir);
+}
+
+RunJournal::~RunJournal()
+{
+    // A full disk only means resuming fewer translation units, don't abort
+    if (m_stream)
+        m_stream->clear_error();
+}
+
+bool RunJournal::open()
+{
+    // Parses up to the first incomplete record, the one being written when the run was killed
+    size_t validSize = 0;
+    size_t fileSize = 0;
+    if (auto buffer = llvm::MemoryBuffer::getFile(m_filename)) {
+        llvm::StringRef contents = (*buffer)->getBuffer();
+        fileSize = contents.size();
+        if (contents.startswith(s_magic)) {
+            llvm::StringRef rest = contents.drop_front(sizeof(s_magic) - 1);
+            while (!rest.empty()) {
+                llvm::StringRef header, indexStr, resultStr, sizeStr;
+                std::tie(header, rest) = rest.split('\n');
+                std::tie(indexStr, header) = header.split(' ');
+                std::tie(resultStr, sizeStr) = header.split(' ');
+                size_t index = 0;
+                int result = 0;
+                size_t size = 0;
+                if (indexStr.getAsInteger(10, index) || resultStr.getAsInteger(10, result) || sizeStr.getAsInteger(10, size)
+                    || rest.size() < size + 1 || rest[size] != '\n')
+                    break;
+
+                m_resumed[index] = { rest.take_front(size).str(), result };
+                rest = rest.drop_front(size + 1);
+                validSize = contents.size() - rest.size();
+            }
+        }
+    }
+
+    // Appending after a torn record would hide the ones coming after it, so write the valid ones again
+    std::error_code ec;
+    if (validSize == 0 || validSize != fileSize) {
+        m_stream.reset(new llvm::raw_fd_ostream(m_filename, ec, llvm::sys::fs::F_None));
+        if (ec) {
+            m_stream.reset();
+            return false;
+        }
+
+        *m_stream << s_magic;
+        for (const auto &it : m_resumed)
+            *m_stream << formatRecord(it.first, it.second.output, it.second.result);
+        m_stream->flush();
+    } else {
+#if LLVM_VERSION_MAJOR >= 9
+        const auto flags = llvm::sys::fs::OF_Append;
+#else
+        const auto flags = llvm::sys::fs::F_Append;
+#endif
+        m_stream.reset(new llvm::raw_fd_ostream(m_filename, ec, flags));
+        if (ec) {
+            m_stream.reset();
+            return false;
+        }
+    }
+
+    m_stream->SetUnbuffered(); // Each record is written as a whole, and reaches the OS before the next translation unit starts
+    return !m_stream->has_error();
+}
+
+bool RunJournal::lookup(size_t index, string &output, int &result) const
+{
+    auto it = m_resumed.find(index);
+    if (it == m_resumed.end())
+        return false;
+
+    output = it->second.output;
+    result = it->second.result;
+    return true;
+}
+
+void RunJournal::record(size_t index, const string &output, int result)
+{
+    const string record = formatRecord(index, output, result);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_stream)
+        *m_stream << record;
+}
+
+void RunJournal::finish()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_stream) {
+        m_stream->close();
+        if (m_stream->has_error())
+            m_stream->clear_error(); // Or its destructor aborts
+        m_stream.reset();
+    }
+
+    llvm::sys::fs::remove(m_filename);
+}
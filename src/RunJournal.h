@@ -0,0 +1,79 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_RUN_JOURNAL_H
+#define CLAZY_RUN_JOURNAL_H
+
+#include <llvm/Support/raw_ostream.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * Progress journal of a clazy-standalone run, for -state-dir.
+ *
+ * Each translation unit's diagnostics and exit code are appended as soon as it's done, so a run which was
+ * killed, for example on a preempted CI machine, can be started again with the same arguments and only
+ * analyzes the translation units it didn't finish. The journal is removed once a run completes.
+ *
+ * A record cut short by the kill is dropped when loading. Unlike -cache-dir, the input files aren't hashed,
+ * the run is assumed to be resumed on the same sources.
+ */
+class RunJournal
+{
+public:
+    // runKey identifies the run, like the configuration and the compile commands of the files to analyze
+    RunJournal(const std::string &stateDir, const std::string &runKey);
+    ~RunJournal();
+
+    /**
+     * Loads what the run did before it was interrupted and opens the journal for appending.
+     * Returns false if it can't be written.
+     */
+    bool open();
+
+    // Returns true if the translation unit at index was done by the interrupted run
+    bool lookup(size_t index, std::string &output, int &result) const;
+
+    size_t numResumed() const { return m_resumed.size(); }
+
+    // Thread-safe
+    void record(size_t index, const std::string &output, int result);
+
+    // All translation units are done, the next run with the same arguments starts over
+    void finish();
+
+private:
+    struct Entry {
+        std::string output;
+        int result;
+    };
+
+    const std::string m_filename;
+    std::unordered_map<size_t, Entry> m_resumed;
+    std::unique_ptr<llvm::raw_fd_ostream> m_stream;
+    std::mutex m_mutex;
+};
+
+#endif
@@ -0,0 +1,211 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "RunStats.h"
+#include "StringUtils.h"
+
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+
+#ifndef _WIN32
+# include <sys/resource.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <utility>
+
+using namespace std;
+
+static thread_local vector<TranslationUnitStats> s_recordedTranslationUnits;
+
+void RunStats::recordTranslationUnit(TranslationUnitStats stats)
+{
+    s_recordedTranslationUnits.push_back(std::move(stats));
+}
+
+vector<TranslationUnitStats> RunStats::takeTranslationUnits()
+{
+    vector<TranslationUnitStats> result;
+    result.swap(s_recordedTranslationUnits);
+    return result;
+}
+
+void RunStats::add(TranslationUnitStats stats)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_translationUnits.push_back(std::move(stats));
+}
+
+void RunStats::addCachedTranslationUnit()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_resultCacheHits++;
+}
+
+void RunStats::addUncachedTranslationUnit()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_resultCacheMisses++;
+}
+
+static string formatNumber(double value)
+{
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.3f", value);
+    return buffer;
+}
+
+static string hitsAndRate(uint64_t hits, uint64_t misses)
+{
+    const uint64_t total = hits + misses;
+    return "{ \"hits\": " + to_string(hits) + ", \"misses\": " + to_string(misses)
+           + ", \"hit_rate\": " + formatNumber(total > 0 ? double(hits) / total : 0) + " }";
+}
+
+// p50, p95 and max, using the nearest rank, so they're values that actually occurred
+static string distribution(vector<double> values)
+{
+    if (values.empty())
+        values.push_back(0);
+
+    std::sort(values.begin(), values.end());
+    auto percentile = [&values](double p) {
+        const size_t rank = static_cast<size_t>(std::ceil(p * values.size()));
+        return values[std::max<size_t>(rank, 1) - 1];
+    };
+
+    return "{ \"p50\": " + formatNumber(percentile(0.5)) + ", \"p95\": " + formatNumber(percentile(0.95))
+           + ", \"max\": " + formatNumber(values.back()) + " }";
+}
+
+bool RunStats::writeJson(const string &filename, unsigned int slowestCount) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    struct CheckTotals {
+        double seconds = 0;
+        uint64_t warnings = 0;
+        vector<double> milliseconds; // Per translation unit
+    };
+
+    map<string, CheckTotals> checks; // Sorted, so runs can be diffed
+    vector<double> seconds;
+    vector<double> warnings;
+    vector<double> arenaKB;
+    vector<double> memoryMB;
+    double totalSeconds = 0;
+    uint64_t headerCacheHits = 0;
+    uint64_t headerCacheMisses = 0;
+    for (const TranslationUnitStats &tu : m_translationUnits) {
+        uint64_t tuWarnings = 0;
+        for (const TranslationUnitStats::Check &check : tu.checks) {
+            CheckTotals &totals = checks[check.name];
+            totals.seconds += check.seconds;
+            totals.warnings += check.warnings;
+            totals.milliseconds.push_back(check.seconds * 1000);
+            tuWarnings += check.warnings;
+        }
+
+        seconds.push_back(tu.seconds);
+        warnings.push_back(tuWarnings);
+        arenaKB.push_back(tu.arenaBytes / 1024.0);
+        memoryMB.push_back(tu.memoryBytes / (1024.0 * 1024.0));
+        totalSeconds += tu.seconds;
+        headerCacheHits += tu.headerCacheHits;
+        headerCacheMisses += tu.headerCacheMisses;
+    }
+
+    string json = "{\n";
+    json += "    \"translation_units\": " + to_string(m_translationUnits.size()) + ",\n";
+    json += "    \"seconds\": " + formatNumber(totalSeconds) + ",\n";
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+        const double peakRssMB = usage.ru_maxrss / (1024.0 * 1024.0); // In bytes
+#else
+        const double peakRssMB = usage.ru_maxrss / 1024.0; // In KB
+#endif
+        json += "    \"peak_rss_mb\": " + formatNumber(peakRssMB) + ",\n";
+    }
+#endif
+    json += "    \"header_cache\": " + hitsAndRate(headerCacheHits, headerCacheMisses) + ",\n";
+    json += "    \"result_cache\": " + hitsAndRate(m_resultCacheHits, m_resultCacheMisses) + ",\n";
+    json += "    \"per_translation_unit\": {\n";
+    json += "        \"seconds\": " + distribution(seconds) + ",\n";
+    json += "        \"warnings\": " + distribution(warnings) + ",\n";
+    json += "        \"arena_kb\": " + distribution(arenaKB) + ",\n";
+    json += "        \"memory_mb\": " + distribution(memoryMB) + "\n";
+    json += "    },\n";
+
+    json += "    \"checks\": {";
+    bool first = true;
+    for (const auto &it : checks) {
+        json += first ? "\n        " : ",\n        ";
+        first = false;
+        clazy::appendJsonString(json, it.first);
+        json += ": { \"total_ms\": " + formatNumber(it.second.seconds * 1000) + ", \"warnings\": " + to_string(it.second.warnings)
+                + ", \"per_translation_unit_ms\": " + distribution(it.second.milliseconds) + " }";
+    }
+    json += "\n    },\n";
+
+    // The check taking the longest is where to look first
+    vector<const TranslationUnitStats *> slowest;
+    slowest.reserve(m_translationUnits.size());
+    for (const TranslationUnitStats &tu : m_translationUnits)
+        slowest.push_back(&tu);
+    const size_t numSlowest = std::min<size_t>(slowestCount, slowest.size());
+    std::partial_sort(slowest.begin(), slowest.begin() + numSlowest, slowest.end(),
+                      [](const TranslationUnitStats *tu1, const TranslationUnitStats *tu2) { return tu1->seconds > tu2->seconds; });
+
+    json += "    \"slowest_translation_units\": [";
+    for (size_t i = 0; i < numSlowest; ++i) {
+        const TranslationUnitStats *tu = slowest[i];
+        auto dominant = std::max_element(tu->checks.cbegin(), tu->checks.cend(),
+                                         [](const TranslationUnitStats::Check &c1, const TranslationUnitStats::Check &c2) {
+                                             return c1.seconds < c2.seconds;
+                                         });
+        json += i == 0 ? "\n        { \"file\": " : ",\n        { \"file\": ";
+        clazy::appendJsonString(json, tu->file);
+        json += ", \"seconds\": " + formatNumber(tu->seconds) + ", \"dominant_check\": ";
+        clazy::appendJsonString(json, dominant == tu->checks.cend() ? "" : dominant->name);
+        json += ", \"dominant_check_ms\": " + formatNumber(dominant == tu->checks.cend() ? 0 : dominant->seconds * 1000) + " }";
+    }
+    json += "\n    ]\n}\n";
+
+    std::error_code ec;
+    llvm::raw_fd_ostream os(filename, ec, llvm::sys::fs::F_None);
+    if (ec)
+        return false;
+
+    os << json;
+    os.close();
+    if (os.has_error()) {
+        os.clear_error(); // Or its destructor aborts
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,84 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_RUN_STATS_H
+#define CLAZY_RUN_STATS_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// What clazy did in a translation unit, for clazy-standalone's -stats-json
+struct TranslationUnitStats
+{
+    struct Check {
+        std::string name;
+        double seconds; // AST visits, AST matchers and preprocessor callbacks
+        uint64_t warnings; // Emitted, not counting the ones replayed from the header cache
+    };
+
+    std::string file;
+    double seconds = 0; // Including parsing, set by clazy-standalone
+    uint64_t arenaBytes = 0; // Held by the ClazyContext and the checks
+    uint64_t memoryBytes = 0; // AST, SourceManager, Preprocessor and clazy state at the end, which is about the peak
+    uint64_t headerCacheHits = 0; // Headers whose warnings were replayed from the header cache
+    uint64_t headerCacheMisses = 0;
+    std::vector<Check> checks;
+};
+
+/**
+ * Aggregates the TranslationUnitStats of a whole clazy-standalone run, from the threads of -j, and writes them
+ * as a JSON document: totals, p50, p95 and max per translation unit, and the slowest translation units.
+ */
+class RunStats
+{
+public:
+    /**
+     * Called by ClazyASTConsumer at the end of a translation unit, hands its stats to the thread which called
+     * ClangTool::run(), which is the same one.
+     */
+    static void recordTranslationUnit(TranslationUnitStats stats);
+
+    /**
+     * Returns the stats recorded by this thread since the last call. Empty if the file failed to parse before
+     * the consumer ran.
+     */
+    static std::vector<TranslationUnitStats> takeTranslationUnits();
+
+    void add(TranslationUnitStats stats);
+    void addCachedTranslationUnit(); // Replayed from the -cache-dir
+    void addUncachedTranslationUnit();
+
+    /**
+     * Writes the JSON document, with the slowestCount slowest translation units. Returns false on failure.
+     */
+    bool writeJson(const std::string &filename, unsigned int slowestCount) const;
+
+private:
+    mutable std::mutex m_mutex;
+    std::vector<TranslationUnitStats> m_translationUnits;
+    uint64_t m_resultCacheHits = 0;
+    uint64_t m_resultCacheMisses = 0;
+};
+
+#endif
@@ -0,0 +1,200 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "SarifExporter.h"
+#include "StringUtils.h"
+#include "checkmanager.h"
+
+#include <clang/Basic/Diagnostic.h>
+#include <clang/Basic/FileManager.h>
+#include <clang/Basic/SourceManager.h>
+#include <clang/Basic/LangOptions.h>
+#include <clang/Tooling/Core/Replacement.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <utility>
+
+using namespace clang;
+using namespace std;
+
+SarifExporter::SarifExporter(const SourceManager &sm, const LangOptions &lo, const string &directory)
+    : m_sm(sm)
+    , m_lo(lo)
+{
+    const FileEntry *mainFile = m_sm.getFileEntryForID(m_sm.getMainFileID());
+    if (!mainFile)
+        return;
+
+    // Files with the same name in different directories mustn't overwrite each other
+    llvm::SmallString<256> mainPath(mainFile->getName());
+    llvm::sys::fs::make_absolute(mainPath);
+    llvm::MD5 hash;
+    hash.update(mainPath.str());
+    llvm::MD5::MD5Result result;
+    hash.final(result);
+    llvm::SmallString<32> hexHash;
+    llvm::MD5::stringifyResult(result, hexHash);
+
+    llvm::sys::fs::create_directories(directory);
+    m_filename = directory + '/' + llvm::sys::path::filename(mainPath).str() + '-' + hexHash.str().str() + ".sarif";
+
+    int fd = -1;
+    if (std::error_code ec = llvm::sys::fs::createUniqueFile(m_filename + "-%%%%%%", fd, m_tmpFilename)) {
+        llvm::errs() << "clazy: Failed to create " << m_filename << ": " << ec.message() << "\n";
+        return;
+    }
+
+    m_stream.reset(new llvm::raw_fd_ostream(fd, /*shouldClose=*/ true));
+}
+
+SarifExporter::~SarifExporter()
+{
+    if (!m_stream)
+        return;
+
+    writeHeader();
+    *m_stream << (m_hasResults ? "\n]}]}\n" : "]}]}\n");
+    m_stream->close();
+
+    if (m_stream->has_error()) {
+        llvm::errs() << "clazy: Failed to write " << m_filename << "\n";
+        m_stream->clear_error();
+        llvm::sys::fs::remove(m_tmpFilename);
+    } else if (llvm::sys::fs::rename(m_tmpFilename, m_filename)) {
+        llvm::sys::fs::remove(m_tmpFilename);
+    }
+}
+
+void SarifExporter::addRule(const RegisteredCheck &check)
+{
+    string rule = "{\"id\":";
+    clazy::appendJsonString(rule, check.name);
+    rule += ",\"helpUri\":";
+    clazy::appendJsonString(rule, "https://github.com/KDE/clazy/blob/master/docs/checks/README-" + check.name + ".md");
+    rule += ",\"properties\":{\"level\":" + to_string(check.level) + "}}";
+    m_rules.push_back(std::move(rule));
+}
+
+void SarifExporter::writeHeader()
+{
+    if (m_headerWritten)
+        return;
+
+    m_headerWritten = true;
+    *m_stream << "{\"version\":\"2.1.0\",\"$schema\":\"https://json.schemastore.org/sarif-2.1.0.json\",\"runs\":[{\"tool\":{\"driver\":"
+                 "{\"name\":\"clazy\",\"informationUri\":\"https://github.com/KDE/clazy\",\"rules\":[";
+    for (size_t i = 0; i < m_rules.size(); ++i)
+        *m_stream << (i == 0 ? "\n" : ",\n") << m_rules[i];
+    *m_stream << "]}},\"results\":[";
+
+    m_rules.clear(); // Not needed anymore
+}
+
+string SarifExporter::uriForFile(llvm::StringRef filename) const
+{
+    llvm::SmallString<256> path(filename);
+    llvm::sys::fs::make_absolute(path);
+    string pathStr = path.str().str();
+    std::replace(pathStr.begin(), pathStr.end(), '\\', '/');
+
+    static const char hexDigits[] = "0123456789ABCDEF";
+    string uri = pathStr[0] == '/' ? "file://" : "file:///"; // Windows paths start with the drive letter
+    for (char c : pathStr) {
+        if (isalnum(static_cast<unsigned char>(c)) || strchr("-._~/:", c)) {
+            uri += c;
+        } else {
+            uri += '%';
+            uri += hexDigits[(c >> 4) & 0xf];
+            uri += hexDigits[c & 0xf];
+        }
+    }
+
+    return uri;
+}
+
+void SarifExporter::write(SourceLocation loc, llvm::StringRef checkName, llvm::StringRef message,
+                          bool isError, const vector<FixItHint> &fixits)
+{
+    if (!m_stream)
+        return;
+
+    writeHeader();
+
+    string result = m_hasResults ? ",\n{\"ruleId\":" : "\n{\"ruleId\":";
+    clazy::appendJsonString(result, checkName);
+    result += isError ? ",\"level\":\"error\"" : ",\"level\":\"warning\"";
+    result += ",\"message\":{\"text\":";
+    clazy::appendJsonString(result, message);
+    result += '}';
+
+    const SourceLocation expansionLoc = m_sm.getExpansionLoc(loc);
+    const llvm::StringRef filename = m_sm.getFilename(expansionLoc);
+    if (!filename.empty()) {
+        result += ",\"locations\":[{\"physicalLocation\":{\"artifactLocation\":{\"uri\":";
+        clazy::appendJsonString(result, uriForFile(filename));
+        result += "},\"region\":{\"startLine\":" + to_string(m_sm.getExpansionLineNumber(loc));
+        result += ",\"startColumn\":" + to_string(m_sm.getExpansionColumnNumber(loc)) + "}}}]";
+    }
+
+    // SARIF groups the replacements per file, keep the order in which they came otherwise
+    vector<pair<string, string>> replacementsPerFile;
+    for (const FixItHint &fixit : fixits) {
+        if (fixit.isNull())
+            continue;
+
+        const tooling::Replacement replacement(m_sm, fixit.RemoveRange, fixit.CodeToInsert, m_lo);
+        auto it = std::find_if(replacementsPerFile.begin(), replacementsPerFile.end(), [&replacement](const pair<string, string> &p) {
+            return p.first == replacement.getFilePath();
+        });
+        if (it == replacementsPerFile.end()) {
+            replacementsPerFile.push_back({ replacement.getFilePath().str(), string() });
+            it = replacementsPerFile.end() - 1;
+        } else {
+            it->second += ',';
+        }
+
+        it->second += "{\"deletedRegion\":{\"byteOffset\":" + to_string(replacement.getOffset());
+        it->second += ",\"byteLength\":" + to_string(replacement.getLength()) + "},\"insertedContent\":{\"text\":";
+        clazy::appendJsonString(it->second, replacement.getReplacementText());
+        it->second += "}}";
+    }
+
+    if (!replacementsPerFile.empty()) {
+        result += ",\"fixes\":[{\"artifactChanges\":[";
+        for (size_t i = 0; i < replacementsPerFile.size(); ++i) {
+            result += i == 0 ? "{\"artifactLocation\":{\"uri\":" : ",{\"artifactLocation\":{\"uri\":";
+            clazy::appendJsonString(result, uriForFile(replacementsPerFile[i].first));
+            result += "},\"replacements\":[" + replacementsPerFile[i].second + "]}";
+        }
+        result += "]}]";
+    }
+
+    result += '}';
+    *m_stream << result;
+    m_hasResults = true;
+}
@@ -0,0 +1,85 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_SARIF_EXPORTER_H
+#define CLAZY_SARIF_EXPORTER_H
+
+#include <clang/Basic/SourceLocation.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/StringRef.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace clang {
+class FixItHint;
+class LangOptions;
+class SourceManager;
+}
+
+namespace llvm {
+class raw_fd_ostream;
+}
+
+struct RegisteredCheck;
+
+/**
+ * Writes the warnings of a translation unit as a SARIF 2.1.0 log, for code review tools.
+ *
+ * The log is streamed: the rules (the enabled checks) are written once, before the first result,
+ * then each warning is written as soon as it's emitted, fixits included, so memory use doesn't grow with
+ * the number of warnings. The log is written to a temporary file and renamed when the translation unit is done,
+ * so readers never see an incomplete log.
+ *
+ * Enabled by setting CLAZY_EXPORT_SARIF to a directory. Each translation unit gets its own file in it,
+ * named after the main file.
+ */
+class SarifExporter
+{
+public:
+    SarifExporter(const clang::SourceManager &sm, const clang::LangOptions &lo, const std::string &directory);
+    ~SarifExporter();
+
+    /**
+     * Adds a check to the rules. Must be called before the first write().
+     */
+    void addRule(const RegisteredCheck &check);
+
+    void write(clang::SourceLocation loc, llvm::StringRef checkName, llvm::StringRef message,
+               bool isError, const std::vector<clang::FixItHint> &fixits);
+
+private:
+    void writeHeader();
+    std::string uriForFile(llvm::StringRef filename) const;
+
+    const clang::SourceManager &m_sm;
+    const clang::LangOptions &m_lo;
+    std::string m_filename;
+    llvm::SmallString<128> m_tmpFilename;
+    std::unique_ptr<llvm::raw_fd_ostream> m_stream;
+    std::vector<std::string> m_rules;
+    bool m_headerWritten = false;
+    bool m_hasResults = false;
+};
+
+#endif
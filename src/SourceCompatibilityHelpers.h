@@ -26,6 +26,7 @@
 #include <clang/AST/Attr.h>
 #include <clang/AST/Expr.h>
 #include <clang/AST/Decl.h>
+#include <clang/Basic/LangOptions.h>
 #include <clang/Basic/SourceLocation.h>
 #include <clang/Basic/SourceManager.h>
 #include <clang/Frontend/FrontendDiagnostic.h>
@@ -42,6 +43,19 @@ using namespace boost;
 using namespace std;
 #endif
 
+#if LLVM_VERSION_MAJOR >= 9
+# include <llvm/Support/TimeProfiler.h>
+// Makes the enclosing scope show up in clang's -ftime-trace output
+# define CLAZY_TIME_TRACE_SCOPE(name, detail) llvm::TimeTraceScope clazyTimeTraceScope(name, detail)
+# define CLAZY_TIME_TRACE_ENABLED() llvm::timeTraceProfilerEnabled()
+// Adds an event of its own for what was measured elsewhere, its duration is meaningless
+# define CLAZY_TIME_TRACE_EVENT(name, detail) do { llvm::timeTraceProfilerBegin(name, detail); llvm::timeTraceProfilerEnd(); } while (false)
+#else
+# define CLAZY_TIME_TRACE_SCOPE(name, detail)
+# define CLAZY_TIME_TRACE_ENABLED() false
+# define CLAZY_TIME_TRACE_EVENT(name, detail)
+#endif
+
 namespace clazy {
 
 template <typename T>
@@ -74,6 +88,34 @@ inline clang::CharSourceRange getImmediateExpansionRange(clang::SourceLocation m
 #endif
 }
 
+inline clang::CharSourceRange getExpansionRange(clang::SourceLocation macroLoc, const clang::SourceManager &sm)
+{
+#if LLVM_VERSION_MAJOR >= 7
+    return sm.getExpansionRange(macroLoc);
+#else
+    auto pair = sm.getExpansionRange(macroLoc);
+    return clang::CharSourceRange(clang::SourceRange(pair.first, pair.second), true);
+#endif
+}
+
+inline bool isCPlusPlus17(const clang::LangOptions &lo)
+{
+#if LLVM_VERSION_MAJOR >= 6
+    return lo.CPlusPlus17;
+#else
+    return lo.CPlusPlus1z;
+#endif
+}
+
+inline bool isCPlusPlus20(const clang::LangOptions &lo)
+{
+#if LLVM_VERSION_MAJOR >= 11
+    return lo.CPlusPlus20;
+#else
+    return lo.CPlusPlus2a;
+#endif
+}
+
 inline bool hasUnusedResultAttr(clang::FunctionDecl *func)
 {
 #if LLVM_VERSION_MAJOR >= 8
@@ -94,6 +136,16 @@ inline bool hasUnusedResultAttr(clang::FunctionDecl *func)
 
 }
 
+inline bool isNothrow(const clang::FunctionProtoType *proto, const clang::ASTContext &context)
+{
+#if LLVM_VERSION_MAJOR >= 7
+    (void)context;
+    return proto->isNothrow();
+#else
+    return proto->isNothrow(context);
+#endif
+}
+
 inline clang::tooling::Replacements& DiagnosticFix(clang::tooling::Diagnostic &diag, llvm::StringRef filePath)
 {
 #if LLVM_VERSION_MAJOR >= 9
@@ -103,6 +155,15 @@ inline clang::tooling::Replacements& DiagnosticFix(clang::tooling::Diagnostic &d
 #endif
 }
 
+inline const llvm::StringMap<clang::tooling::Replacements>& DiagnosticFixes(const clang::tooling::Diagnostic &diag)
+{
+#if LLVM_VERSION_MAJOR >= 9
+    return diag.Message.Fix;
+#else
+    return diag.Fix;
+#endif
+}
+
 }
 
 #endif
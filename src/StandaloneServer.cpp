@@ -0,0 +1,142 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+
+#include "StandaloneServer.h"
+
+#ifndef _WIN32
+
+#include <clang/Basic/DiagnosticOptions.h>
+#include <clang/Frontend/TextDiagnosticPrinter.h>
+#include <clang/Tooling/CompilationDatabase.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace clang;
+using namespace clang::tooling;
+using namespace std;
+
+// Returns the request, without the terminating empty line, or an empty string if the client went away
+static string readRequest(int fd)
+{
+    string request;
+    char buffer[4096];
+    while (request.find("\n\n") == string::npos) {
+        const ssize_t count = ::read(fd, buffer, sizeof(buffer));
+        if (count <= 0)
+            break; // The client can also just close its write end instead of sending an empty line
+        request.append(buffer, count);
+    }
+
+    return request.substr(0, request.find("\n\n"));
+}
+
+StandaloneServer::StandaloneServer(const CompilationDatabase &compilations, string defaultChecks,
+                                   ActionFactoryCreator createFactory, bool reusePreambles)
+    : m_compilations(compilations)
+    , m_defaultChecks(std::move(defaultChecks))
+    , m_createFactory(std::move(createFactory))
+    , m_reusePreambles(reusePreambles)
+{
+}
+
+void StandaloneServer::writeReply(int fd, llvm::StringRef reply)
+{
+    while (!reply.empty()) {
+        const ssize_t count = ::write(fd, reply.data(), reply.size());
+        if (count <= 0)
+            return;
+        reply = reply.drop_front(count);
+    }
+}
+
+string StandaloneServer::handleRequest(llvm::StringRef request) const
+{
+    string checks = m_defaultChecks;
+    vector<string> sourcePaths;
+
+    llvm::SmallVector<llvm::StringRef, 16> lines;
+    request.split(lines, '\n', -1, /*KeepEmpty=*/ false);
+    for (llvm::StringRef line : lines) {
+        line = line.trim();
+        if (line.consume_front("checks="))
+            checks = line.str();
+        else if (!line.empty())
+            sourcePaths.push_back(line.str());
+    }
+
+    string output;
+    llvm::raw_string_ostream os(output);
+    TextDiagnosticPrinter diagnosticPrinter(os, new DiagnosticOptions());
+    unique_ptr<FrontendActionFactory> factory = m_createFactory(sourcePaths, checks, m_reusePreambles ? &m_compilations : nullptr);
+
+    ClangTool tool(m_compilations, sourcePaths);
+    tool.setDiagnosticConsumer(&diagnosticPrinter);
+    const int result = sourcePaths.empty() ? 1 : tool.run(factory.get());
+    os << "exit: " << result << "\n";
+
+    return os.str();
+}
+
+int StandaloneServer::run(const string &socketPath)
+{
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        llvm::errs() << "clazy-standalone: Socket path too long: " << socketPath << "\n";
+        return 1;
+    }
+    std::copy(socketPath.cbegin(), socketPath.cend(), address.sun_path);
+
+    const int serverFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    ::unlink(socketPath.c_str()); // Leftover from a previous run
+    if (serverFd < 0 || ::bind(serverFd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 || ::listen(serverFd, 8) != 0) {
+        llvm::errs() << "clazy-standalone: Failed to listen on " << socketPath << "\n";
+        return 1;
+    }
+
+    ::signal(SIGPIPE, SIG_IGN); // Clients disconnecting early shouldn't kill us
+
+    while (true) {
+        const int clientFd = ::accept(serverFd, nullptr, nullptr);
+        if (clientFd < 0)
+            continue;
+
+        const string request = readRequest(clientFd);
+        writeReply(clientFd, handleRequest(request));
+        ::close(clientFd);
+    }
+
+    return 0;
+}
+
+#endif
@@ -0,0 +1,75 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+
+#ifndef CLAZY_STANDALONE_SERVER_H
+#define CLAZY_STANDALONE_SERVER_H
+
+#ifndef _WIN32
+
+#include "ActionFactoryCreator.h"
+
+#include <llvm/ADT/StringRef.h>
+
+#include <string>
+
+namespace clang {
+namespace tooling {
+class CompilationDatabase;
+}
+}
+
+/**
+ * clazy-standalone -server: keeps running and analyzes the files requested via a Unix socket.
+ *
+ * Saves the process start-up, option parsing and check registration for each analyzed file, useful for IDEs and
+ * pre-commit hooks. Requests are handled one at a time. FileManager isn't reused across requests, as files change
+ * in between.
+ */
+class StandaloneServer
+{
+public:
+    StandaloneServer(const clang::tooling::CompilationDatabase &compilations, std::string defaultChecks,
+                     ActionFactoryCreator createFactory, bool reusePreambles);
+
+    /**
+     * Listens on socketPath until killed. Returns non-zero if it can't listen.
+     */
+    int run(const std::string &socketPath);
+
+    /**
+     * Writes all of reply to fd, or as much as the client reads before going away.
+     */
+    static void writeReply(int fd, llvm::StringRef reply);
+
+private:
+    std::string handleRequest(llvm::StringRef request) const;
+
+    const clang::tooling::CompilationDatabase &m_compilations;
+    const std::string m_defaultChecks;
+    const ActionFactoryCreator m_createFactory;
+    const bool m_reusePreambles;
+};
+
+#endif
+
+#endif
@@ -0,0 +1,167 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+
+#include "StandaloneWatch.h"
+#include "ResultCache.h"
+
+#include <clang/Basic/DiagnosticOptions.h>
+#include <clang/Frontend/TextDiagnosticPrinter.h>
+#include <clang/Tooling/CompilationDatabase.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/Support/Chrono.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+using namespace clang;
+using namespace clang::tooling;
+using namespace std;
+
+namespace {
+
+// The files each translation unit read and when they were last modified
+class WatchedUnits
+{
+public:
+    void setDependencies(size_t unit, const vector<string> &files)
+    {
+        for (const string &file : files) {
+            auto it = m_files.find(file);
+            if (it == m_files.end())
+                it = m_files.insert({ file, { modificationTime(file), {} } }).first;
+            if (std::find(it->second.units.cbegin(), it->second.units.cend(), unit) == it->second.units.cend())
+                it->second.units.push_back(unit);
+        }
+    }
+
+    // Returns the units depending on the files modified since the last call, the most recently edited first
+    vector<size_t> takeModifiedUnits()
+    {
+        unordered_map<size_t, llvm::sys::TimePoint<>> modified;
+        for (auto &it : m_files) {
+            const llvm::sys::TimePoint<> time = modificationTime(it.first);
+            if (time == it.second.time)
+                continue;
+
+            it.second.time = time;
+            for (size_t unit : it.second.units) {
+                llvm::sys::TimePoint<> &unitTime = modified[unit];
+                unitTime = std::max(unitTime, time);
+            }
+        }
+
+        vector<pair<llvm::sys::TimePoint<>, size_t>> sorted;
+        for (const auto &it : modified)
+            sorted.push_back({ it.second, it.first });
+        std::sort(sorted.begin(), sorted.end(), std::greater<pair<llvm::sys::TimePoint<>, size_t>>());
+
+        vector<size_t> units;
+        for (const auto &it : sorted)
+            units.push_back(it.second);
+        return units;
+    }
+
+private:
+    // A deleted file has the default value, so recreating it also counts as a modification
+    static llvm::sys::TimePoint<> modificationTime(const string &file)
+    {
+        llvm::sys::fs::file_status status;
+        if (llvm::sys::fs::status(file, status))
+            return {};
+        return status.getLastModificationTime();
+    }
+
+    struct File {
+        llvm::sys::TimePoint<> time;
+        vector<size_t> units; // Indexes into the source files
+    };
+    unordered_map<string, File> m_files;
+};
+
+}
+
+StandaloneWatch::StandaloneWatch(const CompilationDatabase &compilations, vector<string> sourcePaths,
+                                 string checks, ActionFactoryCreator createFactory)
+    : m_compilations(compilations)
+    , m_sourcePaths(std::move(sourcePaths))
+    , m_checks(std::move(checks))
+    , m_createFactory(std::move(createFactory))
+{
+}
+
+int StandaloneWatch::run(const ResultCache *cache, bool reusePreambles)
+{
+    WatchedUnits watched;
+
+    // The first run doesn't use preambles, the files read through a preamble aren't in the FileManager.
+    // Later runs only add to the dependencies, an include removed since only costs a few spurious re-analyses.
+    auto analyze = [&] (size_t i, bool reusePreamble) {
+        const string &sourcePath = m_sourcePaths[i];
+        string cacheKey;
+        string output;
+        int result = 0;
+        vector<string> dependencies;
+        if (cache) {
+            cacheKey = cache->keyFor(sourcePath, m_compilations.getCompileCommands(sourcePath));
+            if (cache->lookup(cacheKey, output, result, &dependencies)) {
+                llvm::errs() << output;
+                watched.setDependencies(i, dependencies);
+                return;
+            }
+        }
+
+        llvm::raw_string_ostream os(output);
+        TextDiagnosticPrinter diagnosticPrinter(os, new DiagnosticOptions());
+        unique_ptr<FrontendActionFactory> factory = m_createFactory({ sourcePath }, m_checks, reusePreamble ? &m_compilations : nullptr);
+        ClangTool tool(m_compilations, { sourcePath });
+        tool.setDiagnosticConsumer(&diagnosticPrinter);
+        result = tool.run(factory.get());
+        os.flush();
+        llvm::errs() << output;
+
+        watched.setDependencies(i, ResultCache::dependenciesOf(tool.getFiles()));
+        if (cache && result == 0)
+            cache->store(cacheKey, tool.getFiles(), output, result);
+    };
+
+    for (size_t i = 0; i < m_sourcePaths.size(); ++i)
+        analyze(i, /*reusePreamble=*/ false);
+
+    llvm::errs() << "clazy-standalone: Watching " << m_sourcePaths.size() << " files\n";
+    while (true) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        const vector<size_t> units = watched.takeModifiedUnits();
+        for (size_t i : units) {
+            llvm::errs() << "clazy-standalone: Analyzing " << m_sourcePaths[i] << "\n";
+            analyze(i, reusePreambles);
+        }
+    }
+
+    return 0;
+}
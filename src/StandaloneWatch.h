@@ -0,0 +1,66 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+
+#ifndef CLAZY_STANDALONE_WATCH_H
+#define CLAZY_STANDALONE_WATCH_H
+
+#include "ActionFactoryCreator.h"
+
+#include <string>
+#include <vector>
+
+class ResultCache;
+
+namespace clang {
+namespace tooling {
+class CompilationDatabase;
+}
+}
+
+/**
+ * clazy-standalone -watch: analyzes the files and then re-analyzes the ones depending on each file modified,
+ * the most recently edited first, until killed, for feedback while editing.
+ *
+ * Files are polled instead of using inotify or FSEvents, which keeps it portable, checking the include closure of a
+ * few thousand files each interval is cheap compared to parsing a single one.
+ */
+class StandaloneWatch
+{
+public:
+    StandaloneWatch(const clang::tooling::CompilationDatabase &compilations, std::vector<std::string> sourcePaths,
+                    std::string checks, ActionFactoryCreator createFactory);
+
+    /**
+     * Never returns. Results are looked up in and stored into cache, if non-null. Re-analyses reuse the
+     * precompiled preambles of the files if reusePreambles.
+     */
+    int run(const ResultCache *cache, bool reusePreambles);
+
+private:
+    const clang::tooling::CompilationDatabase &m_compilations;
+    const std::vector<std::string> m_sourcePaths;
+    const std::string m_checks;
+    const ActionFactoryCreator m_createFactory;
+};
+
+#endif
@@ -0,0 +1,393 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+
+#include "StandaloneWorker.h"
+
+#ifdef CLAZY_HAS_WORKER
+
+#include "JsonlExporter.h"
+#include "StandaloneServer.h"
+
+#include <clang/Frontend/PCHContainerOperations.h>
+#include <clang/Tooling/CompilationDatabase.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/VirtualFileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+using namespace clang;
+using namespace clang::tooling;
+using namespace std;
+
+static const size_t s_maxBlobsSize = size_t(256) << 20;
+static const size_t s_maxBlobSize = size_t(32) << 20; // A bigger one closes the connection, so a client can't exhaust memory
+
+// Buffered reads of the lines and the file contents of a worker request
+class WorkerRequestReader
+{
+public:
+    explicit WorkerRequestReader(int fd)
+        : m_fd(fd)
+    {
+    }
+
+    // Returns false if the client went away, or sent a line longer than s_maxLineSize
+    bool readLine(string &line)
+    {
+        size_t end = 0;
+        while ((end = m_buffer.find('\n')) == string::npos) {
+            if (m_buffer.size() > s_maxLineSize || !fill())
+                return false;
+        }
+
+        line = m_buffer.substr(0, end);
+        m_buffer.erase(0, end + 1);
+        return true;
+    }
+
+    bool read(size_t size, string &data)
+    {
+        while (m_buffer.size() < size) {
+            if (!fill())
+                return false;
+        }
+
+        data = m_buffer.substr(0, size);
+        m_buffer.erase(0, size);
+        return true;
+    }
+
+private:
+    bool fill()
+    {
+        char buffer[65536];
+        const ssize_t count = ::read(m_fd, buffer, sizeof(buffer));
+        if (count <= 0)
+            return false;
+        m_buffer.append(buffer, count);
+        return true;
+    }
+
+    static const size_t s_maxLineSize = 1 << 20;
+    const int m_fd;
+    string m_buffer;
+};
+
+namespace {
+
+// Lets the compile command's directory only exist in the bundle, the physical file system keeps its previous one
+class BundleWorkingDirectoryFileSystem : public llvm::vfs::ProxyFileSystem
+{
+public:
+    using ProxyFileSystem::ProxyFileSystem;
+
+    std::error_code setCurrentWorkingDirectory(const llvm::Twine &path) override
+    {
+        ProxyFileSystem::setCurrentWorkingDirectory(path);
+        return {};
+    }
+};
+
+}
+
+static string md5Of(llvm::StringRef data)
+{
+    llvm::MD5 hash;
+    hash.update(data);
+    llvm::MD5::MD5Result result;
+    hash.final(result);
+    llvm::SmallString<32> hexHash;
+    llvm::MD5::stringifyResult(result, hexHash);
+    return hexHash.str().str();
+}
+
+// The flags a coordinator can pass. Anything else, like -include, -Xclang -load, -fplugin or the -M options writing
+// dependency files, could read, write or run arbitrary files on the worker.
+static bool isAcceptedWorkerFlag(llvm::StringRef arg)
+{
+    static const char *const s_exactFlags[] = { "-c", "-w", "-g", "-pthread", "-nostdinc", "-nostdinc++", "-fPIC", "-fpic",
+                                                "-fPIE", "-fpie", "-fexceptions", "-fno-exceptions", "-frtti", "-fno-rtti",
+                                                "-fms-extensions", "-fms-compatibility", "-fsigned-char", "-funsigned-char",
+                                                "-fno-operator-names", "-fvisibility-inlines-hidden", "-m32", "-m64" };
+    static const char *const s_prefixes[] = { "-I", "-isystem", "-iquote", "-idirafter", "-D", "-U", "-std=", "-stdlib=",
+                                              "--target=", "-O", "-fvisibility=", "-x" };
+    if (std::find(std::begin(s_exactFlags), std::end(s_exactFlags), arg) != std::end(s_exactFlags))
+        return true;
+
+    // -Wp, -Wa and -Wl pass flags through, to the preprocessor for example
+    if (arg.startswith("-W"))
+        return !arg.contains(',');
+
+    return std::any_of(std::begin(s_prefixes), std::end(s_prefixes), [arg](const char *prefix) { return arg.startswith(prefix); });
+}
+
+// The accepted flags which can take their value as the next argument, like "-I <dir>"
+static bool takesSeparateValue(llvm::StringRef arg)
+{
+    static const char *const s_flags[] = { "-I", "-isystem", "-iquote", "-idirafter", "-D", "-U", "-x" };
+    return std::find(std::begin(s_flags), std::end(s_flags), arg) != std::end(s_flags);
+}
+
+// Reads the first line of a connection, which must have the -worker-secret-file's secret. Every character is compared,
+// so the time taken doesn't reveal how much of it a client guessed right.
+static bool authenticateWorkerClient(WorkerRequestReader &reader, llvm::StringRef secret)
+{
+    string line;
+    if (!reader.readLine(line))
+        return false;
+
+    llvm::StringRef clientSecret = line;
+    if (!clientSecret.consume_front("secret="))
+        return false;
+
+    unsigned char difference = clientSecret.size() == secret.size() ? 0 : 1;
+    for (size_t i = 0; i < clientSecret.size(); ++i)
+        difference |= static_cast<unsigned char>(clientSecret[i] ^ (i < secret.size() ? secret[i] : 0));
+    return difference == 0;
+}
+
+static bool isLoopback(const sockaddr *address)
+{
+    if (address->sa_family == AF_INET)
+        return (ntohl(reinterpret_cast<const sockaddr_in *>(address)->sin_addr.s_addr) >> 24) == 127;
+    if (address->sa_family == AF_INET6)
+        return IN6_IS_ADDR_LOOPBACK(&reinterpret_cast<const sockaddr_in6 *>(address)->sin6_addr);
+    return false;
+}
+
+StandaloneWorker::StandaloneWorker(string defaultChecks, ActionFactoryCreator createFactory)
+    : m_defaultChecks(std::move(defaultChecks))
+    , m_createFactory(std::move(createFactory))
+{
+}
+
+// Reads and runs a request. Returns false if the client went away instead.
+bool StandaloneWorker::handleRequest(WorkerRequestReader &reader, string &reply)
+{
+    reply.clear();
+    string checks = m_defaultChecks;
+    string directory = "/";
+    vector<string> args;
+    vector<pair<string, string>> files; // Path and MD5
+    vector<string> sourcePaths;
+    vector<string> missing;
+    string error;
+    bool expectsValue = false; // If the previous arg= was a flag taking the next one as its value
+
+    string line;
+    while (true) {
+        if (!reader.readLine(line))
+            return false;
+        if (line.empty())
+            break;
+
+        llvm::StringRef value = line;
+        if (value.consume_front("checks=")) {
+            checks = value.str();
+        } else if (value.consume_front("directory=")) {
+            directory = value.str();
+        } else if (value.consume_front("arg=")) {
+            if (expectsValue)
+                expectsValue = false;
+            else if (isAcceptedWorkerFlag(value))
+                expectsValue = takesSeparateValue(value);
+            else
+                error += "error: flag not accepted by this worker: " + value.str() + "\n";
+            args.push_back(value.str());
+        } else if (value.consume_front("main=")) {
+            sourcePaths.push_back(value.str());
+        } else if (value.consume_front("file=")) {
+            llvm::StringRef md5, path;
+            std::tie(md5, path) = value.split(' ');
+            files.push_back({ path.str(), md5.str() });
+        } else if (value.consume_front("blob=")) {
+            llvm::StringRef md5, sizeStr;
+            std::tie(md5, sizeStr) = value.split(' ');
+            size_t size = 0;
+            string data;
+            if (sizeStr.getAsInteger(10, size) || size > s_maxBlobSize || !reader.read(size, data))
+                return false; // Can't know where the next line starts
+            if (md5Of(data) != md5) {
+                error = "error: corrupt blob " + md5.str() + "\n";
+                continue;
+            }
+
+            if (m_blobsSize + size > s_maxBlobsSize) {
+                m_blobs.clear(); // Simpler than LRU, coordinators just have to send them again
+                m_blobsSize = 0;
+            }
+            if (m_blobs.insert({ md5.str(), std::move(data) }).second)
+                m_blobsSize += size;
+        } else {
+            error = "error: unknown request line " + line + "\n";
+        }
+    }
+
+    if (sourcePaths.empty())
+        error += "error: no main file\n";
+
+    if (!error.empty()) {
+        reply = error + "exit: 1\n";
+        return true;
+    }
+
+    // Files of the bundle shadow the ones of the worker, which has to provide the rest, like system headers
+    llvm::IntrusiveRefCntPtr<llvm::vfs::InMemoryFileSystem> bundle(new llvm::vfs::InMemoryFileSystem());
+    for (const auto &file : files) {
+        auto it = m_blobs.find(file.second);
+        if (it == m_blobs.end()) {
+            missing.push_back(file.second);
+            continue;
+        }
+
+        llvm::SmallString<256> path(file.first);
+        llvm::sys::fs::make_absolute(directory, path);
+        bundle->addFile(path, 0, llvm::MemoryBuffer::getMemBufferCopy(it->second, path));
+    }
+
+    if (!missing.empty()) {
+        for (const string &md5 : missing)
+            reply += "missing=" + md5 + "\n";
+        reply += "exit: 2\n";
+        return true;
+    }
+
+    for (string &sourcePath : sourcePaths) {
+        llvm::SmallString<256> path(sourcePath);
+        llvm::sys::fs::make_absolute(directory, path);
+        sourcePath = path.str().str();
+    }
+
+    llvm::IntrusiveRefCntPtr<llvm::vfs::OverlayFileSystem> fileSystem(
+        new llvm::vfs::OverlayFileSystem(new BundleWorkingDirectoryFileSystem(
+            llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem>(llvm::vfs::createPhysicalFileSystem().release()))));
+    fileSystem->pushOverlay(bundle);
+
+    JsonlDiagnosticConsumer diagnosticConsumer(reply);
+    FixedCompilationDatabase compilations(directory, args);
+    unique_ptr<FrontendActionFactory> factory = m_createFactory(sourcePaths, checks, nullptr);
+
+    ClangTool tool(compilations, sourcePaths, std::make_shared<PCHContainerOperations>(), fileSystem);
+    tool.setDiagnosticConsumer(&diagnosticConsumer);
+    const int result = tool.run(factory.get());
+
+    reply += "exit: " + std::to_string(result) + "\n";
+    return true;
+}
+
+// Requests are handled one at a time, run several workers for more
+int StandaloneWorker::run(const string &address, const string &secretFile, bool allowRemote, unsigned int readTimeout)
+{
+    llvm::StringRef host, port;
+    std::tie(host, port) = llvm::StringRef(address).rsplit(':');
+    if (host.empty() || port.empty()) {
+        llvm::errs() << "clazy-standalone: Invalid -worker, expected <host>:<port>\n";
+        return 1;
+    }
+
+    // Read from a file, as the command line is visible to the other users
+    auto secretBuffer = llvm::MemoryBuffer::getFile(secretFile);
+    const string secret = secretFile.empty() || !secretBuffer
+                              ? string()
+                              : (*secretBuffer)->getBuffer().split('\n').first.rtrim("\r").str();
+    if (secret.empty()) {
+        llvm::errs() << "clazy-standalone: -worker requires -worker-secret-file, naming a file with a non-empty secret\n";
+        return 1;
+    }
+
+    addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+    addrinfo *addresses = nullptr;
+    if (::getaddrinfo(host.str().c_str(), port.str().c_str(), &hints, &addresses) != 0 || !addresses) {
+        llvm::errs() << "clazy-standalone: Failed to resolve " << address << "\n";
+        return 1;
+    }
+
+    if (!allowRemote && !isLoopback(addresses->ai_addr)) {
+        llvm::errs() << "clazy-standalone: -worker only listens on loopback addresses, like 127.0.0.1, unless -worker-allow-remote is passed\n";
+        ::freeaddrinfo(addresses);
+        return 1;
+    }
+
+    const int serverFd = ::socket(addresses->ai_family, addresses->ai_socktype, addresses->ai_protocol);
+    const int reuse = 1;
+    if (serverFd >= 0)
+        ::setsockopt(serverFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)); // Restarting right away shouldn't fail
+    const bool listening = serverFd >= 0 && ::bind(serverFd, addresses->ai_addr, addresses->ai_addrlen) == 0 && ::listen(serverFd, 8) == 0;
+    ::freeaddrinfo(addresses);
+    if (!listening) {
+        llvm::errs() << "clazy-standalone: Failed to listen on " << address << "\n";
+        return 1;
+    }
+
+    ::signal(SIGPIPE, SIG_IGN); // Coordinators disconnecting early shouldn't kill us
+
+    while (true) {
+        const int clientFd = ::accept(serverFd, nullptr, nullptr);
+        if (clientFd < 0)
+            continue;
+
+        // Requests are handled one at a time, so a client going quiet mustn't block the others. The timeout
+        // applies to each read, a big blob arriving slowly but steadily is fine.
+        if (readTimeout > 0) {
+            timeval timeout = {};
+            timeout.tv_sec = readTimeout;
+            ::setsockopt(clientFd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        }
+
+        // A connection can send several requests, each answered before reading the next
+        WorkerRequestReader reader(clientFd);
+        if (!authenticateWorkerClient(reader, secret)) {
+            StandaloneServer::writeReply(clientFd, "error: wrong secret\nexit: 1\n");
+            ::close(clientFd);
+            continue;
+        }
+
+        string reply;
+        while (handleRequest(reader, reply))
+            StandaloneServer::writeReply(clientFd, reply);
+        ::close(clientFd);
+    }
+
+    return 0;
+}
+
+#endif
@@ -0,0 +1,70 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+
+#ifndef CLAZY_STANDALONE_WORKER_H
+#define CLAZY_STANDALONE_WORKER_H
+
+#include <llvm/Config/llvm-config.h>
+
+#if LLVM_VERSION_MAJOR >= 12 && !defined(_WIN32)
+# define CLAZY_HAS_WORKER // Needs ClangTool's BaseFS
+
+#include "ActionFactoryCreator.h"
+
+#include <string>
+#include <unordered_map>
+
+class WorkerRequestReader;
+
+/**
+ * clazy-standalone -worker: analyzes the translation units sent over TCP by a coordinator, for example one per
+ * machine of a build farm. See the -worker option for the protocol.
+ *
+ * Each connection must first send the secret of the -worker-secret-file. The files of a request are sent as blobs
+ * keyed by their MD5, which are kept across requests and connections, so coordinators only send each version of a
+ * header once.
+ */
+class StandaloneWorker
+{
+public:
+    StandaloneWorker(std::string defaultChecks, ActionFactoryCreator createFactory);
+
+    /**
+     * Listens on address, "<host>:<port>", until killed. Returns non-zero if it can't listen. Only loopback
+     * addresses are accepted unless allowRemote. Connections not sending anything for readTimeout seconds
+     * are closed, 0 never closes them.
+     */
+    int run(const std::string &address, const std::string &secretFile, bool allowRemote, unsigned int readTimeout);
+
+private:
+    bool handleRequest(WorkerRequestReader &reader, std::string &reply);
+
+    const std::string m_defaultChecks;
+    const ActionFactoryCreator m_createFactory;
+    std::unordered_map<std::string, std::string> m_blobs; // File contents by MD5
+    size_t m_blobsSize = 0;
+};
+
+#endif
+
+#endif
@@ -26,18 +26,23 @@
 #include <clang/Basic/SourceLocation.h>
 #include <clang/Basic/SourceManager.h>
 
+class StmtIndex;
+
 struct StmtBodyRange
 {
     clang::Stmt *body = nullptr;
     const clang::SourceManager *const sm = nullptr;
     const clang::SourceLocation searchUntilLoc; // We don't search after this point
+    const StmtIndex *const index = nullptr; // Optional, to search body without walking it
 
     explicit StmtBodyRange(clang::Stmt *body,
                            const clang::SourceManager *sm = nullptr,
-                           clang::SourceLocation searchUntilLoc = {})
+                           clang::SourceLocation searchUntilLoc = {},
+                           const StmtIndex *index = nullptr)
         : body(body)
         , sm(sm)
         , searchUntilLoc(searchUntilLoc)
+        , index(index)
     {
     }
 
@@ -0,0 +1,117 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "StmtFacts.h"
+#include "ClazyContext.h"
+#include "LoopUtils.h"
+#include "QtUtils.h"
+#include "SourceCompatibilityHelpers.h"
+#include "StringUtils.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/Basic/SourceLocation.h>
+#include <llvm/Support/Casting.h>
+
+using namespace clang;
+
+void StmtFacts::reset(Stmt *stmt)
+{
+    m_stmt = stmt;
+    m_computed = 0;
+}
+
+void StmtFacts::computeCallee() const
+{
+    if (!needs(Fact_Callee))
+        return;
+
+    m_callee = nullptr;
+    if (auto call = dyn_cast_or_null<CallExpr>(m_stmt))
+        m_callee = call->getDirectCallee();
+    else if (auto ctorExpr = dyn_cast_or_null<CXXConstructExpr>(m_stmt))
+        m_callee = ctorExpr->getConstructor();
+
+    m_method = dyn_cast_or_null<CXXMethodDecl>(m_callee);
+}
+
+FunctionDecl *StmtFacts::callee() const
+{
+    computeCallee();
+    return m_callee;
+}
+
+CXXMethodDecl *StmtFacts::method() const
+{
+    computeCallee();
+    return m_method;
+}
+
+CXXRecordDecl *StmtFacts::record() const
+{
+    computeCallee();
+    return m_method ? m_method->getParent() : nullptr;
+}
+
+StringRef StmtFacts::recordName() const
+{
+    CXXRecordDecl *rec = record();
+    return rec ? clazy::name(rec) : StringRef();
+}
+
+bool StmtFacts::isQtContainer() const
+{
+    if (needs(Fact_QtContainer)) {
+        CXXRecordDecl *rec = record();
+        m_isQtContainer = rec && clazy::isQtContainer(rec);
+    }
+
+    return m_isQtContainer;
+}
+
+Stmt *StmtFacts::enclosingLoop() const
+{
+    if (needs(Fact_Loop))
+        m_loop = clazy::isInLoop(m_context, m_stmt);
+
+    return m_loop;
+}
+
+bool StmtFacts::isInMainFile() const
+{
+    if (needs(Fact_Location)) {
+        const SourceLocation loc = m_stmt ? clazy::getLocStart(m_stmt) : SourceLocation();
+        m_isMacro = loc.isMacroID();
+        m_isInMainFile = loc.isValid() && m_context->isMainFile(loc);
+    }
+
+    return m_isInMainFile;
+}
+
+bool StmtFacts::isMacro() const
+{
+    isInMainFile();
+    return m_isMacro;
+}
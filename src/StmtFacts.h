@@ -0,0 +1,127 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_STMT_FACTS_H
+#define CLAZY_STMT_FACTS_H
+
+#include <llvm/ADT/StringRef.h>
+
+#include <cstdint>
+
+class ClazyContext;
+
+namespace clang {
+class CXXMethodDecl;
+class CXXRecordDecl;
+class FunctionDecl;
+class Stmt;
+}
+
+/**
+ * What most checks derive first from the statement being visited: its callee, the callee's class, and whether
+ * it's in the main file, in a macro or in a loop. Computed once per statement, when first asked for, and shared
+ * by all the checks visiting it.
+ *
+ * Get it with ClazyContext::stmtFacts(). The ParentMap-free loop query only works for the statement being visited.
+ */
+class StmtFacts
+{
+public:
+    explicit StmtFacts(const ClazyContext *context)
+        : m_context(context)
+    {
+    }
+
+    void reset(clang::Stmt *stmt);
+
+    clang::Stmt *stmt() const
+    {
+        return m_stmt;
+    }
+
+    /**
+     * Returns the direct callee of a CallExpr, including member and operator calls, or the constructor of a CXXConstructExpr.
+     */
+    clang::FunctionDecl *callee() const;
+
+    /**
+     * Returns callee() if it's a method, or nullptr.
+     */
+    clang::CXXMethodDecl *method() const;
+
+    /**
+     * Returns the class of method(), or nullptr.
+     */
+    clang::CXXRecordDecl *record() const;
+
+    /**
+     * Returns the name of record(), without namespace, or an empty string.
+     */
+    llvm::StringRef recordName() const;
+
+    /**
+     * Returns true if record() is one of clazy::qtContainers().
+     */
+    bool isQtContainer() const;
+
+    /**
+     * Returns the innermost loop the statement is in, or nullptr. See clazy::isInLoop().
+     */
+    clang::Stmt *enclosingLoop() const;
+
+    bool isInMainFile() const;
+
+    /**
+     * Returns true if the statement starts in a macro expansion.
+     */
+    bool isMacro() const;
+
+private:
+    enum Fact {
+        Fact_Callee = 1,
+        Fact_QtContainer = 2,
+        Fact_Loop = 4,
+        Fact_Location = 8
+    };
+
+    bool needs(Fact fact) const
+    {
+        if (m_computed & fact)
+            return false;
+        m_computed |= fact;
+        return true;
+    }
+
+    void computeCallee() const;
+
+    const ClazyContext *const m_context;
+    clang::Stmt *m_stmt = nullptr;
+    mutable uint8_t m_computed = 0;
+    mutable clang::FunctionDecl *m_callee = nullptr;
+    mutable clang::CXXMethodDecl *m_method = nullptr;
+    mutable clang::Stmt *m_loop = nullptr;
+    mutable bool m_isQtContainer = false;
+    mutable bool m_isInMainFile = false;
+    mutable bool m_isMacro = false;
+};
+
+#endif
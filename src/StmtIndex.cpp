@@ -0,0 +1,158 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "StmtIndex.h"
+#include "Utils.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+
+using namespace clang;
+using namespace std;
+
+StmtIndex::StmtIndex(Stmt *root)
+    : m_root(root)
+{
+    if (!root)
+        return;
+
+    add(root, 0);
+
+    vector<vector<unsigned int>> positionsByClass;
+    for (unsigned int i = 0; i < m_nodes.size(); ++i) {
+        const unsigned int stmtClass = m_nodes[i].stmt->getStmtClass();
+        if (stmtClass >= positionsByClass.size())
+            positionsByClass.resize(stmtClass + 1);
+        positionsByClass[stmtClass].push_back(i);
+    }
+
+    for (vector<unsigned int> &positions : positionsByClass) {
+        if (!positions.empty())
+            m_positionsByClass.push_back(std::move(positions));
+    }
+}
+
+void StmtIndex::add(Stmt *stmt, unsigned int depth)
+{
+    const unsigned int position = m_nodes.size();
+    m_nodes.push_back({ stmt, 0, depth });
+    m_positions.insert({ stmt, position }); // A few nodes appear twice in the AST, the first one wins
+
+    for (Stmt *child : stmt->children()) {
+        if (child) // Can happen
+            add(child, depth + 1);
+    }
+
+    m_nodes[position].end = m_nodes.size();
+}
+
+// Same rule as Utils::isPassedToFunction(): the argument itself, or its first child, must be the DeclRefExpr
+static DeclRefExpr *declRefForArgument(Expr *arg)
+{
+    if (auto refExpr = dyn_cast_or_null<DeclRefExpr>(arg))
+        return refExpr;
+
+    if (!clazy::hasChildren(arg))
+        return nullptr;
+
+    Stmt *firstChild = *(arg->child_begin()); // Can be null (bug #362236)
+    return dyn_cast_or_null<DeclRefExpr>(firstChild);
+}
+
+template <typename T>
+void StmtIndex::addArgumentUses(T *expr, unsigned int position) const
+{
+    unsigned int argIndex = 0;
+    for (Expr *arg : expr->arguments()) {
+        if (DeclRefExpr *refExpr = declRefForArgument(arg))
+            addUse(refExpr->getDecl(), DeclUse_PassedToFunction, expr, position, argIndex);
+        ++argIndex;
+    }
+}
+
+vector<StmtIndex::DeclUse> StmtIndex::usesOf(const ValueDecl *decl, const Stmt *stmt, bool includeSelf) const
+{
+    vector<DeclUse> result;
+    unsigned int begin, end;
+    if (!decl || !subtree(stmt, includeSelf, begin, end))
+        return result;
+
+    if (!m_usesIndexed)
+        indexUses();
+
+    auto it = m_uses.find(decl);
+    if (it == m_uses.end())
+        return result;
+
+    for (const IndexedUse &indexed : it->second) {
+        if (indexed.position >= begin && indexed.position < end)
+            result.push_back(indexed.use);
+    }
+
+    return result;
+}
+
+void StmtIndex::indexUses() const
+{
+    m_usesIndexed = true;
+
+    for (unsigned int position = 0; position < m_nodes.size(); ++position) {
+        Stmt *stmt = m_nodes[position].stmt;
+        if (m_positions.lookup(stmt) != position)
+            continue; // Shared node, already indexed
+
+        if (auto refExpr = dyn_cast<DeclRefExpr>(stmt)) {
+            addUse(refExpr->getDecl(), DeclUse_Referenced, stmt, position);
+        } else if (auto callExpr = dyn_cast<CallExpr>(stmt)) {
+            if (callExpr->getDirectCallee())
+                addArgumentUses(callExpr, position);
+
+            auto operatorExpr = dyn_cast<CXXOperatorCallExpr>(callExpr);
+            auto methodDecl = operatorExpr ? dyn_cast_or_null<CXXMethodDecl>(operatorExpr->getDirectCallee()) : nullptr;
+            if (methodDecl && methodDecl->isCopyAssignmentOperator())
+                addUse(Utils::valueDeclForOperatorCall(operatorExpr), DeclUse_AssignedFrom, stmt, position);
+        } else if (auto constructExpr = dyn_cast<CXXConstructExpr>(stmt)) {
+            addArgumentUses(constructExpr, position);
+        } else if (auto returnStmt = dyn_cast<ReturnStmt>(stmt)) {
+            if (auto refExpr = clazy::unpeal<DeclRefExpr>(returnStmt->getRetValue(), clazy::IgnoreImplicitCasts))
+                addUse(refExpr->getDecl(), DeclUse_Returned, stmt, position);
+        } else if (auto binaryOperator = dyn_cast<BinaryOperator>(stmt)) {
+            if (binaryOperator->getOpcode() == BO_Assign) {
+                if (auto refExpr = clazy::unpeal<DeclRefExpr>(binaryOperator->getRHS(), clazy::IgnoreImplicitCasts))
+                    addUse(refExpr->getDecl(), DeclUse_AssignedTo, stmt, position);
+            }
+        } else if (auto unaryOperator = dyn_cast<UnaryOperator>(stmt)) {
+            if (unaryOperator->getOpcode() == UO_AddrOf) {
+                if (auto refExpr = firstDescendantOfType<DeclRefExpr>(unaryOperator))
+                    addUse(refExpr->getDecl(), DeclUse_AddressTaken, stmt, position);
+            }
+        }
+    }
+}
+
+void StmtIndex::addUse(const ValueDecl *decl, DeclUseKind kind, Stmt *stmt, unsigned int position, unsigned int argIndex) const
+{
+    if (decl)
+        m_uses[decl].push_back({ { kind, stmt, argIndex }, position });
+}
@@ -0,0 +1,251 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_STMT_INDEX_H
+#define CLAZY_STMT_INDEX_H
+
+#include "HierarchyUtils.h"
+#include "SourceCompatibilityHelpers.h"
+
+#include <clang/AST/Stmt.h>
+#include <clang/Basic/SourceLocation.h>
+#include <clang/Basic/SourceManager.h>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/Support/Casting.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace clang {
+class ValueDecl;
+}
+
+/**
+ * Index of all statements below a root, usually a function body, for checks that search the same body many times.
+ *
+ * Statements are stored in depth-first order, and each one knows where its subtree ends, so finding the descendants
+ * of some class is a binary search per statement class instead of walking the subtree.
+ *
+ * Get it with ClazyContext::functionStmtIndex(), which builds it once per function and shares it between checks.
+ */
+class StmtIndex
+{
+public:
+    enum DeclUseKind {
+        DeclUse_Referenced, // Any DeclRefExpr
+        DeclUse_PassedToFunction, // Argument of a call or construct expression, argIndex says which
+        DeclUse_AssignedTo, // Right side of a builtin assignment: something = decl
+        DeclUse_AssignedFrom, // Left side of a copy-assignment operator call: decl = something
+        DeclUse_Returned,
+        DeclUse_AddressTaken
+    };
+
+    struct DeclUse {
+        DeclUseKind kind;
+        clang::Stmt *stmt; // The DeclRefExpr, call, assignment, return or unary operator
+        unsigned int argIndex; // Only for DeclUse_PassedToFunction
+    };
+
+    explicit StmtIndex(clang::Stmt *root);
+
+    clang::Stmt *root() const { return m_root; }
+
+    /**
+     * Returns true if stmt is root or a descendant of it.
+     */
+    bool contains(const clang::Stmt *stmt) const { return m_positions.count(stmt); }
+
+    /**
+     * Returns true if child is a descendant of parent. Like clazy::isChildOf().
+     */
+    bool isDescendant(const clang::Stmt *child, const clang::Stmt *parent) const
+    {
+        auto childIt = m_positions.find(child);
+        auto parentIt = m_positions.find(parent);
+        if (childIt == m_positions.end() || parentIt == m_positions.end())
+            return false;
+
+        return parentIt->second < childIt->second && childIt->second < m_nodes[parentIt->second].end;
+    }
+
+    /**
+     * Returns the number of statements between root and stmt, 0 for root itself.
+     */
+    unsigned int depth(const clang::Stmt *stmt) const
+    {
+        auto it = m_positions.find(stmt);
+        return it == m_positions.end() ? 0 : m_nodes[it->second].depth;
+    }
+
+    /**
+     * Returns the statements of type T below stmt, and stmt itself if includeSelf, in depth-first order.
+     * Like clazy::getChilds().
+     */
+    template <typename T>
+    std::vector<T*> statementsOfType(const clang::Stmt *stmt, bool includeSelf = true) const
+    {
+        std::vector<T*> result;
+        unsigned int begin, end;
+        if (!subtree(stmt, includeSelf, begin, end))
+            return result;
+
+        std::vector<unsigned int> positions;
+        int numClasses = 0;
+        for (const std::vector<unsigned int> &classPositions : m_positionsByClass) {
+            if (!llvm::isa<T>(m_nodes[classPositions.front()].stmt))
+                continue;
+
+            auto first = std::lower_bound(classPositions.cbegin(), classPositions.cend(), begin);
+            auto last = std::lower_bound(first, classPositions.cend(), end);
+            positions.insert(positions.end(), first, last);
+            ++numClasses;
+        }
+
+        if (numClasses > 1)
+            std::sort(positions.begin(), positions.end());
+
+        result.reserve(positions.size());
+        for (unsigned int position : positions)
+            result.push_back(llvm::cast<T>(m_nodes[position].stmt));
+
+        return result;
+    }
+
+    /**
+     * Returns the first statement of type T below stmt, in depth-first order. Like clazy::getFirstChildOfType().
+     */
+    template <typename T>
+    T* firstDescendantOfType(const clang::Stmt *stmt) const
+    {
+        unsigned int begin, end;
+        if (!subtree(stmt, /*includeSelf=*/ false, begin, end))
+            return nullptr;
+
+        unsigned int firstPosition = end;
+        for (const std::vector<unsigned int> &classPositions : m_positionsByClass) {
+            if (!llvm::isa<T>(m_nodes[classPositions.front()].stmt))
+                continue;
+
+            auto it = std::lower_bound(classPositions.cbegin(), classPositions.cend(), begin);
+            if (it != classPositions.cend())
+                firstPosition = std::min(firstPosition, *it);
+        }
+
+        return firstPosition < end ? llvm::cast<T>(m_nodes[firstPosition].stmt) : nullptr;
+    }
+
+    /**
+     * Returns how decl is used below stmt, and in stmt itself if includeSelf, in depth-first order.
+     * The uses of all declarations are indexed in one pass the first time, so each query only costs
+     * the number of uses of decl. See Utils::isPassedToFunction() and friends for the exact rules.
+     */
+    std::vector<DeclUse> usesOf(const clang::ValueDecl *decl, const clang::Stmt *stmt, bool includeSelf = true) const;
+
+private:
+    struct Node {
+        clang::Stmt *stmt;
+        unsigned int end; // One past the last descendant
+        unsigned int depth;
+    };
+
+    struct IndexedUse {
+        DeclUse use;
+        unsigned int position;
+    };
+
+    void add(clang::Stmt *stmt, unsigned int depth);
+    void indexUses() const;
+    template <typename T>
+    void addArgumentUses(T *expr, unsigned int position) const;
+    void addUse(const clang::ValueDecl *decl, DeclUseKind kind, clang::Stmt *stmt, unsigned int position, unsigned int argIndex = 0) const;
+    bool subtree(const clang::Stmt *stmt, bool includeSelf, unsigned int &begin, unsigned int &end) const
+    {
+        auto it = m_positions.find(stmt);
+        if (it == m_positions.end())
+            return false;
+
+        begin = includeSelf ? it->second : it->second + 1;
+        end = m_nodes[it->second].end;
+        return true;
+    }
+
+    clang::Stmt *const m_root;
+    std::vector<Node> m_nodes; // Depth-first order
+    llvm::DenseMap<const clang::Stmt *, unsigned int> m_positions;
+    std::vector<std::vector<unsigned int>> m_positionsByClass; // Sorted positions, one non-empty list per statement class found
+    mutable llvm::DenseMap<const clang::ValueDecl *, std::vector<IndexedUse>> m_uses; // Built by the first usesOf() call
+    mutable bool m_usesIndexed = false;
+};
+
+// Overloads of the HierarchyUtils.h helpers which use index if it has the statement, and walk the AST otherwise
+
+namespace clazy {
+
+inline bool isChildOf(const StmtIndex *index, clang::Stmt *child, clang::Stmt *parent)
+{
+    if (index && index->contains(parent))
+        return index->isDescendant(child, parent);
+
+    return isChildOf(child, parent);
+}
+
+template <typename T>
+T* getFirstChildOfType(const StmtIndex *index, clang::Stmt *stm)
+{
+    if (index && index->contains(stm))
+        return index->firstDescendantOfType<T>(stm);
+
+    return getFirstChildOfType<T>(stm);
+}
+
+template <typename T>
+void getChilds(const StmtIndex *index, clang::Stmt *stmt, std::vector<T*> &result_list)
+{
+    if (index && index->contains(stmt))
+        clazy::append(index->statementsOfType<T>(stmt), result_list);
+    else
+        getChilds<T>(stmt, result_list);
+}
+
+template <typename T>
+std::vector<T*> getStatements(const StmtIndex *index, clang::Stmt *body,
+                              const clang::SourceManager *sm = nullptr,
+                              clang::SourceLocation startLocation = {})
+{
+    if (!index || !index->contains(body))
+        return getStatements<T>(body, sm, startLocation);
+
+    std::vector<T*> statements = index->statementsOfType<T>(body, /*includeSelf=*/ false);
+    if (startLocation.isValid()) {
+        const clang::SourceLocation spellingStart = sm ? sm->getSpellingLoc(startLocation) : clang::SourceLocation();
+        statements.erase(std::remove_if(statements.begin(), statements.end(), [sm, spellingStart](T *t) {
+            return !sm || !sm->isBeforeInSLocAddrSpace(spellingStart, clazy::getLocStart(t));
+        }), statements.end());
+    }
+
+    return statements;
+}
+
+}
+
+#endif
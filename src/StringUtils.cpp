@@ -24,6 +24,10 @@
 
 #include "StringUtils.h"
 
+#include <clang/AST/DeclTemplate.h>
+
+#include <algorithm>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -66,3 +70,253 @@ bool clazy::anyArgIsOfAnySimpleType(clang::FunctionDecl *func,
         return clazy::anyArgIsOfSimpleType(func, simpleType, lo);
     });
 }
+
+void clazy::appendJsonString(string &out, llvm::StringRef str)
+{
+    static const char hexDigits[] = "0123456789abcdef";
+    out += '"';
+    for (char c : str) {
+        switch (c) {
+        case '"':
+            out += "\\\"";
+            break;
+        case '\\':
+            out += "\\\\";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        case '\t':
+            out += "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                out += "\\u00";
+                out += hexDigits[(c >> 4) & 0xf];
+                out += hexDigits[c & 0xf];
+            } else {
+                out += c;
+            }
+        }
+    }
+    out += '"';
+}
+
+clazy::NameSet::NameSet(std::initializer_list<llvm::StringRef> names)
+{
+    vector<llvm::StringRef> uniqueNames;
+    for (llvm::StringRef name : names) {
+        if (!name.empty() && !clazy::contains(uniqueNames, name))
+            uniqueNames.push_back(name);
+    }
+
+    size_t numBuckets = 4;
+    while (numBuckets < uniqueNames.size() * 2)
+        numBuckets *= 2;
+
+    // Look for a seed without collisions, with up to 8 times more buckets than needed, the tables are small
+    for (size_t buckets = numBuckets; buckets <= numBuckets * 8; buckets *= 2) {
+        for (unsigned int seed = 0; seed < 64; ++seed) {
+            if (tryBuild(uniqueNames, buckets, seed, /*allowCollisions=*/ false)) {
+                m_isPerfect = true;
+                return;
+            }
+        }
+    }
+
+    tryBuild(uniqueNames, numBuckets, 0, /*allowCollisions=*/ true);
+}
+
+bool clazy::NameSet::tryBuild(const vector<llvm::StringRef> &names, size_t numBuckets, unsigned int seed, bool allowCollisions)
+{
+    m_buckets.assign(numBuckets, string());
+    m_mask = numBuckets - 1;
+    m_seed = seed;
+
+    for (llvm::StringRef name : names) {
+        size_t i = hash(name, seed) & m_mask;
+        while (!m_buckets[i].empty()) {
+            if (!allowCollisions)
+                return false;
+            i = (i + 1) & m_mask;
+        }
+        m_buckets[i] = name.str();
+    }
+
+    return true;
+}
+
+// Returns true if classNameFor(record) would be empty
+static bool classNameIsEmpty(const CXXRecordDecl *record)
+{
+    for (; record; record = dyn_cast_or_null<CXXRecordDecl>(record->getParent())) {
+        if (!clazy::name(record).empty())
+            return false;
+    }
+
+    return true;
+}
+
+// Removes suffix from the end of str, returns false if str doesn't end with it
+static bool consumeSuffix(llvm::StringRef &str, llvm::StringRef suffix)
+{
+    if (!str.endswith(suffix))
+        return false;
+
+    str = str.drop_back(suffix.size());
+    return true;
+}
+
+bool clazy::classNameIs(const CXXRecordDecl *record, llvm::StringRef className)
+{
+    if (!record)
+        return className.empty();
+
+    const llvm::StringRef name = clazy::name(record);
+    auto parent = dyn_cast_or_null<CXXRecordDecl>(record->getParent());
+    if (classNameIsEmpty(parent))
+        return className == name;
+
+    return consumeSuffix(className, name) && consumeSuffix(className, "::") && classNameIs(parent, className);
+}
+
+bool clazy::qualifiedNameIs(const NamedDecl *decl, llvm::StringRef qualifiedName)
+{
+    if (!decl)
+        return false;
+
+    llvm::StringRef rest = qualifiedName;
+    if (decl->getDeclName().isIdentifier()) {
+        if (!consumeSuffix(rest, decl->getName()))
+            return false;
+    } else if (auto ctor = dyn_cast<CXXConstructorDecl>(decl)) {
+        if (!consumeSuffix(rest, clazy::name(ctor->getParent())))
+            return false;
+    } else {
+        return decl->getQualifiedNameAsString() == qualifiedName; // Operators and such, rare enough
+    }
+
+    for (const DeclContext *context = decl->getDeclContext(); context; context = context->getParent()) {
+        if (isa<TranslationUnitDecl>(context))
+            break;
+
+        if (isa<LinkageSpecDecl>(context))
+            continue;
+
+        if (auto ns = dyn_cast<NamespaceDecl>(context)) {
+            if (ns->isInline())
+                continue;
+            if (ns->isAnonymousNamespace())
+                return false;
+        } else if (isa<ClassTemplateSpecializationDecl>(context) || !isa<TagDecl>(context)) {
+            return false; // Would be printed with template arguments, or is a function
+        }
+
+        auto named = cast<NamedDecl>(context);
+        if (!named->getDeclName().isIdentifier())
+            return false; // Anonymous struct
+
+        if (!consumeSuffix(rest, "::") || !consumeSuffix(rest, named->getName()))
+            return false;
+    }
+
+    return rest.empty();
+}
+
+bool clazy::qualifiedMethodNameIs(const FunctionDecl *func, llvm::StringRef name)
+{
+    auto method = dyn_cast_or_null<CXXMethodDecl>(func);
+    if (!method)
+        return func && clazy::qualifiedNameIs(func, name);
+
+    // Same format as qualifiedMethodName(): only the class name, without its scopes or template arguments
+    if (!method->getParent())
+        return name.empty();
+
+    llvm::StringRef rest = name;
+    if (method->getDeclName().isIdentifier()) {
+        if (!consumeSuffix(rest, method->getName()))
+            return false;
+    } else if (isa<CXXConstructorDecl>(method)) {
+        if (!consumeSuffix(rest, clazy::name(method->getParent())))
+            return false;
+    } else {
+        return clazy::qualifiedMethodName(const_cast<CXXMethodDecl*>(method)) == name;
+    }
+
+    return consumeSuffix(rest, "::") && rest == clazy::name(method->getParent());
+}
+
+// Two rows of the classic dynamic programming table, for strings too long for the bit-parallel version
+static unsigned int editDistanceDP(llvm::StringRef s1, llvm::StringRef s2, unsigned int maxDistance)
+{
+    std::vector<unsigned int> previous(s1.size() + 1);
+    std::vector<unsigned int> current(s1.size() + 1);
+    for (size_t i = 0; i <= s1.size(); ++i)
+        previous[i] = i;
+
+    for (size_t j = 1; j <= s2.size(); ++j) {
+        current[0] = j;
+        unsigned int rowMinimum = current[0];
+        for (size_t i = 1; i <= s1.size(); ++i) {
+            current[i] = std::min({ previous[i] + 1, current[i - 1] + 1, previous[i - 1] + (s1[i - 1] == s2[j - 1] ? 0 : 1) });
+            rowMinimum = std::min(rowMinimum, current[i]);
+        }
+
+        if (rowMinimum > maxDistance)
+            return maxDistance + 1; // Values never decrease from one row to the next's minimum
+        previous.swap(current);
+    }
+
+    return std::min(previous[s1.size()], maxDistance + 1);
+}
+
+unsigned int clazy::editDistance(llvm::StringRef s1, llvm::StringRef s2, unsigned int maxDistance)
+{
+    if (s1.size() > s2.size())
+        std::swap(s1, s2); // s1 is the pattern, the shorter one
+
+    if (s2.size() - s1.size() > maxDistance)
+        return maxDistance + 1;
+
+    if (s1.empty())
+        return s2.size();
+
+    if (s1.size() > 64)
+        return editDistanceDP(s1, s2, maxDistance);
+
+    // Bit i of peq[c] is set if s1[i] == c
+    uint64_t peq[256] = {};
+    for (size_t i = 0; i < s1.size(); ++i)
+        peq[static_cast<unsigned char>(s1[i])] |= uint64_t(1) << i;
+
+    // The vertical deltas of the current column, +1 (pv) or -1 (mv), and the last row's value
+    const uint64_t lastRow = uint64_t(1) << (s1.size() - 1);
+    uint64_t pv = ~uint64_t(0);
+    uint64_t mv = 0;
+    unsigned int distance = s1.size();
+    for (size_t j = 0; j < s2.size(); ++j) {
+        const uint64_t eq = peq[static_cast<unsigned char>(s2[j])];
+        const uint64_t xv = eq | mv;
+        const uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+        if (ph & lastRow)
+            distance++;
+        else if (mh & lastRow)
+            distance--;
+
+        // The first row is j, each step adds 1 to it
+        ph = (ph << 1) | 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+
+        // Each remaining character can lower the distance by one at most
+        const size_t remaining = s2.size() - j - 1;
+        if (distance > maxDistance + remaining)
+            return maxDistance + 1;
+    }
+
+    return std::min(distance, maxDistance + 1);
+}
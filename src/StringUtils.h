@@ -47,6 +47,7 @@
 #include <llvm/Support/Casting.h>
 #include <llvm/Support/raw_ostream.h>
 
+#include <initializer_list>
 #include <string>
 #include <vector>
 
@@ -79,47 +80,55 @@ inline std::string classNameFor(const clang::CXXRecordDecl *record)
     return name;
 }
 
-inline std::string classNameFor(clang::CXXConstructorDecl *ctorDecl)
+// Returns the class whose name classNameFor() returns
+inline const clang::CXXRecordDecl *recordFor(const clang::CXXRecordDecl *record)
 {
-    return classNameFor(ctorDecl->getParent());
+    return record;
 }
 
-inline std::string classNameFor(clang::CXXMethodDecl *method)
+inline const clang::CXXRecordDecl *recordFor(clang::CXXConstructorDecl *ctorDecl)
 {
-    return method ? classNameFor(method->getParent()) : std::string();
+    return ctorDecl->getParent();
 }
 
-inline std::string classNameFor(clang::CXXConstructExpr *expr)
+inline const clang::CXXRecordDecl *recordFor(clang::CXXMethodDecl *method)
 {
-    return classNameFor(expr->getConstructor());
+    return method ? method->getParent() : nullptr;
 }
 
-inline std::string classNameFor(clang::CXXOperatorCallExpr *call)
+inline const clang::CXXRecordDecl *recordFor(clang::CXXConstructExpr *expr)
 {
-    return call ? classNameFor(llvm::dyn_cast_or_null<clang::CXXMethodDecl>(call->getDirectCallee())) : std::string();
+    return recordFor(expr->getConstructor());
 }
 
-inline std::string classNameFor(clang::QualType qt)
+inline const clang::CXXRecordDecl *recordFor(clang::CXXOperatorCallExpr *call)
+{
+    return call ? recordFor(llvm::dyn_cast_or_null<clang::CXXMethodDecl>(call->getDirectCallee())) : nullptr;
+}
+
+inline const clang::CXXRecordDecl *recordFor(clang::QualType qt)
 {
     qt = qt.getNonReferenceType().getUnqualifiedType();
     const clang::Type *t = qt.getTypePtrOrNull();
     if (!t)
-        return {};
+        return nullptr;
 
     if (clang::ElaboratedType::classof(t))
-        return classNameFor(static_cast<const clang::ElaboratedType*>(t)->getNamedType());
+        return recordFor(static_cast<const clang::ElaboratedType*>(t)->getNamedType());
 
-    const clang::CXXRecordDecl *record = t->isRecordType() ? t->getAsCXXRecordDecl()
-                                                           : t->getPointeeCXXRecordDecl();
-    return classNameFor(record);
+    return t->isRecordType() ? t->getAsCXXRecordDecl()
+                             : t->getPointeeCXXRecordDecl();
 }
 
-inline std::string classNameFor(clang::ParmVarDecl *param)
+inline const clang::CXXRecordDecl *recordFor(clang::ParmVarDecl *param)
 {
-    if (!param)
-        return {};
+    return param ? recordFor(param->getType()) : nullptr;
+}
 
-    return classNameFor(param->getType());
+template <typename T>
+inline std::string classNameFor(T node)
+{
+    return classNameFor(recordFor(node));
 }
 
 inline llvm::StringRef name(const clang::NamedDecl *decl)
@@ -162,10 +171,102 @@ inline std::string name(clang::QualType t, clang::LangOptions lo, bool asWritten
     return t.getAsString(p);
 }
 
+/**
+ * Returns the same as classNameFor(record) == className, but without building any string.
+ * For the hot paths, like checking the class of every CXXConstructExpr.
+ */
+bool classNameIs(const clang::CXXRecordDecl *record, llvm::StringRef className);
+
+template <typename T>
+inline bool classNameIs(T node, llvm::StringRef className)
+{
+    return classNameIs(recordFor(node), className);
+}
+
 template <typename T>
 inline bool isOfClass(T *node, llvm::StringRef className)
 {
-    return node && classNameFor(node) == className;
+    return node && classNameIs(node, className);
+}
+
+/**
+ * Returns the same as getQualifiedNameAsString() == qualifiedName, but without building any string.
+ * The scopes of decl are compared one by one against the "::" separated parts of qualifiedName, for example
+ * "std::vector" or "QObject::connect". Inline namespaces are skipped, like clang does when printing.
+ * Returns false for names which would be printed with template arguments or anonymous scopes.
+ */
+bool qualifiedNameIs(const clang::NamedDecl *decl, llvm::StringRef qualifiedName);
+
+/**
+ * A set of names for the hot paths, like the function and class names a check looks for, declared as a static table:
+ *     static const clazy::NameSet names = { "append", "push_back" };
+ *
+ * The hash function is chosen at construction so that every name gets its own bucket, which makes contains()
+ * one cheap hash of the length and a few characters, plus at most one string compare.
+ */
+class NameSet
+{
+public:
+    NameSet(std::initializer_list<llvm::StringRef> names);
+
+    bool contains(llvm::StringRef name) const
+    {
+        if (name.empty())
+            return false;
+
+        // Linear probing is only needed if no perfect hash was found, see the constructor
+        for (size_t i = hash(name, m_seed) & m_mask; !m_buckets[i].empty(); i = (i + 1) & m_mask) {
+            if (m_buckets[i] == name)
+                return true;
+            if (m_isPerfect)
+                return false;
+        }
+
+        return false;
+    }
+
+private:
+    static size_t hash(llvm::StringRef name, unsigned int seed)
+    {
+        size_t h = seed + name.size();
+        h = h * 31 + static_cast<unsigned char>(name.front());
+        h = h * 31 + static_cast<unsigned char>(name[name.size() / 2]);
+        h = h * 31 + static_cast<unsigned char>(name.back());
+        return h ^ (h >> 5);
+    }
+
+    bool tryBuild(const std::vector<llvm::StringRef> &names, size_t numBuckets, unsigned int seed, bool allowCollisions);
+
+    std::vector<std::string> m_buckets; // Empty string for free buckets
+    size_t m_mask = 0;
+    unsigned int m_seed = 0;
+    bool m_isPerfect = false;
+};
+
+inline bool functionIsOneOf(clang::FunctionDecl *func, const NameSet &functionNames)
+{
+    return func && functionNames.contains(clazy::name(func));
+}
+
+inline bool classIsOneOf(clang::CXXRecordDecl *record, const NameSet &classNames)
+{
+    return record && classNames.contains(clazy::name(record));
+}
+
+/**
+ * Returns the same as classNames.contains(classNameFor(node)), only building the name for nested classes.
+ */
+template <typename T>
+inline bool classNameIsOneOf(T node, const NameSet &classNames)
+{
+    const clang::CXXRecordDecl *record = recordFor(node);
+    if (!record)
+        return false;
+
+    if (!llvm::isa<clang::CXXRecordDecl>(record->getParent()))
+        return classNames.contains(clazy::name(record));
+
+    return classNames.contains(classNameFor(record));
 }
 
 inline bool functionIsOneOf(clang::FunctionDecl *func, const std::vector<llvm::StringRef> &functionNames)
@@ -226,6 +327,16 @@ inline std::string qualifiedMethodName(clang::CallExpr *call)
     return call ? qualifiedMethodName(call->getDirectCallee()) : std::string();
 }
 
+/**
+ * Returns the same as qualifiedMethodName(func) == name, without building any string.
+ */
+bool qualifiedMethodNameIs(const clang::FunctionDecl *func, llvm::StringRef name);
+
+inline bool qualifiedMethodNameIs(clang::CallExpr *call, llvm::StringRef name)
+{
+    return call && qualifiedMethodNameIs(call->getDirectCallee(), name);
+}
+
 inline std::string accessString(clang::AccessSpecifier s)
 {
     switch (s)
@@ -310,6 +421,18 @@ bool anyArgIsOfSimpleType(clang::FunctionDecl *func, const std::string &simpleTy
  */
 bool anyArgIsOfAnySimpleType(clang::FunctionDecl *func, const std::vector<std::string> &simpleTypes, const clang::LangOptions &);
 
+/**
+ * Appends str to out as a quoted JSON string, escaping it as needed
+ */
+void appendJsonString(std::string &out, llvm::StringRef str);
+
+/**
+ * Returns the Levenshtein distance between s1 and s2, or maxDistance + 1 if it's bigger than maxDistance,
+ * in which case it stops as soon as that's certain.
+ * Uses Myers' bit-parallel algorithm if the shorter string fits in 64 characters, without allocating.
+ */
+unsigned int editDistance(llvm::StringRef s1, llvm::StringRef s2, unsigned int maxDistance);
+
 inline void dump(const clang::SourceManager &sm, clang::Stmt *s)
 {
     if (!s)
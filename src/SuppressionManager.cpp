@@ -21,13 +21,15 @@
 
 #include "SuppressionManager.h"
 #include "SourceCompatibilityHelpers.h"
-#include "clazy_stl.h"
 
+#include <clang/Basic/CharInfo.h>
 #include <clang/Basic/SourceManager.h>
 #include <clang/Lex/Lexer.h>
 #include <clang/Basic/SourceLocation.h>
 #include <clang/Basic/TokenKinds.h>
 #include <clang/Lex/Token.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringRef.h>
 #include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/raw_ostream.h>
 
@@ -77,8 +79,23 @@ bool SuppressionManager::isSuppressed(const std::string &checkName, clang::Sourc
     return checkIsSuppressedByLine;
 }
 
+// Returns the comma separated check names following key, up to the first whitespace.
+// For example "a,b" for key "clazy:exclude=" and comment "// clazy:exclude=a,b foo"
+static llvm::SmallVector<llvm::StringRef, 4> checkNamesAfter(llvm::StringRef comment, llvm::StringRef key)
+{
+    llvm::SmallVector<llvm::StringRef, 4> checkNames;
+    const size_t pos = comment.find(key);
+    if (pos != llvm::StringRef::npos) {
+        llvm::StringRef value = comment.substr(pos + key.size()).take_until([](char c) { return isWhitespace(c); });
+        value.split(checkNames, ',', /*MaxSplit=*/ -1, /*KeepEmpty=*/ false);
+    }
+
+    return checkNames;
+}
+
 void SuppressionManager::parseFile(FileID id, const SourceManager &sm, const clang::LangOptions &lo) const
 {
+    CLAZY_TIME_TRACE_SCOPE("clazy SuppressionManager::parseFile", sm.getFilename(sm.getLocForStartOfFile(id)));
     const unsigned hash = id.getHashValue();
     auto it = m_processedFileIDs.insert({hash, Suppressions()}).first;
     Suppressions &suppressions = (*it).second;
@@ -92,25 +109,28 @@ void SuppressionManager::parseFile(FileID id, const SourceManager &sm, const cla
         return;
     }
 
+    // Most files don't have any clazy comment, don't pay for lexing them
+    if (buffer->getBuffer().find("clazy:") == llvm::StringRef::npos)
+        return;
+
     Lexer lexer(id, buffer, sm, lo);
     lexer.SetCommentRetentionState(true);
 
     Token token;
     while (!lexer.LexFromRawLexer(token)) {
         if (token.getKind() == tok::comment) {
-            std::string comment = Lexer::getSpelling(token, sm, lo);
+            // Read the raw text, Lexer::getSpelling() would allocate a std::string for every comment
+            const llvm::StringRef comment(sm.getCharacterData(token.getLocation()), token.getLength());
+            if (!comment.contains("clazy:"))
+                continue;
 
-            if (clazy::contains(comment, "clazy:skip")) {
+            if (comment.contains("clazy:skip")) {
                 suppressions.skipEntireFile = true;
                 return;
             }
 
-            static regex rx(R"(clazy:excludeall=(.*?)(\s|$))");
-            smatch match;
-            if (regex_search(comment, match, rx) && match.size() > 1) {
-                vector<string> checks = clazy::splitString(match[1], ',');
-                suppressions.checksToSkip.insert(checks.cbegin(), checks.cend());
-            }
+            for (llvm::StringRef checkName : checkNamesAfter(comment, "clazy:excludeall="))
+                suppressions.checksToSkip.insert(checkName.str());
 
             const int lineNumber = sm.getSpellingLineNumber(token.getLocation());
             if (lineNumber < 0) {
@@ -118,14 +138,17 @@ void SuppressionManager::parseFile(FileID id, const SourceManager &sm, const cla
                 continue;
             }
 
-            static regex rx2(R"(clazy:exclude=(.*?)(\s|$))");
-            if (regex_search(comment, match, rx2) && match.size() > 1) {
-                vector<string> checks = clazy::splitString(match[1], ',');
-
-                for (const string &checkName : checks) {
-                    suppressions.checksToSkipByLine.insert(LineAndCheckName(lineNumber, checkName));
-                }
-            }
+            for (llvm::StringRef checkName : checkNamesAfter(comment, "clazy:exclude="))
+                suppressions.checksToSkipByLine.insert(LineAndCheckName(lineNumber, checkName.str()));
         }
     }
 }
+
+size_t SuppressionManager::numSuppressions() const
+{
+    size_t count = 0;
+    for (const auto &it : m_processedFileIDs)
+        count += it.second.checksToSkip.size() + it.second.checksToSkipByLine.size() + (it.second.skipEntireFile ? 1 : 0);
+
+    return count;
+}
@@ -54,6 +54,10 @@ public:
     bool isSuppressed(const std::string &checkName, clang::SourceLocation,
                       const clang::SourceManager &, const clang::LangOptions &) const;
 
+    // For the print-stats option
+    size_t numFiles() const { return m_processedFileIDs.size(); }
+    size_t numSuppressions() const;
+
 private:
     void parseFile(clang::FileID, const clang::SourceManager &, const clang::LangOptions &lo) const;
     SuppressionManager(const SuppressionManager &) = delete;
@@ -90,6 +90,17 @@ ClassTemplateSpecializationDecl *clazy::templateDecl(Decl *decl)
     return dyn_cast<ClassTemplateSpecializationDecl>(classDecl);
 }
 
+ClassTemplateSpecializationDecl *clazy::templateDeclOrMemberType(Decl *decl)
+{
+    auto field = dyn_cast<FieldDecl>(decl);
+    if (!field)
+        return templateDecl(decl);
+
+    const Type *t = field->getType().getTypePtrOrNull();
+    CXXRecordDecl *record = t ? t->getAsCXXRecordDecl() : nullptr;
+    return record ? dyn_cast<ClassTemplateSpecializationDecl>(record) : nullptr;
+}
+
 string clazy::getTemplateArgumentTypeStr(ClassTemplateSpecializationDecl *specialization,
                                          unsigned int index, const LangOptions &lo, bool recordOnly)
 {
@@ -121,3 +132,17 @@ clang::QualType clazy::getTemplateArgumentType(ClassTemplateSpecializationDecl *
 
     return args[index].getAsType();
 }
+
+const CXXRecordDecl *clazy::getTemplateArgumentRecord(ClassTemplateSpecializationDecl *specialization, unsigned int index)
+{
+    if (!specialization)
+        return nullptr;
+
+    auto &args = specialization->getTemplateArgs();
+    if (args.size() <= index || args[index].getKind() != TemplateArgument::Type)
+        return nullptr;
+
+    const Type *t = args[index].getAsType().getTypePtrOrNull();
+    const CXXRecordDecl *record = t ? t->getAsCXXRecordDecl() : nullptr;
+    return record ? record->getCanonicalDecl() : nullptr;
+}
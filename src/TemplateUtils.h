@@ -19,7 +19,9 @@
     Boston, MA 02110-1301, USA.
 */
 
+#include <clang/AST/DeclTemplate.h>
 #include <clang/AST/Type.h>
+#include <llvm/ADT/DenseMap.h>
 
 #include <vector>
 #include <string>
@@ -50,6 +52,12 @@ std::vector<clang::QualType> getTemplateArgumentsTypes(clang::CXXRecordDecl *);
 
 clang::ClassTemplateSpecializationDecl *templateDecl(clang::Decl *decl);
 
+/**
+ * Like templateDecl(), but also returns the type of members.
+ * Example: for "QVector<Foo> m_foos;" it returns QVector<Foo>
+ */
+clang::ClassTemplateSpecializationDecl *templateDeclOrMemberType(clang::Decl *decl);
+
 /**
  * Returns a string with the type name of the argument at the specified index.
  * If recordOnly is true, then it will only return a name if the argument is a class or struct.
@@ -61,4 +69,44 @@ std::string getTemplateArgumentTypeStr(clang::ClassTemplateSpecializationDecl*,
 
 clang::QualType getTemplateArgumentType(clang::ClassTemplateSpecializationDecl *, unsigned int index);
 
+/**
+ * Returns the canonical declaration of the class or struct passed as the template argument at the specified index,
+ * or nullptr if that argument isn't a record type.
+ * Cheaper than comparing getTemplateArgumentTypeStr() results, as no type needs to be pretty-printed.
+ *
+ * Example: For QTypeInfo<Foo>, getTemplateArgumentRecord(decl, 0) would return Foo's CXXRecordDecl
+ */
+const clang::CXXRecordDecl *getTemplateArgumentRecord(clang::ClassTemplateSpecializationDecl *, unsigned int index);
+
+/**
+ * Remembers what a check concluded about each class template specialization, for checks that are called for
+ * every use of a specialization, like each QList<Foo> variable, but whose conclusion only depends on the
+ * template arguments. So QList<Foo> is analyzed once, no matter how many variables use it.
+ *
+ * Keyed by the canonical declaration. Holds declarations, so it must not outlive the translation unit.
+ */
+template <typename T>
+class SpecializationMemo
+{
+public:
+    /**
+     * Returns the value computed for specialization, calling compute(specialization) the first time.
+     */
+    template <typename Compute>
+    const T &get(clang::ClassTemplateSpecializationDecl *specialization, Compute compute)
+    {
+        const clang::ClassTemplateSpecializationDecl *key = specialization->getCanonicalDecl();
+        auto it = m_values.find(key);
+        if (it == m_values.end())
+            it = m_values.insert({ key, compute(specialization) }).first;
+
+        return it->second;
+    }
+
+    void clear() { m_values.clear(); }
+
+private:
+    llvm::DenseMap<const clang::ClassTemplateSpecializationDecl *, T> m_values;
+};
+
 }
@@ -0,0 +1,161 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "TranslationUnitSample.h"
+
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Format.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <tuple>
+#include <utility>
+
+using namespace std;
+
+// FNV-1a, stable across platforms and runs, unlike std::hash
+static uint64_t hashOf(llvm::StringRef str)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (char c : str) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+TranslationUnitSample::TranslationUnitSample(const vector<string> &files, double fraction)
+{
+    // Ordered, so runs are reproducible
+    map<string, vector<pair<uint64_t, string>>> filesByDirectory;
+    for (const string &file : files)
+        filesByDirectory[llvm::sys::path::parent_path(file).str()].push_back({ hashOf(llvm::sys::path::filename(file)), file });
+
+    for (auto &it : filesByDirectory) {
+        vector<pair<uint64_t, string>> &directoryFiles = it.second;
+        sort(directoryFiles.begin(), directoryFiles.end());
+
+        const size_t population = directoryFiles.size();
+        const size_t numFiles = min(population, max<size_t>(1, static_cast<size_t>(ceil(fraction * population))));
+        m_strata.push_back({ population, m_files.size(), numFiles });
+        for (size_t i = 0; i < numFiles; ++i)
+            m_files.push_back(directoryFiles[i].second);
+
+        m_population += population;
+    }
+}
+
+// Returns the number of warnings of each check in a file's diagnostics
+static map<string, unsigned int> countWarnings(llvm::StringRef output)
+{
+    map<string, unsigned int> counts;
+    llvm::SmallVector<llvm::StringRef, 32> lines;
+    output.split(lines, '\n', -1, /*KeepEmpty=*/ false);
+    for (llvm::StringRef line : lines) {
+        // Our warnings end with " [-Wclazy-<check>]"
+        const size_t tagStart = line.rfind(" [-Wclazy-");
+        if (tagStart != llvm::StringRef::npos && line.endswith("]"))
+            counts[line.slice(tagStart + strlen(" [-Wclazy-"), line.size() - 1).str()]++;
+    }
+
+    return counts;
+}
+
+static double sampleVariance(const unsigned int *values, size_t size)
+{
+    if (size < 2)
+        return 0;
+
+    double mean = 0;
+    for (size_t i = 0; i < size; ++i)
+        mean += values[i];
+    mean /= size;
+
+    double sum = 0;
+    for (size_t i = 0; i < size; ++i)
+        sum += (values[i] - mean) * (values[i] - mean);
+
+    return sum / (size - 1);
+}
+
+void TranslationUnitSample::printEstimates(const vector<string> &outputs, llvm::raw_ostream &os) const
+{
+    // Warnings of each check in each sampled file
+    map<string, vector<unsigned int>> counts;
+    for (size_t i = 0; i < outputs.size() && i < m_files.size(); ++i) {
+        for (const auto &it : countWarnings(outputs[i])) {
+            vector<unsigned int> &checkCounts = counts[it.first];
+            checkCounts.resize(m_files.size(), 0);
+            checkCounts[i] = it.second;
+        }
+    }
+
+    // The stratified estimator of the total, T = sum(N_h * mean_h), and of its variance,
+    // V = sum(N_h^2 * (1 - n_h / N_h) * s_h^2 / n_h). A directory with a single sampled file
+    // has no variance of its own, the variance of the whole sample is used instead.
+    struct Estimate {
+        string check;
+        double total;
+        double low;
+        double high;
+    };
+    vector<Estimate> estimates;
+    for (const auto &it : counts) {
+        const vector<unsigned int> &checkCounts = it.second;
+        const double pooledVariance = sampleVariance(checkCounts.data(), checkCounts.size());
+        double total = 0;
+        double variance = 0;
+        double observed = 0; // The total can't be lower
+        for (const Stratum &stratum : m_strata) {
+            const unsigned int *values = checkCounts.data() + stratum.firstFile;
+            double sum = 0;
+            for (size_t i = 0; i < stratum.numFiles; ++i)
+                sum += values[i];
+            observed += sum;
+
+            const double population = stratum.population;
+            const double n = stratum.numFiles;
+            const double s2 = stratum.numFiles > 1 ? sampleVariance(values, stratum.numFiles) : pooledVariance;
+            total += population * sum / n;
+            variance += population * population * (1 - n / population) * s2 / n;
+        }
+
+        const double margin = 1.96 * sqrt(variance);
+        estimates.push_back({ it.first, total, max(observed, total - margin), total + margin });
+    }
+
+    sort(estimates.begin(), estimates.end(), [](const Estimate &a, const Estimate &b) {
+        return make_tuple(-a.total, a.check) < make_tuple(-b.total, b.check);
+    });
+
+    os << "clazy-standalone: Analyzed " << m_files.size() << " of " << m_population << " files, from "
+       << m_strata.size() << " directories. Estimated warnings per check, with 95% confidence intervals:\n";
+    for (const Estimate &estimate : estimates)
+        os << "    " << estimate.check << ": " << llvm::format("%.0f [%.0f, %.0f]", estimate.total, estimate.low, estimate.high) << '\n';
+}
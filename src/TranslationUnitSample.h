@@ -0,0 +1,67 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_TRANSLATION_UNIT_SAMPLE_H
+#define CLAZY_TRANSLATION_UNIT_SAMPLE_H
+
+#include <string>
+#include <vector>
+
+namespace llvm {
+class raw_ostream;
+}
+
+/**
+ * The files analyzed by clazy-standalone -sample, a deterministic pseudo-random fraction of the files
+ * of each directory, and the estimation of the number of warnings all files would have had.
+ *
+ * Each directory is a stratum with at least one sampled file, so a directory with many similar files
+ * doesn't outweigh the others. Files are picked by a hash of their name, the same ones are analyzed by
+ * every run, which keeps trends about the code and not about the sample.
+ */
+class TranslationUnitSample
+{
+public:
+    // fraction must be in ]0, 1]
+    TranslationUnitSample(const std::vector<std::string> &files, double fraction);
+
+    const std::vector<std::string> &files() const { return m_files; }
+
+    /**
+     * Prints the estimated total of warnings per check, with 95% confidence intervals.
+     * outputs are the diagnostics printed for each of files(), in the same order.
+     */
+    void printEstimates(const std::vector<std::string> &outputs, llvm::raw_ostream &os) const;
+
+private:
+    struct Stratum {
+        size_t population; // Number of files in the directory
+        size_t firstFile; // Its sampled files are contiguous in m_files
+        size_t numFiles;
+    };
+
+    std::vector<Stratum> m_strata;
+    std::vector<std::string> m_files;
+    size_t m_population = 0;
+};
+
+#endif
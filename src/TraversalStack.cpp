@@ -0,0 +1,92 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "TraversalStack.h"
+#include "ClazyContext.h"
+#include "HierarchyUtils.h"
+#include "LoopUtils.h"
+
+#include <clang/AST/ParentMap.h>
+#include <clang/AST/Stmt.h>
+
+using namespace clang;
+
+void TraversalStack::push(Stmt *stmt)
+{
+    if (clazy::isLoop(stmt))
+        m_loops.push_back(static_cast<int>(m_stmts.size()));
+    m_stmts.push_back(stmt);
+}
+
+void TraversalStack::pop()
+{
+    if (m_stmts.empty())
+        return;
+
+    m_stmts.pop_back();
+    if (!m_loops.empty() && m_loops.back() == static_cast<int>(m_stmts.size()))
+        m_loops.pop_back();
+}
+
+int TraversalStack::indexOf(const Stmt *stmt) const
+{
+    if (!stmt)
+        return -1;
+
+    for (int i = static_cast<int>(m_stmts.size()) - 1; i >= 0; --i) {
+        if (m_stmts[i] == stmt)
+            return i;
+    }
+
+    return -1;
+}
+
+Stmt *TraversalStack::parent(const Stmt *stmt, unsigned int depth) const
+{
+    const int index = indexOf(stmt);
+    if (index == -1 || static_cast<unsigned int>(index) < depth)
+        return nullptr;
+
+    return m_stmts[index - depth];
+}
+
+Stmt *TraversalStack::enclosingLoop(const Stmt *stmt) const
+{
+    const int index = indexOf(stmt);
+    for (auto it = m_loops.rbegin(); index != -1 && it != m_loops.rend(); ++it) {
+        if (*it < index)
+            return m_stmts[*it];
+    }
+
+    return nullptr;
+}
+
+Stmt *clazy::parent(const ClazyContext *context, Stmt *s, unsigned int depth)
+{
+    if (!s || depth == 0)
+        return s;
+
+    if (context->traversalStack.contains(s))
+        return context->traversalStack.parent(s, depth);
+
+    return context->parentMap ? parent(context->parentMap, s, depth) : nullptr;
+}
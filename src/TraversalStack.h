@@ -0,0 +1,120 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_TRAVERSAL_STACK_H
+#define CLAZY_TRAVERSAL_STACK_H
+
+#include <utility>
+#include <vector>
+
+namespace clang {
+class FunctionDecl;
+class Stmt;
+}
+
+/**
+ * The statements RecursiveASTVisitor is currently inside of, outermost first. ClazyASTConsumer pushes and pops them
+ * in dataTraverseStmtPre() and dataTraverseStmtPost(), so while a check visits a statement it's on top.
+ *
+ * The ancestors of the statement being visited, and of its ancestors, are known without building a ParentMap,
+ * in constant time for the statement itself. Use it through clazy::parent(ClazyContext*, ...) and
+ * clazy::isInLoop(ClazyContext*, ...), which fall back to the ParentMap for other statements.
+ */
+class TraversalStack
+{
+public:
+    void push(clang::Stmt *stmt);
+    void pop();
+
+    clang::Stmt *current() const
+    {
+        return m_stmts.empty() ? nullptr : m_stmts.back();
+    }
+
+    /**
+     * Returns the function whose body is being traversed, which for lambdas is the enclosing function.
+     */
+    clang::FunctionDecl *function() const
+    {
+        return m_function;
+    }
+
+    bool contains(const clang::Stmt *stmt) const
+    {
+        return indexOf(stmt) != -1;
+    }
+
+    /**
+     * Returns the depth-th ancestor of stmt, which must be on the stack, 1 being its parent. nullptr past the root.
+     */
+    clang::Stmt *parent(const clang::Stmt *stmt, unsigned int depth = 1) const;
+
+    /**
+     * Returns the innermost for, range-for, while or do-while loop enclosing stmt, which must be on the stack.
+     */
+    clang::Stmt *enclosingLoop(const clang::Stmt *stmt) const;
+
+    class FunctionScope;
+
+private:
+    // Searches from the top, as the statement being visited and its closest ancestors are the ones asked about
+    int indexOf(const clang::Stmt *stmt) const;
+
+    std::vector<clang::Stmt *> m_stmts;
+    std::vector<int> m_loops; // Indexes into m_stmts
+    clang::FunctionDecl *m_function = nullptr;
+};
+
+/**
+ * Gives a function body a stack of its own while alive, as the ParentMap it replaces is per function too.
+ * Statements of a local class's methods don't have the enclosing function's statements as ancestors.
+ * Does nothing if function is nullptr.
+ */
+class TraversalStack::FunctionScope
+{
+public:
+    FunctionScope(TraversalStack &stack, clang::FunctionDecl *function)
+        : m_stack(stack)
+        , m_active(function != nullptr)
+    {
+        if (m_active) {
+            std::swap(m_stack, m_outer);
+            m_stack.m_function = function;
+        }
+    }
+
+    ~FunctionScope()
+    {
+        if (m_active)
+            std::swap(m_stack, m_outer);
+    }
+
+    FunctionScope(const FunctionScope &) = delete;
+    FunctionScope& operator=(const FunctionScope &) = delete;
+
+private:
+    TraversalStack &m_stack;
+    TraversalStack m_outer;
+    const bool m_active;
+};
+
+#endif
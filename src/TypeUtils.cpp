@@ -24,6 +24,7 @@
 #include "StringUtils.h"
 #include "Utils.h"
 #include "StmtBodyRange.h"
+#include "StmtIndex.h"
 #include "ClazyContext.h"
 
 #include <clang/AST/ASTContext.h>
@@ -36,16 +37,15 @@
 
 using namespace clang;
 
-bool clazy::classifyQualType(const ClazyContext *context, clang::QualType qualType,
-                             const VarDecl *varDecl, QualTypeClassification &classif,
-                             clang::Stmt *body)
+// The part of classifyQualType() which only depends on the type
+static bool classifyType(const ClazyContext *context, QualType qualType, clazy::QualTypeClassification &classif)
 {
     QualType unrefQualType = clazy::unrefQualType(qualType);
     const Type *paramType = unrefQualType.getTypePtrOrNull();
     if (!paramType || paramType->isIncompleteType())
         return false;
 
-    if (isUndeducibleAuto(paramType))
+    if (clazy::isUndeducibleAuto(paramType))
         return false;
 
     classif.size_of_T = context->astContext.getTypeSize(unrefQualType) / 8;
@@ -66,8 +66,43 @@ bool clazy::classifyQualType(const ClazyContext *context, clang::QualType qualTy
         }
     } else if (classif.isConst && classif.isReference && !classif.isNonTriviallyCopyable && !classif.isBig) {
         classif.passSmallTrivialByValue = true;
-    } else if (varDecl && !classif.isConst && !classif.isReference && (classif.isBig || classif.isNonTriviallyCopyable)) {
-        if (body && (Utils::containsNonConstMemberCall(context->parentMap, body, varDecl) || Utils::isPassedToFunction(StmtBodyRange(body), varDecl, /*byrefonly=*/ true)))
+    }
+
+    return true;
+}
+
+// Returns classifyType()'s result, computed once per canonical type, as the same few types are used by most parameters.
+// Failures aren't cached, an incomplete type can be completed later in the translation unit.
+static bool cachedClassification(const ClazyContext *context, QualType qualType, clazy::QualTypeClassification &classif)
+{
+    void *key = qualType.getCanonicalType().getAsOpaquePtr();
+    auto it = context->qualTypeClassifications.find(key);
+    if (it != context->qualTypeClassifications.end()) {
+        classif = it->second;
+        return true;
+    }
+
+    clazy::QualTypeClassification result;
+    if (!classifyType(context, qualType, result))
+        return false;
+
+    context->qualTypeClassifications[key] = result;
+    classif = result;
+    return true;
+}
+
+bool clazy::classifyQualType(const ClazyContext *context, clang::QualType qualType,
+                             const VarDecl *varDecl, QualTypeClassification &classif,
+                             clang::Stmt *body)
+{
+    if (qualType.isNull() || !cachedClassification(context, qualType, classif))
+        return false;
+
+    if (qualType->isRValueReferenceType()) // && ref, nothing to do here
+        return true;
+
+    if (varDecl && !classif.isConst && !classif.isReference && (classif.isBig || classif.isNonTriviallyCopyable)) {
+        if (body && (Utils::containsNonConstMemberCall(context->parentMap, body, varDecl) || Utils::isPassedToFunction(StmtBodyRange(body, nullptr, {}, context->functionStmtIndex(body)), varDecl, /*byrefonly=*/ true)))
             return true;
 
         classif.passNonTriviallyCopyableByConstRef = classif.isNonTriviallyCopyable;
@@ -90,29 +125,15 @@ bool clazy::isSmallTrivial(const ClazyContext *context, QualType qualType)
     if (qualType->isPointerType()) // We don't care about ** (We can change this whenever we have a use case)
         return false;
 
-    QualType unrefQualType = clazy::unrefQualType(qualType);
-    const Type *paramType = unrefQualType.getTypePtrOrNull();
-    if (!paramType || paramType->isIncompleteType())
-        return false;
-
-    if (isUndeducibleAuto(paramType))
-        return false;
-
     if (qualType->isRValueReferenceType()) // && ref, nothing to do here
         return false;
 
-     CXXRecordDecl *recordDecl = paramType->getAsCXXRecordDecl();
-     CXXMethodDecl *copyCtor = recordDecl ? Utils::copyCtor(recordDecl) : nullptr;
-     const bool hasDeletedCopyCtor = copyCtor && copyCtor->isDeleted();
-     const bool isTrivial = recordDecl && !recordDecl->hasNonTrivialCopyConstructor() && !recordDecl->hasNonTrivialDestructor() && !hasDeletedCopyCtor;
-
-     if (isTrivial) {
-         const auto typeSize = context->astContext.getTypeSize(unrefQualType) / 8;
-         const bool isSmall = typeSize <= 16;
-         return isSmall;
-     }
+    const Type *paramType = clazy::unrefQualType(qualType).getTypePtrOrNull();
+    if (!paramType || !paramType->getAsCXXRecordDecl())
+        return false;
 
-     return false;
+    QualTypeClassification classif;
+    return cachedClassification(context, qualType, classif) && !classif.isNonTriviallyCopyable && !classif.isBig;
 }
 
 void clazy::heapOrStackAllocated(Expr *arg, const std::string &type,
@@ -183,7 +204,7 @@ bool clazy::derivesFrom(const clang::CXXRecordDecl *derived, const std::string &
     if (!derived || !derived->hasDefinition())
         return false;
 
-    if (derived->getQualifiedNameAsString() == possibleBase)
+    if (clazy::qualifiedNameIs(derived, possibleBase))
         return true;
 
     for (auto base : derived->bases()) {
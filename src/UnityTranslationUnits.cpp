@@ -0,0 +1,130 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "UnityTranslationUnits.h"
+#include "HeaderTranslationUnits.h"
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+
+#include <algorithm>
+#include <utility>
+
+using namespace clang::tooling;
+using namespace std;
+
+string UnityTranslationUnits::commandKey(CompileCommand command, llvm::StringRef file)
+{
+    HeaderTranslationUnits::replaceInputFile(command, file, string());
+    string key = command.Directory;
+    bool skipNext = false;
+    for (const string &arg : command.CommandLine) {
+        const llvm::StringRef argRef(arg);
+        if (skipNext) {
+            skipNext = false;
+        } else if (arg == "-o" || arg == "-MF" || arg == "-MT" || arg == "-MQ") {
+            skipNext = true;
+        } else if (!argRef.startswith("-o") && !argRef.startswith("-MF") && !argRef.startswith("/Fo")) {
+            key += '\n' + arg;
+        }
+    }
+
+    return key;
+}
+
+UnityTranslationUnits::UnityTranslationUnits(const CompilationDatabase &compilations,
+                                             const vector<string> &sources, unsigned int batchSize)
+    : m_compilations(compilations)
+{
+    // Keeps the order of first appearance, so runs are reproducible
+    vector<string> keys;
+    unordered_map<string, vector<string>> filesByKey;
+    vector<string> unbatched;
+    for (const string &source : sources) {
+        const vector<CompileCommand> commands = m_compilations.getCompileCommands(source);
+        if (commands.size() != 1) {
+            unbatched.push_back(source);
+            continue;
+        }
+
+        const string key = commandKey(commands.front(), source);
+        vector<string> &files = filesByKey[key];
+        if (files.empty())
+            keys.push_back(key);
+        files.push_back(source);
+    }
+
+    for (const string &key : keys) {
+        const vector<string> &files = filesByKey[key];
+        for (size_t begin = 0; begin < files.size(); begin += batchSize) {
+            const size_t end = std::min<size_t>(begin + batchSize, files.size());
+            if (end - begin == 1) {
+                unbatched.push_back(files[begin]);
+                continue;
+            }
+
+            string path = files[begin] + ".clazy-unity.cpp";
+            m_batches[path].assign(files.cbegin() + begin, files.cbegin() + end);
+            m_paths.push_back(std::move(path));
+        }
+    }
+
+    m_paths.insert(m_paths.end(), unbatched.cbegin(), unbatched.cend());
+}
+
+const vector<string> *UnityTranslationUnits::filesFor(llvm::StringRef filename) const
+{
+    auto it = m_batches.find(filename.str());
+    return it == m_batches.end() ? nullptr : &it->second;
+}
+
+string UnityTranslationUnits::contentsFor(llvm::StringRef filename) const
+{
+    string contents;
+    const vector<string> *files = filesFor(filename);
+    if (!files)
+        return contents;
+
+    const vector<CompileCommand> commands = m_compilations.getCompileCommands(files->front());
+    const string directory = commands.empty() ? string() : commands.front().Directory;
+    for (const string &file : *files) {
+        llvm::SmallString<256> path(file);
+        llvm::sys::fs::make_absolute(directory, path);
+        contents += "#include \"" + path.str().str() + "\"\n";
+    }
+
+    return contents;
+}
+
+vector<CompileCommand> UnityTranslationUnits::getCompileCommands(llvm::StringRef filename) const
+{
+    const vector<string> *files = filesFor(filename);
+    if (!files)
+        return m_compilations.getCompileCommands(filename);
+
+    vector<CompileCommand> commands = m_compilations.getCompileCommands(files->front());
+    for (CompileCommand &command : commands)
+        HeaderTranslationUnits::replaceInputFile(command, files->front(), filename.str());
+
+    return commands;
+}
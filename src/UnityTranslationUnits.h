@@ -0,0 +1,73 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_UNITY_TRANSLATION_UNITS_H
+#define CLAZY_UNITY_TRANSLATION_UNITS_H
+
+#include <clang/Tooling/CompilationDatabase.h>
+#include <llvm/ADT/StringRef.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * The synthetic translation units of clazy-standalone -unity-batch-size, which include several source files
+ * having the same compile command, so the headers they share are parsed once per batch instead of once per file.
+ *
+ * A batch borrows the compile command of its first file. Files which can't be batched, because no other file
+ * has the same compile command or they have several, are kept as they are.
+ */
+class UnityTranslationUnits
+    : public clang::tooling::CompilationDatabase
+{
+public:
+    UnityTranslationUnits(const clang::tooling::CompilationDatabase &compilations,
+                          const std::vector<std::string> &sources, unsigned int batchSize);
+
+    /**
+     * Returns the source files included by the synthetic translation unit filename, or nullptr if it isn't one.
+     */
+    const std::vector<std::string> *filesFor(llvm::StringRef filename) const;
+
+    /**
+     * Returns the contents of the synthetic translation unit filename, which doesn't exist on disk.
+     */
+    std::string contentsFor(llvm::StringRef filename) const;
+
+    /**
+     * Returns everything in the compile command but the input file itself and the files written, which are named after it.
+     * Commands with the same key compile their files the same way.
+     */
+    static std::string commandKey(clang::tooling::CompileCommand command, llvm::StringRef file);
+
+    // The synthetic translation units, followed by the files that weren't batched
+    std::vector<std::string> getAllFiles() const override { return m_paths; }
+    std::vector<clang::tooling::CompileCommand> getCompileCommands(llvm::StringRef filename) const override;
+
+private:
+    const clang::tooling::CompilationDatabase &m_compilations;
+    std::unordered_map<std::string, std::vector<std::string>> m_batches; // Files by path
+    std::vector<std::string> m_paths;
+};
+
+#endif
@@ -23,11 +23,14 @@
 */
 
 #include "Utils.h"
+#include "ClazyContext.h"
 #include "StringUtils.h"
 #include "HierarchyUtils.h"
 #include "StmtBodyRange.h"
+#include "StmtIndex.h"
 #include "clazy_stl.h"
 
+#include <clang/AST/Attr.h>
 #include <clang/AST/Expr.h>
 #include <clang/AST/DeclCXX.h>
 #include <clang/AST/DeclTemplate.h>
@@ -37,6 +40,7 @@
 #include <clang/AST/Decl.h>
 #include <clang/AST/DeclBase.h>
 #include <clang/AST/DeclGroup.h>
+#include <clang/AST/LambdaCapture.h>
 #include <clang/AST/OperationKinds.h>
 #include <clang/AST/Stmt.h>
 #include <clang/AST/StmtIterator.h>
@@ -49,6 +53,8 @@
 #include <llvm/Support/Casting.h>
 
 #include <cctype>
+#include <cstdint>
+#include <cstring>
 #include <iterator>
 #include <utility>
 
@@ -311,6 +317,24 @@ bool Utils::containsNonConstMemberCall(clang::ParentMap *map, Stmt *body, const
     return false;
 }
 
+// Returns true if the param-th parameter of fDecl is a reference or pointer to non-const
+static bool takesNonConstRefOrPtr(const FunctionDecl *fDecl, unsigned int param)
+{
+    if (!fDecl || param >= fDecl->param_size())
+        return false;
+
+    const ParmVarDecl *paramDecl = fDecl->getParamDecl(param);
+    if (!paramDecl)
+        return false;
+
+    QualType qt = paramDecl->getType();
+    const Type *t = qt.getTypePtrOrNull();
+    if (!t)
+        return false;
+
+    return (t->isReferenceType() || t->isPointerType()) && !t->getPointeeType().isConstQualified();
+}
+
 template<class T>
 static bool isArgOfFunc(T expr, FunctionDecl *fDecl, const VarDecl *varDecl, bool byRefOrPtrOnly)
 {
@@ -338,31 +362,45 @@ static bool isArgOfFunc(T expr, FunctionDecl *fDecl, const VarDecl *varDecl, boo
         }
 
         // It is, lets see if the callee takes our variable by const-ref
-        if (param >= fDecl->param_size())
-            continue;
-
-        ParmVarDecl *paramDecl = fDecl->getParamDecl(param);
-        if (!paramDecl)
-            continue;
-
-        QualType qt = paramDecl->getType();
-        const Type *t = qt.getTypePtrOrNull();
-        if (!t)
-            continue;
-
-        if ((t->isReferenceType() || t->isPointerType()) && !t->getPointeeType().isConstQualified())
+        if (takesNonConstRefOrPtr(fDecl, param))
             return true; // function receives non-const ref, so our foreach variable cant be const-ref
     }
 
     return false;
 }
 
+// Returns true if index has body and, below it, a use of decl of the given kind
+static bool hasIndexedUse(const StmtIndex *index, Stmt *body, const ValueDecl *decl, StmtIndex::DeclUseKind kind)
+{
+    return clazy::any_of(index->usesOf(decl, body), [kind](const StmtIndex::DeclUse &use) {
+        return use.kind == kind;
+    });
+}
+
 bool Utils::isPassedToFunction(const StmtBodyRange &bodyRange, const VarDecl *varDecl, bool byRefOrPtrOnly)
 {
     if (!bodyRange.isValid())
         return false;
 
     Stmt *body = bodyRange.body;
+    if (bodyRange.index && bodyRange.index->contains(body)) {
+        for (const StmtIndex::DeclUse &use : bodyRange.index->usesOf(varDecl, body)) {
+            if (use.kind != StmtIndex::DeclUse_PassedToFunction || bodyRange.isOutsideRange(use.stmt))
+                continue;
+
+            if (!byRefOrPtrOnly)
+                return true;
+
+            auto callExpr = dyn_cast<CallExpr>(use.stmt);
+            const FunctionDecl *fDecl = callExpr ? callExpr->getDirectCallee()
+                                                 : cast<CXXConstructExpr>(use.stmt)->getConstructor();
+            if (takesNonConstRefOrPtr(fDecl, use.argIndex))
+                return true;
+        }
+
+        return false;
+    }
+
     std::vector<CallExpr*> callExprs;
     clazy::getChilds<CallExpr>(body, callExprs);
     for (CallExpr *callexpr : callExprs) {
@@ -390,11 +428,17 @@ bool Utils::isPassedToFunction(const StmtBodyRange &bodyRange, const VarDecl *va
     return false;
 }
 
-bool Utils::addressIsTaken(const clang::CompilerInstance &ci, Stmt *body, const clang::ValueDecl *valDecl)
+bool Utils::addressIsTaken(Stmt *body, const clang::ValueDecl *valDecl, const StmtIndex *index)
 {
     if (!body || !valDecl)
         return false;
 
+    if (index && index->contains(body)) {
+        return clazy::any_of(index->usesOf(valDecl, body, /*includeSelf=*/ false), [](const StmtIndex::DeclUse &use) {
+            return use.kind == StmtIndex::DeclUse_AddressTaken;
+        });
+    }
+
     auto unaries = clazy::getStatements<UnaryOperator>(body);
     return clazy::any_of(unaries, [valDecl](UnaryOperator *op) {
         if (op->getOpcode() != clang::UO_AddrOf)
@@ -405,11 +449,44 @@ bool Utils::addressIsTaken(const clang::CompilerInstance &ci, Stmt *body, const
     });
 }
 
-bool Utils::isReturned(Stmt *body, const VarDecl *varDecl)
+bool Utils::isCapturedByReference(Stmt *body, const VarDecl *varDecl, const StmtIndex *index)
+{
+    if (!body || !varDecl)
+        return false;
+
+    return clazy::any_of(clazy::getStatements<LambdaExpr>(index, body), [varDecl](LambdaExpr *lambda) {
+        return clazy::any_of(lambda->captures(), [varDecl](const LambdaCapture &capture) {
+            return capture.capturesVariable() && capture.getCapturedVar() == varDecl
+                   && capture.getCaptureKind() == LCK_ByRef;
+        });
+    });
+}
+
+bool Utils::isBoundToReference(Stmt *body, const VarDecl *varDecl, const StmtIndex *index)
+{
+    if (!body || !varDecl)
+        return false;
+
+    return clazy::any_of(clazy::getStatements<DeclStmt>(index, body), [varDecl](DeclStmt *declStmt) {
+        return clazy::any_of(declStmt->decls(), [varDecl](Decl *decl) {
+            auto refDecl = dyn_cast<VarDecl>(decl);
+            if (!refDecl || !refDecl->getType()->isReferenceType() || !refDecl->getInit())
+                return false;
+
+            auto declRef = dyn_cast<DeclRefExpr>(refDecl->getInit()->IgnoreParenImpCasts());
+            return declRef && declRef->getDecl() == varDecl;
+        });
+    });
+}
+
+bool Utils::isReturned(Stmt *body, const VarDecl *varDecl, const StmtIndex *index)
 {
     if (!body)
         return false;
 
+    if (index && index->contains(body))
+        return hasIndexedUse(index, body, varDecl, StmtIndex::DeclUse_Returned);
+
     std::vector<ReturnStmt*> returns;
     clazy::getChilds<ReturnStmt>(body, returns);
     for (ReturnStmt *returnStmt : returns) {
@@ -426,11 +503,14 @@ bool Utils::isReturned(Stmt *body, const VarDecl *varDecl)
     return false;
 }
 
-bool Utils::isAssignedTo(Stmt *body, const VarDecl *varDecl)
+bool Utils::isAssignedTo(Stmt *body, const VarDecl *varDecl, const StmtIndex *index)
 {
     if (!body)
         return false;
 
+    if (index && index->contains(body))
+        return hasIndexedUse(index, body, varDecl, StmtIndex::DeclUse_AssignedTo);
+
     std::vector<BinaryOperator*> operatorCalls;
     clazy::getChilds<BinaryOperator>(body, operatorCalls);
     for (BinaryOperator *binaryOperator : operatorCalls) {
@@ -449,11 +529,14 @@ bool Utils::isAssignedTo(Stmt *body, const VarDecl *varDecl)
     return false;
 }
 
-bool Utils::isAssignedFrom(Stmt *body, const VarDecl *varDecl)
+bool Utils::isAssignedFrom(Stmt *body, const VarDecl *varDecl, const StmtIndex *index)
 {
     if (!body)
         return false;
 
+    if (index && index->contains(body))
+        return hasIndexedUse(index, body, varDecl, StmtIndex::DeclUse_AssignedFrom);
+
     std::vector<CXXOperatorCallExpr*> operatorCalls;
     clazy::getChilds<CXXOperatorCallExpr>(body, operatorCalls);
     for (CXXOperatorCallExpr *operatorExpr : operatorCalls) {
@@ -667,10 +750,123 @@ const CXXRecordDecl *Utils::recordForMemberCall(CXXMemberCallExpr *call, string
     return nullptr;
 }
 
+// Literals are scanned 8 bytes at a time, bytes are only looked at individually in words which matched
+static const uint64_t s_lowBits = 0x0101010101010101ULL;
+static const uint64_t s_highBits = 0x8080808080808080ULL;
+
+static inline uint64_t loadWord(const char *data)
+{
+    uint64_t word;
+    memcpy(&word, data, sizeof(word));
+    return word;
+}
+
+static inline bool hasZeroByte(uint64_t word)
+{
+    return ((word - s_lowBits) & ~word & s_highBits) != 0;
+}
+
+// Returns LiteralFlag_ContainsNull and/or LiteralFlag_Ascii
+static unsigned int scanLiteralBytes(StringRef bytes)
+{
+    bool nonAscii = false;
+    bool containsNull = false;
+    const char *data = bytes.data();
+    const size_t size = bytes.size();
+    size_t i = 0;
+
+    for (; i + sizeof(uint64_t) <= size && !(nonAscii && containsNull); i += sizeof(uint64_t)) {
+        const uint64_t word = loadWord(data + i);
+        if ((word & s_highBits) == 0 && !hasZeroByte(word))
+            continue;
+
+        for (size_t j = i; j < i + sizeof(uint64_t); ++j) {
+            nonAscii |= (data[j] & 0x80) != 0;
+            containsNull |= data[j] == 0;
+        }
+    }
+
+    for (; i < size; ++i) {
+        nonAscii |= (data[i] & 0x80) != 0;
+        containsNull |= data[i] == 0;
+    }
+
+    return (nonAscii || containsNull ? Utils::LiteralFlag_None : Utils::LiteralFlag_Ascii)
+           | (containsNull ? Utils::LiteralFlag_ContainsNull : Utils::LiteralFlag_None);
+}
+
+static inline bool isByteEscape(char c)
+{
+    return c == 'U' || c == 'u' || c == 'x' || std::isdigit(static_cast<unsigned char>(c));
+}
+
+static bool sourceContainsEscapedBytes(StringRef str)
+{
+    static const uint64_t backslashes = s_lowBits * '\\';
+    const char *data = str.data();
+    const size_t size = str.size();
+    size_t i = 0;
+
+    // Only i + 1 < size matters, a trailing backslash escapes nothing
+    for (; i + sizeof(uint64_t) < size; i += sizeof(uint64_t)) {
+        if (!hasZeroByte(loadWord(data + i) ^ backslashes))
+            continue;
+
+        for (size_t j = i; j < i + sizeof(uint64_t); ++j) {
+            if (data[j] == '\\' && isByteEscape(data[j + 1]))
+                return true;
+        }
+    }
+
+    for (; i + 1 < size; ++i) {
+        if (data[i] == '\\' && isByteEscape(data[i + 1]))
+            return true;
+    }
+
+    return false;
+}
+
+static StringRef literalSourceText(StringLiteral *lt, const SourceManager &sm, const LangOptions &lo)
+{
+    // The AST doesn't have the info, we need to ask the Lexer
+    SourceRange sr = lt->getSourceRange();
+    CharSourceRange cr = Lexer::getAsCharRange(sr, sm, lo);
+    return Lexer::getSourceText(cr, sm, lo);
+}
+
 bool Utils::isAscii(StringLiteral *lt)
 {
-    // 'é' for some reason has isAscii() == true, so also call containsNonAsciiOrNull
-    return lt && lt->isAscii() && !lt->containsNonAsciiOrNull();
+    // 'é' for some reason has isAscii() == true, so also check the bytes
+    return lt && lt->isAscii() && (scanLiteralBytes(lt->getBytes()) & LiteralFlag_Ascii);
+}
+
+unsigned int Utils::classifyLiteral(const ClazyContext *context, StringLiteral *lt)
+{
+    if (!lt)
+        return LiteralFlag_None;
+
+    auto it = context->literalClassifications.find(lt);
+    if (it != context->literalClassifications.end())
+        return it->second;
+
+    unsigned int flags = LiteralFlag_None;
+    if (lt->isAscii())
+        flags |= scanLiteralBytes(lt->getBytes());
+    if (sourceContainsEscapedBytes(literalSourceText(lt, context->sm, context->pp.getLangOpts())))
+        flags |= LiteralFlag_ContainsEscapedBytes;
+
+    context->literalClassifications[lt] = flags;
+    return flags;
+}
+
+bool Utils::isAscii(const ClazyContext *context, StringLiteral *lt)
+{
+    return classifyLiteral(context, lt) & LiteralFlag_Ascii;
+}
+
+bool Utils::literalContainsEscapedBytes(const ClazyContext *context, StringLiteral *lt)
+{
+    return classifyLiteral(context, lt) & LiteralFlag_ContainsEscapedBytes;
 }
 
 bool Utils::isInDerefExpression(Stmt *s, ParentMap *map)
@@ -917,6 +1113,28 @@ bool Utils::ctorInitializerContainsMove(const vector<CXXCtorInitializer*> &ctorI
     });
 }
 
+bool Utils::isMovedFrom(Stmt *body, const VarDecl *varDecl)
+{
+    if (!body || !varDecl)
+        return false;
+
+    vector<CallExpr*> calls;
+    clazy::getChilds(body, calls);
+
+    return clazy::any_of(calls, [varDecl](CallExpr *call) {
+        FunctionDecl *funcDecl = call->getDirectCallee();
+        if (!funcDecl || call->getNumArgs() != 1)
+            return false;
+
+        auto name = funcDecl->getQualifiedNameAsString();
+        if (name != "std::move" && name != "std::__1::move")
+            return false;
+
+        auto declRef = dyn_cast<DeclRefExpr>(call->getArg(0)->IgnoreParenImpCasts());
+        return declRef && declRef->getDecl() == varDecl;
+    });
+}
+
 string Utils::filenameForLoc(SourceLocation loc, const clang::SourceManager &sm)
 {
     if (loc.isMacroID())
@@ -971,21 +1189,44 @@ SourceLocation Utils::locForNextToken(SourceLocation loc, const clang::SourceMan
 
 bool Utils::literalContainsEscapedBytes(StringLiteral *lt, const SourceManager &sm, const LangOptions &lo)
 {
-    if (!lt)
-        return false;
+    return lt && sourceContainsEscapedBytes(literalSourceText(lt, sm, lo));
+}
 
-    // The AST doesn't have the info, we need to ask the Lexer
-    SourceRange sr = lt->getSourceRange();
-    CharSourceRange cr = Lexer::getAsCharRange(sr, sm, lo);
-    const StringRef str = Lexer::getSourceText(cr, sm, lo);
+const CXXRecordDecl *Utils::virtualCallClass(const CXXMemberCallExpr *call, const FunctionDecl *caller,
+                                             const CXXMethodDecl *&callee)
+{
+    const CXXMethodDecl *method = call->getMethodDecl();
+    auto memberExpr = dyn_cast<MemberExpr>(call->getCallee()->IgnoreParens());
+    const Expr *object = call->getImplicitObjectArgument();
+    if (!method || !method->isVirtual() || method->hasAttr<FinalAttr>() || !memberExpr || memberExpr->hasQualifier()
+        || !object || call->isTypeDependent())
+        return nullptr;
 
-    for (int i = 0, size = str.size(); i < size - 1; ++i) {
-        if (str[i] == '\\') {
-            auto next = str[i+1];
-            if (next == 'U' || next == 'u' || next == 'x' || std::isdigit(next))
-                return true;
-        }
+    // The dynamic type of local variables, value members and temporaries is known, they're already called directly.
+    // So is the one of this during construction and destruction.
+    object = object->IgnoreParenImpCasts();
+    if (isa<CXXThisExpr>(object) && (dyn_cast_or_null<CXXConstructorDecl>(caller) || dyn_cast_or_null<CXXDestructorDecl>(caller)))
+        return nullptr;
+
+    if (!memberExpr->isArrow()) {
+        if (!object->isGLValue())
+            return nullptr;
+
+        auto declRef = dyn_cast<DeclRefExpr>(object);
+        auto member = dyn_cast<MemberExpr>(object);
+        const ValueDecl *decl = declRef ? declRef->getDecl() : (member ? member->getMemberDecl() : nullptr);
+        if (decl && !decl->getType()->isReferenceType())
+            return nullptr;
     }
 
-    return false;
+    const QualType type = memberExpr->isArrow() ? object->getType()->getPointeeType() : object->getType();
+    const CXXRecordDecl *record = type.isNull() ? nullptr : type->getAsCXXRecordDecl();
+    record = record ? record->getDefinition() : nullptr;
+    if (!record || record->hasAttr<FinalAttr>() || record->isAbstract())
+        return nullptr;
+
+    // A final override between the callee's class and the static class
+    const CXXMethodDecl *overrider = method->getCorrespondingMethodInClass(record);
+    callee = overrider ? overrider : method;
+    return callee->hasAttr<FinalAttr>() || callee->isPure() ? nullptr : record;
 }
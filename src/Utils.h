@@ -44,6 +44,8 @@
 
 // TODO: this is a dumping ground, most of these functions should be moved to the other *Utils classes
 
+class ClazyContext;
+
 namespace clang {
 class CXXNamedCastExpr;
 class CXXRecordDecl;
@@ -74,6 +76,7 @@ class VarDecl;
 }
 
 struct StmtBodyRange;
+class StmtIndex;
 
 namespace Utils {
 /// Returns true if the class has at least one constexpr ctor
@@ -120,16 +123,18 @@ clang::CXXRecordDecl* isMemberVariable(clang::ValueDecl *);
 // while (bar) { foo.setValue(); // non-const call }
 bool containsNonConstMemberCall(clang::ParentMap *map, clang::Stmt *body, const clang::VarDecl *varDecl);
 
+// The helpers below answer from index's def-use lists when it has body, instead of walking body.
+
 // Returns true if there's an assignment to varDecl in body
 // Example: our_var = something_else
-bool isAssignedFrom(clang::Stmt *body, const clang::VarDecl *varDecl);
+bool isAssignedFrom(clang::Stmt *body, const clang::VarDecl *varDecl, const StmtIndex *index = nullptr);
 
 // Returns true if varDecl is assigned to something
 // Example: something_else = our_var
-bool isAssignedTo(clang::Stmt *body, const clang::VarDecl *varDecl);
+bool isAssignedTo(clang::Stmt *body, const clang::VarDecl *varDecl, const StmtIndex *index = nullptr);
 
 // Returns whether the variable is returned in body
-bool isReturned(clang::Stmt *body, const clang::VarDecl *varDecl);
+bool isReturned(clang::Stmt *body, const clang::VarDecl *varDecl, const StmtIndex *index = nullptr);
 
 // Returns true if a body of statements contains a function call that takes our variable (varDecl)
 // By ref or pointer
@@ -137,8 +142,13 @@ bool isPassedToFunction(const StmtBodyRange &bodyRange, const clang::VarDecl *va
                         bool byRefOrPtrOnly);
 
 // Returns true if we take the address of varDecl, such as: &foo
-bool addressIsTaken(const clang::CompilerInstance &ci, clang::Stmt *body,
-                    const clang::ValueDecl *valDecl);
+bool addressIsTaken(clang::Stmt *body, const clang::ValueDecl *valDecl, const StmtIndex *index = nullptr);
+
+// Returns true if a lambda in body captures varDecl by reference, explicitly or with [&]
+bool isCapturedByReference(clang::Stmt *body, const clang::VarDecl *varDecl, const StmtIndex *index = nullptr);
+
+// Returns true if a reference variable is bound to varDecl, such as: auto &ref = foo;
+bool isBoundToReference(clang::Stmt *body, const clang::VarDecl *varDecl, const StmtIndex *index = nullptr);
 
 // QString::fromLatin1("foo")    -> true
 // QString::fromLatin1("foo", 1) -> false
@@ -180,6 +190,23 @@ const clang::CXXRecordDecl* recordForMemberCall(clang::CXXMemberCallExpr *call,
 
 bool isAscii(clang::StringLiteral *lt);
 
+enum LiteralFlag {
+    LiteralFlag_None = 0,
+    LiteralFlag_Ascii = 1, // Same as isAscii()
+    LiteralFlag_ContainsNull = 2, // Only computed for narrow literals
+    LiteralFlag_ContainsEscapedBytes = 4 // Same as literalContainsEscapedBytes()
+};
+
+/**
+ * Returns the LiteralFlag bits of lt, computed with a single scan of its bytes and of its source text.
+ * The result is cached per literal, so checks visiting the same literal don't re-lex it.
+ */
+unsigned int classifyLiteral(const ClazyContext *context, clang::StringLiteral *lt);
+
+// isAscii() and literalContainsEscapedBytes(), through the classifyLiteral() cache
+bool isAscii(const ClazyContext *context, clang::StringLiteral *lt);
+bool literalContainsEscapedBytes(const ClazyContext *context, clang::StringLiteral *lt);
+
 // Checks if Statement s inside an operator* call
 bool isInDerefExpression(clang::Stmt *s, clang::ParentMap *map);
 
@@ -279,6 +306,13 @@ bool ctorInitializerContainsMove(clang::CXXCtorInitializer*);
 // Overload that recieves a vector and returns true if any ctor initializer contains a move()
 bool ctorInitializerContainsMove(const std::vector<clang::CXXCtorInitializer*> &);
 
+/**
+ * Returns true if body passes varDecl to std::move()
+ * Example
+ * void setFoo(Foo a) { m_foo = std::move(a); } // Would return true for the function body and a
+ */
+bool isMovedFrom(clang::Stmt *body, const clang::VarDecl *varDecl);
+
 /**
  * Returns the filename for the source location loc
  */
@@ -315,6 +349,16 @@ inline bool methodOverrides(clang::CXXMethodDecl *method)
 {
     return method && method->isVirtual() && method->size_overridden_methods() > 0;
 }
+
+/**
+ * Returns the static class of the object if call is dispatched through the vtable, and marking that class or the
+ * method final would let the compiler call it directly. Sets callee to the method as seen from the static class,
+ * which can be declared in one of its bases.
+ * Returns nullptr for qualified calls, calls on objects accessed by value, calls on this in caller if it's a constructor
+ * or destructor, abstract classes, pure methods and when something is already final.
+ */
+const clang::CXXRecordDecl *virtualCallClass(const clang::CXXMemberCallExpr *call, const clang::FunctionDecl *caller,
+                                             const clang::CXXMethodDecl *&callee);
 }
 
 #endif
@@ -0,0 +1,86 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "WarningDeduplicator.h"
+
+#include <clang/Basic/SourceManager.h>
+
+#include <utility>
+
+using namespace clang;
+
+// Groups of checks warning about the same code, the preferred check first. The more specific warning is preferred.
+static const char *const s_overlappingChecks[][3] = {
+    { "qlatin1string-non-ascii", "qstring-allocations", nullptr },
+    { "algorithm-callable-by-value", "function-args-by-ref", "function-args-by-value" },
+    { "detaching-temporary", "detaching-member", nullptr },
+    { "constexpr-lookup-table", "non-pod-global-static", nullptr }
+};
+
+WarningDeduplicator::WarningDeduplicator(const SourceManager &sm)
+    : m_sm(sm)
+{
+}
+
+WarningDeduplicator::Rank WarningDeduplicator::rankOf(llvm::StringRef checkName)
+{
+    Rank rank;
+    const int numGroups = sizeof(s_overlappingChecks) / sizeof(s_overlappingChecks[0]);
+    for (int group = 0; group < numGroups; ++group) {
+        for (int priority = 0; priority < 3 && s_overlappingChecks[group][priority]; ++priority) {
+            if (checkName == s_overlappingChecks[group][priority]) {
+                rank.group = group;
+                rank.priority = priority;
+                return rank;
+            }
+        }
+    }
+
+    return rank;
+}
+
+uint64_t WarningDeduplicator::key(Rank rank, SourceLocation loc) const
+{
+    // The checks of a group don't necessarily warn at the same token of an expression, so compare lines
+    unsigned int line = 0;
+    FileID fid;
+    if (loc.isValid()) {
+        const std::pair<FileID, unsigned> decomposed = m_sm.getDecomposedExpansionLoc(loc);
+        fid = decomposed.first;
+        line = m_sm.getLineNumber(decomposed.first, decomposed.second);
+    }
+
+    return (uint64_t(fid.getHashValue()) << 32) ^ (uint64_t(line) << 4) ^ uint64_t(rank.group);
+}
+
+void WarningDeduplicator::record(Rank rank, SourceLocation loc)
+{
+    auto it = m_bestPriorities.insert({ key(rank, loc), rank.priority }).first;
+    if (rank.priority < it->second)
+        it->second = rank.priority;
+}
+
+bool WarningDeduplicator::isShadowed(Rank rank, SourceLocation loc) const
+{
+    auto it = m_bestPriorities.find(key(rank, loc));
+    return it != m_bestPriorities.end() && it->second < rank.priority;
+}
@@ -0,0 +1,78 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_WARNING_DEDUPLICATOR_H
+#define CLAZY_WARNING_DEDUPLICATOR_H
+
+#include <clang/Basic/SourceLocation.h>
+#include <llvm/ADT/StringRef.h>
+
+#include <cstdint>
+#include <unordered_map>
+
+namespace clang {
+class SourceManager;
+}
+
+/**
+ * For the deduplicate-warnings option: some checks warn about the same code, like qlatin1string-non-ascii and
+ * qstring-allocations. Within such a group of overlapping checks, only the warnings of the preferred check are
+ * kept for a line, see CheckBase::isShadowedWarning().
+ *
+ * The checks of a group defer their warnings until the end of the translation unit, when it's known which ones
+ * win. Only used by the main thread.
+ */
+class WarningDeduplicator
+{
+public:
+    // The group of a check and its priority within it, lower is preferred
+    struct Rank
+    {
+        int group = -1;
+        int priority = 0;
+        bool isValid() const { return group >= 0; }
+    };
+
+    explicit WarningDeduplicator(const clang::SourceManager &sm);
+
+    /**
+     * Returns checkName's rank, invalid if it doesn't overlap with any other check.
+     */
+    static Rank rankOf(llvm::StringRef checkName);
+
+    /**
+     * Remembers that a check of rank warned at loc.
+     */
+    void record(Rank rank, clang::SourceLocation loc);
+
+    /**
+     * Returns true if a preferred check of rank's group warned on the same line as loc, so far.
+     */
+    bool isShadowed(Rank rank, clang::SourceLocation loc) const;
+
+private:
+    uint64_t key(Rank rank, clang::SourceLocation loc) const;
+    const clang::SourceManager &m_sm;
+    std::unordered_map<uint64_t, int> m_bestPriorities; // By key()
+};
+
+#endif
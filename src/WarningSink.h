@@ -0,0 +1,43 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#ifndef CLAZY_WARNING_SINK_H
+#define CLAZY_WARNING_SINK_H
+
+#include <clang/Basic/Diagnostic.h>
+#include <clang/Basic/SourceLocation.h>
+#include <llvm/ADT/StringRef.h>
+
+#include <vector>
+
+/**
+ * Receives the warnings instead of the DiagnosticsEngine, for hosts that report them their own way, like
+ * the clang-tidy module. The message doesn't include the check's tag, the exporters still get the warnings.
+ */
+class WarningSink
+{
+public:
+    virtual ~WarningSink() = default;
+    virtual void warn(llvm::StringRef checkName, clang::SourceLocation loc, llvm::StringRef message,
+                      const std::vector<clang::FixItHint> &fixits) = 0;
+};
+
+#endif
@@ -0,0 +1,178 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "WasteReport.h"
+#include "StringUtils.h"
+
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+static unique_ptr<WasteReport> s_report; // Set by enable()
+
+// Loops nested deeper than this aren't assumed to run more often, or a single finding would dwarf all others
+static const unsigned int s_maxLoopDepth = 4;
+
+double WasteFinding::waste() const
+{
+    const double cost = estimate.allocations * 256.0 + estimate.bytesCopied;
+    const double runs = std::pow(10.0, std::min(estimate.loopDepth, s_maxLoopDepth));
+    return cost * runs * (hasHotness ? hotness : 1);
+}
+
+WasteReport *WasteReport::instance()
+{
+    return s_report.get();
+}
+
+void WasteReport::enable()
+{
+    if (!s_report)
+        s_report.reset(new WasteReport());
+}
+
+void WasteReport::addTo(Totals &totals, const WasteFinding &finding)
+{
+    totals.findings++;
+    totals.allocations += finding.estimate.allocations;
+    totals.bytesCopied += finding.estimate.bytesCopied;
+    totals.maxLoopDepth = std::max(totals.maxLoopDepth, finding.estimate.loopDepth);
+    totals.waste += finding.waste();
+    totals.hasHotness = totals.hasHotness || finding.hasHotness;
+    totals.hotness = std::max(totals.hotness, finding.hotness);
+}
+
+void WasteReport::add(const WasteFinding &finding)
+{
+    const string key = finding.check + ':' + finding.file + ':' + to_string(finding.line) + ':' + to_string(finding.column);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_seen.insert(key).second)
+        return;
+
+    addTo(m_checks[finding.check], finding);
+    addTo(m_files[finding.file], finding);
+    if (!finding.function.empty())
+        addTo(m_functions[{ finding.function, finding.file }], finding);
+    m_weightedByHotness = m_weightedByHotness || finding.hasHotness;
+}
+
+static string formatNumber(double value)
+{
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.0f", value);
+    return buffer;
+}
+
+template <typename Key>
+static vector<typename map<Key, WasteReport::Totals>::const_iterator> mostWasteful(const map<Key, WasteReport::Totals> &totals,
+                                                                                   unsigned int topCount)
+{
+    vector<typename map<Key, WasteReport::Totals>::const_iterator> result;
+    result.reserve(totals.size());
+    for (auto it = totals.cbegin(); it != totals.cend(); ++it)
+        result.push_back(it);
+
+    // Stable, so ties keep the sorted order of the map and runs can be diffed
+    std::stable_sort(result.begin(), result.end(), [](const typename map<Key, WasteReport::Totals>::const_iterator &it1,
+                                                      const typename map<Key, WasteReport::Totals>::const_iterator &it2) {
+        return it1->second.waste > it2->second.waste;
+    });
+    result.resize(std::min<size_t>(topCount, result.size()));
+    return result;
+}
+
+static string totalsJson(const WasteReport::Totals &totals)
+{
+    string json = "\"findings\": " + to_string(totals.findings) + ", \"allocations\": " + to_string(totals.allocations)
+                  + ", \"bytes_copied\": " + to_string(totals.bytesCopied) + ", \"max_loop_depth\": " + to_string(totals.maxLoopDepth);
+    if (totals.hasHotness)
+        json += ", \"hotness\": " + to_string(totals.hotness);
+    return json + ", \"waste\": " + formatNumber(totals.waste);
+}
+
+bool WasteReport::writeJson(const string &filename, unsigned int topCount) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    double totalWaste = 0;
+    for (const auto &it : m_files)
+        totalWaste += it.second.waste;
+
+    string json = "{\n";
+    json += "    \"findings\": " + to_string(m_seen.size()) + ",\n";
+    json += "    \"weighted_by_hotness\": " + string(m_weightedByHotness ? "true" : "false") + ",\n";
+    json += "    \"waste\": " + formatNumber(totalWaste) + ",\n";
+
+    json += "    \"checks\": {";
+    bool first = true;
+    for (const auto &it : m_checks) {
+        json += first ? "\n        " : ",\n        ";
+        first = false;
+        clazy::appendJsonString(json, it.first);
+        json += ": { " + totalsJson(it.second) + " }";
+    }
+    json += "\n    },\n";
+
+    json += "    \"files\": [";
+    first = true;
+    for (const auto &it : mostWasteful(m_files, topCount)) {
+        json += first ? "\n        { \"file\": " : ",\n        { \"file\": ";
+        first = false;
+        clazy::appendJsonString(json, it->first);
+        json += ", " + totalsJson(it->second) + " }";
+    }
+    json += "\n    ],\n";
+
+    json += "    \"functions\": [";
+    first = true;
+    for (const auto &it : mostWasteful(m_functions, topCount)) {
+        json += first ? "\n        { \"function\": " : ",\n        { \"function\": ";
+        first = false;
+        clazy::appendJsonString(json, it->first.first);
+        json += ", \"file\": ";
+        clazy::appendJsonString(json, it->first.second);
+        json += ", " + totalsJson(it->second) + " }";
+    }
+    json += "\n    ]\n}\n";
+
+    std::error_code ec;
+    llvm::raw_fd_ostream os(filename, ec, llvm::sys::fs::F_None);
+    if (ec)
+        return false;
+
+    os << json;
+    os.close();
+    if (os.has_error()) {
+        os.clear_error(); // Or its destructor aborts
+        return false;
+    }
+
+    return true;
+}
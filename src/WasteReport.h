@@ -0,0 +1,105 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_WASTE_REPORT_H
+#define CLAZY_WASTE_REPORT_H
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <utility>
+
+// The rough cost of the code a performance warning is about, see CheckBase::setWasteEstimate()
+struct WasteEstimate
+{
+    uint64_t allocations = 0; // Heap allocations each time the code runs
+    uint64_t bytesCopied = 0; // Each time the code runs
+    unsigned int loopDepth = 0; // Loops the code runs in, each assumed to run it 10 times
+};
+
+// A warning of a performance check, for clazy-standalone's -waste-report
+struct WasteFinding
+{
+    std::string check;
+    std::string file;
+    unsigned int line = 0;
+    unsigned int column = 0;
+    std::string function; // Qualified name of the enclosing function, empty outside of one
+    WasteEstimate estimate;
+    bool hasHotness = false; // If the function could be looked up in the CLAZY_HOTNESS_PROFILE
+    uint64_t hotness = 0;
+
+    /**
+     * Returns the estimated waste, in bytes copied. An allocation counts as 256, each loop multiplies it by 10,
+     * and with a hotness profile it's multiplied by the execution count of the function.
+     */
+    double waste() const;
+};
+
+/**
+ * Aggregates the WasteFindings of a whole clazy-standalone run, from the threads of -j, and writes them as a JSON
+ * document ranking files and functions by their estimated waste, so the costliest warnings can be fixed first.
+ * A warning in a header is only counted once, not once per translation unit including it.
+ */
+class WasteReport
+{
+public:
+    /**
+     * Returns the report, or nullptr unless enable() was called, which must happen before the analysis starts.
+     */
+    static WasteReport *instance();
+    static void enable();
+
+    // Of the findings of a check, file or function
+    struct Totals {
+        uint64_t findings = 0;
+        uint64_t allocations = 0;
+        uint64_t bytesCopied = 0;
+        unsigned int maxLoopDepth = 0;
+        double waste = 0;
+        bool hasHotness = false;
+        uint64_t hotness = 0;
+    };
+
+    void add(const WasteFinding &finding);
+
+    /**
+     * Writes the JSON document, with the topCount most wasteful files and functions. Returns false on failure.
+     */
+    bool writeJson(const std::string &filename, unsigned int topCount) const;
+
+private:
+    WasteReport() = default;
+
+    static void addTo(Totals &totals, const WasteFinding &finding);
+
+    mutable std::mutex m_mutex;
+    std::unordered_set<std::string> m_seen; // By check and location, as headers are analyzed by each translation unit
+    std::map<std::string, Totals> m_checks;
+    std::map<std::string, Totals> m_files;
+    std::map<std::pair<std::string, std::string>, Totals> m_functions; // By name and file, as static functions can share a name
+    bool m_weightedByHotness = false;
+};
+
+#endif
@@ -23,12 +23,23 @@
 */
 
 #include "checkbase.h"
+#include "Baseline.h"
 #include "ClazyContext.h"
+#include "FunctionHotness.h"
+#include "HeaderCache.h"
+#include "JsonlExporter.h"
+#include "LoopUtils.h"
+#include "SarifExporter.h"
 #include "SourceCompatibilityHelpers.h"
 #include "SuppressionManager.h"
 #include "Utils.h"
+#include "WarningDeduplicator.h"
+#include "WarningSink.h"
+#include "WasteReport.h"
+#include "checkmanager.h"
 #include "clazy_stl.h"
 
+#include <clang/AST/Decl.h>
 #include <clang/AST/DeclBase.h>
 #include <clang/AST/Stmt.h>
 #include <clang/Basic/Diagnostic.h>
@@ -37,10 +48,13 @@
 #include <clang/Frontend/CompilerInstance.h>
 #include <clang/Lex/MacroInfo.h>
 #include <clang/Lex/Preprocessor.h>
+#include <llvm/ADT/Hashing.h>
 #include <llvm/ADT/IntrusiveRefCntPtr.h>
+#include <llvm/ADT/SmallVector.h>
 #include <llvm/ADT/StringRef.h>
 #include <llvm/Support/raw_ostream.h>
 
+#include <assert.h>
 #include <vector>
 #include <memory>
 
@@ -58,60 +72,82 @@ ClazyPreprocessorCallbacks::ClazyPreprocessorCallbacks(CheckBase *check)
 {
 }
 
+ClazyStat *ClazyPreprocessorCallbacks::stat() const
+{
+    return check->m_context->collectsStats() ? &check->m_stats.preprocessor : nullptr;
+}
+
 void ClazyPreprocessorCallbacks::MacroExpands(const Token &macroNameTok, const MacroDefinition &md,
                                               SourceRange range, const MacroArgs *)
 {
+    ClazyStatTimer timer(stat(), check->m_context->perfCounters);
     check->VisitMacroExpands(macroNameTok, range, md.getMacroInfo());
 }
 
 void ClazyPreprocessorCallbacks::Defined(const Token &macroNameTok, const MacroDefinition &, SourceRange range)
 {
+    ClazyStatTimer timer(stat(), check->m_context->perfCounters);
     check->VisitDefined(macroNameTok, range);
 }
 
 void ClazyPreprocessorCallbacks::Ifdef(SourceLocation loc, const Token &macroNameTok, const MacroDefinition &)
 {
+    ClazyStatTimer timer(stat(), check->m_context->perfCounters);
     check->VisitIfdef(loc, macroNameTok);
 }
 
 void ClazyPreprocessorCallbacks::Ifndef(SourceLocation loc, const Token &macroNameTok, const MacroDefinition &)
 {
+    ClazyStatTimer timer(stat(), check->m_context->perfCounters);
     check->VisitIfndef(loc, macroNameTok);
 }
 
 void ClazyPreprocessorCallbacks::If(SourceLocation loc, SourceRange conditionRange, PPCallbacks::ConditionValueKind conditionValue)
 {
+    ClazyStatTimer timer(stat(), check->m_context->perfCounters);
     check->VisitIf(loc, conditionRange, conditionValue);
 }
 
 void ClazyPreprocessorCallbacks::Elif(SourceLocation loc, SourceRange conditionRange, PPCallbacks::ConditionValueKind conditionValue, SourceLocation ifLoc)
 {
+    ClazyStatTimer timer(stat(), check->m_context->perfCounters);
     check->VisitElif(loc, conditionRange, conditionValue, ifLoc);
 }
 
 void ClazyPreprocessorCallbacks::Else(SourceLocation loc, SourceLocation ifLoc)
 {
+    ClazyStatTimer timer(stat(), check->m_context->perfCounters);
     check->VisitElse(loc, ifLoc);
 }
 
 void ClazyPreprocessorCallbacks::Endif(SourceLocation loc, SourceLocation ifLoc)
 {
+    ClazyStatTimer timer(stat(), check->m_context->perfCounters);
     check->VisitEndif(loc, ifLoc);
 }
 
 void ClazyPreprocessorCallbacks::MacroDefined(const Token &macroNameTok, const MacroDirective *)
 {
+    ClazyStatTimer timer(stat(), check->m_context->perfCounters);
     check->VisitMacroDefined(macroNameTok);
 }
 
 CheckBase::CheckBase(const string &name, const ClazyContext *context, Options options)
-    : m_sm(context->ci.getSourceManager())
+    : m_sm(&context->sm)
     , m_name(name)
     , m_context(context)
-    , m_astContext(context->astContext)
-    , m_preprocessorCallbacks(new ClazyPreprocessorCallbacks(this))
+    , m_astContext(&context->astContext)
+    , m_emittedWarningsInMacro(newPresumedLocSet())
+    , m_emittedManualFixItsWarningsInMacro(newPresumedLocSet())
+    , m_queuedManualInterventionWarnings(arenaAllocator())
     , m_options(options)
     , m_tag(" [-Wclazy-" + m_name + ']')
+    , m_duplicateRank(WarningDeduplicator::rankOf(m_name))
+    , m_isPerformanceCheck(FunctionHotness::instance()
+                           && (CheckManager::instance()->checkOptions(m_name) & RegisteredCheck::Option_Performance))
+    , m_reportsWaste(WasteReport::instance()
+                     && (CheckManager::instance()->checkOptions(m_name) & RegisteredCheck::Option_Performance))
+    , m_isCacheSafe(CheckManager::instance()->checkOptions(m_name) & RegisteredCheck::Option_CacheSafe)
 {
 }
 
@@ -174,10 +210,49 @@ void CheckBase::VisitEndif(SourceLocation, SourceLocation)
     // Overriden in derived classes
 }
 
-void CheckBase::enablePreProcessorCallbacks()
+void CheckBase::enablePreProcessorCallbacks(PreprocessorEvents events, std::initializer_list<llvm::StringRef> macroNames)
+{
+    m_preprocessorEvents = events;
+    m_preprocessorMacroNames.assign(macroNames.begin(), macroNames.end());
+    subscribePreprocessorCallbacks();
+}
+
+void CheckBase::subscribePreprocessorCallbacks()
 {
-    Preprocessor &pi = m_context->ci.getPreprocessor();
-    pi.addPPCallbacks(std::unique_ptr<PPCallbacks>(m_preprocessorCallbacks));
+    llvm::SmallVector<llvm::StringRef, 4> macroNames(m_preprocessorMacroNames.begin(), m_preprocessorMacroNames.end());
+    m_context->preprocessorDispatcher()->subscribe(new ClazyPreprocessorCallbacks(this), m_preprocessorEvents, macroNames);
+}
+
+clazy::ArenaAllocator<char> CheckBase::arenaAllocator()
+{
+    return clazy::ArenaAllocator<char>(m_context->arena, &m_stats.arenaBytes);
+}
+
+void CheckBase::endTranslationUnit()
+{
+    // These live in the ClazyContext's arena, release them while it still exists
+    newPresumedLocSet().swap(m_emittedWarningsInMacro);
+    newPresumedLocSet().swap(m_emittedManualFixItsWarningsInMacro);
+    clazy::ArenaVector<std::pair<SourceLocation, std::string>>(arenaAllocator()).swap(m_queuedManualInterventionWarnings);
+}
+
+void CheckBase::reset(const ClazyContext *context)
+{
+    assert(isReusable());
+    m_sm = &context->sm;
+    m_context = context;
+    m_astContext = &context->astContext;
+
+    m_emittedWarningsInMacro = newPresumedLocSet();
+    m_emittedManualFixItsWarningsInMacro = newPresumedLocSet();
+    m_queuedManualInterventionWarnings = clazy::ArenaVector<std::pair<SourceLocation, std::string>>(arenaAllocator());
+    m_formattedDiagIDs.clear(); // They belong to the previous DiagnosticIDs
+    m_stats = CheckStats();
+    m_disabled = false;
+    m_hasWasteEstimate = false;
+
+    if (m_preprocessorEvents != 0) // The previous Preprocessor owned and deleted the callbacks
+        subscribePreprocessorCallbacks();
 }
 
 bool CheckBase::shouldIgnoreFile(SourceLocation loc) const
@@ -188,10 +263,9 @@ bool CheckBase::shouldIgnoreFile(SourceLocation loc) const
     if (!loc.isValid())
         return true;
 
-    string filename = sm().getFilename(loc);
-
+    const llvm::StringRef filename = m_context->fileInfo(loc).name;
     return clazy::any_of(m_filesToIgnore, [filename](const std::string &ignored) {
-        return clazy::contains(filename, ignored);
+        return filename.find(ignored) != llvm::StringRef::npos;
     });
 }
 
@@ -210,26 +284,267 @@ void CheckBase::emitWarning(clang::SourceLocation loc, const std::string &error,
     emitWarning(loc, error, {}, printWarningTag);
 }
 
+bool CheckBase::shouldEmitWarning(SourceLocation loc)
+{
+    // Cheap and memoized per file, so check it before the suppression comments, which need lexing the file
+    if (m_context->shouldIgnoreFile(loc) || !m_context->passesLineFilter(loc))
+        return false;
+
+    if (m_context->suppressionManager.isSuppressed(m_name, loc, sm(), lo()))
+        return false;
+
+    if (loc.isMacroID() && warningAlreadyEmitted(loc))
+        return false; // For warnings in macro arguments we get a warning in each place the argument is used within the expanded macro, so filter all the dups
+
+    return true;
+}
+
 void CheckBase::emitWarning(clang::SourceLocation loc, std::string error,
                             const vector<FixItHint> &fixits, bool printWarningTag)
 {
-    if (m_context->suppressionManager.isSuppressed(m_name, loc, sm(), lo()))
-        return;
+    // Captured before any filtering, so the estimate doesn't leak into the next warning
+    WasteFinding waste;
+    if (m_reportsWaste)
+        waste = captureWaste(loc);
 
-    if (m_context->shouldIgnoreFile(loc))
+    if (!shouldEmitWarning(loc) || isInBaseline(loc, error) || !passesHotness(loc, error))
         return;
 
-    if (loc.isMacroID()) {
-        if (warningAlreadyEmitted(loc))
-            return; // For warnings in macro arguments we get a warning in each place the argument is used within the expanded macro, so filter all the dups
-        m_emittedWarningsInMacro.push_back(loc.getRawEncoding());
-    }
-
     if (printWarningTag)
         error += m_tag;
 
+    const bool cacheable = m_context->headerCache && isCacheableWarning(loc);
+    if (defersWarnings()) {
+        m_context->deduplicator->record(m_duplicateRank, loc);
+        m_bufferedWarnings.push_back({ loc, std::move(error), nullptr, {}, fixits, std::move(waste), cacheable });
+        emitQueuedManualFixitWarnings();
+        return;
+    }
+
+    if (!passesHeaderCache(loc, error, cacheable))
+        return;
+
+    if (m_context->collectsStats())
+        m_stats.warnings++;
+    if (m_context->maxWarnings > 0)
+        ClazyContext::countEmittedWarning();
+    if (m_reportsWaste)
+        WasteReport::instance()->add(waste);
+
     reallyEmitWarning(loc, error, fixits);
+    emitQueuedManualFixitWarnings();
+}
+
+// Same substitution clang does for string arguments, only needed for the exporters, the header cache and the warning sink
+static string formatMessage(llvm::StringRef format, llvm::ArrayRef<llvm::StringRef> args)
+{
+    string message;
+    message.reserve(format.size());
+    for (size_t i = 0; i < format.size(); ++i) {
+        const char c = format[i];
+        if (c == '%' && i + 1 < format.size()) {
+            const char next = format[i + 1];
+            if (next == '%') {
+                message += '%';
+                ++i;
+                continue;
+            }
+
+            const unsigned int argIndex = next - '0';
+            if (argIndex < args.size()) {
+                message += args[argIndex];
+                ++i;
+                continue;
+            }
+        }
+
+        message += c;
+    }
+
+    return message;
+}
+
+void CheckBase::emitFormattedWarning(SourceLocation loc, const char *format, llvm::ArrayRef<llvm::StringRef> args,
+                                     const vector<FixItHint> &fixits)
+{
+    // The hotness is appended to the message, which then no longer matches the format
+    if (m_isPerformanceCheck && m_context->hotness) {
+        emitWarning(loc, formatMessage(format, args), fixits, /*printWarningTag=*/ true);
+        return;
+    }
+
+    WasteFinding waste;
+    if (m_reportsWaste)
+        waste = captureWaste(loc);
+
+    if (!shouldEmitWarning(loc))
+        return;
+
+    HeaderCache *headerCache = m_context->headerCache;
+    string message;
+    if (headerCache || m_context->jsonlExporter || m_context->sarifExporter || m_context->baseline || m_context->baselineExporter
+        || m_context->warningSink)
+        message = formatMessage(format, args);
+
+    if (isInBaseline(loc, message))
+        return;
+
+    const bool cacheable = headerCache && isCacheableWarning(loc);
+    if (defersWarnings()) {
+        m_context->deduplicator->record(m_duplicateRank, loc);
+        m_bufferedWarnings.push_back({ loc, std::move(message), format, vector<string>(args.begin(), args.end()), fixits,
+                                       std::move(waste), cacheable });
+        emitQueuedManualFixitWarnings();
+        return;
+    }
+
+    if (!passesHeaderCache(loc, message + m_tag, cacheable))
+        return;
+
+    if (m_context->collectsStats())
+        m_stats.warnings++;
+    if (m_context->maxWarnings > 0)
+        ClazyContext::countEmittedWarning();
+    if (m_reportsWaste)
+        WasteReport::instance()->add(waste);
+
+    reallyEmitWarning(loc, formattedDiagID(format), args, message, fixits);
+    emitQueuedManualFixitWarnings();
+}
+
+bool CheckBase::isInBaseline(SourceLocation loc, llvm::StringRef message)
+{
+    const Baseline *baseline = m_context->baseline;
+    BaselineExporter *exporter = m_context->baselineExporter;
+    if (!baseline && !exporter)
+        return false;
+
+    const llvm::StringRef rootDir = baseline ? baseline->rootDir() : exporter->rootDir();
+    const uint64_t fingerprint = Baseline::fingerprint(sm(), loc, m_name, message, rootDir);
+
+    // Known warnings are exported too, so the baseline can be regenerated while it's in use
+    if (exporter) {
+        const bool sameRoot = !baseline || exporter->rootDir() == rootDir;
+        exporter->write(sameRoot ? fingerprint : Baseline::fingerprint(sm(), loc, m_name, message, exporter->rootDir()),
+                        m_name, loc);
+    }
+
+    return baseline && baseline->contains(fingerprint);
+}
+
+bool CheckBase::passesHotness(SourceLocation loc, string &message) const
+{
+    uint64_t count = 0;
+    if (!m_isPerformanceCheck || !m_context->enclosingFunctionHotness(loc, count))
+        return true;
+
+    if (count < m_context->hotness->minHotness())
+        return false;
+
+    message += " (hotness " + to_string(count) + ')';
+    return true;
+}
 
+void CheckBase::setWasteEstimate(uint64_t allocations, uint64_t bytesCopied, unsigned int loopDepth)
+{
+    if (!m_reportsWaste)
+        return;
+
+    m_wasteEstimate.allocations = allocations;
+    m_wasteEstimate.bytesCopied = bytesCopied;
+    m_wasteEstimate.loopDepth = loopDepth;
+    m_hasWasteEstimate = true;
+}
+
+WasteFinding CheckBase::captureWaste(SourceLocation loc)
+{
+    WasteFinding finding;
+    finding.check = m_name;
+    if (m_hasWasteEstimate) {
+        finding.estimate = m_wasteEstimate;
+        m_hasWasteEstimate = false;
+    } else {
+        finding.estimate.allocations = 1;
+        if (Stmt *stmt = m_context->traversalStack.current())
+            finding.estimate.loopDepth = clazy::loopDepth(m_context, stmt);
+    }
+
+    if (loc.isInvalid())
+        return finding;
+
+    finding.file = m_context->fileInfo(loc).name;
+    finding.line = sm().getExpansionLineNumber(loc);
+    finding.column = sm().getExpansionColumnNumber(loc);
+    if (const FunctionDecl *func = m_context->enclosingFunction(loc))
+        finding.function = func->getQualifiedNameAsString();
+    finding.hasHotness = m_context->enclosingFunctionHotness(loc, finding.hotness);
+    return finding;
+}
+
+bool CheckBase::isCacheableWarning(SourceLocation loc) const
+{
+    const SourceLocation nodeLoc = m_context->cacheableNodeLoc;
+    return nodeLoc.isValid() && loc.isValid()
+           && sm().getFileID(sm().getExpansionLoc(nodeLoc)) == sm().getFileID(sm().getExpansionLoc(loc));
+}
+
+bool CheckBase::passesHeaderCache(SourceLocation loc, const string &message, bool cacheable)
+{
+    HeaderCache *headerCache = m_context->headerCache;
+    if (!headerCache || !cacheable)
+        return true;
+
+    if (headerCache->isCached(loc))
+        return false; // Already emitted when the header was loaded from the cache
+
+    headerCache->recordWarning(loc, message);
+    return true;
+}
+
+vector<CheckBase::BufferedWarning> CheckBase::takeBufferedWarnings()
+{
+    vector<BufferedWarning> warnings;
+    warnings.swap(m_bufferedWarnings);
+    return warnings;
+}
+
+bool CheckBase::defersWarnings() const
+{
+    return m_context->deduplicator && m_duplicateRank.isValid();
+}
+
+bool CheckBase::isShadowedWarning(SourceLocation loc) const
+{
+    return defersWarnings() && m_context->deduplicator->isShadowed(m_duplicateRank, loc);
+}
+
+void CheckBase::emitDeferredWarning(const BufferedWarning &warning)
+{
+    // Suppressions and the baseline were already honoured when it was deferred
+    if (isShadowedWarning(warning.loc))
+        return;
+
+    if (!passesHeaderCache(warning.loc, warning.format ? warning.message + m_tag : warning.message, warning.cacheable))
+        return;
+
+    if (m_context->collectsStats())
+        m_stats.warnings++;
+    if (m_context->maxWarnings > 0)
+        ClazyContext::countEmittedWarning();
+    if (m_reportsWaste)
+        WasteReport::instance()->add(warning.waste);
+
+    if (!warning.format) {
+        reallyEmitWarning(warning.loc, warning.message, warning.fixits);
+        return;
+    }
+
+    const vector<llvm::StringRef> args(warning.args.begin(), warning.args.end());
+    reallyEmitWarning(warning.loc, formattedDiagID(warning.format), args, warning.message, warning.fixits);
+}
+
+void CheckBase::emitQueuedManualFixitWarnings()
+{
     for (const auto& l : m_queuedManualInterventionWarnings) {
         string msg = string("FixIt failed, requires manual intervention: ");
         if (!l.second.empty())
@@ -247,52 +562,104 @@ void CheckBase::emitInternalError(SourceLocation loc, string error)
                  << " at " << loc.printToString(sm()) << "\n";
 }
 
+bool CheckBase::warningsAreErrors() const
+{
+    return m_context->pp.getDiagnostics().getWarningsAsErrors() && !m_context->userDisabledWError();
+}
+
+unsigned int CheckBase::formattedDiagID(const char *format)
+{
+    auto it = m_formattedDiagIDs.find(format);
+    if (it != m_formattedDiagIDs.end())
+        return it->second;
+
+    // -Werror can't change during a translation unit, so the severity can be part of the cached ID
+    const auto severity = warningsAreErrors() ? DiagnosticIDs::Error : DiagnosticIDs::Warning;
+    const string formatWithTag = format + m_tag;
+    const unsigned int id = m_context->pp.getDiagnostics().getDiagnosticIDs()->getCustomDiagID(severity, formatWithTag);
+    m_formattedDiagIDs.insert({ format, id });
+    return id;
+}
+
 void CheckBase::reallyEmitWarning(clang::SourceLocation loc, const std::string &error, const vector<FixItHint> &fixits)
 {
-    FullSourceLoc full(loc, sm());
-    auto &engine = m_context->ci.getDiagnostics();
-    auto severity = (engine.getWarningsAsErrors() && !m_context->userDisabledWError()) ? DiagnosticIDs::Error
-                                                                                       : DiagnosticIDs::Warning;
+    auto &engine = m_context->pp.getDiagnostics();
+    auto severity = warningsAreErrors() ? DiagnosticIDs::Error : DiagnosticIDs::Warning;
     unsigned id = engine.getDiagnosticIDs()->getCustomDiagID(severity, error.c_str());
-    DiagnosticBuilder B = engine.Report(full, id);
-    for (const FixItHint& fixit : fixits) {
-        if (!fixit.isNull())
-            B.AddFixItHint(fixit);
+
+    // The check name has its own field in the exports
+    llvm::StringRef message(error);
+    if (message.endswith(m_tag))
+        message = message.drop_back(m_tag.size());
+
+    reallyEmitWarning(loc, id, {}, message, fixits);
+}
+
+void CheckBase::reallyEmitWarning(SourceLocation loc, unsigned int diagID, llvm::ArrayRef<llvm::StringRef> args,
+                                  llvm::StringRef message, const vector<FixItHint> &fixits)
+{
+    if (WarningSink *sink = m_context->warningSink) {
+        sink->warn(m_name, loc, message, fixits);
+    } else {
+        FullSourceLoc full(loc, sm());
+        auto &engine = m_context->pp.getDiagnostics();
+        DiagnosticBuilder B = engine.Report(full, diagID);
+        for (llvm::StringRef arg : args)
+            B << arg;
+
+        for (const FixItHint& fixit : fixits) {
+            if (!fixit.isNull())
+                B.AddFixItHint(fixit);
+        }
     }
+
+    if (m_context->jsonlExporter)
+        m_context->jsonlExporter->write(loc, m_name, message, fixits);
+    if (m_context->sarifExporter)
+        m_context->sarifExporter->write(loc, m_name, message, warningsAreErrors(), fixits);
 }
 
 void CheckBase::queueManualFixitWarning(clang::SourceLocation loc, const string &message)
 {
-    if (fixitsEnabled() && !manualFixitAlreadyQueued(loc)) {
+    if (fixitsEnabled() && !manualFixitAlreadyQueued(loc))
         m_queuedManualInterventionWarnings.push_back({loc, message});
-        m_emittedManualFixItsWarningsInMacro.push_back(loc.getRawEncoding());
-    }
 }
 
-bool CheckBase::warningAlreadyEmitted(SourceLocation loc) const
+size_t CheckBase::PresumedLocHash::operator()(unsigned int rawLoc) const
 {
-    PresumedLoc ploc = sm().getPresumedLoc(loc);
-    for (auto rawLoc : m_emittedWarningsInMacro) {
-        SourceLocation l = SourceLocation::getFromRawEncoding(rawLoc);
-        PresumedLoc p = sm().getPresumedLoc(l);
-        if (Utils::presumedLocationsEqual(p, ploc))
-            return true;
-    }
+    const PresumedLoc ploc = sm->getPresumedLoc(SourceLocation::getFromRawEncoding(rawLoc));
+    return llvm::hash_combine(ploc.getLine(), ploc.getColumn(), llvm::StringRef(ploc.getFilename()));
+}
 
-    return false;
+bool CheckBase::PresumedLocEqual::operator()(unsigned int rawLoc1, unsigned int rawLoc2) const
+{
+    return Utils::presumedLocationsEqual(sm->getPresumedLoc(SourceLocation::getFromRawEncoding(rawLoc1)),
+                                         sm->getPresumedLoc(SourceLocation::getFromRawEncoding(rawLoc2)));
 }
 
-bool CheckBase::manualFixitAlreadyQueued(SourceLocation loc) const
+CheckBase::PresumedLocSet CheckBase::newPresumedLocSet()
 {
-    PresumedLoc ploc = sm().getPresumedLoc(loc);
-    for (auto loc : m_emittedManualFixItsWarningsInMacro) {
-        SourceLocation l = SourceLocation::getFromRawEncoding(loc);
-        PresumedLoc p = sm().getPresumedLoc(l);
-        if (Utils::presumedLocationsEqual(p, ploc))
-            return true;
-    }
+    return PresumedLocSet(0, PresumedLocHash{ m_sm }, PresumedLocEqual{ m_sm }, arenaAllocator());
+}
+
+// Returns false if a location with the same PresumedLoc is already in set
+bool CheckBase::insertPresumedLoc(PresumedLocSet &set, SourceLocation loc) const
+{
+    // Such locations never compared equal to any other
+    if (sm().getPresumedLoc(loc).isInvalid())
+        return true;
 
-    return false;
+    return set.insert(loc.getRawEncoding()).second;
+}
+
+bool CheckBase::warningAlreadyEmitted(SourceLocation loc)
+{
+    return !insertPresumedLoc(m_emittedWarningsInMacro, loc);
+}
+
+bool CheckBase::manualFixitAlreadyQueued(SourceLocation loc)
+{
+    return !insertPresumedLoc(m_emittedManualFixItsWarningsInMacro, loc);
 }
 
 bool CheckBase::isOptionSet(const std::string &optionName) const
@@ -306,3 +673,8 @@ ClazyAstMatcherCallback::ClazyAstMatcherCallback(CheckBase *check)
     , m_check(check)
 {
 }
+
+llvm::StringRef ClazyAstMatcherCallback::getID() const
+{
+    return m_check->m_name;
+}
@@ -25,8 +25,13 @@
 #ifndef CHECK_BASE_H
 #define CHECK_BASE_H
 
+#include "ArenaAllocator.h"
 #include "clazy_stl.h"
+#include "ClazyStats.h"
+#include "PreprocessorDispatcher.h"
 #include "SourceCompatibilityHelpers.h"
+#include "WarningDeduplicator.h"
+#include "WasteReport.h"
 
 #include <clang/Basic/SourceManager.h>
 #include <clang/Frontend/CompilerInstance.h>
@@ -36,9 +41,14 @@
 #include <clang/AST/ASTContext.h>
 #include <clang/Basic/SourceLocation.h>
 #include <clang/Lex/PPCallbacks.h>
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/StringRef.h>
 #include <llvm/Config/llvm-config.h>
 
+#include <initializer_list>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -91,6 +101,7 @@ public:
     void Else(clang::SourceLocation loc, clang::SourceLocation ifLoc) override;
     void Endif(clang::SourceLocation loc, clang::SourceLocation ifLoc) override;
 private:
+    ClazyStat *stat() const;
     CheckBase *const check;
 };
 
@@ -99,6 +110,7 @@ class ClazyAstMatcherCallback
 {
 public:
     explicit ClazyAstMatcherCallback(CheckBase *check);
+    llvm::StringRef getID() const override; // So MatchFinder's profiling reports by check name
 protected:
     CheckBase *const m_check;
 };
@@ -109,7 +121,8 @@ public:
 
     enum Option {
         Option_None = 0,
-        Option_CanIgnoreIncludes = 1
+        Option_CanIgnoreIncludes = 1,
+        Option_Reusable = 2 // See reset()
     };
     typedef int Options;
 
@@ -120,12 +133,23 @@ public:
 
     virtual ~CheckBase();
 
-    std::string name() const { return m_name; }
+    const std::string &name() const { return m_name; }
 
     void emitWarning(const clang::Decl *, const std::string &error, bool printWarningTag = true);
     void emitWarning(const clang::Stmt *, const std::string &error, bool printWarningTag = true);
     void emitWarning(clang::SourceLocation loc, const std::string &error, bool printWarningTag = true);
     void emitWarning(clang::SourceLocation loc, std::string error, const std::vector<clang::FixItHint> &fixits, bool printWarningTag = true);
+
+    /**
+     * Emits a warning whose message is a format with clang's %0 style placeholders, filled with args. For example:
+     *     emitFormattedWarning(loc, "Use %0 instead of %1", { replacement, original });
+     *
+     * Prefer it when the message contains names. The custom diagnostic is registered once per format,
+     * not once per distinct message, and the message is only built if an exporter or the header cache needs it.
+     * format must be a string literal, as it's cached by address.
+     */
+    void emitFormattedWarning(clang::SourceLocation loc, const char *format, llvm::ArrayRef<llvm::StringRef> args,
+                              const std::vector<clang::FixItHint> &fixits = {});
     void emitInternalError(clang::SourceLocation loc, std::string error);
 
     virtual void registerASTMatchers(clang::ast_matchers::MatchFinder &) {};
@@ -135,8 +159,73 @@ public:
         return m_options & Option_CanIgnoreIncludes;
     }
 
+    /**
+     * Returns true if clazy-standalone can rebind this check to the next translation unit with reset(),
+     * instead of creating a new instance.
+     * Checks opt in with Option_Reusable, if their constructor doesn't use the ClazyContext (for example
+     * to enable the AccessSpecifierManager) and they don't have per translation unit state.
+     */
+    bool isReusable() const
+    {
+        return m_options & Option_Reusable;
+    }
+
+    /**
+     * Drops the per translation unit state, must be called before its ClazyContext is destroyed.
+     */
+    void endTranslationUnit();
+
+    /**
+     * Rebinds a reusable check to the translation unit of context. endTranslationUnit() must have been called.
+     */
+    void reset(const ClazyContext *context);
+
     virtual void VisitStmt(clang::Stmt *stm);
     virtual void VisitDecl(clang::Decl *decl);
+
+    // A deferred warning, see emitDeferredWarning()
+    struct BufferedWarning {
+        clang::SourceLocation loc;
+        std::string message; // If format is set, the formatted message of a deferred warning, when needed
+        const char *format;
+        std::vector<std::string> args;
+        std::vector<clang::FixItHint> fixits;
+        WasteFinding waste; // With -waste-report, captured where the warning was emitted, see captureWaste()
+        bool cacheable; // See isCacheableWarning(), decided where the warning was emitted
+    };
+
+    /**
+     * Returns the warnings deferred so far, and clears them.
+     */
+    std::vector<BufferedWarning> takeBufferedWarnings();
+
+    /**
+     * With deduplicate-warnings, the checks overlapping with others keep their warnings in takeBufferedWarnings()
+     * until the end of the translation unit. This emits one of them, unless a preferred check warned on its line.
+     */
+    void emitDeferredWarning(const BufferedWarning &warning);
+
+    /**
+     * Returns true if, with deduplicate-warnings, a check overlapping with this one and preferred over it already warned
+     * on loc's line. Such a warning is dropped, so the check can skip building its fixits.
+     */
+    bool isShadowedWarning(clang::SourceLocation loc) const;
+
+    /**
+     * Returns true if the check used up its CLAZY_CHECK_TIME_BUDGET, it's then no longer visited for the rest of
+     * the translation unit.
+     */
+    bool isDisabled() const { return m_disabled; }
+
+    // Marked cache_safe in checks.json, see RegisteredCheck::Option_CacheSafe
+    bool isCacheSafe() const { return m_isCacheSafe; }
+
+    // True if the check subscribed to preprocessor events, which don't happen when the input is an AST file
+    bool visitsPreprocessor() const { return m_preprocessorEvents != 0; }
+    void disable() { m_disabled = true; }
+
+    CheckStats &stats() { return m_stats; }
+    const CheckStats &stats() const { return m_stats; }
 protected:
     virtual void VisitMacroExpands(const clang::Token &macroNameTok, const clang::SourceRange &, const clang::MacroInfo *minfo = nullptr);
     virtual void VisitMacroDefined(const clang::Token &macroNameTok);
@@ -148,37 +237,100 @@ protected:
     virtual void VisitElse(clang::SourceLocation loc, clang::SourceLocation ifLoc);
     virtual void VisitEndif(clang::SourceLocation loc, clang::SourceLocation ifLoc);
 
-    void enablePreProcessorCallbacks();
+    /**
+     * Subscribes this check's Visit* preprocessor methods to the events in events.
+     * If macroNames isn't empty, the macro events are only visited for those macros, which is much cheaper
+     * than filtering them by name inside VisitMacroExpands().
+     */
+    void enablePreProcessorCallbacks(PreprocessorEvents events = PreprocessorEvent_All,
+                                     std::initializer_list<llvm::StringRef> macroNames = {});
 
 
     bool shouldIgnoreFile(clang::SourceLocation) const;
     void reallyEmitWarning(clang::SourceLocation loc, const std::string &error, const std::vector<clang::FixItHint> &fixits);
+    void reallyEmitWarning(clang::SourceLocation loc, unsigned int diagID, llvm::ArrayRef<llvm::StringRef> args,
+                           llvm::StringRef message, const std::vector<clang::FixItHint> &fixits);
+
+    /**
+     * Sets the estimated cost of the code the next warning is about, for clazy-standalone's -waste-report.
+     * Without it, a warning of a performance check counts as one allocation, in the loops running the statement
+     * being visited. loopDepth is usually clazy::loopDepth() of the statement warned about.
+     */
+    void setWasteEstimate(uint64_t allocations, uint64_t bytesCopied, unsigned int loopDepth);
 
     void queueManualFixitWarning(clang::SourceLocation loc, const std::string &message = {});
-    bool warningAlreadyEmitted(clang::SourceLocation loc) const;
-    bool manualFixitAlreadyQueued(clang::SourceLocation loc) const;
+    // These two remember loc, so they return true for any further location expanding to the same place
+    bool warningAlreadyEmitted(clang::SourceLocation loc);
+    bool manualFixitAlreadyQueued(clang::SourceLocation loc);
     bool isOptionSet(const std::string &optionName) const;
 
     bool fixitsEnabled() const { return true; } // Fixits are always shown
 
+    // For containers holding per translation unit state, their allocations are counted in stats().arenaBytes
+    clazy::ArenaAllocator<char> arenaAllocator();
+
     // 3 shortcuts for stuff that litter the codebase all over.
-    const clang::SourceManager &sm() const { return m_sm; }
-    const clang::LangOptions &lo() const { return m_astContext.getLangOpts(); }
+    const clang::SourceManager &sm() const { return *m_sm; }
+    const clang::LangOptions &lo() const { return m_astContext->getLangOpts(); }
 
-    const clang::SourceManager &m_sm;
+    // Pointers, as reset() rebinds them
+    const clang::SourceManager *m_sm;
     const std::string m_name;
-    const ClazyContext *const m_context;
-    clang::ASTContext &m_astContext;
+    const ClazyContext *m_context;
+    clang::ASTContext *m_astContext;
     std::vector<std::string> m_filesToIgnore;
 private:
+    bool shouldEmitWarning(clang::SourceLocation loc);
+    bool isInBaseline(clang::SourceLocation loc, llvm::StringRef message); // Also exports it, with CLAZY_EXPORT_BASELINE
+    bool passesHotness(clang::SourceLocation loc, std::string &message) const; // Appends the hotness, with CLAZY_HOTNESS_PROFILE
+    WasteFinding captureWaste(clang::SourceLocation loc); // Uses up the estimate of setWasteEstimate()
+
+    /**
+     * Returns true if the warning only depends on the header it's in, so it can be stored in the HeaderCache: it's
+     * in the same file as the node being visited, which isn't part of a template instantiation.
+     */
+    bool isCacheableWarning(clang::SourceLocation loc) const;
+    bool passesHeaderCache(clang::SourceLocation loc, const std::string &message, bool cacheable); // Also records it
+    void emitQueuedManualFixitWarnings();
+    bool defersWarnings() const; // See emitDeferredWarning()
+    void subscribePreprocessorCallbacks();
+    bool warningsAreErrors() const;
+    unsigned int formattedDiagID(const char *format);
+
     friend class ClazyPreprocessorCallbacks;
     friend class ClazyAstMatcherCallback;
-    ClazyPreprocessorCallbacks *const m_preprocessorCallbacks;
-    std::vector<unsigned int> m_emittedWarningsInMacro;
-    std::vector<unsigned int> m_emittedManualFixItsWarningsInMacro;
-    std::vector<std::pair<clang::SourceLocation, std::string>> m_queuedManualInterventionWarnings;
+    PreprocessorEvents m_preprocessorEvents = 0; // Remembered so reset() can subscribe again
+    std::vector<std::string> m_preprocessorMacroNames;
+    CheckStats m_stats; // Before the containers using arenaAllocator()
+    // Raw encodings of locations, hashed and compared by their PresumedLoc, as Utils::presumedLocationsEqual() does,
+    // so a header included twice or a #line directive still dedups. Only locations with a valid PresumedLoc are stored.
+    struct PresumedLocHash {
+        const clang::SourceManager *sm;
+        size_t operator()(unsigned int rawLoc) const;
+    };
+    struct PresumedLocEqual {
+        const clang::SourceManager *sm;
+        bool operator()(unsigned int rawLoc1, unsigned int rawLoc2) const;
+    };
+    typedef std::unordered_set<unsigned int, PresumedLocHash, PresumedLocEqual, clazy::ArenaAllocator<unsigned int>> PresumedLocSet;
+    PresumedLocSet newPresumedLocSet();
+    bool insertPresumedLoc(PresumedLocSet &set, clang::SourceLocation loc) const;
+
+    // Allocated in the ClazyContext's arena, as they only live for the translation unit
+    PresumedLocSet m_emittedWarningsInMacro;
+    PresumedLocSet m_emittedManualFixItsWarningsInMacro;
+    clazy::ArenaVector<std::pair<clang::SourceLocation, std::string>> m_queuedManualInterventionWarnings;
     const Options m_options;
     const std::string m_tag;
+    const WarningDeduplicator::Rank m_duplicateRank; // Invalid unless the check overlaps with others
+    const bool m_isPerformanceCheck; // Only set with CLAZY_HOTNESS_PROFILE, see passesHotness()
+    const bool m_reportsWaste; // Only set for performance checks with -waste-report, see captureWaste()
+    WasteEstimate m_wasteEstimate; // See setWasteEstimate()
+    bool m_hasWasteEstimate = false;
+    const bool m_isCacheSafe;
+    bool m_disabled = false;
+    std::vector<BufferedWarning> m_bufferedWarnings; // See takeBufferedWarnings()
+    llvm::DenseMap<const char *, unsigned int> m_formattedDiagIDs; // By format, see emitFormattedWarning()
 };
 
 #endif
@@ -42,22 +42,41 @@ using namespace std;
 static const char * s_fixitNamePrefix = "fix-";
 static const char * s_levelPrefix = "level";
 
-std::mutex CheckManager::m_lock;
+// CLAZY_CHECKS keywords which limit the checks enabled through a level to a cost tier, indexed by RegisteredCheck::Cost
+static const vector<string> s_costNames = { "cheap", "moderate", "expensive" };
 
 CheckManager::CheckManager()
 {
     m_registeredChecks.reserve(100);
     registerChecks();
+    clazy::sort(m_registeredChecks, checkLessThan);
+
+    const char *checksEnv = getenv("CLAZY_CHECKS");
+    if (checksEnv) {
+        const string checksEnvStr = clazy::unquoteString(checksEnv);
+        m_requestedChecksThroughEnv = checksEnvStr == "all_checks" ? availableChecks(CheckLevel2)
+                                                                   : checksForCommaSeparatedString(checksEnvStr, /*by-ref=*/ m_disabledChecksThroughEnv);
+    }
 }
 
 bool CheckManager::checkExists(const string &name) const
 {
-    return checkForName(m_registeredChecks, name) != m_registeredChecks.cend();
+    return registeredCheck(name) != nullptr;
 }
 
-CheckManager *CheckManager::instance()
+const RegisteredCheck *CheckManager::registeredCheck(const string &name) const
 {
-    static CheckManager s_instance;
+    auto it = std::lower_bound(m_registeredChecks.cbegin(), m_registeredChecks.cend(), name, [] (const RegisteredCheck &c, const string &n) {
+        return c.name < n;
+    });
+
+    return (it != m_registeredChecks.cend() && it->name == name) ? &(*it) : nullptr;
+}
+
+const CheckManager *CheckManager::instance()
+{
+    // Thread-safe initialization, and nothing changes afterwards
+    static const CheckManager s_instance;
     return &s_instance;
 }
 
@@ -86,13 +105,10 @@ void CheckManager::registerFixIt(int id, const string &fixitName, const string &
     m_fixitByName.insert({fixitName, fixit});
 }
 
-CheckBase* CheckManager::createCheck(const string &name, ClazyContext *context)
+CheckBase* CheckManager::createCheck(const string &name, ClazyContext *context) const
 {
-    for (const auto& rc : m_registeredChecks) {
-        if (rc.name == name) {
-            return rc.factory(context);
-        }
-    }
+    if (const RegisteredCheck *rc = registeredCheck(name))
+        return rc->factory(context);
 
     llvm::errs() << "Invalid check name " << name << "\n";
     return nullptr;
@@ -103,20 +119,25 @@ string CheckManager::checkNameForFixIt(const string &fixitName) const
     if (fixitName.empty())
         return {};
 
-    for (auto &registeredCheck : m_registeredChecks) {
-        auto it = m_fixitsByCheckName.find(registeredCheck.name);
-        if (it != m_fixitsByCheckName.end()) {
-            auto &fixits = (*it).second;
-            for (const RegisteredFixIt &fixit : fixits) {
-                if (fixit.name == fixitName)
-                    return (*it).first;
-            }
+    if (m_fixitByName.find(fixitName) == m_fixitByName.end())
+        return {};
+
+    for (const auto &it : m_fixitsByCheckName) {
+        for (const RegisteredFixIt &fixit : it.second) {
+            if (fixit.name == fixitName)
+                return it.first;
         }
     }
 
     return {};
 }
 
+RegisteredCheck::Options CheckManager::checkOptions(const string &checkName) const
+{
+    const RegisteredCheck *check = registeredCheck(checkName);
+    return check ? check->options : RegisteredCheck::Option_None;
+}
+
 RegisteredCheck::List CheckManager::availableChecks(CheckLevel maxLevel) const
 {
     RegisteredCheck::List checks = m_registeredChecks;
@@ -130,20 +151,9 @@ RegisteredCheck::List CheckManager::availableChecks(CheckLevel maxLevel) const
 
 RegisteredCheck::List CheckManager::requestedChecksThroughEnv(vector<string> &userDisabledChecks) const
 {
-    static RegisteredCheck::List requestedChecksThroughEnv;
-    static vector<string> disabledChecksThroughEnv;
-    if (requestedChecksThroughEnv.empty()) {
-        const char *checksEnv = getenv("CLAZY_CHECKS");
-        if (checksEnv) {
-            const string checksEnvStr = clazy::unquoteString(checksEnv);
-            requestedChecksThroughEnv = checksEnvStr == "all_checks" ? availableChecks(CheckLevel2)
-                                                                     : checksForCommaSeparatedString(checksEnvStr, /*by-ref=*/ disabledChecksThroughEnv);
-        }
-    }
-
-    std::copy(disabledChecksThroughEnv.begin(), disabledChecksThroughEnv.end(),
+    std::copy(m_disabledChecksThroughEnv.begin(), m_disabledChecksThroughEnv.end(),
               std::back_inserter(userDisabledChecks));
-    return requestedChecksThroughEnv;
+    return m_requestedChecksThroughEnv;
 }
 
 RegisteredCheck::List::const_iterator CheckManager::checkForName(const RegisteredCheck::List &checks,
@@ -171,7 +181,7 @@ static bool takeArgument(const string &arg, vector<string> &args)
     return false;
 }
 
-RegisteredCheck::List CheckManager::requestedChecks(std::vector<std::string> &args, bool qt4Compat)
+RegisteredCheck::List CheckManager::requestedChecks(std::vector<std::string> &args, bool qt4Compat) const
 {
     RegisteredCheck::List result;
 
@@ -236,14 +246,25 @@ RegisteredCheck::List CheckManager::checksForLevel(int level) const
 }
 
 std::vector<std::pair<CheckBase*, RegisteredCheck>> CheckManager::createChecks(const RegisteredCheck::List &requestedChecks,
-                                                                               ClazyContext *context)
+                                                                               ClazyContext *context,
+                                                                               ReusableChecks *reusableChecks) const
 {
     assert(context);
 
     std::vector<std::pair<CheckBase*, RegisteredCheck>> checks;
     checks.reserve(requestedChecks.size() + 1);
     for (const auto& check : requestedChecks) {
-        checks.push_back({createCheck(check.name, context), check });
+        CheckBase *reused = nullptr;
+        if (reusableChecks) {
+            auto it = reusableChecks->find(check.name);
+            if (it != reusableChecks->end()) {
+                reused = it->second;
+                reusableChecks->erase(it);
+                reused->reset(context);
+            }
+        }
+
+        checks.push_back({ reused ? reused : createCheck(check.name, context), check });
     }
 
     return checks;
@@ -270,24 +291,33 @@ RegisteredCheck::List CheckManager::checksForCommaSeparatedString(const string &
 {
     vector<string> checkNames = clazy::splitString(str, ',');
     RegisteredCheck::List result;
+    RegisteredCheck::List levelChecks; // Subject to the cost keyword, unlike checks requested by name
+    bool levelRequested = false;
+    int maxCost = -1;
 
     for (const string &name : checkNames) {
         if (checkForName(result, name) != result.cend())
             continue; // Already added. Duplicate check specified. continue.
 
-        auto it = checkForName(m_registeredChecks, name);
-        if (it == m_registeredChecks.cend()) {
+        auto costIt = clazy::find(s_costNames, name);
+        if (costIt != s_costNames.cend()) {
+            maxCost = std::max<int>(maxCost, costIt - s_costNames.cbegin());
+            continue;
+        }
+
+        const RegisteredCheck *check = registeredCheck(name);
+        if (!check) {
             // Unknown, but might be a fixit name
             const string checkName = checkNameForFixIt(name);
-            auto it = checkForName(m_registeredChecks, checkName);
-            const bool checkDoesntExist = it == m_registeredChecks.cend();
+            check = registeredCheck(checkName);
+            const bool checkDoesntExist = !check;
             if (checkDoesntExist) {
                 if (clazy::startsWith(name, s_levelPrefix) && name.size() == strlen(s_levelPrefix) + 1) {
                     auto lastChar = name.back();
                     const int digit = lastChar - '0';
                     if (digit > CheckLevelUndefined && digit <= MaxCheckLevel) {
-                        RegisteredCheck::List levelChecks = checksForLevel(digit);
-                        clazy::append(levelChecks, result);
+                        clazy::append(checksForLevel(digit), levelChecks);
+                        levelRequested = true;
                     } else {
                         llvm::errs() << "Invalid level: " << name << "\n";
                     }
@@ -305,14 +335,29 @@ RegisteredCheck::List CheckManager::checksForCommaSeparatedString(const string &
                     }
                 }
             } else {
-                result.push_back(*it);
+                result.push_back(*check);
             }
             continue;
         } else {
-            result.push_back(*it);
+            result.push_back(*check);
         }
     }
 
+    if (maxCost != -1) {
+        // "cheap" alone means the cheap checks of the default level
+        if (!levelRequested)
+            levelChecks = checksForLevel(DefaultCheckLevel);
+
+        levelChecks.erase(remove_if(levelChecks.begin(), levelChecks.end(), [maxCost](const RegisteredCheck &c) {
+            return c.cost > maxCost;
+        }), levelChecks.end());
+    }
+
+    for (const RegisteredCheck &check : levelChecks) {
+        if (checkForName(result, check.name) == result.cend())
+            result.push_back(check);
+    }
+
     removeChecksFromList(result, userDisabledChecks);
 
     return result;
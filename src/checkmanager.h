@@ -30,7 +30,6 @@
 #include <clang/Lex/PreprocessorOptions.h>
 
 #include <functional>
-#include <mutex>
 #include <unordered_map>
 #include <vector>
 #include <utility>
@@ -49,12 +48,26 @@ struct RegisteredFixIt {
 
 using FactoryFunction = std::function<CheckBase*(ClazyContext *context)>;
 
+// Checks of finished translation units which can be reset() for the next one, by name. See CheckBase::isReusable()
+using ReusableChecks = std::unordered_map<std::string, CheckBase *>;
+
 struct RegisteredCheck {
     enum Option {
         Option_None = 0,
         Option_Qt4Incompatible = 1,
         Option_VisitsStmts = 2,
-        Option_VisitsDecls = 4
+        Option_VisitsDecls = 4,
+        Option_NeedsParentMap = 8, // Uses ClazyContext::parentMap, for statements which aren't being visited or their ancestors, see TraversalStack
+        Option_IgnoresFunctionBodies = 16, // Never looks into function bodies, so clazy-standalone can skip parsing the ones in headers
+        Option_Performance = 32, // In the performance category, so its warnings are prioritized with CLAZY_HOTNESS_PROFILE, see FunctionHotness
+        Option_CacheSafe = 64 // Its warnings only depend on the node it visits, so it skips headers replayed from the HeaderCache
+    };
+
+    // Runtime cost tier, measured with dev-scripts/benchmark.py. CLAZY_CHECKS="level1,cheap" only enables the cheap ones
+    enum Cost {
+        Cost_Cheap = 0,
+        Cost_Moderate,
+        Cost_Expensive
     };
 
     typedef std::vector<RegisteredCheck> List;
@@ -62,8 +75,14 @@ struct RegisteredCheck {
 
     std::string name;
     CheckLevel level;
+    Cost cost;
     FactoryFunction factory;
     Options options;
+
+    // AST node classes the check wants to be called for, for example "CallExpr" or "CXXRecordDecl".
+    // Classes with subclasses also match their subclasses. Empty means every Stmt (or Decl).
+    std::vector<std::string> visitedStmtClasses;
+    std::vector<std::string> visitedDeclClasses;
     bool operator==(const RegisteredCheck &other) const { return name == other.name; }
 };
 
@@ -84,13 +103,11 @@ class CheckManager
 {
 public:
     /**
-     * @note You must hold the CheckManager lock when operating on the instance
-     *
-     * @sa lock()
+     * The registry is built once, when first called, and is read-only afterwards, so it can be
+     * used from several threads without locking.
      */
-    static CheckManager *instance();
+    static const CheckManager *instance();
 
-    static std::mutex &lock() { return m_lock; }
     RegisteredCheck::List availableChecks(CheckLevel maxLevel) const;
     RegisteredCheck::List requestedChecksThroughEnv(std::vector<std::string> &userDisabledChecks) const;
 
@@ -99,31 +116,39 @@ public:
     RegisteredCheck::List checksForCommaSeparatedString(const std::string &str,
                                                         std::vector<std::string> &userDisabledChecks) const;
     RegisteredFixIt::List availableFixIts(const std::string &checkName) const;
+    RegisteredCheck::Options checkOptions(const std::string &checkName) const; // Option_None if it doesn't exist
 
 
     /**
      * Returns all the requested checks.
      * This is a union of the requested checks via env variable and via arguments passed to compiler
      */
-    RegisteredCheck::List requestedChecks(std::vector<std::string> &args, bool qt4Compat);
-    std::vector<std::pair<CheckBase*, RegisteredCheck>> createChecks(const RegisteredCheck::List &requestedChecks, ClazyContext *context);
+    RegisteredCheck::List requestedChecks(std::vector<std::string> &args, bool qt4Compat) const;
+    /**
+     * Creates the requested checks for a translation unit. Checks found in reusableChecks are taken from it
+     * and reset() instead.
+     */
+    std::vector<std::pair<CheckBase*, RegisteredCheck>> createChecks(const RegisteredCheck::List &requestedChecks, ClazyContext *context,
+                                                                     ReusableChecks *reusableChecks = nullptr) const;
 
     static void removeChecksFromList(RegisteredCheck::List &list, std::vector<std::string> &checkNames);
 
 private:
     CheckManager();
-    static std::mutex m_lock;
 
     void registerChecks();
     void registerFixIt(int id, const std::string &fititName, const std::string &checkName);
     void registerCheck(const RegisteredCheck &check);
     bool checkExists(const std::string &name) const;
+    const RegisteredCheck *registeredCheck(const std::string &name) const; // Binary search, nullptr if it doesn't exist
     RegisteredCheck::List checksForLevel(int level) const;
-    CheckBase* createCheck(const std::string &name, ClazyContext *context);
+    CheckBase* createCheck(const std::string &name, ClazyContext *context) const;
     std::string checkNameForFixIt(const std::string &) const;
-    RegisteredCheck::List m_registeredChecks;
+    RegisteredCheck::List m_registeredChecks; // Sorted by name
     std::unordered_map<std::string, std::vector<RegisteredFixIt>> m_fixitsByCheckName;
     std::unordered_map<std::string, RegisteredFixIt > m_fixitByName;
+    RegisteredCheck::List m_requestedChecksThroughEnv; // CLAZY_CHECKS, parsed once
+    std::vector<std::string> m_disabledChecksThroughEnv;
 };
 
 #endif
@@ -23,18 +23,10 @@
 */
 
 #include "detachingbase.h"
-#include "StringUtils.h"
-#include "QtUtils.h"
-#include "clazy_stl.h"
+#include "ClazyContext.h"
+#include "QtRegistry.h"
 
 #include <clang/AST/DeclCXX.h>
-#include <llvm/ADT/StringRef.h>
-
-#include <unordered_map>
-#include <utility>
-#include <vector>
-
-class ClazyContext;
 
 using namespace clang;
 using namespace std;
@@ -49,20 +41,6 @@ bool DetachingBase::isDetachingMethod(CXXMethodDecl *method, DetachingMethodType
     if (!method)
         return false;
 
-    CXXRecordDecl *record = method->getParent();
-    if (!record)
-        return false;
-
-    StringRef className = clazy::name(record);
-
-    const std::unordered_map<string, std::vector<StringRef>> &methodsByType = detachingMethodType == DetachingMethod ? clazy::detachingMethods()
-                                                                                                                     : clazy::detachingMethodsWithConstCounterParts();
-    auto it = methodsByType.find(className);
-    if (it != methodsByType.cend()) {
-        const auto &methods = it->second;
-        if (clazy::contains(methods, clazy::name(method)))
-            return true;
-    }
-
-    return false;
+    return m_context->qtRegistry().isDetachingMethod(method->getParent(), method->getDeclName(),
+                                                     detachingMethodType == DetachingMethodWithConstCounterPart);
 }
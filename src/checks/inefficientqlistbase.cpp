@@ -23,6 +23,7 @@
 */
 
 #include "inefficientqlistbase.h"
+#include "ClazyContext.h"
 #include "Utils.h"
 #include "TypeUtils.h"
 #include "ContextUtils.h"
@@ -70,11 +71,12 @@ bool InefficientQListBase::shouldIgnoreVariable(VarDecl *varDecl) const
     }
 
     Stmt *body = fDecl ? fDecl->getBody() : nullptr;
-    if ((m_ignoreMode & IgnoreIsAssignedToInFunction) && Utils::isAssignedFrom(body, varDecl)) {
+    const StmtIndex *index = m_context->functionStmtIndex(body);
+    if ((m_ignoreMode & IgnoreIsAssignedToInFunction) && Utils::isAssignedFrom(body, varDecl, index)) {
         return true;
     }
 
-    if ((m_ignoreMode & IgnoreIsPassedToFunctions) && Utils::isPassedToFunction(StmtBodyRange(body), varDecl, /*by-ref=*/ false)) {
+    if ((m_ignoreMode & IgnoreIsPassedToFunctions) && Utils::isPassedToFunction(StmtBodyRange(body, nullptr, {}, index), varDecl, /*by-ref=*/ false)) {
         return true;
     }
 
@@ -96,22 +98,31 @@ void InefficientQListBase::VisitDecl(clang::Decl *decl)
     if (!t)
         return;
 
-    CXXRecordDecl *recordDecl = t->getAsCXXRecordDecl();
-    if (!recordDecl || clazy::name(recordDecl) != "QList" || type.getAsString() == "QVariantList")
+    auto specialization = dyn_cast_or_null<ClassTemplateSpecializationDecl>(t->getAsCXXRecordDecl());
+    if (!specialization || clazy::name(specialization) != "QList")
         return;
 
-    const std::vector<clang::QualType> types = clazy::getTemplateArgumentsTypes(recordDecl);
-    if (types.empty())
-        return;
-    QualType qt2 = types[0];
-    if (!qt2.getTypePtrOrNull() || qt2->isIncompleteType())
-        return;
-
-    const int size_of_ptr = clazy::sizeOfPointer(&m_astContext, qt2); // in bits
-    const int size_of_T = m_astContext.getTypeSize(qt2);
+    // Each QList<Foo> variable gets here, but the size only depends on Foo
+    const int size_of_T = m_tooBigTypeSizes.get(specialization, [this] (ClassTemplateSpecializationDecl *list) {
+        return tooBigTypeSize(list);
+    });
 
-    if (size_of_T > size_of_ptr && !shouldIgnoreVariable(varDecl)) {
+    if (size_of_T != 0 && type.getAsString() != "QVariantList" && !shouldIgnoreVariable(varDecl)) {
         string s = string("Use QVector instead of QList for type with size " + to_string(size_of_T / 8) + " bytes");
         emitWarning(clazy::getLocStart(decl), s.c_str());
     }
 }
+
+int InefficientQListBase::tooBigTypeSize(ClassTemplateSpecializationDecl *list) const
+{
+    const std::vector<clang::QualType> types = clazy::getTemplateArgumentsTypes(list);
+    if (types.empty())
+        return 0;
+    QualType qt2 = types[0];
+    if (!qt2.getTypePtrOrNull() || qt2->isIncompleteType())
+        return 0;
+
+    const int size_of_ptr = clazy::sizeOfPointer(m_astContext, qt2); // in bits
+    const int size_of_T = m_astContext->getTypeSize(qt2);
+    return size_of_T > size_of_ptr ? size_of_T : 0;
+}
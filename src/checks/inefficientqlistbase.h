@@ -26,12 +26,14 @@
 #define INEFFICIENT_QLIST_BASE_H
 
 #include "checkbase.h"
+#include "TemplateUtils.h"
 
 #include <string>
 
 class ClazyContext;
 
 namespace clang {
+class ClassTemplateSpecializationDecl;
 class VarDecl;
 class Decl;
 }
@@ -57,7 +59,10 @@ public:
 
 private:
     bool shouldIgnoreVariable(clang::VarDecl *varDecl) const;
+    // Returns the size of T in bits if it's bigger than a pointer, 0 otherwise
+    int tooBigTypeSize(clang::ClassTemplateSpecializationDecl *list) const;
     const int m_ignoreMode;
+    clazy::SpecializationMemo<int> m_tooBigTypeSizes; // Result of tooBigTypeSize() for each QList specialization
 };
 
 #endif
@@ -41,7 +41,7 @@ using namespace clang;
 using namespace std;
 
 ConnectNotNormalized::ConnectNotNormalized(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
 {
 }
 
@@ -76,7 +76,7 @@ bool ConnectNotNormalized::handleQ_ARG(CXXConstructExpr *expr)
     if (original == normalized)
         return false;
 
-    emitWarning(expr, "Signature is not normalized. Use " + normalized + " instead of " + original);
+    emitFormattedWarning(clazy::getLocStart(expr), "Signature is not normalized. Use %0 instead of %1", { normalized, original });
     return true;
 }
 
@@ -119,6 +119,6 @@ bool ConnectNotNormalized::handleConnect(CallExpr *callExpr)
     normalized.erase(0, 1);
     original.erase(0, 1);
 
-    emitWarning(clazy::getLocStart(callExpr), "Signature is not normalized. Use " + normalized + " instead of " + original);
+    emitFormattedWarning(clazy::getLocStart(callExpr), "Signature is not normalized. Use %0 instead of %1", { normalized, original });
     return true;
 }
@@ -20,10 +20,15 @@
 */
 
 #include "container-anti-pattern.h"
+#include "ClazyContext.h"
+#include "FixItUtils.h"
 #include "Utils.h"
 #include "StringUtils.h"
 #include "LoopUtils.h"
 #include "HierarchyUtils.h"
+#include "PreProcessorVisitor.h"
+#include "StmtBodyRange.h"
+#include "TypeUtils.h"
 #include "SourceCompatibilityHelpers.h"
 #include "clazy_stl.h"
 
@@ -33,6 +38,8 @@
 #include <clang/AST/ExprCXX.h>
 #include <clang/AST/Stmt.h>
 #include <clang/Basic/LLVM.h>
+#include <clang/Lex/Lexer.h>
+#include <llvm/ADT/StringRef.h>
 #include <llvm/Support/Casting.h>
 
 #include <vector>
@@ -44,8 +51,10 @@ using namespace std;
 
 
 ContainerAntiPattern::ContainerAntiPattern(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
 {
+    if (fixitsEnabled())
+        context->enablePreprocessorVisitor(); // For the Qt version, the fixits use qAsConst() and keyBegin()
 }
 
 static bool isInterestingCall(CallExpr *call)
@@ -56,7 +65,8 @@ static bool isInterestingCall(CallExpr *call)
 
     static const vector<string> methods = { "QVector::toList", "QList::toVector", "QMap::values",
                                             "QMap::keys", "QSet::toList", "QSet::values",
-                                            "QHash::values", "QHash::keys" };
+                                            "QHash::values", "QHash::keys", "QMultiMap::values",
+                                            "QMultiMap::keys", "QMultiHash::values", "QMultiHash::keys" };
 
     return clazy::contains(methods, clazy::qualifiedMethodName(func));
 }
@@ -104,7 +114,7 @@ bool ContainerAntiPattern::VisitQSet(Stmt *stmt)
         return false;
 
     CXXMethodDecl *firstMethod = dyn_cast<CXXMethodDecl>(firstFunc);
-    if (!firstMethod || clazy::qualifiedMethodName(firstMethod) != "QSet::intersect")
+    if (!firstMethod || !clazy::qualifiedMethodNameIs(firstMethod, "QSet::intersect"))
         return false;
 
     emitWarning(clazy::getLocStart(stmt), "Use QSet::intersects() instead");
@@ -119,9 +129,105 @@ bool ContainerAntiPattern::handleLoop(Stmt *stm)
 
     auto memberExpr = clazy::getFirstChildOfType2<CXXMemberCallExpr>(containerExpr);
     if (isInterestingCall(memberExpr)) {
-        emitWarning(clazy::getLocStart(stm), "allocating an unneeded temporary container");
+        auto rangeLoop = dyn_cast<CXXForRangeStmt>(stm);
+        emitWarning(clazy::getLocStart(stm), "allocating an unneeded temporary container",
+                    rangeLoop && fixitsEnabled() ? loopFixits(rangeLoop, memberExpr) : vector<FixItHint>());
         return true;
     }
 
     return false;
 }
+
+static bool isNameUsed(Stmt *body, StringRef name)
+{
+    for (DeclStmt *declStmt : clazy::getStatements<DeclStmt>(body)) {
+        for (Decl *decl : declStmt->decls()) {
+            auto namedDecl = dyn_cast<NamedDecl>(decl);
+            if (namedDecl && clazy::name(namedDecl) == name)
+                return true;
+        }
+    }
+
+    return clazy::any_of(clazy::getStatements<DeclRefExpr>(body), [name](DeclRefExpr *declRef) {
+        return clazy::name(declRef->getDecl()) == name;
+    });
+}
+
+// Iterates the container instead, when the loop can't modify it, which the temporary list allowed
+vector<FixItHint> ContainerAntiPattern::loopFixits(CXXForRangeStmt *loop, CXXMemberCallExpr *call) const
+{
+    Expr *rangeInit = loop->getRangeInit();
+    if (!rangeInit || rangeInit->IgnoreImplicit() != call || call->getNumArgs() != 0)
+        return {};
+
+    VarDecl *loopVar = loop->getLoopVariable();
+    const QualType loopVarType = loopVar->getType();
+    if (loopVarType->isReferenceType() && !clazy::unrefQualType(loopVarType).isConstQualified())
+        return {};
+
+    // Only local containers, a member or a reference could be changed by any call
+    Expr *object = call->getImplicitObjectArgument();
+    auto declRef = object ? dyn_cast<DeclRefExpr>(object->IgnoreImpCasts()) : nullptr;
+    auto containerDecl = declRef ? dyn_cast<VarDecl>(declRef->getDecl()) : nullptr;
+    if (!containerDecl || !containerDecl->hasLocalStorage() || containerDecl->getType()->isReferenceType()
+        || clazy::getLocStart(loop).isMacroID()
+        || call->getSourceRange().getBegin().isMacroID() || call->getSourceRange().getEnd().isMacroID())
+        return {};
+
+    Stmt *body = loop->getBody();
+    if (Utils::containsNonConstMemberCall(m_context->parentMap, body, containerDecl)
+        || Utils::isPassedToFunction(StmtBodyRange(body, nullptr, {}, m_context->functionStmtIndex(body)), containerDecl, true)
+        || Utils::addressIsTaken(body, containerDecl, m_context->functionStmtIndex(body)))
+        return {};
+
+    const string container = clazy::name(containerDecl).str();
+    const int qtVersion = m_context->preprocessorVisitor ? m_context->preprocessorVisitor->qtVersion() : -1;
+    if (clazy::name(call->getMethodDecl()) == "keys")
+        return qtVersion == -1 || qtVersion >= 50600 ? keyLoopFixits(loop, call, container) : vector<FixItHint>();
+
+    if (containerDecl->getType().isConstQualified())
+        return { clazy::createReplacement(call->getSourceRange(), container) };
+
+    if (qtVersion != -1 && qtVersion < 50700) // qAsConst() was added to 5.7
+        return {};
+
+    return { clazy::createReplacement(call->getSourceRange(), "qAsConst(" + container + ")") };
+}
+
+// for (auto k : hash.keys()) { ... } becomes
+// for (auto kIt = hash.keyBegin(), kEnd = hash.keyEnd(); kIt != kEnd; ++kIt) { auto k = *kIt; ... }
+vector<FixItHint> ContainerAntiPattern::keyLoopFixits(CXXForRangeStmt *loop, CXXMemberCallExpr *call,
+                                                      const string &container) const
+{
+    VarDecl *loopVar = loop->getLoopVariable();
+    auto body = dyn_cast<CompoundStmt>(loop->getBody());
+    FunctionDecl *func = m_context->lastFunctionDecl;
+    if (!body || body->body_empty() || !func || !func->getBody() || clazy::name(loopVar).empty())
+        return {};
+
+    const string name = clazy::name(loopVar).str();
+    const string it = name + "It";
+    const string end = name + "End";
+    if (isNameUsed(func->getBody(), it) || isNameUsed(func->getBody(), end))
+        return {};
+
+    // "const QString &" in "const QString &k"
+    const SourceLocation varStart = clazy::getLocStart(loopVar);
+    if (varStart.isMacroID() || loopVar->getLocation().isMacroID())
+        return {};
+    const string type = Lexer::getSourceText(CharSourceRange::getCharRange(varStart, loopVar->getLocation()), sm(), lo()).str();
+
+    // Keep the indentation of the first statement
+    const SourceLocation firstStart = clazy::getLocStart(body->body_front());
+    if (type.empty() || firstStart.isMacroID())
+        return {};
+    const unsigned int column = sm().getSpellingColumnNumber(firstStart);
+    const StringRef linePrefix(sm().getCharacterData(firstStart) - (column - 1), column - 1);
+    const bool ownLine = linePrefix.find_first_not_of(" \t") == StringRef::npos;
+
+    const string header = "auto " + it + " = " + container + ".keyBegin(), " + end + " = " + container + ".keyEnd(); "
+                          + it + " != " + end + "; ++" + it;
+    const string declaration = type + name + " = *" + it + ";" + (ownLine ? "\n" + linePrefix.str() : string(" "));
+    return { clazy::createReplacement({ varStart, clazy::getLocEnd(call) }, header),
+             clazy::createInsertion(firstStart, declaration) };
+}
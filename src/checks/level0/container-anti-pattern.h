@@ -25,6 +25,7 @@
 #include "checkbase.h"
 
 #include <string>
+#include <vector>
 
 class ClazyContext;
 
@@ -32,6 +33,8 @@ namespace clang {
 class Stmt;
 class CXXForRangeStmt;
 class CXXConstructExpr;
+class CXXMemberCallExpr;
+class FixItHint;
 }
 
 /**
@@ -49,6 +52,9 @@ public:
 private:
     bool VisitQSet(clang::Stmt *stmt);
     bool handleLoop(clang::Stmt *);
+    std::vector<clang::FixItHint> loopFixits(clang::CXXForRangeStmt *loop, clang::CXXMemberCallExpr *call) const;
+    std::vector<clang::FixItHint> keyLoopFixits(clang::CXXForRangeStmt *loop, clang::CXXMemberCallExpr *call,
+                                                const std::string &container) const;
 };
 
 #endif
@@ -0,0 +1,120 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "discarded-result.h"
+#include "ClazyContext.h"
+#include "HierarchyUtils.h"
+#include "LoopUtils.h"
+#include "StringUtils.h"
+#include "SourceCompatibilityHelpers.h"
+
+#include <clang/AST/Attr.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/Type.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/SourceLocation.h>
+#include <llvm/Support/Casting.h>
+
+using namespace clang;
+using namespace std;
+
+DiscardedResult::DiscardedResult(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+}
+
+bool DiscardedResult::isDiscarded(CXXMemberCallExpr *call) const
+{
+    // The temporary holding the result is wrapped in a few implicit nodes, an explicit (void) cast isn't one of them
+    Stmt *child = call;
+    Stmt *parent = clazy::parent(m_context, call);
+    while (parent && (isa<ExprWithCleanups>(parent) || isa<CXXBindTemporaryExpr>(parent)
+                      || isa<MaterializeTemporaryExpr>(parent) || isa<ImplicitCastExpr>(parent) || isa<ParenExpr>(parent))) {
+        child = parent;
+        parent = clazy::parent(m_context, parent);
+    }
+
+    if (!parent || isa<CompoundStmt>(parent))
+        return parent != nullptr;
+
+    if (auto ifStmt = dyn_cast<IfStmt>(parent))
+        return child == ifStmt->getThen() || child == ifStmt->getElse();
+
+    if (auto switchCase = dyn_cast<SwitchCase>(parent))
+        return child == switchCase->getSubStmt();
+
+    if (auto label = dyn_cast<LabelStmt>(parent))
+        return child == label->getSubStmt();
+
+    return child == clazy::bodyFromLoop(parent);
+}
+
+void DiscardedResult::VisitStmt(clang::Stmt *stmt)
+{
+    auto call = dyn_cast<CXXMemberCallExpr>(stmt);
+    if (!call || clazy::getLocStart(call).isMacroID())
+        return;
+
+    CXXMethodDecl *method = call->getMethodDecl();
+    if (!method || method->isStatic() || (!method->isConst() && method->getRefQualifier() != RQ_RValue))
+        return;
+
+    static const clazy::NameSet classes = { "QString", "QByteArray", "QStringList", "QList", "QVector",
+                                            "QVarLengthArray", "QLinkedList", "QMap", "QMultiMap", "QHash",
+                                            "QMultiHash", "QSet", "QQueue", "QStack" };
+    // The object's class rather than the method's, QStringList's are in QList and QListSpecialMethods
+    CXXRecordDecl *record = call->getRecordDecl();
+    if (!clazy::classIsOneOf(record, classes))
+        return;
+
+    const QualType returnType = method->getReturnType();
+    if (returnType.isNull() || returnType->isReferenceType())
+        return;
+
+    CXXRecordDecl *returnRecord = returnType->getAsCXXRecordDecl();
+    if (!returnRecord)
+        return;
+
+    // Methods allocating a result of another type, the ones returning their own class are found by type
+    static const clazy::NameSet allocatingMethods = { "toVector", "toList", "toSet", "toStdVector", "toStdList",
+                                                      "toStdMap", "toStdString", "toStdWString", "toStdU16String",
+                                                      "toStdU32String", "toUcs4", "toUtf8", "toLatin1", "toLocal8Bit",
+                                                      "toHex", "toBase64", "toPercentEncoding", "toHtmlEscaped",
+                                                      "keys", "values", "uniqueKeys", "split", "join" };
+    const bool returnsOwnClass = returnRecord->getCanonicalDecl() == method->getParent()->getCanonicalDecl();
+    if (!returnsOwnClass && !allocatingMethods.contains(clazy::name(method)))
+        return;
+
+    // Q_REQUIRED_RESULT and [[nodiscard]] already make the compiler warn
+    if (method->hasAttr<WarnUnusedResultAttr>() || returnRecord->hasAttr<WarnUnusedResultAttr>())
+        return;
+
+    if (!isDiscarded(call))
+        return;
+
+    const string name = clazy::name(record).str() + "::" + clazy::name(method).str() + "()";
+    emitWarning(clazy::getLocStart(call), name + " result is unused; it returns a new "
+                + clazy::simpleTypeName(returnType, lo()) + " and doesn't modify the object");
+}
@@ -38,7 +38,7 @@ using namespace std;
 
 
 EmptyQStringliteral::EmptyQStringliteral(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context)
+    : CheckBase(name, context, Option_Reusable)
 {
 }
 
@@ -79,5 +79,5 @@ bool EmptyQStringliteral::maybeIgnoreUic(SourceLocation loc) const
     if (preProcessorVisitor && preProcessorVisitor->qtVersion() >= 51200)
         return false;
 
-    return clazy::isUIFile(loc, sm());
+    return clazy::isUIFile(m_context->fileInfo(loc).basename());
 }
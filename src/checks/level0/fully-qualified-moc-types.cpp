@@ -54,7 +54,7 @@ FullyQualifiedMocTypes::FullyQualifiedMocTypes(const std::string &name, ClazyCon
     : CheckBase(name, context)
 {
     context->enableAccessSpecifierManager();
-    enablePreProcessorCallbacks();
+    enablePreProcessorCallbacks(PreprocessorEvent_MacroExpands, { "Q_GADGET" });
 }
 
 void FullyQualifiedMocTypes::VisitDecl(clang::Decl *decl)
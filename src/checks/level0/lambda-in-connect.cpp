@@ -42,7 +42,7 @@ using namespace std;
 
 
 LambdaInConnect::LambdaInConnect(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
 {
 }
 
@@ -56,8 +56,8 @@ void LambdaInConnect::VisitStmt(clang::Stmt *stmt)
     if (captures.begin() == captures.end())
         return;
 
-    auto callExpr = clazy::getFirstParentOfType<CallExpr>(m_context->parentMap, lambda);
-    if (clazy::qualifiedMethodName(callExpr) != "QObject::connect")
+    auto callExpr = clazy::getFirstParentOfType<CallExpr>(m_context, lambda);
+    if (!clazy::qualifiedMethodNameIs(callExpr, "QObject::connect"))
         return;
 
     ValueDecl *senderDecl = clazy::signalSenderForConnect(callExpr);
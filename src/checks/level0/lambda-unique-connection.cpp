@@ -43,7 +43,7 @@ using namespace std;
 
 
 LambdaUniqueConnection::LambdaUniqueConnection(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
 {
 }
 
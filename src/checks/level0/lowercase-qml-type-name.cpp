@@ -33,7 +33,7 @@ using namespace std;
 
 
 LowercaseQMlTypeName::LowercaseQMlTypeName(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context)
+    : CheckBase(name, context, Option_Reusable)
 {
 }
 
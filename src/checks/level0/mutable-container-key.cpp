@@ -45,7 +45,7 @@ static bool isInterestingContainer(StringRef name)
 }
 
 MutableContainerKey::MutableContainerKey(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
 {
 }
 
@@ -65,8 +65,8 @@ void MutableContainerKey::VisitDecl(clang::Decl *decl)
         return;
 
     auto record = t->isRecordType() ? t->getAsCXXRecordDecl() : nullptr;
-    if (!clazy::classIsOneOf(record, {"QPointer", "QWeakPointer",
-                                      "QPersistentModelIndex", "weak_ptr"}))
+    static const clazy::NameSet weakClasses = { "QPointer", "QWeakPointer", "QPersistentModelIndex", "weak_ptr" };
+    if (!clazy::classIsOneOf(record, weakClasses))
         return;
 
 
@@ -78,7 +78,7 @@ public:
 
 
 QColorFromLiteral::QColorFromLiteral(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
     , m_astMatcherCallBack(new QColorFromLiteral_Callback(this))
 {
 }
@@ -25,6 +25,7 @@
 #include "qdatetime-utc.h"
 #include "Utils.h"
 #include "FixItUtils.h"
+#include "StringUtils.h"
 #include "SourceCompatibilityHelpers.h"
 
 #include <clang/AST/Decl.h>
@@ -44,7 +45,7 @@ using namespace clang;
 using namespace std;
 
 QDateTimeUtc::QDateTimeUtc(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context)
+    : CheckBase(name, context, Option_Reusable)
 {
 }
 
@@ -69,7 +70,7 @@ void QDateTimeUtc::VisitStmt(clang::Stmt *stmt)
         return;
 
     CXXMethodDecl *firstMethod = dyn_cast<CXXMethodDecl>(firstFunc);
-    if (!firstMethod || firstMethod->getQualifiedNameAsString() != "QDateTime::currentDateTime")
+    if (!firstMethod || !clazy::qualifiedNameIs(firstMethod, "QDateTime::currentDateTime"))
         return;
 
     std::string replacement = "::currentDateTimeUtc()";
@@ -79,7 +80,7 @@ void QDateTimeUtc::VisitStmt(clang::Stmt *stmt)
 
     std::vector<FixItHint> fixits;
     if (fixitsEnabled()) {
-        const bool success = clazy::transformTwoCallsIntoOneV2(&m_astContext, secondCall, replacement, fixits);
+        const bool success = clazy::transformTwoCallsIntoOneV2(m_astContext, secondCall, replacement, fixits);
         if (!success) {
             queueManualFixitWarning(clazy::getLocStart(secondCall));
         }
@@ -40,7 +40,7 @@ using namespace std;
 QEnums::QEnums(const std::string &name, ClazyContext *context)
     : CheckBase(name, context)
 {
-    enablePreProcessorCallbacks();
+    enablePreProcessorCallbacks(PreprocessorEvent_MacroExpands, { "Q_ENUMS" });
     context->enablePreprocessorVisitor();
 }
 
@@ -37,7 +37,7 @@ using namespace std;
 
 
 QFileInfoExists::QFileInfoExists(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
 {
 }
 
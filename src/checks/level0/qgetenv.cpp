@@ -46,7 +46,7 @@ using namespace clang;
 using namespace std;
 
 QGetEnv::QGetEnv(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
 {
 }
 
@@ -96,7 +96,7 @@ void QGetEnv::VisitStmt(clang::Stmt *stmt)
     if (!errorMsg.empty()) {
         std::vector<FixItHint> fixits;
         if (fixitsEnabled()) {
-            const bool success = clazy::transformTwoCallsIntoOne(&m_astContext, qgetEnvCall, memberCall, replacement, fixits);
+            const bool success = clazy::transformTwoCallsIntoOne(m_astContext, qgetEnvCall, memberCall, replacement, fixits);
             if (!success) {
                 queueManualFixitWarning(clazy::getLocStart(memberCall));
             }
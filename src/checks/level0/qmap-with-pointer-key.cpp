@@ -39,7 +39,7 @@ using namespace clang;
 using namespace std;
 
 QMapWithPointerKey::QMapWithPointerKey(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context)
+    : CheckBase(name, context, Option_Reusable)
 {
 }
 
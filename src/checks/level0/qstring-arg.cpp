@@ -27,18 +27,21 @@
 #include "clazy_stl.h"
 #include "ClazyContext.h"
 #include "PreProcessorVisitor.h"
+#include "FixItUtils.h"
 
 #include <clang/AST/Decl.h>
 #include <clang/AST/DeclCXX.h>
 #include <clang/AST/Expr.h>
 #include <clang/AST/ExprCXX.h>
 #include <clang/AST/Stmt.h>
+#include <clang/Basic/Diagnostic.h>
 #include <clang/Basic/LLVM.h>
 #include <clang/Basic/SourceLocation.h>
 #include <clang/Lex/Lexer.h>
 #include <llvm/ADT/StringRef.h>
 #include <llvm/Support/Casting.h>
 
+#include <cctype>
 #include <vector>
 
 class ClazyContext;
@@ -91,24 +94,106 @@ static bool isArgFuncWithOnlyQString(CallExpr *callExpr)
         return false;
 
     ParmVarDecl *secondParam = method->getParamDecl(1);
-    if (clazy::classNameFor(secondParam) == "QString")
+    if (clazy::classNameIs(secondParam, "QString"))
         return true;
 
     ParmVarDecl *firstParam = method->getParamDecl(0);
-    if (clazy::classNameFor(firstParam) != "QString")
+    if (!clazy::classNameIs(firstParam, "QString"))
         return false;
 
     // This is a arg(QString, int, QChar) call, it's good if the second parameter is a default param
     return isa<CXXDefaultArgExpr>(callExpr->getArg(1));
 }
 
+// Returns the arguments which were passed explicitly, default arguments are dropped
+static vector<Expr *> explicitArgs(CallExpr *call)
+{
+    vector<Expr *> args;
+    for (unsigned int i = 0; i < call->getNumArgs(); ++i) {
+        Expr *arg = call->getArg(i);
+        if (isa<CXXDefaultArgExpr>(arg))
+            break;
+        args.push_back(arg);
+    }
+
+    return args;
+}
+
+// Returns true if arg is a QString already, and not something implicitly converted to one, like a const char*
+static bool isQStringArgument(Expr *arg)
+{
+    arg = arg->IgnoreImplicit();
+    if (isa<CXXConstructExpr>(arg) && !isa<CXXTemporaryObjectExpr>(arg))
+        return false;
+
+    CXXRecordDecl *record = arg->getType()->getAsCXXRecordDecl();
+    return record && clazy::name(record) == "QString";
+}
+
+// Collects the arguments of an .arg() chain, in the order they're substituted. calls goes from the outermost call to the innermost one.
+static bool collectQStringArgs(const vector<CallExpr *> &calls, vector<Expr *> &args)
+{
+    for (auto it = calls.rbegin(), end = calls.rend(); it != end; ++it) {
+        for (Expr *arg : explicitArgs(*it)) {
+            if (!isQStringArgument(arg))
+                return false;
+            args.push_back(arg);
+        }
+    }
+
+    return true;
+}
+
+static string sourceText(Expr *expr, const SourceManager &sm, const LangOptions &lo)
+{
+    const SourceRange range = expr->getSourceRange();
+    if (range.getBegin().isMacroID() || range.getEnd().isMacroID())
+        return {};
+
+    return Lexer::getSourceText(CharSourceRange::getTokenRange(range), sm, lo);
+}
+
+vector<FixItHint> QStringArg::multiArgFixits(const vector<CallExpr *> &calls)
+{
+    vector<Expr *> args;
+    if (calls.size() < 2 || !collectQStringArgs(calls, args))
+        return {};
+
+    CallExpr *innermost = calls.back();
+    CallExpr *outermost = calls.front();
+    const SourceRange range(innermost->getRParenLoc(), outermost->getRParenLoc());
+    if (range.getBegin().isMacroID() || range.getEnd().isMacroID())
+        return {};
+
+    // .arg(a).arg(b).arg(c) -> .arg(a, b, c), the innermost call keeps its own arguments
+    string replacement;
+    for (size_t i = explicitArgs(innermost).size(); i < args.size(); ++i) {
+        const string text = sourceText(args.at(i), sm(), lo());
+        if (text.empty())
+            return {};
+        replacement += ", " + text;
+    }
+
+    return { clazy::createReplacement(range, replacement + ")") };
+}
+
 bool QStringArg::checkMultiArgWarningCase(const vector<clang::CallExpr *> &calls)
 {
     const int size = calls.size();
     for (int i = 1; i < size; ++i) {
         auto call = calls.at(i);
         if (calls.at(i - 1)->getNumArgs() + call->getNumArgs() <= 9) {
-            emitWarning(clazy::getLocEnd(call), "Use multi-arg instead");
+            // Merge as many of the inner calls as the multi-arg overloads accept
+            vector<CallExpr *> merged;
+            size_t numArgs = 0;
+            for (int j = i - 1; j < size; ++j) {
+                numArgs += explicitArgs(calls.at(j)).size();
+                if (numArgs > 9)
+                    break;
+                merged.push_back(calls.at(j));
+            }
+
+            emitWarning(clazy::getLocEnd(call), "Use multi-arg instead", multiArgFixits(merged));
             return true;
         }
     }
@@ -143,6 +228,142 @@ void QStringArg::checkForMultiArgOpportunities(CXXMemberCallExpr *memberCall)
     checkMultiArgWarningCase(argCalls);
 }
 
+// Returns the string literal a format string was constructed from, as in QString("%1"), QLatin1String("%1") or QStringLiteral("%1")
+static StringLiteral *formatStringLiteral(Expr *expr, const SourceManager &sm, const LangOptions &lo)
+{
+    if (clazy::getLocStart(expr).isMacroID()) {
+        if (Lexer::getImmediateMacroName(clazy::getLocStart(expr), sm, lo) != "QStringLiteral")
+            return nullptr;
+
+        vector<StringLiteral *> literals;
+        clazy::getChilds<StringLiteral>(expr, literals);
+        return literals.empty() ? nullptr : literals.front();
+    }
+
+    while (expr) {
+        expr = expr->IgnoreImplicit()->IgnoreParens();
+        if (auto literal = dyn_cast<StringLiteral>(expr))
+            return literal;
+
+        if (auto construct = dyn_cast<CXXConstructExpr>(expr)) {
+            expr = construct->getNumArgs() == 1 ? construct->getArg(0) : nullptr;
+        } else if (auto cast = dyn_cast<ExplicitCastExpr>(expr)) {
+            expr = cast->getSubExpr();
+        } else {
+            return nullptr;
+        }
+    }
+
+    return nullptr;
+}
+
+// Appends the literal text between placeholders, as QLatin1Char('c') or QLatin1String("text").
+// Returns false if it can't be used in a QLatin1String, as it's not ASCII.
+static bool appendTextPiece(const string &text, vector<string> &pieces)
+{
+    if (text.empty())
+        return true;
+
+    const char quote = text.size() == 1 ? '\'' : '"';
+    string piece = text.size() == 1 ? "QLatin1Char(" : "QLatin1String(";
+    piece += quote;
+    for (char c : text) {
+        if (c == quote || c == '\\') {
+            piece += '\\';
+            piece += c;
+        } else if (c == '\n') {
+            piece += "\\n";
+        } else if (c == '\t') {
+            piece += "\\t";
+        } else if (c < 0x20 || c > 0x7e) {
+            return false;
+        } else {
+            piece += c;
+        }
+    }
+
+    piece += quote;
+    piece += ')';
+    pieces.push_back(piece);
+    return true;
+}
+
+bool QStringArg::checkConcatenationCase(CXXMemberCallExpr *memberCall)
+{
+    if (!isArgFuncWithOnlyQString(memberCall) || clazy::contains(m_alreadyProcessedChainedCalls, memberCall))
+        return false;
+
+    vector<CallExpr *> argCalls;
+    for (auto call : Utils::callListForChain(memberCall)) {
+        if (!isArgFuncWithOnlyQString(call))
+            break;
+        argCalls.push_back(call);
+    }
+
+    auto innermost = dyn_cast<CXXMemberCallExpr>(argCalls.back());
+    vector<Expr *> args;
+    if (!innermost || !collectQStringArgs(argCalls, args) || args.size() > 9)
+        return false;
+
+    StringLiteral *literal = formatStringLiteral(innermost->getImplicitObjectArgument(), sm(), lo());
+    if (!literal)
+        return false;
+
+    string format;
+    for (unsigned int i = 0; i < literal->getLength(); ++i) {
+        const uint32_t codeUnit = literal->getCodeUnit(i);
+        if (codeUnit > 0x7e)
+            return false;
+        format += char(codeUnit);
+    }
+
+    // Split the format string into text and placeholders. Each placeholder must be used once, and
+    // there mustn't be any localized ones, as %L1. Otherwise it's formatting more than just concatenating.
+    vector<string> pieces;
+    vector<bool> usedArgs(args.size(), false);
+    string text;
+    for (size_t i = 0; i < format.size(); ++i) {
+        const char c = format[i];
+        const char next = i + 1 < format.size() ? format[i + 1] : 0;
+        if (c == '%' && next == 'L')
+            return false;
+
+        if (c != '%' || !isdigit(next)) {
+            text += c;
+            continue;
+        }
+
+        const size_t index = next - '1';
+        if (next == '0' || index >= args.size() || usedArgs[index] || (i + 2 < format.size() && isdigit(format[i + 2])))
+            return false;
+
+        string argText = sourceText(args.at(index), sm(), lo());
+        if (argText.empty())
+            return false;
+
+        if (!appendTextPiece(text, pieces))
+            return false;
+        text.clear();
+
+        usedArgs[index] = true;
+        pieces.push_back(argText);
+        ++i;
+    }
+
+    if (clazy::contains(usedArgs, false) || !appendTextPiece(text, pieces))
+        return false;
+
+    string suggestion;
+    for (const string &piece : pieces)
+        suggestion += suggestion.empty() ? piece : " + " + piece;
+
+    for (auto call : argCalls)
+        m_alreadyProcessedChainedCalls.push_back(call);
+
+    emitWarning(clazy::getLocStart(memberCall), "QString::arg() is only concatenating strings here, use QStringBuilder instead: " + suggestion);
+    return true;
+}
+
 bool QStringArg::checkQLatin1StringCase(CXXMemberCallExpr *memberCall)
 {
     PreProcessorVisitor *preProcessorVisitor = m_context->preprocessorVisitor;
@@ -175,7 +396,8 @@ void QStringArg::VisitStmt(clang::Stmt *stmt)
     if (shouldIgnoreFile(clazy::getLocStart(stmt)))
         return;
 
-    checkForMultiArgOpportunities(memberCall);
+    if (!isOptionSet("concatenation") || !checkConcatenationCase(memberCall))
+        checkForMultiArgOpportunities(memberCall);
 
     if (checkQLatin1StringCase(memberCall))
         return;
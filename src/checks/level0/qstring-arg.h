@@ -24,6 +24,8 @@
 
 #include "checkbase.h"
 
+#include <clang/Basic/Diagnostic.h>
+
 #include <string>
 #include <vector>
 
@@ -47,7 +49,9 @@ public:
     void checkForMultiArgOpportunities(clang::CXXMemberCallExpr *memberCall);
 private:
     bool checkQLatin1StringCase(clang::CXXMemberCallExpr *);
+    bool checkConcatenationCase(clang::CXXMemberCallExpr *);
     bool checkMultiArgWarningCase(const std::vector<clang::CallExpr *> &calls);
+    std::vector<clang::FixItHint> multiArgFixits(const std::vector<clang::CallExpr *> &calls);
     std::vector<clang::CallExpr*> m_alreadyProcessedChainedCalls;
 };
 
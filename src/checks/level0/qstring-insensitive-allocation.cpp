@@ -20,14 +20,24 @@
 */
 
 #include "qstring-insensitive-allocation.h"
+#include "ClazyContext.h"
+#include "LoopUtils.h"
+#include "StmtBodyRange.h"
+#include "TypeUtils.h"
 #include "Utils.h"
 #include "StringUtils.h"
 #include "SourceCompatibilityHelpers.h"
 #include "clazy_stl.h"
 
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
 #include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/OperationKinds.h>
 #include <clang/AST/Stmt.h>
 #include <clang/Basic/LLVM.h>
+#include <clang/Basic/OperatorKinds.h>
+#include <clang/Basic/SourceManager.h>
 #include <llvm/Support/Casting.h>
 
 #include <vector>
@@ -42,7 +52,7 @@ using namespace std;
 
 
 QStringInsensitiveAllocation::QStringInsensitiveAllocation(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
 {
 }
 
@@ -52,7 +62,7 @@ static bool isInterestingCall1(CallExpr *call)
     if (!func)
         return false;
 
-    static const vector<string> methods = { "QString::toUpper", "QString::toLower" };
+    static const vector<string> methods = { "QString::toUpper", "QString::toLower", "QByteArray::toUpper", "QByteArray::toLower" };
     return clazy::contains(methods, clazy::qualifiedMethodName(func));
 }
 
@@ -62,14 +72,153 @@ static bool isInterestingCall2(CallExpr *call)
     if (!func)
         return false;
 
+    // QByteArray has no case insensitive startsWith(), endsWith() or contains()
     static const vector<string> methods = { "QString::endsWith", "QString::startsWith",
-                                            "QString::contains", "QString::compare" };
+                                            "QString::contains", "QString::compare", "QByteArray::compare" };
     return clazy::contains(methods, clazy::qualifiedMethodName(func));
 }
 
+// The str.toLower() in expr, if it's one, looking through temporaries and copies
+static CXXMemberCallExpr *caseConversion(Expr *expr)
+{
+    while (expr) {
+        expr = expr->IgnoreImplicit();
+        auto constructExpr = dyn_cast<CXXConstructExpr>(expr);
+        if (!constructExpr || constructExpr->getNumArgs() != 1)
+            break;
+        expr = constructExpr->getArg(0);
+    }
+
+    auto call = dyn_cast_or_null<CXXMemberCallExpr>(expr);
+    return call && isInterestingCall1(call) ? call : nullptr;
+}
+
+// str.toLower() == other, or other != str.toUpper()
+static CXXMemberCallExpr *comparedCaseConversion(CXXOperatorCallExpr *op)
+{
+    if ((op->getOperator() != OO_EqualEqual && op->getOperator() != OO_ExclaimEqual) || op->getNumArgs() != 2)
+        return nullptr;
+
+    CXXMemberCallExpr *conversion = caseConversion(op->getArg(0));
+    return conversion ? conversion : caseConversion(op->getArg(1));
+}
+
+// The key of hash[key], hash.value(key) and other lookups in associative containers
+static Expr *lookupKey(CallExpr *call)
+{
+    auto method = dyn_cast_or_null<CXXMethodDecl>(call->getDirectCallee());
+    if (!method)
+        return nullptr;
+
+    static const vector<string> containers = { "QHash", "QMap", "QSet", "std::map", "std::unordered_map", "std::set", "std::unordered_set" };
+    CXXRecordDecl *record = method->getParent();
+    if (!clazy::any_of(containers, [record](const string &className) { return clazy::derivesFrom(record, className); }))
+        return nullptr;
+
+    if (auto op = dyn_cast<CXXOperatorCallExpr>(call))
+        return op->getOperator() == OO_Subscript && op->getNumArgs() == 2 ? op->getArg(1) : nullptr;
+
+    static const clazy::NameSet lookups = { "value", "contains", "find", "constFind", "count", "at" };
+    return call->getNumArgs() > 0 && lookups.contains(clazy::name(method)) ? call->getArg(0) : nullptr;
+}
+
+static bool referencesCaseFunction(Stmt *stmt)
+{
+    if (!stmt)
+        return false;
+
+    if (auto declRef = dyn_cast<DeclRefExpr>(stmt)) {
+        auto func = dyn_cast<FunctionDecl>(declRef->getDecl());
+        if (func && (clazy::name(func) == "tolower" || clazy::name(func) == "toupper"))
+            return true;
+    }
+
+    // Also look inside lambdas, like [](unsigned char c) { return std::tolower(c); }
+    return clazy::any_of(stmt->children(), [](Stmt *child) { return referencesCaseFunction(child); });
+}
+
+// The s in s.begin(), for a std::string s, looking through iterator copies
+static VarDecl *stringForBeginCall(Expr *expr)
+{
+    while (expr) {
+        expr = expr->IgnoreImplicit();
+        auto constructExpr = dyn_cast<CXXConstructExpr>(expr);
+        if (!constructExpr || constructExpr->getNumArgs() != 1)
+            break;
+        expr = constructExpr->getArg(0);
+    }
+
+    auto call = dyn_cast_or_null<CXXMemberCallExpr>(expr);
+    CXXMethodDecl *method = call ? call->getMethodDecl() : nullptr;
+    if (!method || clazy::name(method) != "begin" || !clazy::qualifiedNameIs(method->getParent(), "std::basic_string"))
+        return nullptr;
+
+    return dyn_cast_or_null<VarDecl>(Utils::valueDeclForMemberCall(call));
+}
+
+// A by-value parameter, or a local variable copy constructed from another string
+static bool isStringCopy(VarDecl *varDecl)
+{
+    if (varDecl->getType()->isReferenceType())
+        return false;
+
+    if (isa<ParmVarDecl>(varDecl))
+        return true;
+
+    auto constructExpr = varDecl->getInit() ? dyn_cast<CXXConstructExpr>(varDecl->getInit()->IgnoreImplicit()) : nullptr;
+    return constructExpr && constructExpr->getConstructor()->isCopyConstructor();
+}
+
+// std::transform(s.begin(), s.end(), s.begin(), ::tolower), with s being a copy
+static bool isStdStringCaseConversion(CallExpr *call)
+{
+    FunctionDecl *func = call->getDirectCallee();
+    if (!func || call->getNumArgs() != 4 || !clazy::qualifiedNameIs(func, "std::transform"))
+        return false;
+
+    VarDecl *varDecl = stringForBeginCall(call->getArg(0));
+    return varDecl && varDecl == stringForBeginCall(call->getArg(2)) && isStringCopy(varDecl)
+           && referencesCaseFunction(call->getArg(3));
+}
+
+// Whether key is converted from a variable which doesn't change while looping, so could be converted once before
+bool QStringInsensitiveAllocation::isLoopInvariantKey(CXXMemberCallExpr *conversion, Stmt *loop) const
+{
+    auto varDecl = dyn_cast_or_null<VarDecl>(Utils::valueDeclForMemberCall(conversion));
+    if (!varDecl || sm().isBeforeInTranslationUnit(clazy::getLocStart(loop), clazy::getLocStart(varDecl)))
+        return false;
+
+    return !Utils::containsNonConstMemberCall(m_context->parentMap, loop, varDecl)
+           && !Utils::isPassedToFunction(StmtBodyRange(loop, nullptr, {}, m_context->functionStmtIndex(loop)), varDecl, true);
+}
+
 void QStringInsensitiveAllocation::VisitStmt(clang::Stmt *stmt)
 {
-    vector<CallExpr *> calls = Utils::callListForChain(dyn_cast<CallExpr>(stmt));
+    auto call = dyn_cast<CallExpr>(stmt);
+    if (!call)
+        return;
+
+    if (auto op = dyn_cast<CXXOperatorCallExpr>(call)) {
+        if (comparedCaseConversion(op)) {
+            emitWarning(clazy::getLocStart(stmt), "unneeded allocation; use compare() with Qt::CaseInsensitive instead");
+            return;
+        }
+    }
+
+    if (Expr *key = lookupKey(call)) {
+        CXXMemberCallExpr *conversion = caseConversion(key);
+        Stmt *loop = conversion ? clazy::isInLoop(m_context, stmt) : nullptr;
+        if (loop && isLoopInvariantKey(conversion, loop))
+            emitWarning(clazy::getLocStart(conversion), "unneeded allocation on each iteration; convert the key once, before the loop");
+        return;
+    }
+
+    if (isStdStringCaseConversion(call)) {
+        emitWarning(clazy::getLocStart(stmt), "unneeded allocation; compare case insensitively without a copy, for example with std::equal() and a tolower predicate");
+        return;
+    }
+
+    vector<CallExpr *> calls = Utils::callListForChain(call);
     if (calls.size() < 2)
         return;
 
@@ -29,11 +29,13 @@
 class ClazyContext;
 
 namespace clang {
+class CXXMemberCallExpr;
 class Stmt;
 }
 
 /**
- * Finds unneeded allocations in the form of str.{toLower, toUpper}().{contains, compare, startsWith, endsWith}().
+ * Finds unneeded allocations in the form of str.{toLower, toUpper}().{contains, compare, startsWith, endsWith}(),
+ * str.toLower() == other, lookups keyed by a loop invariant str.toLower() and std::transform(tolower) on std::string copies.
  *
  * See README-qstring-insensitive-allocation for more information
  */
@@ -43,6 +45,8 @@ class QStringInsensitiveAllocation
 public:
     explicit QStringInsensitiveAllocation(const std::string &name, ClazyContext *context);
     void VisitStmt(clang::Stmt *stmt) override;
+private:
+    bool isLoopInvariantKey(clang::CXXMemberCallExpr *conversion, clang::Stmt *loop) const;
 };
 
 #endif
@@ -25,14 +25,17 @@
 #include "HierarchyUtils.h"
 #include "StringUtils.h"
 #include "FixItUtils.h"
+#include "PreProcessorVisitor.h"
 #include "SourceCompatibilityHelpers.h"
 #include "clazy_stl.h"
 
 #include <clang/Lex/Lexer.h>
+#include <clang/AST/Decl.h>
 #include <clang/AST/DeclCXX.h>
 #include <clang/AST/Expr.h>
 #include <clang/AST/ExprCXX.h>
 #include <clang/AST/Stmt.h>
+#include <clang/AST/StmtCXX.h>
 #include <clang/Basic/Diagnostic.h>
 #include <clang/Basic/IdentifierTable.h>
 #include <clang/Basic/LLVM.h>
@@ -45,7 +48,6 @@
 #include <vector>
 
 namespace clang {
-class Decl;
 class LangOptions;
 }  // namespace clang
 
@@ -54,7 +56,24 @@ using namespace std;
 
 StringRefCandidates::StringRefCandidates(const std::string &name, ClazyContext *context)
     : CheckBase(name, context, Option_CanIgnoreIncludes)
+    , m_forceQt6(isOptionSet("qt6"))
 {
+    context->enablePreprocessorVisitor();
+}
+
+bool StringRefCandidates::isQt6() const
+{
+    if (m_forceQt6)
+        return true;
+
+    PreProcessorVisitor *preProcessorVisitor = m_context->preprocessorVisitor;
+    return preProcessorVisitor && preProcessorVisitor->qtVersion() >= 60000;
+}
+
+std::string StringRefCandidates::suggestion(const std::string &methodName) const
+{
+    return isQt6() ? "Use QStringView::" + methodName + "() instead"
+                   : "Use " + methodName + "Ref() instead";
 }
 
 static bool isInterestingFirstMethod(CXXMethodDecl *method)
@@ -81,6 +100,15 @@ static bool isInterestingSecondMethod(CXXMethodDecl *method, const clang::LangOp
     return !clazy::anyArgIsOfAnySimpleType(method, {"QRegExp", "QRegularExpression"}, lo);
 }
 
+static bool isQStringRefMethod(CXXMethodDecl *method)
+{
+    if (!method || clazy::name(method->getParent()) != "QString")
+        return false;
+
+    static const llvm::SmallVector<StringRef, 3> list = {{ "leftRef", "midRef", "rightRef" }};
+    return clazy::contains(list, clazy::name(method));
+}
+
 static bool isMethodReceivingQStringRef(CXXMethodDecl *method)
 {
     if (!method || clazy::name(method->getParent()) != "QString")
@@ -101,13 +129,92 @@ void StringRefCandidates::VisitStmt(clang::Stmt *stmt)
 {
     // Here we look for code like str.firstMethod().secondMethod(), where firstMethod() is for example mid() and secondMethod is for example, toInt()
 
+    if (auto rangeLoop = dyn_cast<CXXForRangeStmt>(stmt)) {
+        if (isQt6())
+            processSplitLoop(rangeLoop);
+        return;
+    }
+
     auto call = dyn_cast<CallExpr>(stmt);
     if (!call || processCase1(dyn_cast<CXXMemberCallExpr>(call)))
         return;
 
+    if (isQt6() && processQStringRefCall(dyn_cast<CXXMemberCallExpr>(call)))
+        return;
+
     processCase2(call);
 }
 
+void StringRefCandidates::VisitDecl(clang::Decl *decl)
+{
+    // Ports "QStringRef ref = ...", as the calls initializing it are ported to QStringView
+    auto varDecl = dyn_cast<VarDecl>(decl);
+    if (!varDecl || !isQt6())
+        return;
+
+    CXXRecordDecl *record = varDecl->getType().getNonReferenceType()->getAsCXXRecordDecl();
+    if (!record || clazy::name(record) != "QStringRef")
+        return;
+
+    // Only when spelled out, "auto" follows the initializer
+    const SourceLocation typeLoc = varDecl->getTypeSpecStartLoc();
+    if (typeLoc.isInvalid() || typeLoc.isMacroID())
+        return;
+
+    const CharSourceRange typeRange = CharSourceRange::getTokenRange(typeLoc, typeLoc);
+    if (Lexer::getSourceText(typeRange, sm(), lo()) != "QStringRef")
+        return;
+
+    std::vector<FixItHint> fixits;
+    if (fixitsEnabled())
+        fixits.push_back(clazy::createReplacement({ typeLoc, typeLoc }, "QStringView"));
+
+    emitWarning(typeLoc, "QStringRef is gone in Qt 6, use QStringView instead", fixits);
+}
+
+// Catches cases like: s.midRef(1, 1), which doesn't build with Qt 6
+bool StringRefCandidates::processQStringRefCall(CXXMemberCallExpr *memberCall)
+{
+    if (!memberCall || !isQStringRefMethod(memberCall->getMethodDecl()))
+        return false;
+
+    const string methodName = clazy::name(memberCall->getMethodDecl()).drop_back(3).str();
+    std::vector<FixItHint> fixits;
+    if (fixitsEnabled())
+        fixits = fixitQt6(memberCall);
+
+    emitWarning(clazy::getLocEnd(memberCall), "QStringRef is gone in Qt 6, use QStringView::" + methodName + "() instead", fixits);
+    return true;
+}
+
+// Catches cases like: for (QStringView part : s.split(QLatin1Char(','))), which allocates a list and a string per part
+void StringRefCandidates::processSplitLoop(CXXForRangeStmt *rangeLoop)
+{
+    Expr *rangeInit = rangeLoop->getRangeInit();
+    auto splitCall = rangeInit ? dyn_cast<CXXMemberCallExpr>(rangeInit->IgnoreImplicit()) : nullptr;
+    CXXMethodDecl *method = splitCall ? splitCall->getMethodDecl() : nullptr;
+    if (!method || clazy::name(method->getParent()) != "QString" || clazy::name(method) != "split")
+        return;
+
+    // tokenize() only takes strings and characters
+    if (clazy::anyArgIsOfAnySimpleType(method, {"QRegExp", "QRegularExpression"}, lo()))
+        return;
+
+    // The parts are QStringViews now, anything else would need porting the loop's body
+    VarDecl *loopVariable = rangeLoop->getLoopVariable();
+    CXXRecordDecl *record = loopVariable ? loopVariable->getType().getNonReferenceType()->getAsCXXRecordDecl() : nullptr;
+    const bool isView = record && clazy::name(record) == "QStringView";
+
+    auto memberExpr = dyn_cast<MemberExpr>(splitCall->getCallee());
+    std::vector<FixItHint> fixits;
+    if (fixitsEnabled() && isView && memberExpr && !memberExpr->getMemberLoc().isMacroID())
+        fixits.push_back(clazy::createReplacement({ memberExpr->getMemberLoc(), memberExpr->getMemberLoc() }, "tokenize"));
+
+    emitWarning(clazy::getLocEnd(splitCall), isView ? "Use tokenize() instead of split(), to iterate without allocating"
+                                                    : "Use tokenize() instead of split(), with a QStringView loop variable, to iterate without allocating",
+                fixits);
+}
+
 static bool containsChild(Stmt *s, Stmt *target)
 {
     if (!s)
@@ -141,7 +248,7 @@ bool StringRefCandidates::isConvertedToSomethingElse(clang::Stmt* s) const
     if (containsChild(constr->getArg(0), s)) {
         CXXConstructorDecl *ctor = constr->getConstructor();
         CXXRecordDecl *record = ctor ? ctor->getParent() : nullptr;
-        return record ? record->getQualifiedNameAsString() != "QString" : false;
+        return record ? !clazy::qualifiedNameIs(record, "QString") : false;
 
     }
 
@@ -176,9 +283,9 @@ bool StringRefCandidates::processCase1(CXXMemberCallExpr *memberCall)
     const string firstMethodName = firstMemberCall->getMethodDecl()->getNameAsString();
     std::vector<FixItHint> fixits;
     if (fixitsEnabled())
-        fixits = fixit(firstMemberCall);
+        fixits = isQt6() ? fixitQt6(firstMemberCall) : fixit(firstMemberCall);
 
-    emitWarning(clazy::getLocEnd(firstMemberCall), "Use " + firstMethodName + "Ref() instead", fixits);
+    emitWarning(clazy::getLocEnd(firstMemberCall), suggestion(firstMethodName), fixits);
     return true;
 }
 
@@ -219,10 +326,10 @@ bool StringRefCandidates::processCase2(CallExpr *call)
 
     std::vector<FixItHint> fixits;
     if (fixitsEnabled()) {
-        fixits = fixit(innerMemberCall);
+        fixits = isQt6() ? fixitQt6(innerMemberCall) : fixit(innerMemberCall);
     }
 
-    emitWarning(clazy::getLocStart(call), "Use " + innerMethod->getNameAsString() + "Ref() instead", fixits);
+    emitWarning(clazy::getLocStart(call), suggestion(innerMethod->getNameAsString()), fixits);
     return true;
 }
 
@@ -246,3 +353,36 @@ std::vector<FixItHint> StringRefCandidates::fixit(CXXMemberCallExpr *call)
     return fixits;
 
 }
+
+// Rewrites s.mid(1) and s.midRef(1) into QStringView(s).mid(1)
+std::vector<FixItHint> StringRefCandidates::fixitQt6(CXXMemberCallExpr *call)
+{
+    auto memberExpr = dyn_cast<MemberExpr>(call->getCallee());
+    Expr *object = memberExpr ? memberExpr->getBase() : nullptr;
+    if (!object || memberExpr->isImplicitAccess()) {
+        queueManualFixitWarning(clazy::getLocStart(call), "Internal error 1");
+        return {};
+    }
+
+    const SourceLocation objectStart = clazy::getLocStart(object);
+    const SourceLocation objectEnd = Lexer::getLocForEndOfToken(clazy::getLocEnd(object), 0, sm(), lo());
+    if (objectStart.isMacroID() || !objectEnd.isValid() || memberExpr->getMemberLoc().isMacroID()) {
+        queueManualFixitWarning(clazy::getLocStart(call), "Internal error 2");
+        return {};
+    }
+
+    std::vector<FixItHint> fixits;
+    if (memberExpr->isArrow()) {
+        fixits.push_back(clazy::createInsertion(objectStart, "QStringView(*"));
+        fixits.push_back(clazy::createInsertion(objectEnd, ")"));
+        fixits.push_back(clazy::createReplacement({ memberExpr->getOperatorLoc(), memberExpr->getOperatorLoc() }, "."));
+    } else {
+        clazy::insertParentMethodCall("QStringView", { objectStart, objectEnd }, fixits);
+    }
+
+    const StringRef methodName = clazy::name(call->getMethodDecl());
+    if (methodName.endswith("Ref"))
+        fixits.push_back(clazy::createReplacement({ memberExpr->getMemberLoc(), memberExpr->getMemberLoc() }, methodName.drop_back(3).str()));
+
+    return fixits;
+}
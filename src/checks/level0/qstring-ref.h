@@ -31,7 +31,9 @@ class ClazyContext;
 
 namespace clang {
 class Stmt;
+class Decl;
 class CallExpr;
+class CXXForRangeStmt;
 class CXXMemberCallExpr;
 class FixItHint;
 }
@@ -39,6 +41,9 @@ class FixItHint;
 /**
  * Finds places where the QString::fooRef() should be used instead QString::foo(), to save allocations
  *
+ * With Qt 6, or the qt6 option when preparing a port, suggests QStringView and QString::tokenize() instead,
+ * and ports the existing QStringRef usage, as QStringRef is gone.
+ *
  * See README-qstringref for more info.
  */
 class StringRefCandidates
@@ -47,13 +52,20 @@ class StringRefCandidates
 public:
     StringRefCandidates(const std::string &name, ClazyContext *context);
     void VisitStmt(clang::Stmt *stmt) override;
+    void VisitDecl(clang::Decl *decl) override;
 private:
     bool processCase1(clang::CXXMemberCallExpr*);
     bool processCase2(clang::CallExpr *call);
+    bool processQStringRefCall(clang::CXXMemberCallExpr *memberCall);
+    void processSplitLoop(clang::CXXForRangeStmt *rangeLoop);
     bool isConvertedToSomethingElse(clang::Stmt* s) const;
+    bool isQt6() const;
+    std::string suggestion(const std::string &methodName) const;
 
     std::vector<clang::CallExpr*> m_alreadyProcessedChainedCalls;
     std::vector<clang::FixItHint> fixit(clang::CXXMemberCallExpr*);
+    std::vector<clang::FixItHint> fixitQt6(clang::CXXMemberCallExpr*);
+    const bool m_forceQt6;
 };
 
 #endif
@@ -34,7 +34,7 @@ using namespace std;
 QtMacros::QtMacros(const std::string &name, ClazyContext *context)
     : CheckBase(name, context)
 {
-    enablePreProcessorCallbacks();
+    enablePreProcessorCallbacks(PreprocessorEvent_MacroDefined | PreprocessorEvent_Defined | PreprocessorEvent_Ifdef);
     context->enablePreprocessorVisitor();
 }
 
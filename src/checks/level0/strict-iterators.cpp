@@ -21,6 +21,7 @@
 
 #include "strict-iterators.h"
 #include "ClazyContext.h"
+#include "QtRegistry.h"
 #include "QtUtils.h"
 #include "StringUtils.h"
 #include "TypeUtils.h"
@@ -61,7 +62,7 @@ static bool isMemberVariable(Expr *expr)
 // QVector::iterator isn't even a class, it's a typedef.
 
 StrictIterators::StrictIterators(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
 {
 }
 
@@ -80,15 +81,16 @@ bool StrictIterators::handleImplicitCast(ImplicitCastExpr *implicitCast)
     if (!implicitCast)
         return false;
 
-    const string nameTo = clazy::simpleTypeName(implicitCast->getType(), m_context->ci.getLangOpts());
+    const string nameTo = clazy::simpleTypeName(implicitCast->getType(), m_context->pp.getLangOpts());
 
+    const QtRegistry &qtRegistry = m_context->qtRegistry();
     const QualType typeTo = implicitCast->getType();
     CXXRecordDecl *recordTo = clazy::parentRecordForTypedef(typeTo);
-    if (recordTo && !clazy::isQtCOWIterableClass(recordTo))
+    if (recordTo && !qtRegistry.isQtCOWIterableClass(recordTo))
         return false;
 
     recordTo = clazy::typeAsRecord(typeTo);
-    if (recordTo && !clazy::isQtCOWIterator(recordTo))
+    if (recordTo && !qtRegistry.isQtCOWIterator(recordTo))
         return false;
 
     assert(implicitCast->getSubExpr());
@@ -100,7 +102,7 @@ bool StrictIterators::handleImplicitCast(ImplicitCastExpr *implicitCast)
 
     QualType typeFrom = implicitCast->getSubExpr()->getType();
     CXXRecordDecl *recordFrom = clazy::parentRecordForTypedef(typeFrom);
-    if (recordFrom && !clazy::isQtCOWIterableClass(recordFrom))
+    if (recordFrom && !qtRegistry.isQtCOWIterableClass(recordFrom))
         return false;
 
     // const_iterator might be a typedef to pointer, like const T *, instead of a class, so just check for const qualification in that case
@@ -117,7 +119,7 @@ bool StrictIterators::handleImplicitCast(ImplicitCastExpr *implicitCast)
     if (nameToIsIterator)
         return false;
 
-    const string nameFrom = clazy::simpleTypeName(typeFrom, m_context->ci.getLangOpts());
+    const string nameFrom = clazy::simpleTypeName(typeFrom, m_context->pp.getLangOpts());
     const bool nameFromIsIterator = nameFrom == "iterator" || clazy::endsWith(nameFrom, "::iterator");
     if (!nameFromIsIterator)
         return false;
@@ -142,7 +144,7 @@ bool StrictIterators::handleOperator(CXXOperatorCallExpr *op)
         return false;
 
     CXXRecordDecl *record = method->getParent();
-    if (!clazy::isQtCOWIterator(record))
+    if (!m_context->qtRegistry().isQtCOWIterator(record))
         return false;
 
     if (clazy::name(record) != "iterator")
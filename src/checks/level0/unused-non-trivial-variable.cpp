@@ -20,8 +20,10 @@
 */
 
 #include "unused-non-trivial-variable.h"
+#include "ClazyContext.h"
 #include "StringUtils.h"
 #include "HierarchyUtils.h"
+#include "StmtIndex.h"
 #include "ContextUtils.h"
 #include "QtUtils.h"
 #include "clazy_stl.h"
@@ -161,12 +163,21 @@ void UnusedNonTrivialVariable::handleVarDecl(VarDecl *varDecl)
 
     SourceLocation locStart = clazy::getLocStart(varDecl);
     locStart = sm().getExpansionLoc(locStart);
-    auto declRefs = clazy::getStatements<DeclRefExpr>(body, &sm(), locStart);
 
-    auto pred = [varDecl] (DeclRefExpr *declRef) {
-        return declRef->getDecl() == varDecl;
-    };
+    bool isUsed = false;
+    if (const StmtIndex *index = m_context->functionStmtIndex(body)) {
+        // Only look at the references to varDecl, instead of at every DeclRefExpr in the function
+        const SourceLocation spellingStart = sm().getSpellingLoc(locStart);
+        isUsed = clazy::any_of(index->usesOf(varDecl, body, /*includeSelf=*/ false), [this, spellingStart] (const StmtIndex::DeclUse &use) {
+            return use.kind == StmtIndex::DeclUse_Referenced && sm().isBeforeInSLocAddrSpace(spellingStart, clazy::getLocStart(use.stmt));
+        });
+    } else {
+        auto declRefs = clazy::getStatements<DeclRefExpr>(body, &sm(), locStart);
+        isUsed = clazy::any_of(declRefs, [varDecl] (DeclRefExpr *declRef) {
+            return declRef->getDecl() == varDecl;
+        });
+    }
 
-    if (!clazy::any_of(declRefs, pred))
-        emitWarning(locStart, "unused " + clazy::simpleTypeName(varDecl->getType(), lo()));
+    if (!isUsed)
+        emitFormattedWarning(locStart, "unused %0", { clazy::simpleTypeName(varDecl->getType(), lo()) });
 }
@@ -114,7 +114,7 @@ enum QtUnregularlyNamedEventTypes {
 
 
 WrongQEventCast::WrongQEventCast(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context)
+    : CheckBase(name, context, Option_Reusable)
 {
 
 
@@ -44,7 +44,7 @@ using namespace std;
 
 
 WrongQGlobalStatic::WrongQGlobalStatic(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context)
+    : CheckBase(name, context, Option_Reusable)
 {
 }
 
@@ -59,7 +59,7 @@ void WrongQGlobalStatic::VisitStmt(clang::Stmt *stmt)
         return;
 
     SourceLocation loc = clazy::getLocStart(stmt);
-    if (clazy::isInMacro(&m_astContext, loc, "Q_GLOBAL_STATIC_WITH_ARGS"))
+    if (clazy::isInMacro(m_astContext, loc, "Q_GLOBAL_STATIC_WITH_ARGS"))
         return;
 
     CXXRecordDecl *record = ctorDecl->getParent();
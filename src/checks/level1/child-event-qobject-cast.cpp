@@ -44,7 +44,7 @@ using namespace std;
 
 
 ChildEventQObjectCast::ChildEventQObjectCast(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
 {
 }
 
@@ -58,8 +58,8 @@ void ChildEventQObjectCast::VisitDecl(Decl *decl)
     if (!body)
         return;
 
-    auto methodName = childEventMethod->getNameAsString();
-    if (!clazy::equalsAny(methodName, {"event", "childEvent", "eventFilter"}))
+    static const clazy::NameSet eventMethods = { "event", "childEvent", "eventFilter" };
+    if (!clazy::functionIsOneOf(childEventMethod, eventMethods))
         return;
 
     if (!clazy::isQObject(childEventMethod->getParent()))
@@ -80,7 +80,7 @@ void ChildEventQObjectCast::VisitDecl(Decl *decl)
                 continue;
 
             auto childFDecl = childCall->getDirectCallee();
-            if (!childFDecl || childFDecl->getQualifiedNameAsString() != "QChildEvent::child")
+            if (!childFDecl || !clazy::qualifiedNameIs(childFDecl, "QChildEvent::child"))
                 continue;
 
             emitWarning(childCall, "qobject_cast in childEvent");
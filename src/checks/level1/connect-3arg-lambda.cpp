@@ -41,7 +41,7 @@ using namespace std;
 using uint = unsigned;
 
 Connect3ArgLambda::Connect3ArgLambda(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
 {
 }
 
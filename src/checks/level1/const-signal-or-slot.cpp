@@ -70,7 +70,7 @@ void ConstSignalOrSlot::VisitStmt(clang::Stmt *stmt)
     // Here the user is connecting to a const method, which isn't marked as slot or signal and returns non-void
     // Looks like a getter!
 
-    emitWarning(stmt, slot->getQualifiedNameAsString() + " is not a slot, and is possibly a getter");
+    emitFormattedWarning(clazy::getLocStart(stmt), "%0 is not a slot, and is possibly a getter", { slot->getQualifiedNameAsString() });
 }
 
 void ConstSignalOrSlot::VisitDecl(Decl *decl)
@@ -102,8 +102,8 @@ void ConstSignalOrSlot::VisitDecl(Decl *decl)
         return;
 
     if (isSlot && !method->getReturnType()->isVoidType()) {
-        emitWarning(decl, "getter " + method->getQualifiedNameAsString() + " possibly mismarked as a slot");
+        emitFormattedWarning(clazy::getLocStart(decl), "getter %0 possibly mismarked as a slot", { method->getQualifiedNameAsString() });
     } else if (isSignal) {
-        emitWarning(decl, "signal " + method->getQualifiedNameAsString() + " shouldn't be const");
+        emitFormattedWarning(clazy::getLocStart(decl), "signal %0 shouldn't be const", { method->getQualifiedNameAsString() });
     }
 }
@@ -24,6 +24,8 @@
 
 
 #include "detaching-temporary.h"
+#include "ClazyContext.h"
+#include "QtRegistry.h"
 #include "Utils.h"
 #include "StringUtils.h"
 #include "QtUtils.h"
@@ -39,7 +41,6 @@
 #include <clang/Basic/LLVM.h>
 #include <llvm/Support/Casting.h>
 
-#include <unordered_map>
 #include <utility>
 
 class ClazyContext;
@@ -139,27 +140,15 @@ void DetachingTemporary::VisitStmt(clang::Stmt *stm)
     CXXRecordDecl *classDecl = detachingMethod->getParent();
     StringRef className = clazy::name(classDecl);
 
-    const std::unordered_map<string, std::vector<StringRef>> &methodsByType = clazy::detachingMethods();
-    auto it = methodsByType.find(className);
-    auto it2 = m_writeMethodsByType.find(className);
-
-    std::vector<StringRef> allowedFunctions;
-    std::vector<StringRef> allowedWriteFunctions;
-    if (it != methodsByType.end()) {
-        allowedFunctions = it->second;
-    }
-
-    if (it2 != m_writeMethodsByType.end()) {
-        allowedWriteFunctions = it2->second;
-    }
+    auto it = m_writeMethodsByType.find(className);
 
     // Check if it's one of the detaching methods
     StringRef functionName = clazy::name(detachingMethod);
 
     string error;
 
-    const bool isReadFunction = clazy::contains(allowedFunctions, functionName);
-    const bool isWriteFunction = clazy::contains(allowedWriteFunctions, functionName);
+    const bool isReadFunction = m_context->qtRegistry().isDetachingMethod(classDecl, detachingMethod->getDeclName());
+    const bool isWriteFunction = it != m_writeMethodsByType.end() && clazy::contains(it->second, functionName);
 
     if (isReadFunction || isWriteFunction) {
         bool returnTypeIsIterator = false;
@@ -24,9 +24,13 @@
 
 #include "foreach.h"
 #include "ClazyContext.h"
+#include "FixItUtils.h"
+#include "StmtBodyRange.h"
+#include "StmtIndex.h"
 #include "Utils.h"
 #include "HierarchyUtils.h"
 #include "QtUtils.h"
+#include "QtRegistry.h"
 #include "TypeUtils.h"
 #include "PreProcessorVisitor.h"
 #include "StringUtils.h"
@@ -40,10 +44,12 @@
 #include <clang/AST/Stmt.h>
 #include <clang/AST/Type.h>
 #include <clang/Basic/LLVM.h>
+#include <clang/Basic/SourceManager.h>
+#include <clang/Lex/Lexer.h>
 #include <llvm/ADT/StringRef.h>
 #include <llvm/Support/Casting.h>
 
-#include <unordered_map>
+#include <algorithm>
 #include <vector>
 
 namespace clang {
@@ -56,12 +62,19 @@ using namespace std;
 
 Foreach::Foreach(const std::string &name, ClazyContext *context)
     : CheckBase(name, context, Option_CanIgnoreIncludes)
+    , m_portToRangeFor(isOptionSet("port-to-range-for"))
 {
     context->enablePreprocessorVisitor();
 }
 
 void Foreach::VisitStmt(clang::Stmt *stmt)
 {
+    if (m_portToRangeFor) {
+        // Works with any Qt version, unlike the checks below
+        if (auto forStmt = dyn_cast<ForStmt>(stmt))
+            checkPortToRangeFor(forStmt);
+    }
+
     PreProcessorVisitor *preProcessorVisitor = m_context->preprocessorVisitor;
     if (!preProcessorVisitor || preProcessorVisitor->qtVersion() >= 50900) {
         // Disabled since 5.9 because the Q_FOREACH internals changed.
@@ -191,12 +204,10 @@ bool Foreach::containsDetachments(Stmt *stm, clang::ValueDecl *containerValueDec
             DeclContext *declContext = valDecl->getDeclContext();
             auto recordDecl = dyn_cast<CXXRecordDecl>(declContext);
             if (recordDecl) {
-                const std::string className = Utils::rootBaseClass(recordDecl)->getQualifiedNameAsString();
-                const std::unordered_map<string, std::vector<StringRef>> &detachingMethodsMap = clazy::detachingMethods();
-                if (detachingMethodsMap.find(className) != detachingMethodsMap.end()) {
-                    const std::string functionName = valDecl->getNameAsString();
-                    const auto &allowedFunctions = detachingMethodsMap.at(className);
-                    if (clazy::contains(allowedFunctions, functionName)) {
+                CXXRecordDecl *rootClass = Utils::rootBaseClass(recordDecl);
+                // Only Qt's own classes, not ones in a namespace which happen to have the same name
+                if (rootClass->getDeclContext()->getRedeclContext()->isTranslationUnit()) {
+                    if (m_context->qtRegistry().isDetachingMethod(rootClass, valDecl->getDeclName())) {
                         Expr *expr = memberExpr->getBase();
 
                         if (expr) {
@@ -221,3 +232,190 @@ bool Foreach::containsDetachments(Stmt *stm, clang::ValueDecl *containerValueDec
         return this->containsDetachments(child, containerValueDecl);
     });
 }
+
+// Returns the container passed to Q_FOREACH, or nullptr if forStmt isn't the outer loop of a Q_FOREACH.
+// Qt < 5.9 constructs a QForeachContainer from it, newer versions call qMakeForeachContainer()
+static Expr *foreachContainerExpr(ForStmt *forStmt)
+{
+    auto declStmt = dyn_cast_or_null<DeclStmt>(forStmt->getInit());
+    auto varDecl = declStmt && declStmt->isSingleDecl() ? dyn_cast<VarDecl>(declStmt->getSingleDecl()) : nullptr;
+    Expr *init = varDecl ? varDecl->getInit() : nullptr;
+    while (init) {
+        init = init->IgnoreImplicit();
+        if (auto callExpr = dyn_cast<CallExpr>(init)) {
+            FunctionDecl *func = callExpr->getDirectCallee();
+            const bool isMakeContainer = func && clazy::name(func) == "qMakeForeachContainer" && callExpr->getNumArgs() == 1;
+            return isMakeContainer ? callExpr->getArg(0) : nullptr;
+        }
+
+        auto constructExpr = dyn_cast<CXXConstructExpr>(init);
+        CXXConstructorDecl *ctor = constructExpr ? constructExpr->getConstructor() : nullptr;
+        if (!ctor || constructExpr->getNumArgs() < 1 || clazy::name(ctor) != "QForeachContainer")
+            return nullptr;
+
+        // The copy of qMakeForeachContainer()'s result isn't elided before C++17
+        init = constructExpr->getArg(0);
+        if (!ctor->isCopyOrMoveConstructor())
+            return init;
+    }
+
+    return nullptr;
+}
+
+// Returns true for Q_FOREACH (const QString &s, list), false for Q_FOREACH (s, list), which reuses a variable
+static bool declaresLoopVariable(ForStmt *forStmt)
+{
+    Stmt *inner = forStmt->getBody();
+    if (auto innerFor = dyn_cast_or_null<ForStmt>(inner))
+        return dyn_cast_or_null<DeclStmt>(innerFor->getInit()) != nullptr;
+
+    // Qt 6 with C++17: if (variable = *_container_.i; false) {} else
+    if (auto ifStmt = dyn_cast_or_null<IfStmt>(inner))
+        return dyn_cast_or_null<DeclStmt>(ifStmt->getInit()) != nullptr;
+
+    return false;
+}
+
+// Splits "foreach (const QString &s, list)" into "const QString &s" and "list"
+static bool parseForeachMacro(StringRef text, string &variable, string &container)
+{
+    const size_t open = text.find('(');
+    if (open == StringRef::npos || !text.endswith(")"))
+        return false;
+
+    const StringRef macroName = text.substr(0, open).trim();
+    if (macroName != "foreach" && macroName != "Q_FOREACH")
+        return false;
+
+    // Like the preprocessor, only parentheses protect commas
+    const StringRef args = text.slice(open + 1, text.size() - 1);
+    int depth = 0;
+    char quote = 0;
+    for (size_t i = 0; i < args.size(); ++i) {
+        const char c = args[i];
+        if (quote) {
+            if (c == '\\')
+                ++i;
+            else if (c == quote)
+                quote = 0;
+        } else if (c == '"' || c == '\'') {
+            quote = c;
+        } else if (c == '(') {
+            ++depth;
+        } else if (c == ')') {
+            --depth;
+        } else if (c == ',' && depth == 0) {
+            variable = args.substr(0, i).trim().str();
+            container = args.substr(i + 1).trim().str();
+            return !variable.empty() && !container.empty();
+        }
+    }
+
+    return false;
+}
+
+// Returns true if the statement is directly inside a block, so a declaration can be inserted before it
+static bool isInCompoundStmt(const StmtIndex *index, Stmt *stmt)
+{
+    return clazy::any_of(index->statementsOfType<CompoundStmt>(index->root()), [stmt](CompoundStmt *compound) {
+        return std::find(compound->body_begin(), compound->body_end(), stmt) != compound->body_end();
+    });
+}
+
+std::string Foreach::asConstFunction() const
+{
+    if (clazy::isCPlusPlus17(lo()))
+        return "std::as_const";
+
+    PreProcessorVisitor *preProcessorVisitor = m_context->preprocessorVisitor;
+    if (preProcessorVisitor && preProcessorVisitor->qtVersion() >= 50700)
+        return "qAsConst";
+
+    return {};
+}
+
+// Returns a name for the const copy of a temporary container that doesn't clash with, or shadow, anything the function uses
+std::string Foreach::unusedVariableName(const StmtIndex *index) const
+{
+    vector<string> usedNames;
+    if (FunctionDecl *func = m_context->lastFunctionDecl) {
+        for (ParmVarDecl *param : func->parameters())
+            usedNames.push_back(param->getNameAsString());
+    }
+
+    for (DeclRefExpr *declRef : index->statementsOfType<DeclRefExpr>(index->root()))
+        usedNames.push_back(declRef->getDecl()->getNameAsString());
+    for (MemberExpr *memberExpr : index->statementsOfType<MemberExpr>(index->root()))
+        usedNames.push_back(memberExpr->getMemberDecl()->getNameAsString());
+    for (DeclStmt *declStmt : index->statementsOfType<DeclStmt>(index->root())) {
+        for (Decl *decl : declStmt->decls()) {
+            if (auto namedDecl = dyn_cast<NamedDecl>(decl))
+                usedNames.push_back(namedDecl->getNameAsString());
+        }
+    }
+
+    string name = "container";
+    for (int i = 2; clazy::contains(usedNames, name); ++i)
+        name = "container" + std::to_string(i);
+
+    return name;
+}
+
+void Foreach::checkPortToRangeFor(ForStmt *forStmt)
+{
+    Expr *containerExpr = foreachContainerExpr(forStmt);
+    Stmt *body = forStmt->getBody();
+    if (!containerExpr || !body || !declaresLoopVariable(forStmt))
+        return;
+
+    const StmtIndex *index = m_context->functionStmtIndex(forStmt);
+    Expr *container = containerExpr->IgnoreParenImpCasts();
+    const bool isTemporary = !container->isGLValue();
+    auto declRef = dyn_cast<DeclRefExpr>(container);
+    auto varDecl = declRef ? dyn_cast<VarDecl>(declRef->getDecl()) : nullptr;
+    const bool isLocal = varDecl && varDecl->hasLocalStorage();
+    if (isLocal) {
+        // The copy is needed if the body modifies the container
+        if (Utils::containsNonConstMemberCall(m_context->parentMap, body, varDecl)
+            || Utils::isPassedToFunction(StmtBodyRange(body, &sm(), {}, index), varDecl, /*byRefOrPtrOnly=*/ true)
+            || Utils::addressIsTaken(body, varDecl, index)
+            || Utils::isCapturedByReference(body, varDecl, index) || Utils::isBoundToReference(body, varDecl, index))
+            return;
+    }
+
+    const QualType containerType = container->getType();
+    CXXRecordDecl *record = containerType->getAsCXXRecordDecl();
+    const bool isImplicitlyShared = record && clazy::isQtCOWIterableClass(Utils::rootBaseClass(record));
+    const bool needsAsConst = isImplicitlyShared && !containerType.isConstQualified();
+    const string asConst = asConstFunction();
+
+    const SourceLocation loc = clazy::getLocStart(forStmt);
+    const CharSourceRange macroRange = clazy::getExpansionRange(loc, sm());
+    const SourceRange range(macroRange.getBegin(), macroRange.getEnd());
+    const StringRef text = Lexer::getSourceText(CharSourceRange::getTokenRange(range), sm(), lo());
+    string variable, containerText;
+    const bool canFix = (isLocal || isTemporary) && (!needsAsConst || !asConst.empty()) && parseForeachMacro(text, variable, containerText);
+    if (!canFix) {
+        emitWarning(loc, "Q_FOREACH copies the container, use a range-for loop over std::as_const() if the loop doesn't modify it");
+        return;
+    }
+
+    string replacement;
+    if (isTemporary && needsAsConst) {
+        // A non-const temporary would detach when iterated, so make it a const variable first
+        if (!index || !isInCompoundStmt(index, forStmt)) {
+            emitWarning(loc, "Q_FOREACH copies the container, store it in a const variable and use a range-for loop instead");
+            return;
+        }
+
+        const string name = unusedVariableName(index);
+        replacement = "const auto " + name + " = " + containerText + ";\n" + Lexer::getIndentationForLine(range.getBegin(), sm()).str()
+                      + "for (" + variable + " : " + name + ")";
+    } else if (needsAsConst) {
+        replacement = "for (" + variable + " : " + asConst + "(" + containerText + "))";
+    } else {
+        replacement = "for (" + variable + " : " + containerText + ")";
+    }
+
+    emitWarning(loc, "Q_FOREACH copies the container, use a range-for loop instead", { clazy::createReplacement(range, replacement) });
+}
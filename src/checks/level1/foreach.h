@@ -30,6 +30,7 @@
 #include <string>
 
 class ClazyContext;
+class StmtIndex;
 
 namespace clang {
 class ForStmt;
@@ -43,6 +44,7 @@ class CXXForRangeStmt;
  *   - Finds places where you're detaching the foreach container.
  *   - Finds places where big or non-trivial types are passed by value instead of const-ref.
  *   - Finds places where you're using foreach on STL containers. It causes deep-copy.
+ *   - With the port-to-range-for option, suggests range-loops over std::as_const() instead.
  * - For Range Loops:
  *   - Finds places where you're using C++11 for range loops with Qt containers. (potential detach)
  */
@@ -55,7 +57,11 @@ public:
 private:
     void checkBigTypeMissingRef();
     bool containsDetachments(clang::Stmt *stmt, clang::ValueDecl *containerValueDecl);
+    void checkPortToRangeFor(clang::ForStmt *forStmt);
+    std::string asConstFunction() const;
+    std::string unusedVariableName(const StmtIndex *index) const;
     clang::ForStmt *m_lastForStmt = nullptr;
+    const bool m_portToRangeFor;
 };
 
 #endif
@@ -50,7 +50,7 @@ IncorrectEmit::IncorrectEmit(const std::string &name, ClazyContext *context)
     : CheckBase(name, context, Option_CanIgnoreIncludes)
 {
     context->enableAccessSpecifierManager();
-    enablePreProcessorCallbacks();
+    enablePreProcessorCallbacks(PreprocessorEvent_MacroExpands, { "emit", "Q_EMIT" });
     m_emitLocations.reserve(30); // bootstrap it
     m_filesToIgnore = { "moc_", ".moc" };
 }
@@ -76,10 +76,10 @@ void IncorrectEmit::VisitStmt(Stmt *stmt)
     if (shouldIgnoreFile(clazy::getLocStart(stmt)))
         return;
 
-    if (Stmt *parent = clazy::parent(m_context->parentMap, methodCall)) {
+    if (Stmt *parent = clazy::parent(m_context, methodCall)) {
         // Check if we're inside a chained call, such as: emit d_func()->mySignal()
         // We're not interested in the d_func() call, so skip it
-        if (clazy::getFirstParentOfType<CXXMemberCallExpr>(m_context->parentMap, parent))
+        if (clazy::getFirstParentOfType<CXXMemberCallExpr>(m_context, parent))
             return;
     }
 
@@ -91,9 +91,9 @@ void IncorrectEmit::VisitStmt(Stmt *stmt)
     const string methodName = method->getQualifiedNameAsString();
     const bool isSignal = type == QtAccessSpecifier_Signal;
     if (isSignal && !hasEmit) {
-        emitWarning(stmt, "Missing emit keyword on signal call " + methodName);
+        emitFormattedWarning(clazy::getLocStart(stmt), "Missing emit keyword on signal call %0", { methodName });
     } else if (!isSignal && hasEmit) {
-        emitWarning(stmt, "Emit keyword being used with non-signal " + methodName);
+        emitFormattedWarning(clazy::getLocStart(stmt), "Emit keyword being used with non-signal %0", { methodName });
     }
 
     if (isSignal)
@@ -113,7 +113,7 @@ void IncorrectEmit::checkCallSignalInsideCTOR(CXXMemberCallExpr *callExpr)
     if (!implicitArg || !isa<CXXThisExpr>(implicitArg)) // emit other->sig() is ok
         return;
 
-    if (clazy::getFirstParentOfType<LambdaExpr>(m_context->parentMap, callExpr) != nullptr)
+    if (clazy::getFirstParentOfType<LambdaExpr>(m_context, callExpr) != nullptr)
         return; // Emit is inside a lambda, it's fine
 
     emitWarning(clazy::getLocStart(callExpr), "Emitting inside constructor probably has no effect");
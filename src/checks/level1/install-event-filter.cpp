@@ -22,6 +22,7 @@
 #include "install-event-filter.h"
 #include "Utils.h"
 #include "HierarchyUtils.h"
+#include "StringUtils.h"
 #include "TypeUtils.h"
 
 #include <clang/AST/Decl.h>
@@ -41,7 +42,7 @@ using namespace std;
 
 
 InstallEventFilter::InstallEventFilter(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
 {
 }
 
@@ -52,7 +53,7 @@ void InstallEventFilter::VisitStmt(clang::Stmt *stmt)
         return;
 
     FunctionDecl *func = memberCallExpr->getDirectCallee();
-    if (!func || func->getQualifiedNameAsString() != "QObject::installEventFilter")
+    if (!func || !clazy::qualifiedNameIs(func, "QObject::installEventFilter"))
         return;
 
     Expr *expr = memberCallExpr->getImplicitObjectArgument();
@@ -69,7 +70,7 @@ void InstallEventFilter::VisitStmt(clang::Stmt *stmt)
     auto methods = Utils::methodsFromString(record, "eventFilter");
 
     for (auto method : methods) {
-        if (method->getQualifiedNameAsString() != "QObject::eventFilter") // It overrides it, probably on purpose then, don't warn.
+        if (!clazy::qualifiedNameIs(method, "QObject::eventFilter")) // It overrides it, probably on purpose then, don't warn.
             return;
     }
 
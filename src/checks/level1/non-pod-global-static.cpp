@@ -25,26 +25,112 @@
 #include "non-pod-global-static.h"
 #include "QtUtils.h"
 #include "ClazyContext.h"
+#include "FixItUtils.h"
+#include "StringUtils.h"
 #include "SourceCompatibilityHelpers.h"
 #include "clazy_stl.h"
 
 #include <clang/AST/DeclCXX.h>
+#include <clang/AST/RecursiveASTVisitor.h>
 #include <clang/Lex/Lexer.h>
+#include <clang/Lex/Preprocessor.h>
+#include <clang/AST/ASTContext.h>
 #include <clang/AST/Decl.h>
+#include <clang/AST/Expr.h>
 #include <clang/AST/ExprCXX.h>
 #include <clang/AST/Stmt.h>
 #include <clang/Basic/LLVM.h>
 #include <clang/Basic/SourceLocation.h>
+#include <clang/Basic/SourceManager.h>
 #include <clang/Basic/Specifiers.h>
 #include <clang/Frontend/CompilerInstance.h>
+#include <llvm/ADT/SmallPtrSet.h>
 #include <llvm/ADT/StringRef.h>
 #include <llvm/Support/Casting.h>
 
+#include <algorithm>
+#include <cctype>
 #include <vector>
 
 using namespace clang;
 using namespace std;
 
+namespace {
+
+// Finds the uses of a global static in the main file, which need to dereference it once it's a Q_GLOBAL_STATIC
+class GlobalStaticUsesVisitor
+    : public RecursiveASTVisitor<GlobalStaticUsesVisitor>
+{
+public:
+    GlobalStaticUsesVisitor(const SourceManager &sm, VarDecl *varDecl)
+        : m_sm(sm)
+        , m_varDecl(varDecl)
+    {
+    }
+
+    bool TraverseDecl(Decl *decl)
+    {
+        // The variable has internal linkage, so headers can't use it. Skipping them is what keeps this cheap.
+        if (decl && !isa<TranslationUnitDecl>(decl) && !m_sm.isInMainFile(m_sm.getExpansionLoc(decl->getLocation())))
+            return true;
+
+        return RecursiveASTVisitor<GlobalStaticUsesVisitor>::TraverseDecl(decl);
+    }
+
+    bool VisitMemberExpr(MemberExpr *memberExpr)
+    {
+        // s.foo() becomes s->foo()
+        auto declRef = dyn_cast<DeclRefExpr>(memberExpr->getBase()->IgnoreParenImpCasts());
+        if (!memberExpr->isArrow() && declRef && declRef->getDecl() == m_varDecl) {
+            m_dotUses.insert(declRef);
+            addFixit(memberExpr->getOperatorLoc(), "->");
+        }
+
+        return true;
+    }
+
+    bool VisitDeclRefExpr(DeclRefExpr *declRef)
+    {
+        // Parents are visited first, so member accesses were already handled
+        if (declRef->getDecl() != m_varDecl || m_dotUses.count(declRef))
+            return true;
+
+        // There's no ns::(*foo)
+        if (declRef->hasQualifier())
+            hasUnsupportedUses = true;
+        else
+            addFixit(declRef->getLocation(), "(*" + clazy::name(m_varDecl).str() + ")");
+
+        return true;
+    }
+
+    bool hasUnsupportedUses = false;
+    std::vector<FixItHint> fixits;
+
+private:
+    void addFixit(SourceLocation loc, const std::string &replacement)
+    {
+        if (loc.isMacroID()) {
+            hasUnsupportedUses = true;
+            return;
+        }
+
+        fixits.push_back(clazy::createReplacement(loc, replacement));
+    }
+
+    const SourceManager &m_sm;
+    VarDecl *const m_varDecl;
+    llvm::SmallPtrSet<DeclRefExpr *, 8> m_dotUses;
+};
+
+}  // namespace
+
+enum class StartupCost {
+    None,
+    Allocation,
+    RegExpCompilation
+};
+
 static bool shouldIgnoreType(StringRef name)
 {
     // Q_GLOBAL_STATIC and such
@@ -52,12 +138,178 @@ static bool shouldIgnoreType(StringRef name)
     return clazy::contains(blacklist, name);
 }
 
+static bool isRegExpClass(CXXRecordDecl *record)
+{
+    const StringRef className = clazy::name(record);
+    return className == "QRegularExpression" || className == "QRegExp"
+           || (className == "basic_regex" && record->isInStdNamespace());
+}
+
+// Strings and containers allocate when they're constructed with contents
+static bool isAllocatingClass(CXXRecordDecl *record)
+{
+    static const clazy::NameSet stdClasses = { "basic_string", "vector", "deque", "list", "map", "multimap", "set",
+                                               "multiset", "unordered_map", "unordered_multimap", "unordered_set",
+                                               "unordered_multiset" };
+    if (record->isInStdNamespace())
+        return stdClasses.contains(clazy::name(record));
+
+    return clazy::name(record) == "QStringList" || clazy::isQtContainer(record);
+}
+
+// QStringLiteral and QByteArrayLiteral point to static data
+static bool isFromStaticData(CXXConstructorDecl *ctorDecl)
+{
+    static const clazy::NameSet dataPointers = { "QArrayDataPointer", "QStringDataPtr", "QByteArrayDataPtr" };
+    if (ctorDecl->getNumParams() == 0)
+        return false;
+
+    CXXRecordDecl *paramRecord = ctorDecl->getParamDecl(0)->getType().getNonReferenceType()->getAsCXXRecordDecl();
+    return paramRecord && dataPointers.contains(clazy::name(paramRecord));
+}
+
+// Estimates the cost of running s at startup, it doesn't look into called functions
+static StartupCost startupCost(Stmt *s)
+{
+    // QStringLiteral's lambda returns static data
+    if (!s || isa<LambdaExpr>(s))
+        return StartupCost::None;
+
+    StartupCost cost = StartupCost::None;
+    if (isa<CXXNewExpr>(s) || isa<CXXStdInitializerListExpr>(s))
+        cost = StartupCost::Allocation;
+
+    if (auto ctorExpr = dyn_cast<CXXConstructExpr>(s)) {
+        CXXConstructorDecl *ctorDecl = ctorExpr->getConstructor();
+        CXXRecordDecl *record = ctorDecl ? ctorDecl->getParent() : nullptr;
+        if (record && isRegExpClass(record))
+            return StartupCost::RegExpCompilation;
+
+        const bool hasArgs = ctorExpr->getNumArgs() > 0 && !isa<CXXDefaultArgExpr>(ctorExpr->getArg(0));
+        if (record && hasArgs && !ctorDecl->isCopyOrMoveConstructor() && !isFromStaticData(ctorDecl)
+            && isAllocatingClass(record))
+            cost = StartupCost::Allocation;
+    }
+
+    for (Stmt *child : s->children())
+        cost = std::max(cost, startupCost(child));
+
+    return cost;
+}
+
+// Same as startupCost(), but also looks into the constructor, as the application's own ones are usually visible
+static StartupCost constructionCost(CXXConstructExpr *ctorExpr)
+{
+    StartupCost cost = startupCost(ctorExpr);
+    CXXConstructorDecl *ctorDecl = ctorExpr->getConstructor();
+    if (!ctorDecl || !ctorDecl->hasBody() || ctorDecl->getParent()->isInStdNamespace())
+        return cost;
+
+    for (CXXCtorInitializer *init : ctorDecl->inits()) {
+        if (init->isWritten())
+            cost = std::max(cost, startupCost(init->getInit()));
+    }
+
+    return std::max(cost, startupCost(ctorDecl->getBody()));
+}
+
+// Returns the temporary that an elidable copy or move constructor copies, as in: static QString s = QString("foo")
+static CXXConstructExpr *elidedConstruction(CXXConstructExpr *ctorExpr)
+{
+    if (!ctorExpr->isElidable() || ctorExpr->getNumArgs() == 0)
+        return nullptr;
+
+    Expr *arg = ctorExpr->getArg(0)->IgnoreImplicit();
+    if (auto functionalCast = dyn_cast<CXXFunctionalCastExpr>(arg))
+        arg = functionalCast->getSubExpr()->IgnoreImplicit();
+
+    return dyn_cast<CXXConstructExpr>(arg);
+}
+
+// Returns the constructor call which initializes the variable
+static CXXConstructExpr *initializingConstruction(VarDecl *varDecl)
+{
+    auto ctorExpr = dyn_cast_or_null<CXXConstructExpr>(varDecl->getInit() ? varDecl->getInit()->IgnoreImplicit() : nullptr);
+    while (CXXConstructExpr *elided = ctorExpr ? elidedConstruction(ctorExpr) : nullptr)
+        ctorExpr = elided;
+
+    return ctorExpr;
+}
+
 NonPodGlobalStatic::NonPodGlobalStatic(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
 {
     m_filesToIgnore = { "main.cpp", "qrc_", "qdbusxml2cpp" };
 }
 
+// Ports "static Foo foo(args);" to "Q_GLOBAL_STATIC_WITH_ARGS(Foo, foo, (args));", so it's only constructed when used
+vector<FixItHint> NonPodGlobalStatic::globalStaticFixits(VarDecl *varDecl) const
+{
+    const QualType type = varDecl->getType();
+    if (type.isConstQualified() || type->isArrayType() || type->getContainedAutoType()
+        || !sm().isInMainFile(varDecl->getLocation()))
+        return {};
+
+    Preprocessor &preprocessor = m_context->pp;
+    if (!preprocessor.isMacroDefined("Q_GLOBAL_STATIC") || !preprocessor.isMacroDefined("Q_GLOBAL_STATIC_WITH_ARGS"))
+        return {};
+
+    const SourceLocation declStart = clazy::getLocStart(varDecl);
+    const SourceLocation nameLoc = varDecl->getLocation();
+    if (declStart.isMacroID() || nameLoc.isMacroID())
+        return {};
+
+    // The initializer can end with a macro, like QStringLiteral("foo")
+    SourceLocation declEnd = clazy::getLocEnd(varDecl);
+    if (declEnd.isMacroID())
+        declEnd = clazy::getExpansionRange(declEnd, sm()).getEnd();
+
+    // "static Foo" in "static Foo foo = Foo(1, 2)"
+    StringRef typeText = Lexer::getSourceText(CharSourceRange::getCharRange(declStart, nameLoc), sm(), lo()).trim();
+    if (typeText.startswith("static "))
+        typeText = typeText.substr(6).trim();
+
+    // It's a macro argument, so no commas. They also mean several variables are declared at once.
+    if (typeText.empty() || typeText.find(',') != StringRef::npos)
+        return {};
+
+    // "= Foo(1, 2)", empty if default constructed
+    const SourceLocation afterName = Lexer::getLocForEndOfToken(nameLoc, 0, sm(), lo());
+    const SourceLocation afterDecl = Lexer::getLocForEndOfToken(declEnd, 0, sm(), lo());
+    if (afterName.isInvalid() || afterDecl.isInvalid())
+        return {};
+
+    // Not "static QString a, b;"
+    const char *afterDeclData = sm().getCharacterData(afterDecl);
+    while (isspace(*afterDeclData))
+        ++afterDeclData;
+
+    if (*afterDeclData != ';')
+        return {};
+
+    StringRef initText = sm().isBeforeInTranslationUnit(afterName, afterDecl)
+        ? Lexer::getSourceText(CharSourceRange::getCharRange(afterName, afterDecl), sm(), lo()).trim()
+        : StringRef();
+    if (initText.startswith("="))
+        initText = initText.substr(1).trim();
+    else if (initText.startswith("(") && initText.endswith(")"))
+        initText = initText.substr(1, initText.size() - 2).trim();
+
+    GlobalStaticUsesVisitor visitor(sm(), varDecl);
+    visitor.TraverseDecl(m_astContext->getTranslationUnitDecl());
+    if (visitor.hasUnsupportedUses)
+        return {};
+
+    const string name = clazy::name(varDecl).str();
+    const string globalStatic = initText.empty()
+        ? "Q_GLOBAL_STATIC(" + typeText.str() + ", " + name + ")"
+        : "Q_GLOBAL_STATIC_WITH_ARGS(" + typeText.str() + ", " + name + ", (" + initText.str() + "))";
+
+    vector<FixItHint> fixits = { clazy::createReplacement({ declStart, declEnd }, globalStatic) };
+    clazy::append(visitor.fixits, fixits);
+    return fixits;
+}
+
 void NonPodGlobalStatic::VisitStmt(clang::Stmt *stm)
 {
     VarDecl *varDecl = m_context->lastDecl ? dyn_cast<VarDecl>(m_context->lastDecl) : nullptr;
@@ -83,6 +335,10 @@ void NonPodGlobalStatic::VisitStmt(clang::Stmt *stm)
     if (!ctorExpr)
         return;
 
+    // The temporary being copied gets the warning, otherwise we'd warn twice
+    if (elidedConstruction(ctorExpr))
+        return;
+
     auto ctorDecl = ctorExpr->getConstructor();
     auto recordDecl = ctorDecl ? ctorDecl->getParent() : nullptr;
     if (!recordDecl)
@@ -100,13 +356,31 @@ void NonPodGlobalStatic::VisitStmt(clang::Stmt *stm)
         }
     }
 
-    if (m_context->isQtDeveloper() && clazy::isBootstrapping(m_context->ci.getPreprocessorOpts()))
+    if (m_context->isQtDeveloper() && clazy::isBootstrapping(m_context->pp.getPreprocessorOpts()))
         return;
 
     StringRef className = clazy::name(recordDecl);
-    if (!shouldIgnoreType(className)) {
-        std::string error = string("non-POD static (") + className.data() + string(")");
-        emitWarning(declStart, error);
+    if (shouldIgnoreType(className))
+        return;
+
+    std::string error = string("non-POD static (") + className.data() + string(")");
+
+    // Only the variable's own construction can become lazy, not temporaries used to initialize it
+    vector<FixItHint> fixits;
+    if (ctorExpr == initializingConstruction(varDecl)) {
+        switch (constructionCost(ctorExpr)) {
+        case StartupCost::RegExpCompilation:
+            error += " compiles a regular expression at startup";
+            break;
+        case StartupCost::Allocation:
+            error += " allocates memory at startup";
+            break;
+        case StartupCost::None:
+            break;
+        }
+
+        fixits = globalStaticFixits(varDecl);
     }
 
+    emitWarning(declStart, error, fixits);
 }
@@ -28,14 +28,17 @@
 #include "checkbase.h"
 
 #include <string>
+#include <vector>
 
 class ClazyContext;
 namespace clang {
+class FixItHint;
 class Stmt;
+class VarDecl;
 }  // namespace clang
 
 /**
- * Finds global static non-POD variables.
+ * Finds global static non-POD variables, and estimates what their initialization costs at startup.
  *
  * See README-non-pod-global-static.
  */
@@ -45,6 +48,8 @@ class NonPodGlobalStatic
 public:
     explicit NonPodGlobalStatic(const std::string &name, ClazyContext *context);
     void VisitStmt(clang::Stmt *stm) override;
+private:
+    std::vector<clang::FixItHint> globalStaticFixits(clang::VarDecl *varDecl) const;
 };
 
 #endif
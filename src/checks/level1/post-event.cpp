@@ -35,7 +35,7 @@ using namespace std;
 
 
 PostEvent::PostEvent(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
 {
 }
 
@@ -45,10 +45,8 @@ void PostEvent::VisitStmt(clang::Stmt *stmt)
     if (!callexpr)
         return;
 
-    auto name = clazy::qualifiedMethodName(callexpr);
-
-    const bool isPostEvent = name == "QCoreApplication::postEvent";
-    const bool isSendEvent = name == "QCoreApplication::sendEvent";
+    const bool isPostEvent = clazy::qualifiedMethodNameIs(callexpr, "QCoreApplication::postEvent");
+    const bool isSendEvent = !isPostEvent && clazy::qualifiedMethodNameIs(callexpr, "QCoreApplication::sendEvent");
 
     //if (!isPostEvent && !isSendEvent)
     // Send event has false-positives
@@ -39,7 +39,7 @@ using namespace clang;
 using namespace std;
 
 QDeleteAll::QDeleteAll(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
 {
 }
 
@@ -47,7 +47,7 @@ void QDeleteAll::VisitStmt(clang::Stmt *stmt)
 {
     // Find a call to QMap/QSet/QHash::values/keys
     auto offendingCall = dyn_cast<CXXMemberCallExpr>(stmt);
-    FunctionDecl *func = offendingCall ? offendingCall->getDirectCallee() : nullptr;
+    FunctionDecl *func = offendingCall ? m_context->stmtFacts.callee() : nullptr;
     if (!func)
         return;
 
@@ -56,11 +56,11 @@ void QDeleteAll::VisitStmt(clang::Stmt *stmt)
     const bool isKeys = isValues ? false : funcName == "keys";
 
     if (isValues || isKeys) {
-        const std::string offendingClassName = offendingCall->getMethodDecl()->getParent()->getNameAsString();
+        const std::string offendingClassName = m_context->stmtFacts.recordName().str();
         if (clazy::isQtAssociativeContainer(offendingClassName)) {
             // Once found see if the first parent call is qDeleteAll
             int i = 1;
-            Stmt *p = clazy::parent(m_context->parentMap, stmt, i);
+            Stmt *p = clazy::parent(m_context, stmt, i);
             while (p) {
                 auto pc = dyn_cast<CallExpr>(p);
                 FunctionDecl *f = pc ? pc->getDirectCallee() : nullptr;
@@ -80,7 +80,7 @@ void QDeleteAll::VisitStmt(clang::Stmt *stmt)
                     break;
                 }
                 ++i;
-                p = clazy::parent(m_context->parentMap, stmt, i);
+                p = clazy::parent(m_context, stmt, i);
             }
         }
     }
@@ -23,6 +23,7 @@
 #include "qlatin1string-non-ascii.h"
 #include "Utils.h"
 #include "HierarchyUtils.h"
+#include "StringUtils.h"
 
 #include <clang/AST/DeclCXX.h>
 #include <clang/AST/Expr.h>
@@ -38,7 +39,7 @@ using namespace std;
 
 
 QLatin1StringNonAscii::QLatin1StringNonAscii(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
 {
 }
 
@@ -47,10 +48,10 @@ void QLatin1StringNonAscii::VisitStmt(clang::Stmt *stmt)
     auto constructExpr = dyn_cast<CXXConstructExpr>(stmt);
     CXXConstructorDecl *ctor = constructExpr ? constructExpr->getConstructor() : nullptr;
 
-    if (!ctor || ctor->getQualifiedNameAsString() != "QLatin1String::QLatin1String")
+    if (!ctor || !clazy::qualifiedNameIs(ctor, "QLatin1String::QLatin1String"))
         return;
 
     StringLiteral *lt = clazy::getFirstChildOfType2<StringLiteral>(stmt);
-    if (lt && !Utils::isAscii(lt))
+    if (lt && !Utils::isAscii(m_context, lt))
         emitWarning(stmt, "QLatin1String with non-ascii literal");
 }
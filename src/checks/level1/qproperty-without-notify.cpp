@@ -42,7 +42,7 @@ using namespace std;
 QPropertyWithoutNotify::QPropertyWithoutNotify(const std::string &name, ClazyContext *context)
     : CheckBase(name, context, Option_CanIgnoreIncludes)
 {
-    enablePreProcessorCallbacks();
+    enablePreProcessorCallbacks(PreprocessorEvent_MacroExpands, { "Q_GADGET", "Q_OBJECT", "Q_PROPERTY" });
 }
 
 void QPropertyWithoutNotify::VisitMacroExpands(const clang::Token &MacroNameTok, const clang::SourceRange &range, const MacroInfo *)
@@ -36,14 +36,14 @@ using namespace std;
 
 
 QStringLeft::QStringLeft(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
 {
 }
 
 void QStringLeft::VisitStmt(clang::Stmt *stmt)
 {
     auto memberCall = dyn_cast<CXXMemberCallExpr>(stmt);
-    if (!memberCall || clazy::qualifiedMethodName(memberCall) != "QString::left")
+    if (!memberCall || !clazy::qualifiedMethodNameIs(memberCall, "QString::left"))
         return;
 
     if (memberCall->getNumArgs() == 0) // Doesn't happen
@@ -25,6 +25,7 @@
 #include "range-loop.h"
 #include "Utils.h"
 #include "QtUtils.h"
+#include "QtRegistry.h"
 #include "TypeUtils.h"
 #include "StringUtils.h"
 #include "LoopUtils.h"
@@ -116,7 +117,7 @@ void RangeLoop::VisitStmt(clang::Stmt *stmt)
 bool RangeLoop::islvalue(Expr *exp, SourceLocation &endLoc)
 {
     if (isa<DeclRefExpr>(exp)) {
-        endLoc = clazy::locForEndOfToken(&m_astContext, clazy::getLocStart(exp));
+        endLoc = clazy::locForEndOfToken(m_astContext, clazy::getLocStart(exp));
         return true;
     }
 
@@ -125,7 +126,7 @@ bool RangeLoop::islvalue(Expr *exp, SourceLocation &endLoc)
         if (!decl || isa<FunctionDecl>(decl))
             return false;
 
-        endLoc = clazy::locForEndOfToken(&m_astContext, me->getMemberLoc());
+        endLoc = clazy::locForEndOfToken(m_astContext, me->getMemberLoc());
         return true;
     }
 
@@ -153,10 +154,10 @@ void RangeLoop::processForRangeLoop(CXXForRangeStmt *rangeLoop)
         return;
 
     CXXRecordDecl *record = t->getAsCXXRecordDecl();
-    if (!clazy::isQtCOWIterableClass(Utils::rootBaseClass(record)))
+    if (!m_context->qtRegistry().isQtCOWIterableClass(Utils::rootBaseClass(record)))
         return;
 
-    StmtBodyRange bodyRange(nullptr, &sm(), clazy::getLocStart(rangeLoop));
+    StmtBodyRange bodyRange(nullptr, &sm(), clazy::getLocStart(rangeLoop), m_context->functionStmtIndex(rangeLoop));
     if (clazy::containerNeverDetaches(clazy::containerDeclForLoop(rangeLoop), bodyRange))
         return;
 
@@ -173,7 +174,8 @@ void RangeLoop::processForRangeLoop(CXXForRangeStmt *rangeLoop)
         }
     }
 
-    emitWarning(clazy::getLocStart(rangeLoop), "c++11 range-loop might detach Qt container (" + record->getQualifiedNameAsString() + ')', fixits);
+    emitFormattedWarning(clazy::getLocStart(rangeLoop), "c++11 range-loop might detach Qt container (%0)",
+                         { record->getQualifiedNameAsString() }, fixits);
 }
 
 void RangeLoop::checkPassByConstRefCorrectness(CXXForRangeStmt *rangeLoop)
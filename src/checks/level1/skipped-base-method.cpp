@@ -41,7 +41,7 @@ using namespace std;
 
 
 SkippedBaseMethod::SkippedBaseMethod(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context)
+    : CheckBase(name, context, Option_Reusable)
 {
 }
 
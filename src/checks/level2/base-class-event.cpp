@@ -44,7 +44,7 @@ using namespace clang;
 using namespace std;
 
 BaseClassEvent::BaseClassEvent(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context)
+    : CheckBase(name, context, Option_Reusable)
 {
 }
 
@@ -38,7 +38,7 @@ using namespace std;
 
 
 CopyablePolymorphic::CopyablePolymorphic(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context)
+    : CheckBase(name, context, Option_Reusable)
 {
 }
 
@@ -57,5 +57,6 @@ void CopyablePolymorphic::VisitDecl(clang::Decl *decl)
             return;
     }
 
-    emitWarning(clazy::getLocStart(record), "Polymorphic class " + record->getQualifiedNameAsString() + " is copyable. Potential slicing.");
+    emitFormattedWarning(clazy::getLocStart(record), "Polymorphic class %0 is copyable. Potential slicing.",
+                         { record->getQualifiedNameAsString() });
 }
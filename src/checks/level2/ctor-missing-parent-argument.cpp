@@ -39,7 +39,7 @@ using namespace std;
 
 
 CtorMissingParentArgument::CtorMissingParentArgument(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context)
+    : CheckBase(name, context, Option_Reusable)
 {
 }
 
@@ -96,7 +96,7 @@ static bool shouldIgnoreFunction(clang::FunctionDecl *function)
 }
 
 FunctionArgsByRef::FunctionArgsByRef(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
 {
 }
 
@@ -139,7 +139,7 @@ void FunctionArgsByRef::processFunction(FunctionDecl *func)
             continue;
 
         vector<CXXCtorInitializer *> ctorInits = Utils::ctorInitializer(dyn_cast<CXXConstructorDecl>(func), param);
-        if (Utils::ctorInitializerContainsMove(ctorInits))
+        if (Utils::ctorInitializerContainsMove(ctorInits) || Utils::isMovedFrom(body, param))
             continue;
 
         if (classif.passBigTypeByConstRef || classif.passNonTriviallyCopyableByConstRef) {
@@ -153,6 +153,8 @@ void FunctionArgsByRef::processFunction(FunctionDecl *func)
             }
 
             addFixits(fixits, func, i);
+            // Copied on each call, and a non-trivial copy constructor usually allocates
+            setWasteEstimate(classif.passNonTriviallyCopyableByConstRef ? 1 : 0, classif.size_of_T, 0);
             emitWarning(clazy::getLocStart(param), error.c_str(), fixits);
         }
     }
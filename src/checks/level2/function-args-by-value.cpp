@@ -104,7 +104,7 @@ static bool shouldIgnoreFunction(clang::FunctionDecl *function)
 }
 
 FunctionArgsByValue::FunctionArgsByValue(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
 {
 }
 
@@ -183,7 +183,7 @@ void FunctionArgsByValue::processFunction(FunctionDecl *func)
             std::vector<FixItHint> fixits;
             auto method = dyn_cast<CXXMethodDecl>(func);
             const bool isVirtualMethod = method && method->isVirtual();
-            if ((!isVirtualMethod || warnForOverriddenMethods) && fixitsEnabled()) { // Don't try to fix virtual methods, as build can fail
+            if ((!isVirtualMethod || warnForOverriddenMethods) && fixitsEnabled() && !isShadowedWarning(clazy::getLocStart(param))) { // Don't try to fix virtual methods, as build can fail
                 for (auto redecl : func->redecls()) { // Fix in both header and .cpp
                     auto fdecl = dyn_cast<FunctionDecl>(redecl);
                     const ParmVarDecl *param = fdecl->getParamDecl(i);
@@ -193,6 +193,8 @@ void FunctionArgsByValue::processFunction(FunctionDecl *func)
 
             const string paramStr = param->getType().getAsString();
             string error = "Pass small and trivially-copyable type by value (" + paramStr + ')';
+            // What's read through the reference, instead of being passed in registers
+            setWasteEstimate(0, classif.size_of_T, 0);
             emitWarning(clazy::getLocStart(param), error.c_str(), fixits);
         }
     }
@@ -38,7 +38,7 @@ class ClazyContext;
 using namespace clang;
 
 GlobalConstCharPointer::GlobalConstCharPointer(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context)
+    : CheckBase(name, context, Option_Reusable)
 {
     m_filesToIgnore = { "3rdparty", "mysql.h", "qpicture.cpp" };
 }
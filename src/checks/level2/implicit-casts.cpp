@@ -55,7 +55,7 @@ using namespace std;
 
 
 ImplicitCasts::ImplicitCasts(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
 {
     m_filesToIgnore = { "qobject_impl.h", "qdebug.h", "hb-", "qdbusintegrator.cpp",
                         "harfbuzz-", "qunicodetools.cpp" };
@@ -43,7 +43,7 @@ using namespace std;
 MissingQObjectMacro::MissingQObjectMacro(const std::string &name, ClazyContext *context)
     : CheckBase(name, context)
 {
-    enablePreProcessorCallbacks();
+    enablePreProcessorCallbacks(PreprocessorEvent_MacroExpands, { "Q_OBJECT" });
 }
 
 void MissingQObjectMacro::VisitMacroExpands(const clang::Token &MacroNameTok, const clang::SourceRange &range, const MacroInfo *)
@@ -75,7 +75,7 @@ void MissingQObjectMacro::VisitDecl(clang::Decl *decl)
             return; // We found a Q_OBJECT after start and before end, it's ours.
     }
 
-    emitWarning(startLoc, record->getQualifiedNameAsString() + " is missing a Q_OBJECT macro");
+    emitFormattedWarning(startLoc, "%0 is missing a Q_OBJECT macro", { record->getQualifiedNameAsString() });
 }
 
 void MissingQObjectMacro::registerQ_OBJECT(SourceLocation loc)
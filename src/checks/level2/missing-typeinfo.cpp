@@ -23,18 +23,24 @@
 */
 
 #include "missing-typeinfo.h"
+#include "ClazyContext.h"
 #include "TemplateUtils.h"
 #include "QtUtils.h"
 #include "StringUtils.h"
+#include "PreProcessorVisitor.h"
 #include "SourceCompatibilityHelpers.h"
 
+#include <clang/AST/ASTContext.h>
+#include <clang/AST/Decl.h>
 #include <clang/AST/DeclTemplate.h>
 #include <clang/AST/DeclCXX.h>
+#include <clang/AST/TemplateBase.h>
 #include <clang/AST/Type.h>
+#include <clang/Basic/IdentifierTable.h>
 #include <clang/Basic/SourceManager.h>
+#include <llvm/ADT/APSInt.h>
 #include <llvm/ADT/StringRef.h>
 
-class ClazyContext;
 namespace clang {
 class Decl;
 }  // namespace clang
@@ -45,6 +51,39 @@ using namespace clang;
 MissingTypeInfo::MissingTypeInfo(const std::string &name, ClazyContext *context)
     : CheckBase(name, context)
 {
+    context->enablePreprocessorVisitor(); // Qt 6's QList is a vector and has Q_RELOCATABLE_TYPE
+}
+
+// Returns true for containers which, in Qt 5, store their elements in an array of pointers
+static bool isListLike(StringRef name)
+{
+    return name == "QList" || name == "QQueue";
+}
+
+static bool isVectorLike(StringRef name)
+{
+    return name == "QVector" || name == "QStack" || name == "QVarLengthArray";
+}
+
+// Reads a constant such as QTypeInfo<T>::isRelocatable, an enumerator in Qt but we also accept static constexpr bools
+static bool readConstant(ASTContext *context, CXXRecordDecl *record, StringRef name, bool &value)
+{
+    for (NamedDecl *decl : record->lookup(DeclarationName(&context->Idents.get(name)))) {
+        if (auto enumerator = dyn_cast<EnumConstantDecl>(decl)) {
+            value = enumerator->getInitVal().getBoolValue();
+            return true;
+        }
+
+        if (auto var = dyn_cast<VarDecl>(decl)) {
+            const APValue *apValue = var->getInit() && !var->getInit()->isValueDependent() ? var->evaluateValue() : nullptr;
+            if (apValue && apValue->isInt()) {
+                value = apValue->getInt().getBoolValue();
+                return true;
+            }
+        }
+    }
+
+    return false;
 }
 
 void MissingTypeInfo::VisitDecl(clang::Decl *decl)
@@ -53,46 +92,169 @@ void MissingTypeInfo::VisitDecl(clang::Decl *decl)
     if (!tstdecl)
         return;
 
-    const bool isQList = clazy::name(tstdecl) == "QList";
-    const bool isQVector = isQList ? false : clazy::name(tstdecl) == "QVector";
+    const StringRef containerName = clazy::name(tstdecl);
+    const bool isQt6 = m_context->preprocessorVisitor && m_context->preprocessorVisitor->qtVersion() >= 60000;
+    const bool isQList = !isQt6 && isListLike(containerName);
+    const bool isQVector = !isQList && (isVectorLike(containerName) || isListLike(containerName));
 
     if (!isQList && !isQVector) {
         registerQTypeInfo(tstdecl);
         return;
     }
 
-    QualType qt2 = clazy::getTemplateArgumentType(tstdecl, 0);
+    // Each variable of type QList<Foo> gets here, but the answer only depends on Foo
+    CXXRecordDecl *record = m_missingTypeInfos.get(tstdecl, [this, isQList, isQt6] (ClassTemplateSpecializationDecl *specialization) {
+        return recordMissingTypeInfo(specialization, isQList, isQt6);
+    });
+
+    if (record) {
+        string msg = "Missing Q_DECLARE_TYPEINFO: " + clazy::name(record).str();
+        if (!m_astContext->getRecordType(record).isTriviallyCopyableType(*m_astContext)) {
+            msg += isQt6 ? ", it's relocatable, use Q_RELOCATABLE_TYPE instead of copying it element by element"
+                         : ", it's relocatable, use Q_MOVABLE_TYPE instead of copying it element by element";
+        }
+
+        emitWarning(decl, msg);
+        emitWarning(record, "Type declared here:", false);
+    }
+}
+
+CXXRecordDecl *MissingTypeInfo::recordMissingTypeInfo(ClassTemplateSpecializationDecl *containerDecl, bool isQList, bool isQt6)
+{
+    QualType qt2 = clazy::getTemplateArgumentType(containerDecl, 0);
     const Type *t = qt2.getTypePtrOrNull();
     CXXRecordDecl *record = t ? t->getAsCXXRecordDecl() : nullptr;
-    if (!record || !record->getDefinition() || typeHasClassification(qt2))
-        return; // Don't crash if we only have a fwd decl
+    if (!record || !record->getDefinition() || typeHasClassification(record))
+        return nullptr; // Don't crash if we only have a fwd decl
 
-    const bool isCopyable = qt2.isTriviallyCopyableType(m_astContext);
-    const bool isTooBigForQList = isQList && clazy::isTooBigForQList(qt2, &m_astContext);
+    const bool isCopyable = qt2.isTriviallyCopyableType(*m_astContext);
+    const bool isTooBigForQList = isQList && clazy::isTooBigForQList(qt2, m_astContext);
 
-    if ((isQVector || isTooBigForQList) && isCopyable) {
+    // Qt 6 already relocates trivially copyable types, but copies the rest element by element
+    const bool benefits = isCopyable ? !isQt6 : isRecordRelocatable(record);
+    if ((!isQList || isTooBigForQList) && benefits) {
         if (sm().isInSystemHeader(clazy::getLocStart(record)))
-            return;
+            return nullptr;
 
-        std::string typeName = clazy::name(record);
-        if (typeName == "QPair") // QPair doesn't use Q_DECLARE_TYPEINFO, but rather a explicit QTypeInfo.
-            return;
+        if (clazy::name(record) == "QPair") // QPair doesn't use Q_DECLARE_TYPEINFO, but rather a explicit QTypeInfo.
+            return nullptr;
 
-        emitWarning(decl, "Missing Q_DECLARE_TYPEINFO: " + typeName);
-        emitWarning(record, "Type declared here:", false);
+        return record;
     }
+
+    return nullptr;
+}
+
+bool MissingTypeInfo::isRelocatable(QualType qt)
+{
+    qt = m_astContext->getBaseElementType(qt.getCanonicalType());
+    if (qt->isReferenceType() || qt->isScalarType() || qt.isTriviallyCopyableType(*m_astContext))
+        return true;
+
+    CXXRecordDecl *record = qt->getAsCXXRecordDecl();
+    if (!record || !record->getDefinition())
+        return false;
+
+    record = record->getDefinition();
+    bool relocatable = false;
+    if (ClassTemplateSpecializationDecl *typeInfo = qtypeInfoFor(record))
+        return qtypeInfoIsRelocatable(typeInfo, relocatable) && relocatable;
+
+    // We don't know what std:: and other third party types do with their storage, like std::string's SSO
+    if (sm().isInSystemHeader(clazy::getLocStart(record)))
+        return false;
+
+    return isRecordRelocatable(record);
+}
+
+bool MissingTypeInfo::isRecordRelocatable(CXXRecordDecl *record)
+{
+    record = record->getDefinition();
+    if (!record || record->isDynamicClass() || record->isUnion())
+        return false;
+
+    // With user provided copy, move or destruction the type might be tracking its own address
+    if (CXXDestructorDecl *dtor = record->getDestructor()) {
+        if (dtor->isUserProvided())
+            return false;
+    }
+
+    for (CXXConstructorDecl *ctor : record->ctors()) {
+        if (ctor->isCopyOrMoveConstructor() && ctor->isUserProvided())
+            return false;
+    }
+
+    for (CXXMethodDecl *method : record->methods()) {
+        if ((method->isCopyAssignmentOperator() || method->isMoveAssignmentOperator()) && method->isUserProvided())
+            return false;
+    }
+
+    for (const CXXBaseSpecifier &base : record->bases()) {
+        if (!isRelocatable(base.getType()))
+            return false;
+    }
+
+    for (FieldDecl *field : record->fields()) {
+        if (!isRelocatable(field->getType()))
+            return false;
+    }
+
+    return true;
+}
+
+ClassTemplateSpecializationDecl *MissingTypeInfo::qtypeInfoFor(const CXXRecordDecl *record)
+{
+    if (!m_qtypeInfoLookedUp) {
+        m_qtypeInfoLookedUp = true;
+        DeclarationName name(&m_astContext->Idents.get("QTypeInfo"));
+        for (NamedDecl *decl : m_astContext->getTranslationUnitDecl()->lookup(name)) {
+            if ((m_qtypeInfoTemplate = dyn_cast<ClassTemplateDecl>(decl)))
+                break;
+        }
+    }
+
+    if (!m_qtypeInfoTemplate)
+        return nullptr;
+
+    void *insertPos = nullptr;
+    const TemplateArgument arg(m_astContext->getRecordType(record));
+    ClassTemplateSpecializationDecl *typeInfo = m_qtypeInfoTemplate->findSpecialization(arg, insertPos);
+    if (!typeInfo || !typeInfo->getDefinition())
+        return nullptr;
+
+    // An instantiation of the primary template just means nobody declared anything
+    if (typeInfo->getSpecializationKind() == TSK_ExplicitSpecialization
+        || typeInfo->getSpecializedTemplateOrPartial().is<ClassTemplatePartialSpecializationDecl *>())
+        return typeInfo;
+
+    return nullptr;
+}
+
+bool MissingTypeInfo::qtypeInfoIsRelocatable(ClassTemplateSpecializationDecl *typeInfo, bool &relocatable) const
+{
+    CXXRecordDecl *definition = typeInfo->getDefinition();
+    if (readConstant(m_astContext, definition, "isRelocatable", relocatable))
+        return true;
+
+    // Older Qt 5 only has isStatic, which Q_MOVABLE_TYPE and Q_PRIMITIVE_TYPE unset
+    bool isStatic = true;
+    if (!readConstant(m_astContext, definition, "isStatic", isStatic))
+        return false;
+
+    relocatable = !isStatic;
+    return true;
 }
 
 void MissingTypeInfo::registerQTypeInfo(ClassTemplateSpecializationDecl *decl)
 {
     if (clazy::name(decl) == "QTypeInfo") {
-        const string typeName = clazy::getTemplateArgumentTypeStr(decl, 0, lo(), /**recordOnly=*/ true);
-        if (!typeName.empty())
-            m_typeInfos.insert(typeName);
+        const CXXRecordDecl *record = clazy::getTemplateArgumentRecord(decl, 0);
+        if (record && m_typeInfos.insert(record).second)
+            m_missingTypeInfos.clear(); // Conclusions about QList<record> would be stale
     }
 }
 
-bool MissingTypeInfo::typeHasClassification(QualType qt) const
+bool MissingTypeInfo::typeHasClassification(const CXXRecordDecl *record) const
 {
-    return m_typeInfos.find(clazy::simpleTypeName(qt, lo())) != m_typeInfos.end();
+    return m_typeInfos.count(record->getCanonicalDecl());
 }
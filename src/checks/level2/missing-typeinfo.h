@@ -26,13 +26,16 @@
 #define CLAZY_MISSING_TYPE_INFO_H
 
 #include "checkbase.h"
+#include "TemplateUtils.h"
+
+#include <llvm/ADT/SmallPtrSet.h>
 
-#include <set>
 #include <string>
 
 class ClazyContext;
 
 namespace clang {
+class ClassTemplateDecl;
 class ClassTemplateSpecializationDecl;
 class CXXRecordDecl;
 class Decl;
@@ -42,6 +45,7 @@ class QualType;
 /**
  * Suggests usage of Q_PRIMITIVE_TYPE or Q_MOVABLE_TYPE in cases where you're using QList<T> and sizeof(T) > sizeof(void*)
  * or using QVector<T>. Unless they already have a classification.
+ * Types which aren't trivially copyable but only hold relocatable members get Q_RELOCATABLE_TYPE suggested (Q_MOVABLE_TYPE in Qt 5).
  *
  * See README-missing-type-info for more info.
  */
@@ -53,8 +57,19 @@ public:
     void VisitDecl(clang::Decl *decl) override;
 private:
     void registerQTypeInfo(clang::ClassTemplateSpecializationDecl *decl);
-    bool typeHasClassification(clang::QualType) const;
-    std::set<std::string> m_typeInfos;
+    // Returns the type for which containerDecl, a QList or QVector, needs a Q_DECLARE_TYPEINFO, if any
+    clang::CXXRecordDecl *recordMissingTypeInfo(clang::ClassTemplateSpecializationDecl *containerDecl, bool isQList, bool isQt6);
+    bool isRelocatable(clang::QualType qt);
+    // Returns true if all bases and members are relocatable and copying isn't user provided
+    bool isRecordRelocatable(clang::CXXRecordDecl *record);
+    // Returns the QTypeInfo<record> declared by Qt or the user, if any
+    clang::ClassTemplateSpecializationDecl *qtypeInfoFor(const clang::CXXRecordDecl *record);
+    bool qtypeInfoIsRelocatable(clang::ClassTemplateSpecializationDecl *typeInfo, bool &relocatable) const;
+    bool typeHasClassification(const clang::CXXRecordDecl *record) const;
+    clang::ClassTemplateDecl *m_qtypeInfoTemplate = nullptr;
+    bool m_qtypeInfoLookedUp = false;
+    llvm::SmallPtrSet<const clang::CXXRecordDecl *, 32> m_typeInfos; // Canonical declarations of the types with a QTypeInfo specialization
+    clazy::SpecializationMemo<clang::CXXRecordDecl *> m_missingTypeInfos; // Result of recordMissingTypeInfo()
 };
 
 #endif
@@ -108,7 +108,7 @@ static bool classIsOk(StringRef className)
 OldStyleConnect::OldStyleConnect(const std::string &name, ClazyContext *context)
     : CheckBase(name, context, Option_CanIgnoreIncludes)
 {
-    enablePreProcessorCallbacks();
+    enablePreProcessorCallbacks(PreprocessorEvent_MacroExpands, { "Q_PRIVATE_SLOT" });
     context->enableAccessSpecifierManager();
 }
 
@@ -117,6 +117,13 @@ int OldStyleConnect::classifyConnect(FunctionDecl *connectFunc, T *connectCall)
 {
     int classification = ConnectFlag_None;
 
+    // Filter by the unqualified name first, to not build the qualified one for every call
+    static const clazy::NameSet connectFunctions = { "connect", "disconnect", "singleShot", "addTransition",
+                                                     "addAction", "open", "QSignalSpy" };
+    auto ctor = dyn_cast<CXXConstructorDecl>(connectFunc);
+    if (!connectFunctions.contains(ctor ? clazy::name(ctor) : clazy::name(connectFunc)))
+        return classification;
+
     const string methodName = connectFunc->getQualifiedNameAsString();
     if (methodName == "QObject::connect")
         classification |= ConnectFlag_Connect;
@@ -265,6 +272,70 @@ void OldStyleConnect::addPrivateSlot(const PrivateSlot &slot)
     m_privateSlots.push_back(slot);
 }
 
+// These run for every Q_PRIVATE_SLOT and SIGNAL/SLOT macro, hand-written instead of std::regex as it was too slow.
+// They match what "Q_PRIVATE_SLOT\s*\((.*)\s*,\s*.*\s+(.*)\(.*" and "\s*(SIGNAL|SLOT)\s*\(\s*(.+)\s*\(.*" used to.
+
+static bool isWhitespace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+static llvm::StringRef skipWhitespace(llvm::StringRef text)
+{
+    return text.drop_while(isWhitespace);
+}
+
+// Consumes "<keyword>\s*\(" from the start of text
+static bool consumeMacroStart(llvm::StringRef &text, llvm::StringRef keyword)
+{
+    if (!text.consume_front(keyword))
+        return false;
+
+    text = skipWhitespace(text);
+    return text.consume_front("(");
+}
+
+// Q_PRIVATE_SLOT(d_func(), void _q_foo(int)) -> { "d_func()", "_q_foo" }
+static bool parsePrivateSlot(llvm::StringRef text, PrivateSlot &slot)
+{
+    if (!consumeMacroStart(text, "Q_PRIVATE_SLOT"))
+        return false;
+
+    // The object is everything up to the last comma which is followed by a declaration: "<type> <name>(",
+    // commas can appear in the object expression and in the slot's arguments
+    for (size_t comma = text.rfind(','); comma != llvm::StringRef::npos; comma = text.rfind(',', comma)) {
+        const llvm::StringRef declaration = text.substr(comma + 1);
+        const size_t paren = declaration.rfind('(');
+        if (paren != llvm::StringRef::npos) {
+            const llvm::StringRef beforeParen = declaration.substr(0, paren);
+            const size_t space = beforeParen.find_last_of(" \t\n\r\f\v");
+            if (space != llvm::StringRef::npos) {
+                slot.objName = text.substr(0, comma).str();
+                slot.name = beforeParen.substr(space + 1).str();
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// SIGNAL(foo(int)) -> "foo"
+static bool parseSignalOrSlotMacro(llvm::StringRef text, llvm::StringRef &name)
+{
+    text = skipWhitespace(text);
+    if (!consumeMacroStart(text, "SIGNAL") && !consumeMacroStart(text, "SLOT"))
+        return false;
+
+    text = skipWhitespace(text);
+    const size_t paren = text.rfind('(');
+    if (paren == 0 || paren == llvm::StringRef::npos)
+        return false;
+
+    name = text.substr(0, paren);
+    return true;
+}
+
 void OldStyleConnect::VisitMacroExpands(const Token &macroNameTok, const SourceRange &range, const MacroInfo *)
 {
     IdentifierInfo *ii = macroNameTok.getIdentifierInfo();
@@ -274,12 +345,9 @@ void OldStyleConnect::VisitMacroExpands(const Token &macroNameTok, const SourceR
     auto charRange = Lexer::getAsCharRange(range, sm(), lo());
     const string text = Lexer::getSourceText(charRange, sm(), lo());
 
-    static regex rx(R"(Q_PRIVATE_SLOT\s*\((.*)\s*,\s*.*\s+(.*)\(.*)");
-    smatch match;
-    if (!regex_match(text, match, rx) || match.size() != 3)
-        return;
-
-    addPrivateSlot({match[1], match[2]});
+    PrivateSlot slot;
+    if (parsePrivateSlot(text, slot))
+        addPrivateSlot(slot);
 }
 
 // SIGNAL(foo()) -> foo
@@ -293,18 +361,11 @@ string OldStyleConnect::signalOrSlotNameFromMacro(SourceLocation macroLoc)
     auto charRange = Lexer::getAsCharRange(range, sm(), lo());
     const string text = Lexer::getSourceText(charRange, sm(), lo());
 
-    static regex rx(R"(\s*(SIGNAL|SLOT)\s*\(\s*(.+)\s*\(.*)");
+    llvm::StringRef name;
+    if (!parseSignalOrSlotMacro(text, name))
+        return string("parsing failed for ") + text;
 
-    smatch match;
-    if (regex_match(text, match, rx)) {
-        if (match.size() == 3) {
-            return match[2].str();
-        } else {
-            return "error2";
-        }
-    } else {
-        return string("regexp failed for ") + text;
-    }
+    return name.str();
 }
 
 bool OldStyleConnect::isSignalOrSlot(SourceLocation loc, string &macroName) const
@@ -491,7 +552,7 @@ vector<FixItHint> OldStyleConnect::fixits(int classification, T *callOrCtor)
             if (record) {
                 lastRecordDecl = record;
                 if (isQPointer(expr)) {
-                    auto endLoc = clazy::locForNextToken(&m_astContext, clazy::getLocStart(arg), tok::comma);
+                    auto endLoc = clazy::locForNextToken(m_astContext, clazy::getLocStart(arg), tok::comma);
                     if (endLoc.isValid()) {
                         fixits.push_back(FixItHint::CreateInsertion(endLoc, ".data()"));
                     } else {
@@ -31,6 +31,7 @@
 #include "FunctionUtils.h"
 #include "QtUtils.h"
 #include "HierarchyUtils.h"
+#include "LoopUtils.h"
 #include "SourceCompatibilityHelpers.h"
 
 #include <clang/AST/DeclCXX.h>
@@ -78,13 +79,13 @@ struct Latin1Expr {
 };
 
 QStringAllocations::QStringAllocations(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
 {
 }
 
 void QStringAllocations::VisitStmt(clang::Stmt *stm)
 {
-    if (m_context->isQtDeveloper() && clazy::isBootstrapping(m_context->ci.getPreprocessorOpts())) {
+    if (m_context->isQtDeveloper() && clazy::isBootstrapping(m_context->pp.getPreprocessorOpts())) {
         // During bootstrap many QString::fromLatin1() are used instead of tr(), which causes
         // much noise
         return;
@@ -96,7 +97,7 @@ void QStringAllocations::VisitStmt(clang::Stmt *stm)
     VisitAssignOperatorQLatin1String(stm);
 }
 
-static bool betterTakeQLatin1String(CXXMethodDecl *method, StringLiteral *lt)
+static bool betterTakeQLatin1String(const ClazyContext *context, CXXMethodDecl *method, StringLiteral *lt)
 {
     static const vector<StringRef> methods = {"append", "compare", "endsWith", "startsWith", "insert",
                                               "lastIndexOf", "prepend", "replace", "contains", "indexOf" };
@@ -104,7 +105,7 @@ static bool betterTakeQLatin1String(CXXMethodDecl *method, StringLiteral *lt)
     if (!clazy::isOfClass(method, "QString"))
         return false;
 
-    return (!lt || Utils::isAscii(lt)) && clazy::contains(methods, clazy::name(method));
+    return (!lt || Utils::isAscii(context, lt)) && clazy::contains(methods, clazy::name(method));
 }
 
 // Returns the first occurrence of a QLatin1String(char*) CTOR call
@@ -229,14 +230,14 @@ void QStringAllocations::VisitCtor(Stmt *stm)
         }
 
         vector<FixItHint> fixits;
-        if (qlatin1expr.enableFixit && fixitsEnabled()) {
+        if (qlatin1expr.enableFixit && fixitsEnabled() && !isShadowedWarning(clazy::getLocStart(stm))) {
             if (!clazy::getLocStart(qlatin1Ctor).isMacroID()) {
                 if (!ternary) {
                     fixits = fixItReplaceWordWithWord(qlatin1Ctor, "QStringLiteral", "QLatin1String");
                     bool shouldRemoveQString = clazy::getLocStart(qlatin1Ctor).getRawEncoding() != clazy::getLocStart(stm).getRawEncoding() && dyn_cast_or_null<CXXBindTemporaryExpr>(clazy::parent(m_context->parentMap, ctorExpr));
                     if (shouldRemoveQString) {
                         // This is the case of QString(QLatin1String("foo")), which we just fixed to be QString(QStringLiteral("foo)), so now remove QString
-                        auto removalFixits = clazy::fixItRemoveToken(&m_astContext, ctorExpr, true);
+                        auto removalFixits = clazy::fixItRemoveToken(m_astContext, ctorExpr, true);
                         if (removalFixits.empty())  {
                             queueManualFixitWarning(clazy::getLocStart(ctorExpr), "Internal error: invalid start or end location");
                         } else {
@@ -281,7 +282,7 @@ void QStringAllocations::VisitCtor(Stmt *stm)
                             FunctionDecl *fDecl = parentMemberCallExpr->getDirectCallee();
                             if (fDecl) {
                                 auto method = dyn_cast<CXXMethodDecl>(fDecl);
-                                if (method && betterTakeQLatin1String(method, lt)) {
+                                if (method && betterTakeQLatin1String(m_context, method, lt)) {
                                     replacement = "QLatin1String";
                                 }
                             }
@@ -301,17 +302,17 @@ vector<FixItHint> QStringAllocations::fixItReplaceWordWithWord(clang::Stmt *begi
 {
     StringLiteral *lt = stringLiteralForCall(begin);
     if (replacee == "QLatin1String") {
-        if (lt && !Utils::isAscii(lt)) {
+        if (lt && !Utils::isAscii(m_context, lt)) {
             maybeEmitWarning(clazy::getLocStart(lt), "Don't use QLatin1String with non-latin1 literals");
             return {};
         }
     }
 
-    if (Utils::literalContainsEscapedBytes(lt, sm(), lo()))
+    if (Utils::literalContainsEscapedBytes(m_context, lt))
         return {};
 
     vector<FixItHint> fixits;
-    FixItHint fixit = clazy::fixItReplaceWordWithWord(&m_astContext, begin, replacement, replacee);
+    FixItHint fixit = clazy::fixItReplaceWordWithWord(m_astContext, begin, replacement, replacee);
     if (fixit.isNull()) {
         queueManualFixitWarning(clazy::getLocStart(begin), "");
     } else {
@@ -387,17 +388,16 @@ static bool isQStringLiteralCandidate(Stmt *s, ParentMap *map, const LangOptions
         // QTest::newRow will static_assert when using QLatin1String
         // Q_STATIC_ASSERT_X(QMetaTypeId2<T>::Defined, "Type is not registered, please use the Q_DECLARE_METATYPE macro to make it known to Qt's meta-object system");
 
-        string className = clazy::classNameFor(operatorCall);
-        if (className == "QString") {
+        if (clazy::classNameIs(operatorCall, "QString")) {
             return false;
-        } else if (className.empty() && clazy::hasArgumentOfType(operatorCall->getDirectCallee(), "QString", lo)) {
+        } else if (clazy::classNameIs(operatorCall, "") && clazy::hasArgumentOfType(operatorCall->getDirectCallee(), "QString", lo)) {
             return false;
         }
     }
 
     if (currentCall > 0 && callExpr) {
         auto fDecl = callExpr->getDirectCallee();
-        if (fDecl && betterTakeQLatin1String(dyn_cast<CXXMethodDecl>(fDecl), literal))
+        if (fDecl && betterTakeQLatin1String(m_context, dyn_cast<CXXMethodDecl>(fDecl), literal))
             return false;
 
         return true;
@@ -422,9 +422,9 @@ std::vector<FixItHint> QStringAllocations::fixItReplaceFromLatin1OrFromUtf8(Call
 
     StringLiteral *literal = stringLiteralForCall(callExpr);
     if (literal) {
-        if (Utils::literalContainsEscapedBytes(literal, sm(), lo()))
+        if (Utils::literalContainsEscapedBytes(m_context, literal))
             return {};
-        if (!Utils::isAscii(literal)) {
+        if (!Utils::isAscii(m_context, literal)) {
             // QString::fromLatin1() to QLatin1String() is fine
             // QString::fromUtf8() to QStringLiteral() is fine
             // all other combinations are not
@@ -451,7 +451,7 @@ std::vector<FixItHint> QStringAllocations::fixItRawLiteral(clang::StringLiteral
 {
     vector<FixItHint> fixits;
 
-    SourceRange range = clazy::rangeForLiteral(&m_astContext, lt);
+    SourceRange range = clazy::rangeForLiteral(m_astContext, lt);
     if (range.isInvalid()) {
         if (lt) {
             queueManualFixitWarning(clazy::getLocStart(lt), "Internal error: Can't calculate source location");
@@ -463,7 +463,7 @@ std::vector<FixItHint> QStringAllocations::fixItRawLiteral(clang::StringLiteral
     if (start.isMacroID()) {
         queueManualFixitWarning(start, "Can't use QStringLiteral in macro");
     } else {
-        if (Utils::literalContainsEscapedBytes(lt, sm(), lo()))
+        if (Utils::literalContainsEscapedBytes(m_context, lt))
             return {};
 
         string revisedReplacement = lt->getLength() == 0 ? "QLatin1String" : replacement; // QLatin1String("") is better than QStringLiteral("")
@@ -523,7 +523,7 @@ void QStringAllocations::VisitOperatorCall(Stmt *stm)
         if (literals.empty()) {
             queueManualFixitWarning(clazy::getLocStart(stm), "Couldn't find literal");
         } else {
-            const string replacement = Utils::isAscii(literals[0]) ? "QLatin1String" : "QStringLiteral";
+            const string replacement = Utils::isAscii(m_context, literals[0]) ? "QLatin1String" : "QStringLiteral";
             fixits = fixItRawLiteral(literals[0], replacement);
         }
     }
@@ -539,7 +539,8 @@ void QStringAllocations::VisitFromLatin1OrUtf8(Stmt *stmt)
         return;
 
     FunctionDecl *functionDecl = callExpr->getDirectCallee();
-    if (!clazy::functionIsOneOf(functionDecl, {"fromLatin1", "fromUtf8"}))
+    static const clazy::NameSet functionNames = { "fromLatin1", "fromUtf8" };
+    if (!clazy::functionIsOneOf(functionDecl, functionNames))
         return;
 
     auto methodDecl = dyn_cast<CXXMethodDecl>(functionDecl);
@@ -611,17 +612,21 @@ void QStringAllocations::VisitAssignOperatorQLatin1String(Stmt *stmt)
 
 void QStringAllocations::maybeEmitWarning(SourceLocation loc, string error, std::vector<FixItHint> fixits)
 {
-    if (clazy::isUIFile(loc, sm())) {
+    if (clazy::isUIFile(m_context->fileInfo(loc).basename())) {
         // Don't bother warning for generated UI files.
         // We do the check here instead of at the beginning so users that don't use UI files don't have to pay the performance price.
         return;
     }
 
-    if (m_context->isQtDeveloper() && Utils::filenameForLoc(loc, sm()) == "qstring.cpp") {
+    if (m_context->isQtDeveloper() && m_context->fileInfo(loc).basename() == "qstring.cpp") {
         // There's an error replacing an internal fromLatin1() because the replacement code doesn't expect to be working on QString itself
         // not worth to fix, it's only 1 case in qstring.cpp, and related to Qt 1.x compat
         fixits = {};
     }
 
+    // One allocation, and the literal converted to UTF-16
+    Stmt *stmt = m_context->traversalStack.current();
+    StringLiteral *literal = clazy::getFirstChildOfType<StringLiteral>(stmt);
+    setWasteEstimate(1, literal ? 2 * literal->getLength() : 0, stmt ? clazy::loopDepth(m_context, stmt) : 0);
     emitWarning(loc, error, fixits);
 }
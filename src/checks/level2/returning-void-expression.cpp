@@ -40,7 +40,7 @@ using namespace std;
 
 
 ReturningVoidExpression::ReturningVoidExpression(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
 {
 }
 
@@ -63,7 +63,7 @@ void RuleOfThree::VisitDecl(clang::Decl *decl)
 
     const SourceLocation recordStart = clazy::getLocStart(record);
     if (recordStart.isMacroID()) {
-        if (clazy::isInMacro(&m_astContext, recordStart, "Q_GLOBAL_STATIC_INTERNAL"))
+        if (clazy::isInMacro(m_astContext, recordStart, "Q_GLOBAL_STATIC_INTERNAL"))
             return;
     }
 
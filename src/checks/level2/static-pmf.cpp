@@ -38,7 +38,7 @@ using namespace std;
 
 
 StaticPmf::StaticPmf(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context)
+    : CheckBase(name, context, Option_Reusable)
 {
 }
 
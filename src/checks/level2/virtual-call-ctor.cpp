@@ -42,7 +42,7 @@ using namespace std;
 using namespace clang;
 
 VirtualCallCtor::VirtualCallCtor(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context)
+    : CheckBase(name, context, Option_Reusable)
 {
 }
 
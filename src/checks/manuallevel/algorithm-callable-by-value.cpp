@@ -0,0 +1,160 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "algorithm-callable-by-value.h"
+#include "FixItUtils.h"
+#include "SourceCompatibilityHelpers.h"
+#include "StringUtils.h"
+#include "TypeUtils.h"
+#include "Utils.h"
+#include "clazy_stl.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/Type.h>
+#include <clang/Basic/Diagnostic.h>
+#include <clang/Basic/LLVM.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+#include <vector>
+
+using namespace clang;
+using namespace std;
+
+AlgorithmCallableByValue::AlgorithmCallableByValue(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+}
+
+// Algorithms taking a comparator, which is called O(n log n) times by the sorting ones
+static bool isComparisonAlgorithm(StringRef name)
+{
+    static const clazy::NameSet algorithms = { "sort", "stable_sort", "partial_sort", "partial_sort_copy",
+                                               "nth_element", "is_sorted", "is_sorted_until", "lower_bound",
+                                               "upper_bound", "equal_range", "binary_search", "min_element",
+                                               "max_element", "minmax_element", "merge", "inplace_merge",
+                                               "unique", "unique_copy", "adjacent_find", "make_heap", "push_heap",
+                                               "pop_heap", "sort_heap", "includes", "set_union",
+                                               "set_intersection", "set_difference", "set_symmetric_difference",
+                                               "lexicographical_compare" };
+    return algorithms.contains(name);
+}
+
+// Algorithms calling a predicate or function once per element
+static bool isElementAlgorithm(StringRef name)
+{
+    static const clazy::NameSet algorithms = { "find_if", "find_if_not", "count_if", "all_of", "any_of", "none_of",
+                                               "remove_if", "remove_copy_if", "replace_if", "replace_copy_if",
+                                               "copy_if", "partition", "stable_partition", "partition_copy",
+                                               "partition_point", "is_partitioned", "transform", "for_each",
+                                               "accumulate", "generate" };
+    return algorithms.contains(name);
+}
+
+// QtConcurrent::map() and blockingMap() modify the elements in place, so they take them by reference already
+static bool isConcurrentAlgorithm(StringRef name)
+{
+    static const clazy::NameSet algorithms = { "mapped", "mappedReduced", "filtered", "filteredReduced", "filter",
+                                               "blockingMapped", "blockingMappedReduced", "blockingFiltered",
+                                               "blockingFilteredReduced", "blockingFilter" };
+    return algorithms.contains(name);
+}
+
+static bool isInNamespace(const FunctionDecl *func, StringRef name)
+{
+    auto ns = dyn_cast<NamespaceDecl>(func->getDeclContext());
+    return ns && clazy::name(ns) == name;
+}
+
+// The lambda passed directly as an argument, possibly copied into the parameter
+static LambdaExpr *lambdaForArg(Expr *arg)
+{
+    arg = arg->IgnoreImplicit();
+    auto construct = dyn_cast<CXXConstructExpr>(arg);
+    if (construct && construct->getNumArgs() == 1)
+        arg = construct->getArg(0)->IgnoreImplicit();
+
+    return dyn_cast<LambdaExpr>(arg);
+}
+
+void AlgorithmCallableByValue::VisitStmt(clang::Stmt *stmt)
+{
+    auto callExpr = dyn_cast<CallExpr>(stmt);
+    FunctionDecl *func = callExpr ? callExpr->getDirectCallee() : nullptr;
+    if (!func || isa<CXXMethodDecl>(func))
+        return;
+
+    const StringRef name = clazy::name(func);
+    string algorithm;
+    bool isComparison = false;
+    if (func->isInStdNamespace() && (isComparisonAlgorithm(name) || isElementAlgorithm(name))) {
+        algorithm = "std::" + name.str();
+        isComparison = isComparisonAlgorithm(name);
+    } else if (isInNamespace(func, "QtConcurrent") && isConcurrentAlgorithm(name)) {
+        algorithm = "QtConcurrent::" + name.str();
+    } else {
+        return;
+    }
+
+    for (Expr *arg : callExpr->arguments()) {
+        if (LambdaExpr *lambda = lambdaForArg(arg))
+            checkLambda(lambda, algorithm, isComparison);
+    }
+}
+
+void AlgorithmCallableByValue::checkLambda(LambdaExpr *lambda, const std::string &algorithm, bool isComparison)
+{
+    CXXMethodDecl *callOperator = lambda->getCallOperator();
+    Stmt *body = callOperator ? callOperator->getBody() : nullptr;
+    if (!body)
+        return;
+
+    for (ParmVarDecl *param : Utils::functionParameters(callOperator)) {
+        const QualType paramType = param->getType();
+        if (paramType.isNull() || paramType->isReferenceType() || paramType->isDependentType()
+            || paramType->isIncompleteType())
+            continue;
+
+        // Not warned about if the body modifies or moves the copy
+        clazy::QualTypeClassification classif;
+        if (!clazy::classifyQualType(m_context, paramType, param, classif, body)
+            || !(classif.passBigTypeByConstRef || classif.passNonTriviallyCopyableByConstRef)
+            || Utils::isMovedFrom(body, param))
+            continue;
+
+        vector<FixItHint> fixits;
+        const SourceLocation start = clazy::getLocStart(param);
+        if (fixitsEnabled() && !param->getName().empty() && !start.isMacroID() && !param->getLocation().isMacroID()) {
+            if (!paramType.isConstQualified())
+                fixits.push_back(clazy::createInsertion(start, "const "));
+            fixits.push_back(clazy::createInsertion(param->getLocation(), "&"));
+        }
+
+        emitWarning(start, algorithm + "() copies the " + clazy::simpleTypeName(paramType.getUnqualifiedType(), lo())
+                    + (isComparison ? " argument on each comparison" : " argument for each element")
+                    + "; take it by const-ref", fixits);
+    }
+}
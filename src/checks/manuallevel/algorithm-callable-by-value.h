@@ -0,0 +1,53 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_ALGORITHM_CALLABLE_BY_VALUE_H
+#define CLAZY_ALGORITHM_CALLABLE_BY_VALUE_H
+
+#include "checkbase.h"
+
+#include <string>
+
+class ClazyContext;
+
+namespace clang {
+class LambdaExpr;
+class Stmt;
+}
+
+/**
+ * Finds lambdas passed to std algorithms and QtConcurrent which take large or non-trivially copyable
+ * parameters by value, so each comparison or element copies them.
+ *
+ * See README-algorithm-callable-by-value.md for more info.
+ */
+class AlgorithmCallableByValue
+    : public CheckBase
+{
+public:
+    explicit AlgorithmCallableByValue(const std::string &name, ClazyContext *context);
+    void VisitStmt(clang::Stmt *stmt) override;
+private:
+    void checkLambda(clang::LambdaExpr *lambda, const std::string &algorithm, bool isComparison);
+};
+
+#endif
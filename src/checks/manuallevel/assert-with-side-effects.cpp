@@ -82,7 +82,7 @@ static bool methodIsOK(const string &name)
 void AssertWithSideEffects::VisitStmt(Stmt *stm)
 {
     const SourceLocation stmStart = clazy::getLocStart(stm);
-    if (!clazy::isInMacro(&m_astContext, stmStart, "Q_ASSERT"))
+    if (!clazy::isInMacro(m_astContext, stmStart, "Q_ASSERT"))
         return;
 
     bool warn = false;
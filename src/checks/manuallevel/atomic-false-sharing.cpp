@@ -0,0 +1,225 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "atomic-false-sharing.h"
+#include "SourceCompatibilityHelpers.h"
+#include "StringUtils.h"
+#include "TemplateUtils.h"
+#include "clazy_stl.h"
+
+#include <clang/AST/ASTContext.h>
+#include <clang/AST/CharUnits.h>
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/DeclTemplate.h>
+#include <clang/AST/RecordLayout.h>
+#include <clang/AST/Type.h>
+#include <clang/Basic/SourceManager.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace clang;
+using namespace std;
+
+// The common size on x86 and ARM, std::hardware_destructive_interference_size isn't available everywhere
+static const int64_t s_cacheLineSize = 64;
+
+AtomicFalseSharing::AtomicFalseSharing(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+}
+
+static bool isAtomicClass(const CXXRecordDecl *record)
+{
+    if (!record)
+        return false;
+
+    const StringRef name = clazy::name(record);
+    if (record->isInStdNamespace())
+        return name == "atomic" || name == "atomic_flag";
+
+    static const clazy::NameSet qtClasses = { "QAtomicInt", "QAtomicInteger", "QAtomicPointer", "QBasicAtomicInt",
+                                              "QBasicAtomicInteger", "QBasicAtomicPointer" };
+    return qtClasses.contains(name);
+}
+
+static bool isAtomic(QualType type)
+{
+    return isAtomicClass(type->getAsCXXRecordDecl());
+}
+
+static bool containsAtomic(const CXXRecordDecl *record, int depth = 0)
+{
+    record = record ? record->getDefinition() : nullptr;
+    if (!record || depth > 3)
+        return false;
+
+    for (const FieldDecl *field : record->fields()) {
+        const Type *type = field->getType()->getBaseElementTypeUnsafe();
+        if (isAtomicClass(type->getAsCXXRecordDecl()) || containsAtomic(type->getAsCXXRecordDecl(), depth + 1))
+            return true;
+    }
+
+    return false;
+}
+
+// Containers storing their elements contiguously
+static QualType arrayElementType(const ASTContext &astContext, QualType type, int64_t &count)
+{
+    count = -1;
+    if (const ConstantArrayType *arrayType = astContext.getAsConstantArrayType(type)) {
+        count = static_cast<int64_t>(arrayType->getSize().getZExtValue());
+        return arrayType->getElementType();
+    }
+
+    auto specialization = dyn_cast_or_null<ClassTemplateSpecializationDecl>(type->getAsCXXRecordDecl());
+    if (!specialization)
+        return {};
+
+    static const clazy::NameSet qtContainers = { "QVector", "QVarLengthArray" };
+    static const clazy::NameSet stdContainers = { "vector", "array", "deque" };
+    const StringRef name = clazy::name(specialization);
+    if ((specialization->isInStdNamespace() && stdContainers.contains(name)) || qtContainers.contains(name))
+        return clazy::getTemplateArgumentType(specialization, 0);
+
+    return {};
+}
+
+// Returns true if the bytes at offsets first and last of an object aligned to alignment can be on the same cache line
+static bool mayShareCacheLine(int64_t first, int64_t last, int64_t alignment)
+{
+    for (int64_t start = 0; start < s_cacheLineSize; start += alignment) {
+        if ((start + first) / s_cacheLineSize == (start + last) / s_cacheLineSize)
+            return true;
+    }
+
+    return false;
+}
+
+namespace {
+
+struct AtomicMember {
+    const FieldDecl *field;
+    int64_t begin;
+    int64_t end;
+    bool isArray;
+};
+
+}
+
+void AtomicFalseSharing::VisitDecl(clang::Decl *decl)
+{
+    if (auto record = dyn_cast<CXXRecordDecl>(decl))
+        checkRecord(record);
+    else if (isa<FieldDecl>(decl) || (isa<VarDecl>(decl) && !isa<ParmVarDecl>(decl)))
+        checkArray(cast<DeclaratorDecl>(decl));
+}
+
+void AtomicFalseSharing::checkRecord(CXXRecordDecl *record)
+{
+    if (!record->isThisDeclarationADefinition() || record->isInvalidDecl() || record->isDependentType()
+        || record->isUnion() || record->isLambda() || isAtomicClass(record)
+        || sm().isInSystemHeader(clazy::getLocStart(record)))
+        return;
+
+    const ASTRecordLayout &layout = m_astContext->getASTRecordLayout(record);
+    vector<AtomicMember> atomics;
+    for (const FieldDecl *field : record->fields()) {
+        QualType type = field->getType();
+        int64_t count = 1;
+        if (const ConstantArrayType *arrayType = m_astContext->getAsConstantArrayType(type)) {
+            count = static_cast<int64_t>(arrayType->getSize().getZExtValue());
+            type = arrayType->getElementType();
+        }
+
+        if (field->isBitField() || type->isDependentType() || !isAtomic(type))
+            continue;
+
+        const int64_t begin = m_astContext->toCharUnitsFromBits(layout.getFieldOffset(field->getFieldIndex())).getQuantity();
+        const int64_t elementSize = m_astContext->getTypeSizeInChars(type).getQuantity();
+        atomics.push_back({ field, begin, begin + count * elementSize, count > 1 && elementSize < s_cacheLineSize });
+    }
+
+    // Sorted by offset already, as fields are laid out in declaration order
+    const int64_t alignment = std::min(layout.getAlignment().getQuantity(), s_cacheLineSize);
+    auto mayShare = [alignment](const AtomicMember &m1, const AtomicMember &m2) {
+        return mayShareCacheLine(m1.end - 1, m2.begin, alignment);
+    };
+
+    vector<const FieldDecl *> sharing;
+    for (unsigned int i = 0; i < atomics.size(); ++i) {
+        const bool nearPrevious = i > 0 && mayShare(atomics[i - 1], atomics[i]);
+        const bool nearNext = i + 1 < atomics.size() && mayShare(atomics[i], atomics[i + 1]);
+        if (nearPrevious || nearNext || atomics[i].isArray)
+            sharing.push_back(atomics[i].field);
+    }
+
+    if (sharing.empty())
+        return;
+
+    string names;
+    for (const FieldDecl *field : sharing) {
+        if (!names.empty())
+            names += ", ";
+        names += clazy::name(field).str();
+    }
+
+    emitWarning(clazy::getLocStart(record), clazy::name(record).str() + " has atomic members within "
+                + to_string(s_cacheLineSize) + " bytes of each other (" + names + "); if different threads write them, "
+                "align them with alignas(std::hardware_destructive_interference_size) or split the struct");
+}
+
+void AtomicFalseSharing::checkArray(DeclaratorDecl *decl)
+{
+    const QualType type = decl->getType();
+    if (type.isNull() || type->isDependentType())
+        return;
+
+    int64_t count = 0;
+    const QualType elementType = arrayElementType(*m_astContext, type, count);
+    const CXXRecordDecl *record = elementType.isNull() ? nullptr : elementType->getAsCXXRecordDecl();
+    if (!record || elementType->isDependentType() || elementType->isIncompleteType() || count == 0 || count == 1)
+        return;
+
+    // Arrays of atomics which are members are warned about with their record
+    const bool isArrayOfAtomics = isAtomicClass(record);
+    if (isArrayOfAtomics ? isa<FieldDecl>(decl) : !containsAtomic(record))
+        return;
+
+    // Elements which are cache line aligned, or bigger, don't share one with their neighbours
+    const int64_t size = m_astContext->getTypeSizeInChars(elementType).getQuantity();
+    if (size >= s_cacheLineSize || m_astContext->getTypeAlignInChars(elementType).getQuantity() >= s_cacheLineSize)
+        return;
+
+    const string elementName = clazy::simpleTypeName(elementType, lo());
+    if (isArrayOfAtomics) {
+        emitWarning(decl->getLocation(), "array of " + elementName + ", whose neighbouring elements share cache lines; "
+                    "if different threads write them, wrap the atomic in a struct aligned with alignas(std::hardware_destructive_interference_size)");
+    } else {
+        emitWarning(decl->getLocation(), "array of " + elementName + ", which is " + to_string(size)
+                    + " bytes and has atomic members, so neighbouring elements share cache lines; if different threads write them, "
+                    "align " + elementName + " with alignas(std::hardware_destructive_interference_size)");
+    }
+}
@@ -0,0 +1,357 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "atomic-memory-order.h"
+#include "ClazyContext.h"
+#include "HierarchyUtils.h"
+#include "LoopUtils.h"
+#include "SourceCompatibilityHelpers.h"
+#include "StmtIndex.h"
+#include "StringUtils.h"
+#include "clazy_stl.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/StmtCXX.h>
+#include <clang/AST/Type.h>
+#include <clang/Basic/LLVM.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace clang;
+using namespace std;
+
+enum AtomicOperationKind {
+    Atomic_Read,
+    Atomic_Increment,
+    Atomic_ReadModifyWrite, // Anything else which writes, including decrements and stores
+};
+
+struct AtomicOperation
+{
+    AtomicOperationKind kind = Atomic_ReadModifyWrite;
+    const ValueDecl *object = nullptr; // The field or variable, if it's one
+    bool isQt = false;
+    bool isOrdered = false; // std::memory_order_seq_cst or QAtomicInteger's ordered variants
+    std::string name;
+};
+
+AtomicMemoryOrder::AtomicMemoryOrder(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+}
+
+static bool isAtomicClass(const CXXRecordDecl *record, bool &isQt)
+{
+    if (!record)
+        return false;
+
+    const StringRef name = clazy::name(record);
+    isQt = !record->isInStdNamespace();
+    if (!isQt)
+        return name == "atomic" || name == "atomic_flag";
+
+    static const clazy::NameSet qtClasses = { "QAtomicInt", "QAtomicInteger", "QBasicAtomicInt", "QBasicAtomicInteger" };
+    return qtClasses.contains(name);
+}
+
+static unsigned int numExplicitArgs(const CallExpr *call)
+{
+    return static_cast<unsigned int>(std::count_if(call->arg_begin(), call->arg_end(), [](const Expr *arg) {
+        return !isa<CXXDefaultArgExpr>(arg);
+    }));
+}
+
+static const ValueDecl *declForObject(Expr *object)
+{
+    if (auto memberExpr = dyn_cast<MemberExpr>(object))
+        return memberExpr->getMemberDecl();
+
+    auto declRef = dyn_cast<DeclRefExpr>(object);
+    return declRef ? declRef->getDecl() : nullptr;
+}
+
+// Returns true if call is a member call, or member operator call, on a std::atomic or QAtomicInteger
+static bool atomicOperation(CallExpr *call, AtomicOperation &operation)
+{
+    auto method = dyn_cast_or_null<CXXMethodDecl>(call->getDirectCallee());
+    Expr *object = nullptr;
+    if (auto memberCall = dyn_cast<CXXMemberCallExpr>(call))
+        object = memberCall->getImplicitObjectArgument();
+    else if (isa<CXXOperatorCallExpr>(call) && call->getNumArgs() > 0)
+        object = call->getArg(0);
+
+    if (!method || !object)
+        return false;
+
+    object = object->IgnoreParenImpCasts();
+    QualType type = object->getType();
+    if (type->isPointerType())
+        type = type->getPointeeType();
+
+    if (!isAtomicClass(type->getAsCXXRecordDecl(), operation.isQt))
+        return false;
+
+    operation.object = declForObject(object);
+    const OverloadedOperatorKind op = method->getOverloadedOperator();
+    if (op == OO_PlusPlus || op == OO_PlusEqual) {
+        operation.kind = Atomic_Increment;
+        operation.isOrdered = true;
+        operation.name = op == OO_PlusPlus ? "operator++" : "operator+=";
+        return true;
+    }
+
+    if (isa<CXXConversionDecl>(method)) {
+        operation.kind = Atomic_Read;
+        operation.name = "load";
+        return true;
+    }
+
+    operation.name = clazy::name(method).str();
+    const StringRef name = operation.name;
+    if (operation.isQt) {
+        if (name == "ref" || name.startswith("fetchAndAdd")) {
+            operation.kind = Atomic_Increment;
+            operation.isOrdered = name == "ref" || name == "fetchAndAddOrdered";
+        } else if (name.startswith("load")) {
+            operation.kind = Atomic_Read;
+        }
+    } else if (name == "fetch_add") {
+        operation.kind = Atomic_Increment;
+        operation.isOrdered = numExplicitArgs(call) < 2; // No std::memory_order argument
+    } else if (name == "load" || name == "test" || name == "is_lock_free") {
+        operation.kind = Atomic_Read;
+    }
+
+    return true;
+}
+
+// Returns true if the value of expr isn't used, such as in "counter++;"
+static bool isDiscarded(const ClazyContext *context, Stmt *expr)
+{
+    Stmt *child = expr;
+    Stmt *parent = clazy::parent(context, expr);
+    while (parent && (isa<ExprWithCleanups>(parent) || isa<ParenExpr>(parent)
+                      || (isa<CastExpr>(parent) && cast<CastExpr>(parent)->getType()->isVoidType()))) {
+        child = parent;
+        parent = clazy::parent(context, parent);
+    }
+
+    if (!parent)
+        return false;
+
+    if (isa<CompoundStmt>(parent) || clazy::bodyFromLoop(parent) == child)
+        return true;
+
+    if (auto forStmt = dyn_cast<ForStmt>(parent))
+        return forStmt->getInc() == child;
+
+    auto ifStmt = dyn_cast<IfStmt>(parent);
+    return ifStmt && (ifStmt->getThen() == child || ifStmt->getElse() == child);
+}
+
+static bool isNonLocal(Expr *expr)
+{
+    expr = expr->IgnoreParenImpCasts();
+    if (isa<MemberExpr>(expr))
+        return true;
+
+    auto declRef = dyn_cast<DeclRefExpr>(expr);
+    auto varDecl = declRef ? dyn_cast<VarDecl>(declRef->getDecl()) : nullptr;
+    return varDecl && varDecl->hasGlobalStorage();
+}
+
+// Returns true if body assigns to a member or a global, besides the atomics
+static bool writesNonLocal(Stmt *body, const StmtIndex *index)
+{
+    for (BinaryOperator *binaryOperator : index->statementsOfType<BinaryOperator>(body)) {
+        if (binaryOperator->isAssignmentOp() && isNonLocal(binaryOperator->getLHS()))
+            return true;
+    }
+
+    for (UnaryOperator *unaryOperator : index->statementsOfType<UnaryOperator>(body)) {
+        if (unaryOperator->isIncrementDecrementOp() && isNonLocal(unaryOperator->getSubExpr()))
+            return true;
+    }
+
+    for (CXXOperatorCallExpr *operatorCall : index->statementsOfType<CXXOperatorCallExpr>(body)) {
+        AtomicOperation operation;
+        if (operatorCall->isAssignmentOp() && operatorCall->getNumArgs() > 0 && isNonLocal(operatorCall->getArg(0))
+            && !atomicOperation(operatorCall, operation))
+            return true;
+    }
+
+    return false;
+}
+
+void AtomicMemoryOrder::VisitStmt(clang::Stmt *stmt)
+{
+    if (auto call = dyn_cast<CallExpr>(stmt))
+        checkCounter(call);
+    else
+        checkSpinLoop(stmt);
+}
+
+void AtomicMemoryOrder::checkCounter(CallExpr *call)
+{
+    AtomicOperation operation;
+    if (!atomicOperation(call, operation) || operation.kind != Atomic_Increment || !operation.isOrdered
+        || !operation.object || !isDiscarded(m_context, call))
+        return;
+
+    // The function must only increment and read the counter, and use other atomics only as counters too.
+    // An increment next to stores, or to other atomic operations, might be publishing them.
+    const StmtIndex *index = m_context->functionStmtIndex(call);
+    Stmt *body = index ? index->root() : nullptr;
+    if (!body || writesNonLocal(body, index))
+        return;
+
+    unsigned int numOperations = 0;
+    for (CallExpr *otherCall : index->statementsOfType<CallExpr>(body)) {
+        AtomicOperation other;
+        if (!atomicOperation(otherCall, other))
+            continue;
+
+        if (other.kind == Atomic_ReadModifyWrite || (other.object != operation.object && other.kind != Atomic_Increment))
+            return;
+
+        if (other.object == operation.object)
+            ++numOperations;
+    }
+
+    // Otherwise the counter is passed to a function, or has its address taken
+    unsigned int numReferences = 0;
+    for (MemberExpr *memberExpr : index->statementsOfType<MemberExpr>(body)) {
+        if (memberExpr->getMemberDecl() == operation.object)
+            ++numReferences;
+    }
+
+    for (DeclRefExpr *declRef : index->statementsOfType<DeclRefExpr>(body)) {
+        if (declRef->getDecl() == operation.object)
+            ++numReferences;
+    }
+
+    if (numReferences != numOperations)
+        return;
+
+    if (operation.isQt) {
+        emitWarning(clazy::getLocStart(call), "atomic counter incremented with ordered semantics; use fetchAndAddRelaxed() if nothing synchronizes on it");
+    } else {
+        emitWarning(clazy::getLocStart(call), "atomic counter incremented with sequentially consistent ordering; use fetch_add() with std::memory_order_relaxed if nothing synchronizes on it");
+    }
+}
+
+static bool isConstant(Expr *expr)
+{
+    expr = expr->IgnoreParenImpCasts();
+    if (isa<IntegerLiteral>(expr) || isa<CXXBoolLiteralExpr>(expr) || isa<CXXNullPtrLiteralExpr>(expr)
+        || isa<CXXDefaultArgExpr>(expr))
+        return true;
+
+    // std::memory_order_acquire is an enumerator, or a constexpr variable since C++20
+    auto declRef = dyn_cast<DeclRefExpr>(expr);
+    auto varDecl = declRef ? dyn_cast<VarDecl>(declRef->getDecl()) : nullptr;
+    return declRef && (isa<EnumConstantDecl>(declRef->getDecl()) || (varDecl && varDecl->isConstexpr()));
+}
+
+// Locks store a constant, like test_and_set() or testAndSetAcquire(0, 1). A compare-and-swap storing a
+// computed value is a lock-free update instead, which only retries when another thread won the race.
+static bool storesConstant(CallExpr *call, const AtomicOperation &operation)
+{
+    const bool hasExpectedReference = !operation.isQt && StringRef(operation.name).startswith("compare_exchange");
+    for (unsigned int i = hasExpectedReference ? 1 : 0; i < call->getNumArgs(); ++i) {
+        if (!isConstant(call->getArg(i)))
+            return false;
+    }
+
+    return true;
+}
+
+static Expr *loopCondition(Stmt *loop)
+{
+    if (auto whileStmt = dyn_cast<WhileStmt>(loop))
+        return whileStmt->getCond();
+    if (auto doStmt = dyn_cast<DoStmt>(loop))
+        return doStmt->getCond();
+
+    auto forStmt = dyn_cast<ForStmt>(loop);
+    return forStmt ? forStmt->getCond() : nullptr;
+}
+
+void AtomicMemoryOrder::checkSpinLoop(Stmt *loop)
+{
+    Expr *cond = loopCondition(loop);
+    Stmt *body = clazy::bodyFromLoop(loop);
+    if (!cond || !body)
+        return;
+
+    // Waits until the condition, which reads an atomic, changes
+    std::string readModifyWrite;
+    bool conditionIsAtomic = false;
+    vector<CallExpr *> conditionCalls;
+    clazy::getChilds<CallExpr>(cond, conditionCalls);
+    for (CallExpr *call : conditionCalls) {
+        AtomicOperation operation;
+        if (!atomicOperation(call, operation))
+            return;
+
+        conditionIsAtomic = true;
+        if (operation.kind != Atomic_ReadModifyWrite)
+            continue;
+
+        if (!storesConstant(call, operation))
+            return;
+
+        if (readModifyWrite.empty())
+            readModifyWrite = operation.name;
+    }
+
+    if (!conditionIsAtomic)
+        return;
+
+    // Any other call is either a pause, a yield, a sleep, or real work. Writing to an atomic means the
+    // loop isn't only waiting for other threads.
+    vector<CallExpr *> bodyCalls;
+    clazy::getChilds<CallExpr>(body, bodyCalls);
+    for (CallExpr *call : bodyCalls) {
+        AtomicOperation operation;
+        if (!atomicOperation(call, operation) || operation.kind == Atomic_ReadModifyWrite)
+            return;
+    }
+
+    vector<AsmStmt *> asmStmts;
+    clazy::getChilds<AsmStmt>(body, asmStmts);
+    if (!asmStmts.empty())
+        return;
+
+    if (readModifyWrite.empty()) {
+        emitWarning(clazy::getLocStart(loop), "spin loop without a pause or yield; call _mm_pause() or std::this_thread::yield() in its body");
+    } else {
+        emitWarning(clazy::getLocStart(loop), "spin loop retries " + readModifyWrite + "() without a pause or yield; call _mm_pause() or std::this_thread::yield(), and wait for a relaxed load to see the change before retrying");
+    }
+}
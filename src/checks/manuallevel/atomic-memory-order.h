@@ -0,0 +1,54 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_ATOMIC_MEMORY_ORDER_H
+#define CLAZY_ATOMIC_MEMORY_ORDER_H
+
+#include "checkbase.h"
+
+#include <string>
+
+class ClazyContext;
+
+namespace clang {
+class CallExpr;
+class Stmt;
+}
+
+/**
+ * Finds atomic counters incremented with sequentially consistent, or ordered, semantics when nothing
+ * synchronizes on them, and spin loops on atomics without a pause or yield.
+ *
+ * See README-atomic-memory-order.md for more info.
+ */
+class AtomicMemoryOrder
+    : public CheckBase
+{
+public:
+    explicit AtomicMemoryOrder(const std::string &name, ClazyContext *context);
+    void VisitStmt(clang::Stmt *stmt) override;
+private:
+    void checkCounter(clang::CallExpr *call);
+    void checkSpinLoop(clang::Stmt *loop);
+};
+
+#endif
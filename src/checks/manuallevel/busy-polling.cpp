@@ -0,0 +1,292 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "busy-polling.h"
+#include "ClazyContext.h"
+#include "HierarchyUtils.h"
+#include "QtUtils.h"
+#include "SourceCompatibilityHelpers.h"
+#include "StringUtils.h"
+
+#include <clang/AST/ASTContext.h>
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/StmtCXX.h>
+#include <clang/Basic/LLVM.h>
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+using namespace clang;
+using namespace std;
+
+// Intervals up to this many milliseconds only make sense for animations, which don't poll
+static const uint64_t s_maxInterval = 10;
+
+BusyPolling::BusyPolling(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes)
+{
+}
+
+static Expr *ignoreVoidCast(Expr *expr)
+{
+    expr = expr->IgnoreImplicit();
+    if (auto cast = dyn_cast<CStyleCastExpr>(expr))
+        expr = cast->getSubExpr()->IgnoreImplicit();
+    return expr;
+}
+
+// QThread::sleep(), std::this_thread::sleep_for(), usleep() and friends
+static FunctionDecl *sleepFunction(Stmt *stmt)
+{
+    auto expr = dyn_cast<Expr>(stmt);
+    auto call = expr ? dyn_cast<CallExpr>(ignoreVoidCast(expr)) : nullptr;
+    FunctionDecl *func = call ? call->getDirectCallee() : nullptr;
+    if (!func)
+        return nullptr;
+
+    const StringRef name = clazy::name(func);
+    if (auto method = dyn_cast<CXXMethodDecl>(func)) {
+        static const clazy::NameSet qthreadSleeps = { "sleep", "msleep", "usleep" };
+        return method->isStatic() && qthreadSleeps.contains(name) && clazy::name(method->getParent()) == "QThread" ? func : nullptr;
+    }
+
+    auto ns = dyn_cast<NamespaceDecl>(func->getDeclContext());
+    if (ns && ns->getName() == "this_thread" && ns->getParent()->isStdNamespace())
+        return name == "sleep_for" || name == "sleep_until" ? func : nullptr;
+
+    static const clazy::NameSet cSleeps = { "sleep", "usleep", "nanosleep", "Sleep" };
+    return func->isExternC() && cSleeps.contains(name) ? func : nullptr;
+}
+
+static bool isProcessEvents(Stmt *stmt)
+{
+    auto expr = dyn_cast<Expr>(stmt);
+    auto call = expr ? dyn_cast<CallExpr>(ignoreVoidCast(expr)) : nullptr;
+    auto method = call ? dyn_cast_or_null<CXXMethodDecl>(call->getDirectCallee()) : nullptr;
+    return method && clazy::name(method) == "processEvents";
+}
+
+// if (done) break;
+static bool isExitCheck(Stmt *stmt)
+{
+    auto ifStmt = dyn_cast<IfStmt>(stmt);
+    if (!ifStmt || ifStmt->getElse())
+        return false;
+
+    Stmt *then = ifStmt->getThen();
+    if (auto compound = dyn_cast<CompoundStmt>(then))
+        then = compound->size() == 1 ? compound->body_back() : nullptr;
+    return then && (isa<BreakStmt>(then) || isa<ReturnStmt>(then));
+}
+
+void BusyPolling::checkSleepLoop(Stmt *loop)
+{
+    Stmt *body = nullptr;
+    Expr *cond = nullptr;
+    if (auto whileStmt = dyn_cast<WhileStmt>(loop)) {
+        body = whileStmt->getBody();
+        cond = whileStmt->getCond();
+    } else if (auto doStmt = dyn_cast<DoStmt>(loop)) {
+        body = doStmt->getBody();
+        cond = doStmt->getCond();
+    } else if (auto forStmt = dyn_cast<ForStmt>(loop)) {
+        if (forStmt->getInc()) // Retrying n times, or a delay, not waiting for something
+            return;
+        body = forStmt->getBody();
+        cond = forStmt->getCond();
+    }
+
+    if (!body || (cond && cond->isValueDependent()))
+        return;
+
+    // Only a sleep, and checks for the condition, anything else is work done periodically
+    Stmt *sleep = nullptr;
+    FunctionDecl *sleepFunc = nullptr;
+    bool hasExitCheck = false;
+    auto compound = dyn_cast<CompoundStmt>(body);
+    const ArrayRef<Stmt *> statements = compound ? ArrayRef<Stmt *>(compound->body_begin(), compound->body_end())
+                                                 : ArrayRef<Stmt *>(body);
+    for (Stmt *stmt : statements) {
+        if (FunctionDecl *func = sleepFunction(stmt)) {
+            if (sleep)
+                return;
+            sleep = stmt;
+            sleepFunc = func;
+        } else if (isExitCheck(stmt)) {
+            hasExitCheck = true;
+        } else if (!isa<NullStmt>(stmt) && !isProcessEvents(stmt)) {
+            return;
+        }
+    }
+
+    // while (true) { msleep(100); } isn't waiting for anything
+    bool constantCondition = true;
+    if (!sleep || (!hasExitCheck && (!cond || cond->EvaluateAsBooleanCondition(constantCondition, *m_astContext))))
+        return;
+
+    emitFormattedWarning(clazy::getLocStart(sleep), "Polling with %0() in a loop burns CPU time and adds latency; wait on a "
+                         "QWaitCondition or std::condition_variable, or react to a signal, like QFutureWatcher::finished(), instead",
+                         { clazy::qualifiedMethodName(sleepFunc) });
+}
+
+// The variable or member an expression names, through &timer and such
+static const ValueDecl *namedDecl(Expr *expr)
+{
+    expr = expr ? expr->IgnoreParenImpCasts() : nullptr;
+    if (auto unary = dyn_cast_or_null<UnaryOperator>(expr)) {
+        if (unary->getOpcode() == UO_AddrOf)
+            expr = unary->getSubExpr()->IgnoreParenImpCasts();
+    }
+
+    if (auto declRef = dyn_cast_or_null<DeclRefExpr>(expr))
+        return declRef->getDecl();
+    if (auto member = dyn_cast_or_null<MemberExpr>(expr))
+        return member->getMemberDecl();
+    return nullptr;
+}
+
+// Returns true if cond calls QFuture::isFinished(), QFile::exists() and such, or reads a bool or atomic flag
+static bool queriesState(Stmt *cond)
+{
+    static const clazy::NameSet queries = { "isFinished", "isRunning", "isCanceled", "isResultReadyAt", "resultCount", "exists",
+                                            "bytesAvailable", "canReadLine", "atEnd", "state", "load", "loadAcquire",
+                                            "loadRelaxed", "lastModified" };
+    if (!cond)
+        return false;
+
+    if (auto memberCall = dyn_cast<CXXMemberCallExpr>(cond)) {
+        CXXMethodDecl *method = memberCall->getMethodDecl();
+        if (method && queries.contains(clazy::name(method)))
+            return true;
+
+        // if (m_done), with a std::atomic<bool>
+        const StringRef className = method ? clazy::name(method->getParent()) : StringRef();
+        if (dyn_cast_or_null<CXXConversionDecl>(method)
+            && (className.contains("atomic") || className.startswith("QAtomic") || className.startswith("QBasicAtomic")))
+            return true;
+    } else if (auto call = dyn_cast<CallExpr>(cond)) {
+        FunctionDecl *func = call->getDirectCallee();
+        if (func && queries.contains(clazy::name(func))) // QFileInfo::exists()
+            return true;
+    } else if (isa<MemberExpr>(cond) || isa<DeclRefExpr>(cond)) {
+        if (cast<Expr>(cond)->getType()->isBooleanType())
+            return true;
+    }
+
+    for (Stmt *child : cond->children()) {
+        if (queriesState(child))
+            return true;
+    }
+
+    return false;
+}
+
+// Returns true if body connects timer's timeout() to a slot or lambda starting with a state check
+bool BusyPolling::findPollingSlot(Stmt *body, const ValueDecl *timer, std::string &slotName) const
+{
+    for (CallExpr *call : clazy::getStatements<CallExpr>(body)) {
+        FunctionDecl *func = call->getDirectCallee();
+        if (!func || !clazy::isConnect(func) || !clazy::connectHasPMFStyle(func) || call->getNumArgs() < 3
+            || namedDecl(call->getArg(0)) != timer)
+            continue;
+
+        CXXMethodDecl *signal = clazy::pmfFromConnect(call, 1);
+        if (!signal || clazy::name(signal) != "timeout")
+            continue;
+
+        Stmt *slotBody = nullptr;
+        if (CXXMethodDecl *slot = clazy::receiverMethodForConnect(call)) {
+            const FunctionDecl *definition = nullptr;
+            if (slot->hasBody(definition))
+                slotBody = definition->getBody();
+            slotName = clazy::qualifiedMethodName(slot) + "()";
+        } else {
+            // connect(timer, &QTimer::timeout, [] { ... }), or with a context object before the lambda
+            for (unsigned int i = 2; i < call->getNumArgs() && !slotBody; ++i) {
+                Expr *arg = call->getArg(i)->IgnoreImplicit();
+                auto lambda = isa<LambdaExpr>(arg) ? cast<LambdaExpr>(arg) : clazy::getFirstChildOfType2<LambdaExpr>(arg);
+                if (lambda) {
+                    slotBody = lambda->getBody();
+                    slotName = "a lambda";
+                }
+            }
+        }
+
+        auto compound = dyn_cast_or_null<CompoundStmt>(slotBody);
+        auto ifStmt = compound && !compound->body_empty() ? dyn_cast<IfStmt>(compound->body_front()) : nullptr;
+        if (ifStmt && queriesState(ifStmt->getCond()))
+            return true;
+    }
+
+    return false;
+}
+
+void BusyPolling::checkTimer(CXXMemberCallExpr *call)
+{
+    CXXMethodDecl *method = call->getMethodDecl();
+    if (!method || call->getNumArgs() != 1 || clazy::name(method->getParent()) != "QTimer")
+        return;
+
+    const StringRef methodName = clazy::name(method);
+    if (methodName != "start" && methodName != "setInterval")
+        return;
+
+    // Only plain milliseconds, std::chrono durations aren't literals
+    auto literal = dyn_cast<IntegerLiteral>(call->getArg(0)->IgnoreParenImpCasts());
+    const ValueDecl *timer = namedDecl(call->getImplicitObjectArgument());
+    if (!literal || !timer || literal->getValue().getZExtValue() > s_maxInterval)
+        return;
+
+    // It's usually connected where it's created, which for members is often another method, like the constructor
+    string slotName;
+    FunctionDecl *function = m_context->lastFunctionDecl;
+    bool polls = function && findPollingSlot(function->getBody(), timer, slotName);
+    auto record = !polls && isa<FieldDecl>(timer) ? dyn_cast<CXXRecordDecl>(timer->getDeclContext()) : nullptr;
+    if (record) {
+        for (CXXMethodDecl *other : record->methods()) {
+            const FunctionDecl *definition = nullptr;
+            if (other != function && other->hasBody(definition) && findPollingSlot(definition->getBody(), timer, slotName)) {
+                polls = true;
+                break;
+            }
+        }
+    }
+
+    if (!polls)
+        return;
+
+    emitFormattedWarning(clazy::getLocStart(call), "QTimer with a %0 ms interval polls in %1; use a QFutureWatcher, "
+                         "QSocketNotifier or QFileSystemWatcher, or a condition variable, to be notified instead",
+                         { std::to_string(literal->getValue().getZExtValue()), slotName });
+}
+
+void BusyPolling::VisitStmt(clang::Stmt *stmt)
+{
+    if (auto memberCall = dyn_cast<CXXMemberCallExpr>(stmt))
+        checkTimer(memberCall);
+    else
+        checkSleepLoop(stmt);
+}
@@ -0,0 +1,56 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_BUSY_POLLING_H
+#define CLAZY_BUSY_POLLING_H
+
+#include "checkbase.h"
+
+#include <string>
+
+class ClazyContext;
+
+namespace clang {
+class CXXMemberCallExpr;
+class Stmt;
+class ValueDecl;
+}
+
+/**
+ * Finds loops which sleep until a condition changes, and QTimers with very short intervals whose timeout slot
+ * starts by checking a flag, a file, a socket or a QFuture, instead of being notified.
+ *
+ * See README-busy-polling.md for more info.
+ */
+class BusyPolling
+    : public CheckBase
+{
+public:
+    explicit BusyPolling(const std::string &name, ClazyContext *context);
+    void VisitStmt(clang::Stmt *stmt) override;
+private:
+    void checkSleepLoop(clang::Stmt *loop);
+    void checkTimer(clang::CXXMemberCallExpr *call);
+    bool findPollingSlot(clang::Stmt *body, const clang::ValueDecl *timer, std::string &slotName) const;
+};
+
+#endif
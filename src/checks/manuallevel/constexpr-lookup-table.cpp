@@ -0,0 +1,219 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "constexpr-lookup-table.h"
+#include "HierarchyUtils.h"
+#include "QtUtils.h"
+#include "StringUtils.h"
+#include "TemplateUtils.h"
+#include "SourceCompatibilityHelpers.h"
+
+#include <clang/AST/ASTContext.h>
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/Type.h>
+#include <clang/Basic/LLVM.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+#include <vector>
+
+using namespace clang;
+using namespace std;
+
+enum class TableKind {
+    None,
+    Strings,
+    Values,
+    Associative
+};
+
+ConstexprLookupTable::ConstexprLookupTable(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+}
+
+static bool isStringClass(const CXXRecordDecl *record)
+{
+    if (!record)
+        return false;
+
+    const StringRef className = clazy::name(record);
+    if (record->isInStdNamespace())
+        return className == "basic_string";
+
+    return className == "QString" || className == "QByteArray";
+}
+
+static TableKind elementKind(QualType type)
+{
+    if (type.isNull())
+        return TableKind::None;
+
+    if (isStringClass(type->getAsCXXRecordDecl()))
+        return TableKind::Strings;
+
+    return type->isArithmeticType() || type->isEnumeralType() ? TableKind::Values : TableKind::None;
+}
+
+static TableKind tableKind(ASTContext &astContext, QualType type)
+{
+    if (const ArrayType *arrayType = astContext.getAsArrayType(type)) {
+        // Arrays of trivial types are already constant initialized, only strings allocate
+        const TableKind kind = elementKind(arrayType->getElementType());
+        return kind == TableKind::Strings ? kind : TableKind::None;
+    }
+
+    CXXRecordDecl *record = type->getAsCXXRecordDecl();
+    if (!record)
+        return TableKind::None;
+
+    const StringRef className = clazy::name(record);
+    if (!record->isInStdNamespace() && (className == "QStringList" || className == "QByteArrayList"))
+        return TableKind::Strings;
+
+    static const clazy::NameSet stdSequential = { "vector", "deque", "list", "array" };
+    static const clazy::NameSet stdAssociative = { "map", "multimap", "set", "multiset", "unordered_map",
+                                                   "unordered_multimap", "unordered_set", "unordered_multiset" };
+    static const clazy::NameSet qtSequential = { "QList", "QVector", "QVarLengthArray" };
+    static const clazy::NameSet qtAssociative = { "QHash", "QMultiHash", "QMap", "QMultiMap", "QSet" };
+
+    const bool isStd = record->isInStdNamespace();
+    if (isStd ? stdAssociative.contains(className) : qtAssociative.contains(className))
+        return TableKind::Associative;
+
+    if (!(isStd ? stdSequential.contains(className) : qtSequential.contains(className)))
+        return TableKind::None;
+
+    const vector<QualType> args = clazy::getTemplateArgumentsTypes(record);
+    const TableKind kind = args.empty() ? TableKind::None : elementKind(args[0]);
+
+    // Like arrays, these only allocate for their strings
+    if (className == "array" || className == "QVarLengthArray")
+        return kind == TableKind::Strings ? kind : TableKind::None;
+
+    return kind;
+}
+
+// Whether stmt only builds objects out of literals, enumerators and constexpr variables
+static bool isBuiltFromLiterals(Stmt *stmt)
+{
+    if (!stmt)
+        return true;
+
+    if (isa<StringLiteral>(stmt) || isa<IntegerLiteral>(stmt) || isa<FloatingLiteral>(stmt) || isa<CharacterLiteral>(stmt)
+        || isa<CXXBoolLiteralExpr>(stmt) || isa<CXXNullPtrLiteralExpr>(stmt) || isa<ImplicitValueInitExpr>(stmt)
+        || isa<CXXDefaultArgExpr>(stmt))
+        return true;
+
+    // QStringLiteral builds its string inside a lambda without captures
+    if (auto lambda = dyn_cast<LambdaExpr>(stmt))
+        return lambda->capture_size() == 0;
+
+    if (auto declRef = dyn_cast<DeclRefExpr>(stmt)) {
+        ValueDecl *decl = declRef->getDecl();
+        if (auto varDecl = dyn_cast<VarDecl>(decl))
+            return varDecl->isConstexpr();
+        return isa<EnumConstantDecl>(decl) || isa<FunctionDecl>(decl);
+    }
+
+    if (auto call = dyn_cast<CallExpr>(stmt)) {
+        // Only the call to QStringLiteral's lambda, or Qt 6's qMakeStringPrivate()
+        FunctionDecl *func = call->getDirectCallee();
+        auto method = dyn_cast_or_null<CXXMethodDecl>(func);
+        const bool isQStringLiteral = (method && method->getParent()->isLambda())
+                                      || (func && clazy::name(func) == "qMakeStringPrivate");
+        if (!isQStringLiteral)
+            return false;
+    } else if (auto unaryOp = dyn_cast<UnaryOperator>(stmt)) {
+        if (unaryOp->getOpcode() != UO_Minus && unaryOp->getOpcode() != UO_Plus)
+            return false;
+    } else if (!isa<InitListExpr>(stmt) && !isa<CXXStdInitializerListExpr>(stmt) && !isa<CXXConstructExpr>(stmt)
+               && !isa<CastExpr>(stmt) && !isa<MaterializeTemporaryExpr>(stmt) && !isa<CXXBindTemporaryExpr>(stmt)
+               && !isa<ExprWithCleanups>(stmt) && !isa<ParenExpr>(stmt)
+#if LLVM_VERSION_MAJOR >= 8
+               && !isa<ConstantExpr>(stmt)
+#endif
+               ) {
+        return false;
+    }
+
+    for (Stmt *child : stmt->children()) {
+        if (!isBuiltFromLiterals(child))
+            return false;
+    }
+
+    return true;
+}
+
+// QStringList list = { "a", "b" } or std::string names[] = { "a", "b" }, but not a default constructed container
+static bool isInitializedWithList(Expr *init)
+{
+    if (isa<InitListExpr>(init->IgnoreImplicit()))
+        return true;
+
+    auto initLists = clazy::getStatements<CXXStdInitializerListExpr>(init);
+    return !initLists.empty();
+}
+
+void ConstexprLookupTable::VisitDecl(clang::Decl *decl)
+{
+    auto varDecl = dyn_cast<VarDecl>(decl);
+    if (!varDecl || !varDecl->hasGlobalStorage() || varDecl->isConstexpr() || !varDecl->getInit()
+        || varDecl->getDeclContext()->isDependentContext())
+        return;
+
+    const QualType type = varDecl->getType();
+    // isConstant() also looks at the elements of arrays
+    if (!type.isConstant(*m_astContext) || type->isReferenceType())
+        return;
+
+    const TableKind kind = tableKind(*m_astContext, type);
+    if (kind == TableKind::None || !isInitializedWithList(varDecl->getInit()) || !isBuiltFromLiterals(varDecl->getInit()))
+        return;
+
+    // Suggest the string view of the same library, for arrays that's the one of their strings
+    const ArrayType *arrayType = m_astContext->getAsArrayType(type);
+    const CXXRecordDecl *record = arrayType ? arrayType->getElementType()->getAsCXXRecordDecl() : type->getAsCXXRecordDecl();
+    const bool isStd = record && record->isInStdNamespace();
+
+    string suggestion;
+    switch (kind) {
+    case TableKind::Strings:
+        suggestion = isStd ? "a constexpr array of std::string_view or const char *" : "a constexpr array of QLatin1String or const char *";
+        break;
+    case TableKind::Values:
+        suggestion = "a constexpr array";
+        break;
+    case TableKind::Associative:
+        suggestion = "a constexpr array sorted by key, searched with std::lower_bound()";
+        break;
+    case TableKind::None:
+        return;
+    }
+
+    const string when = varDecl->isStaticLocal() ? "the first time it's used" : "at startup";
+    emitWarning(clazy::getLocStart(varDecl), "const table initialized from literals allocates " + when + "; consider " + suggestion);
+}
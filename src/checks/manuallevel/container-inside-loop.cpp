@@ -21,31 +21,134 @@
 
 #include "container-inside-loop.h"
 #include "ClazyContext.h"
+#include "FixItUtils.h"
+#include "HierarchyUtils.h"
 #include "Utils.h"
 #include "StringUtils.h"
 #include "LoopUtils.h"
+#include "PreProcessorVisitor.h"
 #include "StmtBodyRange.h"
+#include "StmtIndex.h"
 #include "SourceCompatibilityHelpers.h"
 #include "clazy_stl.h"
 
 #include <clang/AST/ParentMap.h>
 #include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/LambdaCapture.h>
 #include <clang/AST/ExprCXX.h>
 #include <clang/AST/Stmt.h>
 #include <clang/Basic/LLVM.h>
+#include <clang/Lex/Lexer.h>
+#include <llvm/ADT/StringRef.h>
 #include <llvm/Support/Casting.h>
 
-namespace clang {
-class CXXConstructorDecl;
-}  // namespace clang
+#include <vector>
 
 using namespace clang;
 using namespace std;
 
 
 ContainerInsideLoop::ContainerInsideLoop(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
 {
+    context->enablePreprocessorVisitor(); // For the Qt version, QList only keeps its capacity since Qt 6
+}
+
+static bool isContainer(const CXXRecordDecl *record)
+{
+    if (!record)
+        return false;
+
+    static const clazy::NameSet qtContainers = { "QVector", "QList" };
+    static const clazy::NameSet stdContainers = { "vector", "unordered_map", "unordered_set" };
+    return record->isInStdNamespace() ? stdContainers.contains(clazy::name(record))
+                                      : qtContainers.contains(clazy::name(record));
+}
+
+// Returns true if hoisting varDecl to the scope of root would clash with, or hide, something else with the same name
+static bool nameIsUsedElsewhere(Stmt *root, const VarDecl *varDecl)
+{
+    const StringRef name = clazy::name(varDecl);
+    auto otherDeclNamed = [varDecl, name](const NamedDecl *decl) {
+        return decl && decl != varDecl && clazy::name(decl) == name;
+    };
+
+    for (DeclStmt *declStmt : clazy::getStatements<DeclStmt>(root)) {
+        for (Decl *decl : declStmt->decls()) {
+            if (otherDeclNamed(dyn_cast<NamedDecl>(decl)))
+                return true;
+        }
+    }
+
+    return clazy::any_of(clazy::getStatements<DeclRefExpr>(root), [&otherDeclNamed](DeclRefExpr *declRef) {
+               return otherDeclNamed(declRef->getDecl());
+           }) || clazy::any_of(clazy::getStatements<MemberExpr>(root), [&otherDeclNamed](MemberExpr *member) {
+               return member->isImplicitAccess() && otherDeclNamed(member->getMemberDecl());
+           });
+}
+
+static bool isCapturedByLambda(Stmt *loop, const VarDecl *varDecl)
+{
+    return clazy::any_of(clazy::getStatements<LambdaExpr>(loop), [varDecl](LambdaExpr *lambda) {
+        return clazy::any_of(lambda->captures(), [varDecl](const LambdaCapture &capture) {
+            return capture.capturesVariable() && capture.getCapturedVar() == varDecl;
+        });
+    });
+}
+
+// Moves the declaration before the loop and empties the container where it was declared, which is equivalent,
+// as nothing before the declaration could use it
+vector<FixItHint> ContainerInsideLoop::hoistFixits(Stmt *loopStmt, DeclStmt *declStm, VarDecl *varDecl,
+                                                   CXXConstructExpr *ctorExpr) const
+{
+    CXXConstructorDecl *ctor = ctorExpr->getConstructor();
+    if (!ctor->isDefaultConstructor() || varDecl->isStaticLocal() || varDecl->getType().isConstQualified())
+        return {};
+
+    // clear() frees the storage of QList before Qt 6 and of QVector before Qt 5.7, resize(0) keeps it
+    const CXXRecordDecl *record = ctor->getParent();
+    const bool isStd = record->isInStdNamespace();
+    if (!isStd && clazy::name(record) == "QList"
+        && (!m_context->preprocessorVisitor || m_context->preprocessorVisitor->qtVersion() < 60000)) {
+        return {};
+    }
+
+    const SourceRange declRange = declStm->getSourceRange();
+    const SourceLocation loopStart = clazy::getLocStart(loopStmt);
+    if (declRange.getBegin().isMacroID() || declRange.getEnd().isMacroID() || loopStart.isMacroID())
+        return {};
+
+    // Only declarations in the body, not in the loop's condition or init statement
+    Stmt *child = declStm;
+    while (child && clazy::parent(m_context->parentMap, child) != loopStmt)
+        child = clazy::parent(m_context->parentMap, child);
+    if (!child || child != clazy::bodyFromLoop(loopStmt))
+        return {};
+
+    if (Utils::addressIsTaken(loopStmt, varDecl, m_context->functionStmtIndex(loopStmt))
+        || isCapturedByLambda(loopStmt, varDecl))
+        return {};
+
+    Stmt *root = loopStmt;
+    while (Stmt *parent = clazy::parent(m_context->parentMap, root))
+        root = parent;
+    if (nameIsUsedElsewhere(root, varDecl))
+        return {};
+
+    const string declaration = Lexer::getSourceText(CharSourceRange::getTokenRange(declRange), sm(), lo()).str();
+    if (declaration.empty())
+        return {};
+
+    // Keep the indentation of the loop
+    const unsigned int column = sm().getSpellingColumnNumber(loopStart);
+    const StringRef linePrefix(sm().getCharacterData(loopStart) - (column - 1), column - 1);
+    const string indentation = linePrefix.find_first_not_of(" \t") == StringRef::npos ? linePrefix.str() : string();
+
+    const string empty = clazy::name(varDecl).str() + (isStd ? ".clear();" : ".resize(0);");
+    return { clazy::createInsertion(loopStart, declaration + "\n" + indentation),
+             clazy::createReplacement(declRange, empty) };
 }
 
 void ContainerInsideLoop::VisitStmt(clang::Stmt *stmt)
@@ -55,14 +158,14 @@ void ContainerInsideLoop::VisitStmt(clang::Stmt *stmt)
         return;
 
     CXXConstructorDecl *ctor = ctorExpr->getConstructor();
-    if (!ctor || !clazy::equalsAny(clazy::classNameFor(ctor), { "QVector", "std::vector", "QList" }))
+    if (!ctor || !isContainer(ctor->getParent()))
         return;
 
     DeclStmt *declStm = dyn_cast_or_null<DeclStmt>(m_context->parentMap->getParent(stmt));
     if (!declStm || !declStm->isSingleDecl())
         return;
 
-    Stmt *loopStmt = clazy::isInLoop(m_context->parentMap, stmt);
+    Stmt *loopStmt = clazy::isInLoop(m_context, stmt);
     if (!loopStmt)
         return;
 
@@ -70,8 +173,12 @@ void ContainerInsideLoop::VisitStmt(clang::Stmt *stmt)
     if (!varDecl || Utils::isInitializedExternally(varDecl))
         return;
 
-    if (Utils::isPassedToFunction(StmtBodyRange(loopStmt), varDecl, true))
+    // Also bails out for containers moved from, std::move() takes a reference
+    if (Utils::isPassedToFunction(StmtBodyRange(loopStmt, nullptr, {}, m_context->functionStmtIndex(loopStmt)), varDecl, true))
         return;
 
-    emitWarning(clazy::getLocStart(stmt), "container inside loop causes unneeded allocations");
+    // Allocates on each iteration of the loop it's declared in
+    setWasteEstimate(1, 0, clazy::loopDepth(m_context, stmt));
+    emitWarning(clazy::getLocStart(stmt), "container inside loop causes unneeded allocations",
+                hoistFixits(loopStmt, declStm, varDecl, ctorExpr));
 }
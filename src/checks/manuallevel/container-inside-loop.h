@@ -25,11 +25,16 @@
 #include "checkbase.h"
 
 #include <string>
+#include <vector>
 
 class ClazyContext;
 
 namespace clang {
+class CXXConstructExpr;
+class DeclStmt;
+class FixItHint;
 class Stmt;
+class VarDecl;
 }
 
 /**
@@ -44,6 +49,10 @@ class ContainerInsideLoop
 public:
     explicit ContainerInsideLoop(const std::string &name, ClazyContext *context);
     void VisitStmt(clang::Stmt *stmt) override;
+
+private:
+    std::vector<clang::FixItHint> hoistFixits(clang::Stmt *loopStmt, clang::DeclStmt *declStm, clang::VarDecl *varDecl,
+                                              clang::CXXConstructExpr *ctorExpr) const;
 };
 
 #endif
@@ -0,0 +1,225 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#include "detaching-lambda-capture.h"
+#include "ClazyContext.h"
+#include "HierarchyUtils.h"
+#include "LoopUtils.h"
+#include "QtUtils.h"
+#include "StmtIndex.h"
+#include "StringUtils.h"
+#include "SourceCompatibilityHelpers.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/LambdaCapture.h>
+#include <clang/AST/ParentMap.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/StmtCXX.h>
+#include <clang/Basic/Lambda.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/SourceManager.h>
+#include <llvm/Support/Casting.h>
+
+using namespace clang;
+using namespace std;
+
+DetachingLambdaCapture::DetachingLambdaCapture(const std::string &name, ClazyContext *context)
+    : DetachingBase(name, context, Option_CanIgnoreIncludes)
+{
+}
+
+// Returns true for QList, QString and friends, including classes deriving from them, like QStringList
+static bool isCOWContainer(const CXXRecordDecl *record)
+{
+    if (!record)
+        return false;
+
+    if (clazy::isQtCOWIterableClass(const_cast<CXXRecordDecl *>(record)))
+        return true;
+
+    if (!record->hasDefinition())
+        return false;
+
+    for (const CXXBaseSpecifier &base : record->bases()) {
+        if (isCOWContainer(base.getType()->getAsCXXRecordDecl()))
+            return true;
+    }
+
+    return false;
+}
+
+static Stmt *parentIgnoringParenImpCasts(ParentMap *map, Stmt *&child)
+{
+    Stmt *parent = clazy::parent(map, child);
+    while (parent && (isa<ImplicitCastExpr>(parent) || isa<ParenExpr>(parent))) {
+        child = parent;
+        parent = clazy::parent(map, parent);
+    }
+
+    return parent;
+}
+
+// Returns the non-const method called on the variable referenced by declRef, and the call itself, as in list.append(1) or list[0]
+static CXXMethodDecl *nonConstMethodCall(ParentMap *map, DeclRefExpr *declRef, CallExpr *&call)
+{
+    Stmt *child = declRef;
+    Stmt *parent = parentIgnoringParenImpCasts(map, child);
+
+    CXXMethodDecl *method = nullptr;
+    call = nullptr;
+    if (auto memberExpr = dyn_cast_or_null<MemberExpr>(parent)) {
+        method = dyn_cast<CXXMethodDecl>(memberExpr->getMemberDecl());
+        call = dyn_cast_or_null<CXXMemberCallExpr>(clazy::parent(map, memberExpr));
+    } else if (auto op = dyn_cast_or_null<CXXOperatorCallExpr>(parent)) {
+        if (op->getNumArgs() > 0 && op->getArg(0) == child) {
+            method = dyn_cast_or_null<CXXMethodDecl>(op->getDirectCallee());
+            call = op;
+        }
+    }
+
+    if (!method || !call || method->isConst())
+        return nullptr;
+
+    // Assigning replaces the contents instead of copying them
+    if (method->isCopyAssignmentOperator() || method->isMoveAssignmentOperator())
+        return nullptr;
+
+    return method;
+}
+
+// Returns true if the result of a call like list[0] or list.first() is written to
+static bool isWrittenTo(ParentMap *map, CallExpr *call)
+{
+    Stmt *child = call;
+    Stmt *parent = parentIgnoringParenImpCasts(map, child);
+
+    if (auto binaryOp = dyn_cast_or_null<BinaryOperator>(parent))
+        return binaryOp->isAssignmentOp() && binaryOp->getLHS() == child;
+
+    if (auto unaryOp = dyn_cast_or_null<UnaryOperator>(parent))
+        return unaryOp->isIncrementDecrementOp();
+
+    if (auto op = dyn_cast_or_null<CXXOperatorCallExpr>(parent)) {
+        auto method = dyn_cast_or_null<CXXMethodDecl>(op->getDirectCallee());
+        return method && !method->isConst() && op->getNumArgs() > 0 && op->getArg(0) == child;
+    }
+
+    if (auto memberExpr = dyn_cast_or_null<MemberExpr>(parent)) {
+        auto method = dyn_cast<CXXMethodDecl>(memberExpr->getMemberDecl());
+        return method && !method->isConst();
+    }
+
+    return false;
+}
+
+// Returns true if varDecl isn't used after the lambda, so moving it into the lambda doesn't change behaviour
+bool DetachingLambdaCapture::canBeMoved(const StmtIndex *index, LambdaExpr *lambda, VarDecl *varDecl) const
+{
+    if (!index || !varDecl->hasLocalStorage())
+        return false;
+
+    // Moving it would leave it empty for the next iteration
+    Stmt *loop = clazy::isInLoop(m_context, lambda);
+    if (loop && sm().isBeforeInTranslationUnit(clazy::getLocStart(varDecl), clazy::getLocStart(loop)))
+        return false;
+
+    for (DeclRefExpr *declRef : clazy::getStatements<DeclRefExpr>(index, index->root())) {
+        if (declRef->getDecl() == varDecl && sm().isBeforeInTranslationUnit(clazy::getLocEnd(lambda), clazy::getLocStart(declRef)))
+            return false;
+    }
+
+    return true;
+}
+
+void DetachingLambdaCapture::VisitStmt(clang::Stmt *stmt)
+{
+    // The copies captured by non-mutable lambdas are const, so they can't detach
+    auto lambda = dyn_cast<LambdaExpr>(stmt);
+    Stmt *body = lambda ? lambda->getBody() : nullptr;
+    if (!body || !lambda->isMutable())
+        return;
+
+    // Null if it's not inside a function body, like in a default member initializer
+    const StmtIndex *index = m_context->functionStmtIndex(lambda);
+    for (const LambdaCapture &capture : lambda->captures()) {
+        if (capture.getCaptureKind() != LCK_ByCopy || capture.isPackExpansion())
+            continue;
+
+        VarDecl *varDecl = capture.getCapturedVar();
+        if (!varDecl || varDecl->isInitCapture() || varDecl->getType()->isReferenceType()
+            || varDecl->getType().isConstQualified() || !isCOWContainer(varDecl->getType()->getAsCXXRecordDecl()))
+            continue;
+
+        const string name = varDecl->getNameAsString();
+        CallExpr *modifyingCall = nullptr;
+        CXXMethodDecl *modifyingMethod = nullptr;
+        CallExpr *detachingCall = nullptr;
+        CXXMethodDecl *detachingMethod = nullptr;
+        for (DeclRefExpr *declRef : clazy::getStatements<DeclRefExpr>(index, body)) {
+            if (declRef->getDecl() != varDecl)
+                continue;
+
+            CallExpr *call = nullptr;
+            CXXMethodDecl *method = nonConstMethodCall(m_context->parentMap, declRef, call);
+            if (!method)
+                continue;
+
+            // list[0] and list.first() don't modify the container, unless their result is written to
+            if (isDetachingMethod(method, DetachingMethodWithConstCounterPart) && !isWrittenTo(m_context->parentMap, call)) {
+                if (!detachingCall) {
+                    detachingCall = call;
+                    detachingMethod = method;
+                }
+            } else if (!modifyingCall) {
+                modifyingCall = call;
+                modifyingMethod = method;
+            }
+        }
+
+        if (modifyingCall) {
+            // Otherwise the copy is needed, as both the lambda and the enclosing function use their own version
+            if (canBeMoved(index, lambda, varDecl)) {
+                emitWarning(clazy::getLocStart(modifyingCall), "Mutable lambda modifies its copy of '" + name + "' with "
+                            + clazy::qualifiedMethodName(modifyingMethod) + "(), which deep-copies it, move it into the lambda with ["
+                            + name + " = std::move(" + name + ")]");
+            }
+            continue;
+        }
+
+        if (detachingCall) {
+            emitWarning(clazy::getLocStart(detachingCall), "Mutable lambda detaches its copy of '" + name + "' by calling non-const "
+                        + clazy::qualifiedMethodName(detachingMethod) + "(), read it through qAsConst()");
+            continue;
+        }
+
+        for (CXXForRangeStmt *rangeLoop : clazy::getStatements<CXXForRangeStmt>(index, body)) {
+            auto declRef = dyn_cast_or_null<DeclRefExpr>(rangeLoop->getRangeInit() ? rangeLoop->getRangeInit()->IgnoreParenImpCasts() : nullptr);
+            if (declRef && declRef->getDecl() == varDecl) {
+                emitWarning(clazy::getLocStart(rangeLoop), "Mutable lambda detaches its copy of '" + name
+                            + "' by iterating it with a range-for, iterate over qAsConst(" + name + ")");
+                break;
+            }
+        }
+    }
+}
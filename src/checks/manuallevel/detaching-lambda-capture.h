@@ -0,0 +1,52 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#ifndef CLAZY_DETACHING_LAMBDA_CAPTURE_H
+#define CLAZY_DETACHING_LAMBDA_CAPTURE_H
+
+#include "checks/detachingbase.h"
+
+#include <string>
+
+class ClazyContext;
+class StmtIndex;
+namespace clang {
+class LambdaExpr;
+class Stmt;
+class VarDecl;
+}  // namespace clang
+
+/**
+ * Finds Qt containers captured by copy in mutable lambdas and then detached inside the lambda.
+ *
+ * See README-detaching-lambda-capture.md for more info.
+ */
+class DetachingLambdaCapture
+    : public DetachingBase
+{
+public:
+    explicit DetachingLambdaCapture(const std::string &name, ClazyContext *context);
+    void VisitStmt(clang::Stmt *stmt) override;
+private:
+    bool canBeMoved(const StmtIndex *index, clang::LambdaExpr *lambda, clang::VarDecl *varDecl) const;
+};
+
+#endif
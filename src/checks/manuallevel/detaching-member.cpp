@@ -74,7 +74,7 @@ void DetachingMember::VisitStmt(clang::Stmt *stm)
         if (!method || clazy::name(method) != "operator[]")
             return;
 
-        auto memberExpr = clazy::getFirstParentOfType<CXXMemberCallExpr>(m_context->parentMap, operatorExpr);
+        auto memberExpr = clazy::getFirstParentOfType<CXXMemberCallExpr>(m_context, operatorExpr);
         CXXMethodDecl *parentMemberDecl = memberExpr ? memberExpr->getMethodDecl() : nullptr;
         if (parentMemberDecl && !parentMemberDecl->isConst()) {
             // Don't warn for s.m_listOfValues[0].nonConstMethod();
@@ -96,13 +96,13 @@ void DetachingMember::VisitStmt(clang::Stmt *stm)
 
     // Catch cases like m_foo[0] = .. , which is fine
 
-    auto parentUnaryOp = clazy::getFirstParentOfType<UnaryOperator>(m_context->parentMap, callExpr);
+    auto parentUnaryOp = clazy::getFirstParentOfType<UnaryOperator>(m_context, callExpr);
     if (parentUnaryOp) {
         // m_foo[0]++ is OK
         return;
     }
 
-    auto parentOp = clazy::getFirstParentOfType<CXXOperatorCallExpr>(m_context->parentMap, clazy::parent(m_context->parentMap, callExpr));
+    auto parentOp = clazy::getFirstParentOfType<CXXOperatorCallExpr>(m_context, clazy::parent(m_context, callExpr));
     if (parentOp) {
         FunctionDecl *parentFunc = parentOp->getDirectCallee();
         const string parentFuncName = parentFunc ? parentFunc->getNameAsString() : "";
@@ -112,7 +112,7 @@ void DetachingMember::VisitStmt(clang::Stmt *stm)
         }
     }
 
-    auto parentBinaryOp = clazy::getFirstParentOfType<BinaryOperator>(m_context->parentMap, callExpr);
+    auto parentBinaryOp = clazy::getFirstParentOfType<BinaryOperator>(m_context, callExpr);
     if (parentBinaryOp && parentBinaryOp->isAssignmentOp()) {
         // m_foo[0] += .. is OK
         Expr *lhs = parentBinaryOp->getLHS();
@@ -124,7 +124,7 @@ void DetachingMember::VisitStmt(clang::Stmt *stm)
     if (returnsNonConstIterator) {
         // If we're calling begin()/end() as arguments to a function taking non-const iterators it's fine
         // Such as qSort(list.begin(), list.end());
-        auto parentCall = clazy::getFirstParentOfType<CallExpr>(m_context->parentMap, clazy::parent(m_context->parentMap, memberCall));
+        auto parentCall = clazy::getFirstParentOfType<CallExpr>(m_context, clazy::parent(m_context, memberCall));
         FunctionDecl *parentFunc = parentCall ? parentCall->getDirectCallee() : nullptr;
         if (parentFunc && parentFunc->getNumParams() == parentCall->getNumArgs()) {
             int i = 0;
@@ -0,0 +1,322 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "double-lookup.h"
+#include "ClazyContext.h"
+#include "HierarchyUtils.h"
+#include "QtUtils.h"
+#include "StringUtils.h"
+#include "clazy_stl.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/ParentMap.h>
+#include <clang/AST/Stmt.h>
+#include <clang/Basic/LLVM.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+#include <vector>
+
+using namespace clang;
+using namespace std;
+
+DoubleLookup::DoubleLookup(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+}
+
+static bool isAssociativeContainer(CXXRecordDecl *record)
+{
+    if (!record)
+        return false;
+
+    static const clazy::NameSet stdContainers = { "map", "unordered_map", "set", "unordered_set" };
+    return record->isInStdNamespace() ? stdContainers.contains(clazy::name(record))
+                                      : clazy::isQtAssociativeContainer(record);
+}
+
+static Expr *stripKey(Expr *expr)
+{
+    while (expr) {
+        expr = expr->IgnoreParenImpCasts();
+        if (auto temporary = dyn_cast<MaterializeTemporaryExpr>(expr))
+            expr = clazy::getFirstChild(temporary) ? cast<Expr>(clazy::getFirstChild(temporary)) : nullptr;
+        else if (auto bind = dyn_cast<CXXBindTemporaryExpr>(expr))
+            expr = bind->getSubExpr();
+        else
+            return expr;
+    }
+
+    return nullptr;
+}
+
+// Returns true if a and b are the same variable, member or literal, or a conversion of one
+static bool isSameValue(Expr *a, Expr *b)
+{
+    a = stripKey(a);
+    b = stripKey(b);
+    if (!a || !b || a->getStmtClass() != b->getStmtClass())
+        return false;
+
+    if (auto declRefA = dyn_cast<DeclRefExpr>(a))
+        return declRefA->getDecl() == cast<DeclRefExpr>(b)->getDecl();
+
+    if (isa<CXXThisExpr>(a))
+        return true;
+
+    if (auto memberA = dyn_cast<MemberExpr>(a)) {
+        auto memberB = cast<MemberExpr>(b);
+        return memberA->getMemberDecl() == memberB->getMemberDecl() && memberA->isArrow() == memberB->isArrow()
+               && isSameValue(memberA->getBase(), memberB->getBase());
+    }
+
+    if (auto intA = dyn_cast<IntegerLiteral>(a))
+        return intA->getValue() == cast<IntegerLiteral>(b)->getValue();
+
+    if (auto charA = dyn_cast<CharacterLiteral>(a))
+        return charA->getValue() == cast<CharacterLiteral>(b)->getValue();
+
+    if (auto stringA = dyn_cast<StringLiteral>(a))
+        return stringA->getBytes() == cast<StringLiteral>(b)->getBytes();
+
+    // A converting constructor, like QString("foo")
+    if (auto constructA = dyn_cast<CXXConstructExpr>(a)) {
+        auto constructB = cast<CXXConstructExpr>(b);
+        return constructA->getConstructor() == constructB->getConstructor() && constructA->getNumArgs() == 1
+               && constructB->getNumArgs() == 1 && isSameValue(constructA->getArg(0), constructB->getArg(0));
+    }
+
+    return false;
+}
+
+// Returns the object a method or member operator is called on
+static Expr *objectOf(CallExpr *call)
+{
+    if (auto memberCall = dyn_cast<CXXMemberCallExpr>(call))
+        return memberCall->getImplicitObjectArgument();
+
+    auto operatorCall = dyn_cast<CXXOperatorCallExpr>(call);
+    if (operatorCall && dyn_cast_or_null<CXXMethodDecl>(operatorCall->getDirectCallee()) && operatorCall->getNumArgs() > 0)
+        return operatorCall->getArg(0);
+
+    return nullptr;
+}
+
+// Returns the key of a lookup like c.value(k) or c[k]
+static Expr *keyOf(CallExpr *call)
+{
+    if (isa<CXXMemberCallExpr>(call))
+        return call->getNumArgs() > 0 ? call->getArg(0) : nullptr;
+
+    auto operatorCall = dyn_cast<CXXOperatorCallExpr>(call);
+    if (operatorCall && operatorCall->getOperator() == OO_Subscript && operatorCall->getNumArgs() == 2)
+        return operatorCall->getArg(1);
+
+    return nullptr;
+}
+
+// The calls which don't change the container, so an iterator returned by find() stays valid across them
+static bool isReadOnly(CallExpr *call)
+{
+    auto method = dyn_cast_or_null<CXXMethodDecl>(call->getDirectCallee());
+    if (!method)
+        return false;
+
+    static const clazy::NameSet readOnlyMethods = { "begin", "end", "find", "count", "size", "isEmpty", "empty" };
+    return method->isConst() || readOnlyMethods.contains(clazy::name(method));
+}
+
+// Returns the variables used by a key, which must not change between both lookups
+static vector<ValueDecl *> keyVariables(Expr *key)
+{
+    vector<ValueDecl *> variables;
+    for (DeclRefExpr *declRef : clazy::getStatements<DeclRefExpr>(key, nullptr, {}, -1, /*includeParent=*/ true))
+        variables.push_back(declRef->getDecl());
+    return variables;
+}
+
+static bool modifiesVariable(Stmt *stmt, const vector<ValueDecl *> &variables)
+{
+    auto isVariable = [&variables](Expr *expr) {
+        auto declRef = dyn_cast_or_null<DeclRefExpr>(expr ? expr->IgnoreParenImpCasts() : nullptr);
+        return declRef && clazy::contains(variables, declRef->getDecl());
+    };
+
+    if (auto unary = dyn_cast<UnaryOperator>(stmt))
+        return unary->isIncrementDecrementOp() && isVariable(unary->getSubExpr());
+
+    if (auto binary = dyn_cast<BinaryOperator>(stmt))
+        return binary->isAssignmentOp() && isVariable(binary->getLHS());
+
+    if (auto operatorCall = dyn_cast<CXXOperatorCallExpr>(stmt))
+        return operatorCall->isAssignmentOp() && operatorCall->getNumArgs() > 0 && isVariable(operatorCall->getArg(0));
+
+    return false;
+}
+
+static bool isNonConstReferenceOrPointer(QualType type)
+{
+    return (type->isReferenceType() || type->isPointerType()) && !type->getPointeeType().isConstQualified();
+}
+
+// Returns true if call can change a key variable or the container without being a call on the container, like k.append(x),
+// std::swap(m, other) or fill(m). If the container is a member, any non-const method of this can change it.
+static bool modifiesKeyOrContainer(CallExpr *call, Expr *container, const vector<ValueDecl *> &variables, bool usesThis)
+{
+    auto refersToKeyOrContainer = [&](Expr *expr) {
+        expr = expr ? expr->IgnoreParenImpCasts() : nullptr;
+        if (auto unary = dyn_cast_or_null<UnaryOperator>(expr)) {
+            if (unary->getOpcode() == UO_AddrOf)
+                expr = unary->getSubExpr()->IgnoreParenImpCasts();
+        }
+
+        if (!expr)
+            return false;
+
+        auto declRef = dyn_cast<DeclRefExpr>(expr);
+        if (declRef && clazy::contains(variables, declRef->getDecl()))
+            return true;
+
+        return (usesThis && isa<CXXThisExpr>(expr)) || isSameValue(container, expr);
+    };
+
+    auto method = dyn_cast_or_null<CXXMethodDecl>(call->getDirectCallee());
+    if (method && !method->isConst() && !method->isStatic() && refersToKeyOrContainer(objectOf(call)))
+        return true;
+
+    // The arguments passed by non-const reference or pointer. A member operator's first argument is its object.
+    FunctionDecl *callee = call->getDirectCallee();
+    const unsigned int firstArg = isa<CXXOperatorCallExpr>(call) && method ? 1 : 0;
+    for (unsigned int i = firstArg; i < call->getNumArgs(); ++i) {
+        Expr *arg = call->getArg(i);
+        if (!refersToKeyOrContainer(arg))
+            continue;
+
+        if (!callee)
+            return true; // Through a function pointer, we can't tell
+
+        const unsigned int paramIndex = i - firstArg;
+        const QualType type = paramIndex < callee->getNumParams() ? callee->getParamDecl(paramIndex)->getType() : arg->getType();
+        if (isNonConstReferenceOrPointer(type))
+            return true;
+    }
+
+    return false;
+}
+
+CallExpr *DoubleLookup::secondLookup(CXXMemberCallExpr *firstLookup) const
+{
+    Expr *container = objectOf(firstLookup);
+    Expr *key = keyOf(firstLookup);
+    if (!container || !key)
+        return nullptr;
+
+    // The statement of the enclosing block containing the first lookup, and the ones after it
+    Stmt *statement = firstLookup;
+    Stmt *parent = clazy::parent(m_context, statement);
+    while (parent && !isa<CompoundStmt>(parent)) {
+        statement = parent;
+        parent = clazy::parent(m_context, statement);
+    }
+
+    if (!parent)
+        return nullptr;
+
+    vector<Stmt *> statements;
+    bool found = false;
+    for (Stmt *child : parent->children()) {
+        found = found || child == statement;
+        if (found)
+            statements.push_back(child);
+    }
+
+    static const clazy::NameSet secondLookups = { "value", "find", "constFind", "at", "operator[]" };
+    const vector<ValueDecl *> variables = keyVariables(key);
+    const bool usesThis = !clazy::getStatements<CXXThisExpr>(container, nullptr, {}, -1, /*includeParent=*/ true).empty()
+                          || !clazy::getStatements<CXXThisExpr>(key, nullptr, {}, -1, /*includeParent=*/ true).empty();
+    bool afterFirstLookup = false;
+    for (Stmt *stmt : statements) {
+        for (Stmt *s : clazy::getStatements<Stmt>(stmt, nullptr, {}, -1, /*includeParent=*/ true)) {
+            if (s == firstLookup) {
+                afterFirstLookup = true;
+                continue;
+            }
+
+            if (!afterFirstLookup)
+                continue;
+
+            // Lambdas don't run here
+            if (isa<LambdaExpr>(s) || modifiesVariable(s, variables))
+                return nullptr;
+
+            auto call = dyn_cast<CallExpr>(s);
+            if (!call)
+                continue;
+
+            if (!isSameValue(container, objectOf(call))) {
+                if (modifiesKeyOrContainer(call, container, variables, usesThis))
+                    return nullptr;
+                continue;
+            }
+
+            auto method = dyn_cast_or_null<CXXMethodDecl>(call->getDirectCallee());
+            if (method && secondLookups.contains(clazy::name(method)) && isSameValue(key, keyOf(call)))
+                return call;
+
+            if (!isReadOnly(call))
+                return nullptr; // It could insert or remove, invalidating the iterator
+        }
+    }
+
+    return nullptr;
+}
+
+// "value()", or "operator[]"
+static string describe(const CXXMethodDecl *method)
+{
+    const string name = clazy::name(method).str();
+    return method->isOverloadedOperator() ? name : name + "()";
+}
+
+void DoubleLookup::VisitStmt(clang::Stmt *stmt)
+{
+    auto memberCall = dyn_cast<CXXMemberCallExpr>(stmt);
+    CXXMethodDecl *method = memberCall ? memberCall->getMethodDecl() : nullptr;
+    if (!method || method->getNumParams() != 1 || !isAssociativeContainer(method->getParent()))
+        return;
+
+    static const clazy::NameSet firstLookups = { "contains", "count", "find", "constFind" };
+    if (!firstLookups.contains(clazy::name(method)))
+        return;
+
+    CallExpr *second = secondLookup(memberCall);
+    if (!second)
+        return;
+
+    const bool isStd = method->getParent()->isInStdNamespace();
+    emitWarning(clazy::getLocStart(second), describe(method) + " followed by " + describe(cast<CXXMethodDecl>(second->getDirectCallee()))
+                + " looks up the same key twice, use " + (isStd ? "find()" : "constFind() or find()")
+                + " and reuse the iterator");
+}
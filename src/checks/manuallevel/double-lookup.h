@@ -0,0 +1,55 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_DOUBLE_LOOKUP_H
+#define CLAZY_DOUBLE_LOOKUP_H
+
+#include "checkbase.h"
+
+#include <string>
+
+class ClazyContext;
+
+namespace clang {
+class CallExpr;
+class CXXMemberCallExpr;
+class Stmt;
+}
+
+/**
+ * Finds two lookups of the same key in the same associative container, like
+ * contains() followed by value(), which should be a single find() or constFind().
+ *
+ * See README-double-lookup.md for more info.
+ */
+class DoubleLookup
+    : public CheckBase
+{
+public:
+    explicit DoubleLookup(const std::string &name, ClazyContext *context);
+    void VisitStmt(clang::Stmt *stmt) override;
+
+private:
+    clang::CallExpr *secondLookup(clang::CXXMemberCallExpr *firstLookup) const;
+};
+
+#endif
@@ -0,0 +1,219 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "emplace-candidates.h"
+#include "ClazyContext.h"
+#include "FixItUtils.h"
+#include "PreProcessorVisitor.h"
+#include "StringUtils.h"
+#include "TypeUtils.h"
+#include "SourceCompatibilityHelpers.h"
+#include "clazy_stl.h"
+
+#include <clang/AST/ASTContext.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/SourceLocation.h>
+#include <clang/Lex/Lexer.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+using namespace clang;
+using namespace std;
+
+EmplaceCandidates::EmplaceCandidates(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes)
+{
+    context->enablePreprocessorVisitor(); // emplaceBack() depends on the Qt version
+}
+
+// Returns the constructor call of a temporary spelled as T(args) or T{args}, like in push_back(QString(3, 'a'))
+static CXXConstructExpr *temporaryConstruction(Expr *temporary)
+{
+    CXXConstructExpr *construct = dyn_cast<CXXTemporaryObjectExpr>(temporary);
+    if (auto functionalCast = dyn_cast<CXXFunctionalCastExpr>(temporary))
+        construct = dyn_cast<CXXConstructExpr>(functionalCast->getSubExpr()->IgnoreImplicit());
+
+    // emplace_back() initializes with parentheses, so T{list} would call another constructor.
+    // Aggregates, which don't have constructors, can't be emplaced before C++20 either.
+    if (!construct || construct->isStdInitListInitialization())
+        return nullptr;
+
+    return construct;
+}
+
+// The arguments the user wrote, without default ones
+static vector<Expr *> writtenArgs(CXXConstructExpr *construct)
+{
+    vector<Expr *> args;
+    for (unsigned int i = 0; i < construct->getNumArgs(); ++i) {
+        Expr *arg = construct->getArg(i);
+        if (isa<CXXDefaultArgExpr>(arg))
+            break;
+        args.push_back(arg);
+    }
+
+    return args;
+}
+
+bool EmplaceCandidates::isNonTriviallyCopyable(Expr *expr) const
+{
+    clazy::QualTypeClassification classification;
+    return clazy::classifyQualType(m_context, expr->getType(), nullptr, classification) && classification.isNonTriviallyCopyable;
+}
+
+// Renames the method and unwraps the temporary, so push_back(QString(3, 'a')) becomes emplace_back(3, 'a')
+vector<FixItHint> EmplaceCandidates::emplaceFixits(CXXMemberCallExpr *memberCall, const string &emplaceName,
+                                                   Expr *temporary, const vector<Expr *> &args) const
+{
+    auto memberExpr = dyn_cast<MemberExpr>(memberCall->getCallee()->IgnoreParens());
+    const SourceLocation nameLoc = memberExpr ? memberExpr->getMemberLoc() : SourceLocation();
+    const SourceRange range = temporary->getSourceRange();
+    if (nameLoc.isInvalid() || nameLoc.isMacroID() || range.getBegin().isMacroID() || range.getEnd().isMacroID())
+        return {};
+
+    vector<FixItHint> fixits = { clazy::createReplacement(nameLoc, emplaceName) };
+    if (args.empty()) {
+        fixits.push_back(FixItHint::CreateRemoval(range));
+        return fixits;
+    }
+
+    const SourceLocation firstArgStart = clazy::getLocStart(args.front());
+    const SourceLocation lastArgEnd = clazy::getLocEnd(args.back());
+    if (firstArgStart.isMacroID() || lastArgEnd.isMacroID())
+        return {};
+
+    const SourceLocation afterLastArg = Lexer::getLocForEndOfToken(lastArgEnd, 0, sm(), lo());
+    const SourceLocation end = Lexer::getLocForEndOfToken(range.getEnd(), 0, sm(), lo());
+    if (afterLastArg.isInvalid() || end.isInvalid())
+        return {};
+
+    fixits.push_back(FixItHint::CreateRemoval(CharSourceRange::getCharRange(range.getBegin(), firstArgStart)));
+    fixits.push_back(FixItHint::CreateRemoval(CharSourceRange::getCharRange(afterLastArg, end)));
+    return fixits;
+}
+
+void EmplaceCandidates::checkSequenceContainer(CXXMemberCallExpr *memberCall, CXXRecordDecl *record)
+{
+    static const clazy::NameSet stdContainers = { "vector", "deque", "list" };
+
+    CXXMethodDecl *method = memberCall->getMethodDecl();
+    const StringRef methodName = clazy::name(method);
+    const StringRef className = clazy::name(record);
+    string emplaceName;
+    if (record->isInStdNamespace()) {
+        if (!stdContainers.contains(className))
+            return;
+
+        if (methodName == "push_back")
+            emplaceName = "emplace_back";
+        else if (methodName == "push_front" && className != "vector")
+            emplaceName = "emplace_front";
+    } else if (className == "QVector" || className == "QList") {
+        // QVector::emplaceBack() was added in 5.13, QList::emplaceBack() in 6.0
+        const int qtVersion = m_context->preprocessorVisitor ? m_context->preprocessorVisitor->qtVersion() : -1;
+        if (qtVersion < (className == "QList" ? 60000 : 51300))
+            return;
+
+        if (methodName == "append")
+            emplaceName = "emplaceBack";
+        else if (methodName == "push_back")
+            emplaceName = "emplace_back";
+    }
+
+    if (emplaceName.empty())
+        return;
+
+    Expr *temporary = memberCall->getArg(0)->IgnoreImplicit();
+    CXXConstructExpr *construct = temporaryConstruction(temporary);
+    if (!construct || !isNonTriviallyCopyable(temporary))
+        return;
+
+    // Not QList<T>::append(const QList<T> &), nor a conversion from a derived class
+    const QualType elementType = method->getParamDecl(0)->getType().getNonReferenceType();
+    if (!m_astContext->hasSameUnqualifiedType(elementType, temporary->getType()))
+        return;
+
+    const string typeName = clazy::simpleTypeName(temporary->getType(), lo());
+    emitWarning(clazy::getLocStart(memberCall), methodName.str() + "() moves a temporary " + typeName + ", use "
+                + emplaceName + "() to construct it in place",
+                emplaceFixits(memberCall, emplaceName, temporary, writtenArgs(construct)));
+}
+
+void EmplaceCandidates::checkMap(CXXMemberCallExpr *memberCall, CXXRecordDecl *record)
+{
+    static const clazy::NameSet stdMaps = { "map", "multimap", "unordered_map", "unordered_multimap" };
+    if (!record->isInStdNamespace() || !stdMaps.contains(clazy::name(record)))
+        return;
+
+    Expr *temporary = memberCall->getArg(0)->IgnoreImplicit();
+
+    // insert(const value_type &) converts std::pair<K, V> to std::pair<const K, V>
+    auto conversion = dyn_cast<CXXConstructExpr>(temporary);
+    if (conversion && !isa<CXXTemporaryObjectExpr>(conversion) && conversion->getNumArgs() == 1)
+        temporary = conversion->getArg(0)->IgnoreImplicit();
+
+    CXXRecordDecl *pairRecord = temporary->getType()->getAsCXXRecordDecl();
+    if (!pairRecord || !pairRecord->isInStdNamespace() || clazy::name(pairRecord) != "pair"
+        || !isNonTriviallyCopyable(temporary))
+        return;
+
+    vector<Expr *> args;
+    if (auto call = dyn_cast<CallExpr>(temporary)) {
+        // std::make_pair(key, value)
+        FunctionDecl *func = call->getDirectCallee();
+        if (!func || !func->isInStdNamespace() || clazy::name(func) != "make_pair" || call->getNumArgs() != 2)
+            return;
+
+        args = { call->getArg(0), call->getArg(1) };
+    } else if (CXXConstructExpr *construct = temporaryConstruction(temporary)) {
+        // std::pair<K, V>(key, value)
+        args = writtenArgs(construct);
+    }
+
+    if (args.size() != 2)
+        return;
+
+    // try_emplace() doesn't construct the value when the key exists, which matches what insert() does
+    const bool isMultiMap = clazy::name(record).endswith("multimap");
+    const string emplaceName = !isMultiMap && clazy::isCPlusPlus17(lo()) ? "try_emplace" : "emplace";
+    emitWarning(clazy::getLocStart(memberCall), "insert() constructs a temporary std::pair, use " + emplaceName
+                + "() to construct it in place",
+                emplaceFixits(memberCall, emplaceName, temporary, args));
+}
+
+void EmplaceCandidates::VisitStmt(clang::Stmt *stmt)
+{
+    auto memberCall = dyn_cast<CXXMemberCallExpr>(stmt);
+    CXXMethodDecl *method = memberCall ? memberCall->getMethodDecl() : nullptr;
+    CXXRecordDecl *record = method ? method->getParent() : nullptr;
+    if (!record || memberCall->getNumArgs() != 1 || method->getNumParams() != 1)
+        return;
+
+    if (clazy::name(method) == "insert")
+        checkMap(memberCall, record);
+    else
+        checkSequenceContainer(memberCall, record);
+}
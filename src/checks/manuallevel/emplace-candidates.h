@@ -0,0 +1,61 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_EMPLACE_CANDIDATES_H
+#define CLAZY_EMPLACE_CANDIDATES_H
+
+#include "checkbase.h"
+
+#include <string>
+#include <vector>
+
+class ClazyContext;
+namespace clang {
+class CXXConstructExpr;
+class CXXMemberCallExpr;
+class CXXRecordDecl;
+class Expr;
+class FixItHint;
+class Stmt;
+}  // namespace clang
+
+/**
+ * Finds push_back(T(args)), append(T(args)) and insert(std::make_pair(k, v)) calls which could construct
+ * the element in place with emplace_back(), emplaceBack() or emplace().
+ *
+ * See README-emplace-candidates.md for more info.
+ */
+class EmplaceCandidates
+    : public CheckBase
+{
+public:
+    explicit EmplaceCandidates(const std::string &name, ClazyContext *context);
+    void VisitStmt(clang::Stmt *stmt) override;
+private:
+    void checkSequenceContainer(clang::CXXMemberCallExpr *memberCall, clang::CXXRecordDecl *record);
+    void checkMap(clang::CXXMemberCallExpr *memberCall, clang::CXXRecordDecl *record);
+    bool isNonTriviallyCopyable(clang::Expr *expr) const;
+    std::vector<clang::FixItHint> emplaceFixits(clang::CXXMemberCallExpr *memberCall, const std::string &emplaceName,
+                                                clang::Expr *temporary, const std::vector<clang::Expr *> &args) const;
+};
+
+#endif
@@ -0,0 +1,114 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+
+#include "endl-in-loop.h"
+#include "ClazyContext.h"
+#include "FixItUtils.h"
+#include "StringUtils.h"
+#include "SourceCompatibilityHelpers.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/Basic/Diagnostic.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/OperatorKinds.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+#include <vector>
+
+using namespace clang;
+using namespace std;
+
+EndlInLoop::EndlInLoop(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+}
+
+// std::endl and Qt::endl, or Qt 5's global endl, and their flush counterparts
+static bool isManipulator(const FunctionDecl *func, StringRef name)
+{
+    if (!func || clazy::name(func) != name)
+        return false;
+
+    if (func->isInStdNamespace())
+        return true;
+
+    const DeclContext *context = func->getDeclContext()->getRedeclContext();
+    if (auto ns = dyn_cast<NamespaceDecl>(context))
+        return clazy::name(ns) == "Qt";
+
+    return context->isTranslationUnit() && func->getNumParams() == 1
+           && clazy::simpleTypeName(func->getParamDecl(0)->getType(), func->getASTContext().getLangOpts()) == "QTextStream";
+}
+
+static bool isStream(const CXXRecordDecl *record)
+{
+    if (!record)
+        return false;
+
+    const StringRef name = clazy::name(record);
+    if (name == "QTextStream" || name == "QFileDevice")
+        return true;
+
+    return record->isInStdNamespace() && (name == "basic_ostream" || name == "basic_iostream" || name == "basic_ofstream" || name == "basic_fstream");
+}
+
+void EndlInLoop::VisitStmt(clang::Stmt *stmt)
+{
+    const StmtFacts &facts = m_context->stmtFacts;
+
+    // stream.flush()
+    if (isa<CXXMemberCallExpr>(stmt)) {
+        CXXMethodDecl *method = facts.method();
+        if (method && clazy::name(method) == "flush" && isStream(facts.record()) && facts.enclosingLoop())
+            emitWarning(clazy::getLocStart(stmt), "flush() called on every iteration, flush once after the loop");
+        return;
+    }
+
+    // stream << std::endl and stream << std::flush
+    auto operatorCall = dyn_cast<CXXOperatorCallExpr>(stmt);
+    if (!operatorCall || operatorCall->getOperator() != OO_LessLess || operatorCall->getNumArgs() != 2)
+        return;
+
+    auto declRef = dyn_cast<DeclRefExpr>(operatorCall->getArg(1)->IgnoreImplicit());
+    auto func = declRef ? dyn_cast<FunctionDecl>(declRef->getDecl()) : nullptr;
+    const bool isEndl = isManipulator(func, "endl");
+    if ((!isEndl && !isManipulator(func, "flush")) || !facts.enclosingLoop())
+        return;
+
+    if (!isEndl) {
+        emitWarning(clazy::getLocStart(declRef), "Flushing on every iteration, flush once after the loop");
+        return;
+    }
+
+    vector<FixItHint> fixits;
+    const SourceRange range = declRef->getSourceRange();
+    if (!range.getBegin().isMacroID() && !range.getEnd().isMacroID())
+        fixits.push_back(clazy::createReplacement(range, "'\\n'"));
+
+    emitWarning(clazy::getLocStart(declRef), "endl flushes the stream on every iteration, use '\\n' and flush once after the loop", fixits);
+}
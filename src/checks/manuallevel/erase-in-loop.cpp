@@ -0,0 +1,275 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "erase-in-loop.h"
+#include "ClazyContext.h"
+#include "HierarchyUtils.h"
+#include "LoopUtils.h"
+#include "StringUtils.h"
+#include "TypeUtils.h"
+#include "Utils.h"
+#include "SourceCompatibilityHelpers.h"
+
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/StmtCXX.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/SourceLocation.h>
+#include <clang/Basic/SourceManager.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+using namespace clang;
+using namespace std;
+
+enum class ContainerKind {
+    None,
+    StdVector,
+    QVector,
+    QList
+};
+
+EraseInLoop::EraseInLoop(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+}
+
+static ContainerKind containerKind(const CXXRecordDecl *record)
+{
+    if (clazy::derivesFrom(record, "std::vector"))
+        return ContainerKind::StdVector;
+
+    // With Qt 6 QVector is an alias of QList, so its records are named QList
+    if (clazy::derivesFrom(record, "QVector"))
+        return ContainerKind::QVector;
+
+    if (clazy::derivesFrom(record, "QList"))
+        return ContainerKind::QList;
+
+    return ContainerKind::None;
+}
+
+static const char *containerName(ContainerKind kind)
+{
+    switch (kind) {
+    case ContainerKind::StdVector:
+        return "std::vector";
+    case ContainerKind::QVector:
+        return "QVector";
+    case ContainerKind::QList:
+        return "QList";
+    case ContainerKind::None:
+        break;
+    }
+
+    return "";
+}
+
+// v.begin(), possibly converted to a const_iterator
+static bool isBeginCall(Expr *expr)
+{
+    while (expr) {
+        expr = expr->IgnoreImplicit();
+        auto constructExpr = dyn_cast<CXXConstructExpr>(expr);
+        if (!constructExpr || constructExpr->getNumArgs() != 1)
+            break;
+        expr = constructExpr->getArg(0);
+    }
+
+    auto call = dyn_cast_or_null<CXXMemberCallExpr>(expr);
+    if (!call || !call->getMethodDecl())
+        return false;
+
+    static const clazy::NameSet beginMethods = { "begin", "cbegin", "constBegin" };
+    return beginMethods.contains(clazy::name(call->getMethodDecl()));
+}
+
+static bool isZero(Expr *expr)
+{
+    auto literal = expr ? dyn_cast<IntegerLiteral>(expr->IgnoreParenImpCasts()) : nullptr;
+    return literal && literal->getValue() == 0;
+}
+
+// Arguments written by the user, not the defaulted ones, like the count of Qt 6's QList::remove(i, n = 1)
+static unsigned int numExplicitArgs(CallExpr *call)
+{
+    unsigned int count = 0;
+    for (Expr *arg : call->arguments()) {
+        if (!isa<CXXDefaultArgExpr>(arg))
+            ++count;
+    }
+
+    return count;
+}
+
+// Insertions and removals at index 0 or begin(), which move every element
+static bool isFrontOperation(CXXMemberCallExpr *call, StringRef methodName)
+{
+    static const clazy::NameSet frontMethods = { "prepend", "push_front", "pop_front", "removeFirst", "takeFirst" };
+    if (frontMethods.contains(methodName))
+        return true;
+
+    if (call->getNumArgs() == 0)
+        return false;
+
+    Expr *firstArg = call->getArg(0);
+    if (methodName == "insert")
+        return isZero(firstArg) || isBeginCall(firstArg);
+
+    if (methodName == "erase")
+        return numExplicitArgs(call) == 1 && isBeginCall(firstArg);
+
+    if (methodName == "removeAt" || methodName == "takeAt" || methodName == "remove")
+        return numExplicitArgs(call) == 1 && isZero(firstArg);
+
+    return false;
+}
+
+// Single element removals, which move the elements after it
+static bool isRemoval(CXXMemberCallExpr *call, StringRef methodName)
+{
+    if (numExplicitArgs(call) != 1)
+        return false;
+
+    static const clazy::NameSet removalMethods = { "erase", "removeAt", "takeAt", "removeOne" };
+    if (removalMethods.contains(methodName))
+        return true;
+
+    // QVector::remove(int i)
+    return methodName == "remove" && call->getArg(0)->getType()->isIntegerType();
+}
+
+static bool referencesDecl(Stmt *stmt, const ValueDecl *decl)
+{
+    if (!stmt)
+        return false;
+
+    if (auto declRef = dyn_cast<DeclRefExpr>(stmt)) {
+        if (declRef->getDecl() == decl)
+            return true;
+    } else if (auto memberExpr = dyn_cast<MemberExpr>(stmt)) {
+        if (memberExpr->getMemberDecl() == decl)
+            return true;
+    }
+
+    for (Stmt *child : stmt->children()) {
+        if (referencesDecl(child, decl))
+            return true;
+    }
+
+    return false;
+}
+
+// for (auto x : v), for (int i = 0; i < v.size();), for (auto it = v.begin(); it != v.end();) or while (!v.isEmpty())
+static bool loopIterates(Stmt *loop, const ValueDecl *container)
+{
+    if (auto rangeLoop = dyn_cast<CXXForRangeStmt>(loop))
+        return referencesDecl(rangeLoop->getRangeInit(), container);
+
+    // The init also covers Q_FOREACH, which iterates over a copy of the container
+    if (auto forStmt = dyn_cast<ForStmt>(loop))
+        return referencesDecl(forStmt->getCond(), container) || referencesDecl(forStmt->getInit(), container);
+
+    if (auto whileStmt = dyn_cast<WhileStmt>(loop))
+        return referencesDecl(whileStmt->getCond(), container);
+
+    if (auto doStmt = dyn_cast<DoStmt>(loop))
+        return referencesDecl(doStmt->getCond(), container);
+
+    return false;
+}
+
+// Whether a break or return after loc leaves the loop, as in loops which remove the element they were looking for
+static bool exitsAfter(Stmt *stmt, const SourceManager &sm, SourceLocation loc, bool breakExits)
+{
+    if (!stmt || isa<LambdaExpr>(stmt))
+        return false;
+
+    if (isa<ReturnStmt>(stmt) || (breakExits && isa<BreakStmt>(stmt)))
+        return sm.isBeforeInTranslationUnit(loc, clazy::getLocStart(stmt));
+
+    // A break inside a nested loop or switch doesn't leave ours
+    breakExits = breakExits && !clazy::isLoop(stmt) && !isa<SwitchStmt>(stmt);
+    for (Stmt *child : stmt->children()) {
+        if (exitsAfter(child, sm, loc, breakExits))
+            return true;
+    }
+
+    return false;
+}
+
+Stmt *EraseInLoop::enclosingLoop(Stmt *stmt, ValueDecl *container) const
+{
+    // Walk up by hand instead of using clazy::isInLoop(), as a lambda defined inside a loop doesn't run there
+    for (Stmt *parent = clazy::parent(m_context, stmt); parent; parent = clazy::parent(m_context, parent)) {
+        if (isa<LambdaExpr>(parent))
+            return nullptr;
+
+        if (clazy::isLoop(parent) && (!container || loopIterates(parent, container)))
+            return parent;
+    }
+
+    return nullptr;
+}
+
+void EraseInLoop::VisitStmt(clang::Stmt *stmt)
+{
+    auto call = dyn_cast<CXXMemberCallExpr>(stmt);
+    CXXMethodDecl *method = call ? call->getMethodDecl() : nullptr;
+    if (!method)
+        return;
+
+    const ContainerKind kind = containerKind(method->getParent());
+    if (kind == ContainerKind::None)
+        return;
+
+    const StringRef methodName = clazy::name(method);
+    const bool atFront = isFrontOperation(call, methodName);
+    ValueDecl *container = nullptr;
+    if (atFront) {
+        // QList keeps free space before its first element, so taking or prepending there doesn't move the others
+        if (kind == ContainerKind::QList)
+            return;
+    } else if (isRemoval(call, methodName)) {
+        // Only removals from the container being iterated over, calls in other loops likely run a bounded number of times
+        container = Utils::valueDeclForMemberCall(call);
+        if (!container)
+            return;
+    } else {
+        return;
+    }
+
+    Stmt *loop = enclosingLoop(stmt, container);
+    if (!loop || exitsAfter(clazy::bodyFromLoop(loop), sm(), clazy::getLocStart(stmt), /*breakExits=*/ true))
+        return;
+
+    const string name = containerName(kind);
+    if (atFront) {
+        emitWarning(clazy::getLocStart(stmt), methodName.str() + "() at the front of a " + name + " inside a loop moves every element on each iteration; consider "
+                    + (kind == ContainerKind::StdVector ? "std::deque" : "QQueue, std::deque") + " or iterating by index");
+    } else {
+        emitWarning(clazy::getLocStart(stmt), methodName.str() + "() inside a loop over the same " + name + " moves the following elements on each iteration; consider "
+                    + (kind == ContainerKind::StdVector ? "the erase/remove_if idiom" : "removeIf() or the erase/remove_if idiom"));
+    }
+}
@@ -0,0 +1,85 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "findchild-in-loop.h"
+#include "ClazyContext.h"
+#include "QtUtils.h"
+#include "StringUtils.h"
+#include "SourceCompatibilityHelpers.h"
+
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/Basic/LLVM.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+using namespace clang;
+using namespace std;
+
+FindChildInLoop::FindChildInLoop(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+}
+
+// timerEvent() isn't always called often, but when it is, it's like paintEvent()
+static bool isTimerEvent(const CXXMethodDecl *method)
+{
+    if (clazy::name(method) == "timerEvent" && clazy::name(method->getParent()) == "QObject")
+        return true;
+
+    for (const CXXMethodDecl *overridden : method->overridden_methods()) {
+        if (isTimerEvent(overridden))
+            return true;
+    }
+
+    return false;
+}
+
+void FindChildInLoop::VisitStmt(clang::Stmt *stmt)
+{
+    const StmtFacts &facts = m_context->stmtFacts;
+    CXXMethodDecl *method = isa<CXXMemberCallExpr>(stmt) ? facts.method() : nullptr;
+    if (!method || facts.recordName() != "QObject")
+        return;
+
+    const StringRef methodName = clazy::name(method);
+    const bool isFindChild = methodName == "findChild" || methodName == "findChildren";
+    if (!isFindChild && methodName != "property")
+        return;
+
+    auto function = dyn_cast_or_null<CXXMethodDecl>(m_context->lastFunctionDecl);
+    const bool inHotMethod = function && (clazy::isHotMethod(function) || isTimerEvent(function));
+    const bool inLoop = facts.enclosingLoop() != nullptr;
+    if (!inLoop && !inHotMethod)
+        return;
+
+    const string where = inLoop ? string("inside a loop") : "inside " + clazy::name(function).str() + "(), which is called very often,";
+    if (isFindChild) {
+        emitWarning(clazy::getLocStart(stmt), methodName.str() + "() " + where
+                    + " walks the object tree and compares object names each time, cache the result in a member");
+    } else {
+        emitWarning(clazy::getLocStart(stmt), "property() " + where
+                    + " looks the property up by name each time, call its getter or cache the QMetaProperty instead");
+    }
+}
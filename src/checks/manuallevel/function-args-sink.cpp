@@ -0,0 +1,258 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "function-args-sink.h"
+#include "ClazyContext.h"
+#include "FixItUtils.h"
+#include "HierarchyUtils.h"
+#include "StmtIndex.h"
+#include "StringUtils.h"
+#include "Utils.h"
+#include "SourceCompatibilityHelpers.h"
+#include "clazy_stl.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/TypeLoc.h>
+#include <clang/Basic/CharInfo.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/SourceManager.h>
+#include <clang/Lex/Lexer.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+using namespace clang;
+using namespace std;
+
+FunctionArgsSink::FunctionArgsSink(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+}
+
+// Returns the class of a const T& parameter, if passing it by value and moving it would avoid copies
+static CXXRecordDecl *sinkableRecord(const ParmVarDecl *param)
+{
+    const QualType type = param->getType();
+    if (!type->isLValueReferenceType())
+        return nullptr;
+
+    const QualType pointee = type->getPointeeType();
+    if (!pointee.isConstQualified() || pointee.isVolatileQualified() || pointee->isDependentType())
+        return nullptr;
+
+    CXXRecordDecl *record = pointee->getAsCXXRecordDecl();
+    record = record ? record->getDefinition() : nullptr;
+    if (!record || record->hasTrivialCopyConstructor() || !record->hasMoveConstructor())
+        return nullptr;
+
+    return record;
+}
+
+static DeclRefExpr *referenceTo(Expr *expr, const ParmVarDecl *param)
+{
+    auto declRef = expr ? dyn_cast<DeclRefExpr>(expr->IgnoreParenImpCasts()) : nullptr;
+    return declRef && declRef->getDecl() == param ? declRef : nullptr;
+}
+
+// Returns the use of param in a member initializer copying it, such as m_foo(foo)
+static DeclRefExpr *copyInInitializer(CXXCtorInitializer *init, const ParmVarDecl *param)
+{
+    if (!init->isAnyMemberInitializer())
+        return nullptr;
+
+    Expr *initExpr = init->getInit();
+    if (auto cleanups = dyn_cast_or_null<ExprWithCleanups>(initExpr))
+        initExpr = cleanups->getSubExpr();
+
+    auto ctorExpr = dyn_cast_or_null<CXXConstructExpr>(initExpr);
+    CXXConstructorDecl *ctor = ctorExpr ? ctorExpr->getConstructor() : nullptr;
+    if (!ctor || !ctor->isCopyConstructor() || ctorExpr->getNumArgs() == 0)
+        return nullptr;
+
+    return referenceTo(ctorExpr->getArg(0), param);
+}
+
+// Returns the use of param in a statement which copy-assigns it to a member, such as m_foo = foo;
+static DeclRefExpr *copyInAssignment(Stmt *stmt, const ParmVarDecl *param)
+{
+    if (auto cleanups = dyn_cast<ExprWithCleanups>(stmt))
+        stmt = cleanups->getSubExpr();
+
+    auto op = dyn_cast<CXXOperatorCallExpr>(stmt);
+    auto method = op ? dyn_cast_or_null<CXXMethodDecl>(op->getDirectCallee()) : nullptr;
+    if (!method || !method->isCopyAssignmentOperator() || op->getNumArgs() != 2
+        || !method->getParent()->hasMoveAssignment())
+        return nullptr;
+
+    auto member = dyn_cast<MemberExpr>(op->getArg(0)->IgnoreParenImpCasts());
+    if (!member || !isa<FieldDecl>(member->getMemberDecl()) || !isa<CXXThisExpr>(member->getBase()->IgnoreParenImpCasts()))
+        return nullptr;
+
+    return referenceTo(op->getArg(1), param);
+}
+
+static vector<DeclRefExpr *> referencesIn(Stmt *stmt, const ParmVarDecl *param, const StmtIndex *index)
+{
+    vector<DeclRefExpr *> references;
+    if (DeclRefExpr *declRef = referenceTo(dyn_cast_or_null<Expr>(stmt), param))
+        references.push_back(declRef);
+
+    for (DeclRefExpr *declRef : clazy::getStatements<DeclRefExpr>(index, stmt)) {
+        if (declRef->getDecl() == param)
+            references.push_back(declRef);
+    }
+
+    return references;
+}
+
+// Returns the only copy of param into a member, if param is dead afterwards
+DeclRefExpr *FunctionArgsSink::sinkUse(CXXMethodDecl *method, ParmVarDecl *param) const
+{
+    auto body = dyn_cast_or_null<CompoundStmt>(method->getBody());
+    if (!body)
+        return nullptr;
+
+    const StmtIndex *index = m_context->functionStmtIndex(body);
+    auto ctor = dyn_cast<CXXConstructorDecl>(method);
+
+    DeclRefExpr *use = nullptr;
+    Stmt *useStmt = nullptr; // The statement of the body assigning it, nullptr for initializers
+    vector<DeclRefExpr *> initializerReferences;
+    if (ctor) {
+        for (CXXCtorInitializer *init : ctor->inits()) {
+            if (DeclRefExpr *copy = copyInInitializer(init, param)) {
+                if (use)
+                    return nullptr;
+                use = copy;
+            }
+            clazy::append(referencesIn(init->getInit(), param, nullptr), initializerReferences);
+        }
+    }
+
+    for (Stmt *stmt : body->body()) {
+        if (DeclRefExpr *copy = copyInAssignment(stmt, param)) {
+            if (use)
+                return nullptr;
+            use = copy;
+            useStmt = stmt;
+        }
+    }
+
+    if (!use || clazy::getFirstChildOfType<GotoStmt>(index, body) || Utils::isCapturedByReference(body, param, index)
+        || Utils::isBoundToReference(body, param, index) || Utils::addressIsTaken(body, param, index))
+        return nullptr;
+
+    const vector<DeclRefExpr *> bodyReferences = referencesIn(body, param, index);
+    if (!useStmt) {
+        // Initializers don't run in the order they're written, so it must be the only use
+        return initializerReferences.size() == 1 && bodyReferences.empty() ? use : nullptr;
+    }
+
+    // Initializers run before the body, so only the body's later statements could use it again
+    const SourceLocation useStart = sm().getExpansionLoc(clazy::getLocStart(useStmt));
+    const bool usedAfterwards = clazy::any_of(bodyReferences, [this, use, useStart](DeclRefExpr *declRef) {
+        return declRef != use && !sm().isBeforeInTranslationUnit(sm().getExpansionLoc(clazy::getLocStart(declRef)), useStart);
+    });
+
+    return usedAfterwards ? nullptr : use;
+}
+
+// Replaces "const T &" with "T" in the parameter's declaration
+static bool byValueFixit(const ParmVarDecl *param, const SourceManager &sm, const LangOptions &lo, FixItHint &fixit)
+{
+    TypeSourceInfo *typeInfo = param->getTypeSourceInfo();
+    if (!typeInfo)
+        return false;
+
+    auto refLoc = typeInfo->getTypeLoc().getAs<LValueReferenceTypeLoc>();
+    if (!refLoc)
+        return false;
+
+    const SourceLocation start = clazy::getLocStart(param);
+    const SourceLocation end = refLoc.getSourceRange().getEnd();
+    const SourceRange pointeeRange = refLoc.getPointeeLoc().getUnqualifiedLoc().getSourceRange();
+    if (start.isMacroID() || end.isMacroID() || pointeeRange.getBegin().isMacroID() || pointeeRange.getEnd().isMacroID())
+        return false;
+
+    string type = Lexer::getSourceText(CharSourceRange::getTokenRange(pointeeRange), sm, lo).str();
+    if (type.empty())
+        return false;
+
+    // "const T &foo" needs a space once the & is gone
+    const SourceLocation afterRef = Lexer::getLocForEndOfToken(end, 0, sm, lo);
+    if (afterRef.isValid() && (isAlphanumeric(*sm.getCharacterData(afterRef)) || *sm.getCharacterData(afterRef) == '_'))
+        type += ' ';
+
+    fixit = clazy::createReplacement({ start, end }, type);
+    return true;
+}
+
+vector<FixItHint> FunctionArgsSink::fixits(CXXMethodDecl *method, unsigned int paramIndex, DeclRefExpr *use) const
+{
+    if (clazy::getLocStart(use).isMacroID())
+        return {};
+
+    vector<FixItHint> result;
+    for (FunctionDecl *redecl : method->redecls()) {
+        auto params = Utils::functionParameters(redecl);
+        if (params.size() <= paramIndex)
+            return {};
+
+        FixItHint fixit;
+        if (!byValueFixit(params[paramIndex], sm(), lo(), fixit))
+            return {};
+        result.push_back(fixit);
+    }
+
+    const string name = clazy::name(use->getDecl()).str();
+    result.push_back(clazy::createReplacement(use->getSourceRange(), "std::move(" + name + ")"));
+    return result;
+}
+
+void FunctionArgsSink::VisitDecl(clang::Decl *decl)
+{
+    auto method = dyn_cast<CXXMethodDecl>(decl);
+    if (!method || !method->isThisDeclarationADefinition() || method->isDeleted() || method->isDefaulted()
+        || method->isVirtual() || method->isCopyAssignmentOperator() || method->isMoveAssignmentOperator())
+        return;
+
+    auto ctor = dyn_cast<CXXConstructorDecl>(method);
+    if (ctor && ctor->isCopyOrMoveConstructor())
+        return;
+
+    auto params = Utils::functionParameters(method);
+    for (unsigned int i = 0; i < params.size(); ++i) {
+        ParmVarDecl *param = params[i];
+        if (param->getName().empty() || !sinkableRecord(param))
+            continue;
+
+        DeclRefExpr *use = sinkUse(method, param);
+        if (!use)
+            continue;
+
+        emitWarning(clazy::getLocStart(param), "'" + param->getName().str() + "' is only copied into a member, pass it by value and move it instead",
+                    fixits(method, i, use));
+    }
+}
@@ -0,0 +1,59 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_FUNCTION_ARGS_SINK_H
+#define CLAZY_FUNCTION_ARGS_SINK_H
+
+#include "checkbase.h"
+
+#include <string>
+#include <vector>
+
+class ClazyContext;
+
+namespace clang {
+class CXXMethodDecl;
+class DeclRefExpr;
+class Decl;
+class FixItHint;
+class ParmVarDecl;
+}
+
+/**
+ * Finds const-ref parameters of constructors and setters which are only copied into a member,
+ * which should be passed by value and moved instead, so callers can move in temporaries.
+ *
+ * See README-function-args-sink.md for more info.
+ */
+class FunctionArgsSink
+    : public CheckBase
+{
+public:
+    explicit FunctionArgsSink(const std::string &name, ClazyContext *context);
+    void VisitDecl(clang::Decl *decl) override;
+
+private:
+    clang::DeclRefExpr *sinkUse(clang::CXXMethodDecl *method, clang::ParmVarDecl *param) const;
+    std::vector<clang::FixItHint> fixits(clang::CXXMethodDecl *method, unsigned int paramIndex, clang::DeclRefExpr *use) const;
+};
+
+#endif
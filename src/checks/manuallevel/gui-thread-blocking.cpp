@@ -0,0 +1,223 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#include "gui-thread-blocking.h"
+#include "AccessSpecifierManager.h"
+#include "ClazyContext.h"
+#include "QtUtils.h"
+#include "StmtIndex.h"
+#include "StringUtils.h"
+#include "TypeUtils.h"
+#include "SourceCompatibilityHelpers.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/Type.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/SourceManager.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+#include <vector>
+
+using namespace clang;
+using namespace std;
+
+// How many calls deep helpers are followed, so slot() -> load() -> readFile() -> QFile::readAll() is still caught
+static const int s_maxDepth = 2;
+
+static const char *const s_ioAdvice = "move the I/O to a worker thread";
+static const char *const s_waitAdvice = "connect to its signals instead";
+static const char *const s_processEventsAdvice = "move the long running work to a worker thread instead";
+static const char *const s_sleepAdvice = "use a QTimer instead";
+
+GuiThreadBlocking::GuiThreadBlocking(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes)
+{
+    context->enableAccessSpecifierManager();
+}
+
+// Returns the record of the object a member function is called on
+static CXXRecordDecl *objectRecord(CXXMemberCallExpr *memberCall)
+{
+    Expr *object = memberCall->getImplicitObjectArgument();
+    return object ? clazy::pointeeQualType(object->getType())->getAsCXXRecordDecl() : nullptr;
+}
+
+// Returns the advice for a call which blocks, or nullptr. name is set to how the warning calls it.
+static const char *blockingCallAdvice(Stmt *stmt, string &name)
+{
+    if (auto ctorExpr = dyn_cast<CXXConstructExpr>(stmt)) {
+        CXXConstructorDecl *ctor = ctorExpr->getConstructor();
+        if (!ctor || ctor->isCopyOrMoveConstructor() || !clazy::isOfClass(ctor, "QSettings"))
+            return nullptr;
+
+        name = "QSettings constructor";
+        return s_ioAdvice;
+    }
+
+    auto call = dyn_cast<CallExpr>(stmt);
+    auto method = call ? dyn_cast_or_null<CXXMethodDecl>(call->getDirectCallee()) : nullptr;
+    if (!method)
+        return nullptr;
+
+    const StringRef methodName = clazy::name(method);
+    const StringRef className = clazy::name(method->getParent());
+    if (method->isStatic()) {
+        const char *advice = nullptr;
+        if (methodName == "processEvents" && className == "QCoreApplication")
+            advice = s_processEventsAdvice;
+        else if ((methodName == "sleep" || methodName == "msleep" || methodName == "usleep") && className == "QThread")
+            advice = s_sleepAdvice;
+
+        if (advice)
+            name = clazy::qualifiedMethodName(method) + "()";
+        return advice;
+    }
+
+    auto memberCall = dyn_cast<CXXMemberCallExpr>(call);
+    CXXRecordDecl *object = memberCall ? objectRecord(memberCall) : nullptr;
+    if (!object)
+        return nullptr;
+
+    if (methodName == "processEvents" && className == "QEventLoop") {
+        name = "QEventLoop::processEvents()";
+        return s_processEventsAdvice;
+    }
+
+    // QProcess::waitForFinished(), QAbstractSocket::waitForConnected(), QIODevice::waitForReadyRead() and friends
+    if (methodName.startswith("waitFor") && clazy::derivesFrom(object, "QIODevice")) {
+        name = clazy::qualifiedMethodName(method) + "()";
+        return s_waitAdvice;
+    }
+
+    static const clazy::NameSet fileMethods = { "open", "readAll", "readLine", "read", "write" };
+    if (fileMethods.contains(methodName) && clazy::derivesFrom(object, "QFileDevice")) {
+        name = clazy::name(object).str() + "::" + methodName.str() + "()";
+        return s_ioAdvice;
+    }
+
+    if ((methodName == "entryList" || methodName == "entryInfoList") && className == "QDir") {
+        name = "QDir::" + methodName.str() + "()";
+        return s_ioAdvice;
+    }
+
+    return nullptr;
+}
+
+// Returns the slots and event handlers of GUI classes, which run in the GUI thread
+const char *GuiThreadBlocking::guiMethodKind(CXXMethodDecl *method) const
+{
+    if (!clazy::isGuiClass(method->getParent()))
+        return nullptr;
+
+    AccessSpecifierManager *accessSpecifierManager = m_context->accessSpecifierManager;
+    if (accessSpecifierManager && accessSpecifierManager->qtAccessSpecifierType(method) == QtAccessSpecifier_Slot)
+        return "slot";
+
+    const StringRef methodName = clazy::name(method);
+    if (method->size_overridden_methods() > 0
+        && (methodName == "event" || methodName == "eventFilter" || methodName.endswith("Event")))
+        return "event handler";
+
+    return nullptr;
+}
+
+const GuiThreadBlocking::Blocking &GuiThreadBlocking::blockingIn(const FunctionDecl *func, int depth)
+{
+    auto key = make_pair(func, depth);
+    auto it = m_blockingFunctions.find(key);
+    if (it != m_blockingFunctions.end())
+        return it->second;
+
+    // Inserted before scanning, so recursive functions terminate
+    m_blockingFunctions[key] = {};
+    Blocking blocking;
+    Stmt *body = func->getBody();
+    for (Stmt *stmt : clazy::getStatements<Stmt>(m_context->functionStmtIndex(body), body)) {
+        FunctionDecl *helper = nullptr;
+        if (findBlocking(stmt, depth, blocking.name, blocking.advice, helper)) {
+            if (helper)
+                blocking.name = clazy::qualifiedMethodName(helper) + "(), which calls " + blocking.name;
+            break;
+        }
+    }
+
+    return m_blockingFunctions[key] = blocking;
+}
+
+// Returns true if stmt blocks, directly or via a helper defined in this translation unit, which is then set
+bool GuiThreadBlocking::findBlocking(Stmt *stmt, int depth, string &name, const char *&advice, FunctionDecl *&helper)
+{
+    helper = nullptr;
+    advice = blockingCallAdvice(stmt, name);
+    if (advice)
+        return true;
+
+    auto call = dyn_cast<CallExpr>(stmt);
+    FunctionDecl *callee = call && depth > 0 ? call->getDirectCallee() : nullptr;
+    const FunctionDecl *definition = nullptr;
+    if (!callee || !callee->hasBody(definition) || sm().isInSystemHeader(clazy::getLocStart(definition)))
+        return false;
+
+    // It gets its own warning
+    auto calledMethod = dyn_cast<CXXMethodDecl>(callee);
+    if (calledMethod && guiMethodKind(calledMethod))
+        return false;
+
+    const Blocking &blocking = blockingIn(definition, depth - 1);
+    if (!blocking.advice)
+        return false;
+
+    name = blocking.name;
+    advice = blocking.advice;
+    helper = callee;
+    return true;
+}
+
+void GuiThreadBlocking::VisitDecl(clang::Decl *decl)
+{
+    auto method = dyn_cast<CXXMethodDecl>(decl);
+    if (!method || !method->isThisDeclarationADefinition() || !method->hasBody() || method->isDependentContext())
+        return;
+
+    const char *kind = guiMethodKind(method);
+    if (!kind)
+        return;
+
+    const string where = string(" blocks the GUI thread inside ") + kind + " " + clazy::qualifiedMethodName(method) + "()";
+    Stmt *body = method->getBody();
+    for (Stmt *stmt : clazy::getStatements<Stmt>(m_context->functionStmtIndex(body), body)) {
+        string name;
+        const char *advice = nullptr;
+        FunctionDecl *helper = nullptr;
+        if (!findBlocking(stmt, s_maxDepth, name, advice, helper))
+            continue;
+
+        if (helper)
+            emitWarning(clazy::getLocStart(stmt), clazy::qualifiedMethodName(helper) + "()" + where + ", as it calls " + name + ", " + advice);
+        else
+            emitWarning(clazy::getLocStart(stmt), name + where + ", " + advice);
+    }
+}
@@ -0,0 +1,64 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#ifndef CLAZY_GUI_THREAD_BLOCKING_H
+#define CLAZY_GUI_THREAD_BLOCKING_H
+
+#include "checkbase.h"
+
+#include <map>
+#include <string>
+#include <utility>
+
+class ClazyContext;
+
+namespace clang {
+class CXXMethodDecl;
+class Decl;
+class FunctionDecl;
+class Stmt;
+}
+
+/**
+ * Finds blocking I/O, waitFor*() calls, sleeps and processEvents() inside slots and event handlers
+ * of QWidget, QQuickItem and QWindow derived classes, also via helper functions a few calls deep.
+ *
+ * See README-gui-thread-blocking.md for more info.
+ */
+class GuiThreadBlocking
+    : public CheckBase
+{
+public:
+    explicit GuiThreadBlocking(const std::string &name, ClazyContext *context);
+    void VisitDecl(clang::Decl *decl) override;
+private:
+    struct Blocking {
+        std::string name; // The blocking call, prefixed by the helpers leading to it
+        const char *advice = nullptr; // nullptr if the function doesn't block
+    };
+
+    const char *guiMethodKind(clang::CXXMethodDecl *method) const;
+    const Blocking &blockingIn(const clang::FunctionDecl *func, int depth);
+    bool findBlocking(clang::Stmt *stmt, int depth, std::string &name, const char *&advice, clang::FunctionDecl *&helper);
+    std::map<std::pair<const clang::FunctionDecl *, int>, Blocking> m_blockingFunctions; // Result of blockingIn()
+};
+
+#endif
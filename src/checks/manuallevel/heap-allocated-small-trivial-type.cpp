@@ -22,10 +22,14 @@
 #include "heap-allocated-small-trivial-type.h"
 #include "Utils.h"
 #include "StmtBodyRange.h"
+#include "StmtIndex.h"
 #include "HierarchyUtils.h"
 #include "QtUtils.h"
+#include "StringUtils.h"
+#include "TemplateUtils.h"
 #include "TypeUtils.h"
 #include "ClazyContext.h"
+#include "clazy_stl.h"
 
 #include <clang/AST/AST.h>
 
@@ -35,14 +39,210 @@ using namespace std;
 
 HeapAllocatedSmallTrivialType::HeapAllocatedSmallTrivialType(const std::string &name,
                                                              ClazyContext *context)
-    : CheckBase(name, context)
+    : CheckBase(name, context, Option_Reusable)
 {
 }
 
+// Returns the name of the smart pointer class, or nullptr if it's not one
+static const char *smartPointerName(QualType qualType)
+{
+    const CXXRecordDecl *record = qualType.isNull() ? nullptr : qualType->getAsCXXRecordDecl();
+    if (!record)
+        return nullptr;
+
+    const StringRef name = clazy::name(record);
+    if (record->isInStdNamespace()) {
+        if (name == "unique_ptr")
+            return "std::unique_ptr";
+        return name == "shared_ptr" ? "std::shared_ptr" : nullptr;
+    }
+
+    if (name == "QScopedPointer")
+        return "QScopedPointer";
+    return name == "QSharedPointer" ? "QSharedPointer" : nullptr;
+}
+
+static const char *containerName(QualType qualType)
+{
+    const CXXRecordDecl *record = qualType.isNull() ? nullptr : qualType->getAsCXXRecordDecl();
+    if (!record)
+        return nullptr;
+
+    const StringRef name = clazy::name(record);
+    if (record->isInStdNamespace())
+        return name == "vector" ? "std::vector" : nullptr;
+
+    if (name == "QVector")
+        return "QVector";
+    return name == "QList" ? "QList" : nullptr;
+}
+
+static QualType firstTemplateArgument(QualType qualType)
+{
+    auto specialization = dyn_cast_or_null<ClassTemplateSpecializationDecl>(qualType->getAsCXXRecordDecl());
+    return clazy::getTemplateArgumentType(specialization, 0);
+}
+
+// Returns the record if it's small and trivial, and not a pimpl, which would be forward declared in the header
+static const CXXRecordDecl *smallTrivialRecord(const ClazyContext *context, QualType qualType)
+{
+    if (qualType.isNull() || !clazy::isSmallTrivial(context, qualType))
+        return nullptr;
+
+    const CXXRecordDecl *record = qualType->getAsCXXRecordDecl();
+    if (!record || clazy::contains(record->getQualifiedNameAsString(), "Private"))
+        return nullptr;
+
+    return record;
+}
+
+static Expr *ignoreElidedCopies(Expr *expr)
+{
+    expr = expr->IgnoreImplicit();
+    if (auto cast = dyn_cast<ExplicitCastExpr>(expr))
+        expr = cast->getSubExpr()->IgnoreImplicit();
+
+    auto construct = dyn_cast<CXXConstructExpr>(expr);
+    if (construct && construct->isElidable() && construct->getNumArgs() == 1)
+        return construct->getArg(0)->IgnoreImplicit();
+
+    return expr;
+}
+
+// Returns true for std::make_unique<T>(), std::make_shared<T>(), QSharedPointer<T>::create() and constructing from new T
+static bool allocatesObject(Expr *init)
+{
+    init = ignoreElidedCopies(init);
+    if (auto construct = dyn_cast<CXXConstructExpr>(init)) {
+        auto newExpr = construct->getNumArgs() > 0 ? dyn_cast<CXXNewExpr>(construct->getArg(0)->IgnoreImplicit()) : nullptr;
+        return newExpr && !newExpr->isArray() && newExpr->getNumPlacementArgs() == 0;
+    }
+
+    auto callExpr = dyn_cast<CallExpr>(init);
+    FunctionDecl *func = callExpr ? callExpr->getDirectCallee() : nullptr;
+    if (!func)
+        return false;
+
+    const StringRef name = clazy::name(func);
+    if (func->isInStdNamespace())
+        return name == "make_unique" || name == "make_shared";
+
+    auto method = dyn_cast<CXXMethodDecl>(func);
+    return method && name == "create" && clazy::name(method->getParent()) == "QSharedPointer";
+}
+
+// Returns true if the smart pointer, or the object it points to, might be used outside of body
+static bool smartPointerEscapes(Stmt *body, const VarDecl *varDecl, const StmtIndex *index)
+{
+    if (!index || Utils::isAssignedTo(body, varDecl, index) || Utils::isReturned(body, varDecl, index))
+        return true;
+
+    for (const StmtIndex::DeclUse &use : index->usesOf(varDecl, body)) {
+        if (use.kind == StmtIndex::DeclUse_AddressTaken)
+            return true;
+
+        if (use.kind != StmtIndex::DeclUse_PassedToFunction)
+            continue;
+
+        // p->v and *p are fine, anything else can move, copy or alias it
+        auto operatorCall = dyn_cast<CXXOperatorCallExpr>(use.stmt);
+        if (!operatorCall || use.argIndex != 0
+            || (operatorCall->getOperator() != OO_Arrow && operatorCall->getOperator() != OO_Star))
+            return true;
+    }
+
+    static const clazy::NameSet rawPointerMethods = { "get", "data", "release", "take" };
+    for (CXXMemberCallExpr *memberCall : index->statementsOfType<CXXMemberCallExpr>(body)) {
+        CXXMethodDecl *method = memberCall->getMethodDecl();
+        if (method && rawPointerMethods.contains(clazy::name(method)) && Utils::valueDeclForMemberCall(memberCall) == varDecl)
+            return true;
+    }
+
+    return false;
+}
+
+// Returns true if body stores a new T into the container, so the raw pointers it holds are owning ones
+static bool appendsNewExpr(Stmt *body, const VarDecl *varDecl, const StmtIndex *index)
+{
+    if (!index)
+        return false;
+
+    static const clazy::NameSet appendMethods = { "append", "prepend", "push_back", "push_front", "emplace_back",
+                                                  "insert", "operator<<", "operator+=" };
+    for (CallExpr *callExpr : index->statementsOfType<CallExpr>(body)) {
+        auto method = dyn_cast_or_null<CXXMethodDecl>(callExpr->getDirectCallee());
+        if (!method || !appendMethods.contains(clazy::name(method)) || Utils::valueDeclForCallExpr(callExpr) != varDecl)
+            continue;
+
+        for (Expr *arg : callExpr->arguments()) {
+            if (isa<CXXNewExpr>(arg->IgnoreImplicit()))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+bool HeapAllocatedSmallTrivialType::checkContainer(DeclaratorDecl *decl, FunctionDecl *function)
+{
+    const char *container = containerName(decl->getType());
+    const QualType elementType = container ? firstTemplateArgument(decl->getType()) : QualType();
+    if (elementType.isNull())
+        return false;
+
+    const char *smartPointer = smartPointerName(elementType);
+    const bool isRawPointer = elementType->isPointerType();
+    if (!smartPointer && !isRawPointer)
+        return false;
+
+    const CXXRecordDecl *record = smallTrivialRecord(m_context, isRawPointer ? elementType->getPointeeType()
+                                                                            : firstTemplateArgument(elementType));
+    if (!record)
+        return false;
+
+    // A container of raw pointers might not own them, only warn if we see it storing new ones
+    if (isRawPointer) {
+        Stmt *body = function ? function->getBody() : nullptr;
+        if (!body || !appendsNewExpr(body, cast<VarDecl>(decl), m_context->functionStmtIndex(body)))
+            return false;
+    }
+
+    emitWarning(decl->getLocation(), string("Don't store small trivially copyable/destructible types through ")
+                + (isRawPointer ? "owning pointers" : smartPointer) + " in a " + container
+                + ", store them by value instead: " + record->getQualifiedNameAsString());
+    return true;
+}
+
+bool HeapAllocatedSmallTrivialType::checkSmartPointer(VarDecl *varDecl, FunctionDecl *function)
+{
+    const char *smartPointer = smartPointerName(varDecl->getType());
+    if (!smartPointer || !varDecl->getInit() || !allocatesObject(varDecl->getInit()))
+        return false;
+
+    const CXXRecordDecl *record = smallTrivialRecord(m_context, firstTemplateArgument(varDecl->getType()));
+    Stmt *body = function->getBody();
+    if (!record || !body || smartPointerEscapes(body, varDecl, m_context->functionStmtIndex(body)))
+        return false;
+
+    emitWarning(varDecl->getLocation(), string("Don't heap-allocate small trivially copyable/destructible types with ")
+                + smartPointer + ", use a local variable instead: " + record->getQualifiedNameAsString());
+    return true;
+}
+
 void HeapAllocatedSmallTrivialType::VisitDecl(clang::Decl *decl)
 {
+    if (auto fieldDecl = dyn_cast<FieldDecl>(decl)) {
+        checkContainer(fieldDecl, nullptr);
+        return;
+    }
+
     auto varDecl = dyn_cast<VarDecl>(decl);
-    if (!varDecl)
+    if (!varDecl || isa<ParmVarDecl>(varDecl))
+        return;
+
+    DeclContext *context = varDecl->getDeclContext();
+    FunctionDecl *fDecl = context ? dyn_cast<FunctionDecl>(context) : nullptr;
+    if (checkContainer(varDecl, fDecl) || !fDecl || checkSmartPointer(varDecl, fDecl))
         return;
 
     Expr *init = varDecl->getInit();
@@ -56,11 +256,6 @@ void HeapAllocatedSmallTrivialType::VisitDecl(clang::Decl *decl)
     if (newExpr->isArray())
         return;
 
-    DeclContext *context = varDecl->getDeclContext();
-    FunctionDecl *fDecl = context ? dyn_cast<FunctionDecl>(context) : nullptr;
-    if (!fDecl)
-        return;
-
     QualType qualType = newExpr->getType()->getPointeeType();
     if (clazy::isSmallTrivial(m_context, qualType)) {
         if (clazy::contains(qualType.getAsString(), "Private")) {
@@ -69,9 +264,10 @@ void HeapAllocatedSmallTrivialType::VisitDecl(clang::Decl *decl)
         }
 
         auto body = fDecl->getBody();
-        if (Utils::isAssignedTo(body, varDecl) ||
-            Utils::isPassedToFunction(StmtBodyRange(body), varDecl, false) ||
-            Utils::isReturned(body, varDecl))
+        const StmtIndex *index = m_context->functionStmtIndex(body);
+        if (Utils::isAssignedTo(body, varDecl, index) ||
+            Utils::isPassedToFunction(StmtBodyRange(body, nullptr, {}, index), varDecl, false) ||
+            Utils::isReturned(body, varDecl, index))
             return;
 
         emitWarning(init, "Don't heap-allocate small trivially copyable/destructible types: " + qualType.getAsString());
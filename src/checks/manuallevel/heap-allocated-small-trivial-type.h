@@ -24,6 +24,11 @@
 
 #include "checkbase.h"
 
+namespace clang {
+class DeclaratorDecl;
+class FunctionDecl;
+class VarDecl;
+}
 
 /**
  * See README-heap-allocated-small-trivial-type.md for more info.
@@ -34,6 +39,8 @@ public:
     explicit HeapAllocatedSmallTrivialType(const std::string &name, ClazyContext *context);
     void VisitDecl(clang::Decl *decl) override;
 private:
+    bool checkContainer(clang::DeclaratorDecl *decl, clang::FunctionDecl *function);
+    bool checkSmartPointer(clang::VarDecl *varDecl, clang::FunctionDecl *function);
 };
 
 #endif
@@ -0,0 +1,219 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "heterogeneous-lookup.h"
+#include "ClazyContext.h"
+#include "FixItUtils.h"
+#include "HierarchyUtils.h"
+#include "StmtIndex.h"
+#include "StringUtils.h"
+#include "SourceCompatibilityHelpers.h"
+#include "TypeUtils.h"
+
+#include <clang/AST/ASTContext.h>
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/DeclTemplate.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/TemplateBase.h>
+#include <clang/AST/Type.h>
+#include <clang/AST/TypeLoc.h>
+#include <clang/Basic/Diagnostic.h>
+#include <clang/Basic/IdentifierTable.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/OperatorKinds.h>
+#include <clang/Basic/SourceLocation.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+using namespace clang;
+using namespace std;
+
+namespace {
+struct ContainerKind {
+    bool isUnordered;
+    bool isMap;
+};
+}
+
+static bool containerKind(const ClassTemplateSpecializationDecl *record, ContainerKind &kind)
+{
+    static const clazy::NameSet containers = { "map", "multimap", "set", "multiset", "unordered_map", "unordered_multimap",
+                                               "unordered_set", "unordered_multiset" };
+    if (!record || !record->isInStdNamespace() || !containers.contains(clazy::name(record)))
+        return false;
+
+    const StringRef name = clazy::name(record);
+    kind.isUnordered = name.startswith("unordered_");
+    kind.isMap = name.endswith("map");
+    return true;
+}
+
+static CXXRecordDecl *templateArgumentRecord(const ClassTemplateSpecializationDecl *record, unsigned int index)
+{
+    const TemplateArgumentList &args = record->getTemplateArgs();
+    if (index >= args.size() || args[index].getKind() != TemplateArgument::Type)
+        return nullptr;
+
+    return args[index].getAsType()->getAsCXXRecordDecl();
+}
+
+// std::less<> and std::equal_to<> declare is_transparent, as do the hashes written for heterogeneous lookup
+static bool isTransparent(ASTContext *astContext, const CXXRecordDecl *functor)
+{
+    return !functor || !functor->lookup(DeclarationName(&astContext->Idents.get("is_transparent"))).empty();
+}
+
+// Returns the type the key is converted from, if arg constructs a std::string from a const char * or a std::string_view
+static string convertedFromType(Expr *arg)
+{
+    arg = arg->IgnoreImplicit();
+    while (auto cast = dyn_cast<CXXFunctionalCastExpr>(arg)) // std::string(view)
+        arg = cast->getSubExpr()->IgnoreImplicit();
+
+    auto construct = dyn_cast<CXXConstructExpr>(arg);
+    CXXConstructorDecl *ctor = construct ? construct->getConstructor() : nullptr;
+    if (!ctor || ctor->getNumParams() == 0 || ctor->isCopyOrMoveConstructor()
+        || !clazy::qualifiedNameIs(ctor->getParent(), "std::basic_string"))
+        return {};
+
+    const QualType paramType = clazy::unrefQualType(ctor->getParamDecl(0)->getType());
+    if (paramType->isPointerType() && paramType->getPointeeType()->isCharType())
+        return "const char *";
+
+    if (clazy::qualifiedNameIs(paramType->getAsCXXRecordDecl(), "std::basic_string_view"))
+        return "std::string_view";
+
+    return {};
+}
+
+HeterogeneousLookup::HeterogeneousLookup(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes)
+{
+}
+
+// The fixit changes the variable's type, which is only safe if it isn't passed anywhere expecting the old one
+bool HeterogeneousLookup::isOnlyUsedAsObject(VarDecl *varDecl) const
+{
+    auto func = dyn_cast<FunctionDecl>(varDecl->getDeclContext());
+    Stmt *body = func ? func->getBody() : nullptr;
+    if (!body)
+        return false;
+
+    for (DeclRefExpr *declRef : clazy::getStatements<DeclRefExpr>(m_context->functionStmtIndex(body), body)) {
+        if (declRef->getDecl() != varDecl)
+            continue;
+
+        // map.find(key), map[key], or the implicit range variable of for (auto &it : map)
+        Stmt *parent = clazy::parent(m_context, declRef);
+        if (parent && isa<MemberExpr>(parent))
+            continue;
+
+        auto op = dyn_cast_or_null<CXXOperatorCallExpr>(parent);
+        if (op && op->getOperator() == OO_Subscript && op->getArg(0) == declRef)
+            continue;
+
+        auto declStmt = dyn_cast_or_null<DeclStmt>(parent);
+        if (!declStmt || !declStmt->isSingleDecl() || !declStmt->getSingleDecl()->isImplicit())
+            return false;
+    }
+
+    return true;
+}
+
+vector<FixItHint> HeterogeneousLookup::fixits(VarDecl *varDecl, unsigned int numWrittenArgs)
+{
+    if (!fixitsEnabled() || !lo().CPlusPlus14 || m_fixedDecls.count(varDecl) || !varDecl->isLocalVarDecl())
+        return {};
+
+    TypeSourceInfo *typeSourceInfo = varDecl->getTypeSourceInfo();
+    if (!typeSourceInfo)
+        return {};
+
+    // const std::map<std::string, int> becomes const std::map<std::string, int, std::less<>>
+    TypeLoc typeLoc = typeSourceInfo->getTypeLoc().getUnqualifiedLoc();
+    if (auto elaborated = typeLoc.getAs<ElaboratedTypeLoc>())
+        typeLoc = elaborated.getNamedTypeLoc().getUnqualifiedLoc();
+
+    auto specializationLoc = typeLoc.getAs<TemplateSpecializationTypeLoc>();
+    if (!specializationLoc || specializationLoc.getNumArgs() != numWrittenArgs || specializationLoc.getRAngleLoc().isMacroID()
+        || !isOnlyUsedAsObject(varDecl))
+        return {};
+
+    m_fixedDecls.insert(varDecl);
+    return { clazy::createInsertion(specializationLoc.getRAngleLoc(), ", std::less<>") };
+}
+
+void HeterogeneousLookup::VisitStmt(clang::Stmt *stmt)
+{
+    auto call = dyn_cast<CXXMemberCallExpr>(stmt);
+    if (!call || call->getNumArgs() == 0 || clazy::getLocStart(call).isMacroID())
+        return;
+
+    auto record = dyn_cast_or_null<ClassTemplateSpecializationDecl>(call->getRecordDecl());
+    ContainerKind kind;
+    if (!containerKind(record, kind))
+        return;
+
+    // Before C++26, at(), operator[] and erase() don't have heterogeneous overloads
+    static const clazy::NameSet orderedLookups = { "find", "count", "contains", "equal_range", "lower_bound", "upper_bound" };
+    static const clazy::NameSet unorderedLookups = { "find", "count", "contains", "equal_range" };
+    CXXMethodDecl *method = call->getMethodDecl();
+    if (!clazy::functionIsOneOf(method, kind.isUnordered ? unorderedLookups : orderedLookups))
+        return;
+
+    // Unordered containers only support it since C++20
+    if (kind.isUnordered ? !clazy::isCPlusPlus20(lo()) : !lo().CPlusPlus14)
+        return;
+
+    if (!clazy::qualifiedNameIs(templateArgumentRecord(record, 0), "std::basic_string"))
+        return;
+
+    // The comparator, or the hash and the equality, follow the key and the mapped type
+    const unsigned int functorIndex = kind.isMap ? 2 : 1;
+    if (kind.isUnordered) {
+        if (isTransparent(m_astContext, templateArgumentRecord(record, functorIndex))
+            && isTransparent(m_astContext, templateArgumentRecord(record, functorIndex + 1)))
+            return;
+    } else if (isTransparent(m_astContext, templateArgumentRecord(record, functorIndex))) {
+        return;
+    }
+
+    const string fromType = convertedFromType(call->getArg(0));
+    if (fromType.empty())
+        return;
+
+    const string name = "std::" + clazy::name(record).str() + "::" + clazy::name(method).str() + "()";
+    if (kind.isUnordered) {
+        emitWarning(clazy::getLocStart(call), name + " converts the " + fromType + " key to a std::string on every lookup;"
+                    " give the container a hash declaring is_transparent and std::equal_to<> for heterogeneous lookup");
+        return;
+    }
+
+    auto declRef = dyn_cast<DeclRefExpr>(call->getImplicitObjectArgument()->IgnoreImpCasts());
+    auto varDecl = declRef ? dyn_cast<VarDecl>(declRef->getDecl()) : nullptr;
+    emitWarning(clazy::getLocStart(call), name + " converts the " + fromType + " key to a std::string on every lookup;"
+                " use std::less<> as comparator for heterogeneous lookup",
+                varDecl ? fixits(varDecl, functorIndex) : vector<FixItHint>());
+}
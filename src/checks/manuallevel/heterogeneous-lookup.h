@@ -0,0 +1,60 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_HETEROGENEOUS_LOOKUP_H
+#define CLAZY_HETEROGENEOUS_LOOKUP_H
+
+#include "checkbase.h"
+
+#include <llvm/ADT/DenseSet.h>
+
+#include <string>
+#include <vector>
+
+class ClazyContext;
+
+namespace clang {
+class FixItHint;
+class Stmt;
+class VarDecl;
+}
+
+/**
+ * Finds lookups into std::map, std::set and their unordered and multi variants keyed by std::string, with a
+ * const char * or std::string_view converted to a std::string on every call, as the container isn't transparent.
+ *
+ * See README-heterogeneous-lookup.md for more info.
+ */
+class HeterogeneousLookup
+    : public CheckBase
+{
+public:
+    explicit HeterogeneousLookup(const std::string &name, ClazyContext *context);
+    void VisitStmt(clang::Stmt *stmt) override;
+private:
+    std::vector<clang::FixItHint> fixits(clang::VarDecl *varDecl, unsigned int numWrittenArgs);
+    bool isOnlyUsedAsObject(clang::VarDecl *varDecl) const;
+
+    llvm::DenseSet<const clang::VarDecl *> m_fixedDecls; // So the type is only rewritten once
+};
+
+#endif
@@ -0,0 +1,170 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "hot-path-allocations.h"
+#include "ClazyContext.h"
+#include "HierarchyUtils.h"
+#include "QtUtils.h"
+#include "StmtIndex.h"
+#include "StringUtils.h"
+#include "TypeUtils.h"
+#include "SourceCompatibilityHelpers.h"
+#include "clazy_stl.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/Type.h>
+#include <clang/Basic/LLVM.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+#include <unordered_set>
+#include <vector>
+
+using namespace clang;
+using namespace std;
+
+// Classes whose construction allocates, except default constructing the ones with a shared default instance
+static bool isAllocatingConstruction(CXXConstructorDecl *ctor)
+{
+    static const clazy::NameSet alwaysAllocating = { "QPainterPath", "QRegion" };
+    static const clazy::NameSet allocatingUnlessDefault = { "QFont", "QPen", "QBrush", "QImage", "QPixmap" };
+
+    const StringRef className = clazy::name(ctor->getParent());
+    if (alwaysAllocating.contains(className))
+        return true;
+
+    return allocatingUnlessDefault.contains(className) && !ctor->isDefaultConstructor();
+}
+
+// Returns true if the constructor loads a file, such as QPixmap(QString fileName)
+static bool isLoadingConstruction(CXXConstructorDecl *ctor)
+{
+    static const clazy::NameSet loadingClasses = { "QPixmap", "QImage", "QIcon", "QMovie" };
+    const StringRef className = clazy::name(ctor->getParent());
+    if (className == "QSettings")
+        return true;
+
+    if (!loadingClasses.contains(className) || ctor->getNumParams() == 0)
+        return false;
+
+    const QualType type = clazy::unrefQualType(ctor->getParamDecl(0)->getType());
+    if (const CXXRecordDecl *record = type->getAsCXXRecordDecl())
+        return clazy::name(record) == "QString";
+
+    return type->isPointerType() && type->getPointeeType()->isCharType();
+}
+
+// Decoded images can also be shared across calls and objects, as a static or through QPixmapCache
+static string loadingFixSuggestion(StringRef className)
+{
+    if (className == "QPixmap")
+        return "load it once and cache it in a member, a static or QPixmapCache";
+
+    if (className == "QSettings")
+        return "load it once and cache it in a member";
+
+    return "load it once and cache it in a member or a static";
+}
+
+static bool isLoadingCall(FunctionDecl *func)
+{
+    static const vector<StringRef> loadingMethods = { "QPixmap::load", "QImage::load", "QImageReader::read", "QFile::open",
+                                                      "QIODevice::readAll", "QDir::entryList", "QDir::entryInfoList" };
+    return clazy::any_of(loadingMethods, [func](StringRef name) { return clazy::qualifiedMethodNameIs(func, name); });
+}
+
+static bool isFormattingCall(CallExpr *call)
+{
+    static const vector<StringRef> formattingMethods = { "QString::arg", "QString::number", "QString::asprintf",
+                                                         "QString::sprintf" };
+    FunctionDecl *func = call->getDirectCallee();
+    if (!func || !clazy::any_of(formattingMethods, [func](StringRef name) { return clazy::qualifiedMethodNameIs(func, name); }))
+        return false;
+
+    // Only warn once for str.arg(a).arg(b)
+    auto memberCall = dyn_cast<CXXMemberCallExpr>(call);
+    Expr *object = memberCall ? memberCall->getImplicitObjectArgument() : nullptr;
+    auto objectCall = object ? dyn_cast<CXXMemberCallExpr>(object->IgnoreImplicit()) : nullptr;
+    return !objectCall || !clazy::qualifiedMethodNameIs(objectCall->getDirectCallee(), "QString::arg");
+}
+
+HotPathAllocations::HotPathAllocations(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+}
+
+void HotPathAllocations::VisitDecl(clang::Decl *decl)
+{
+    auto method = dyn_cast<CXXMethodDecl>(decl);
+    if (!method || !method->isThisDeclarationADefinition() || !method->hasBody() || method->size_overridden_methods() == 0)
+        return;
+
+    bool returnsText = false;
+    if (!clazy::isHotMethod(method, &returnsText))
+        return;
+
+    Stmt *body = method->getBody();
+    const StmtIndex *index = m_context->functionStmtIndex(body);
+
+    // Static locals are only constructed once, they're what this check recommends
+    std::unordered_set<const Stmt *> constructedOnce;
+    for (DeclStmt *declStmt : clazy::getStatements<DeclStmt>(index, body)) {
+        for (Decl *d : declStmt->decls()) {
+            auto varDecl = dyn_cast<VarDecl>(d);
+            if (!varDecl || !varDecl->isStaticLocal() || !varDecl->getInit())
+                continue;
+
+            constructedOnce.insert(varDecl->getInit());
+            for (Stmt *s : clazy::getStatements<Stmt>(varDecl->getInit()))
+                constructedOnce.insert(s);
+        }
+    }
+
+    const string where = " inside " + clazy::name(method).str() + "(), which is called very often";
+
+    for (CXXConstructExpr *ctorExpr : clazy::getStatements<CXXConstructExpr>(index, body)) {
+        CXXConstructorDecl *ctor = ctorExpr->getConstructor();
+        if (!ctor || ctor->isCopyOrMoveConstructor() || constructedOnce.count(ctorExpr))
+            continue;
+
+        const string className = clazy::name(ctor->getParent()).str();
+        if (isLoadingConstruction(ctor))
+            emitWarning(clazy::getLocStart(ctorExpr), className + " loaded from a file" + where + ", " + loadingFixSuggestion(className));
+        else if (isAllocatingConstruction(ctor))
+            emitWarning(clazy::getLocStart(ctorExpr), className + " constructed" + where + ", consider caching it in a member");
+    }
+
+    for (CallExpr *call : clazy::getStatements<CallExpr>(index, body)) {
+        FunctionDecl *func = call->getDirectCallee();
+        if (!func || constructedOnce.count(call))
+            continue;
+
+        if (isLoadingCall(func))
+            emitWarning(clazy::getLocStart(call), clazy::qualifiedMethodName(func) + "()" + where + ", do the I/O once and cache the result in a member");
+        else if (!returnsText && isFormattingCall(call))
+            emitWarning(clazy::getLocStart(call), clazy::qualifiedMethodName(func) + "()" + where + ", consider caching the formatted string in a member");
+    }
+}
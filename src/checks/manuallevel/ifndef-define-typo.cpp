@@ -23,8 +23,8 @@
 #include "Utils.h"
 #include "HierarchyUtils.h"
 #include "QtUtils.h"
+#include "StringUtils.h"
 #include "TypeUtils.h"
-#include "levenshteindistance.h"
 
 #include <clang/AST/AST.h>
 
@@ -37,7 +37,7 @@ using namespace std;
 IfndefDefineTypo::IfndefDefineTypo(const std::string &name, ClazyContext *context)
     : CheckBase(name, context)
 {
-    enablePreProcessorCallbacks();
+    enablePreProcessorCallbacks(PreprocessorEvent_All & ~PreprocessorEvent_MacroExpands);
 }
 
 void IfndefDefineTypo::VisitMacroDefined(const Token &macroNameTok)
@@ -89,7 +89,7 @@ void IfndefDefineTypo::VisitEndif(SourceLocation, SourceLocation)
     m_lastIfndef.clear();
 }
 
-void IfndefDefineTypo::maybeWarn(const string &define, SourceLocation loc)
+void IfndefDefineTypo::maybeWarn(llvm::StringRef define, SourceLocation loc)
 {
     if (m_lastIfndef == "Q_CONSTRUCTOR_FUNCTION") // Transform into a list if more false-positives need to be added
         return;
@@ -102,8 +102,7 @@ void IfndefDefineTypo::maybeWarn(const string &define, SourceLocation loc)
     if (define.length() < 4)
         return;
 
-    const int levDistance = levenshtein_distance(define, m_lastIfndef);
-    if (levDistance < 3) {
-        emitWarning(loc, string("Possible typo in define. ") + m_lastIfndef + " vs " + define);
+    if (clazy::editDistance(define, m_lastIfndef, 2) <= 2) {
+        emitWarning(loc, string("Possible typo in define. ") + m_lastIfndef + " vs " + define.str());
     }
 }
@@ -41,7 +41,7 @@ public:
     void VisitElse(clang::SourceLocation loc, clang::SourceLocation ifLoc) override;
     void VisitEndif(clang::SourceLocation loc, clang::SourceLocation ifLoc) override;
 
-    void maybeWarn(const std::string &define, clang::SourceLocation loc);
+    void maybeWarn(llvm::StringRef define, clang::SourceLocation loc);
 
 private:
     std::string m_lastIfndef;
@@ -0,0 +1,200 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#include "ineffective-move.h"
+#include "ClazyContext.h"
+#include "FixItUtils.h"
+#include "StringUtils.h"
+#include "TypeUtils.h"
+#include "SourceCompatibilityHelpers.h"
+
+#include <clang/AST/ASTContext.h>
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/SourceManager.h>
+#include <clang/Lex/Lexer.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+#include <cctype>
+
+using namespace clang;
+using namespace std;
+
+IneffectiveMove::IneffectiveMove(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+}
+
+// Returns the argument of a std::move(x) call
+static Expr *movedExpr(CallExpr *callExpr)
+{
+    FunctionDecl *func = callExpr ? callExpr->getDirectCallee() : nullptr;
+    if (!func || isa<CXXMethodDecl>(func) || callExpr->getNumArgs() != 1 || !func->isInStdNamespace()
+        || clazy::name(func) != "move")
+        return nullptr;
+
+    return callExpr->getArg(0);
+}
+
+bool IneffectiveMove::isNonTriviallyCopyable(QualType qualType) const
+{
+    clazy::QualTypeClassification classification;
+    return clazy::classifyQualType(m_context, qualType, nullptr, classification) && classification.isNonTriviallyCopyable;
+}
+
+// Makes std::move(x) just x
+vector<FixItHint> IneffectiveMove::removeMoveFixits(CallExpr *moveCall) const
+{
+    const SourceRange range = moveCall->getSourceRange();
+    Expr *arg = moveCall->getArg(0);
+    if (range.getBegin().isMacroID() || range.getEnd().isMacroID())
+        return {};
+
+    const string argText = Lexer::getSourceText(CharSourceRange::getTokenRange(arg->getSourceRange()), sm(), lo()).str();
+    if (argText.empty())
+        return {};
+
+    Expr *strippedArg = arg->IgnoreParenImpCasts();
+    const bool needsParens = !isa<DeclRefExpr>(strippedArg) && !isa<MemberExpr>(strippedArg);
+    return { clazy::createReplacement(range, needsParens ? "(" + argText + ")" : argText) };
+}
+
+// Returns the location of the const in "const QString foo()", or an invalid location if it's not written there
+SourceLocation IneffectiveMove::returnTypeConstLoc(FunctionDecl *func) const
+{
+    // The return type's range doesn't include its qualifiers, so look between the start of the declaration and the type
+    const SourceLocation start = clazy::getLocStart(func);
+    const SourceLocation typeStart = func->getReturnTypeSourceRange().getBegin();
+    if (start.isInvalid() || typeStart.isInvalid() || start.isMacroID() || typeStart.isMacroID())
+        return {};
+
+    const StringRef text = Lexer::getSourceText(CharSourceRange::getCharRange(start, typeStart), sm(), lo());
+    const size_t pos = text.rfind("const");
+    if (pos == StringRef::npos || !text.substr(pos + 5).trim().empty())
+        return {};
+
+    if (pos > 0 && (isalnum(text[pos - 1]) || text[pos - 1] == '_'))
+        return {};
+
+    return start.getLocWithOffset(pos);
+}
+
+void IneffectiveMove::VisitDecl(clang::Decl *decl)
+{
+    auto func = dyn_cast<FunctionDecl>(decl);
+    if (!func || !func->isFirstDecl() || func->isImplicit() || func->isTemplateInstantiation()
+        || isa<CXXConversionDecl>(func) || clazy::getLocStart(func).isMacroID())
+        return;
+
+    const QualType returnType = func->getReturnType();
+    if (!returnType.isConstQualified() || returnType->isReferenceType() || returnType->isDependentType()
+        || !isNonTriviallyCopyable(returnType))
+        return;
+
+    // Overrides have their signature imposed
+    auto method = dyn_cast<CXXMethodDecl>(func);
+    if (method && method->size_overridden_methods() > 0)
+        return;
+
+    // All declarations need the same change
+    vector<FixItHint> fixits;
+    for (FunctionDecl *redecl : func->redecls()) {
+        const SourceLocation constLoc = returnTypeConstLoc(redecl);
+        if (constLoc.isInvalid()) {
+            fixits.clear();
+            break;
+        }
+
+        fixits.push_back(FixItHint::CreateRemoval(CharSourceRange::getCharRange(constLoc, redecl->getReturnTypeSourceRange().getBegin())));
+    }
+
+    const SourceLocation constLoc = returnTypeConstLoc(func);
+    emitWarning(constLoc.isValid() ? constLoc : clazy::getLocStart(func),
+                "Returning const " + clazy::simpleTypeName(returnType.getUnqualifiedType(), lo())
+                + " by value prevents the caller from moving it, remove the const", fixits);
+}
+
+// std::move(constValue) binds to the copy constructor
+void IneffectiveMove::checkMoveOfConst(CallExpr *callExpr)
+{
+    Expr *arg = movedExpr(callExpr);
+    if (!arg || arg->isTypeDependent() || !arg->getType().isConstQualified() || !isNonTriviallyCopyable(arg->getType()))
+        return;
+
+    // Templates move whatever they're given
+    FunctionDecl *func = m_context->lastFunctionDecl;
+    if (func && func->isTemplateInstantiation())
+        return;
+
+    auto declRef = dyn_cast<DeclRefExpr>(arg->IgnoreParenImpCasts());
+    const string what = declRef ? "const '" + declRef->getDecl()->getNameAsString() + "'"
+                                : "a const " + clazy::simpleTypeName(arg->getType().getUnqualifiedType(), lo());
+    emitWarning(clazy::getLocStart(callExpr), "std::move() on " + what + " has no effect, it's copied instead of moved",
+                removeMoveFixits(callExpr));
+}
+
+// return std::move(local) prevents copy elision, and return std::move(param) is redundant
+void IneffectiveMove::checkReturn(ReturnStmt *returnStmt)
+{
+    Expr *value = returnStmt->getRetValue();
+    auto constructExpr = value ? dyn_cast<CXXConstructExpr>(value->IgnoreImplicit()) : nullptr;
+    if (!constructExpr || constructExpr->getNumArgs() != 1)
+        return;
+
+    auto moveCall = dyn_cast<CallExpr>(constructExpr->getArg(0)->IgnoreImplicit());
+    Expr *arg = movedExpr(moveCall);
+    auto declRef = arg ? dyn_cast<DeclRefExpr>(arg->IgnoreParenImpCasts()) : nullptr;
+    auto varDecl = declRef ? dyn_cast<VarDecl>(declRef->getDecl()) : nullptr;
+    if (!varDecl || declRef->refersToEnclosingVariableOrCapture() || !varDecl->hasLocalStorage() || varDecl->isExceptionVariable())
+        return;
+
+    // Const ones are warned about by checkMoveOfConst()
+    const QualType varType = varDecl->getType();
+    if (varType->isReferenceType() || varType.isConstQualified() || varType.isVolatileQualified())
+        return;
+
+    // Only returning the same type is guaranteed to move implicitly, unique_ptr<Base> from unique_ptr<Derived> might need the std::move()
+    if (!m_astContext->hasSameUnqualifiedType(constructExpr->getType(), varType))
+        return;
+
+    const string name = varDecl->getNameAsString();
+    if (isa<ParmVarDecl>(varDecl)) {
+        emitWarning(clazy::getLocStart(moveCall), "std::move() in the return statement is redundant, '" + name + "' is moved implicitly",
+                    removeMoveFixits(moveCall));
+    } else {
+        emitWarning(clazy::getLocStart(moveCall), "std::move() in the return statement prevents copy elision, return '" + name + "' instead",
+                    removeMoveFixits(moveCall));
+    }
+}
+
+void IneffectiveMove::VisitStmt(clang::Stmt *stmt)
+{
+    if (auto returnStmt = dyn_cast<ReturnStmt>(stmt)) {
+        checkReturn(returnStmt);
+    } else if (auto callExpr = dyn_cast<CallExpr>(stmt)) {
+        checkMoveOfConst(callExpr);
+    }
+}
@@ -0,0 +1,63 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#ifndef CLAZY_INEFFECTIVE_MOVE_H
+#define CLAZY_INEFFECTIVE_MOVE_H
+
+#include "checkbase.h"
+
+#include <clang/AST/Type.h>
+#include <clang/Basic/SourceLocation.h>
+
+#include <string>
+#include <vector>
+
+class ClazyContext;
+namespace clang {
+class CallExpr;
+class Decl;
+class FixItHint;
+class FunctionDecl;
+class ReturnStmt;
+class Stmt;
+}  // namespace clang
+
+/**
+ * Finds std::move() calls on const objects or in return statements, and const return types, which prevent moves.
+ *
+ * See README-ineffective-move.md for more info.
+ */
+class IneffectiveMove
+    : public CheckBase
+{
+public:
+    explicit IneffectiveMove(const std::string &name, ClazyContext *context);
+    void VisitDecl(clang::Decl *decl) override;
+    void VisitStmt(clang::Stmt *stmt) override;
+private:
+    void checkMoveOfConst(clang::CallExpr *callExpr);
+    void checkReturn(clang::ReturnStmt *returnStmt);
+    bool isNonTriviallyCopyable(clang::QualType qualType) const;
+    clang::SourceLocation returnTypeConstLoc(clang::FunctionDecl *func) const;
+    std::vector<clang::FixItHint> removeMoveFixits(clang::CallExpr *moveCall) const;
+};
+
+#endif
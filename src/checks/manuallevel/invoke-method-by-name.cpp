@@ -0,0 +1,166 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "invoke-method-by-name.h"
+#include "ClazyContext.h"
+#include "ContextUtils.h"
+#include "FixItUtils.h"
+#include "PreProcessorVisitor.h"
+#include "StringUtils.h"
+#include "TypeUtils.h"
+#include "Utils.h"
+#include "SourceCompatibilityHelpers.h"
+#include "clazy_stl.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/Type.h>
+#include <clang/Basic/LLVM.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+using namespace clang;
+using namespace std;
+
+InvokeMethodByName::InvokeMethodByName(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes)
+{
+    context->enablePreprocessorVisitor();
+}
+
+void InvokeMethodByName::VisitStmt(clang::Stmt *stmt)
+{
+    auto call = dyn_cast<CallExpr>(stmt);
+    FunctionDecl *func = call ? call->getDirectCallee() : nullptr;
+    if (!func || clazy::name(func) != "invokeMethod" || call->getNumArgs() < 2)
+        return;
+
+    // The functor and pointer-to-member-function overloads were added in Qt 5.10
+    PreProcessorVisitor *preProcessorVisitor = m_context->preprocessorVisitor;
+    if (!preProcessorVisitor || preProcessorVisitor->qtVersion() < 51000)
+        return;
+
+    auto method = dyn_cast<CXXMethodDecl>(func);
+    if (!method || clazy::name(method->getParent()) != "QMetaObject" || func->getNumParams() < 2)
+        return;
+
+    const QualType memberType = func->getParamDecl(1)->getType();
+    if (!memberType->isPointerType() || !memberType->getPointeeType()->isCharType())
+        return;
+
+    // A variable holding the name can't be converted
+    auto literal = dyn_cast<StringLiteral>(call->getArg(1)->IgnoreImpCasts());
+    if (!literal)
+        return;
+
+    const string methodName = literal->getString().str();
+    emitWarning(call, "QMetaObject::invokeMethod() looks up '" + methodName + "' by name on every call, use a pointer to member function instead",
+                fixits(call, methodName));
+}
+
+// Overrides are found once per class, keep the most derived one
+static vector<CXXMethodDecl*> mostDerivedMethods(const vector<CXXMethodDecl*> &methods)
+{
+    vector<CXXMethodDecl*> result;
+    for (CXXMethodDecl *method : methods) {
+        const bool isOverridden = clazy::any_of(methods, [method](CXXMethodDecl *other) {
+            for (const CXXMethodDecl *overridden : other->overridden_methods()) {
+                if (overridden == method)
+                    return true;
+            }
+            return false;
+        });
+
+        if (!isOverridden)
+            result.push_back(method);
+    }
+
+    return result;
+}
+
+vector<FixItHint> InvokeMethodByName::fixits(CallExpr *call, const string &methodName)
+{
+    if (!fixitsEnabled())
+        return {};
+
+    // The pointer-to-member-function overload only takes a connection type, arguments need a lambda
+    FunctionDecl *func = call->getDirectCallee();
+    for (unsigned int i = 2; i < call->getNumArgs(); ++i) {
+        if (isa<CXXDefaultArgExpr>(call->getArg(i)))
+            continue;
+
+        const EnumType *enumType = func->getParamDecl(i)->getType()->getAs<EnumType>();
+        if (i != 2 || !enumType || clazy::name(enumType->getDecl()) != "ConnectionType") {
+            queueManualFixitWarning(clazy::getLocStart(call), "Fixit not implemented for invokeMethod() with arguments or a return value, use a lambda");
+            return {};
+        }
+    }
+
+    const Expr *object = call->getArg(0)->IgnoreImpCasts();
+    const Type *objectType = clazy::pointeeQualType(object->getType()).getTypePtrOrNull();
+    const CXXRecordDecl *record = objectType ? objectType->getAsCXXRecordDecl() : nullptr;
+    if (!record) {
+        queueManualFixitWarning(clazy::getLocStart(call), "Failed to get class name for the receiver");
+        return {};
+    }
+
+    vector<CXXMethodDecl*> methods = mostDerivedMethods(Utils::methodsFromString(record, methodName));
+
+    if (methods.size() != 1) {
+        queueManualFixitWarning(clazy::getLocStart(call), methods.empty() ? "No such method " + methodName + " in class " + record->getNameAsString()
+                                                                           : "Too many overloads for method " + methodName);
+        return {};
+    }
+
+    CXXMethodDecl *methodDecl = methods[0];
+    if (methodDecl->isStatic() || methodDecl->getNumParams() > 0)
+        return {};
+
+    DeclContext *context = m_context->lastDecl ? m_context->lastDecl->getDeclContext() : nullptr;
+    if (!context)
+        return {};
+
+    bool isSpecialProtectedCase = false;
+    if (!clazy::canTakeAddressOf(methodDecl, context, /*by-ref*/ isSpecialProtectedCase)) {
+        queueManualFixitWarning(clazy::getLocStart(call), "Can't fix " + clazy::accessString(methodDecl->getAccess()) + ' ' + methodDecl->getQualifiedNameAsString());
+        return {};
+    }
+
+    const SourceLocation locStart = clazy::getLocStart(call);
+    string qualifiedName;
+    auto contextRecord = clazy::firstContextOfType<CXXRecordDecl>(context);
+    if (isSpecialProtectedCase && contextRecord) {
+        qualifiedName = contextRecord->getNameAsString() + "::" + methodDecl->getNameAsString();
+    } else {
+        const bool isInInclude = sm().getMainFileID() != sm().getFileID(locStart);
+        qualifiedName = clazy::getMostNeededQualifiedName(sm(), methodDecl, context, locStart, !isInInclude);
+    }
+
+    const SourceRange range = call->getArg(1)->getSourceRange();
+    if (range.getBegin().isMacroID() || range.getEnd().isMacroID())
+        return {};
+
+    return { clazy::createReplacement(range, '&' + qualifiedName) };
+}
@@ -0,0 +1,55 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_INVOKE_METHOD_BY_NAME_H
+#define CLAZY_INVOKE_METHOD_BY_NAME_H
+
+#include "checkbase.h"
+
+#include <string>
+#include <vector>
+
+class ClazyContext;
+
+namespace clang {
+class Stmt;
+class CallExpr;
+class FixItHint;
+}
+
+/**
+ * Finds QMetaObject::invokeMethod() calls passing the method name as a string literal,
+ * which is looked up on every call, and suggests the pointer-to-member-function overload.
+ *
+ * See README-invoke-method-by-name.md for more info.
+ */
+class InvokeMethodByName
+    : public CheckBase
+{
+public:
+    explicit InvokeMethodByName(const std::string &name, ClazyContext *context);
+    void VisitStmt(clang::Stmt *stmt) override;
+private:
+    std::vector<clang::FixItHint> fixits(clang::CallExpr *call, const std::string &methodName);
+};
+
+#endif
@@ -20,6 +20,7 @@
 */
 
 #include "isempty-vs-count.h"
+#include "FixItUtils.h"
 #include "StringUtils.h"
 #include "QtUtils.h"
 #include "SourceCompatibilityHelpers.h"
@@ -31,6 +32,7 @@
 #include <clang/AST/Stmt.h>
 #include <clang/AST/StmtIterator.h>
 #include <clang/Basic/LLVM.h>
+#include <clang/Lex/Lexer.h>
 #include <llvm/ADT/StringRef.h>
 #include <llvm/Support/Casting.h>
 
@@ -41,24 +43,159 @@ using namespace std;
 
 
 IsEmptyVSCount::IsEmptyVSCount(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
 {
 }
 
-void IsEmptyVSCount::VisitStmt(clang::Stmt *stmt)
+static bool isStdContainer(CXXRecordDecl *record)
+{
+    static const clazy::NameSet containers = { "vector", "list", "deque", "basic_string", "map", "multimap", "set", "multiset",
+                                               "unordered_map", "unordered_multimap", "unordered_set", "unordered_multiset",
+                                               "array", "queue", "stack", "priority_queue" };
+    return record && record->isInStdNamespace() && clazy::classIsOneOf(record, containers);
+}
+
+// Returns the call if expr is a size(), count() or length() call without arguments on a Qt or std container
+static CXXMemberCallExpr *sizeCall(Expr *expr)
+{
+    auto memberCall = expr ? dyn_cast<CXXMemberCallExpr>(expr->IgnoreParenImpCasts()) : nullptr;
+    CXXMethodDecl *method = memberCall ? memberCall->getMethodDecl() : nullptr;
+    if (!method || memberCall->getNumArgs() != 0)
+        return nullptr;
+
+    CXXRecordDecl *record = method->getParent();
+    if (isStdContainer(record)) {
+        static const clazy::NameSet stdSizeMethods = { "size", "length" };
+        return clazy::functionIsOneOf(method, stdSizeMethods) ? memberCall : nullptr;
+    }
+
+    // The iterables don't have isEmpty()
+    static const clazy::NameSet sizeMethods = { "size", "count", "length" };
+    static const clazy::NameSet iterables = { "QSequentialIterable", "QAssociativeIterable" };
+    if (!clazy::functionIsOneOf(method, sizeMethods) || !clazy::classIsOneOf(record, clazy::qtContainers())
+        || clazy::classIsOneOf(record, iterables))
+        return nullptr;
+
+    return memberCall;
+}
+
+static const char *emptyMethodName(CXXMemberCallExpr *call)
+{
+    return isStdContainer(call->getMethodDecl()->getParent()) ? "empty" : "isEmpty";
+}
+
+// Replaces replaced with "list.isEmpty()", or "!list.isEmpty()" if negate, where list is the object call is invoked on
+vector<FixItHint> IsEmptyVSCount::fixits(Expr *replaced, CXXMemberCallExpr *call, bool negate) const
+{
+    auto memberExpr = dyn_cast<MemberExpr>(call->getCallee()->IgnoreParens());
+    Expr *object = call->getImplicitObjectArgument();
+    const SourceRange range = replaced->getSourceRange();
+    if (!memberExpr || !object || memberExpr->isImplicitAccess() || range.getBegin().isMacroID() || range.getEnd().isMacroID())
+        return {};
+
+    const StringRef objectText = Lexer::getSourceText(CharSourceRange::getTokenRange(object->getSourceRange()), sm(), lo());
+    if (objectText.empty())
+        return {};
+
+    string replacement = negate ? "!" : "";
+    replacement += objectText.str() + (memberExpr->isArrow() ? "->" : ".") + emptyMethodName(call) + "()";
+    return { clazy::createReplacement(range, replacement) };
+}
+
+void IsEmptyVSCount::warn(Expr *expr, CXXMemberCallExpr *call, bool negate)
+{
+    string message = string("use ") + emptyMethodName(call) + "() instead";
+    CXXRecordDecl *record = call->getMethodDecl()->getParent();
+    if (isStdContainer(record) && clazy::name(record) == "list")
+        message += ", std::list::size() isn't O(1) with the old libstdc++ ABI";
+
+    emitWarning(clazy::getLocStart(expr), message, fixits(expr, call, negate));
+}
+
+// !list.count()
+void IsEmptyVSCount::checkNot(UnaryOperator *unaryOp)
 {
-    auto cast = dyn_cast<ImplicitCastExpr>(stmt);
+    if (unaryOp->getOpcode() != UO_LNot)
+        return;
+
+    auto cast = dyn_cast<ImplicitCastExpr>(unaryOp->getSubExpr()->IgnoreParens());
     if (!cast || cast->getCastKind() != clang::CK_IntegralToBoolean)
         return;
 
-    auto memberCall = dyn_cast<CXXMemberCallExpr>(*(cast->child_begin()));
-    CXXMethodDecl *method = memberCall ? memberCall->getMethodDecl() : nullptr;
+    if (CXXMemberCallExpr *call = sizeCall(cast->getSubExpr())) {
+        m_handledCast = cast;
+        warn(unaryOp, call, /*negate=*/ false);
+    }
+}
+
+// list.size() == 0, list.count() > 0, 0 != list.length()
+void IsEmptyVSCount::checkComparison(BinaryOperator *binaryOp)
+{
+    if (!binaryOp->isComparisonOp())
+        return;
+
+    BinaryOperatorKind op = binaryOp->getOpcode();
+    CXXMemberCallExpr *call = sizeCall(binaryOp->getLHS());
+    Expr *other = binaryOp->getRHS();
+    if (!call) {
+        // Mirror 0 < list.size() into list.size() > 0
+        call = sizeCall(binaryOp->getRHS());
+        other = binaryOp->getLHS();
+        if (op == BO_LT || op == BO_GT)
+            op = op == BO_LT ? BO_GT : BO_LT;
+        else if (op == BO_LE || op == BO_GE)
+            op = op == BO_LE ? BO_GE : BO_LE;
+    }
+
+    auto literal = dyn_cast<IntegerLiteral>(other->IgnoreParenImpCasts());
+    if (!call || !literal)
+        return;
+
+    const bool isZero = literal->getValue() == 0;
+    const bool isOne = literal->getValue() == 1;
+    const bool testsEmpty = (isZero && (op == BO_EQ || op == BO_LE)) || (isOne && op == BO_LT);
+    const bool testsNotEmpty = (isZero && (op == BO_NE || op == BO_GT)) || (isOne && op == BO_GE);
+    if (testsEmpty || testsNotEmpty)
+        warn(binaryOp, call, /*negate=*/ testsNotEmpty);
+}
 
-    if (!clazy::functionIsOneOf(method, {"size", "count", "length"}))
+// if (list.count()) or bool b = list.size();
+void IsEmptyVSCount::checkBoolConversion(ImplicitCastExpr *cast)
+{
+    if (cast->getCastKind() != clang::CK_IntegralToBoolean || cast == m_handledCast)
         return;
 
-    if (!clazy::classIsOneOf(method->getParent(), clazy::qtContainers()))
+    if (CXXMemberCallExpr *call = sizeCall(cast->getSubExpr()))
+        warn(call, call, /*negate=*/ true);
+}
+
+// hash.keys().isEmpty() or set.toList().isEmpty() build a temporary container just to check if it's empty
+void IsEmptyVSCount::checkTemporaryContainer(CXXMemberCallExpr *memberCall)
+{
+    CXXMethodDecl *method = memberCall->getMethodDecl();
+    if (!method || clazy::name(method) != "isEmpty" || memberCall->getNumArgs() != 0)
         return;
 
-    emitWarning(clazy::getLocStart(stmt), "use isEmpty() instead");
+    auto innerCall = dyn_cast_or_null<CXXMemberCallExpr>(memberCall->getImplicitObjectArgument() ? memberCall->getImplicitObjectArgument()->IgnoreImplicit() : nullptr);
+    CXXMethodDecl *innerMethod = innerCall ? innerCall->getMethodDecl() : nullptr;
+    static const clazy::NameSet conversions = { "toList", "toVector", "keys", "uniqueKeys", "values" };
+    if (!innerMethod || innerCall->getNumArgs() != 0 || !clazy::functionIsOneOf(innerMethod, conversions)
+        || !clazy::classIsOneOf(innerMethod->getParent(), clazy::qtContainers()))
+        return;
+
+    emitWarning(clazy::getLocStart(memberCall), "call isEmpty() on the container instead of on the temporary returned by "
+                + clazy::name(innerMethod).str() + "()", fixits(memberCall, innerCall, /*negate=*/ false));
+}
+
+void IsEmptyVSCount::VisitStmt(clang::Stmt *stmt)
+{
+    if (auto unaryOp = dyn_cast<UnaryOperator>(stmt)) {
+        checkNot(unaryOp);
+    } else if (auto binaryOp = dyn_cast<BinaryOperator>(stmt)) {
+        checkComparison(binaryOp);
+    } else if (auto cast = dyn_cast<ImplicitCastExpr>(stmt)) {
+        checkBoolConversion(cast);
+    } else if (auto memberCall = dyn_cast<CXXMemberCallExpr>(stmt)) {
+        checkTemporaryContainer(memberCall);
+    }
 }
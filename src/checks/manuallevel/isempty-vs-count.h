@@ -25,15 +25,22 @@
 #include "checkbase.h"
 
 #include <string>
+#include <vector>
 
 class ClazyContext;
 
 namespace clang {
+class BinaryOperator;
+class CXXMemberCallExpr;
+class Expr;
+class FixItHint;
+class ImplicitCastExpr;
 class Stmt;
+class UnaryOperator;
 }
 
 /**
- * Finds places where you're using Container::count() instead of Container::isEmpty()
+ * Finds places where you're using Container::count() instead of Container::isEmpty(), or std::vector::size() instead of empty()
  *
  * See README-isempty-vs-count
  */
@@ -43,6 +50,14 @@ class IsEmptyVSCount
 public:
     explicit IsEmptyVSCount(const std::string &name, ClazyContext *context);
     void VisitStmt(clang::Stmt *stmt) override;
+private:
+    void checkNot(clang::UnaryOperator *unaryOp);
+    void checkComparison(clang::BinaryOperator *binaryOp);
+    void checkBoolConversion(clang::ImplicitCastExpr *cast);
+    void checkTemporaryContainer(clang::CXXMemberCallExpr *memberCall);
+    void warn(clang::Expr *expr, clang::CXXMemberCallExpr *sizeCall, bool negate);
+    std::vector<clang::FixItHint> fixits(clang::Expr *replaced, clang::CXXMemberCallExpr *call, bool negate) const;
+    const clang::Stmt *m_handledCast = nullptr; // The cast below a !count(), which was already warned about
 };
 
 #endif
@@ -0,0 +1,122 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "keyed-lookup-in-loop.h"
+#include "ClazyContext.h"
+#include "LoopUtils.h"
+#include "StringUtils.h"
+#include "TemplateUtils.h"
+#include "SourceCompatibilityHelpers.h"
+#include "clazy_stl.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/Type.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/OperatorKinds.h>
+#include <clang/Basic/SourceManager.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+#include <vector>
+
+using namespace clang;
+using namespace std;
+
+KeyedLookupInLoop::KeyedLookupInLoop(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+}
+
+static bool isNamed(QualType type, StringRef className)
+{
+    const CXXRecordDecl *record = type.isNull() ? nullptr : type->getAsCXXRecordDecl();
+    return record && clazy::name(record) == className;
+}
+
+// Returns the name to show for the QSettings, QJsonObject, QVariantMap or QVariantHash a lookup is done on,
+// or an empty string for other classes
+static string lookupClassName(CXXRecordDecl *record)
+{
+    const StringRef className = clazy::name(record);
+    if (className == "QSettings" || className == "QJsonObject")
+        return className.str();
+
+    if (className != "QMap" && className != "QHash")
+        return {};
+
+    const vector<QualType> args = clazy::getTemplateArgumentsTypes(record);
+    if (args.size() != 2 || !isNamed(args[0], "QString") || !isNamed(args[1], "QVariant"))
+        return {};
+
+    return className == "QMap" ? "QVariantMap" : "QVariantHash";
+}
+
+void KeyedLookupInLoop::VisitStmt(clang::Stmt *stmt)
+{
+    if (auto ctorExpr = dyn_cast<CXXConstructExpr>(stmt)) {
+        CXXConstructorDecl *ctor = ctorExpr->getConstructor();
+        if (ctor && !ctor->isCopyOrMoveConstructor() && clazy::name(ctor->getParent()) == "QSettings"
+            && clazy::loopRunningOnEachIteration(m_context, stmt))
+            emitWarning(clazy::getLocStart(stmt), "QSettings constructed on every iteration; construct it once, before the loop");
+        return;
+    }
+
+    auto call = dyn_cast<CallExpr>(stmt);
+    auto method = call ? dyn_cast_or_null<CXXMethodDecl>(call->getDirectCallee()) : nullptr;
+    if (!method || !method->isConst())
+        return;
+
+    // operator[] is only a lookup when const, otherwise it can insert or assign
+    Expr *object = nullptr;
+    Expr *key = nullptr;
+    if (auto op = dyn_cast<CXXOperatorCallExpr>(call)) {
+        if (op->getOperator() != OO_Subscript || op->getNumArgs() != 2)
+            return;
+        object = op->getArg(0);
+        key = op->getArg(1);
+    } else if (auto memberCall = dyn_cast<CXXMemberCallExpr>(call)) {
+        if (clazy::name(method) != "value" || memberCall->getNumArgs() == 0)
+            return;
+        object = memberCall->getImplicitObjectArgument();
+        key = memberCall->getArg(0);
+    } else {
+        return;
+    }
+
+    const string className = lookupClassName(method->getParent());
+    if (className.empty())
+        return;
+
+    auto declRef = object ? dyn_cast<DeclRefExpr>(object->IgnoreParenImpCasts()) : nullptr;
+    auto varDecl = declRef ? dyn_cast<VarDecl>(declRef->getDecl()) : nullptr;
+    Stmt *loop = varDecl ? clazy::loopRunningOnEachIteration(m_context, stmt) : nullptr;
+    if (!loop || !clazy::isUnmodifiedInLoop(m_context, varDecl, loop) || !clazy::isLoopInvariant(m_context, key, loop))
+        return;
+
+    const string lookup = className + "::" + clazy::name(method).str() + "()";
+    const string alternative = className == "QSettings" ? "read the settings into a struct once" : "deserialize it into a struct once";
+    emitWarning(clazy::getLocStart(stmt), lookup + " returns the same value on every iteration; do the lookup before the loop, or " + alternative);
+}
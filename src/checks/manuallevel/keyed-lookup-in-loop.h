@@ -0,0 +1,50 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_KEYED_LOOKUP_IN_LOOP_H
+#define CLAZY_KEYED_LOOKUP_IN_LOOP_H
+
+#include "checkbase.h"
+
+#include <string>
+
+class ClazyContext;
+
+namespace clang {
+class Stmt;
+}
+
+/**
+ * Finds QSettings being constructed inside loops, and QSettings, QJsonObject and QVariantMap lookups
+ * inside loops which get the same value on every iteration.
+ *
+ * See README-keyed-lookup-in-loop.md for more info.
+ */
+class KeyedLookupInLoop
+    : public CheckBase
+{
+public:
+    explicit KeyedLookupInLoop(const std::string &name, ClazyContext *context);
+    void VisitStmt(clang::Stmt *stmt) override;
+};
+
+#endif
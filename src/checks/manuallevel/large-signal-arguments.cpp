@@ -0,0 +1,142 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "large-signal-arguments.h"
+#include "AccessSpecifierManager.h"
+#include "ClazyContext.h"
+#include "HierarchyUtils.h"
+#include "QtUtils.h"
+#include "StringUtils.h"
+#include "TypeUtils.h"
+#include "Utils.h"
+#include "SourceCompatibilityHelpers.h"
+#include "clazy_stl.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/Type.h>
+#include <clang/Basic/LLVM.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+#include <vector>
+
+using namespace clang;
+using namespace std;
+
+LargeSignalArguments::LargeSignalArguments(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes)
+{
+    context->enableAccessSpecifierManager();
+}
+
+// Big and non-trivially copyable, such as std::vector or a struct with several members.
+// Qt's value classes are either small or implicitly shared, so copying them is cheap.
+bool LargeSignalArguments::isExpensiveToCopy(QualType type, int &size) const
+{
+    const QualType unrefType = clazy::unrefQualType(type);
+    const Type *t = unrefType.getTypePtrOrNull();
+    CXXRecordDecl *record = t && !t->isDependentType() ? t->getAsCXXRecordDecl() : nullptr;
+    if (!record)
+        return false;
+
+    const string qualifiedName = record->getQualifiedNameAsString();
+    if (clazy::startsWith(qualifiedName, "Q") && qualifiedName != "QVarLengthArray")
+        return false;
+
+    clazy::QualTypeClassification classification;
+    if (!clazy::classifyQualType(m_context, unrefType, nullptr, classification))
+        return false;
+
+    size = classification.size_of_T;
+    return classification.isBig && classification.isNonTriviallyCopyable;
+}
+
+void LargeSignalArguments::VisitDecl(clang::Decl *decl)
+{
+    AccessSpecifierManager *accessSpecifierManager = m_context->accessSpecifierManager;
+    auto method = dyn_cast<CXXMethodDecl>(decl);
+    if (!accessSpecifierManager || !method)
+        return;
+
+    // Skip the definitions generated by moc
+    if (method->isThisDeclarationADefinition() && !method->hasInlineBody())
+        return;
+
+    if (accessSpecifierManager->qtAccessSpecifierType(method) != QtAccessSpecifier_Signal)
+        return;
+
+    for (ParmVarDecl *param : Utils::functionParameters(method)) {
+        int size = 0;
+        if (param->getType()->isReferenceType() || !isExpensiveToCopy(param->getType(), size))
+            continue;
+
+        emitWarning(param, "signal argument of type " + clazy::simpleTypeName(param->getType(), lo()) + " (" + to_string(size)
+                    + " bytes) is copied on every emit, pass it by const-ref or use an implicitly shared or pointer-like type");
+    }
+}
+
+// Returns true if the argument is Qt::QueuedConnection or Qt::BlockingQueuedConnection, possibly or'ed with other flags
+static bool isQueuedConnection(Expr *typeArg)
+{
+    vector<DeclRefExpr*> declRefs;
+    clazy::getChilds(typeArg, declRefs);
+    return clazy::any_of(declRefs, [](DeclRefExpr *declRef) {
+        auto enumConstant = dyn_cast<EnumConstantDecl>(declRef->getDecl());
+        const StringRef name = enumConstant ? clazy::name(enumConstant) : StringRef();
+        return name == "QueuedConnection" || name == "BlockingQueuedConnection";
+    });
+}
+
+void LargeSignalArguments::VisitStmt(clang::Stmt *stmt)
+{
+    auto call = dyn_cast<CallExpr>(stmt);
+    FunctionDecl *func = call ? call->getDirectCallee() : nullptr;
+    if (!func || !clazy::isConnect(func) || !clazy::connectHasPMFStyle(func))
+        return;
+
+    // The Qt::ConnectionType is always the last argument
+    const unsigned int numArgs = call->getNumArgs();
+    if (numArgs < 4 || func->getNumParams() != numArgs)
+        return;
+
+    const QualType typeParamType = func->getParamDecl(numArgs - 1)->getType();
+    const EnumDecl *enumDecl = typeParamType->getAs<EnumType>() ? typeParamType->getAs<EnumType>()->getDecl() : nullptr;
+    if (!enumDecl || clazy::name(enumDecl) != "ConnectionType" || !isQueuedConnection(call->getArg(numArgs - 1)))
+        return;
+
+    CXXMethodDecl *signal = clazy::pmfFromConnect(call, /*argIndex=*/ 1);
+    if (!signal)
+        return;
+
+    for (ParmVarDecl *param : Utils::functionParameters(signal)) {
+        int size = 0;
+        if (!isExpensiveToCopy(param->getType(), size))
+            continue;
+
+        emitWarning(call, "queued connection copies the " + clazy::simpleTypeName(param->getType(), lo()) + " (" + to_string(size)
+                    + " bytes) argument of " + signal->getQualifiedNameAsString() + " on every emit, consider an implicitly shared or pointer-like type");
+        return;
+    }
+}
@@ -0,0 +1,183 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "linear-search-in-loop.h"
+#include "ClazyContext.h"
+#include "HierarchyUtils.h"
+#include "LoopUtils.h"
+#include "StmtBodyRange.h"
+#include "StringUtils.h"
+#include "TemplateUtils.h"
+#include "TypeUtils.h"
+#include "Utils.h"
+#include "SourceCompatibilityHelpers.h"
+#include "clazy_stl.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/DeclTemplate.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/Type.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/SourceManager.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+#include <vector>
+
+using namespace clang;
+using namespace std;
+
+LinearSearchInLoop::LinearSearchInLoop(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+}
+
+// The sequential container record is, or derives from, as QStringList derives from QList<QString>
+static ClassTemplateSpecializationDecl *sequentialContainer(CXXRecordDecl *record)
+{
+    if (!record || !record->hasDefinition())
+        return nullptr;
+
+    static const std::vector<std::string> classes = { "QList", "QVector", "QVarLengthArray", "std::vector", "std::deque", "std::list" };
+    auto templateDecl = dyn_cast<ClassTemplateSpecializationDecl>(record);
+    if (templateDecl && clazy::any_of(classes, [record](const string &className) { return clazy::qualifiedNameIs(record, className); }))
+        return templateDecl;
+
+    for (auto base : record->bases()) {
+        if (auto baseTemplateDecl = sequentialContainer(clazy::recordFromBaseSpecifier(base)))
+            return baseTemplateDecl;
+    }
+
+    return nullptr;
+}
+
+// Arguments written by the user, not the defaulted ones, like the case sensitivity of QStringList::contains()
+static unsigned int numExplicitArgs(CallExpr *call)
+{
+    unsigned int count = 0;
+    for (Expr *arg : call->arguments()) {
+        if (!isa<CXXDefaultArgExpr>(arg))
+            ++count;
+    }
+
+    return count;
+}
+
+// The v.begin() in std::find(v.begin(), v.end(), value), possibly converted to a const_iterator
+static CXXMemberCallExpr *beginCall(Expr *expr)
+{
+    while (expr) {
+        expr = expr->IgnoreImplicit();
+        auto constructExpr = dyn_cast<CXXConstructExpr>(expr);
+        if (!constructExpr || constructExpr->getNumArgs() != 1)
+            break;
+        expr = constructExpr->getArg(0);
+    }
+
+    auto call = dyn_cast_or_null<CXXMemberCallExpr>(expr);
+    if (!call || !call->getMethodDecl())
+        return nullptr;
+
+    static const clazy::NameSet beginMethods = { "begin", "cbegin", "constBegin" };
+    return beginMethods.contains(clazy::name(call->getMethodDecl())) ? call : nullptr;
+}
+
+// If child, a child of loop, is evaluated once before the iterations, like a for loop's init statement or a range-for's range
+static bool runsBeforeIterations(Stmt *loop, Stmt *child)
+{
+    if (auto forStmt = dyn_cast<ForStmt>(loop))
+        return child == forStmt->getInit();
+
+    if (auto rangeFor = dyn_cast<CXXForRangeStmt>(loop))
+        return child != rangeFor->getBody() && child != rangeFor->getLoopVarStmt() && child != rangeFor->getCond()
+               && child != rangeFor->getInc();
+
+    return false;
+}
+
+void LinearSearchInLoop::checkSearch(Stmt *search, CXXMemberCallExpr *containerCall, const string &what)
+{
+    CXXRecordDecl *record = containerCall->getRecordDecl();
+    ClassTemplateSpecializationDecl *containerDecl = sequentialContainer(record);
+    if (!containerDecl)
+        return;
+
+    // Members can be modified by any function called in the loop, only look at variables
+    auto varDecl = dyn_cast_or_null<VarDecl>(Utils::valueDeclForMemberCall(containerCall));
+    if (!varDecl)
+        return;
+
+    // Walk up by hand instead of using clazy::isInLoop(), as a lambda defined inside a loop doesn't run there
+    Stmt *loop = nullptr;
+    Stmt *child = search;
+    for (Stmt *parent = clazy::parent(m_context, search); parent && !loop; child = parent, parent = clazy::parent(m_context, parent)) {
+        if (isa<LambdaExpr>(parent))
+            return;
+
+        if (clazy::isLoop(parent) && !runsBeforeIterations(parent, child))
+            loop = parent;
+    }
+
+    // A container declared inside the loop is built again on each iteration, so the set would be too
+    if (!loop || sm().isBeforeInTranslationUnit(clazy::getLocStart(loop), clazy::getLocStart(varDecl)))
+        return;
+
+    if (Utils::containsNonConstMemberCall(m_context->parentMap, loop, varDecl)
+        || Utils::isPassedToFunction(StmtBodyRange(loop, nullptr, {}, m_context->functionStmtIndex(loop)), varDecl, true))
+        return;
+
+    const bool isStd = containerDecl->isInStdNamespace();
+    const string elementType = clazy::simpleTypeName(clazy::getTemplateArgumentType(containerDecl, 0), lo());
+    const string containerName = (isStd ? "std::" : "") + clazy::name(record).str();
+    const string set = isStd ? "std::unordered_set<" + elementType + '>' : "QSet<" + elementType + '>';
+    emitWarning(clazy::getLocStart(search), what + " searches the " + containerName + " linearly on each iteration; consider building a "
+                + set + " once before the loop");
+}
+
+void LinearSearchInLoop::VisitStmt(clang::Stmt *stmt)
+{
+    if (auto memberCall = dyn_cast<CXXMemberCallExpr>(stmt)) {
+        CXXMethodDecl *method = memberCall->getMethodDecl();
+        static const clazy::NameSet searchMethods = { "contains", "indexOf", "lastIndexOf" };
+        if (!method || !searchMethods.contains(clazy::name(method)) || numExplicitArgs(memberCall) != 1)
+            return;
+
+        // A regular expression can't be looked up in a set
+        const CXXRecordDecl *paramRecord = method->getNumParams() > 0 ? method->getParamDecl(0)->getType().getNonReferenceType()->getAsCXXRecordDecl() : nullptr;
+        if (paramRecord && (clazy::name(paramRecord) == "QRegularExpression" || clazy::name(paramRecord) == "QRegExp"))
+            return;
+
+        checkSearch(stmt, memberCall, clazy::name(method).str() + "()");
+        return;
+    }
+
+    auto call = dyn_cast<CallExpr>(stmt);
+    FunctionDecl *func = call ? call->getDirectCallee() : nullptr;
+    if (!func || call->getNumArgs() != 3 || !clazy::qualifiedNameIs(func, "std::find"))
+        return;
+
+    if (CXXMemberCallExpr *containerCall = beginCall(call->getArg(0)))
+        checkSearch(stmt, containerCall, "std::find()");
+}
@@ -0,0 +1,164 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#include "lookup-key-allocations.h"
+#include "ClazyContext.h"
+#include "StringUtils.h"
+#include "TypeUtils.h"
+#include "Utils.h"
+#include "SourceCompatibilityHelpers.h"
+
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/DeclTemplate.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/Basic/LLVM.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+using namespace clang;
+using namespace std;
+
+enum KeySource {
+    KeySource_None = 0,
+    KeySource_Literal,
+    KeySource_ByteArray
+};
+
+LookupKeyAllocations::LookupKeyAllocations(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+    , m_loopsOnly(isOptionSet("loops-only"))
+{
+}
+
+// Returns whether source, what a QString is created from, is a literal or a QByteArray
+static KeySource keySourceFor(Expr *source)
+{
+    if (Utils::containsStringLiteral(source, /*allowEmpty=*/ true))
+        return KeySource_Literal;
+
+    const CXXRecordDecl *record = clazy::unrefQualType(source->getType())->getAsCXXRecordDecl();
+    return record && clazy::name(record) == "QByteArray" ? KeySource_ByteArray : KeySource_None;
+}
+
+// Returns what the temporary QString passed as key is created from, if it's a temporary at all
+static KeySource temporaryKeySource(Expr *key)
+{
+    Expr *expr = key->IgnoreImplicit();
+    while (true) {
+        if (auto cast = dyn_cast<CXXFunctionalCastExpr>(expr)) {
+            expr = cast->getSubExpr()->IgnoreImplicit();
+            continue;
+        }
+
+        // Copies of a named QString, or of a QStringLiteral, don't allocate
+        auto ctorExpr = dyn_cast<CXXConstructExpr>(expr);
+        if (ctorExpr && ctorExpr->getConstructor() && ctorExpr->getConstructor()->isCopyOrMoveConstructor()
+            && ctorExpr->getNumArgs() == 1) {
+            expr = ctorExpr->getArg(0)->IgnoreImplicit();
+            continue;
+        }
+
+        break;
+    }
+
+    if (auto ctorExpr = dyn_cast<CXXConstructExpr>(expr)) {
+        if (ctorExpr->getNumArgs() == 0 || !clazy::isOfClass(ctorExpr->getConstructor(), "QString"))
+            return KeySource_None;
+
+        return keySourceFor(ctorExpr->getArg(0));
+    }
+
+    // QString::fromLatin1("key") and friends
+    if (auto call = dyn_cast<CallExpr>(expr)) {
+        static const clazy::NameSet conversions = { "fromLatin1", "fromUtf8", "fromLocal8Bit", "fromAscii" };
+        auto method = dyn_cast_or_null<CXXMethodDecl>(call->getDirectCallee());
+        if (!method || !method->isStatic() || call->getNumArgs() == 0 || !clazy::functionIsOneOf(method, conversions)
+            || !clazy::isOfClass(method, "QString"))
+            return KeySource_None;
+
+        return keySourceFor(call->getArg(0));
+    }
+
+    return KeySource_None;
+}
+
+// Returns true if the container has a template overload of method, which is how Qt 6 implements heterogeneous lookup
+static bool hasHeterogeneousOverload(CXXMethodDecl *method)
+{
+    for (Decl *decl : method->getParent()->decls()) {
+        auto functionTemplate = dyn_cast<FunctionTemplateDecl>(decl);
+        if (functionTemplate && functionTemplate->getDeclName() == method->getDeclName())
+            return true;
+    }
+
+    return false;
+}
+
+void LookupKeyAllocations::VisitStmt(clang::Stmt *stmt)
+{
+    auto call = dyn_cast<CallExpr>(stmt);
+    if (!call || (!isa<CXXMemberCallExpr>(call) && !isa<CXXOperatorCallExpr>(call)))
+        return;
+
+    const StmtFacts &facts = m_context->stmtFacts;
+    CXXMethodDecl *method = facts.method();
+    if (!method || method->getNumParams() == 0)
+        return;
+
+    static const clazy::NameSet containers = { "QHash", "QMap", "QMultiHash", "QMultiMap", "QSet" };
+    static const clazy::NameSet lookups = { "value", "values", "contains", "count", "find", "constFind", "take",
+                                            "remove", "lowerBound", "upperBound", "equal_range", "operator[]" };
+    if (!clazy::classIsOneOf(facts.record(), containers) || !lookups.contains(clazy::name(method)))
+        return;
+
+    const CXXRecordDecl *keyRecord = clazy::unrefQualType(method->getParamDecl(0)->getType())->getAsCXXRecordDecl();
+    if (!keyRecord || clazy::name(keyRecord) != "QString")
+        return;
+
+    // The object is the first argument of operator[]
+    const unsigned int keyIndex = isa<CXXOperatorCallExpr>(call) ? 1 : 0;
+    if (call->getNumArgs() <= keyIndex)
+        return;
+
+    Expr *key = call->getArg(keyIndex);
+    const KeySource source = temporaryKeySource(key);
+    if (source == KeySource_None)
+        return;
+
+    const bool inLoop = facts.enclosingLoop() != nullptr;
+    if (m_loopsOnly && !inLoop)
+        return;
+
+    string msg = clazy::name(method->getParent()).str() + "::" + clazy::name(method).str()
+                 + "() key is a temporary QString created from a "
+                 + (source == KeySource_Literal ? "string literal" : "QByteArray") + ", which allocates on every "
+                 + (inLoop ? "loop iteration" : "call");
+    if (hasHeterogeneousOverload(method))
+        msg += ", look it up with a QStringView or QLatin1String instead";
+    else if (source == KeySource_Literal)
+        msg += ", use QStringLiteral or a static QString";
+    else
+        msg += ", store the key as a QString to begin with";
+
+    emitWarning(clazy::getLocStart(key), msg);
+}
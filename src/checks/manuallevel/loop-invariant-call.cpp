@@ -0,0 +1,94 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "loop-invariant-call.h"
+#include "ClazyContext.h"
+#include "LoopUtils.h"
+#include "StringUtils.h"
+#include "SourceCompatibilityHelpers.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/Type.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/SourceLocation.h>
+#include <llvm/Support/Casting.h>
+
+using namespace clang;
+using namespace std;
+
+LoopInvariantCall::LoopInvariantCall(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+}
+
+// Returns the record callee returns by value, if it's not trivially copyable, like containers and strings
+static CXXRecordDecl *nonTrivialReturnType(const FunctionDecl *callee)
+{
+    const QualType returnType = callee->getReturnType();
+    if (returnType.isNull() || returnType->isReferenceType() || returnType->isDependentType())
+        return nullptr;
+
+    CXXRecordDecl *record = returnType->getAsCXXRecordDecl();
+    return record && record->hasDefinition() && !record->isTriviallyCopyable() ? record : nullptr;
+}
+
+bool LoopInvariantCall::isHoistable(CallExpr *call, Stmt *loop) const
+{
+    // Operators are mostly cheap lookups, and their results rarely worth a variable
+    FunctionDecl *callee = call->getDirectCallee();
+    if (!callee || isa<CXXOperatorCallExpr>(call) || isa<CXXConversionDecl>(callee) || !nonTrivialReturnType(callee))
+        return false;
+
+    auto method = dyn_cast<CXXMethodDecl>(callee);
+    if (method && !method->isStatic() && !method->isConst())
+        return false;
+
+    return clazy::isLoopInvariant(m_context, call, loop);
+}
+
+void LoopInvariantCall::VisitStmt(clang::Stmt *stmt)
+{
+    auto call = dyn_cast<CallExpr>(stmt);
+    if (!call || clazy::getLocStart(call).isMacroID())
+        return;
+
+    Stmt *loop = clazy::loopRunningOnEachIteration(m_context, call);
+    if (!loop || !isHoistable(call, loop))
+        return;
+
+    // Only warn about the outermost call, hoisting it hoists the ones it's made of too
+    for (Stmt *parent = clazy::parent(m_context, call); parent && parent != loop; parent = clazy::parent(m_context, parent)) {
+        auto parentCall = dyn_cast<CallExpr>(parent);
+        if (parentCall && isHoistable(parentCall, loop))
+            return;
+    }
+
+    const FunctionDecl *callee = call->getDirectCallee();
+    auto method = dyn_cast<CXXMethodDecl>(callee);
+    const string name = (method ? clazy::name(method->getParent()).str() + "::" : string()) + clazy::name(callee).str() + "()";
+    const string typeName = clazy::simpleTypeName(callee->getReturnType(), lo());
+    emitWarning(clazy::getLocStart(call), name + " returns the same " + typeName + " on every iteration; hoist it into a const local before the loop");
+}
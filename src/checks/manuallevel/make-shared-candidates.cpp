@@ -0,0 +1,149 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "make-shared-candidates.h"
+#include "ClazyContext.h"
+#include "FixItUtils.h"
+#include "HierarchyUtils.h"
+#include "SourceCompatibilityHelpers.h"
+#include "TemplateUtils.h"
+#include "Utils.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/Type.h>
+#include <clang/AST/TypeLoc.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/SourceManager.h>
+#include <clang/Lex/Lexer.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+using namespace clang;
+using namespace std;
+
+MakeSharedCandidates::MakeSharedCandidates(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+}
+
+std::string MakeSharedCandidates::sourceText(SourceRange range) const
+{
+    return Lexer::getSourceText(CharSourceRange::getTokenRange(range), sm(), lo()).str();
+}
+
+// The arguments of new T(...), to forward to std::make_shared<T>(...). Returns false if they can't be forwarded.
+bool MakeSharedCandidates::argumentsText(const CXXNewExpr *newExpr, std::string &text) const
+{
+    const Expr *init = newExpr->hasInitializer() ? newExpr->getInitializer() : nullptr;
+    if (!init)
+        return true;
+
+    // Braces can pick another constructor than the parentheses std::make_shared() uses, or be aggregate initialization
+    auto construct = dyn_cast<CXXConstructExpr>(init);
+    if (!construct) {
+        if (isa<InitListExpr>(init) || isa<ParenListExpr>(init) || init->getSourceRange().getBegin().isMacroID()
+            || init->getSourceRange().getEnd().isMacroID())
+            return false;
+        text = sourceText(init->getSourceRange()); // new int(5)
+        return true;
+    }
+
+    if (construct->isListInitialization())
+        return false;
+
+    SourceLocation begin;
+    SourceLocation end;
+    for (const Expr *arg : construct->arguments()) {
+        if (isa<CXXDefaultArgExpr>(arg))
+            break;
+        if (begin.isInvalid())
+            begin = clazy::getLocStart(arg);
+        end = clazy::getLocEnd(arg);
+    }
+
+    if (begin.isMacroID() || end.isMacroID())
+        return false;
+
+    if (begin.isValid())
+        text = sourceText({ begin, end });
+    return true;
+}
+
+void MakeSharedCandidates::VisitStmt(clang::Stmt *stmt)
+{
+    auto construct = dyn_cast<CXXConstructExpr>(stmt);
+    if (!construct || construct->getNumArgs() != 1 || construct->isTypeDependent()) // Two arguments pass a deleter
+        return;
+
+    auto newExpr = dyn_cast<CXXNewExpr>(construct->getArg(0)->IgnoreParenImpCasts());
+    if (!newExpr || newExpr->isArray() || newExpr->getNumPlacementArgs() > 0)
+        return;
+
+    auto record = dyn_cast_or_null<ClassTemplateSpecializationDecl>(construct->getConstructor()->getParent());
+    if (!record || !Utils::isSharedPointer(record))
+        return;
+
+    // std::make_shared() uses neither a class specific operator new, nor constructors only the caller can access
+    const QualType allocatedType = newExpr->getAllocatedType();
+    const CXXConstructExpr *objectConstruct = newExpr->getConstructExpr();
+    if (dyn_cast_or_null<CXXMethodDecl>(newExpr->getOperatorNew())
+        || (objectConstruct && objectConstruct->getConstructor()->getAccess() != AS_public))
+        return;
+
+    const StringRef className = clazy::name(record);
+    const bool isQt = className == "QSharedPointer";
+    const bool isBoost = !isQt && !record->isInStdNamespace();
+    const char *factory = isQt ? "QSharedPointer::create()" : (isBoost ? "boost::make_shared()" : "std::make_shared()");
+    const string pointerName = isQt ? "QSharedPointer" : (isBoost ? "boost::shared_ptr" : "std::shared_ptr");
+
+    // Only a fixit for the same type, as QSharedPointer<Base>::create() can't make a Derived
+    vector<FixItHint> fixits;
+    const QualType pointeeType = clazy::getTemplateArgumentType(record, 0);
+    string args;
+    if (!pointeeType.isNull() && pointeeType.getCanonicalType() == allocatedType.getCanonicalType()
+        && argumentsText(newExpr, args)) {
+        // std::shared_ptr<Foo>(new Foo()) is replaced entirely, std::shared_ptr<Foo> foo(new Foo()) only the new
+        Expr *replaced = newExpr;
+        Stmt *parent = clazy::parent(m_context, construct);
+        while (parent && (isa<CXXBindTemporaryExpr>(parent) || isa<ImplicitCastExpr>(parent)))
+            parent = clazy::parent(m_context, parent);
+        if (isa<CXXTemporaryObjectExpr>(construct))
+            replaced = construct;
+        else if (auto cast = dyn_cast_or_null<CXXFunctionalCastExpr>(parent))
+            replaced = cast;
+
+        const SourceRange range = replaced->getSourceRange();
+        const string typeName = sourceText(newExpr->getAllocatedTypeSourceInfo()->getTypeLoc().getSourceRange());
+        if (range.getBegin().isFileID() && range.getEnd().isFileID() && !typeName.empty()) {
+            const string replacement = isQt ? "QSharedPointer<" + typeName + ">::create(" + args + ")"
+                                            : (isBoost ? "boost" : "std") + string("::make_shared<") + typeName + ">(" + args + ")";
+            fixits.push_back(clazy::createReplacement(range, replacement));
+        }
+    }
+
+    emitFormattedWarning(clazy::getLocStart(newExpr), "%0 constructed from new allocates the object and its reference count "
+                         "separately; use %1 instead", { pointerName, factory }, fixits);
+}
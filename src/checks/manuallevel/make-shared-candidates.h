@@ -0,0 +1,55 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_MAKE_SHARED_CANDIDATES_H
+#define CLAZY_MAKE_SHARED_CANDIDATES_H
+
+#include "checkbase.h"
+
+#include <string>
+
+class ClazyContext;
+
+namespace clang {
+class CXXConstructExpr;
+class CXXNewExpr;
+class Stmt;
+}
+
+/**
+ * Finds std::shared_ptr and QSharedPointer constructed from a new expression, which allocate the object and the
+ * reference count separately, instead of with std::make_shared() or QSharedPointer::create().
+ *
+ * See README-make-shared-candidates.md for more info.
+ */
+class MakeSharedCandidates
+    : public CheckBase
+{
+public:
+    explicit MakeSharedCandidates(const std::string &name, ClazyContext *context);
+    void VisitStmt(clang::Stmt *stmt) override;
+private:
+    bool argumentsText(const clang::CXXNewExpr *newExpr, std::string &text) const;
+    std::string sourceText(clang::SourceRange range) const;
+};
+
+#endif
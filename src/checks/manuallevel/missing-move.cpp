@@ -0,0 +1,220 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "missing-move.h"
+#include "ClazyContext.h"
+#include "FixItUtils.h"
+#include "HierarchyUtils.h"
+#include "LoopUtils.h"
+#include "QtUtils.h"
+#include "StmtIndex.h"
+#include "StringUtils.h"
+#include "Utils.h"
+#include "SourceCompatibilityHelpers.h"
+#include "clazy_stl.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/ParentMap.h>
+#include <clang/AST/Stmt.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/SourceManager.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+#include <algorithm>
+
+using namespace clang;
+using namespace std;
+
+MissingMove::MissingMove(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+}
+
+// Types whose copy costs an atomic reference count increment, or a deep copy, while moving is almost free
+static bool isCandidateType(CXXRecordDecl *record)
+{
+    if (!record)
+        return false;
+
+    const StringRef name = clazy::name(record);
+    if (record->isInStdNamespace()) {
+        static const clazy::NameSet stdTypes = { "basic_string", "vector", "deque", "list", "forward_list",
+                                                 "map", "multimap", "set", "multiset", "unordered_map",
+                                                 "unordered_multimap", "unordered_set", "unordered_multiset",
+                                                 "shared_ptr" };
+        return stdTypes.contains(name);
+    }
+
+    static const clazy::NameSet qtTypes = { "QStringList", "QByteArrayList", "QVariant", "QJsonObject", "QSharedPointer" };
+    return (clazy::isQtCOWIterableClass(record) && name != "QStringRef") || qtTypes.contains(name);
+}
+
+// Returns the variable copied by a copy constructor or copy-assignment operator call, if a move would work too
+static DeclRefExpr *copiedVariable(Stmt *stmt)
+{
+    Expr *source = nullptr;
+    CXXRecordDecl *record = nullptr;
+    if (auto ctorExpr = dyn_cast<CXXConstructExpr>(stmt)) {
+        CXXConstructorDecl *ctor = ctorExpr->getConstructor();
+        if (!ctor || !ctor->isCopyConstructor() || ctorExpr->getNumArgs() == 0)
+            return nullptr;
+
+        record = ctor->getParent();
+        if (!record->hasMoveConstructor())
+            return nullptr;
+        source = ctorExpr->getArg(0);
+    } else if (auto op = dyn_cast<CXXOperatorCallExpr>(stmt)) {
+        auto method = dyn_cast_or_null<CXXMethodDecl>(op->getDirectCallee());
+        if (!method || !method->isCopyAssignmentOperator() || op->getNumArgs() != 2)
+            return nullptr;
+
+        record = method->getParent();
+        if (!record->hasMoveAssignment())
+            return nullptr;
+        source = op->getArg(1);
+    }
+
+    if (!source || !isCandidateType(record))
+        return nullptr;
+
+    return dyn_cast<DeclRefExpr>(source->IgnoreParenImpCasts());
+}
+
+// Returns true if stmt is the value of a return statement, which is moved already
+static bool isReturnValue(ParentMap *map, Stmt *stmt)
+{
+    Stmt *parent = clazy::parent(map, stmt);
+    while (parent && (isa<ImplicitCastExpr>(parent) || isa<ExprWithCleanups>(parent)
+                      || isa<CXXBindTemporaryExpr>(parent) || isa<MaterializeTemporaryExpr>(parent)))
+        parent = clazy::parent(map, parent);
+
+    return parent && isa<ReturnStmt>(parent);
+}
+
+static bool isDeclaredInside(const SourceManager &sm, Stmt *stmt, const VarDecl *varDecl)
+{
+    if (!stmt)
+        return false;
+
+    const SourceLocation loc = sm.getExpansionLoc(varDecl->getLocation());
+    return sm.isBeforeInTranslationUnit(sm.getExpansionLoc(clazy::getLocStart(stmt)), loc)
+           && sm.isBeforeInTranslationUnit(loc, sm.getExpansionLoc(clazy::getLocEnd(stmt)));
+}
+
+vector<DeclRefExpr *> MissingMove::referencesIn(Stmt *scope, const VarDecl *varDecl) const
+{
+    vector<DeclRefExpr *> references = clazy::getStatements<DeclRefExpr>(m_context->functionStmtIndex(scope), scope);
+    references.erase(std::remove_if(references.begin(), references.end(), [varDecl](DeclRefExpr *declRef) {
+        return declRef->getDecl() != varDecl;
+    }), references.end());
+    return references;
+}
+
+// Returns true if copied is the only reference to its variable which isn't before fullExpr
+bool MissingMove::isLastUse(Stmt *scope, Stmt *fullExpr, DeclRefExpr *copied) const
+{
+    const SourceLocation fullExprStart = sm().getExpansionLoc(clazy::getLocStart(fullExpr));
+    return clazy::all_of(referencesIn(scope, cast<VarDecl>(copied->getDecl())), [this, copied, fullExprStart](DeclRefExpr *declRef) {
+        return declRef == copied || sm().isBeforeInTranslationUnit(sm().getExpansionLoc(clazy::getLocStart(declRef)), fullExprStart);
+    });
+}
+
+void MissingMove::VisitStmt(clang::Stmt *stmt)
+{
+    ParentMap *map = m_context->parentMap;
+    DeclRefExpr *copied = map ? copiedVariable(stmt) : nullptr;
+    if (!copied || clazy::getLocStart(copied).isMacroID())
+        return;
+
+    auto varDecl = dyn_cast<VarDecl>(copied->getDecl());
+    if (!varDecl || !varDecl->hasLocalStorage() || varDecl->getType()->isReferenceType()
+        || varDecl->getType().isConstQualified() || varDecl->getType().isVolatileQualified())
+        return;
+
+    // Lambda captures can't take std::move() as is
+    Stmt *parent = clazy::parent(map, stmt);
+    if (isReturnValue(map, stmt) || (parent && isa<LambdaExpr>(parent)))
+        return;
+
+    // The variable must be dead after the copy, so no loop can run the copy again with the same variable,
+    // and a lambda would copy a capture instead
+    Stmt *fullExpr = stmt;
+    while (fullExpr && clazy::parent(map, fullExpr) && isa<Expr>(clazy::parent(map, fullExpr)))
+        fullExpr = clazy::parent(map, fullExpr);
+
+    Stmt *root = stmt;
+    while (Stmt *p = clazy::parent(map, root)) {
+        bool isFreshVariable = true;
+        if (auto rangeLoop = dyn_cast<CXXForRangeStmt>(p))
+            isFreshVariable = rangeLoop->getLoopVariable() == varDecl || isDeclaredInside(sm(), rangeLoop->getBody(), varDecl);
+        else if (clazy::isLoop(p))
+            isFreshVariable = isDeclaredInside(sm(), clazy::bodyFromLoop(p), varDecl);
+        else if (isa<LambdaExpr>(p))
+            isFreshVariable = isDeclaredInside(sm(), p, varDecl);
+
+        if (!isFreshVariable)
+            return;
+        root = p;
+    }
+
+    FunctionDecl *func = m_context->lastFunctionDecl;
+    Stmt *body = func ? func->getBody() : nullptr;
+    if (!body)
+        return;
+
+    if (root == body) {
+        const StmtIndex *index = m_context->functionStmtIndex(body);
+        if (clazy::getFirstChildOfType<GotoStmt>(index, body) || Utils::isReturned(body, varDecl, index)
+            || Utils::addressIsTaken(body, varDecl, index)
+            || Utils::isCapturedByReference(body, varDecl, index) || Utils::isBoundToReference(body, varDecl, index)
+            || !isLastUse(body, fullExpr, copied))
+            return;
+    } else {
+        // A parameter copied into a member, the initializers don't run in the order they're written,
+        // so it must be its only use
+        auto ctor = dyn_cast<CXXConstructorDecl>(func);
+        if (!ctor || !isa<ParmVarDecl>(varDecl) || !clazy::any_of(ctor->inits(), [root](CXXCtorInitializer *init) {
+                return init->getInit() == root;
+            }))
+            return;
+
+        for (CXXCtorInitializer *init : ctor->inits()) {
+            auto declRef = dyn_cast<DeclRefExpr>(init->getInit()->IgnoreParenImpCasts()); // A reference member
+            if ((declRef && declRef->getDecl() == varDecl)
+                || !clazy::all_of(referencesIn(init->getInit(), varDecl), [copied](DeclRefExpr *declRef) {
+                       return declRef == copied;
+                   }))
+                return;
+        }
+
+        if (!referencesIn(body, varDecl).empty())
+            return;
+    }
+
+    const string name = clazy::name(varDecl).str();
+    emitWarning(clazy::getLocStart(copied), "'" + name + "' is copied on its last use, move it instead",
+                { clazy::createReplacement(copied->getSourceRange(), "std::move(" + name + ")") });
+}
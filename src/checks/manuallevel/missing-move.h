@@ -0,0 +1,57 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_MISSING_MOVE_H
+#define CLAZY_MISSING_MOVE_H
+
+#include "checkbase.h"
+
+#include <string>
+#include <vector>
+
+class ClazyContext;
+
+namespace clang {
+class DeclRefExpr;
+class Stmt;
+class VarDecl;
+}
+
+/**
+ * Finds local containers, strings and shared pointers which are copied on their last use,
+ * where they could be moved instead.
+ *
+ * See README-missing-move.md for more info.
+ */
+class MissingMove
+    : public CheckBase
+{
+public:
+    explicit MissingMove(const std::string &name, ClazyContext *context);
+    void VisitStmt(clang::Stmt *stmt) override;
+
+private:
+    std::vector<clang::DeclRefExpr *> referencesIn(clang::Stmt *scope, const clang::VarDecl *varDecl) const;
+    bool isLastUse(clang::Stmt *scope, clang::Stmt *fullExpr, clang::DeclRefExpr *copied) const;
+};
+
+#endif
@@ -0,0 +1,150 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+
+#include "model-signals-in-loop.h"
+#include "ClazyContext.h"
+#include "HierarchyUtils.h"
+#include "LoopUtils.h"
+#include "StringUtils.h"
+#include "SourceCompatibilityHelpers.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/StmtCXX.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/SourceManager.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+#include <vector>
+
+using namespace clang;
+using namespace std;
+
+ModelSignalsInLoop::ModelSignalsInLoop(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+}
+
+// The arguments holding rows or columns, the parent indexes can't be merged into a single call
+static vector<unsigned int> rowArguments(StringRef methodName)
+{
+    if (methodName == "beginInsertRows" || methodName == "beginRemoveRows" || methodName == "beginInsertColumns"
+        || methodName == "beginRemoveColumns" || methodName == "headerDataChanged")
+        return { 1, 2 };
+
+    if (methodName == "beginMoveRows" || methodName == "beginMoveColumns")
+        return { 1, 2, 4 };
+
+    if (methodName == "dataChanged")
+        return { 0, 1 };
+
+    return {};
+}
+
+// The variables whose value changes with each iteration: the ones in the condition and increment, and the range-for's
+static void collectLoopVariables(Stmt *loop, vector<const VarDecl *> &variables)
+{
+    vector<Stmt *> controls;
+    if (auto forStmt = dyn_cast<ForStmt>(loop)) {
+        controls = { forStmt->getCond(), forStmt->getInc() };
+    } else if (auto whileStmt = dyn_cast<WhileStmt>(loop)) {
+        controls = { whileStmt->getCond() };
+    } else if (auto doStmt = dyn_cast<DoStmt>(loop)) {
+        controls = { doStmt->getCond() };
+    } else if (auto rangeLoop = dyn_cast<CXXForRangeStmt>(loop)) {
+        variables.push_back(rangeLoop->getLoopVariable());
+    }
+
+    for (Stmt *control : controls) {
+        vector<DeclRefExpr *> refs;
+        clazy::getChilds<DeclRefExpr>(control, refs);
+        for (DeclRefExpr *ref : refs) {
+            if (auto var = dyn_cast<VarDecl>(ref->getDecl()))
+                variables.push_back(var);
+        }
+    }
+}
+
+// True if expr uses a loop variable, or a variable declared inside the loop, like a row computed from the index
+static bool dependsOnLoop(Expr *expr, Stmt *loop, const vector<const VarDecl *> &loopVariables, const SourceManager &sm)
+{
+    const SourceRange loopRange = loop->getSourceRange();
+    vector<DeclRefExpr *> refs;
+    clazy::getChilds<DeclRefExpr>(expr, refs);
+    for (DeclRefExpr *ref : refs) {
+        auto var = dyn_cast<VarDecl>(ref->getDecl());
+        if (!var)
+            continue;
+
+        if (clazy::contains(loopVariables, var))
+            return true;
+
+        const SourceLocation varLoc = clazy::getLocStart(var);
+        if (!sm.isBeforeInTranslationUnit(varLoc, loopRange.getBegin()) && !sm.isBeforeInTranslationUnit(loopRange.getEnd(), varLoc))
+            return true;
+    }
+
+    return false;
+}
+
+void ModelSignalsInLoop::VisitStmt(clang::Stmt *stmt)
+{
+    const StmtFacts &facts = m_context->stmtFacts;
+    auto memberCall = dyn_cast<CXXMemberCallExpr>(stmt);
+    CXXMethodDecl *method = memberCall ? facts.method() : nullptr;
+    if (!method || facts.recordName() != "QAbstractItemModel")
+        return;
+
+    const StringRef methodName = clazy::name(method);
+    const vector<unsigned int> rowArgs = rowArguments(methodName);
+    if (rowArgs.empty())
+        return;
+
+    bool perRow = false;
+    for (Stmt *loop = facts.enclosingLoop(); loop && !perRow; loop = clazy::isInLoop(m_context, loop)) {
+        vector<const VarDecl *> loopVariables;
+        collectLoopVariables(loop, loopVariables);
+        for (unsigned int arg : rowArgs) {
+            if (arg < memberCall->getNumArgs() && dependsOnLoop(memberCall->getArg(arg), loop, loopVariables, sm())) {
+                perRow = true;
+                break;
+            }
+        }
+    }
+
+    if (!perRow)
+        return;
+
+    const string what = methodName.endswith("Columns") ? "column" : "row";
+    if (methodName == "dataChanged" || methodName == "headerDataChanged") {
+        emitWarning(clazy::getLocStart(stmt), methodName.str() + "() emitted inside a loop, once per " + what
+                    + ", makes the views update each time, emit it once for the whole range, or emit layoutChanged() for large updates");
+    } else {
+        emitWarning(clazy::getLocStart(stmt), methodName.str() + "() called inside a loop, once per " + what
+                    + ", makes the views relayout each time, call it once for the whole range, or reset the model for large updates");
+    }
+}
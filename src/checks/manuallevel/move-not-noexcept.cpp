@@ -0,0 +1,262 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "move-not-noexcept.h"
+#include "FixItUtils.h"
+#include "HierarchyUtils.h"
+#include "StringUtils.h"
+#include "TemplateUtils.h"
+#include "SourceCompatibilityHelpers.h"
+#include "clazy_stl.h"
+
+#include <clang/AST/ASTContext.h>
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/DeclTemplate.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/Type.h>
+#include <clang/AST/TypeLoc.h>
+#include <clang/Basic/SourceManager.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+#include <vector>
+
+using namespace clang;
+using namespace std;
+
+MoveNotNoexcept::MoveNotNoexcept(const std::string &name, ClazyContext *context)
+    : RuleOfBase(name, context)
+{
+}
+
+// Containers which move their elements with std::move_if_noexcept() when reallocating
+static bool isReallocatingContainer(const ClassTemplateSpecializationDecl *specialization)
+{
+    const StringRef name = clazy::name(specialization);
+    if (name == "QVector")
+        return true;
+
+    return (name == "vector" || name == "deque") && specialization->isInStdNamespace();
+}
+
+void MoveNotNoexcept::VisitDecl(clang::Decl *decl)
+{
+    ClassTemplateSpecializationDecl *specialization = clazy::templateDeclOrMemberType(decl);
+    if (!specialization || !isReallocatingContainer(specialization))
+        return;
+
+    const CXXRecordDecl *record = clazy::getTemplateArgumentRecord(specialization, 0);
+    if (record && m_checkedRecords.insert(record).second)
+        checkRecord(record->getDefinition());
+}
+
+static bool isMoveMethod(const CXXMethodDecl *method, bool assignment)
+{
+    if (assignment)
+        return method->isMoveAssignmentOperator();
+
+    auto ctor = dyn_cast<CXXConstructorDecl>(method);
+    return ctor && ctor->isMoveConstructor();
+}
+
+static bool isCopyMethod(const CXXMethodDecl *method, bool assignment)
+{
+    if (assignment)
+        return method->isCopyAssignmentOperator();
+
+    auto ctor = dyn_cast<CXXConstructorDecl>(method);
+    return ctor && ctor->isCopyConstructor();
+}
+
+static bool isNothrowMove(const ASTContext &context, QualType type, bool assignment, int depth);
+
+// Implicit and defaulted members are noexcept if the bases' and members' ones are
+static bool membersAreNothrowMove(const ASTContext &context, const CXXRecordDecl *record, bool assignment, int depth)
+{
+    for (const CXXBaseSpecifier &base : record->bases()) {
+        if (!isNothrowMove(context, base.getType(), assignment, depth))
+            return false;
+    }
+
+    for (const FieldDecl *field : record->fields()) {
+        if (!isNothrowMove(context, field->getType(), assignment, depth))
+            return false;
+    }
+
+    return true;
+}
+
+// Returns true if the type's move constructor, or its move assignment operator, is noexcept.
+// Types without one are copied instead, so their copy constructor or copy assignment operator are checked.
+static bool isNothrowMove(const ASTContext &context, QualType type, bool assignment, int depth)
+{
+    const Type *t = type.getTypePtrOrNull();
+    if (!t || t->isDependentType() || depth > 8)
+        return false;
+
+    t = t->getBaseElementTypeUnsafe();
+    CXXRecordDecl *record = t->getAsCXXRecordDecl();
+    if (!record || type.isTriviallyCopyableType(context))
+        return true;
+
+    record = record->getDefinition();
+    if (!record)
+        return false;
+
+    const CXXMethodDecl *move = nullptr;
+    const CXXMethodDecl *copy = nullptr;
+    for (const CXXMethodDecl *method : record->methods()) {
+        if (isMoveMethod(method, assignment))
+            move = method;
+        else if (isCopyMethod(method, assignment))
+            copy = method;
+    }
+
+    const CXXMethodDecl *used = move ? move : copy;
+    if (!used)
+        return membersAreNothrowMove(context, record, assignment, depth + 1); // Not declared yet
+
+    if (used->isDeleted())
+        return false;
+
+    auto proto = used->getType()->getAs<FunctionProtoType>();
+    if (!proto)
+        return false;
+
+    const ExceptionSpecificationType spec = proto->getExceptionSpecType();
+    if (spec == EST_Unevaluated || spec == EST_Uninstantiated)
+        return membersAreNothrowMove(context, record, assignment, depth + 1);
+
+    return clazy::isNothrow(proto, context);
+}
+
+static bool isNothrowCall(const ASTContext &context, const FunctionDecl *func)
+{
+    if (!func)
+        return false;
+
+    auto method = dyn_cast<CXXMethodDecl>(func);
+    auto proto = func->getType()->getAs<FunctionProtoType>();
+    if (!proto)
+        return false;
+
+    const ExceptionSpecificationType spec = proto->getExceptionSpecType();
+    if (spec != EST_Unevaluated && spec != EST_Uninstantiated)
+        return clazy::isNothrow(proto, context) || func->isTrivial();
+
+    // Implicit or defaulted special members of the members
+    if (method && (isMoveMethod(method, false) || isCopyMethod(method, false)))
+        return isNothrowMove(context, context.getRecordType(method->getParent()), false, 0);
+    if (method && (isMoveMethod(method, true) || isCopyMethod(method, true)))
+        return isNothrowMove(context, context.getRecordType(method->getParent()), true, 0);
+
+    return isa<CXXDestructorDecl>(func) || func->isTrivial();
+}
+
+// Returns true if nothing in stmt can throw, except std::exchange() on scalars, which is only noexcept since C++23
+static bool cantThrow(const ASTContext &context, Stmt *stmt)
+{
+    if (!stmt)
+        return true;
+
+    if (!clazy::getStatements<CXXNewExpr>(stmt, nullptr, {}, -1, true).empty()
+        || !clazy::getStatements<CXXThrowExpr>(stmt, nullptr, {}, -1, true).empty()
+        || !clazy::getStatements<CXXDynamicCastExpr>(stmt, nullptr, {}, -1, true).empty())
+        return false;
+
+    for (CallExpr *call : clazy::getStatements<CallExpr>(stmt, nullptr, {}, -1, true)) {
+        FunctionDecl *func = call->getDirectCallee();
+        if (func && func->isInStdNamespace() && clazy::name(func) == "exchange" && call->getType()->isScalarType())
+            continue;
+
+        if (!isNothrowCall(context, func))
+            return false;
+    }
+
+    return clazy::all_of(clazy::getStatements<CXXConstructExpr>(stmt, nullptr, {}, -1, true), [&context](CXXConstructExpr *ctorExpr) {
+        return isNothrowCall(context, ctorExpr->getConstructor());
+    });
+}
+
+void MoveNotNoexcept::checkRecord(CXXRecordDecl *record)
+{
+    if (!record || record->isDependentType() || isBlacklisted(record) || sm().isInSystemHeader(clazy::getLocStart(record)))
+        return;
+
+    for (CXXMethodDecl *method : record->methods()) {
+        const bool isMoveCtor = isMoveMethod(method, false);
+        if (!isMoveCtor && !isMoveMethod(method, true))
+            continue;
+
+        // A defaulted one is already noexcept when it can be
+        auto proto = method->getType()->getAs<FunctionProtoType>();
+        if (!proto || !method->isUserProvided() || method->isDeleted() || clazy::isNothrow(proto, *m_astContext))
+            continue;
+
+        const string recordName = clazy::name(record).str();
+        if (isMoveCtor)
+            emitWarning(method, "move constructor of " + recordName + " isn't noexcept, containers copy "
+                        + recordName + " elements instead of moving them when they grow", fixits(method));
+        else
+            emitWarning(method, "move assignment operator of " + recordName + " isn't noexcept, so std::swap() of "
+                        + recordName + " isn't either", fixits(method));
+    }
+}
+
+vector<FixItHint> MoveNotNoexcept::fixits(CXXMethodDecl *method) const
+{
+    if (!fixitsEnabled() || method->getRefQualifier() != RQ_None)
+        return {};
+
+    // Only where it's obvious that nothing throws, otherwise noexcept would turn an exception into std::terminate()
+    const FunctionDecl *definition = nullptr;
+    if (!method->hasBody(definition))
+        return {};
+
+    const bool assignment = method->isMoveAssignmentOperator();
+    if (!membersAreNothrowMove(*m_astContext, method->getParent(), assignment, 0)
+        || !cantThrow(*m_astContext, definition->getBody()))
+        return {};
+
+    if (auto ctor = dyn_cast<CXXConstructorDecl>(definition)) {
+        for (CXXCtorInitializer *init : ctor->inits()) {
+            if (!cantThrow(*m_astContext, init->getInit()))
+                return {};
+        }
+    }
+
+    // Both the declaration and the definition need it
+    vector<FixItHint> fixits;
+    for (const FunctionDecl *redecl : method->redecls()) {
+        TypeSourceInfo *typeSourceInfo = redecl->getTypeSourceInfo();
+        auto typeLoc = typeSourceInfo ? typeSourceInfo->getTypeLoc().IgnoreParens().getAs<FunctionTypeLoc>() : FunctionTypeLoc();
+        if (!typeLoc || typeLoc.getRParenLoc().isMacroID())
+            return {};
+
+        fixits.push_back(clazy::createInsertion(clazy::locForEndOfToken(m_astContext, typeLoc.getRParenLoc()), " noexcept"));
+    }
+
+    return fixits;
+}
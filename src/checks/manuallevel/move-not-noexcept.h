@@ -0,0 +1,60 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_MOVE_NOT_NOEXCEPT_H
+#define CLAZY_MOVE_NOT_NOEXCEPT_H
+
+#include "checks/ruleofbase.h"
+
+#include <llvm/ADT/SmallPtrSet.h>
+
+#include <string>
+#include <vector>
+
+class ClazyContext;
+
+namespace clang {
+class CXXMethodDecl;
+class CXXRecordDecl;
+class Decl;
+class FixItHint;
+}
+
+/**
+ * Finds user-provided move constructors and move assignment operators which aren't noexcept, in types
+ * stored in std::vector, QVector or std::deque, which then copy their elements when reallocating.
+ *
+ * See README-move-not-noexcept.md for more info.
+ */
+class MoveNotNoexcept
+    : public RuleOfBase
+{
+public:
+    explicit MoveNotNoexcept(const std::string &name, ClazyContext *context);
+    void VisitDecl(clang::Decl *decl) override;
+private:
+    void checkRecord(clang::CXXRecordDecl *record);
+    std::vector<clang::FixItHint> fixits(clang::CXXMethodDecl *method) const;
+    llvm::SmallPtrSet<const clang::CXXRecordDecl *, 32> m_checkedRecords;
+};
+
+#endif
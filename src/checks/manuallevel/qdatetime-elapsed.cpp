@@ -0,0 +1,142 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+
+#include "qdatetime-elapsed.h"
+#include "ClazyContext.h"
+#include "LoopUtils.h"
+#include "StringUtils.h"
+#include "SourceCompatibilityHelpers.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/OperationKinds.h>
+#include <clang/AST/Stmt.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/OperatorKinds.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+using namespace clang;
+using namespace std;
+
+QDateTimeElapsed::QDateTimeElapsed(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+}
+
+static Expr *skipCopies(Expr *expr)
+{
+    expr = expr->IgnoreImplicit();
+    if (auto constructExpr = dyn_cast<CXXConstructExpr>(expr)) {
+        CXXConstructorDecl *ctor = constructExpr->getConstructor();
+        if (constructExpr->getNumArgs() == 1 && ctor && ctor->isCopyOrMoveConstructor())
+            return constructExpr->getArg(0)->IgnoreImplicit();
+    }
+
+    return expr;
+}
+
+// Returns the QDateTime::current*() method expr reads the time from, directly or, if followVariables is true,
+// through a variable initialized with it
+static CXXMethodDecl *currentTimeMethod(Expr *expr, bool followVariables)
+{
+    if (!expr)
+        return nullptr;
+
+    expr = skipCopies(expr);
+    auto declRef = followVariables ? dyn_cast<DeclRefExpr>(expr) : nullptr;
+    if (declRef) {
+        auto varDecl = dyn_cast<VarDecl>(declRef->getDecl());
+        Expr *init = varDecl ? varDecl->getInit() : nullptr;
+        if (!init)
+            return nullptr;
+        expr = skipCopies(init);
+    }
+
+    auto call = dyn_cast<CallExpr>(expr);
+    auto method = call ? dyn_cast_or_null<CXXMethodDecl>(call->getDirectCallee()) : nullptr;
+    if (!method || !method->isStatic() || clazy::name(method->getParent()) != "QDateTime")
+        return nullptr;
+
+    const StringRef name = clazy::name(method);
+    if (name != "currentDateTime" && name != "currentDateTimeUtc" && name != "currentMSecsSinceEpoch" && name != "currentSecsSinceEpoch")
+        return nullptr;
+
+    return method;
+}
+
+static string elapsedWarning(CXXMethodDecl *method)
+{
+    const string name = clazy::name(method).str();
+    return "Measuring elapsed time with QDateTime::" + name + "() " + (name == "currentDateTime" ? "goes through time zone conversions and " : "")
+           + "isn't monotonic, use QElapsedTimer or std::chrono::steady_clock instead";
+}
+
+void QDateTimeElapsed::VisitStmt(clang::Stmt *stmt)
+{
+    // start.msecsTo(QDateTime::currentDateTime()), QDateTime::currentMSecsSinceEpoch() - start, and Qt 6's now - start
+    Expr *lhs = nullptr;
+    Expr *rhs = nullptr;
+    bool isComparison = false;
+    if (auto memberCall = dyn_cast<CXXMemberCallExpr>(stmt)) {
+        CXXMethodDecl *method = memberCall->getMethodDecl();
+        if (!method || clazy::name(method->getParent()) != "QDateTime" || memberCall->getNumArgs() != 1
+            || (clazy::name(method) != "msecsTo" && clazy::name(method) != "secsTo"))
+            return;
+        lhs = memberCall->getImplicitObjectArgument();
+        rhs = memberCall->getArg(0);
+    } else if (auto binaryOperator = dyn_cast<BinaryOperator>(stmt)) {
+        isComparison = binaryOperator->isRelationalOp();
+        if (binaryOperator->getOpcode() != BO_Sub && !isComparison)
+            return;
+        lhs = binaryOperator->getLHS();
+        rhs = binaryOperator->getRHS();
+    } else if (auto operatorCall = dyn_cast<CXXOperatorCallExpr>(stmt)) {
+        const OverloadedOperatorKind op = operatorCall->getOperator();
+        isComparison = op == OO_Less || op == OO_LessEqual || op == OO_Greater || op == OO_GreaterEqual;
+        if ((op != OO_Minus && !isComparison) || operatorCall->getNumArgs() != 2)
+            return;
+        lhs = operatorCall->getArg(0);
+        rhs = operatorCall->getArg(1);
+    } else {
+        return;
+    }
+
+    // Comparisons only poll when reading the clock right there, as in while (QDateTime::currentDateTime() < deadline)
+    CXXMethodDecl *lhsMethod = currentTimeMethod(lhs, !isComparison);
+    CXXMethodDecl *rhsMethod = currentTimeMethod(rhs, !isComparison);
+    if (isComparison) {
+        CXXMethodDecl *method = lhsMethod ? lhsMethod : rhsMethod;
+        if (method && clazy::isInLoop(m_context, stmt)) {
+            emitWarning(clazy::getLocStart(stmt), "Polling QDateTime::" + clazy::name(method).str()
+                        + "() in a loop isn't monotonic, use QDeadlineTimer or QElapsedTimer instead");
+        }
+        return;
+    }
+
+    // Subtracting other timestamps, like a file's modification time, is fine
+    if (lhsMethod && rhsMethod)
+        emitWarning(clazy::getLocStart(stmt), elapsedWarning(rhsMethod));
+}
@@ -0,0 +1,108 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#include "qdebug-in-loop.h"
+#include "ClazyContext.h"
+#include "HierarchyUtils.h"
+#include "QtUtils.h"
+#include "StringUtils.h"
+#include "SourceCompatibilityHelpers.h"
+
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/Type.h>
+#include <clang/Basic/LLVM.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+using namespace clang;
+using namespace std;
+
+QDebugInLoop::QDebugInLoop(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+}
+
+// Returns true if stmt calls QLoggingCategory::isDebugEnabled() or isInfoEnabled()
+static bool checksCategory(Stmt *stmt)
+{
+    if (!stmt)
+        return false;
+
+    if (auto memberCall = dyn_cast<CXXMemberCallExpr>(stmt)) {
+        CXXMethodDecl *method = memberCall->getMethodDecl();
+        if (method && clazy::name(method->getParent()) == "QLoggingCategory"
+            && (clazy::name(method) == "isDebugEnabled" || clazy::name(method) == "isInfoEnabled"))
+            return true;
+    }
+
+    for (Stmt *child : stmt->children()) {
+        if (checksCategory(child))
+            return true;
+    }
+
+    return false;
+}
+
+// Returns true if stmt only runs when an if checks a logging category first
+static bool isGuardedByCategory(const ClazyContext *context, Stmt *stmt)
+{
+    for (Stmt *parent = clazy::parent(context, stmt); parent; stmt = parent, parent = clazy::parent(context, parent)) {
+        auto ifStmt = dyn_cast<IfStmt>(parent);
+        if (ifStmt && ifStmt->getThen() == stmt && checksCategory(ifStmt->getCond()))
+            return true;
+    }
+
+    return false;
+}
+
+void QDebugInLoop::VisitStmt(clang::Stmt *stmt)
+{
+    const StmtFacts &facts = m_context->stmtFacts;
+    CXXMethodDecl *method = isa<CXXMemberCallExpr>(stmt) ? facts.method() : nullptr;
+    if (!method || facts.recordName() != "QMessageLogger")
+        return;
+
+    const StringRef methodName = clazy::name(method);
+    if (methodName != "debug" && methodName != "info")
+        return;
+
+    // qCDebug() and qCInfo() pass their category, the printf-like qDebug("...") and the stream one don't
+    if (method->getNumParams() > 0) {
+        const QualType firstParam = method->getParamDecl(0)->getType();
+        if (!firstParam->isPointerType() || !firstParam->getPointeeType()->isCharType())
+            return;
+    }
+
+    auto function = dyn_cast_or_null<CXXMethodDecl>(m_context->lastFunctionDecl);
+    const bool inHotMethod = function && clazy::isHotMethod(function);
+    const bool inLoop = facts.enclosingLoop() != nullptr;
+    if ((!inLoop && !inHotMethod) || isGuardedByCategory(m_context, stmt))
+        return;
+
+    const bool isDebug = methodName == "debug";
+    const string where = inLoop ? string("inside a loop") : "inside " + clazy::name(function).str() + "(), which is called very often,";
+    emitWarning(clazy::getLocStart(stmt), string(isDebug ? "qDebug() " : "qInfo() ") + where + " formats its output even if "
+                + (isDebug ? "debug" : "info") + " messages are filtered out, use " + (isDebug ? "qCDebug()" : "qCInfo()")
+                + " with a Q_LOGGING_CATEGORY instead");
+}
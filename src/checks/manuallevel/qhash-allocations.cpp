@@ -0,0 +1,183 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "qhash-allocations.h"
+#include "ClazyContext.h"
+#include "HierarchyUtils.h"
+#include "PreProcessorVisitor.h"
+#include "QtUtils.h"
+#include "StmtIndex.h"
+#include "StringUtils.h"
+#include "SourceCompatibilityHelpers.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/Type.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/OperatorKinds.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+using namespace clang;
+using namespace std;
+
+QHashAllocations::QHashAllocations(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes)
+{
+    context->enablePreprocessorVisitor();
+}
+
+// Returns the name to print if building the class allocates, an empty string otherwise
+static string allocatingClassName(const CXXRecordDecl *record, bool &isImplicitlyShared)
+{
+    if (!record)
+        return {};
+
+    const StringRef name = clazy::name(record);
+    isImplicitlyShared = !record->isInStdNamespace();
+    if (!isImplicitlyShared) {
+        static const clazy::NameSet stdContainers = { "vector", "deque", "list", "forward_list", "map", "multimap", "set",
+                                                      "multiset", "unordered_map", "unordered_multimap", "unordered_set",
+                                                      "unordered_multiset" };
+        if (name == "basic_string")
+            return "std::string";
+        return stdContainers.contains(name) ? "std::" + name.str() : string();
+    }
+
+    return name == "QString" || name == "QByteArray" || clazy::isQtContainer(record) ? name.str() : string();
+}
+
+static string allocatingClassName(QualType type, bool &isImplicitlyShared)
+{
+    return type.isNull() || type->isReferenceType() ? string() : allocatingClassName(type->getAsCXXRecordDecl(), isImplicitlyShared);
+}
+
+// Returns true if the call returns a new string or container. Returning Qt's implicitly shared classes by value only
+// allocates for calls which build a new one, getters just increment the reference count.
+static bool isAllocatingCall(CallExpr *call, string &className)
+{
+    FunctionDecl *func = call->getDirectCallee();
+    bool isImplicitlyShared = false;
+    className = func ? allocatingClassName(func->getReturnType(), isImplicitlyShared) : string();
+    if (className.empty())
+        return false;
+
+    if (!isImplicitlyShared)
+        return true;
+
+    // "prefix" + key.name, or key.name % key.id with QStringBuilder
+    const OverloadedOperatorKind op = func->getOverloadedOperator();
+    if (op == OO_Plus || op == OO_Percent)
+        return true;
+    if (auto conversion = dyn_cast<CXXConversionDecl>(func))
+        return clazy::name(conversion->getParent()) == "QStringBuilder";
+
+    static const clazy::NameSet allocatingMethods = { "arg", "number", "asprintf", "fromLatin1", "fromUtf8", "fromLocal8Bit",
+                                                      "toLower", "toUpper", "toCaseFolded", "toLatin1", "toUtf8",
+                                                      "toLocal8Bit", "toString", "trimmed", "simplified", "left", "right",
+                                                      "mid", "repeated", "split", "join" };
+    return clazy::functionIsOneOf(func, allocatingMethods);
+}
+
+// Returns a description of what expr allocates, or an empty string if it doesn't
+static string allocationDescription(Stmt *stmt)
+{
+    if (auto newExpr = dyn_cast<CXXNewExpr>(stmt))
+        return newExpr->getNumPlacementArgs() == 0 ? "calls new" : string();
+
+    string className;
+    if (auto ctorExpr = dyn_cast<CXXConstructExpr>(stmt)) {
+        CXXConstructorDecl *ctor = ctorExpr->getConstructor();
+        bool isImplicitlyShared = false;
+        className = ctor ? allocatingClassName(ctor->getParent(), isImplicitlyShared) : string();
+
+        // Copies of std containers and strings copy their contents, Qt's are implicitly shared
+        if (className.empty() || ctor->isDefaultConstructor() || ctor->isMoveConstructor()
+            || (ctor->isCopyConstructor() && isImplicitlyShared))
+            return {};
+
+        return (ctor->isCopyConstructor() ? "copies a " : "builds a ") + className;
+    }
+
+    auto call = dyn_cast<CallExpr>(stmt);
+    return call && isAllocatingCall(call, className) ? "builds a " + className : string();
+}
+
+// Returns the hashed type if func is a qHash() overload, std::hash<T>::operator() or the operator() of a hash functor
+static QualType hashedType(FunctionDecl *func, bool &isQHash)
+{
+    isQHash = !isa<CXXMethodDecl>(func);
+    if (isQHash)
+        return clazy::name(func) == "qHash" && func->getNumParams() > 0 ? func->getParamDecl(0)->getType() : QualType();
+
+    auto method = cast<CXXMethodDecl>(func);
+    if (method->getOverloadedOperator() != OO_Call || method->getNumParams() != 1 || !method->getReturnType()->isIntegerType())
+        return {};
+
+    // Hash functors passed to std::unordered_map, named like QStringHash or KeyHasher
+    const CXXRecordDecl *record = method->getParent();
+    const StringRef recordName = clazy::name(record);
+    if ((record->isInStdNamespace() && recordName == "hash") || recordName.endswith("Hash") || recordName.endswith("Hasher"))
+        return method->getParamDecl(0)->getType();
+
+    return {};
+}
+
+void QHashAllocations::VisitDecl(clang::Decl *decl)
+{
+    auto func = dyn_cast<FunctionDecl>(decl);
+    if (!func || !func->doesThisDeclarationHaveABody() || func->isTemplateInstantiation())
+        return;
+
+    bool isQHash = false;
+    const QualType type = hashedType(func, isQHash);
+    if (type.isNull() || shouldIgnoreFile(clazy::getLocStart(func)))
+        return;
+
+    Stmt *body = func->getBody();
+    const StmtIndex *index = m_context->functionStmtIndex(body);
+    for (Stmt *stmt : clazy::getStatements<Stmt>(index, body)) {
+        const string description = allocationDescription(stmt);
+        if (description.empty())
+            continue;
+
+        const string typeName = clazy::simpleTypeName(type, lo());
+        PreProcessorVisitor *preProcessorVisitor = m_context->preprocessorVisitor;
+        string message;
+        if (isQHash) {
+            message = "qHash(" + typeName + ") " + description + " on every insertion and lookup; ";
+            message += preProcessorVisitor && preProcessorVisitor->qtVersion() >= 60000
+                ? "hash the fields with qHashMulti() instead" : "combine the qHash() of each field instead";
+        } else {
+            message = "Hashing " + typeName + " " + description + " on every insertion and lookup; combine the hashes of each field instead";
+        }
+
+        // Copy initializations can be located at the variable, point at what's copied instead
+        auto ctorExpr = dyn_cast<CXXConstructExpr>(stmt);
+        const bool isCopy = ctorExpr && ctorExpr->getNumArgs() == 1 && ctorExpr->getConstructor()->isCopyConstructor();
+        emitWarning(clazy::getLocStart(isCopy ? ctorExpr->getArg(0) : stmt), message);
+        return;
+    }
+}
@@ -0,0 +1,69 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+
+#include "qimage-pixel-in-loop.h"
+#include "ClazyContext.h"
+#include "LoopUtils.h"
+#include "StringUtils.h"
+#include "SourceCompatibilityHelpers.h"
+
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/Basic/LLVM.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+using namespace clang;
+using namespace std;
+
+QImagePixelInLoop::QImagePixelInLoop(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+}
+
+void QImagePixelInLoop::VisitStmt(clang::Stmt *stmt)
+{
+    const StmtFacts &facts = m_context->stmtFacts;
+    CXXMethodDecl *method = facts.method();
+    if (!method || !isa<CXXMemberCallExpr>(stmt) || facts.recordName() != "QImage")
+        return;
+
+    const StringRef methodName = clazy::name(method);
+    const bool isSetter = methodName == "setPixel" || methodName == "setPixelColor";
+    if (!isSetter && methodName != "pixel" && methodName != "pixelColor")
+        return;
+
+    // A loop inside a loop, like over the rows and then the columns. A single loop usually only touches a few pixels.
+    Stmt *loop = facts.enclosingLoop();
+    if (!loop || !clazy::isInLoop(m_context, loop))
+        return;
+
+    if (isSetter) {
+        emitWarning(clazy::getLocStart(stmt), "QImage::" + methodName.str() + "() inside nested loops detaches, converts and bounds-checks"
+                    " each pixel, write whole rows through scanLine() instead, whose layout depends on the image's format()");
+    } else {
+        emitWarning(clazy::getLocStart(stmt), "QImage::" + methodName.str() + "() inside nested loops converts and bounds-checks each pixel,"
+                    " read whole rows through constScanLine() instead, whose layout depends on the image's format()");
+    }
+}
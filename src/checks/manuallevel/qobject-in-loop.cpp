@@ -0,0 +1,142 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "qobject-in-loop.h"
+#include "ClazyContext.h"
+#include "HierarchyUtils.h"
+#include "LoopUtils.h"
+#include "QtUtils.h"
+#include "StringUtils.h"
+#include "SourceCompatibilityHelpers.h"
+
+#include <clang/AST/ASTContext.h>
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/StmtCXX.h>
+#include <clang/AST/Type.h>
+#include <clang/Basic/LLVM.h>
+#include <llvm/Support/Casting.h>
+
+using namespace clang;
+using namespace std;
+
+// Loops with up to this many iterations are cheap enough to create a few objects or connections in
+static const uint64_t s_smallTripCount = 8;
+
+QObjectInLoop::QObjectInLoop(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+}
+
+static bool isSmallLiteral(const Expr *expr)
+{
+    auto literal = expr ? dyn_cast<IntegerLiteral>(expr->IgnoreParenImpCasts()) : nullptr;
+    return literal && literal->getValue().getActiveBits() <= 64 && literal->getValue().getZExtValue() <= s_smallTripCount;
+}
+
+// The i in for (int i = 3; i > 0; --i)
+static bool initializesWithSmallLiteral(ForStmt *forStmt)
+{
+    auto declStmt = dyn_cast_or_null<DeclStmt>(forStmt->getInit());
+    auto varDecl = declStmt && declStmt->isSingleDecl() ? dyn_cast<VarDecl>(declStmt->getSingleDecl()) : nullptr;
+    return varDecl && isSmallLiteral(varDecl->getInit());
+}
+
+// for (int i = 0; i < 3; ++i), for (auto x : { a, b }) and for (auto x : array) where array has a small constant size
+static bool hasSmallTripCount(Stmt *loop, const ASTContext &astContext)
+{
+    if (auto forStmt = dyn_cast<ForStmt>(loop)) {
+        auto binaryOp = dyn_cast_or_null<BinaryOperator>(forStmt->getCond());
+        if (!binaryOp)
+            return false;
+
+        switch (binaryOp->getOpcode()) {
+        case BO_LT:
+        case BO_LE:
+        case BO_NE:
+            return isSmallLiteral(binaryOp->getRHS());
+        case BO_GT:
+        case BO_GE:
+            return isSmallLiteral(binaryOp->getLHS()) || (isSmallLiteral(binaryOp->getRHS()) && initializesWithSmallLiteral(forStmt));
+        default:
+            return false;
+        }
+    }
+
+    auto rangeLoop = dyn_cast<CXXForRangeStmt>(loop);
+    Expr *rangeInit = rangeLoop ? rangeLoop->getRangeInit() : nullptr;
+    if (!rangeInit)
+        return false;
+
+    rangeInit = rangeInit->IgnoreImplicit();
+    if (auto initList = dyn_cast<CXXStdInitializerListExpr>(rangeInit))
+        rangeInit = initList->getSubExpr()->IgnoreImplicit();
+
+    if (auto initList = dyn_cast<InitListExpr>(rangeInit))
+        return initList->getNumInits() <= s_smallTripCount;
+
+    const ConstantArrayType *arrayType = astContext.getAsConstantArrayType(rangeInit->getType());
+    return arrayType && arrayType->getSize().getZExtValue() <= s_smallTripCount;
+}
+
+bool QObjectInLoop::isInLargeLoop(Stmt *stmt) const
+{
+    // Walk up by hand instead of using clazy::isInLoop(), as a lambda defined inside a loop doesn't run there
+    for (Stmt *parent = clazy::parent(m_context, stmt); parent; parent = clazy::parent(m_context, parent)) {
+        if (isa<LambdaExpr>(parent))
+            return false;
+
+        if (clazy::isLoop(parent) && !hasSmallTripCount(parent, *m_astContext))
+            return true;
+    }
+
+    return false;
+}
+
+void QObjectInLoop::VisitStmt(clang::Stmt *stmt)
+{
+    if (auto call = dyn_cast<CallExpr>(stmt)) {
+        FunctionDecl *func = call->getDirectCallee();
+        if (func && clazy::isConnect(func) && isInLargeLoop(stmt))
+            emitWarning(clazy::getLocStart(stmt), "connect() called on every iteration, each one allocates a connection; consider connecting once to a shared handler");
+        return;
+    }
+
+    CXXRecordDecl *record = nullptr;
+    if (auto newExpr = dyn_cast<CXXNewExpr>(stmt)) {
+        record = newExpr->getAllocatedType()->getAsCXXRecordDecl();
+    } else if (auto ctorExpr = dyn_cast<CXXConstructExpr>(stmt)) {
+        // new Foo() was already handled through the CXXNewExpr
+        Stmt *parent = clazy::parent(m_context, stmt);
+        if (parent && isa<CXXNewExpr>(parent))
+            return;
+        record = ctorExpr->getConstructor()->getParent();
+    }
+
+    if (!record || !clazy::isQObject(record) || !isInLargeLoop(stmt))
+        return;
+
+    emitWarning(clazy::getLocStart(stmt), string(clazy::name(record)) + " created on every iteration, each QObject allocates private data; consider a delegate or a single shared object");
+}
@@ -0,0 +1,216 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "qproperty-container-getter.h"
+#include "HierarchyUtils.h"
+#include "SourceCompatibilityHelpers.h"
+#include "StringUtils.h"
+#include "Utils.h"
+#include "clazy_stl.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/PrettyPrinter.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/Type.h>
+#include <clang/Basic/IdentifierTable.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/SourceManager.h>
+#include <clang/Lex/Lexer.h>
+#include <clang/Lex/Token.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+#include <algorithm>
+
+using namespace clang;
+using namespace std;
+
+QPropertyContainerGetter::QPropertyContainerGetter(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context)
+{
+    enablePreProcessorCallbacks(PreprocessorEvent_MacroExpands, { "Q_PROPERTY" });
+}
+
+// Containers which allocate and copy all their elements when returned by value
+static bool isDeepCopiedContainer(const CXXRecordDecl *record)
+{
+    static const clazy::NameSet stdContainers = { "vector", "list", "deque", "map", "multimap", "set", "multiset",
+                                                  "unordered_map", "unordered_multimap", "unordered_set", "unordered_multiset" };
+    if (record->isInStdNamespace())
+        return stdContainers.contains(clazy::name(record));
+
+    return clazy::name(record) == "QVarLengthArray";
+}
+
+// The implicitly shared ones, whose copy is cheap, unless it's a new one every time
+static bool isSharedContainer(const CXXRecordDecl *record)
+{
+    static const clazy::NameSet containers = { "QList", "QVector", "QStringList", "QMap", "QMultiMap", "QHash", "QMultiHash",
+                                               "QSet", "QStack", "QQueue", "QLinkedList", "QJsonArray", "QJsonObject" };
+    return containers.contains(clazy::name(record));
+}
+
+static const Expr *skipCopies(const Expr *expr)
+{
+    expr = expr->IgnoreImplicit();
+    while (auto construct = dyn_cast<CXXConstructExpr>(expr)) {
+        if (construct->getNumArgs() != 1 || !construct->getConstructor()->isCopyOrMoveConstructor())
+            break;
+        expr = construct->getArg(0)->IgnoreImplicit();
+    }
+
+    return expr->IgnoreParens();
+}
+
+// Returns true if the getter builds the container it returns, instead of returning one it keeps
+static bool isBuiltInGetter(Stmt *body, const Expr *expr)
+{
+    static const clazy::NameSet builders = { "keys", "values", "uniqueKeys", "toList", "toVector", "fromList", "fromVector",
+                                             "fromStdVector", "mid", "filter", "findChildren", "split" };
+
+    expr = skipCopies(expr);
+    if (isa<InitListExpr>(expr) || isa<CXXStdInitializerListExpr>(expr))
+        return true;
+
+    if (auto cast = dyn_cast<CXXFunctionalCastExpr>(expr))
+        return isBuiltInGetter(body, cast->getSubExpr());
+
+    // An empty one doesn't allocate, one converted from another container might not either
+    if (auto construct = dyn_cast<CXXConstructExpr>(expr)) {
+        if (construct->getNumArgs() == 1 && !construct->isListInitialization()
+            && construct->getArg(0)->getType()->getAsCXXRecordDecl())
+            return isBuiltInGetter(body, construct->getArg(0));
+        return construct->getNumArgs() > 0;
+    }
+
+    if (auto conditional = dyn_cast<ConditionalOperator>(expr))
+        return isBuiltInGetter(body, conditional->getTrueExpr()) || isBuiltInGetter(body, conditional->getFalseExpr());
+
+    if (auto call = dyn_cast<CallExpr>(expr)) {
+        if (auto op = dyn_cast<CXXOperatorCallExpr>(call))
+            return op->getOperator() == OO_Plus;
+
+        const FunctionDecl *callee = call->getDirectCallee();
+        return callee && builders.contains(clazy::name(callee));
+    }
+
+    // A local, filled by the getter, or a copy of something else which it then modifies
+    auto declRef = dyn_cast<DeclRefExpr>(expr);
+    auto var = declRef ? dyn_cast<VarDecl>(declRef->getDecl()) : nullptr;
+    if (!var || !var->hasLocalStorage() || isa<ParmVarDecl>(var) || var->getType()->isReferenceType())
+        return false;
+
+    const Expr *init = var->getInit() ? skipCopies(var->getInit()) : nullptr;
+    const bool copiesOther = init && (isa<DeclRefExpr>(init) || isa<MemberExpr>(init) || isa<CallExpr>(init))
+                             && !isBuiltInGetter(body, init);
+    return !copiesOther || Utils::containsNonConstMemberCall(nullptr, body, var);
+}
+
+void QPropertyContainerGetter::VisitDecl(clang::Decl *decl)
+{
+    auto method = dyn_cast<CXXMethodDecl>(decl);
+    if (!method || m_properties.empty() || method->getNumParams() != 0 || method->isDependentContext())
+        return;
+
+    const SourceRange classRange = method->getParent()->getSourceRange();
+    const StringRef methodName = clazy::name(method);
+    for (const Property &prop : m_properties) {
+        if (prop.read == methodName && classRange.getBegin() < prop.loc && prop.loc < classRange.getEnd()) {
+            checkGetter(method, prop.name);
+            return;
+        }
+    }
+}
+
+void QPropertyContainerGetter::checkGetter(const CXXMethodDecl *method, const std::string &propertyName)
+{
+    const QualType returnType = method->getReturnType();
+    const CXXRecordDecl *record = returnType->getAsCXXRecordDecl();
+    if (!record || returnType->isReferenceType())
+        return;
+
+    PrintingPolicy policy(lo());
+    policy.SuppressTagKeyword = true;
+    const string typeName = returnType.getUnqualifiedType().getAsString(policy);
+    const string methodName = method->getNameAsString();
+
+    // Warned about once, at the declaration. Whatever the body does, the caller gets a copy.
+    if (isDeepCopiedContainer(record)) {
+        if (method->isFirstDecl())
+            emitFormattedWarning(method->getLocation(), "READ accessor %0() of Q_PROPERTY %1 copies a %2 every time a QML binding "
+                                 "reads it; cache it in an implicitly shared container, or use a QQmlListProperty or a QAbstractListModel",
+                                 { methodName, propertyName, typeName });
+        return;
+    }
+
+    Stmt *body = method->hasBody() && method->isThisDeclarationADefinition() ? method->getBody() : nullptr;
+    if (!body || !isSharedContainer(record))
+        return;
+
+    for (ReturnStmt *ret : clazy::getStatements<ReturnStmt>(body)) {
+        const Expr *value = ret->getRetValue();
+        if (value && isBuiltInGetter(body, value)) {
+            emitFormattedWarning(clazy::getLocStart(ret), "READ accessor %0() of Q_PROPERTY %1 builds a new %2 every time a "
+                                 "QML binding reads it; cache it in a member, or use a QQmlListProperty or a QAbstractListModel",
+                                 { methodName, propertyName, typeName });
+            return;
+        }
+    }
+}
+
+void QPropertyContainerGetter::VisitMacroExpands(const clang::Token &macroNameTok, const clang::SourceRange &range, const MacroInfo *)
+{
+    IdentifierInfo *ii = macroNameTok.getIdentifierInfo();
+    if (!ii || ii->getName() != "Q_PROPERTY" || sm().isInSystemHeader(range.getBegin()))
+        return;
+
+    CharSourceRange crange = Lexer::getAsCharRange(range, sm(), lo());
+    string text = Lexer::getSourceText(crange, sm(), lo()).str();
+    if (!text.empty() && text.back() == ')')
+        text.pop_back();
+
+    // Q_PROPERTY(<type> <name> READ <getter> ...), as qproperty-type-mismatch parses it
+    vector<string> split = clazy::splitString(text, ' ');
+    if (split.size() < 4)
+        return;
+
+    Property p;
+    p.loc = range.getBegin();
+    p.name = split[1];
+    clazy::rtrim(p.name);
+    p.name.erase(std::remove(p.name.begin(), p.name.end(), '*'), p.name.end());
+
+    for (size_t i = 2; i + 1 < split.size(); ++i) {
+        clazy::rtrim(split[i]);
+        if (split[i] == "READ") {
+            p.read = split[i + 1];
+            clazy::rtrim(p.read);
+            break;
+        }
+    }
+
+    if (!p.read.empty())
+        m_properties.push_back(std::move(p));
+}
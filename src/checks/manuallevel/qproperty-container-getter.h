@@ -0,0 +1,69 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_QPROPERTY_CONTAINER_GETTER_H
+#define CLAZY_QPROPERTY_CONTAINER_GETTER_H
+
+#include "checkbase.h"
+
+#include <clang/Basic/SourceLocation.h>
+
+#include <string>
+#include <vector>
+
+class ClazyContext;
+
+namespace clang {
+class CXXMethodDecl;
+class Decl;
+class MacroInfo;
+class Token;
+}
+
+/**
+ * Finds the READ accessors of Q_PROPERTYs which copy a container that isn't implicitly shared, or build a new one,
+ * every time a QML binding reads the property.
+ *
+ * See README-qproperty-container-getter.md for more info.
+ */
+class QPropertyContainerGetter
+    : public CheckBase
+{
+public:
+    explicit QPropertyContainerGetter(const std::string &name, ClazyContext *context);
+    void VisitDecl(clang::Decl *decl) override;
+private:
+    void VisitMacroExpands(const clang::Token &macroNameTok,
+                           const clang::SourceRange &range, const clang::MacroInfo *minfo = nullptr) override;
+    void checkGetter(const clang::CXXMethodDecl *method, const std::string &propertyName);
+
+    struct Property
+    {
+        clang::SourceLocation loc;
+        std::string name;
+        std::string read;
+    };
+
+    std::vector<Property> m_properties;
+};
+
+#endif
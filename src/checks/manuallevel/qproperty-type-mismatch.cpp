@@ -55,7 +55,7 @@ using namespace std;
 QPropertyTypeMismatch::QPropertyTypeMismatch(const std::string &name, ClazyContext *context)
     : CheckBase(name, context)
 {
-    enablePreProcessorCallbacks();
+    enablePreProcessorCallbacks(PreprocessorEvent_MacroExpands, { "Q_PROPERTY" });
     context->enableVisitallTypeDefs();
 }
 
@@ -32,7 +32,7 @@ using namespace std;
 
 
 QRequiredResultCandidates::QRequiredResultCandidates(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context)
+    : CheckBase(name, context, Option_Reusable)
 {
 }
 
@@ -0,0 +1,175 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "qstring-split-single-use.h"
+#include "ClazyContext.h"
+#include "HierarchyUtils.h"
+#include "PreProcessorVisitor.h"
+#include "StmtIndex.h"
+#include "StringUtils.h"
+#include "SourceCompatibilityHelpers.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/OperatorKinds.h>
+#include <clang/Basic/SourceLocation.h>
+#include <llvm/Support/Casting.h>
+
+using namespace clang;
+using namespace std;
+
+enum SplitUse {
+    SplitUse_Other = 0,
+    SplitUse_First = 1,
+    SplitUse_Last = 2,
+    SplitUse_Count = 4
+};
+
+QStringSplitSingleUse::QStringSplitSingleUse(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes)
+{
+    context->enablePreprocessorVisitor();
+}
+
+static bool isZero(Expr *expr)
+{
+    auto literal = expr ? dyn_cast<IntegerLiteral>(expr->IgnoreImpCasts()) : nullptr;
+    return literal && literal->getValue() == 0;
+}
+
+static bool isImplicitNode(Stmt *stmt)
+{
+    if (auto construct = dyn_cast<CXXConstructExpr>(stmt))
+        return construct->isElidable(); // The copy of the list into a local, before C++17
+
+    return isa<ImplicitCastExpr>(stmt) || isa<MaterializeTemporaryExpr>(stmt) || isa<CXXBindTemporaryExpr>(stmt)
+        || isa<ExprWithCleanups>(stmt) || isa<ParenExpr>(stmt);
+}
+
+// Returns how the list is used by its parent, one of SplitUse
+int QStringSplitSingleUse::classifyUse(Stmt *list) const
+{
+    Stmt *child = list;
+    Stmt *parent = clazy::parent(m_context, list);
+    while (parent && isImplicitNode(parent)) {
+        child = parent;
+        parent = clazy::parent(m_context, parent);
+    }
+
+    // list[0]
+    if (auto op = dyn_cast_or_null<CXXOperatorCallExpr>(parent))
+        return op->getOperator() == OO_Subscript && op->getNumArgs() == 2 && op->getArg(0) == child && isZero(op->getArg(1))
+            ? SplitUse_First : SplitUse_Other;
+
+    auto memberExpr = dyn_cast_or_null<MemberExpr>(parent);
+    auto call = memberExpr ? dyn_cast_or_null<CXXMemberCallExpr>(clazy::parent(m_context, memberExpr)) : nullptr;
+    CXXMethodDecl *method = call && call->getCallee() == memberExpr ? call->getMethodDecl() : nullptr;
+    if (!method)
+        return SplitUse_Other;
+
+    static const clazy::NameSet firstMethods = { "first", "constFirst", "front" };
+    static const clazy::NameSet lastMethods = { "last", "constLast", "back" };
+    static const clazy::NameSet countMethods = { "size", "count", "length", "isEmpty" };
+    const unsigned int numArgs = call->getNumArgs();
+    if (numArgs == 0 && clazy::functionIsOneOf(method, firstMethods))
+        return SplitUse_First;
+    if (numArgs == 0 && clazy::functionIsOneOf(method, lastMethods))
+        return SplitUse_Last;
+    if (numArgs == 0 && clazy::functionIsOneOf(method, countMethods))
+        return SplitUse_Count;
+
+    const StringRef name = clazy::name(method);
+    return numArgs == 1 && (name == "at" || name == "value") && isZero(call->getArg(0)) ? SplitUse_First : SplitUse_Other;
+}
+
+// Returns the uses of the local the list was stored in, or SplitUse_Other if any use needs the list
+int QStringSplitSingleUse::classifyVariableUses(VarDecl *varDecl, Stmt *scope) const
+{
+    int uses = SplitUse_Other;
+    for (DeclRefExpr *declRef : clazy::getStatements<DeclRefExpr>(m_context->functionStmtIndex(scope), scope)) {
+        if (declRef->getDecl() != varDecl)
+            continue;
+
+        const int use = classifyUse(declRef);
+        if (use == SplitUse_Other)
+            return SplitUse_Other;
+        uses |= use;
+    }
+
+    return uses;
+}
+
+void QStringSplitSingleUse::VisitStmt(clang::Stmt *stmt)
+{
+    auto splitCall = dyn_cast<CXXMemberCallExpr>(stmt);
+    CXXMethodDecl *method = splitCall ? splitCall->getMethodDecl() : nullptr;
+    if (!method || clazy::name(method) != "split" || !clazy::qualifiedNameIs(method->getParent(), "QString"))
+        return;
+
+    auto memberExpr = dyn_cast<MemberExpr>(splitCall->getCallee());
+    if (!memberExpr || memberExpr->getMemberLoc().isMacroID())
+        return;
+
+    int uses = classifyUse(splitCall);
+    if (uses == SplitUse_Other) {
+        // const QStringList parts = str.split(sep), only used as parts.first()
+        Stmt *parent = clazy::parent(m_context, splitCall);
+        while (parent && isImplicitNode(parent))
+            parent = clazy::parent(m_context, parent);
+
+        auto declStmt = dyn_cast_or_null<DeclStmt>(parent);
+        auto varDecl = declStmt && declStmt->isSingleDecl() ? dyn_cast<VarDecl>(declStmt->getSingleDecl()) : nullptr;
+        Stmt *scope = declStmt ? clazy::parent(m_context, declStmt) : nullptr;
+        if (!varDecl || !scope || !varDecl->isLocalVarDecl() || varDecl->isStaticLocal() || varDecl->getType()->isReferenceType())
+            return;
+
+        uses = classifyVariableUses(varDecl, scope);
+        if (uses == SplitUse_Other)
+            return;
+    }
+
+    string message = "split() allocates a QStringList and a QString per part, only to ";
+    switch (uses) {
+    case SplitUse_First:
+        message += "take the first one; use indexOf() and left(), or section()";
+        break;
+    case SplitUse_Last:
+        message += "take the last one; use lastIndexOf() and mid(), or section() with a negative index";
+        break;
+    case SplitUse_Count:
+        message += "count them; use count() with the separator";
+        break;
+    default:
+        message += "take one and count them; use indexOf() based slicing, section() or count()";
+        break;
+    }
+
+    PreProcessorVisitor *preProcessorVisitor = m_context->preprocessorVisitor;
+    if (preProcessorVisitor && preProcessorVisitor->qtVersion() >= 60000)
+        message += ", or QStringView::tokenize(), which doesn't allocate";
+
+    emitWarning(memberExpr->getMemberLoc(), message);
+}
@@ -0,0 +1,54 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_QSTRING_SPLIT_SINGLE_USE_H
+#define CLAZY_QSTRING_SPLIT_SINGLE_USE_H
+
+#include "checkbase.h"
+
+#include <string>
+
+class ClazyContext;
+
+namespace clang {
+class Expr;
+class Stmt;
+class VarDecl;
+}
+
+/**
+ * Finds QString::split() calls whose list is only used for its first or last part, or its size.
+ *
+ * See README-qstring-split-single-use.md for more info.
+ */
+class QStringSplitSingleUse
+    : public CheckBase
+{
+public:
+    explicit QStringSplitSingleUse(const std::string &name, ClazyContext *context);
+    void VisitStmt(clang::Stmt *stmt) override;
+private:
+    int classifyUse(clang::Stmt *list) const;
+    int classifyVariableUses(clang::VarDecl *varDecl, clang::Stmt *scope) const;
+};
+
+#endif
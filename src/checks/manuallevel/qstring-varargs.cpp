@@ -39,7 +39,7 @@ using namespace std;
 
 
 QStringVarargs::QStringVarargs(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
 {
 }
 
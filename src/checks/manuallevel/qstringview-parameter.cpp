@@ -0,0 +1,272 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "qstringview-parameter.h"
+#include "AccessSpecifierManager.h"
+#include "ClazyContext.h"
+#include "HierarchyUtils.h"
+#include "PreProcessorVisitor.h"
+#include "StmtIndex.h"
+#include "StringUtils.h"
+#include "TypeUtils.h"
+#include "SourceCompatibilityHelpers.h"
+#include "Utils.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/RecursiveASTVisitor.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/Type.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/OperatorKinds.h>
+#include <clang/Basic/SourceLocation.h>
+#include <clang/Basic/SourceManager.h>
+#include <llvm/Support/Casting.h>
+
+#include <vector>
+
+using namespace clang;
+using namespace std;
+
+static bool isConstQStringRef(QualType type)
+{
+    if (!type->isLValueReferenceType())
+        return false;
+
+    const QualType pointee = type->getPointeeType();
+    return pointee.isConstQualified() && clazy::qualifiedNameIs(pointee->getAsCXXRecordDecl(), "QString");
+}
+
+// "foo" and QLatin1String("foo") are converted into a temporary QString, QStringLiteral("foo") already is one
+static bool allocatesFromLiteral(Expr *arg)
+{
+    auto construct = dyn_cast<CXXConstructExpr>(arg->IgnoreImplicit());
+    CXXConstructorDecl *ctor = construct ? construct->getConstructor() : nullptr;
+    if (!ctor || ctor->getNumParams() == 0 || !clazy::qualifiedNameIs(ctor->getParent(), "QString"))
+        return false;
+
+    // Not QString(const QChar *, int) nor Qt 6's QStringLiteral, which constructs from the static data
+    static const clazy::NameSet latin1Classes = { "QLatin1String", "QLatin1StringView" };
+    const QualType paramType = clazy::unrefQualType(ctor->getParamDecl(0)->getType());
+    const bool fromLatin1 = paramType->isPointerType() ? paramType->getPointeeType()->isCharType()
+                                                       : clazy::classIsOneOf(paramType->getAsCXXRecordDecl(), latin1Classes);
+
+    return fromLatin1 && Utils::containsStringLiteral(construct, /*allowEmpty=*/ true);
+}
+
+class CallSiteVisitor
+    : public RecursiveASTVisitor<CallSiteVisitor>
+{
+public:
+    CallSiteVisitor(const SourceManager &sm,
+                    llvm::DenseMap<std::pair<const FunctionDecl *, unsigned int>, unsigned int> &literalArguments,
+                    llvm::DenseSet<const FunctionDecl *> &notOnlyCalled)
+        : m_sm(sm)
+        , m_literalArguments(literalArguments)
+        , m_notOnlyCalled(notOnlyCalled)
+    {
+    }
+
+    bool TraverseDecl(Decl *decl)
+    {
+        // Only main file callers are counted, which is what keeps this cheap
+        if (decl && !isa<TranslationUnitDecl>(decl) && !m_sm.isInMainFile(m_sm.getExpansionLoc(decl->getLocation())))
+            return true;
+
+        return RecursiveASTVisitor<CallSiteVisitor>::TraverseDecl(decl);
+    }
+
+    bool VisitCallExpr(CallExpr *call)
+    {
+        FunctionDecl *callee = call->getDirectCallee();
+        if (!callee || isa<CXXOperatorCallExpr>(call))
+            return true;
+
+        if (auto declRef = dyn_cast<DeclRefExpr>(call->getCallee()->IgnoreImpCasts()))
+            m_calleeRefs.insert(declRef);
+
+        countArguments(callee, call->getArgs(), call->getNumArgs());
+        return true;
+    }
+
+    bool VisitCXXConstructExpr(CXXConstructExpr *construct)
+    {
+        if (CXXConstructorDecl *ctor = construct->getConstructor())
+            countArguments(ctor, construct->getArgs(), construct->getNumArgs());
+        return true;
+    }
+
+    bool VisitDeclRefExpr(DeclRefExpr *declRef)
+    {
+        // Parents are visited first, so calls were already handled. Methods are only called through a MemberExpr.
+        auto func = dyn_cast<FunctionDecl>(declRef->getDecl());
+        if (func && !m_calleeRefs.count(declRef))
+            m_notOnlyCalled.insert(func->getCanonicalDecl());
+        return true;
+    }
+
+private:
+    void countArguments(FunctionDecl *callee, Expr **args, unsigned int numArgs)
+    {
+        const unsigned int numParams = callee->getNumParams();
+        for (unsigned int i = 0; i < numArgs && i < numParams; ++i) {
+            if (isConstQStringRef(callee->getParamDecl(i)->getType()) && allocatesFromLiteral(args[i]))
+                m_literalArguments[{ callee->getCanonicalDecl(), i }]++;
+        }
+    }
+
+    const SourceManager &m_sm;
+    llvm::DenseMap<std::pair<const FunctionDecl *, unsigned int>, unsigned int> &m_literalArguments;
+    llvm::DenseSet<const FunctionDecl *> &m_notOnlyCalled;
+    llvm::DenseSet<const DeclRefExpr *> m_calleeRefs;
+};
+
+QStringviewParameter::QStringviewParameter(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes)
+{
+    context->enableAccessSpecifierManager();
+    context->enablePreprocessorVisitor();
+}
+
+bool QStringviewParameter::isLookupOnlyUse(DeclRefExpr *declRef) const
+{
+    Stmt *child = declRef;
+    Stmt *parent = clazy::parent(m_context, declRef);
+    while (parent && (isa<ImplicitCastExpr>(parent) || isa<ParenExpr>(parent) || isa<MaterializeTemporaryExpr>(parent))) {
+        child = parent;
+        parent = clazy::parent(m_context, parent);
+    }
+
+    if (!parent)
+        return false;
+
+    // The methods QStringView has too, and QString has overloads for taking one
+    static const clazy::NameSet lookupMethods = { "startsWith", "endsWith", "contains", "indexOf", "lastIndexOf",
+                                                  "compare", "isEmpty", "isNull", "size", "length" };
+
+    // param.startsWith(...)
+    if (auto memberExpr = dyn_cast<MemberExpr>(parent)) {
+        auto call = dyn_cast_or_null<CXXMemberCallExpr>(clazy::parent(m_context, memberExpr));
+        return call && call->getCallee() == memberExpr && clazy::functionIsOneOf(call->getMethodDecl(), lookupMethods);
+    }
+
+    // str.startsWith(param)
+    if (auto call = dyn_cast<CXXMemberCallExpr>(parent)) {
+        return child != call->getCallee() && clazy::functionIsOneOf(call->getMethodDecl(), lookupMethods)
+            && clazy::qualifiedNameIs(call->getRecordDecl(), "QString");
+    }
+
+    // param == other
+    if (auto op = dyn_cast<CXXOperatorCallExpr>(parent)) {
+        switch (op->getOperator()) {
+        case OO_EqualEqual:
+        case OO_ExclaimEqual:
+        case OO_Less:
+        case OO_LessEqual:
+        case OO_Greater:
+        case OO_GreaterEqual:
+            return child != op->getCallee();
+        default:
+            return false;
+        }
+    }
+
+    // qHash(param)
+    auto call = dyn_cast<CallExpr>(parent);
+    FunctionDecl *callee = call ? call->getDirectCallee() : nullptr;
+    return callee && child != call->getCallee() && clazy::name(callee) == "qHash";
+}
+
+void QStringviewParameter::countCallSites()
+{
+    if (m_countedCallSites)
+        return;
+
+    m_countedCallSites = true;
+    CallSiteVisitor visitor(sm(), m_literalArguments, m_notOnlyCalled);
+    visitor.TraverseDecl(m_astContext->getTranslationUnitDecl());
+}
+
+void QStringviewParameter::VisitDecl(Decl *decl)
+{
+    auto func = dyn_cast<FunctionDecl>(decl);
+    if (!func || !func->doesThisDeclarationHaveABody() || func->isDependentContext() || func->isTemplateInstantiation()
+        || func->isOverloadedOperator() || clazy::getLocStart(func).isMacroID())
+        return;
+
+    // Changing the signature of virtual methods, slots and invokables breaks their overrides and connections
+    auto method = dyn_cast<CXXMethodDecl>(func);
+    if (method && (method->isVirtual() || method->getParent()->isLambda()))
+        return;
+
+    AccessSpecifierManager *accessSpecifierManager = m_context->accessSpecifierManager;
+    if (method && accessSpecifierManager && accessSpecifierManager->qtAccessSpecifierType(method) != QtAccessSpecifier_None)
+        return;
+
+    Stmt *body = func->getBody();
+    vector<DeclRefExpr *> declRefs;
+    auto ctor = dyn_cast<CXXConstructorDecl>(func);
+    for (unsigned int i = 0; i < func->getNumParams(); ++i) {
+        ParmVarDecl *param = func->getParamDecl(i);
+        if (!param->getIdentifier() || !isConstQStringRef(param->getType()))
+            continue;
+
+        if (ctor && !Utils::ctorInitializer(ctor, param).empty())
+            continue;
+
+        if (declRefs.empty())
+            declRefs = clazy::getStatements<DeclRefExpr>(m_context->functionStmtIndex(body), body);
+
+        bool isUsed = false;
+        bool isLookupOnly = true;
+        for (DeclRefExpr *declRef : declRefs) {
+            if (declRef->getDecl() != param)
+                continue;
+
+            isUsed = true;
+            if (!isLookupOnlyUse(declRef)) {
+                isLookupOnly = false;
+                break;
+            }
+        }
+
+        if (!isUsed || !isLookupOnly)
+            continue;
+
+        countCallSites();
+        if (m_notOnlyCalled.count(func->getCanonicalDecl()))
+            return;
+
+        const int qtVersion = m_context->preprocessorVisitor ? m_context->preprocessorVisitor->qtVersion() : -1;
+        string message = clazy::name(param).str() + " is only compared or searched; "
+            + (qtVersion >= 60000 ? "take a QStringView" : "add a QLatin1String overload, or take a QStringView,")
+            + " so callers don't allocate a QString";
+
+        auto it = m_literalArguments.find({ func->getCanonicalDecl(), i });
+        if (it != m_literalArguments.end())
+            message += " (" + std::to_string(it->second) + (it->second == 1 ? " call passes" : " calls pass") + " a literal in this file)";
+
+        emitWarning(clazy::getLocStart(param), message);
+    }
+}
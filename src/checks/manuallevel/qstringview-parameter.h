@@ -0,0 +1,64 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_QSTRINGVIEW_PARAMETER_H
+#define CLAZY_QSTRINGVIEW_PARAMETER_H
+
+#include "checkbase.h"
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/DenseSet.h>
+
+#include <string>
+#include <utility>
+
+class ClazyContext;
+
+namespace clang {
+class Decl;
+class DeclRefExpr;
+class FunctionDecl;
+}
+
+/**
+ * Finds const QString & parameters which are only compared or searched, so callers passing literals
+ * allocate a QString for nothing.
+ *
+ * See README-qstringview-parameter.md for more info.
+ */
+class QStringviewParameter
+    : public CheckBase
+{
+public:
+    explicit QStringviewParameter(const std::string &name, ClazyContext *context);
+    void VisitDecl(clang::Decl *decl) override;
+private:
+    bool isLookupOnlyUse(clang::DeclRefExpr *declRef) const;
+    void countCallSites();
+
+    // Built by the first countCallSites() call, for the calls in the main file
+    bool m_countedCallSites = false;
+    llvm::DenseMap<std::pair<const clang::FunctionDecl *, unsigned int>, unsigned int> m_literalArguments;
+    llvm::DenseSet<const clang::FunctionDecl *> m_notOnlyCalled; // Their address is taken, so the signature can't change
+};
+
+#endif
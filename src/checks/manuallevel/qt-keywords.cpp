@@ -42,7 +42,7 @@ using namespace std;
 QtKeywords::QtKeywords(const std::string &name, ClazyContext *context)
     : CheckBase(name, context)
 {
-    enablePreProcessorCallbacks();
+    enablePreProcessorCallbacks(PreprocessorEvent_MacroExpands);
     context->enablePreprocessorVisitor();
 }
 
@@ -47,7 +47,7 @@ using namespace clang;
 using namespace std;
 
 Qt4QStringFromArray::Qt4QStringFromArray(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
 {
 }
 
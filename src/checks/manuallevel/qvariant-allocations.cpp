@@ -0,0 +1,139 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "qvariant-allocations.h"
+#include "ClazyContext.h"
+#include "LoopUtils.h"
+#include "PreProcessorVisitor.h"
+#include "StringUtils.h"
+#include "TemplateUtils.h"
+#include "TypeUtils.h"
+#include "SourceCompatibilityHelpers.h"
+
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/Type.h>
+#include <clang/Basic/LLVM.h>
+#include <llvm/Support/Casting.h>
+
+#include <vector>
+
+using namespace clang;
+using namespace std;
+
+QVariantAllocations::QVariantAllocations(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+    context->enablePreprocessorVisitor(); // Qt 6 has a bigger inline storage
+}
+
+// Returns true for QAbstractItemModel::data() and setData() and their overrides
+static bool isModelDataMethod(const CXXMethodDecl *method)
+{
+    const StringRef methodName = clazy::name(method);
+    if (methodName != "data" && methodName != "setData")
+        return false;
+
+    if (clazy::name(method->getParent()) == "QAbstractItemModel")
+        return true;
+
+    for (const CXXMethodDecl *overridden : method->overridden_methods()) {
+        if (isModelDataMethod(overridden))
+            return true;
+    }
+
+    return false;
+}
+
+// Returns the type the QVariant is created from, or a null type if stmt doesn't create one
+static QualType heldType(Stmt *stmt)
+{
+    if (auto ctorExpr = dyn_cast<CXXConstructExpr>(stmt)) {
+        CXXConstructorDecl *ctor = ctorExpr->getConstructor();
+        if (!ctor || ctor->getNumParams() != 1 || ctor->isCopyOrMoveConstructor()
+            || clazy::name(ctor->getParent()) != "QVariant")
+            return {};
+
+        // Stored as a QString
+        const QualType paramType = clazy::unrefQualType(ctor->getParamDecl(0)->getType());
+        const CXXRecordDecl *record = paramType->getAsCXXRecordDecl();
+        return record && clazy::name(record) == "QLatin1String" ? QualType() : paramType;
+    }
+
+    auto call = dyn_cast<CallExpr>(stmt);
+    auto method = call ? dyn_cast_or_null<CXXMethodDecl>(call->getDirectCallee()) : nullptr;
+    if (!method || !clazy::name(method->getParent()).equals("QVariant"))
+        return {};
+
+    const StringRef methodName = clazy::name(method);
+    if (methodName != "fromValue" && methodName != "setValue")
+        return {};
+
+    vector<QualType> typeList = clazy::getTemplateArgumentsTypes(method);
+    return typeList.empty() ? QualType() : typeList[0];
+}
+
+// The number of bytes a QVariant stores without allocating
+int QVariantAllocations::inlineStorageSize(QualType type) const
+{
+    const int pointerSize = clazy::sizeOfPointer(m_astContext, type) / 8;
+    const int qtVersion = m_context->preprocessorVisitor ? m_context->preprocessorVisitor->qtVersion() : -1;
+    if (qtVersion >= 60000)
+        return 3 * pointerSize;
+
+    // Qt 5's union holds a pointer or a qlonglong/double
+    return pointerSize > 8 ? pointerSize : 8;
+}
+
+void QVariantAllocations::VisitStmt(clang::Stmt *stmt)
+{
+    QualType type = heldType(stmt);
+    const Type *t = type.getTypePtrOrNull();
+    if (!t || t->isDependentType() || t->isPointerType() || t->isIntegralOrEnumerationType() || t->isFloatingType())
+        return;
+
+    clazy::QualTypeClassification classification;
+    if (!clazy::classifyQualType(m_context, type, nullptr, classification))
+        return;
+
+    const int inlineSize = inlineStorageSize(type);
+    if (classification.size_of_T <= inlineSize)
+        return;
+
+    auto method = dyn_cast_or_null<CXXMethodDecl>(m_context->lastFunctionDecl);
+    const bool inModelData = method && isModelDataMethod(method);
+    const bool inLoop = clazy::isInLoop(m_context, stmt) != nullptr;
+    if (!inModelData && !inLoop)
+        return;
+
+    string msg = "QVariant holding " + clazy::simpleTypeName(type, lo()) + " allocates " + to_string(classification.size_of_T)
+                 + " bytes on the heap, only " + to_string(inlineSize) + " fit inline";
+    if (inLoop)
+        msg += ", create it once outside the loop if it doesn't change";
+    else
+        msg += ", inside " + clazy::name(method).str() + (clazy::name(method) == "data" ? "(), which is called very often" : "()")
+               + ", consider caching the QVariant in a member";
+
+    emitWarning(clazy::getLocStart(stmt), msg);
+}
@@ -0,0 +1,341 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "qvariantmap-as-struct.h"
+#include "ClazyContext.h"
+#include "HierarchyUtils.h"
+#include "LoopUtils.h"
+#include "MacroUtils.h"
+#include "QtUtils.h"
+#include "StmtIndex.h"
+#include "StringUtils.h"
+#include "SourceCompatibilityHelpers.h"
+
+#include <clang/AST/ASTContext.h>
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/DeclTemplate.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/RecursiveASTVisitor.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/TemplateBase.h>
+#include <clang/AST/Type.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/OperatorKinds.h>
+#include <clang/Basic/SourceLocation.h>
+#include <clang/Basic/SourceManager.h>
+#include <llvm/ADT/DenseSet.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+#include <algorithm>
+#include <cstdint>
+
+using namespace clang;
+using namespace std;
+
+// Returns "QVariantMap" or "QVariantHash" if record is QMap<QString, QVariant> or QHash<QString, QVariant>, nullptr otherwise
+static const char *variantMapName(const CXXRecordDecl *record)
+{
+    auto specialization = dyn_cast_or_null<ClassTemplateSpecializationDecl>(record);
+    if (!specialization)
+        return nullptr;
+
+    const StringRef name = clazy::name(specialization);
+    if (name != "QMap" && name != "QHash")
+        return nullptr;
+
+    const TemplateArgumentList &args = specialization->getTemplateArgs();
+    if (args.size() != 2 || args[0].getKind() != TemplateArgument::Type || args[1].getKind() != TemplateArgument::Type
+        || !clazy::qualifiedNameIs(args[0].getAsType()->getAsCXXRecordDecl(), "QString")
+        || !clazy::qualifiedNameIs(args[1].getAsType()->getAsCXXRecordDecl(), "QVariant"))
+        return nullptr;
+
+    return name == "QMap" ? "QVariantMap" : "QVariantHash";
+}
+
+static string literalText(const StringLiteral *literal)
+{
+    if (literal->getCharByteWidth() == 1)
+        return literal->getString().str();
+
+    // QStringLiteral's u"" literals, keys are ASCII
+    string text;
+    for (unsigned int i = 0; i < literal->getLength(); ++i) {
+        const uint32_t c = literal->getCodeUnit(i);
+        if (c == 0 || c > 127)
+            return {};
+        text += static_cast<char>(c);
+    }
+
+    return text;
+}
+
+// Returns true if expr only converts a string literal, as "foo" and QLatin1String("foo") do
+static bool isConvertedLiteral(Stmt *stmt)
+{
+    if (isa<StringLiteral>(stmt))
+        return true;
+
+    if (!isa<CXXConstructExpr>(stmt) && !isa<ImplicitCastExpr>(stmt) && !isa<CXXFunctionalCastExpr>(stmt)
+        && !isa<MaterializeTemporaryExpr>(stmt) && !isa<CXXBindTemporaryExpr>(stmt) && !isa<ExprWithCleanups>(stmt)
+        && !isa<ParenExpr>(stmt))
+        return false;
+
+    return std::all_of(stmt->child_begin(), stmt->child_end(), [](Stmt *child) { return child && isConvertedLiteral(child); });
+}
+
+// Returns the key if it's "foo", QStringLiteral("foo") or QLatin1String("foo"), an empty string otherwise
+static string literalKey(const ASTContext *astContext, Expr *key)
+{
+    if (!key)
+        return {};
+
+    key = key->IgnoreImplicit();
+
+    // Its string is built inside a lambda or from static data, depending on the Qt version
+    const bool isQStringLiteral = clazy::isInMacro(astContext, clazy::getLocStart(key), "QStringLiteral");
+    if (!isQStringLiteral && !isConvertedLiteral(key))
+        return {};
+
+    auto literal = isa<StringLiteral>(key) ? cast<StringLiteral>(key) : clazy::getFirstChildOfType<StringLiteral>(key);
+    return literal ? literalText(literal) : string();
+}
+
+// The key of an element of QVariantMap map = { { "foo", 1 } }
+static string elementKey(const ASTContext *astContext, Expr *element)
+{
+    element = element->IgnoreImplicit();
+    if (auto initList = dyn_cast<InitListExpr>(element))
+        return initList->getNumInits() > 0 ? literalKey(astContext, initList->getInit(0)) : string();
+
+    auto construct = dyn_cast<CXXConstructExpr>(element);
+    return construct && construct->getNumArgs() > 0 ? literalKey(astContext, construct->getArg(0)) : string();
+}
+
+// Adds the keys of the initializer list the map is built from, returns false if the map is built from something else
+static bool collectInitKeys(const ASTContext *astContext, Expr *init, vector<string> &keys)
+{
+    auto construct = init ? dyn_cast<CXXConstructExpr>(init->IgnoreImplicit()) : nullptr;
+    if (!construct)
+        return false;
+
+    if (construct->getNumArgs() == 0)
+        return true;
+
+    auto stdInitializerList = dyn_cast<CXXStdInitializerListExpr>(construct->getArg(0)->IgnoreImplicit());
+    auto initList = stdInitializerList ? dyn_cast<InitListExpr>(stdInitializerList->getSubExpr()->IgnoreImplicit()) : nullptr;
+    if (!initList || construct->getNumArgs() != 1)
+        return false;
+
+    for (Expr *element : initList->inits()) {
+        string key = elementKey(astContext, element);
+        if (key.empty())
+            return false;
+        keys.push_back(std::move(key));
+    }
+
+    return true;
+}
+
+class ReadKeysVisitor
+    : public RecursiveASTVisitor<ReadKeysVisitor>
+{
+public:
+    ReadKeysVisitor(const ASTContext *astContext, unordered_set<string> &readKeys)
+        : m_astContext(astContext)
+        , m_sm(astContext->getSourceManager())
+        , m_readKeys(readKeys)
+    {
+    }
+
+    bool TraverseDecl(Decl *decl)
+    {
+        // Only the main file's reads are collected, which is what keeps this cheap
+        if (decl && !isa<TranslationUnitDecl>(decl) && !m_sm.isInMainFile(m_sm.getExpansionLoc(decl->getLocation())))
+            return true;
+
+        return RecursiveASTVisitor<ReadKeysVisitor>::TraverseDecl(decl);
+    }
+
+    bool VisitCXXMemberCallExpr(CXXMemberCallExpr *call)
+    {
+        static const clazy::NameSet lookups = { "value", "contains", "find", "constFind" };
+        if (call->getNumArgs() > 0 && clazy::functionIsOneOf(call->getMethodDecl(), lookups) && variantMapName(call->getRecordDecl()))
+            addKey(call->getArg(0));
+        return true;
+    }
+
+    bool VisitCXXOperatorCallExpr(CXXOperatorCallExpr *op)
+    {
+        if (op->getNumArgs() != 2)
+            return true;
+
+        // Parents are visited first, so map[key] = value is known to be a write when visiting map[key]
+        if (op->getOperator() == OO_Equal) {
+            if (auto subscript = dyn_cast<CXXOperatorCallExpr>(op->getArg(0)->IgnoreImplicit()))
+                m_assignedSubscripts.insert(subscript);
+        } else if (op->getOperator() == OO_Subscript && !m_assignedSubscripts.count(op)
+                   && variantMapName(op->getArg(0)->getType()->getAsCXXRecordDecl())) {
+            addKey(op->getArg(1));
+        }
+
+        return true;
+    }
+
+private:
+    void addKey(Expr *key)
+    {
+        string text = literalKey(m_astContext, key);
+        if (!text.empty())
+            m_readKeys.insert(std::move(text));
+    }
+
+    const ASTContext *const m_astContext;
+    const SourceManager &m_sm;
+    unordered_set<string> &m_readKeys;
+    llvm::DenseSet<const CXXOperatorCallExpr *> m_assignedSubscripts;
+};
+
+QVariantmapAsStruct::QVariantmapAsStruct(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    , m_hotPathsOnly(isOptionSet("hot-paths-only"))
+{
+}
+
+// Adds the keys varDecl is filled with, returns false if any isn't a literal or the map is modified otherwise
+bool QVariantmapAsStruct::collectInsertedKeys(VarDecl *varDecl, Stmt *scope, vector<string> &keys) const
+{
+    for (DeclRefExpr *declRef : clazy::getStatements<DeclRefExpr>(m_context->functionStmtIndex(scope), scope)) {
+        if (declRef->getDecl() != varDecl)
+            continue;
+
+        Stmt *child = declRef;
+        Stmt *parent = clazy::parent(m_context, declRef);
+        while (parent && (isa<ImplicitCastExpr>(parent) || isa<ParenExpr>(parent))) {
+            child = parent;
+            parent = clazy::parent(m_context, parent);
+        }
+
+        // map.insert(key, value), map.value(key)
+        if (auto memberExpr = dyn_cast_or_null<MemberExpr>(parent)) {
+            auto call = dyn_cast_or_null<CXXMemberCallExpr>(clazy::parent(m_context, memberExpr));
+            CXXMethodDecl *method = call && call->getCallee() == memberExpr ? call->getMethodDecl() : nullptr;
+            if (!method)
+                return false;
+
+            static const clazy::NameSet lookups = { "value", "contains", "find", "constFind" };
+            if (clazy::name(method) == "insert" && call->getNumArgs() == 2) {
+                string key = literalKey(m_astContext, call->getArg(0));
+                if (key.empty())
+                    return false;
+                keys.push_back(std::move(key));
+            } else if (!method->isConst() && !lookups.contains(clazy::name(method))) {
+                return false; // clear(), remove(), unite()...
+            }
+
+            continue;
+        }
+
+        auto op = dyn_cast_or_null<CXXOperatorCallExpr>(parent);
+        if (!op || op->getNumArgs() != 2 || op->getArg(0) != child)
+            continue; // Passed to a function or returned, which is what such maps are for
+
+        if (op->getOperator() == OO_Equal)
+            return false; // Assigned from another map
+
+        if (op->getOperator() != OO_Subscript)
+            continue;
+
+        string key = literalKey(m_astContext, op->getArg(1));
+        if (key.empty())
+            return false;
+
+        // map[key] = value
+        Stmt *opParent = clazy::parent(m_context, op);
+        while (opParent && (isa<ImplicitCastExpr>(opParent) || isa<MaterializeTemporaryExpr>(opParent)))
+            opParent = clazy::parent(m_context, opParent);
+        auto assignment = dyn_cast_or_null<CXXOperatorCallExpr>(opParent);
+        if (assignment && assignment->getOperator() == OO_Equal && assignment->getArg(0)->IgnoreImplicit() == op)
+            keys.push_back(std::move(key));
+    }
+
+    return true;
+}
+
+void QVariantmapAsStruct::collectReadKeys()
+{
+    if (m_collectedReadKeys)
+        return;
+
+    m_collectedReadKeys = true;
+    ReadKeysVisitor visitor(m_astContext, m_readKeys);
+    visitor.TraverseDecl(m_astContext->getTranslationUnitDecl());
+}
+
+void QVariantmapAsStruct::VisitStmt(clang::Stmt *stmt)
+{
+    auto declStmt = dyn_cast<DeclStmt>(stmt);
+    if (!declStmt)
+        return;
+
+    for (Decl *decl : declStmt->decls()) {
+        auto varDecl = dyn_cast<VarDecl>(decl);
+        if (!varDecl || !varDecl->isLocalVarDecl() || varDecl->isStaticLocal() || varDecl->getLocation().isMacroID())
+            continue;
+
+        const char *typeName = variantMapName(varDecl->getType()->getAsCXXRecordDecl());
+        if (!typeName)
+            continue;
+
+        auto method = dyn_cast_or_null<CXXMethodDecl>(m_context->lastFunctionDecl);
+        const bool inLoop = clazy::isInLoop(m_context, declStmt) != nullptr;
+        const bool inHotMethod = method && clazy::isHotMethod(method);
+        if (m_hotPathsOnly && !inLoop && !inHotMethod)
+            continue;
+
+        // A local can only be used inside its block
+        Stmt *scope = clazy::parent(m_context, declStmt);
+        vector<string> keys;
+        if (!scope || !collectInitKeys(m_astContext, varDecl->getInit(), keys) || !collectInsertedKeys(varDecl, scope, keys))
+            continue;
+
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        if (keys.size() < 2)
+            continue;
+
+        collectReadKeys();
+        if (!std::all_of(keys.cbegin(), keys.cend(), [this](const string &key) { return m_readKeys.count(key) > 0; }))
+            continue;
+
+        string message = string(typeName) + " used as a struct, its " + std::to_string(keys.size())
+            + " literal keys are also read by name in this file; a Q_GADGET struct avoids the allocation, the string lookups and the QVariant boxing";
+        if (inLoop)
+            message += ", on every iteration";
+        else if (inHotMethod)
+            message += ", inside " + clazy::name(method).str() + "(), which is called very often";
+
+        emitWarning(varDecl->getLocation(), message);
+    }
+}
@@ -0,0 +1,60 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_QVARIANTMAP_AS_STRUCT_H
+#define CLAZY_QVARIANTMAP_AS_STRUCT_H
+
+#include "checkbase.h"
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+class ClazyContext;
+
+namespace clang {
+class Stmt;
+class VarDecl;
+}
+
+/**
+ * Finds local QVariantMap and QVariantHash variables filled with a fixed set of literal keys, which the
+ * translation unit also reads back by the same literal keys, so a struct would do.
+ *
+ * See README-qvariantmap-as-struct.md for more info.
+ */
+class QVariantmapAsStruct
+    : public CheckBase
+{
+public:
+    explicit QVariantmapAsStruct(const std::string &name, ClazyContext *context);
+    void VisitStmt(clang::Stmt *stmt) override;
+private:
+    bool collectInsertedKeys(clang::VarDecl *varDecl, clang::Stmt *scope, std::vector<std::string> &keys) const;
+    void collectReadKeys();
+
+    const bool m_hotPathsOnly;
+    bool m_collectedReadKeys = false;
+    std::unordered_set<std::string> m_readKeys; // Literal keys read from any QVariantMap or QVariantHash in the main file
+};
+
+#endif
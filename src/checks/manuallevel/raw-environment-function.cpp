@@ -36,7 +36,7 @@ using namespace std;
 
 
 RawEnvironmentFunction::RawEnvironmentFunction(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context)
+    : CheckBase(name, context, Option_Reusable)
 {
 }
 
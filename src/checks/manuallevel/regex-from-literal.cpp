@@ -0,0 +1,227 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "regex-from-literal.h"
+#include "ClazyContext.h"
+#include "FixItUtils.h"
+#include "LoopUtils.h"
+#include "StmtBodyRange.h"
+#include "StringUtils.h"
+#include "Utils.h"
+#include "HierarchyUtils.h"
+#include "SourceCompatibilityHelpers.h"
+#include "clazy_stl.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/ParentMap.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/StmtCXX.h>
+#include <clang/Basic/LLVM.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+using namespace clang;
+using namespace std;
+
+RegexFromLiteral::RegexFromLiteral(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+    , m_loopsOnly(isOptionSet("loops-only"))
+{
+}
+
+// Returns how the regex class is called in warnings, or nullptr if record isn't one
+static const char *regexClassName(const CXXRecordDecl *record)
+{
+    if (!record)
+        return nullptr;
+
+    const StringRef name = clazy::name(record);
+    if (record->isInStdNamespace())
+        return name == "basic_regex" ? "std::regex" : nullptr;
+
+    if (name == "QRegularExpression")
+        return "QRegularExpression";
+    if (name == "QRegExp")
+        return "QRegExp";
+
+    return nullptr;
+}
+
+// Returns true if stmt evaluates to the same value on every call: literals, enumerators, constexpr
+// or global const variables, operators and string conversions of those
+static bool isConstantExpression(Stmt *stmt)
+{
+    if (!stmt)
+        return true;
+
+    // QStringLiteral is a lambda in Qt 5
+    if (auto lambda = dyn_cast<LambdaExpr>(stmt))
+        return lambda->capture_begin() == lambda->capture_end();
+
+    if (isa<CXXThisExpr>(stmt))
+        return false;
+
+    if (auto declRef = dyn_cast<DeclRefExpr>(stmt)) {
+        auto varDecl = dyn_cast<VarDecl>(declRef->getDecl());
+        return !varDecl || varDecl->isConstexpr()
+               || (varDecl->hasGlobalStorage() && varDecl->getType().isConstQualified());
+    }
+
+    if (auto member = dyn_cast<MemberExpr>(stmt)) {
+        if (!isa<CXXMethodDecl>(member->getMemberDecl()))
+            return false;
+    }
+
+    if (auto call = dyn_cast<CallExpr>(stmt)) {
+        static const clazy::NameSet conversions = { "fromLatin1", "fromUtf8", "fromLocal8Bit", "qMakeStringPrivate" };
+        FunctionDecl *func = call->getDirectCallee();
+        if (!func)
+            return false;
+
+        if (!func->isOverloadedOperator() && !isa<CXXConversionDecl>(func) && !func->isConstexpr()
+            && !conversions.contains(clazy::name(func)))
+            return false;
+    }
+
+    return clazy::all_of(stmt->children(), [](Stmt *child) { return isConstantExpression(child); });
+}
+
+// Returns true for the nodes wrapping a temporary which is copied, or moved, into a variable
+static bool isTemporaryWrapper(Stmt *stmt)
+{
+    if (isa<MaterializeTemporaryExpr>(stmt) || isa<CXXBindTemporaryExpr>(stmt) || isa<ImplicitCastExpr>(stmt)
+        || isa<CXXFunctionalCastExpr>(stmt) || isa<ExprWithCleanups>(stmt))
+        return true;
+
+    auto ctorExpr = dyn_cast<CXXConstructExpr>(stmt);
+    return ctorExpr && ctorExpr->getConstructor() && ctorExpr->getConstructor()->isCopyOrMoveConstructor();
+}
+
+// Returns the variable initialized by ctorExpr, if it's directly initialized by it
+static VarDecl *initializedVariable(ParentMap *map, Stmt *ctorExpr, DeclStmt *&declStmt)
+{
+    Stmt *child = ctorExpr;
+    Stmt *parent = clazy::parent(map, child);
+    while (parent && isTemporaryWrapper(parent)) {
+        child = parent;
+        parent = clazy::parent(map, child);
+    }
+
+    declStmt = dyn_cast_or_null<DeclStmt>(parent);
+    if (!declStmt)
+        return nullptr;
+
+    for (Decl *decl : declStmt->decls()) {
+        auto varDecl = dyn_cast<VarDecl>(decl);
+        if (varDecl && varDecl->getInit() == child)
+            return varDecl;
+    }
+
+    return nullptr;
+}
+
+// Returns the function body containing stmt, or nullptr if stmt is only evaluated once, such as
+// in the initializer of a static or global variable
+static Stmt *functionBody(ParentMap *map, Stmt *stmt)
+{
+    Stmt *root = stmt;
+    while (Stmt *parent = clazy::parent(map, root)) {
+        if (auto declStmt = dyn_cast<DeclStmt>(parent)) {
+            for (Decl *decl : declStmt->decls()) {
+                auto varDecl = dyn_cast<VarDecl>(decl);
+                if (varDecl && varDecl->isStaticLocal())
+                    return nullptr;
+            }
+        }
+        root = parent;
+    }
+
+    // Default member initializers and default arguments don't have a body as root
+    return isa<CompoundStmt>(root) || isa<CXXTryStmt>(root) ? root : nullptr;
+}
+
+vector<FixItHint> RegexFromLiteral::staticFixits(Stmt *body, DeclStmt *declStmt, VarDecl *varDecl) const
+{
+    if (!declStmt->isSingleDecl() || varDecl->getType()->isReferenceType())
+        return {};
+
+    const SourceLocation start = clazy::getLocStart(declStmt);
+    if (start.isMacroID())
+        return {};
+
+    // A static const object must never be modified, nor be handed out as non-const
+    if (Utils::containsNonConstMemberCall(m_context->parentMap, body, varDecl)
+        || Utils::isPassedToFunction(StmtBodyRange(body, nullptr, {}, m_context->functionStmtIndex(body)), varDecl, true)
+        || Utils::addressIsTaken(body, varDecl, m_context->functionStmtIndex(body)))
+        return {};
+
+    return { clazy::createInsertion(start, varDecl->getType().isConstQualified() ? "static " : "static const ") };
+}
+
+void RegexFromLiteral::VisitStmt(clang::Stmt *stmt)
+{
+    auto ctorExpr = dyn_cast<CXXConstructExpr>(stmt);
+    if (!ctorExpr || ctorExpr->getNumArgs() == 0 || !m_context->parentMap)
+        return;
+
+    CXXConstructorDecl *ctor = ctorExpr->getConstructor();
+    if (!ctor || ctor->isCopyOrMoveConstructor())
+        return;
+
+    const char *className = regexClassName(ctor->getParent());
+    if (!className)
+        return;
+
+    if (!Utils::containsStringLiteral(ctorExpr->getArg(0))
+        || !clazy::all_of(ctorExpr->arguments(), [](Expr *arg) { return isConstantExpression(arg); }))
+        return;
+
+    Stmt *body = functionBody(m_context->parentMap, stmt);
+    if (!body)
+        return;
+
+    DeclStmt *declStmt = nullptr;
+    VarDecl *varDecl = initializedVariable(m_context->parentMap, stmt, declStmt);
+    if (varDecl && (varDecl->isStaticLocal() || !varDecl->hasLocalStorage()))
+        return;
+
+    const bool inLoop = clazy::isInLoop(m_context, stmt) != nullptr;
+    if (m_loopsOnly && !inLoop)
+        return;
+
+    // Matching through a const QRegExp still writes to it, so suggest porting instead
+    const bool isQRegExp = StringRef(className) == "QRegExp";
+    string msg = string(className) + " with a constant pattern is compiled " + (inLoop ? "on every loop iteration" : "on every call");
+    if (isQRegExp)
+        msg += ", use a static const QRegularExpression instead";
+    else
+        msg += varDecl ? ", make it static const" : ", use a static const variable";
+
+    vector<FixItHint> fixits;
+    if (varDecl && !isQRegExp)
+        fixits = staticFixits(body, declStmt, varDecl);
+
+    emitWarning(clazy::getLocStart(stmt), msg, fixits);
+}
@@ -0,0 +1,58 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_REGEX_FROM_LITERAL_H
+#define CLAZY_REGEX_FROM_LITERAL_H
+
+#include "checkbase.h"
+
+#include <string>
+#include <vector>
+
+class ClazyContext;
+
+namespace clang {
+class Stmt;
+class VarDecl;
+class DeclStmt;
+class FixItHint;
+}
+
+/**
+ * Finds QRegularExpression, QRegExp and std::regex objects constructed from a constant pattern
+ * in function bodies, which compile the same pattern on every call or loop iteration.
+ *
+ * See README-regex-from-literal.md for more info.
+ */
+class RegexFromLiteral
+    : public CheckBase
+{
+public:
+    explicit RegexFromLiteral(const std::string &name, ClazyContext *context);
+    void VisitStmt(clang::Stmt *stmt) override;
+
+private:
+    std::vector<clang::FixItHint> staticFixits(clang::Stmt *body, clang::DeclStmt *declStmt, clang::VarDecl *varDecl) const;
+    const bool m_loopsOnly;
+};
+
+#endif
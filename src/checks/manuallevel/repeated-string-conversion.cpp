@@ -0,0 +1,233 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+
+#include "repeated-string-conversion.h"
+#include "ClazyContext.h"
+#include "HierarchyUtils.h"
+#include "LoopUtils.h"
+#include "StmtBodyRange.h"
+#include "StringUtils.h"
+#include "Utils.h"
+#include "SourceCompatibilityHelpers.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/SourceManager.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+#include <vector>
+
+using namespace clang;
+using namespace std;
+
+RepeatedStringConversion::RepeatedStringConversion(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+}
+
+// toStdString() and fromStdString() use UTF-8 too
+static StringRef encodingOf(StringRef methodName)
+{
+    if (methodName == "toUtf8" || methodName == "fromUtf8" || methodName == "toStdString" || methodName == "fromStdString")
+        return "utf8";
+    if (methodName == "toLatin1" || methodName == "fromLatin1")
+        return "latin1";
+    if (methodName == "toLocal8Bit" || methodName == "fromLocal8Bit")
+        return "local8bit";
+    if (methodName == "toStdWString" || methodName == "fromStdWString")
+        return "wstring";
+
+    return {};
+}
+
+// Returns the encoding of str.toUtf8() and friends, empty if call isn't one
+static StringRef conversionFromQString(CallExpr *call)
+{
+    auto memberCall = dyn_cast_or_null<CXXMemberCallExpr>(call);
+    CXXMethodDecl *method = memberCall ? memberCall->getMethodDecl() : nullptr;
+    if (!method || clazy::name(method->getParent()) != "QString" || !clazy::name(method).startswith("to"))
+        return {};
+
+    return encodingOf(clazy::name(method));
+}
+
+// Returns the encoding of QString::fromUtf8() and friends, empty if call isn't one
+static StringRef conversionToQString(CallExpr *call)
+{
+    auto method = call ? dyn_cast_or_null<CXXMethodDecl>(call->getDirectCallee()) : nullptr;
+    if (!method || !method->isStatic() || clazy::name(method->getParent()) != "QString" || !clazy::name(method).startswith("from"))
+        return {};
+
+    return encodingOf(clazy::name(method));
+}
+
+// Skips implicit casts and temporaries, and the accessors handing out the converted data as is, like constData() or c_str()
+static Expr *skipAccessors(Expr *expr)
+{
+    while (expr) {
+        expr = expr->IgnoreImplicit();
+        auto memberCall = dyn_cast<CXXMemberCallExpr>(expr);
+        CXXMethodDecl *method = memberCall ? memberCall->getMethodDecl() : nullptr;
+        if (!method)
+            return expr;
+
+        const StringRef name = clazy::name(method);
+        if (name != "constData" && name != "data" && name != "c_str")
+            return expr;
+
+        expr = memberCall->getImplicitObjectArgument();
+    }
+
+    return expr;
+}
+
+// Returns the variable expr refers to, looking through copies, as qPrintable(str) converts QString(str)
+static const VarDecl *variableOf(Expr *expr)
+{
+    expr = expr ? expr->IgnoreImplicit() : nullptr;
+    if (auto functionalCast = dyn_cast_or_null<CXXFunctionalCastExpr>(expr))
+        expr = functionalCast->getSubExpr()->IgnoreImplicit();
+
+    if (auto constructExpr = dyn_cast_or_null<CXXConstructExpr>(expr)) {
+        CXXConstructorDecl *ctor = constructExpr->getConstructor();
+        if (constructExpr->getNumArgs() == 1 && ctor && ctor->isCopyOrMoveConstructor())
+            expr = constructExpr->getArg(0)->IgnoreImplicit();
+    }
+
+    auto declRef = dyn_cast_or_null<DeclRefExpr>(expr);
+    return declRef ? dyn_cast<VarDecl>(declRef->getDecl()) : nullptr;
+}
+
+static bool isDeclaredInside(const VarDecl *varDecl, Stmt *stmt, const SourceManager &sm)
+{
+    const SourceLocation loc = clazy::getLocStart(varDecl);
+    const SourceRange range = stmt->getSourceRange();
+    return !sm.isBeforeInTranslationUnit(loc, range.getBegin()) && !sm.isBeforeInTranslationUnit(range.getEnd(), loc);
+}
+
+void RepeatedStringConversion::VisitStmt(clang::Stmt *stmt)
+{
+    auto call = dyn_cast<CallExpr>(stmt);
+    if (!call || !m_context->parentMap || processRoundTrip(call))
+        return;
+
+    if (!conversionFromQString(call).empty()) {
+        auto memberCall = cast<CXXMemberCallExpr>(call);
+        const VarDecl *string = variableOf(memberCall->getImplicitObjectArgument());
+        if (string && !processRepeatedInExpression(memberCall, string))
+            processRepeatedInLoop(call, string);
+    } else if (!conversionToQString(call).empty() && call->getNumArgs() > 0) {
+        if (const VarDecl *data = variableOf(skipAccessors(call->getArg(0))))
+            processRepeatedInLoop(call, data);
+    }
+}
+
+// Catches cases like: QString::fromUtf8(str.toUtf8()) and QString::fromLatin1(data).toLatin1()
+bool RepeatedStringConversion::processRoundTrip(CallExpr *call)
+{
+    const StringRef toQString = conversionToQString(call);
+    if (!toQString.empty()) {
+        auto inner = call->getNumArgs() > 0 ? dyn_cast<CallExpr>(skipAccessors(call->getArg(0))) : nullptr;
+
+        // Going through Latin-1 or the local 8-bit encoding drops the characters they can't represent, which might be the point
+        if (conversionFromQString(inner) != toQString || (toQString != "utf8" && toQString != "wstring"))
+            return false;
+
+        emitWarning(clazy::getLocStart(call), "QString::" + call->getDirectCallee()->getNameAsString() + "() undoes "
+                    + inner->getDirectCallee()->getNameAsString() + "(), use the QString directly");
+        return true;
+    }
+
+    const StringRef fromQString = conversionFromQString(call);
+    if (fromQString.empty())
+        return false;
+
+    auto inner = dyn_cast<CallExpr>(cast<CXXMemberCallExpr>(call)->getImplicitObjectArgument()->IgnoreImplicit());
+    if (conversionToQString(inner) != fromQString)
+        return false;
+
+    emitWarning(clazy::getLocStart(call), call->getDirectCallee()->getNameAsString() + "() undoes QString::"
+                + inner->getDirectCallee()->getNameAsString() + "(), use the original data directly");
+    return true;
+}
+
+// Catches cases like: foo(str.toUtf8().constData(), str.toUtf8().size())
+bool RepeatedStringConversion::processRepeatedInExpression(CXXMemberCallExpr *memberCall, const VarDecl *string)
+{
+    Stmt *fullExpression = memberCall;
+    while (Stmt *parent = clazy::parent(m_context->parentMap, fullExpression)) {
+        if (!isa<Expr>(parent))
+            break;
+        fullExpression = parent;
+    }
+
+    const StringRef methodName = clazy::name(memberCall->getMethodDecl());
+    vector<CXXMemberCallExpr *> memberCalls;
+    clazy::getChilds<CXXMemberCallExpr>(fullExpression, memberCalls);
+    for (CXXMemberCallExpr *other : memberCalls) {
+        if (other == memberCall)
+            return false; // The first conversion is fine
+
+        CXXMethodDecl *method = other->getMethodDecl();
+        if (method && clazy::name(method) == methodName && !conversionFromQString(other).empty()
+            && variableOf(other->getImplicitObjectArgument()) == string) {
+            emitWarning(clazy::getLocStart(memberCall), methodName.str() + "() converts " + string->getNameAsString()
+                        + " again in the same expression, convert it once and reuse the result");
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Catches cases like: for (...) { foo(str.toUtf8()); }, when str doesn't change inside the loop
+bool RepeatedStringConversion::processRepeatedInLoop(CallExpr *call, const VarDecl *converted)
+{
+    Stmt *loop = clazy::isInLoop(m_context, call);
+    if (!loop)
+        return false;
+
+    // Globals and static locals can change behind our back, and loop variables are new on each iteration
+    if (!converted->hasLocalStorage() || isDeclaredInside(converted, loop, sm()))
+        return false;
+
+    const QualType type = converted->getType();
+    if (type->isReferenceType() && !type.getNonReferenceType().isConstQualified())
+        return false;
+
+    const StmtIndex *index = m_context->functionStmtIndex(loop);
+    if (Utils::isAssignedFrom(loop, converted, index) || Utils::containsNonConstMemberCall(m_context->parentMap, loop, converted)
+        || Utils::isPassedToFunction(StmtBodyRange(loop, nullptr, {}, index), converted, /*byRefOrPtrOnly=*/ true)
+        || Utils::addressIsTaken(loop, converted, index))
+        return false;
+
+    const string methodName = clazy::name(call->getDirectCallee()).str();
+    emitWarning(clazy::getLocStart(call), (isa<CXXMemberCallExpr>(call) ? methodName : "QString::" + methodName) + "() converts the unchanged "
+                + converted->getNameAsString() + " on every iteration, convert it once before the loop");
+    return true;
+}
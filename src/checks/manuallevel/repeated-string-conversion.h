@@ -0,0 +1,58 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+
+#ifndef CLAZY_REPEATED_STRING_CONVERSION_H
+#define CLAZY_REPEATED_STRING_CONVERSION_H
+
+#include "checkbase.h"
+
+#include <string>
+
+class ClazyContext;
+
+namespace clang {
+class Stmt;
+class CallExpr;
+class CXXMemberCallExpr;
+class VarDecl;
+}
+
+/**
+ * Finds QString encoding conversions undone right away, as in QString::fromUtf8(str.toUtf8()), and conversions
+ * of the same unchanged string repeated in one expression or on every iteration of a loop.
+ *
+ * See README-repeated-string-conversion.md for more info.
+ */
+class RepeatedStringConversion
+    : public CheckBase
+{
+public:
+    explicit RepeatedStringConversion(const std::string &name, ClazyContext *context);
+    void VisitStmt(clang::Stmt *stmt) override;
+private:
+    bool processRoundTrip(clang::CallExpr *call);
+    bool processRepeatedInExpression(clang::CXXMemberCallExpr *memberCall, const clang::VarDecl *string);
+    bool processRepeatedInLoop(clang::CallExpr *call, const clang::VarDecl *converted);
+};
+
+#endif
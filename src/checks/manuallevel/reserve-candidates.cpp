@@ -30,6 +30,7 @@
 #include "StringUtils.h"
 #include "QtUtils.h"
 #include "ContextUtils.h"
+#include "FixItUtils.h"
 #include "HierarchyUtils.h"
 #include "LoopUtils.h"
 #include "SourceCompatibilityHelpers.h"
@@ -44,9 +45,13 @@
 #include <clang/Basic/LLVM.h>
 #include <clang/Basic/SourceLocation.h>
 #include <clang/Basic/SourceManager.h>
+#include <clang/Lex/Lexer.h>
 #include <llvm/ADT/StringRef.h>
 #include <llvm/Support/Casting.h>
+#include <llvm/Support/MathExtras.h>
 
+#include <algorithm>
+#include <string>
 #include <vector>
 
 using namespace clang;
@@ -54,6 +59,7 @@ using namespace std;
 
 ReserveCandidates::ReserveCandidates(const std::string &name, ClazyContext *context)
     : CheckBase(name, context, Option_CanIgnoreIncludes)
+    , m_foundReserves(arenaAllocator())
 {
 }
 
@@ -78,7 +84,8 @@ static bool isCandidateMethod(CXXMethodDecl *methodDecl)
     if (!classDecl)
         return false;
 
-    if (!clazy::equalsAny(clazy::name(methodDecl), { "append", "push_back", "push", "operator<<", "operator+=" }))
+    static const clazy::NameSet candidateMethods = { "append", "push_back", "push", "operator<<", "operator+=" };
+    if (!candidateMethods.contains(clazy::name(methodDecl)))
         return false;
 
     if (!clazy::isAReserveClass(classDecl))
@@ -148,12 +155,209 @@ bool ReserveCandidates::isReserveCandidate(ValueDecl *valueDecl, Stmt *loopBody,
     if (isInComplexLoop(callExpr, clazy::getLocStart(valueDecl), isMemberVariable))
         return false;
 
-    if (clazy::loopCanBeInterrupted(loopBody, m_context->sm, clazy::getLocStart(callExpr)))
+    if (clazy::loopCanBeInterrupted(m_context->functionStmtIndex(loopBody), loopBody, m_context->sm, clazy::getLocStart(callExpr)))
         return false;
 
     return true;
 }
 
+static vector<CallExpr *> candidateCallsInBothBranches(IfStmt *ifStmt);
+
+// Returns the candidate calls done once per execution of s, which are its direct children
+// or the calls done on the same container by every branch of an if statement
+static vector<CallExpr *> candidateCallsIn(Stmt *s)
+{
+    if (auto ifStmt = dyn_cast<IfStmt>(s))
+        return candidateCallsInBothBranches(ifStmt);
+
+    vector<CallExpr *> result;
+    auto callExprs = clazy::getStatements<CallExpr>(s, nullptr, {}, /*depth=*/ 1,
+                                                    /*includeParent=*/ true,
+                                                    clazy::IgnoreExprWithCleanups);
+    for (CallExpr *callExpr : callExprs) {
+        if (isCandidate(callExpr))
+            result.push_back(callExpr);
+    }
+
+    if (isa<CompoundStmt>(s)) {
+        for (Stmt *child : s->children()) {
+            if (auto ifStmt = dyn_cast_or_null<IfStmt>(child))
+                clazy::append(candidateCallsInBothBranches(ifStmt), result);
+        }
+    }
+
+    return result;
+}
+
+static vector<CallExpr *> candidateCallsInBothBranches(IfStmt *ifStmt)
+{
+    if (!ifStmt->getElse())
+        return {};
+
+    const vector<CallExpr *> thenCalls = candidateCallsIn(ifStmt->getThen());
+    vector<CallExpr *> elseCalls = candidateCallsIn(ifStmt->getElse());
+
+    // Each call of the then branch needs one in the else branch, on the same container
+    vector<CallExpr *> result;
+    for (CallExpr *thenCall : thenCalls) {
+        ValueDecl *valueDecl = Utils::valueDeclForCallExpr(thenCall);
+        auto it = std::find_if(elseCalls.begin(), elseCalls.end(), [valueDecl](CallExpr *elseCall) {
+            return Utils::valueDeclForCallExpr(elseCall) == valueDecl;
+        });
+
+        if (valueDecl && it != elseCalls.end()) {
+            result.push_back(thenCall);
+            elseCalls.erase(it);
+        }
+    }
+
+    return result;
+}
+
+// Expressions which can be evaluated again before the loop without side effects, like v, m_v or this->d.v
+static bool isSimpleExpr(Expr *expr)
+{
+    expr = expr ? expr->IgnoreParenImpCasts() : nullptr;
+    if (!expr)
+        return false;
+
+    if (isa<DeclRefExpr>(expr) || isa<CXXThisExpr>(expr))
+        return true;
+
+    if (auto memberExpr = dyn_cast<MemberExpr>(expr))
+        return isSimpleExpr(memberExpr->getBase());
+
+    return false;
+}
+
+static bool hasSizeMethod(const CXXRecordDecl *record)
+{
+    if (!record || !record->hasDefinition())
+        return false;
+
+    for (auto method : record->methods()) {
+        if (method->getNumParams() == 0 && clazy::name(method) == "size")
+            return true;
+    }
+
+    for (const CXXBaseSpecifier &base : record->bases()) {
+        if (hasSizeMethod(base.getType()->getAsCXXRecordDecl()))
+            return true;
+    }
+
+    return false;
+}
+
+static bool isLoopVariable(Expr *expr, const VarDecl *var)
+{
+    auto declRef = dyn_cast_or_null<DeclRefExpr>(expr ? expr->IgnoreParenImpCasts() : nullptr);
+    return declRef && declRef->getDecl() == var;
+}
+
+std::string ReserveCandidates::sourceText(SourceRange range) const
+{
+    if (range.getBegin().isMacroID() || range.getEnd().isMacroID())
+        return {};
+
+    return Lexer::getSourceText(CharSourceRange::getTokenRange(range), sm(), lo()).str();
+}
+
+string ReserveCandidates::tripCount(Stmt *loop) const
+{
+    if (auto rangeLoop = dyn_cast<CXXForRangeStmt>(loop)) {
+        // for (auto v : container)
+        Expr *range = rangeLoop->getRangeInit() ? rangeLoop->getRangeInit()->IgnoreParenImpCasts() : nullptr;
+        if (!range)
+            return {};
+
+        if (auto arrayType = dyn_cast<ConstantArrayType>(range->getType().getCanonicalType().getTypePtr()))
+            return std::to_string(arrayType->getSize().getZExtValue());
+
+        if (!isSimpleExpr(range) || !hasSizeMethod(range->getType()->getAsCXXRecordDecl()))
+            return {};
+
+        const string container = sourceText(range->getSourceRange());
+        return container.empty() ? string() : container + ".size()";
+    }
+
+    // for (int i = 0; i < n; ++i), with n being a constant, a variable or a call like v.size()
+    auto forStmt = dyn_cast<ForStmt>(loop);
+    auto declStmt = forStmt ? dyn_cast_or_null<DeclStmt>(forStmt->getInit()) : nullptr;
+    auto var = declStmt && declStmt->isSingleDecl() ? dyn_cast<VarDecl>(declStmt->getSingleDecl()) : nullptr;
+    auto start = var && var->getInit() ? dyn_cast<IntegerLiteral>(var->getInit()->IgnoreParenImpCasts()) : nullptr;
+    if (!start || start->getValue() != 0)
+        return {};
+
+    auto cond = dyn_cast_or_null<BinaryOperator>(forStmt->getCond());
+    if (!cond || (cond->getOpcode() != BO_LT && cond->getOpcode() != BO_NE) || !isLoopVariable(cond->getLHS(), var))
+        return {};
+
+    auto inc = dyn_cast_or_null<UnaryOperator>(forStmt->getInc());
+    if (!inc || !inc->isIncrementOp() || !isLoopVariable(inc->getSubExpr(), var))
+        return {};
+
+    Expr *end = cond->getRHS()->IgnoreParenImpCasts();
+    auto endCall = dyn_cast<CXXMemberCallExpr>(end);
+    const bool isConstCall = endCall && endCall->getNumArgs() == 0 && endCall->getMethodDecl()
+                             && endCall->getMethodDecl()->isConst() && isSimpleExpr(endCall->getImplicitObjectArgument());
+    if (!isa<IntegerLiteral>(end) && !isSimpleExpr(end) && !isConstCall)
+        return {};
+
+    return sourceText(end->getSourceRange());
+}
+
+// Inserts "container.reserve(count);" before loop, for a container appended to numCalls times per iteration
+vector<FixItHint> ReserveCandidates::reserveFixits(Stmt *loop, CallExpr *callExpr, int numCalls) const
+{
+    if (clazy::getLocStart(loop).isMacroID())
+        return {};
+
+    // Reserving inside another loop would run it each time
+    for (Stmt *parent = clazy::parent(m_context->parentMap, loop); parent; parent = clazy::parent(m_context->parentMap, parent)) {
+        if (clazy::bodyFromLoop(parent))
+            return {};
+    }
+
+    Expr *container = nullptr;
+    bool isArrow = false;
+    if (auto memberCall = dyn_cast<CXXMemberCallExpr>(callExpr)) {
+        container = memberCall->getImplicitObjectArgument();
+        isArrow = container && container->getType()->isPointerType();
+    } else if (auto operatorCall = dyn_cast<CXXOperatorCallExpr>(callExpr)) {
+        container = operatorCall->getNumArgs() > 0 ? operatorCall->getArg(0) : nullptr;
+    }
+
+    if (!isSimpleExpr(container))
+        return {};
+
+    const string containerText = sourceText(container->IgnoreParenImpCasts()->getSourceRange());
+    const string count = tripCount(loop);
+    if (containerText.empty() || count.empty())
+        return {};
+
+    // Keep the indentation of the loop
+    const SourceLocation loopStart = clazy::getLocStart(loop);
+    const unsigned int column = sm().getSpellingColumnNumber(loopStart);
+    const StringRef linePrefix(sm().getCharacterData(loopStart) - (column - 1), column - 1);
+    const string indentation = linePrefix.find_first_not_of(" \t") == StringRef::npos ? linePrefix.str() : string();
+
+    const string reserve = containerText + (isArrow ? "->" : ".") + "reserve("
+                           + (numCalls > 1 ? std::to_string(numCalls) + " * " : string()) + count + ");\n";
+    return { clazy::createInsertion(loopStart, reserve + indentation) };
+}
+
+// The size of what callExpr appends, 0 if unknown
+static uint64_t appendedBytes(const ASTContext &astContext, CallExpr *callExpr)
+{
+    // The element is the last argument, of push_back(x) and of operator<<(container, x)
+    Expr *arg = callExpr->getNumArgs() > 0 ? callExpr->getArg(callExpr->getNumArgs() - 1) : nullptr;
+    const QualType type = arg ? arg->getType() : QualType();
+    if (type.isNull() || type->isIncompleteType() || type->isDependentType())
+        return 0;
+
+    return astContext.getTypeSizeInChars(type).getQuantity();
+}
+
 void ReserveCandidates::VisitStmt(clang::Stmt *stm)
 {
     if (registerReserveStatement(stm))
@@ -163,30 +367,38 @@ void ReserveCandidates::VisitStmt(clang::Stmt *stm)
     if (!body)
         return;
 
-    const bool isForeach = clazy::isInMacro(&m_astContext, clazy::getLocStart(stm), "Q_FOREACH");
+    const bool isForeach = clazy::isInMacro(m_astContext, clazy::getLocStart(stm), "Q_FOREACH");
 
     // If the body is another loop, we have nesting, ignore it now since the inner loops will be visited soon.
     if (isa<DoStmt>(body) || isa<WhileStmt>(body) || (!isForeach && isa<ForStmt>(body)))
         return;
 
-    // TODO: Search in both branches of the if statement
-    if (isa<IfStmt>(body))
-        return;
-
-    // Get the list of member calls and operator<< that are direct childs of the loop statements
-    // If it's inside an if statement we don't care.
-    auto callExprs = clazy::getStatements<CallExpr>(body, nullptr, {}, /*depth=*/ 1,
-                                                    /*includeParent=*/ true,
-                                                    clazy::IgnoreExprWithCleanups);
-
+    // Get the list of member calls and operator<< that are done once per iteration.
+    // If it's inside an if statement we only care if every branch does it.
+    const vector<CallExpr *> callExprs = candidateCallsIn(body);
 
+    vector<ValueDecl *> candidates;
     for (CallExpr *callExpr : callExprs) {
-        if (!isCandidate(callExpr))
+        ValueDecl *valueDecl = Utils::valueDeclForCallExpr(callExpr);
+        if (!isReserveCandidate(valueDecl, body, callExpr))
             continue;
 
-        ValueDecl *valueDecl = Utils::valueDeclForCallExpr(callExpr);
-        if (isReserveCandidate(valueDecl, body, callExpr))
-            emitWarning(clazy::getLocStart(callExpr), "Reserve candidate");
+        // The fixit reserves once, for all calls on the same container
+        vector<FixItHint> fixits;
+        if (!clazy::contains(candidates, valueDecl)) {
+            candidates.push_back(valueDecl);
+            const int numCalls = std::count_if(callExprs.cbegin(), callExprs.cend(), [valueDecl](CallExpr *call) {
+                return Utils::valueDeclForCallExpr(call) == valueDecl;
+            });
+            fixits = reserveFixits(stm, callExpr, numCalls);
+        }
+
+        // Growing reallocates and copies what was appended so far, about log2(n) times for n appends, each time the loop runs.
+        // Loops with an unknown trip count are assumed to append 16 times
+        const int64_t tripCount = clazy::constantTripCount(stm, *m_astContext);
+        const uint64_t appends = tripCount > 0 ? tripCount : 16;
+        setWasteEstimate(llvm::Log2_64_Ceil(appends), appends * appendedBytes(*m_astContext, callExpr), clazy::loopDepth(m_context, stm));
+        emitWarning(clazy::getLocStart(callExpr), "Reserve candidate", fixits);
     }
 }
 
@@ -281,14 +493,10 @@ bool ReserveCandidates::isInComplexLoop(clang::Stmt *s, SourceLocation declLocat
     int forCount = 0;
     int foreachCount = 0;
 
-    static vector<unsigned int> nonComplexOnesCache;
-    static vector<unsigned int> complexOnesCache;
     auto rawLoc = clazy::getLocStart(s).getRawEncoding();
 
-
-    // For some reason we generate two warnings on some foreaches, so cache the ones we processed
-    // and return true so we don't trigger a warning
-    if (clazy::contains(nonComplexOnesCache, rawLoc) || clazy::contains(complexOnesCache, rawLoc))
+    // Return true for the ones we already processed, so we don't trigger a warning twice
+    if (clazy::contains(m_nonComplexOnesCache, rawLoc) || clazy::contains(m_complexOnesCache, rawLoc))
         return true;
 
     Stmt *parent = s;
@@ -296,17 +504,17 @@ bool ReserveCandidates::isInComplexLoop(clang::Stmt *s, SourceLocation declLocat
     while ((parent = clazy::parent(m_context->parentMap, parent))) {
         const SourceLocation parentStart = clazy::getLocStart(parent);
         if (!isMemberVariable && sm().isBeforeInSLocAddrSpace(parentStart, declLocation)) {
-            nonComplexOnesCache.push_back(rawLoc);
+            m_nonComplexOnesCache.push_back(rawLoc);
             return false;
         }
 
         bool isLoop = false;
         if (loopIsComplex(parent, isLoop)) {
-            complexOnesCache.push_back(rawLoc);
+            m_complexOnesCache.push_back(rawLoc);
             return true;
         }
 
-        if (clazy::isInForeach(&m_astContext, parentStart)) {
+        if (clazy::isInForeach(m_astContext, parentStart)) {
             auto ploc = sm().getPresumedLoc(parentStart);
             if (Utils::presumedLocationsEqual(ploc, lastForeachForStm)) {
                 // Q_FOREACH comes in pairs, because each has two for statements inside, so ignore one when counting
@@ -320,13 +528,13 @@ bool ReserveCandidates::isInComplexLoop(clang::Stmt *s, SourceLocation declLocat
         }
 
         if (foreachCount > 1 || forCount > 1) { // two foreaches are almost always a false-positve
-            complexOnesCache.push_back(rawLoc);
+            m_complexOnesCache.push_back(rawLoc);
             return true;
         }
 
 
     }
 
-    nonComplexOnesCache.push_back(rawLoc);
+    m_nonComplexOnesCache.push_back(rawLoc);
     return false;
 }
@@ -25,6 +25,7 @@
 #ifndef CLAZY_RESERVE_CANDIDATES
 #define CLAZY_RESERVE_CANDIDATES
 
+#include "ArenaAllocator.h"
 #include "checkbase.h"
 
 #include <vector>
@@ -37,7 +38,9 @@ class ValueDecl;
 class Expr;
 class CallExpr;
 class SourceLocation;
+class SourceRange;
 class Stmt;
+class FixItHint;
 }
 
 /**
@@ -63,8 +66,15 @@ private:
     bool loopIsComplex(clang::Stmt *, bool &isLoop) const;
     bool isInComplexLoop(clang::Stmt *, clang::SourceLocation declLocation, bool isMemberVariable) const;
     bool isReserveCandidate(clang::ValueDecl *valueDecl, clang::Stmt *loopBody, clang::CallExpr *callExpr) const;
+    std::string sourceText(clang::SourceRange range) const;
+    std::string tripCount(clang::Stmt *loop) const;
+    std::vector<clang::FixItHint> reserveFixits(clang::Stmt *loop, clang::CallExpr *callExpr, int numCalls) const;
 
-    std::vector<clang::ValueDecl*> m_foundReserves;
+    clazy::ArenaVector<clang::ValueDecl*> m_foundReserves;
+
+    // For some reason we generate two warnings on some foreaches, so cache the ones we processed
+    mutable std::vector<unsigned int> m_nonComplexOnesCache;
+    mutable std::vector<unsigned int> m_complexOnesCache;
 };
 
 #endif
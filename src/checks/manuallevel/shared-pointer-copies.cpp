@@ -0,0 +1,239 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "shared-pointer-copies.h"
+#include "ClazyContext.h"
+#include "FixItUtils.h"
+#include "HierarchyUtils.h"
+#include "LoopUtils.h"
+#include "StmtIndex.h"
+#include "StringUtils.h"
+#include "Utils.h"
+#include "SourceCompatibilityHelpers.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/LambdaCapture.h>
+#include <clang/AST/ParentMap.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/StmtCXX.h>
+#include <clang/Basic/Lambda.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/OperatorKinds.h>
+#include <clang/Basic/SourceManager.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+#include <vector>
+
+using namespace clang;
+using namespace std;
+
+SharedPointerCopies::SharedPointerCopies(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+}
+
+// Returns true for a QSharedPointer or std::shared_ptr held by value
+static bool isSharedPointerValue(const ValueDecl *decl)
+{
+    const QualType type = decl->getType();
+    return !type->isReferenceType() && Utils::isSharedPointer(type->getAsCXXRecordDecl());
+}
+
+// Returns true if the use of the variable only reads through it, as in p->foo(), *p, p.get(), if (p) or p == q
+static bool isReadOnlyUse(ParentMap *map, DeclRefExpr *declRef)
+{
+    Stmt *child = declRef;
+    Stmt *parent = clazy::parent(map, child);
+    while (parent && (isa<ImplicitCastExpr>(parent) || isa<ParenExpr>(parent))) {
+        child = parent;
+        parent = clazy::parent(map, parent);
+    }
+
+    if (auto memberExpr = dyn_cast_or_null<MemberExpr>(parent)) {
+        auto method = dyn_cast<CXXMethodDecl>(memberExpr->getMemberDecl());
+        return method && method->isConst();
+    }
+
+    auto op = dyn_cast_or_null<CXXOperatorCallExpr>(parent);
+    if (!op)
+        return false;
+
+    if (auto method = dyn_cast_or_null<CXXMethodDecl>(op->getDirectCallee()))
+        return method->isConst() && op->getNumArgs() > 0 && op->getArg(0) == child;
+
+    // Comparisons, which take their arguments by const-ref
+    const OverloadedOperatorKind kind = op->getOperator();
+    return kind == OO_EqualEqual || kind == OO_ExclaimEqual || kind == OO_Less;
+}
+
+// Returns true if every reference to varDecl inside body only reads through it, so it's never copied, moved or modified
+static bool isOnlyReadFrom(ParentMap *map, const StmtIndex *index, Stmt *body, const VarDecl *varDecl)
+{
+    for (DeclRefExpr *declRef : clazy::getStatements<DeclRefExpr>(index, body)) {
+        if (declRef->getDecl() == varDecl && !isReadOnlyUse(map, declRef))
+            return false;
+    }
+
+    return true;
+}
+
+static bool referencesVar(Stmt *stmt, const VarDecl *varDecl)
+{
+    for (DeclRefExpr *declRef : clazy::getStatements<DeclRefExpr>(stmt, nullptr, {}, -1, /*includeParent=*/ true)) {
+        if (declRef->getDecl() == varDecl)
+            return true;
+    }
+
+    return false;
+}
+
+// Makes "T p" a "const T &p"
+static vector<FixItHint> constRefFixits(const VarDecl *varDecl)
+{
+    const SourceLocation start = clazy::getLocStart(varDecl);
+    const SourceLocation nameLoc = varDecl->getLocation();
+    if (start.isMacroID() || nameLoc.isMacroID() || varDecl->getName().empty())
+        return {};
+
+    vector<FixItHint> fixits;
+    if (!varDecl->getType().isConstQualified())
+        fixits.push_back(clazy::createInsertion(start, "const "));
+    fixits.push_back(clazy::createInsertion(nameLoc, "&"));
+    return fixits;
+}
+
+void SharedPointerCopies::VisitDecl(clang::Decl *decl)
+{
+    auto function = dyn_cast<FunctionDecl>(decl);
+    Stmt *body = function ? function->getBody() : nullptr;
+    if (!body || !function->isThisDeclarationADefinition() || function->isTemplateInstantiation()
+        || function->isDeleted() || function->isDefaulted() || clazy::getLocStart(function).isMacroID())
+        return;
+
+    // Overrides have their signature imposed
+    auto method = dyn_cast<CXXMethodDecl>(function);
+    if (method && method->isVirtual())
+        return;
+
+    auto ctor = dyn_cast<CXXConstructorDecl>(function);
+    const StmtIndex *index = m_context->functionStmtIndex(body);
+    for (ParmVarDecl *param : function->parameters()) {
+        if (!isSharedPointerValue(param) || !isOnlyReadFrom(m_context->parentMap, index, body, param))
+            continue;
+
+        bool usedByInitializer = false;
+        if (ctor) {
+            for (CXXCtorInitializer *init : ctor->inits())
+                usedByInitializer |= referencesVar(init->getInit(), param);
+        }
+
+        if (usedByInitializer)
+            continue;
+
+        // The other declarations would need the same change
+        const vector<FixItHint> fixits = function->getPreviousDecl() ? vector<FixItHint>() : constRefFixits(param);
+        emitWarning(clazy::getLocStart(param), "Shared pointer '" + param->getNameAsString()
+                    + "' is passed by value but never stored, pass it by const-ref to avoid atomic reference counting", fixits);
+    }
+}
+
+void SharedPointerCopies::checkRangeLoop(CXXForRangeStmt *rangeLoop)
+{
+    VarDecl *varDecl = rangeLoop->getLoopVariable();
+    Stmt *body = rangeLoop->getBody();
+    if (!varDecl || !body || !isSharedPointerValue(varDecl) || clazy::getLocStart(rangeLoop).isMacroID())
+        return;
+
+    if (!isOnlyReadFrom(m_context->parentMap, m_context->functionStmtIndex(body), body, varDecl))
+        return;
+
+    emitWarning(clazy::getLocStart(varDecl), "range-for copies the shared pointer '" + varDecl->getNameAsString()
+                + "' out of the container, use a const reference to avoid atomic reference counting", constRefFixits(varDecl));
+}
+
+// Returns true if the lambda is passed to QObject::connect() or to QtConcurrent
+static bool isConnectedOrConcurrentLambda(ParentMap *map, LambdaExpr *lambda)
+{
+    auto callExpr = clazy::getFirstParentOfType<CallExpr>(map, lambda);
+    FunctionDecl *func = callExpr ? callExpr->getDirectCallee() : nullptr;
+    if (!func)
+        return false;
+
+    return clazy::qualifiedMethodNameIs(func, "QObject::connect")
+           || StringRef(func->getQualifiedNameAsString()).startswith("QtConcurrent::");
+}
+
+void SharedPointerCopies::checkLambda(LambdaExpr *lambda)
+{
+    // Null if it's not inside a function body, like in a default member initializer
+    const StmtIndex *index = m_context->functionStmtIndex(lambda);
+    if (!index || !isConnectedOrConcurrentLambda(m_context->parentMap, lambda))
+        return;
+
+    Stmt *functionBody = index->root();
+    Stmt *loop = clazy::isInLoop(m_context, lambda);
+    for (const LambdaCapture &capture : lambda->captures()) {
+        if (capture.getCaptureKind() != LCK_ByCopy || capture.isPackExpansion())
+            continue;
+
+        VarDecl *varDecl = capture.getCapturedVar();
+        if (!varDecl || !varDecl->hasLocalStorage() || varDecl->isInitCapture() || !isSharedPointerValue(varDecl)
+            || varDecl->getType().isConstQualified())
+            continue;
+
+        // Moving it would leave it empty for the next iteration
+        if (loop && sm().isBeforeInTranslationUnit(clazy::getLocStart(varDecl), clazy::getLocStart(loop)))
+            continue;
+
+        bool usedAfterwards = false;
+        for (DeclRefExpr *declRef : clazy::getStatements<DeclRefExpr>(index, functionBody)) {
+            if (declRef->getDecl() == varDecl && sm().isBeforeInTranslationUnit(clazy::getLocEnd(lambda), clazy::getLocStart(declRef))) {
+                usedAfterwards = true;
+                break;
+            }
+        }
+
+        if (usedAfterwards)
+            continue;
+
+        const string name = varDecl->getNameAsString();
+        vector<FixItHint> fixits;
+        if (capture.isExplicit() && lo().CPlusPlus14 && !capture.getLocation().isMacroID())
+            fixits.push_back(clazy::createReplacement(SourceRange(capture.getLocation()), name + " = std::move(" + name + ")"));
+
+        emitWarning(capture.getLocation(), "Shared pointer '" + name + "' is copied into the lambda and not used afterwards, move it with ["
+                    + name + " = std::move(" + name + ")]", fixits);
+    }
+}
+
+void SharedPointerCopies::VisitStmt(clang::Stmt *stmt)
+{
+    if (auto rangeLoop = dyn_cast<CXXForRangeStmt>(stmt)) {
+        checkRangeLoop(rangeLoop);
+    } else if (auto lambda = dyn_cast<LambdaExpr>(stmt)) {
+        checkLambda(lambda);
+    }
+}
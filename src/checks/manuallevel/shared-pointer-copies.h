@@ -0,0 +1,58 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_SHARED_POINTER_COPIES_H
+#define CLAZY_SHARED_POINTER_COPIES_H
+
+#include "checkbase.h"
+
+#include <string>
+
+class ClazyContext;
+
+namespace clang {
+class CXXForRangeStmt;
+class Decl;
+class LambdaExpr;
+class Stmt;
+}
+
+/**
+ * Finds shared pointers which are copied for nothing, as each copy costs two atomic operations on the
+ * reference count: parameters taken by value and never stored, range-for loops copying them out of a
+ * container, and lambdas passed to connect() or QtConcurrent copying a local which isn't used afterwards.
+ *
+ * See README-shared-pointer-copies.md for more info.
+ */
+class SharedPointerCopies
+    : public CheckBase
+{
+public:
+    explicit SharedPointerCopies(const std::string &name, ClazyContext *context);
+    void VisitDecl(clang::Decl *decl) override;
+    void VisitStmt(clang::Stmt *stmt) override;
+private:
+    void checkRangeLoop(clang::CXXForRangeStmt *rangeLoop);
+    void checkLambda(clang::LambdaExpr *lambda);
+};
+
+#endif
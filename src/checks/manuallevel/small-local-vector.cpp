@@ -0,0 +1,283 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "small-local-vector.h"
+#include "ClazyContext.h"
+#include "LoopUtils.h"
+#include "StmtIndex.h"
+#include "StringUtils.h"
+#include "TemplateUtils.h"
+#include "clazy_stl.h"
+
+#include <clang/AST/ASTContext.h>
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/StmtCXX.h>
+#include <clang/AST/Type.h>
+#include <clang/Basic/LLVM.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace clang;
+using namespace std;
+
+// Vectors which never hold more elements than this, nor more bytes, are cheap enough to keep on the stack
+static const int64_t s_maxElements = 16;
+static const int64_t s_maxBytes = 512;
+
+enum MethodEffect {
+    Effect_Unknown,
+    Effect_None, // Reads or assigns elements
+    Effect_Append, // Adds one element
+    Effect_Shrink
+};
+
+SmallLocalVector::SmallLocalVector(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+}
+
+static const char *vectorName(QualType qualType)
+{
+    const CXXRecordDecl *record = qualType->getAsCXXRecordDecl();
+    if (!record)
+        return nullptr;
+
+    const StringRef name = clazy::name(record);
+    if (record->isInStdNamespace())
+        return name == "vector" ? "std::vector" : nullptr;
+
+    if (name == "QVector")
+        return "QVector";
+    return name == "QList" ? "QList" : nullptr;
+}
+
+static unsigned int numExplicitArgs(const CXXConstructExpr *construct)
+{
+    return static_cast<unsigned int>(std::count_if(construct->arg_begin(), construct->arg_end(), [](const Expr *arg) {
+        return !isa<CXXDefaultArgExpr>(arg);
+    }));
+}
+
+// Returns the number of elements the vector is constructed with, or -1 if it's not known at compile time
+static int64_t initialSize(const VarDecl *varDecl)
+{
+    Expr *init = varDecl->getInit() ? varDecl->getInit()->IgnoreImplicit() : nullptr;
+    if (!init)
+        return 0;
+
+    auto construct = dyn_cast<CXXConstructExpr>(init);
+    if (!construct)
+        return -1;
+
+    const unsigned int numArgs = numExplicitArgs(construct);
+    if (numArgs == 0)
+        return 0;
+
+    // QVector<int> v = { 1, 2 }
+    Expr *arg = construct->getArg(0)->IgnoreImplicit();
+    if (auto initializerList = dyn_cast<CXXStdInitializerListExpr>(arg)) {
+        auto initList = dyn_cast<InitListExpr>(initializerList->getSubExpr()->IgnoreImplicit());
+        return initList && numArgs == 1 ? initList->getNumInits() : -1;
+    }
+
+    // QVector<int> v(3) or std::vector<int> v(3, 0)
+    auto literal = dyn_cast<IntegerLiteral>(arg);
+    CXXConstructorDecl *ctor = construct->getConstructor();
+    if (!literal || numArgs > 2 || !ctor || ctor->getNumParams() == 0
+        || !ctor->getParamDecl(0)->getType()->isIntegerType() || literal->getValue().getActiveBits() > 32)
+        return -1;
+
+    return static_cast<int64_t>(literal->getValue().getZExtValue());
+}
+
+static bool refersTo(Expr *expr, const VarDecl *varDecl)
+{
+    auto declRef = expr ? dyn_cast<DeclRefExpr>(expr->IgnoreParenImpCasts()) : nullptr;
+    return declRef && declRef->getDecl() == varDecl;
+}
+
+// Returns the method if call is a member call, or a member operator call, on varDecl
+static CXXMethodDecl *methodCalledOn(CallExpr *call, const VarDecl *varDecl)
+{
+    if (auto memberCall = dyn_cast<CXXMemberCallExpr>(call))
+        return refersTo(memberCall->getImplicitObjectArgument(), varDecl) ? memberCall->getMethodDecl() : nullptr;
+
+    auto operatorCall = dyn_cast<CXXOperatorCallExpr>(call);
+    auto method = operatorCall ? dyn_cast_or_null<CXXMethodDecl>(operatorCall->getDirectCallee()) : nullptr;
+    return method && operatorCall->getNumArgs() > 0 && refersTo(operatorCall->getArg(0), varDecl) ? method : nullptr;
+}
+
+// Only methods which QVarLengthArray has too are accepted, so the suggestion compiles
+static MethodEffect methodEffect(const CXXMethodDecl *method, QualType elementType)
+{
+    if (!method)
+        return Effect_Unknown;
+
+    const StringRef name = clazy::name(method);
+    if (name == "emplace_back" || name == "emplace")
+        return Effect_Append;
+
+    static const clazy::NameSet appendMethods = { "append", "prepend", "push_back", "push_front", "insert",
+                                                  "operator<<", "operator+=" };
+    if (appendMethods.contains(name)) {
+        // Only the overloads taking a single element, not the ones taking another container or a count
+        const unsigned int numParams = method->getNumParams();
+        if (numParams == 0 || numParams > (name == "insert" ? 2 : 1))
+            return Effect_Unknown;
+
+        const QualType paramType = method->getParamDecl(numParams - 1)->getType().getNonReferenceType();
+        return paramType.getCanonicalType().getUnqualifiedType() == elementType.getCanonicalType() ? Effect_Append
+                                                                                                  : Effect_Unknown;
+    }
+
+    static const clazy::NameSet shrinkMethods = { "clear", "pop_back", "removeLast", "erase" };
+    if (shrinkMethods.contains(name))
+        return Effect_Shrink;
+
+    static const clazy::NameSet readMethods = { "at", "value", "size", "count", "length", "isEmpty", "empty",
+                                                "contains", "indexOf", "lastIndexOf", "data", "constData",
+                                                "begin", "end", "cbegin", "cend", "constBegin", "constEnd",
+                                                "rbegin", "rend", "front", "back", "first", "last", "operator[]" };
+    return readMethods.contains(name) ? Effect_None : Effect_Unknown;
+}
+
+static DeclStmt *declStmtFor(Stmt *body, const VarDecl *varDecl, const StmtIndex *index)
+{
+    for (DeclStmt *declStmt : index->statementsOfType<DeclStmt>(body)) {
+        if (std::find(declStmt->decl_begin(), declStmt->decl_end(), varDecl) != declStmt->decl_end())
+            return declStmt;
+    }
+
+    return nullptr;
+}
+
+static bool isCapturedByLambda(Stmt *body, const VarDecl *varDecl, const StmtIndex *index)
+{
+    for (LambdaExpr *lambda : index->statementsOfType<LambdaExpr>(body)) {
+        for (const LambdaCapture &capture : lambda->captures()) {
+            if (capture.capturesVariable() && capture.getCapturedVar() == varDecl)
+                return true;
+        }
+    }
+
+    return false;
+}
+
+void SmallLocalVector::VisitDecl(clang::Decl *decl)
+{
+    auto varDecl = dyn_cast<VarDecl>(decl);
+    if (!varDecl || isa<ParmVarDecl>(varDecl) || varDecl->isImplicit() || !varDecl->isLocalVarDecl()
+        || varDecl->isStaticLocal() || varDecl->getLocation().isMacroID())
+        return;
+
+    const char *vectorClass = vectorName(varDecl->getType());
+    auto record = vectorClass ? dyn_cast<ClassTemplateSpecializationDecl>(varDecl->getType()->getAsCXXRecordDecl()) : nullptr;
+    const QualType elementType = clazy::getTemplateArgumentType(record, 0);
+    if (elementType.isNull() || elementType->isDependentType() || elementType->isIncompleteType())
+        return;
+
+    int64_t maxSize = initialSize(varDecl);
+    auto function = dyn_cast<FunctionDecl>(varDecl->getDeclContext());
+    Stmt *body = function ? function->getBody() : nullptr;
+    const StmtIndex *index = m_context->functionStmtIndex(body);
+    DeclStmt *declStmt = index ? declStmtFor(body, varDecl, index) : nullptr;
+    if (maxSize < 0 || !declStmt || isCapturedByLambda(body, varDecl, index))
+        return;
+
+    // Besides method calls and range-loops over it, nothing can use the vector, or it would need to stay one
+    unsigned int numReferences = 0;
+    for (const StmtIndex::DeclUse &use : index->usesOf(varDecl, body)) {
+        if (use.kind == StmtIndex::DeclUse_Referenced)
+            ++numReferences;
+        else if (use.kind != StmtIndex::DeclUse_PassedToFunction) // Returned, assigned or its address taken
+            return;
+    }
+
+    vector<CallExpr *> calls;
+    for (CallExpr *call : index->statementsOfType<CallExpr>(body)) {
+        if (methodCalledOn(call, varDecl))
+            calls.push_back(call);
+    }
+
+    vector<Stmt *> loops;
+    unsigned int numRangeLoops = 0;
+    for (Stmt *stmt : index->statementsOfType<Stmt>(body)) {
+        if (!clazy::isLoop(stmt))
+            continue;
+
+        loops.push_back(stmt);
+        auto rangeLoop = dyn_cast<CXXForRangeStmt>(stmt);
+        if (rangeLoop && refersTo(rangeLoop->getRangeInit(), varDecl))
+            ++numRangeLoops;
+    }
+
+    if (numReferences != calls.size() + numRangeLoops) // Passed to a function, for example
+        return;
+
+    bool changesSize = false;
+    for (CallExpr *call : calls) {
+        const MethodEffect effect = methodEffect(methodCalledOn(call, varDecl), elementType);
+        if (effect == Effect_Unknown)
+            return;
+
+        changesSize |= effect != Effect_None;
+        if (effect != Effect_Append)
+            continue;
+
+        // A loop around the declaration creates a new vector on each iteration, only the ones in between count
+        int64_t numAppends = 1;
+        for (Stmt *loop : loops) {
+            if (!index->isDescendant(call, loop) || index->isDescendant(declStmt, loop))
+                continue;
+
+            const int64_t tripCount = clazy::constantTripCount(loop, *m_astContext);
+            if (tripCount < 0)
+                return;
+
+            numAppends *= tripCount;
+            if (numAppends > s_maxElements)
+                return;
+        }
+
+        maxSize += numAppends;
+        if (maxSize > s_maxElements)
+            return;
+    }
+
+    if (maxSize == 0 || maxSize > s_maxElements
+        || maxSize * m_astContext->getTypeSizeInChars(elementType).getQuantity() > s_maxBytes)
+        return;
+
+    const string element = clazy::simpleTypeName(elementType, lo());
+    const string count = std::to_string(maxSize);
+    const string suggestion = changesSize ? "QVarLengthArray<" + element + ", " + count + ">"
+                                          : "std::array<" + element + ", " + count + ">";
+    emitWarning(varDecl->getLocation(), string(vectorClass) + " never holds more than " + count
+                + (maxSize == 1 ? " element" : " elements") + "; consider " + suggestion + ", which doesn't allocate");
+}
@@ -0,0 +1,215 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "startup-latency.h"
+#include "ClazyContext.h"
+#include "StringUtils.h"
+#include "TypeUtils.h"
+#include "SourceCompatibilityHelpers.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/SourceManager.h>
+#include <clang/Basic/Specifiers.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+#include <vector>
+
+using namespace clang;
+using namespace std;
+
+StartupLatency::StartupLatency(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+}
+
+// Returns what makes the function slow, or nullptr if it's not known to be
+static const char *expensiveFunctionDescription(FunctionDecl *func)
+{
+    static const clazy::NameSet envFunctions = { "qgetenv", "qEnvironmentVariable", "qEnvironmentVariableIsSet",
+                                                 "qEnvironmentVariableIsEmpty", "qEnvironmentVariableIntValue",
+                                                 "getenv", "secure_getenv", "QProcessEnvironment::systemEnvironment" };
+    static const clazy::NameSet settingsMethods = { "QSettings::value", "QSettings::contains", "QSettings::allKeys",
+                                                    "QSettings::childKeys", "QSettings::childGroups" };
+    static const clazy::NameSet fileSystemFunctions = { "QStandardPaths::writableLocation", "QStandardPaths::standardLocations",
+                                                        "QStandardPaths::locate", "QStandardPaths::locateAll",
+                                                        "QStandardPaths::findExecutable", "QFile::open", "QFile::exists",
+                                                        "QFileInfo::exists", "QDir::exists", "QDir::entryList",
+                                                        "QDir::entryInfoList", "QDir::mkpath", "basic_ifstream::open",
+                                                        "basic_ofstream::open", "basic_fstream::open", "fopen" };
+    static const clazy::NameSet pluginFunctions = { "QPluginLoader::load", "QPluginLoader::instance", "QLibrary::load",
+                                                    "QLibrary::resolve", "QCoreApplication::libraryPaths", "dlopen" };
+
+    const string name = clazy::qualifiedMethodName(func);
+    if (envFunctions.contains(name))
+        return "reads the environment";
+
+    if (settingsMethods.contains(name))
+        return "reads the settings";
+
+    if (fileSystemFunctions.contains(name))
+        return "accesses the file system";
+
+    if (pluginFunctions.contains(name))
+        return "loads a library";
+
+    return nullptr;
+}
+
+// Opening a file stream when constructing it, as in std::ifstream stream("foo.txt")
+static bool opensFileStream(CXXConstructExpr *ctorExpr)
+{
+    static const clazy::NameSet fileStreams = { "basic_ifstream", "basic_ofstream", "basic_fstream" };
+    CXXConstructorDecl *ctorDecl = ctorExpr->getConstructor();
+    return ctorDecl && ctorDecl->getParent()->isInStdNamespace() && fileStreams.contains(clazy::name(ctorDecl->getParent()))
+           && ctorExpr->getNumArgs() > 0 && !isa<CXXDefaultArgExpr>(ctorExpr->getArg(0));
+}
+
+// Collects the calls and constructions which run when s runs, so not the ones inside lambdas which aren't called right away
+static void collectCalls(Stmt *s, vector<Expr *> &calls, bool followConstructors)
+{
+    if (!s || isa<LambdaExpr>(s))
+        return;
+
+    if (auto call = dyn_cast<CallExpr>(s)) {
+        calls.push_back(call);
+
+        // [] { ... }()
+        auto operatorCall = dyn_cast<CXXOperatorCallExpr>(call);
+        auto lambda = operatorCall && operatorCall->getNumArgs() > 0 ? dyn_cast<LambdaExpr>(operatorCall->getArg(0)->IgnoreImplicit())
+                                                                     : nullptr;
+        if (lambda)
+            collectCalls(lambda->getBody(), calls, followConstructors);
+    } else if (auto ctorExpr = dyn_cast<CXXConstructExpr>(s)) {
+        calls.push_back(ctorExpr);
+
+        CXXConstructorDecl *ctorDecl = ctorExpr->getConstructor();
+        if (followConstructors && ctorDecl && ctorDecl->hasBody() && !ctorDecl->getParent()->isInStdNamespace()) {
+            for (CXXCtorInitializer *init : ctorDecl->inits()) {
+                if (init->isWritten())
+                    collectCalls(init->getInit(), calls, false);
+            }
+
+            collectCalls(ctorDecl->getBody(), calls, false);
+        }
+    }
+
+    for (Stmt *child : s->children())
+        collectCalls(child, calls, followConstructors);
+}
+
+void StartupLatency::warnAboutExpensiveCalls(Stmt *stmt, const string &when, bool followConstructors, SourceLocation before)
+{
+    vector<Expr *> calls;
+    collectCalls(stmt, calls, followConstructors);
+
+    for (Expr *expr : calls) {
+        const SourceLocation loc = clazy::getLocStart(expr);
+        if (before.isValid() && !sm().isBeforeInTranslationUnit(loc, before))
+            continue;
+
+        if (auto call = dyn_cast<CallExpr>(expr)) {
+            FunctionDecl *func = call->getDirectCallee();
+            if (const char *description = func ? expensiveFunctionDescription(func) : nullptr)
+                emitWarning(loc, clazy::qualifiedMethodName(func) + "() " + description + " " + when + ", consider doing it lazily");
+        } else if (opensFileStream(cast<CXXConstructExpr>(expr))) {
+            emitWarning(loc, "Opening a file stream accesses the file system " + when + ", consider doing it lazily");
+        }
+    }
+}
+
+void StartupLatency::checkStaticInitialization(VarDecl *varDecl)
+{
+    if (!varDecl->isFileVarDecl() || varDecl->getStorageDuration() != SD_Static || varDecl->isConstexpr()
+        || !varDecl->getInit() || varDecl->getDeclContext()->isDependentContext())
+        return;
+
+    // The constructors of the application's own classes run during static initialization too
+    warnAboutExpensiveCalls(varDecl->getInit(), "during the static initialization of '" + varDecl->getNameAsString() + "'",
+                            /*followConstructors=*/ true);
+}
+
+void StartupLatency::checkMain(FunctionDecl *func)
+{
+    Stmt *body = func->getBody();
+    vector<Expr *> calls;
+    collectCalls(body, calls, /*followConstructors=*/ false);
+
+    // Only what runs before the event loop delays showing the application
+    for (Expr *expr : calls) {
+        auto call = dyn_cast<CallExpr>(expr);
+        auto method = call ? dyn_cast_or_null<CXXMethodDecl>(call->getDirectCallee()) : nullptr;
+        if (method && clazy::name(method) == "exec" && clazy::derivesFrom(method->getParent(), "QCoreApplication")) {
+            warnAboutExpensiveCalls(body, "in main() before exec()", /*followConstructors=*/ false, clazy::getLocStart(call));
+            return;
+        }
+    }
+}
+
+// Classes with a static instance() or self() returning themselves usually live as long as the application
+static bool isSingleton(CXXRecordDecl *record)
+{
+    for (auto method : record->methods()) {
+        const StringRef methodName = clazy::name(method);
+        if (!method->isStatic() || (methodName != "instance" && methodName != "self"))
+            continue;
+
+        const QualType returnType = method->getReturnType();
+        CXXRecordDecl *returnedRecord = returnType->getPointeeCXXRecordDecl();
+        if (returnedRecord && returnedRecord->getCanonicalDecl() == record->getCanonicalDecl())
+            return true;
+    }
+
+    return false;
+}
+
+void StartupLatency::checkSingletonConstructor(CXXConstructorDecl *ctorDecl)
+{
+    CXXRecordDecl *record = ctorDecl->getParent();
+    if (!ctorDecl->doesThisDeclarationHaveABody() || ctorDecl->isImplicit() || !isSingleton(record))
+        return;
+
+    const string when = "in the constructor of the " + record->getNameAsString() + " singleton";
+    for (CXXCtorInitializer *init : ctorDecl->inits()) {
+        if (init->isWritten())
+            warnAboutExpensiveCalls(init->getInit(), when, /*followConstructors=*/ false);
+    }
+
+    warnAboutExpensiveCalls(ctorDecl->getBody(), when, /*followConstructors=*/ false);
+}
+
+void StartupLatency::VisitDecl(clang::Decl *decl)
+{
+    if (auto varDecl = dyn_cast<VarDecl>(decl)) {
+        checkStaticInitialization(varDecl);
+    } else if (auto ctorDecl = dyn_cast<CXXConstructorDecl>(decl)) {
+        checkSingletonConstructor(ctorDecl);
+    } else if (auto func = dyn_cast<FunctionDecl>(decl)) {
+        if (func->isMain() && func->doesThisDeclarationHaveABody())
+            checkMain(func);
+    }
+}
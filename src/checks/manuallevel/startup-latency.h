@@ -0,0 +1,61 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_STARTUP_LATENCY_H
+#define CLAZY_STARTUP_LATENCY_H
+
+#include "checkbase.h"
+
+#include <clang/Basic/SourceLocation.h>
+
+#include <string>
+
+class ClazyContext;
+namespace clang {
+class CXXConstructorDecl;
+class Decl;
+class FunctionDecl;
+class Stmt;
+class VarDecl;
+}  // namespace clang
+
+/**
+ * Finds environment reads, settings and file system queries and plugin loading done during static
+ * initialization, in main() before the event loop starts, or in the constructor of singletons.
+ *
+ * See README-startup-latency.md for more info.
+ */
+class StartupLatency
+    : public CheckBase
+{
+public:
+    explicit StartupLatency(const std::string &name, ClazyContext *context);
+    void VisitDecl(clang::Decl *decl) override;
+private:
+    void checkStaticInitialization(clang::VarDecl *varDecl);
+    void checkMain(clang::FunctionDecl *func);
+    void checkSingletonConstructor(clang::CXXConstructorDecl *ctorDecl);
+    void warnAboutExpensiveCalls(clang::Stmt *stmt, const std::string &when, bool followConstructors,
+                                 clang::SourceLocation before = {});
+};
+
+#endif
@@ -0,0 +1,210 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+
+#include "std-function-overhead.h"
+#include "ClazyContext.h"
+#include "HierarchyUtils.h"
+#include "StringUtils.h"
+#include "TypeUtils.h"
+#include "Utils.h"
+#include "SourceCompatibilityHelpers.h"
+#include "clazy_stl.h"
+
+#include <clang/AST/ASTContext.h>
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/DeclTemplate.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/TemplateName.h>
+#include <clang/AST/Type.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/OperatorKinds.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using namespace clang;
+using namespace std;
+
+StdFunctionOverhead::StdFunctionOverhead(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+}
+
+static bool isStdFunction(QualType qualType)
+{
+    const QualType type = clazy::unrefQualType(qualType);
+    if (type.isNull())
+        return false;
+
+    if (CXXRecordDecl *record = type->getAsCXXRecordDecl())
+        return record->isInStdNamespace() && clazy::name(record) == "function";
+
+    // std::function<void(T)> inside a template
+    auto specialization = type->getAs<TemplateSpecializationType>();
+    TemplateDecl *templateDecl = specialization ? specialization->getTemplateName().getAsTemplateDecl() : nullptr;
+    return templateDecl && templateDecl->isInStdNamespace() && clazy::name(templateDecl) == "function";
+}
+
+static bool refersTo(Expr *expr, const ValueDecl *decl)
+{
+    auto declRef = expr ? dyn_cast<DeclRefExpr>(expr->IgnoreImplicit()) : nullptr;
+    return declRef && declRef->getDecl() == decl;
+}
+
+// Returns true if param is called at least once and otherwise only tested for emptiness
+static bool isOnlyCalled(Stmt *body, const ParmVarDecl *param)
+{
+    vector<DeclRefExpr *> refs;
+    clazy::getChilds<DeclRefExpr>(body, refs);
+    const long numUses = std::count_if(refs.cbegin(), refs.cend(), [param](DeclRefExpr *ref) { return ref->getDecl() == param; });
+    if (numUses == 0)
+        return false;
+
+    long numCalls = 0;
+    long numTests = 0;
+
+    vector<CallExpr *> calls;
+    clazy::getChilds<CallExpr>(body, calls);
+    for (CallExpr *call : calls) {
+        auto operatorCall = dyn_cast<CXXOperatorCallExpr>(call);
+        if (!operatorCall) {
+            // Inside templates the call isn't resolved to operator() yet
+            if (refersTo(call->getCallee(), param))
+                numCalls++;
+            continue;
+        }
+
+        if (operatorCall->getNumArgs() == 0 || !refersTo(operatorCall->getArg(0), param))
+            continue;
+
+        const OverloadedOperatorKind op = operatorCall->getOperator();
+        if (op == OO_Call)
+            numCalls++;
+        else if (op == OO_EqualEqual || op == OO_ExclaimEqual) // f != nullptr
+            numTests++;
+    }
+
+    // if (f), through operator bool()
+    vector<CXXMemberCallExpr *> memberCalls;
+    clazy::getChilds<CXXMemberCallExpr>(body, memberCalls);
+    for (CXXMemberCallExpr *memberCall : memberCalls) {
+        CXXMethodDecl *method = memberCall->getMethodDecl();
+        if (method && isa<CXXConversionDecl>(method) && refersTo(memberCall->getImplicitObjectArgument(), param))
+            numTests++;
+    }
+
+    return numCalls > 0 && numCalls + numTests == numUses;
+}
+
+// Returns the lambda expr is built from, if any
+static LambdaExpr *lambdaFor(Expr *expr)
+{
+    while (expr) {
+        expr = expr->IgnoreImplicit();
+        if (auto lambda = dyn_cast<LambdaExpr>(expr))
+            return lambda;
+
+        // The std::function constructor, taking the lambda
+        auto constructExpr = dyn_cast<CXXConstructExpr>(expr);
+        if (!constructExpr || constructExpr->getNumArgs() != 1)
+            return nullptr;
+        expr = constructExpr->getArg(0);
+    }
+
+    return nullptr;
+}
+
+void StdFunctionOverhead::VisitDecl(clang::Decl *decl)
+{
+    // std::function<void()> m_callback = [this, name] { ... };
+    if (auto field = dyn_cast<FieldDecl>(decl)) {
+        if (field->hasInClassInitializer())
+            checkStoredLambda(field, field->getInClassInitializer());
+        return;
+    }
+
+    auto func = dyn_cast<FunctionDecl>(decl);
+    if (!func || !func->doesThisDeclarationHaveABody() || func->isTemplateInstantiation() || func->isDeleted() || func->isDefaulted())
+        return;
+
+    // The constructor's initializers store their arguments
+    if (auto ctor = dyn_cast<CXXConstructorDecl>(func)) {
+        for (CXXCtorInitializer *init : ctor->inits()) {
+            if (init->isMemberInitializer() && init->isWritten())
+                checkStoredLambda(init->getMember(), init->getInit());
+        }
+        return;
+    }
+
+    // Virtual methods can't be templates, and lambdas are usually small enough to be inlined
+    auto method = dyn_cast<CXXMethodDecl>(func);
+    if (method && (method->isVirtual() || method->getParent()->isLambda()))
+        return;
+
+    Stmt *body = func->getBody();
+    for (ParmVarDecl *param : Utils::functionParameters(func)) {
+        if (param->getName().empty() || !isStdFunction(param->getType()) || !isOnlyCalled(body, param))
+            continue;
+
+        emitWarning(clazy::getLocStart(param), "std::function parameter '" + param->getName().str()
+                    + "' is only called, take the callable as a template parameter or a function_ref to avoid the type erasure");
+    }
+}
+
+void StdFunctionOverhead::VisitStmt(clang::Stmt *stmt)
+{
+    // m_callback = [this, name] { ... };
+    auto operatorCall = dyn_cast<CXXOperatorCallExpr>(stmt);
+    if (!operatorCall || operatorCall->getOperator() != OO_Equal || operatorCall->getNumArgs() != 2)
+        return;
+
+    auto memberExpr = dyn_cast<MemberExpr>(operatorCall->getArg(0)->IgnoreImplicit());
+    auto field = memberExpr ? dyn_cast<FieldDecl>(memberExpr->getMemberDecl()) : nullptr;
+    if (field)
+        checkStoredLambda(field, operatorCall->getArg(1));
+}
+
+void StdFunctionOverhead::checkStoredLambda(FieldDecl *field, Expr *init)
+{
+    if (!field || !init || !isStdFunction(field->getType()))
+        return;
+
+    LambdaExpr *lambda = lambdaFor(init);
+    if (!lambda || lambda->getType()->isDependentType())
+        return;
+
+    // libstdc++ stores up to two pointers inline, libc++ three, so bigger captures always allocate
+    const uint64_t captureBytes = m_astContext->getTypeSize(lambda->getType()) / 8;
+    const uint64_t smallBufferBytes = 2 * m_astContext->getTypeSize(m_astContext->VoidPtrTy) / 8;
+    if (captureBytes <= smallBufferBytes)
+        return;
+
+    emitWarning(clazy::getLocStart(lambda), "Lambda stored in std::function member '" + field->getName().str() + "' captures "
+                + std::to_string(captureBytes) + " bytes, more than fits its small buffer, so it's heap allocated");
+}
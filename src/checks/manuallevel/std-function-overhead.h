@@ -0,0 +1,57 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+
+#ifndef CLAZY_STD_FUNCTION_OVERHEAD_H
+#define CLAZY_STD_FUNCTION_OVERHEAD_H
+
+#include "checkbase.h"
+
+#include <string>
+
+class ClazyContext;
+
+namespace clang {
+class Decl;
+class Expr;
+class FieldDecl;
+class Stmt;
+}
+
+/**
+ * Finds std::function parameters which are only called, where a template parameter avoids the type erasure,
+ * and std::function members assigned lambdas too big for the small buffer.
+ *
+ * See README-std-function-overhead.md for more info.
+ */
+class StdFunctionOverhead
+    : public CheckBase
+{
+public:
+    explicit StdFunctionOverhead(const std::string &name, ClazyContext *context);
+    void VisitDecl(clang::Decl *decl) override;
+    void VisitStmt(clang::Stmt *stmt) override;
+private:
+    void checkStoredLambda(clang::FieldDecl *field, clang::Expr *init);
+};
+
+#endif
@@ -0,0 +1,164 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "string-concatenation-in-loop.h"
+#include "ClazyContext.h"
+#include "LoopUtils.h"
+#include "StmtIndex.h"
+#include "StringUtils.h"
+#include "Utils.h"
+#include "SourceCompatibilityHelpers.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/OperatorKinds.h>
+#include <clang/Basic/SourceManager.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+using namespace clang;
+using namespace std;
+
+StringConcatenationInLoop::StringConcatenationInLoop(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+}
+
+// Returns QString, QByteArray or std::string, or nullptr if expr isn't a string
+static const char *stringClassName(const Expr *expr)
+{
+    const CXXRecordDecl *record = expr->getType()->getAsCXXRecordDecl();
+    if (!record)
+        return nullptr;
+
+    const StringRef name = clazy::name(record);
+    if (record->isInStdNamespace())
+        return name == "basic_string" ? "std::string" : nullptr;
+
+    if (name == "QString")
+        return "QString";
+
+    return name == "QByteArray" ? "QByteArray" : nullptr;
+}
+
+static Expr *ignoreConversions(Expr *expr)
+{
+    expr = expr->IgnoreImplicit();
+
+    // A QStringBuilder is converted to the string by its conversion operator
+    auto memberCall = dyn_cast<CXXMemberCallExpr>(expr);
+    if (memberCall && dyn_cast_or_null<CXXConversionDecl>(memberCall->getMethodDecl()))
+        return memberCall->getImplicitObjectArgument()->IgnoreImplicit();
+
+    // Copies of temporaries, which are elided
+    auto construct = dyn_cast<CXXConstructExpr>(expr);
+    if (construct && construct->isElidable() && construct->getNumArgs() == 1)
+        return construct->getArg(0)->IgnoreImplicit();
+
+    return expr;
+}
+
+// Returns the operator+ or QStringBuilder's operator% call, if expr is one
+static CXXOperatorCallExpr *concatenation(Expr *expr)
+{
+    auto op = dyn_cast<CXXOperatorCallExpr>(ignoreConversions(expr));
+    if (op && op->getNumArgs() == 2 && (op->getOperator() == OO_Plus || op->getOperator() == OO_Percent))
+        return op;
+
+    return nullptr;
+}
+
+// Returns true if varDecl is one of the operands of the a + b + c chain
+static bool concatenates(Expr *expr, const VarDecl *varDecl)
+{
+    CXXOperatorCallExpr *op = concatenation(expr);
+    if (!op)
+        return false;
+
+    for (unsigned int i = 0; i < 2; ++i) {
+        auto declRef = dyn_cast<DeclRefExpr>(ignoreConversions(op->getArg(i)));
+        if ((declRef && declRef->getDecl() == varDecl) || concatenates(op->getArg(i), varDecl))
+            return true;
+    }
+
+    return false;
+}
+
+static bool isReserved(const StmtIndex *index, const VarDecl *varDecl)
+{
+    for (CXXMemberCallExpr *memberCall : index->statementsOfType<CXXMemberCallExpr>(index->root())) {
+        CXXMethodDecl *method = memberCall->getMethodDecl();
+        if (method && clazy::name(method) == "reserve" && Utils::valueDeclForMemberCall(memberCall) == varDecl)
+            return true;
+    }
+
+    return false;
+}
+
+void StringConcatenationInLoop::VisitStmt(clang::Stmt *stmt)
+{
+    auto op = dyn_cast<CXXOperatorCallExpr>(stmt);
+    if (!op || op->getNumArgs() != 2 || (op->getOperator() != OO_Equal && op->getOperator() != OO_PlusEqual))
+        return;
+
+    const char *className = stringClassName(op->getArg(0));
+    auto declRef = className ? dyn_cast<DeclRefExpr>(op->getArg(0)->IgnoreImplicit()) : nullptr;
+    auto varDecl = declRef ? dyn_cast<VarDecl>(declRef->getDecl()) : nullptr;
+    if (!varDecl || !varDecl->hasLocalStorage())
+        return;
+
+    const bool isAssignment = op->getOperator() == OO_Equal;
+    if (isAssignment) {
+        // s = s + x
+        if (!concatenates(op->getArg(1), varDecl))
+            return;
+    } else {
+        // s += a + b, which is fine if it's appending a QStringBuilder, as it doesn't create a temporary
+        const CXXRecordDecl *rhsRecord = op->getArg(1)->getType()->getAsCXXRecordDecl();
+        if (!concatenation(op->getArg(1)) || (rhsRecord && clazy::name(rhsRecord) == "QStringBuilder"))
+            return;
+    }
+
+    // Only strings accumulated across iterations, so declared before the loop, and not reserved already
+    Stmt *loop = clazy::isInLoop(m_context, stmt);
+    if (!loop || !sm().isBeforeInTranslationUnit(clazy::getLocStart(varDecl), clazy::getLocStart(loop)))
+        return;
+
+    const StmtIndex *index = m_context->functionStmtIndex(stmt);
+    if (!index || isReserved(index, varDecl))
+        return;
+
+    const string name = clazy::name(varDecl).str();
+    const StringRef type = className;
+    string error = isAssignment ? "'" + name + " = " + name + " + ...' copies the whole " + type.str() + " on every iteration, use +="
+                                : "'" + name + " += a + b' creates a temporary " + type.str() + " on every iteration, "
+                                  + (type == "std::string" ? "use += for each part" : "use += for each part or QStringBuilder");
+    error += " and reserve() it before the loop";
+    if (type != "std::string")
+        error += ", or collect the parts and use " + string(type == "QString" ? "QStringList" : "QByteArrayList") + "::join()";
+
+    emitWarning(clazy::getLocStart(stmt), error);
+}
@@ -0,0 +1,146 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "struct-padding.h"
+#include "StringUtils.h"
+#include "TemplateUtils.h"
+#include "SourceCompatibilityHelpers.h"
+#include "clazy_stl.h"
+
+#include <clang/AST/ASTContext.h>
+#include <clang/AST/CharUnits.h>
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/DeclTemplate.h>
+#include <clang/AST/RecordLayout.h>
+#include <clang/AST/Type.h>
+#include <clang/Basic/SourceManager.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+#include <algorithm>
+#include <stdlib.h>
+#include <vector>
+
+using namespace clang;
+using namespace std;
+
+StructPadding::StructPadding(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes)
+{
+    const char *minSize = getenv("CLAZY_STRUCT_PADDING_MIN_SIZE");
+    if (minSize)
+        m_minSize = atoi(minSize);
+}
+
+// Containers storing their elements contiguously, where padding is multiplied by the number of elements
+static bool isArrayContainer(const ClassTemplateSpecializationDecl *specialization)
+{
+    static const clazy::NameSet qtContainers = { "QVector", "QList", "QVarLengthArray", "QQueue", "QStack" };
+    static const clazy::NameSet stdContainers = { "vector", "deque", "array" };
+
+    const StringRef name = clazy::name(specialization);
+    if (qtContainers.contains(name))
+        return true;
+
+    return stdContainers.contains(name) && specialization->isInStdNamespace();
+}
+
+void StructPadding::VisitDecl(clang::Decl *decl)
+{
+    ClassTemplateSpecializationDecl *specialization = clazy::templateDeclOrMemberType(decl);
+
+    // Q_DECLARE_TYPEINFO specializes QTypeInfo
+    if (!specialization || (clazy::name(specialization) != "QTypeInfo" && !isArrayContainer(specialization)))
+        return;
+
+    const CXXRecordDecl *record = clazy::getTemplateArgumentRecord(specialization, 0);
+    if (record && m_checkedRecords.insert(record).second)
+        checkRecord(record->getDefinition());
+}
+
+namespace {
+
+struct Member {
+    const FieldDecl *field;
+    CharUnits size;
+    CharUnits alignment;
+};
+
+}
+
+void StructPadding::checkRecord(const CXXRecordDecl *record)
+{
+    if (!record || record->isInvalidDecl() || record->isDependentType() || record->isUnion() || record->getNumBases() > 0
+        || record->isDynamicClass() || isa<ClassTemplateSpecializationDecl>(record) || clazy::name(record).empty()
+        || sm().isInSystemHeader(clazy::getLocStart(record)))
+        return;
+
+    vector<Member> members;
+    CharUnits membersSize = CharUnits::Zero();
+    for (const FieldDecl *field : record->fields()) {
+        // The order of bit-fields and empty members is too subtle to suggest
+        const QualType type = field->getType();
+        if (field->isBitField() || clazy::name(field).empty() || type->isDependentType() || type->isIncompleteType())
+            return;
+
+        const CharUnits size = m_astContext->getTypeSizeInChars(type);
+        if (size.isZero())
+            return;
+
+        members.push_back({ field, size, m_astContext->getDeclAlign(field) });
+        membersSize += size;
+    }
+
+    if (members.size() < 2)
+        return;
+
+    const ASTRecordLayout &layout = m_astContext->getASTRecordLayout(record);
+    const CharUnits recordSize = layout.getSize();
+    if (recordSize.getQuantity() < m_minSize)
+        return;
+
+    // Sizes are multiples of alignments, so going from the biggest alignment to the smallest leaves no holes
+    std::stable_sort(members.begin(), members.end(), [](const Member &m1, const Member &m2) {
+        return m1.alignment > m2.alignment;
+    });
+
+    CharUnits optimalSize = CharUnits::Zero();
+    for (const Member &member : members)
+        optimalSize = optimalSize.alignTo(member.alignment) + member.size;
+    optimalSize = optimalSize.alignTo(layout.getAlignment());
+
+    if (optimalSize >= recordSize)
+        return;
+
+    string order;
+    for (const Member &member : members) {
+        if (!order.empty())
+            order += ", ";
+        order += clazy::name(member.field).str();
+    }
+
+    const CharUnits padding = recordSize - membersSize;
+    emitWarning(record, clazy::name(record).str() + " is " + to_string(recordSize.getQuantity()) + " bytes, of which "
+                + to_string(padding.getQuantity()) + " are padding, ordering its members as (" + order + ") makes it "
+                + to_string(optimalSize.getQuantity()) + " bytes");
+}
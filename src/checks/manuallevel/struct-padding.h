@@ -0,0 +1,57 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_STRUCT_PADDING_H
+#define CLAZY_STRUCT_PADDING_H
+
+#include "checkbase.h"
+
+#include <llvm/ADT/SmallPtrSet.h>
+
+#include <string>
+
+class ClazyContext;
+
+namespace clang {
+class CXXRecordDecl;
+class Decl;
+}
+
+/**
+ * Finds structs stored in QVector, std::vector and similar containers, or declared with Q_DECLARE_TYPEINFO,
+ * which would be smaller with their members reordered.
+ *
+ * See README-struct-padding.md for more info.
+ */
+class StructPadding
+    : public CheckBase
+{
+public:
+    explicit StructPadding(const std::string &name, ClazyContext *context);
+    void VisitDecl(clang::Decl *decl) override;
+private:
+    void checkRecord(const clang::CXXRecordDecl *record);
+    llvm::SmallPtrSet<const clang::CXXRecordDecl *, 32> m_checkedRecords;
+    unsigned int m_minSize = 0;
+};
+
+#endif
@@ -0,0 +1,148 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+
+#include "task-capture-copy.h"
+#include "ClazyContext.h"
+#include "StringUtils.h"
+#include "TypeUtils.h"
+#include "Utils.h"
+#include "SourceCompatibilityHelpers.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/LambdaCapture.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/Type.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/Lambda.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+using namespace clang;
+using namespace std;
+
+TaskCaptureCopy::TaskCaptureCopy(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
+{
+}
+
+// Returns the name of the function running its arguments in another thread, or an empty string
+static string taskSubmitter(Stmt *stmt)
+{
+    if (auto constructExpr = dyn_cast<CXXConstructExpr>(stmt)) {
+        CXXConstructorDecl *ctor = constructExpr->getConstructor();
+        if (!ctor || ctor->isCopyOrMoveConstructor() || !ctor->getParent()->isInStdNamespace())
+            return {};
+        const StringRef className = clazy::name(ctor->getParent());
+        return className == "thread" || className == "jthread" ? "std::" + className.str() : string();
+    }
+
+    auto call = dyn_cast<CallExpr>(stmt);
+    FunctionDecl *func = call ? call->getDirectCallee() : nullptr;
+    if (!func)
+        return {};
+
+    const string name = func->getQualifiedNameAsString();
+    if (name == "QtConcurrent::run" || name == "QThreadPool::start" || name == "QThreadPool::tryStart" || name == "QThread::create")
+        return name;
+
+    return func->isInStdNamespace() && clazy::name(func) == "async" ? "std::async" : string();
+}
+
+// Deep copies: containers, std::string and the structs holding them. Implicitly shared Qt classes are
+// a pointer big and smart pointers are meant to be copied.
+bool TaskCaptureCopy::isExpensiveToCopy(QualType qualType) const
+{
+    const QualType type = clazy::unrefQualType(qualType);
+    if (type.isNull() || type->isDependentType())
+        return false;
+
+    CXXRecordDecl *record = type->getAsCXXRecordDecl();
+    if (!record || Utils::isSharedPointer(record))
+        return false;
+
+    clazy::QualTypeClassification classif;
+    return clazy::classifyQualType(m_context, type, nullptr, classif) && classif.isBig && classif.isNonTriviallyCopyable;
+}
+
+static Expr *skipConversions(Expr *expr)
+{
+    // A lambda passed where a std::function is expected is wrapped in its constructor
+    while (true) {
+        expr = expr->IgnoreImplicit();
+        auto constructExpr = dyn_cast<CXXConstructExpr>(expr);
+        if (!constructExpr || constructExpr->getNumArgs() != 1 || isa<CXXTemporaryObjectExpr>(constructExpr))
+            return expr;
+        expr = constructExpr->getArg(0);
+    }
+}
+
+void TaskCaptureCopy::VisitStmt(clang::Stmt *stmt)
+{
+    const string submitter = taskSubmitter(stmt);
+    if (submitter.empty())
+        return;
+
+    if (auto constructExpr = dyn_cast<CXXConstructExpr>(stmt)) {
+        for (Expr *arg : constructExpr->arguments())
+            checkArgument(arg, submitter);
+    } else {
+        for (Expr *arg : cast<CallExpr>(stmt)->arguments())
+            checkArgument(arg, submitter);
+    }
+}
+
+void TaskCaptureCopy::checkArgument(Expr *arg, const string &submitter)
+{
+    arg = skipConversions(arg);
+    if (auto lambda = dyn_cast<LambdaExpr>(arg)) {
+        for (const LambdaCapture &capture : lambda->captures()) {
+            // [data = std::move(data)] is what we suggest
+            if (capture.getCaptureKind() != LCK_ByCopy || !capture.capturesVariable() || lambda->isInitCapture(&capture))
+                continue;
+
+            auto varDecl = dyn_cast_or_null<VarDecl>(capture.getCapturedVar());
+            if (varDecl && isExpensiveToCopy(varDecl->getType())) {
+                const SourceLocation loc = capture.isImplicit() ? clazy::getLocStart(lambda) : capture.getLocation();
+                emitWarning(loc, "Task passed to " + submitter + "() copies the captured " + varDecl->getNameAsString() + " ("
+                            + clazy::simpleTypeName(varDecl->getType(), lo()) + "), capture it with std::move() or share it with a std::shared_ptr");
+            }
+        }
+        return;
+    }
+
+    // Arguments are decay-copied into the task, unless they're moved in
+    if (!isa<DeclRefExpr>(arg) && !isa<MemberExpr>(arg))
+        return;
+
+    auto valueDecl = isa<DeclRefExpr>(arg) ? cast<DeclRefExpr>(arg)->getDecl() : cast<MemberExpr>(arg)->getMemberDecl();
+    if (!isa<VarDecl>(valueDecl) && !isa<FieldDecl>(valueDecl))
+        return;
+
+    if (isExpensiveToCopy(valueDecl->getType())) {
+        emitWarning(clazy::getLocStart(arg), "Task passed to " + submitter + "() copies the argument " + valueDecl->getNameAsString() + " ("
+                    + clazy::simpleTypeName(valueDecl->getType(), lo()) + "), pass it with std::move() or share it with a std::shared_ptr");
+    }
+}
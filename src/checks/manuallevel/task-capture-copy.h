@@ -0,0 +1,57 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+
+#ifndef CLAZY_TASK_CAPTURE_COPY_H
+#define CLAZY_TASK_CAPTURE_COPY_H
+
+#include "checkbase.h"
+
+#include <string>
+
+class ClazyContext;
+
+namespace clang {
+class Stmt;
+class Expr;
+class ValueDecl;
+class QualType;
+}
+
+/**
+ * Finds tasks submitted to QtConcurrent::run(), QThreadPool, std::async() and std::thread which deep copy
+ * big captures or arguments.
+ *
+ * See README-task-capture-copy.md for more info.
+ */
+class TaskCaptureCopy
+    : public CheckBase
+{
+public:
+    explicit TaskCaptureCopy(const std::string &name, ClazyContext *context);
+    void VisitStmt(clang::Stmt *stmt) override;
+private:
+    void checkArgument(clang::Expr *arg, const std::string &submitter);
+    bool isExpensiveToCopy(clang::QualType qualType) const;
+};
+
+#endif
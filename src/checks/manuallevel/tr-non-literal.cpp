@@ -22,6 +22,7 @@
 
 #include "tr-non-literal.h"
 #include "HierarchyUtils.h"
+#include "StringUtils.h"
 
 #include <clang/AST/Decl.h>
 #include <clang/AST/Expr.h>
@@ -36,7 +37,7 @@ using namespace std;
 
 
 TrNonLiteral::TrNonLiteral(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
 {
 }
 
@@ -47,7 +48,7 @@ void TrNonLiteral::VisitStmt(clang::Stmt *stmt)
         return;
 
     FunctionDecl *func = callExpr->getDirectCallee();
-    if (!func || func->getQualifiedNameAsString() != "QObject::tr")
+    if (!func || !clazy::qualifiedNameIs(func, "QObject::tr"))
         return;
 
     Expr *arg1 = callExpr->getArg(0);
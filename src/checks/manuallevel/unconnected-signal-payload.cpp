@@ -0,0 +1,233 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "unconnected-signal-payload.h"
+#include "AccessSpecifierManager.h"
+#include "ClazyContext.h"
+#include "HierarchyUtils.h"
+#include "StmtIndex.h"
+#include "StringUtils.h"
+#include "SourceCompatibilityHelpers.h"
+#include "TypeUtils.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/StmtCXX.h>
+#include <clang/Basic/CharInfo.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/OperatorKinds.h>
+#include <clang/Basic/SourceLocation.h>
+#include <clang/Basic/SourceManager.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+using namespace clang;
+using namespace std;
+
+UnconnectedSignalPayload::UnconnectedSignalPayload(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes)
+{
+    context->enableAccessSpecifierManager();
+    m_filesToIgnore = { "moc_", ".moc" };
+}
+
+// Strips the implicit casts, temporaries and copies between the argument and what builds it
+static Expr *skipImplicit(Expr *expr)
+{
+    while (expr) {
+        expr = expr->IgnoreImplicit();
+        if (auto paren = dyn_cast<ParenExpr>(expr)) {
+            expr = paren->getSubExpr();
+            continue;
+        }
+
+        auto construct = dyn_cast<CXXConstructExpr>(expr);
+        if (!construct || isa<CXXTemporaryObjectExpr>(construct) || construct->getNumArgs() != 1
+            || !construct->getConstructor()->isCopyOrMoveConstructor())
+            return expr;
+
+        expr = construct->getArg(0);
+    }
+
+    return expr;
+}
+
+static bool isLoop(Stmt *stmt)
+{
+    return isa<ForStmt>(stmt) || isa<CXXForRangeStmt>(stmt) || isa<WhileStmt>(stmt) || isa<DoStmt>(stmt);
+}
+
+// Small trivial types, like enums, QPoint or QLatin1String, cost nothing to build
+bool UnconnectedSignalPayload::isPayloadType(QualType qt) const
+{
+    qt = clazy::unrefQualType(qt);
+    return !qt.isNull() && qt->getAsCXXRecordDecl() && !clazy::isSmallTrivial(m_context, qt);
+}
+
+// Returns true if expr builds a new payload, rather than passing on an existing object
+bool UnconnectedSignalPayload::buildsPayload(Expr *expr) const
+{
+    expr = skipImplicit(expr);
+
+    // QStringLiteral and friends are cheap
+    if (!expr || expr->isGLValue() || clazy::getLocStart(expr).isMacroID() || !isPayloadType(expr->getType()))
+        return false;
+
+    if (isa<InitListExpr>(expr))
+        return true;
+
+    if (auto construct = dyn_cast<CXXConstructExpr>(expr)) {
+        // QVariantMap{ { "key", value } }, or QVariant(list.join(','))
+        for (Expr *arg : construct->arguments()) {
+            if (isa<CXXStdInitializerListExpr>(arg->IgnoreImplicit()) || buildsPayload(arg))
+                return true;
+        }
+
+        return false;
+    }
+
+    if (auto opCall = dyn_cast<CXXOperatorCallExpr>(expr)) {
+        // Concatenations, as in "Loading " + fileName, or with QStringBuilder
+        const OverloadedOperatorKind op = opCall->getOperator();
+        return op == OO_Plus || op == OO_Percent;
+    }
+
+    if (auto call = dyn_cast<CallExpr>(expr)) {
+        // Getters returning a copy of a member don't build anything, conversions, like toString(), do
+        auto memberCall = dyn_cast<CXXMemberCallExpr>(call);
+        CXXMethodDecl *method = memberCall ? memberCall->getMethodDecl() : nullptr;
+        if (method && !isa<CXXConversionDecl>(method) && method->isConst() && call->getNumArgs() == 0) {
+            const StringRef name = clazy::name(method);
+            return name.size() > 2 && name.startswith("to") && isUppercase(name[2]);
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+// Returns true if the use modifies the variable, as in payload.insert(key, value) or payload << value
+bool UnconnectedSignalPayload::fills(DeclRefExpr *use) const
+{
+    Stmt *parent = clazy::parent(m_context, use);
+    while (parent && (isa<ImplicitCastExpr>(parent) || isa<ParenExpr>(parent)))
+        parent = clazy::parent(m_context, parent);
+
+    if (auto memberExpr = dyn_cast_or_null<MemberExpr>(parent)) {
+        auto call = dyn_cast_or_null<CXXMemberCallExpr>(clazy::parent(m_context, memberExpr));
+        CXXMethodDecl *method = call && call->getCallee() == memberExpr ? call->getMethodDecl() : nullptr;
+        return method && !method->isConst();
+    }
+
+    if (auto opCall = dyn_cast_or_null<CXXOperatorCallExpr>(parent)) {
+        auto method = dyn_cast_or_null<CXXMethodDecl>(opCall->getDirectCallee());
+        return method && !method->isConst() && opCall->getNumArgs() > 0 && opCall->getArg(0)->IgnoreImpCasts() == use;
+    }
+
+    return false;
+}
+
+// QVariantMap payload; payload.insert(...); emit changed(payload); with payload not used after the emit
+bool UnconnectedSignalPayload::isBuiltForEmit(Expr *arg, CXXMemberCallExpr *signalCall, Stmt *body) const
+{
+    auto declRef = dyn_cast_or_null<DeclRefExpr>(skipImplicit(arg));
+    auto varDecl = declRef ? dyn_cast<VarDecl>(declRef->getDecl()) : nullptr;
+    if (!varDecl || !varDecl->isLocalVarDecl() || varDecl->isStaticLocal() || varDecl->getType()->isReferenceType()
+        || !isPayloadType(varDecl->getType()))
+        return false;
+
+    // Declared outside of the loop the emit is in, it's still used after the emit, by the next iteration
+    const SourceLocation declLoc = clazy::getLocStart(varDecl);
+    for (Stmt *parent = clazy::parent(m_context, signalCall); parent && parent != body; parent = clazy::parent(m_context, parent)) {
+        if (isLoop(parent))
+            return !sm().isBeforeInTranslationUnit(declLoc, clazy::getLocStart(parent)) && isBuiltForEmit(arg, signalCall, parent);
+    }
+
+    bool isBuilt = varDecl->hasInit() && buildsPayload(varDecl->getInit());
+    const SourceLocation emitEnd = clazy::getLocEnd(signalCall);
+    for (DeclRefExpr *use : clazy::getStatements<DeclRefExpr>(m_context->functionStmtIndex(body), body)) {
+        if (use->getDecl() != varDecl || use == declRef)
+            continue;
+
+        if (sm().isBeforeInTranslationUnit(emitEnd, clazy::getLocStart(use)))
+            return false;
+
+        isBuilt = isBuilt || fills(use);
+    }
+
+    return isBuilt;
+}
+
+// isSignalConnected() or receivers() anywhere in the function, as in if (isSignalConnected(...)) or an early return
+bool UnconnectedSignalPayload::checksReceivers(Stmt *body)
+{
+    if (body == m_lastBody)
+        return m_lastBodyChecksReceivers;
+
+    static const clazy::NameSet receiverMethods = { "isSignalConnected", "receivers" };
+    m_lastBody = body;
+    m_lastBodyChecksReceivers = false;
+    for (CallExpr *call : clazy::getStatements<CallExpr>(m_context->functionStmtIndex(body), body)) {
+        FunctionDecl *func = call->getDirectCallee();
+        if (func && clazy::functionIsOneOf(func, receiverMethods)) {
+            m_lastBodyChecksReceivers = true;
+            break;
+        }
+    }
+
+    return m_lastBodyChecksReceivers;
+}
+
+void UnconnectedSignalPayload::VisitStmt(clang::Stmt *stmt)
+{
+    auto signalCall = dyn_cast<CXXMemberCallExpr>(stmt);
+    CXXMethodDecl *method = signalCall ? signalCall->getMethodDecl() : nullptr;
+    AccessSpecifierManager *accessSpecifierManager = m_context->accessSpecifierManager;
+    if (!method || !accessSpecifierManager || signalCall->getNumArgs() == 0)
+        return;
+
+    // isSignalConnected() is protected, so only emits of our own signals can be guarded with it
+    Expr *object = signalCall->getImplicitObjectArgument();
+    if (!object || !isa<CXXThisExpr>(object->IgnoreParenImpCasts()))
+        return;
+
+    FunctionDecl *func = m_context->lastFunctionDecl;
+    Stmt *body = func ? func->getBody() : nullptr;
+    if (!body || shouldIgnoreFile(clazy::getLocStart(stmt)))
+        return;
+
+    if (accessSpecifierManager->qtAccessSpecifierType(method) != QtAccessSpecifier_Signal || checksReceivers(body))
+        return;
+
+    for (Expr *arg : signalCall->arguments()) {
+        if (buildsPayload(arg) || isBuiltForEmit(arg, signalCall, body)) {
+            const string signalName = method->getQualifiedNameAsString();
+            emitFormattedWarning(clazy::getLocStart(arg), "Payload of signal %0 is built even if nothing is connected to it; "
+                                 "guard with isSignalConnected(QMetaMethod::fromSignal(&%0)), or cache it", { signalName });
+            return;
+        }
+    }
+}
@@ -0,0 +1,63 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_UNCONNECTED_SIGNAL_PAYLOAD_H
+#define CLAZY_UNCONNECTED_SIGNAL_PAYLOAD_H
+
+#include "checkbase.h"
+
+#include <clang/AST/Type.h>
+
+#include <string>
+
+class ClazyContext;
+
+namespace clang {
+class CXXMemberCallExpr;
+class DeclRefExpr;
+class Expr;
+class Stmt;
+}
+
+/**
+ * Finds signals emitted with arguments built just for the emit, without checking isSignalConnected() first.
+ *
+ * See README-unconnected-signal-payload.md for more info.
+ */
+class UnconnectedSignalPayload
+    : public CheckBase
+{
+public:
+    explicit UnconnectedSignalPayload(const std::string &name, ClazyContext *context);
+    void VisitStmt(clang::Stmt *stmt) override;
+private:
+    bool isPayloadType(clang::QualType qt) const;
+    bool buildsPayload(clang::Expr *expr) const;
+    bool isBuiltForEmit(clang::Expr *arg, clang::CXXMemberCallExpr *signalCall, clang::Stmt *body) const;
+    bool fills(clang::DeclRefExpr *use) const;
+    bool checksReceivers(clang::Stmt *body);
+
+    clang::Stmt *m_lastBody = nullptr;
+    bool m_lastBodyChecksReceivers = false;
+};
+
+#endif
@@ -44,7 +44,7 @@ using namespace llvm;
 using namespace clang;
 
 UnneededCast::UnneededCast(const std::string &name, ClazyContext *context)
-    : CheckBase(name, context, Option_CanIgnoreIncludes)
+    : CheckBase(name, context, Option_CanIgnoreIncludes | Option_Reusable)
 {
 }
 
@@ -83,7 +83,7 @@ bool UnneededCast::handleNamedCast(CXXNamedCastExpr *namedCast)
         }
 
         // static_cast to base is needed in ternary operators
-        if (clazy::getFirstParentOfType<ConditionalOperator>(m_context->parentMap, namedCast) != nullptr)
+        if (clazy::getFirstParentOfType<ConditionalOperator>(m_context, namedCast) != nullptr)
             return false;
     }
 
@@ -118,7 +118,7 @@ bool UnneededCast::maybeWarn(Stmt *stmt, CXXRecordDecl *castFrom, CXXRecordDecl
         return true;
     } else if (clazy::derivesFrom(/*child=*/ castFrom, castTo)) {
         if (isQObjectCast) {
-            const bool isTernaryOperator = clazy::getFirstParentOfType<ConditionalOperator>(m_context->parentMap, stmt) != nullptr;
+            const bool isTernaryOperator = clazy::getFirstParentOfType<ConditionalOperator>(m_context, stmt) != nullptr;
             if (isTernaryOperator) {
                 emitWarning(clazy::getLocStart(stmt), "use static_cast instead of qobject_cast");
             } else {
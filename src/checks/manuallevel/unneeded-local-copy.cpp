@@ -0,0 +1,195 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "unneeded-local-copy.h"
+#include "ClazyContext.h"
+#include "FixItUtils.h"
+#include "HierarchyUtils.h"
+#include "StmtBodyRange.h"
+#include "StmtIndex.h"
+#include "SourceCompatibilityHelpers.h"
+#include "TypeUtils.h"
+#include "Utils.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/LambdaCapture.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/StmtCXX.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/Lambda.h>
+#include <clang/Basic/SourceLocation.h>
+#include <llvm/Support/Casting.h>
+
+#include <vector>
+
+using namespace clang;
+using namespace std;
+
+UnneededLocalCopy::UnneededLocalCopy(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes)
+{
+}
+
+bool UnneededLocalCopy::isInConstMethod() const
+{
+    auto method = dyn_cast_or_null<CXXMethodDecl>(m_context->lastFunctionDecl);
+    return method && method->isConst();
+}
+
+// Returns true if expr refers to an object which can't be modified nor destroyed while a local initialized from it is alive
+bool UnneededLocalCopy::isStableLvalue(Expr *expr) const
+{
+    expr = expr->IgnoreParenImpCasts();
+
+    // Whatever a variable in scope refers to, outlives the variables declared after it
+    if (auto declRef = dyn_cast<DeclRefExpr>(expr)) {
+        auto varDecl = dyn_cast<VarDecl>(declRef->getDecl());
+        return varDecl && clazy::unrefQualType(varDecl->getType()).isConstQualified();
+    }
+
+    // Members, in const methods: m_items, or other.m_items when other is a const reference
+    if (auto memberExpr = dyn_cast<MemberExpr>(expr)) {
+        auto field = dyn_cast<FieldDecl>(memberExpr->getMemberDecl());
+        if (!field || field->isMutable() || field->getType()->isReferenceType())
+            return false;
+
+        Expr *base = memberExpr->getBase()->IgnoreParenImpCasts();
+        if (isa<CXXThisExpr>(base))
+            return isInConstMethod();
+
+        return !memberExpr->isArrow() && isStableLvalue(base);
+    }
+
+    // Getters returning a const reference, like list.at(0) or name() in a const method
+    if (auto memberCall = dyn_cast<CXXMemberCallExpr>(expr)) {
+        CXXMethodDecl *method = memberCall->getMethodDecl();
+        const QualType returnType = method ? method->getReturnType() : QualType();
+        if (!method || !method->isConst() || !returnType->isLValueReferenceType()
+            || !returnType->getPointeeType().isConstQualified())
+            return false;
+
+        Expr *object = memberCall->getImplicitObjectArgument();
+        object = object ? object->IgnoreParenImpCasts() : nullptr;
+        if (!object)
+            return false;
+
+        return isa<CXXThisExpr>(object) ? isInConstMethod() : isStableLvalue(object);
+    }
+
+    return false;
+}
+
+// Returns true if the local copy is, or might be, modified, in which case a reference wouldn't compile or would change
+// the source too.
+bool UnneededLocalCopy::isModified(const VarDecl *varDecl, Stmt *body) const
+{
+    const StmtIndex *index = m_context->functionStmtIndex(body);
+    if (Utils::containsNonConstMemberCall(m_context->parentMap, body, varDecl)
+        || Utils::isAssignedFrom(body, varDecl, index) || Utils::isReturned(body, varDecl, index)
+        || Utils::isPassedToFunction(StmtBodyRange(body, nullptr, {}, index), varDecl, true)
+        || Utils::addressIsTaken(body, varDecl, index))
+        return true;
+
+    // T &ref = copy
+    for (DeclStmt *declStmt : clazy::getStatements<DeclStmt>(index, body)) {
+        for (Decl *decl : declStmt->decls()) {
+            auto ref = dyn_cast<VarDecl>(decl);
+            const QualType refType = ref ? ref->getType() : QualType();
+            if (refType.isNull() || ref->isImplicit() || !refType->isReferenceType() || refType->getPointeeType().isConstQualified()
+                || !ref->hasInit())
+                continue;
+
+            auto declRef = dyn_cast<DeclRefExpr>(ref->getInit()->IgnoreParenImpCasts());
+            if (declRef && declRef->getDecl() == varDecl)
+                return true;
+        }
+    }
+
+    // for (auto &item : copy), its hidden range variable is always a non-const reference, so look at the items
+    for (CXXForRangeStmt *rangeLoop : clazy::getStatements<CXXForRangeStmt>(index, body)) {
+        auto declRef = dyn_cast<DeclRefExpr>(rangeLoop->getRangeInit()->IgnoreParenImpCasts());
+        const QualType itemType = rangeLoop->getLoopVariable()->getType();
+        if (declRef && declRef->getDecl() == varDecl && itemType->isReferenceType() && !itemType->getPointeeType().isConstQualified())
+            return true;
+    }
+
+    // Lambdas capturing it by reference can do any of the above, we don't look into their bodies
+    for (LambdaExpr *lambda : clazy::getStatements<LambdaExpr>(index, body)) {
+        for (const LambdaCapture &capture : lambda->captures()) {
+            if (capture.capturesVariable() && capture.getCaptureKind() == LCK_ByRef
+                && static_cast<const Decl *>(capture.getCapturedVar()) == varDecl)
+                return true;
+        }
+    }
+
+    return false;
+}
+
+void UnneededLocalCopy::VisitStmt(clang::Stmt *stmt)
+{
+    auto declStmt = dyn_cast<DeclStmt>(stmt);
+    if (!declStmt || !declStmt->isSingleDecl() || clazy::getLocStart(declStmt).isMacroID())
+        return;
+
+    auto varDecl = dyn_cast<VarDecl>(declStmt->getSingleDecl());
+    if (!varDecl || !varDecl->isLocalVarDecl() || varDecl->isStaticLocal() || varDecl->isImplicit()
+        || varDecl->getType()->isReferenceType() || !varDecl->hasInit())
+        return;
+
+    // Loop variables are for range-loop
+    FunctionDecl *func = m_context->lastFunctionDecl;
+    Stmt *body = func ? func->getBody() : nullptr;
+    if (!body || func->isTemplateInstantiation() || dyn_cast_or_null<CXXForRangeStmt>(clazy::parent(m_context, declStmt)))
+        return;
+
+    // Copy-constructed from an lvalue, conversions and temporaries aren't copies
+    auto construct = dyn_cast<CXXConstructExpr>(varDecl->getInit()->IgnoreImplicit());
+    CXXConstructorDecl *ctor = construct ? construct->getConstructor() : nullptr;
+    if (!ctor || !ctor->isCopyConstructor() || construct->getNumArgs() != 1 || !construct->getArg(0)->isLValue())
+        return;
+
+    // Small trivially copyable types are cheaper to copy than to reference
+    const QualType type = varDecl->getType();
+    const CXXRecordDecl *record = type->getAsCXXRecordDecl();
+    if (!record || clazy::isSmallTrivial(m_context, type) || !isStableLvalue(construct->getArg(0)))
+        return;
+
+    const bool isConst = type.isConstQualified();
+    if (!isConst && isModified(varDecl, body))
+        return;
+
+    if (shouldIgnoreFile(clazy::getLocStart(declStmt)))
+        return;
+
+    vector<FixItHint> fixits;
+    if (isConst && varDecl->getLocation().isFileID())
+        fixits.push_back(clazy::createInsertion(varDecl->getLocation(), "&"));
+
+    // Unlike Qt's implicitly shared classes, copying these copies all of their contents
+    const char *format = record->isInStdNamespace()
+        ? "%0 is a deep copy of an object that outlives it, and neither is modified; use a const reference"
+        : "%0 is a copy of an object that outlives it, and neither is modified; use a const reference";
+    emitFormattedWarning(varDecl->getLocation(), format, { varDecl->getName() }, fixits);
+}
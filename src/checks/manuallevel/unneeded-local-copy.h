@@ -0,0 +1,55 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_UNNEEDED_LOCAL_COPY_H
+#define CLAZY_UNNEEDED_LOCAL_COPY_H
+
+#include "checkbase.h"
+
+#include <string>
+
+class ClazyContext;
+
+namespace clang {
+class Expr;
+class Stmt;
+class VarDecl;
+}
+
+/**
+ * Finds local variables copied from an object that outlives them, when neither is modified.
+ *
+ * See README-unneeded-local-copy.md for more info.
+ */
+class UnneededLocalCopy
+    : public CheckBase
+{
+public:
+    explicit UnneededLocalCopy(const std::string &name, ClazyContext *context);
+    void VisitStmt(clang::Stmt *stmt) override;
+private:
+    bool isInConstMethod() const;
+    bool isStableLvalue(clang::Expr *expr) const;
+    bool isModified(const clang::VarDecl *varDecl, clang::Stmt *body) const;
+};
+
+#endif
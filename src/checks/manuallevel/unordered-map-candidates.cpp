@@ -0,0 +1,421 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#include "unordered-map-candidates.h"
+#include "StringUtils.h"
+#include "TemplateUtils.h"
+#include "TypeUtils.h"
+#include "SourceCompatibilityHelpers.h"
+
+#include <clang/AST/ASTContext.h>
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/DeclTemplate.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/AST/Type.h>
+#include <clang/Basic/IdentifierTable.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/OperatorKinds.h>
+#include <clang/Basic/SourceManager.h>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/SmallPtrSet.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+#include <vector>
+
+using namespace clang;
+using namespace std;
+
+enum MapKind {
+    MapKind_None = 0,
+    MapKind_QMap,
+    MapKind_StdMap
+};
+
+// Maps built from initializer lists up to this size, and never modified, get a sorted vector suggested
+static const int s_smallMapSize = 16;
+
+namespace {
+
+struct MapUses
+{
+    bool isLookedUp = false;
+    bool escapes = false; // Iterated, in key order, or used in a way we don't follow
+    bool isWrittenAfterConstruction = false;
+};
+
+// Follows how the tracked maps are used by the code it walks
+class MapUseCollector
+{
+public:
+    void track(const ValueDecl *decl)
+    {
+        m_uses[decl->getCanonicalDecl()];
+    }
+
+    // Returns true if decl was looked up, and not used in any other way than lookups and modifications
+    bool isLookupOnly(const ValueDecl *decl) const
+    {
+        const MapUses &uses = m_uses.find(decl->getCanonicalDecl())->second;
+        return uses.isLookedUp && !uses.escapes;
+    }
+
+    bool isReadOnly(const ValueDecl *decl) const
+    {
+        return !m_uses.find(decl->getCanonicalDecl())->second.isWrittenAfterConstruction;
+    }
+
+    void walk(Stmt *stmt, bool inConstructor);
+
+private:
+    MapUses *usesFor(Expr *expr);
+    void addCall(MapUses &uses, CXXMethodDecl *method, bool inConstructor);
+    llvm::DenseMap<const Decl *, MapUses> m_uses;
+    llvm::SmallPtrSet<const Expr *, 16> m_consumed; // References to tracked maps which were the object of a call we classified
+};
+
+}
+
+static const ValueDecl *referencedDecl(const Expr *expr)
+{
+    expr = expr->IgnoreParenImpCasts();
+    if (auto declRef = dyn_cast<DeclRefExpr>(expr))
+        return declRef->getDecl();
+    if (auto member = dyn_cast<MemberExpr>(expr))
+        return member->getMemberDecl();
+
+    return nullptr;
+}
+
+MapUses *MapUseCollector::usesFor(Expr *expr)
+{
+    const ValueDecl *decl = referencedDecl(expr);
+    auto it = decl ? m_uses.find(decl->getCanonicalDecl()) : m_uses.end();
+    if (it == m_uses.end())
+        return nullptr;
+
+    m_consumed.insert(expr->IgnoreParenImpCasts());
+    return &it->second;
+}
+
+void MapUseCollector::addCall(MapUses &uses, CXXMethodDecl *method, bool inConstructor)
+{
+    static const clazy::NameSet lookups = { "value", "contains", "count", "size", "isEmpty", "empty",
+                                            "find", "constFind", "end", "cend", "constEnd", "at" };
+    static const clazy::NameSet writes = { "insert", "insertMulti", "emplace", "remove", "erase", "take", "clear" };
+
+    bool isLookup = false;
+    bool isWrite = false;
+    switch (method ? method->getOverloadedOperator() : OO_None) {
+    case OO_None:
+        isLookup = method && lookups.contains(clazy::name(method));
+        isWrite = method && writes.contains(clazy::name(method));
+        break;
+    case OO_Subscript:
+        isLookup = true;
+        isWrite = !method->isConst(); // Inserts if the key isn't there
+        break;
+    case OO_Equal:
+        isWrite = true;
+        break;
+    case OO_EqualEqual:
+    case OO_ExclaimEqual:
+        return;
+    default:
+        break;
+    }
+
+    if (!isLookup && !isWrite) {
+        uses.escapes = true; // begin(), keys(), firstKey(), lowerBound() and anything we don't know
+        return;
+    }
+
+    uses.isLookedUp |= isLookup;
+    if (isWrite && !inConstructor)
+        uses.isWrittenAfterConstruction = true;
+}
+
+void MapUseCollector::walk(Stmt *stmt, bool inConstructor)
+{
+    if (!stmt)
+        return;
+
+    if (auto memberCall = dyn_cast<CXXMemberCallExpr>(stmt)) {
+        auto callee = dyn_cast<MemberExpr>(memberCall->getCallee()->IgnoreParens());
+        if (MapUses *uses = callee ? usesFor(callee->getBase()) : nullptr)
+            addCall(*uses, memberCall->getMethodDecl(), inConstructor);
+    } else if (auto operatorCall = dyn_cast<CXXOperatorCallExpr>(stmt)) {
+        auto method = dyn_cast_or_null<CXXMethodDecl>(operatorCall->getDirectCallee());
+        if (MapUses *uses = method && operatorCall->getNumArgs() > 0 ? usesFor(operatorCall->getArg(0)) : nullptr)
+            addCall(*uses, method, inConstructor);
+    } else if (isa<DeclRefExpr>(stmt) || isa<MemberExpr>(stmt)) {
+        // Copied, passed to a function, range-for, address taken...
+        const ValueDecl *decl = referencedDecl(cast<Expr>(stmt));
+        auto it = decl ? m_uses.find(decl->getCanonicalDecl()) : m_uses.end();
+        if (it != m_uses.end() && !m_consumed.count(cast<Expr>(stmt)))
+            it->second.escapes = true;
+    }
+
+    for (Stmt *child : stmt->children())
+        walk(child, inConstructor);
+}
+
+static MapKind mapKind(QualType type)
+{
+    auto specialization = dyn_cast_or_null<ClassTemplateSpecializationDecl>(type->getAsCXXRecordDecl());
+    if (!specialization)
+        return MapKind_None;
+
+    const StringRef name = clazy::name(specialization);
+    if (specialization->isInStdNamespace())
+        return name == "map" ? MapKind_StdMap : MapKind_None;
+
+    return name == "QMap" ? MapKind_QMap : MapKind_None;
+}
+
+// Returns the number of elements of the initializer list init builds the map from, or -1
+static int initializerListSize(Stmt *init)
+{
+    if (!init)
+        return -1;
+
+    if (auto stdInitializerList = dyn_cast<CXXStdInitializerListExpr>(init)) {
+        auto initList = dyn_cast<InitListExpr>(stdInitializerList->getSubExpr()->IgnoreImplicit());
+        return initList ? initList->getNumInits() : -1;
+    }
+
+    for (Stmt *child : init->children()) {
+        const int size = initializerListSize(child);
+        if (size != -1)
+            return size;
+    }
+
+    return -1;
+}
+
+UnorderedMapCandidates::UnorderedMapCandidates(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes)
+{
+}
+
+void UnorderedMapCandidates::VisitDecl(clang::Decl *decl)
+{
+    if (auto record = dyn_cast<CXXRecordDecl>(decl)) {
+        if (record->isThisDeclarationADefinition() && !record->isDependentContext() && !record->isLambda()
+            && !isa<ClassTemplateSpecializationDecl>(record))
+            checkMembers(record);
+    } else if (auto func = dyn_cast<FunctionDecl>(decl)) {
+        auto method = dyn_cast<CXXMethodDecl>(func);
+        if (func->doesThisDeclarationHaveABody() && !func->isDependentContext() && !func->isTemplateInstantiation()
+            && !(method && method->getParent()->isLambda()))
+            checkLocals(func);
+    } else if (auto var = dyn_cast<VarDecl>(decl)) {
+        if (var->isFileVarDecl() && !var->isExternallyVisible() && var->isThisDeclarationADefinition() == VarDecl::Definition
+            && mapKind(var->getType()) != MapKind_None)
+            checkInternalGlobal(var);
+    }
+}
+
+void UnorderedMapCandidates::checkMembers(CXXRecordDecl *record)
+{
+    vector<FieldDecl *> maps;
+    for (FieldDecl *field : record->fields()) {
+        if (field->getAccess() == AS_private && mapKind(field->getType()) != MapKind_None)
+            maps.push_back(field);
+    }
+
+    if (maps.empty() || record->friend_begin() != record->friend_end())
+        return;
+
+    // Their member functions could use our private members too
+    for (Decl *decl : record->decls()) {
+        if (isa<FunctionTemplateDecl>(decl))
+            return;
+        auto nested = dyn_cast<CXXRecordDecl>(decl);
+        if (nested && !nested->isImplicit())
+            return;
+    }
+
+    MapUseCollector collector;
+    for (FieldDecl *field : maps)
+        collector.track(field);
+
+    for (CXXMethodDecl *method : record->methods()) {
+        if (method->isImplicit() || method->isDeleted() || method->isDefaulted())
+            continue;
+
+        const FunctionDecl *definition = nullptr;
+        if (!method->hasBody(definition)) {
+            if (method->isPure())
+                continue;
+            return; // Defined in another translation unit, which might iterate our maps
+        }
+
+        const bool isCtor = isa<CXXConstructorDecl>(definition);
+        collector.walk(definition->getBody(), isCtor);
+        if (isCtor) {
+            for (CXXCtorInitializer *init : cast<CXXConstructorDecl>(definition)->inits())
+                collector.walk(init->getInit(), true);
+        }
+    }
+
+    for (FieldDecl *field : record->fields())
+        collector.walk(field->getInClassInitializer(), true);
+
+    for (FieldDecl *field : maps)
+        maybeWarn(field, collector.isLookupOnly(field), collector.isReadOnly(field), initializerListSize(field->getInClassInitializer()));
+}
+
+// Collects the maps declared in stmt, but not inside lambdas, which have their own scope
+static void collectLocalMaps(Stmt *stmt, vector<VarDecl *> &maps)
+{
+    if (!stmt || isa<LambdaExpr>(stmt))
+        return;
+
+    if (auto declStmt = dyn_cast<DeclStmt>(stmt)) {
+        for (Decl *decl : declStmt->decls()) {
+            auto var = dyn_cast<VarDecl>(decl);
+            if (var && var->isLocalVarDecl() && mapKind(var->getType()) != MapKind_None)
+                maps.push_back(var);
+        }
+    }
+
+    for (Stmt *child : stmt->children())
+        collectLocalMaps(child, maps);
+}
+
+void UnorderedMapCandidates::checkLocals(FunctionDecl *func)
+{
+    vector<VarDecl *> maps;
+    collectLocalMaps(func->getBody(), maps);
+    if (maps.empty())
+        return;
+
+    MapUseCollector collector;
+    for (VarDecl *var : maps)
+        collector.track(var);
+
+    collector.walk(func->getBody(), false);
+    for (VarDecl *var : maps)
+        maybeWarn(var, collector.isLookupOnly(var), collector.isReadOnly(var), initializerListSize(var->getInit()));
+}
+
+// Walks everything in ctx which could use a global with internal linkage
+static void walkDeclContext(DeclContext *ctx, MapUseCollector &collector, const SourceManager &sm)
+{
+    for (Decl *decl : ctx->decls()) {
+        if (sm.isInSystemHeader(clazy::getLocStart(decl)))
+            continue;
+
+        if (auto functionTemplate = dyn_cast<FunctionTemplateDecl>(decl))
+            decl = functionTemplate->getTemplatedDecl();
+        else if (auto classTemplate = dyn_cast<ClassTemplateDecl>(decl))
+            decl = classTemplate->getTemplatedDecl();
+
+        if (auto func = dyn_cast<FunctionDecl>(decl)) {
+            if (func->doesThisDeclarationHaveABody()) {
+                collector.walk(func->getBody(), false);
+                if (auto ctor = dyn_cast<CXXConstructorDecl>(func)) {
+                    for (CXXCtorInitializer *init : ctor->inits())
+                        collector.walk(init->getInit(), false);
+                }
+            }
+        } else if (auto var = dyn_cast<VarDecl>(decl)) {
+            collector.walk(var->getInit(), false);
+        } else if (auto field = dyn_cast<FieldDecl>(decl)) {
+            collector.walk(field->getInClassInitializer(), false);
+        } else if (isa<NamespaceDecl>(decl) || isa<LinkageSpecDecl>(decl)
+                   || (isa<CXXRecordDecl>(decl) && !isa<ClassTemplateSpecializationDecl>(decl))) {
+            walkDeclContext(cast<DeclContext>(decl), collector, sm);
+        }
+    }
+}
+
+void UnorderedMapCandidates::checkInternalGlobal(VarDecl *var)
+{
+    MapUseCollector collector;
+    collector.track(var);
+    walkDeclContext(m_astContext->getTranslationUnitDecl(), collector, sm());
+    maybeWarn(var, collector.isLookupOnly(var), collector.isReadOnly(var), initializerListSize(var->getInit()));
+}
+
+// Returns true if a qHash(key) overload is declared in ctx
+bool UnorderedMapCandidates::declaresQHash(const DeclContext *ctx, QualType key) const
+{
+    for (NamedDecl *decl : ctx->lookup(DeclarationName(&m_astContext->Idents.get("qHash")))) {
+        auto func = dyn_cast<FunctionDecl>(decl);
+        if (func && func->getNumParams() > 0
+            && m_astContext->hasSameUnqualifiedType(clazy::unrefQualType(func->getParamDecl(0)->getType()), key))
+            return true;
+    }
+
+    return false;
+}
+
+bool UnorderedMapCandidates::isHashable(QualType key, bool isQt) const
+{
+    key = key.getCanonicalType();
+    if (key->isScalarType())
+        return true;
+
+    const CXXRecordDecl *record = key->getAsCXXRecordDecl();
+    if (!record)
+        return false;
+
+    if (!isQt)
+        return record->isInStdNamespace() && clazy::name(record) == "basic_string";
+
+    static const clazy::NameSet hashableQtTypes = { "QString", "QByteArray", "QChar", "QLatin1String", "QStringRef",
+                                                    "QUrl", "QDate", "QTime", "QDateTime", "QUuid", "QBitArray",
+                                                    "QModelIndex", "QPersistentModelIndex" };
+    if (hashableQtTypes.contains(clazy::name(record)))
+        return true;
+
+    // Where argument dependent lookup would find it
+    return declaresQHash(record->getDeclContext()->getRedeclContext(), key)
+        || declaresQHash(m_astContext->getTranslationUnitDecl(), key);
+}
+
+void UnorderedMapCandidates::maybeWarn(DeclaratorDecl *decl, bool isLookupOnly, bool isReadOnly, int initializerListSize)
+{
+    if (!isLookupOnly)
+        return;
+
+    auto specialization = cast<ClassTemplateSpecializationDecl>(decl->getType()->getAsCXXRecordDecl());
+    const bool isQt = mapKind(decl->getType()) == MapKind_QMap;
+    const string mapName = isQt ? "QMap" : "std::map";
+    const string name = clazy::name(decl).str();
+
+    if (isReadOnly && initializerListSize >= 0 && initializerListSize <= s_smallMapSize) {
+        emitWarning(decl, "'" + name + "' is a small " + mapName + " which is never modified and only used for lookups, use a sorted "
+                    + (isQt ? "QVector" : "std::vector") + " instead");
+        return;
+    }
+
+    if (!isHashable(clazy::getTemplateArgumentType(specialization, 0), isQt))
+        return;
+
+    emitWarning(decl, "'" + name + "' is only used for lookups and never iterated in key order, use "
+                + (isQt ? "QHash" : "std::unordered_map") + " instead of " + mapName);
+}
@@ -0,0 +1,62 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#ifndef CLAZY_UNORDERED_MAP_CANDIDATES_H
+#define CLAZY_UNORDERED_MAP_CANDIDATES_H
+
+#include "checkbase.h"
+
+#include <string>
+
+class ClazyContext;
+
+namespace clang {
+class CXXRecordDecl;
+class Decl;
+class DeclaratorDecl;
+class DeclContext;
+class FunctionDecl;
+class QualType;
+class VarDecl;
+}
+
+/**
+ * Finds QMap and std::map variables and private members which are only used for lookups in the
+ * translation unit, never iterated in key order, and suggests QHash, std::unordered_map or a sorted vector.
+ *
+ * See README-unordered-map-candidates.md for more info.
+ */
+class UnorderedMapCandidates
+    : public CheckBase
+{
+public:
+    explicit UnorderedMapCandidates(const std::string &name, ClazyContext *context);
+    void VisitDecl(clang::Decl *decl) override;
+private:
+    void checkMembers(clang::CXXRecordDecl *record);
+    void checkLocals(clang::FunctionDecl *func);
+    void checkInternalGlobal(clang::VarDecl *var);
+    bool declaresQHash(const clang::DeclContext *ctx, clang::QualType key) const;
+    bool isHashable(clang::QualType key, bool isQt) const;
+    void maybeWarn(clang::DeclaratorDecl *decl, bool isLookupOnly, bool isReadOnly, int initializerListSize);
+};
+
+#endif
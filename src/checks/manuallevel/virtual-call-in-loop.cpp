@@ -0,0 +1,109 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#include "virtual-call-in-loop.h"
+#include "ClazyContext.h"
+#include "SourceCompatibilityHelpers.h"
+#include "Utils.h"
+
+#include <clang/AST/ASTContext.h>
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/DeclTemplate.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/Basic/LLVM.h>
+#include <clang/Basic/SourceManager.h>
+#include <llvm/Support/Casting.h>
+
+using namespace clang;
+using namespace std;
+
+VirtualCallInLoop::VirtualCallInLoop(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes)
+{
+}
+
+void VirtualCallInLoop::collectRecord(const CXXRecordDecl *record)
+{
+    if (record->isThisDeclarationADefinition()) {
+        for (const CXXBaseSpecifier &base : record->bases()) {
+            if (const CXXRecordDecl *baseRecord = base.getType()->getAsCXXRecordDecl())
+                m_subclassed.insert(baseRecord->getCanonicalDecl());
+        }
+
+        for (const CXXMethodDecl *method : record->methods()) {
+            for (const CXXMethodDecl *overridden : method->overridden_methods())
+                m_overridden.insert(overridden->getCanonicalDecl());
+        }
+    }
+
+    collectHierarchy(record);
+}
+
+// Subclasses can be declared after the loop, so the whole translation unit is looked at, except system headers
+void VirtualCallInLoop::collectHierarchy(const DeclContext *context)
+{
+    for (const Decl *decl : context->decls()) {
+        if (sm().isInSystemHeader(clazy::getLocStart(decl)))
+            continue;
+
+        if (auto classTemplate = dyn_cast<ClassTemplateDecl>(decl)) {
+            // template <typename T> class Foo : public T only derives from its template arguments once instantiated
+            for (const ClassTemplateSpecializationDecl *specialization : classTemplate->specializations())
+                collectRecord(specialization);
+            collectRecord(classTemplate->getTemplatedDecl());
+        } else if (auto record = dyn_cast<CXXRecordDecl>(decl)) {
+            collectRecord(record);
+        } else if (auto nested = dyn_cast<DeclContext>(decl)) {
+            collectHierarchy(nested); // Namespaces, and function bodies for local classes
+        }
+    }
+}
+
+void VirtualCallInLoop::VisitStmt(clang::Stmt *stmt)
+{
+    auto call = dyn_cast<CXXMemberCallExpr>(stmt);
+    if (!call || !m_context->stmtFacts.enclosingLoop())
+        return;
+
+    const CXXMethodDecl *callee = nullptr;
+    const CXXRecordDecl *record = Utils::virtualCallClass(call, m_context->lastFunctionDecl, callee);
+    if (!record || !sm().isInMainFile(sm().getExpansionLoc(record->getLocation())))
+        return;
+
+    if (!m_collected) {
+        collectHierarchy(m_astContext->getTranslationUnitDecl());
+        m_collected = true;
+    }
+
+    const string calleeName = callee->getQualifiedNameAsString();
+    if (!m_subclassed.count(record->getCanonicalDecl())) {
+        const string className = record->getQualifiedNameAsString();
+        emitFormattedWarning(clazy::getLocStart(call), "Virtual call to %0 in a loop, but %1 has no subclasses; "
+                             "mark it final so the compiler can devirtualize the call", { calleeName, className });
+    } else if (callee->getParent()->getCanonicalDecl() == record->getCanonicalDecl()
+               && !m_overridden.count(callee->getCanonicalDecl())) {
+        emitFormattedWarning(clazy::getLocStart(call), "Virtual call to %0 in a loop, but nothing overrides it; "
+                             "mark it final so the compiler can devirtualize the call", { calleeName });
+    }
+}
@@ -0,0 +1,62 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+#ifndef CLAZY_VIRTUAL_CALL_IN_LOOP_H
+#define CLAZY_VIRTUAL_CALL_IN_LOOP_H
+
+#include "checkbase.h"
+
+#include <llvm/ADT/DenseSet.h>
+
+#include <string>
+
+class ClazyContext;
+
+namespace clang {
+class CXXRecordDecl;
+class Decl;
+class DeclContext;
+class Stmt;
+}
+
+/**
+ * Finds virtual calls inside loops, through a pointer or reference whose static class has no subclasses, or to a method
+ * nothing overrides, which could be made final so the compiler devirtualizes them.
+ * Only looks at classes defined in the main file, -global-checks looks at the whole program.
+ *
+ * See README-virtual-call-in-loop.md for more info.
+ */
+class VirtualCallInLoop
+    : public CheckBase
+{
+public:
+    explicit VirtualCallInLoop(const std::string &name, ClazyContext *context);
+    void VisitStmt(clang::Stmt *stmt) override;
+private:
+    void collectRecord(const clang::CXXRecordDecl *record);
+    void collectHierarchy(const clang::DeclContext *context);
+    bool m_collected = false;
+    llvm::DenseSet<const clang::Decl *> m_subclassed; // Canonical records
+    llvm::DenseSet<const clang::Decl *> m_overridden; // Canonical methods
+};
+
+#endif
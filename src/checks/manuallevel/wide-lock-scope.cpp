@@ -0,0 +1,181 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+
+#include "wide-lock-scope.h"
+#include "AccessSpecifierManager.h"
+#include "ClazyContext.h"
+#include "HierarchyUtils.h"
+#include "StringUtils.h"
+#include "Utils.h"
+#include "SourceCompatibilityHelpers.h"
+#include "clazy_stl.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclBase.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/Stmt.h>
+#include <clang/Basic/LLVM.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+#include <array>
+#include <vector>
+
+using namespace clang;
+using namespace std;
+
+WideLockScope::WideLockScope(const std::string &name, ClazyContext *context)
+    : CheckBase(name, context, Option_CanIgnoreIncludes)
+{
+    context->enableAccessSpecifierManager();
+}
+
+static bool isLockGuard(const VarDecl *varDecl)
+{
+    if (varDecl->getType()->isReferenceType())
+        return false;
+
+    CXXRecordDecl *record = varDecl->getType()->getAsCXXRecordDecl();
+    if (!record)
+        return false;
+
+    const StringRef name = clazy::name(record);
+    if (name == "QMutexLocker" || name == "QReadLocker" || name == "QWriteLocker")
+        return true;
+
+    return record->isInStdNamespace() && (name == "lock_guard" || name == "unique_lock" || name == "shared_lock" || name == "scoped_lock");
+}
+
+// std::unique_lock<std::mutex> lock(mutex, std::defer_lock) doesn't lock, or might not
+static bool mightNotLock(const VarDecl *varDecl)
+{
+    Expr *init = varDecl->getInit();
+    auto constructExpr = init ? dyn_cast<CXXConstructExpr>(init->IgnoreImplicit()) : nullptr;
+    if (!constructExpr)
+        return false;
+
+    for (Expr *arg : constructExpr->arguments()) {
+        CXXRecordDecl *record = arg->getType()->getAsCXXRecordDecl();
+        if (record && (clazy::name(record) == "defer_lock_t" || clazy::name(record) == "try_to_lock_t"))
+            return true;
+    }
+
+    return false;
+}
+
+static bool isIODevice(StringRef className)
+{
+    static const std::array<StringRef, 13> classes = {{ "QIODevice", "QFileDevice", "QFile", "QSaveFile", "QTemporaryFile",
+        "QAbstractSocket", "QTcpSocket", "QUdpSocket", "QSslSocket", "QLocalSocket", "QProcess", "QSerialPort", "QNetworkReply" }};
+    return clazy::contains(classes, className);
+}
+
+// Returns what the blocking call does, or an empty string if it doesn't block
+static string blockingCallDescription(CallExpr *call)
+{
+    FunctionDecl *func = call->getDirectCallee();
+    if (!func)
+        return {};
+
+    auto method = dyn_cast<CXXMethodDecl>(func);
+    if (!method) {
+        static const std::array<StringRef, 14> functions = {{ "fopen", "fclose", "fread", "fwrite", "fflush", "fgets", "fputs",
+            "fprintf", "printf", "puts", "sleep", "usleep", "nanosleep", "system" }};
+        const bool isLibC = func->isInStdNamespace() || func->getDeclContext()->getRedeclContext()->isTranslationUnit();
+        return isLibC && clazy::contains(functions, clazy::name(func)) ? "Calling " + func->getNameAsString() + "()" : string();
+    }
+
+    const StringRef className = clazy::name(method->getParent());
+    const StringRef methodName = clazy::name(method);
+    if (className == "QMessageLogger") // qDebug() and friends
+        return "Logging";
+
+    if (className == "QThread" && (methodName == "sleep" || methodName == "msleep" || methodName == "usleep" || methodName == "wait"))
+        return "Calling " + method->getQualifiedNameAsString() + "()";
+
+    static const std::array<StringRef, 8> ioMethods = {{ "open", "read", "readAll", "readLine", "write", "peek", "flush", "commit" }};
+    if (isIODevice(className) && (clazy::contains(ioMethods, methodName) || methodName.startswith("waitFor")))
+        return "Calling " + method->getQualifiedNameAsString() + "()";
+
+    return {};
+}
+
+void WideLockScope::VisitStmt(clang::Stmt *stmt)
+{
+    auto declStmt = dyn_cast<DeclStmt>(stmt);
+    auto locker = declStmt && declStmt->isSingleDecl() ? dyn_cast<VarDecl>(declStmt->getSingleDecl()) : nullptr;
+    if (!locker || !isLockGuard(locker) || mightNotLock(locker))
+        return;
+
+    // The lock is held until the end of the block
+    auto block = dyn_cast_or_null<CompoundStmt>(clazy::parent(m_context->parentMap, declStmt));
+    if (!block)
+        return;
+
+    // Lambdas defined while holding the lock don't run while holding it, unless the locker is inside one too
+    LambdaExpr *lockerLambda = clazy::getFirstParentOfType<LambdaExpr>(m_context->parentMap, declStmt);
+
+    bool isLocked = false;
+    for (Stmt *statement : block->body()) {
+        if (!isLocked) {
+            isLocked = statement == declStmt;
+            continue;
+        }
+
+        vector<CallExpr *> calls;
+        clazy::getChilds<CallExpr>(statement, calls);
+
+        // Stop at an explicit unlock(), not trying to figure out which calls come before it in this statement
+        const bool unlocks = clazy::any_of(calls, [locker](CallExpr *call) {
+            auto memberCall = dyn_cast<CXXMemberCallExpr>(call);
+            CXXMethodDecl *method = memberCall ? memberCall->getMethodDecl() : nullptr;
+            return method && clazy::name(method) == "unlock" && Utils::valueDeclForMemberCall(memberCall) == locker;
+        });
+        if (unlocks)
+            return;
+
+        for (CallExpr *call : calls) {
+            if (clazy::getFirstParentOfType<LambdaExpr>(m_context->parentMap, call) == lockerLambda)
+                checkCall(call, locker);
+        }
+    }
+}
+
+void WideLockScope::checkCall(CallExpr *call, const VarDecl *locker)
+{
+    const string lockerName = locker->getNameAsString();
+    auto memberCall = dyn_cast<CXXMemberCallExpr>(call);
+    CXXMethodDecl *method = memberCall ? memberCall->getMethodDecl() : nullptr;
+    AccessSpecifierManager *accessSpecifierManager = m_context->accessSpecifierManager;
+    if (method && accessSpecifierManager && accessSpecifierManager->qtAccessSpecifierType(method) == QtAccessSpecifier_Signal) {
+        emitWarning(clazy::getLocStart(call), "Signal " + method->getQualifiedNameAsString() + " emitted while " + lockerName
+                    + " holds the lock, the connected slots run inside the critical section");
+        return;
+    }
+
+    const string description = blockingCallDescription(call);
+    if (!description.empty())
+        emitWarning(clazy::getLocStart(call), description + " while " + lockerName + " holds the lock, narrow the critical section");
+}
@@ -0,0 +1,54 @@
+/*
+    This file is part of the clazy static checker.
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+
+#ifndef CLAZY_WIDE_LOCK_SCOPE_H
+#define CLAZY_WIDE_LOCK_SCOPE_H
+
+#include "checkbase.h"
+
+#include <string>
+
+class ClazyContext;
+
+namespace clang {
+class Stmt;
+class CallExpr;
+class VarDecl;
+}
+
+/**
+ * Finds QMutexLocker and std::lock_guard scopes emitting signals or doing blocking I/O while holding the lock.
+ *
+ * See README-wide-lock-scope.md for more info.
+ */
+class WideLockScope
+    : public CheckBase
+{
+public:
+    explicit WideLockScope(const std::string &name, ClazyContext *context);
+    void VisitStmt(clang::Stmt *stmt) override;
+private:
+    void checkCall(clang::CallExpr *call, const clang::VarDecl *locker);
+};
+
+#endif
@@ -0,0 +1,37 @@
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <algorithm>
+#include <vector>
+
+namespace QtConcurrent {
+template <typename Sequence, typename KeepFunctor>
+Sequence blockingFiltered(const Sequence &sequence, KeepFunctor) { return sequence; }
+}
+
+struct Point
+{
+    int x;
+    int y;
+};
+
+void test(QStringList &names, std::vector<Point> &points)
+{
+    std::sort(names.begin(), names.end(), [](QString a, QString b) { return a.size() < b.size(); }); // Warning
+    std::stable_sort(names.begin(), names.end(), [](const QString a, const QString &b) { return a < b; }); // Warning
+    std::sort(names.begin(), names.end(), [](const QString &a, const QString &b) { return a < b; }); // OK
+    std::sort(points.begin(), points.end(), [](Point a, Point b) { return a.x < b.x; }); // OK, small and trivial
+
+    auto it = std::find_if(names.cbegin(), names.cend(), [](QString name) { return name.isEmpty(); }); // Warning
+    auto count = std::count_if(names.cbegin(), names.cend(), [](QString name) { // OK, modified
+        name.append(QLatin1Char('/'));
+        return name.startsWith(QLatin1String("//"));
+    });
+
+    auto comparator = [](QString a, QString b) { return a < b; }; // OK, not passed directly
+    std::sort(names.begin(), names.end(), comparator);
+
+    QStringList nonEmpty = QtConcurrent::blockingFiltered(names, [](QString name) { return !name.isEmpty(); }); // Warning
+    Q_UNUSED(it);
+    Q_UNUSED(count);
+    Q_UNUSED(nonEmpty);
+}
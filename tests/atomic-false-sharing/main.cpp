@@ -0,0 +1,64 @@
+#include <QtCore/QAtomicInt>
+#include <QtCore/QVector>
+#include <array>
+#include <atomic>
+
+struct Stats // Warning
+{
+    std::atomic<int> hits;
+    std::atomic<int> misses;
+};
+
+struct QtStats // Warning
+{
+    QAtomicInt started;
+    char name[16];
+    QAtomicInt finished;
+};
+
+struct Aligned // OK
+{
+    alignas(64) std::atomic<int> hits;
+    alignas(64) std::atomic<int> misses;
+};
+
+struct FarApart // OK
+{
+    std::atomic<int> hits;
+    char buffer[128];
+    std::atomic<int> misses;
+};
+
+struct PerThread // Warning
+{
+    std::atomic<long> counts[4];
+};
+
+struct Worker // OK, a single atomic
+{
+    std::atomic<int> processed;
+    int id;
+};
+
+struct alignas(64) AlignedWorker // OK
+{
+    std::atomic<int> processed;
+};
+
+struct Plain // OK
+{
+    int a;
+    int b;
+};
+
+Worker s_workers[8]; // Warning
+AlignedWorker s_alignedWorkers[8]; // OK
+std::atomic<int> s_counters[4]; // Warning
+Plain s_plain[8]; // OK
+
+struct Pool
+{
+    std::array<Worker, 4> workers; // Warning
+    QVector<Worker> moreWorkers; // Warning
+    Worker single[1]; // OK
+};
@@ -0,0 +1,88 @@
+#include <QtCore/QAtomicInt>
+#include <atomic>
+#include <thread>
+
+struct Stats
+{
+    void recordHit()
+    {
+        ++hits; // Warning
+        misses.fetch_add(1); // Warning
+        qtHits.ref(); // Warning
+        qtMisses.fetchAndAddOrdered(2); // Warning
+    }
+
+    void recordRelaxed()
+    {
+        hits.fetch_add(1, std::memory_order_relaxed); // OK
+        qtHits.fetchAndAddRelaxed(1); // OK
+    }
+
+    int nextId()
+    {
+        return ++ids; // OK, the value is used
+    }
+
+    void release()
+    {
+        if (!refCount.deref()) // OK
+            delete this;
+    }
+
+    void publish(int value)
+    {
+        data = value;
+        ++generation; // OK, might publish data
+    }
+
+    void bump()
+    {
+        ++generation; // OK, decremented below
+        generation.fetch_sub(1);
+    }
+
+    void publishReady()
+    {
+        ++published; // OK, other atomics are used too
+        ready.store(true);
+    }
+
+    std::atomic<int> hits{0};
+    std::atomic<int> misses{0};
+    std::atomic<int> ids{0};
+    std::atomic<int> generation{0};
+    std::atomic<int> published{0};
+    std::atomic<bool> ready{false};
+    QAtomicInt qtHits;
+    QAtomicInt qtMisses;
+    QAtomicInt refCount;
+    int data = 0;
+};
+
+void spin(std::atomic<bool> &flag, std::atomic_flag &lock, QAtomicInt &qtLock, std::atomic<int> &value)
+{
+    while (!flag.load(std::memory_order_acquire)) { } // Warning
+
+    while (lock.test_and_set(std::memory_order_acquire)) { } // Warning
+
+    while (!qtLock.testAndSetOrdered(0, 1)) { } // Warning
+
+    while (!flag.load())
+        std::this_thread::yield(); // OK
+
+    int expected = value.load();
+    while (!value.compare_exchange_weak(expected, expected * 2)) { } // OK, a lock-free update
+
+    do { // Warning
+        expected = 0;
+    } while (!value.compare_exchange_weak(expected, 1));
+}
+
+void notSpinning(std::atomic<bool> &flag, int n)
+{
+    for (int i = 0; i < n; ++i) { } // OK
+
+    while (flag) {
+        flag = false; // OK
+    }
+}
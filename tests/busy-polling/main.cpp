@@ -0,0 +1,105 @@
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+#include <QtCore/QThread>
+#include <QtCore/QFuture>
+#include <QtCore/QFile>
+#include <QtCore/QCoreApplication>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+std::atomic<bool> s_done;
+bool s_flag = false;
+void work();
+
+void sleepLoops()
+{
+    while (!s_done) {
+        QThread::msleep(1); // Warning
+    }
+
+    while (!s_flag)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1)); // Warning
+
+    for (;;) {
+        if (s_done)
+            break;
+        QCoreApplication::processEvents();
+        QThread::usleep(100); // Warning
+    }
+
+    do {
+        QThread::msleep(10); // Warning
+    } while (!QFile::exists(QStringLiteral("/tmp/ready")));
+
+    while (!s_done) {
+        work();
+        QThread::msleep(100); // OK, periodic work
+    }
+
+    for (int i = 0; i < 10; ++i)
+        QThread::msleep(100); // OK, a delay
+}
+
+void forever()
+{
+    while (true)
+        QThread::sleep(1); // OK, not waiting for anything
+}
+
+class Poller : public QObject
+{
+    Q_OBJECT
+public:
+    Poller()
+    {
+        connect(&m_timer, &QTimer::timeout, this, &Poller::checkFuture);
+        connect(m_fileTimer, &QTimer::timeout, this, [this] {
+            if (QFile::exists(m_path))
+                Q_EMIT fileAppeared();
+        });
+        connect(&m_animationTimer, &QTimer::timeout, this, &Poller::animate);
+    }
+
+    void startPolling()
+    {
+        m_timer.start(1); // Warning
+        m_fileTimer->setInterval(0); // Warning
+        m_animationTimer.start(1); // OK, doesn't poll
+        m_timer.start(500); // OK, not a short interval
+    }
+
+    void checkFuture()
+    {
+        if (m_future.isFinished())
+            Q_EMIT finished();
+    }
+
+    void animate()
+    {
+        ++m_frame;
+    }
+
+    void local()
+    {
+        QTimer timer;
+        connect(&timer, &QTimer::timeout, [this] {
+            if (m_ready)
+                Q_EMIT finished();
+        });
+        timer.start(5); // Warning
+    }
+
+Q_SIGNALS:
+    void finished();
+    void fileAppeared();
+
+private:
+    QTimer m_timer;
+    QTimer *m_fileTimer = nullptr;
+    QTimer m_animationTimer;
+    QFuture<void> m_future;
+    QString m_path;
+    int m_frame = 0;
+    bool m_ready = false;
+};
@@ -0,0 +1,25 @@
+# Analyzes a header included by two source files in its own translation unit, so its warning is only emitted once.
+# The header not matched by -header-filter isn't analyzed, neither on its own nor through the source files.
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+printf '#pragma once\nconst char *g_shared = "shared";\n' > "$DIR/shared.h"
+printf '#pragma once\nconst char *g_filtered = "filtered";\n' > "$DIR/filtered.h"
+printf '#include "shared.h"\n#include "filtered.h"\nconst char *g_name1 = "name";\n' > "$DIR/analyze_headers1.cpp"
+printf '#include "shared.h"\nconst char *g_name2 = "name";\n' > "$DIR/analyze_headers2.cpp"
+
+cat > "$DIR/compile_commands.json" <<JSON
+[
+    { "directory": "$DIR", "file": "$DIR/analyze_headers1.cpp", "command": "c++ -std=c++14 -c analyze_headers1.cpp" },
+    { "directory": "$DIR", "file": "$DIR/analyze_headers2.cpp", "command": "c++ -std=c++14 -c analyze_headers2.cpp" }
+]
+JSON
+
+${CLAZYSTANDALONE_CXX} -p "$DIR" -checks=global-const-char-pointer -analyze-headers -header-filter=".*shared.*" > "$DIR/output.txt" 2>&1
+echo "Exit status: $?"
+grep -E "warning:|error:" "$DIR/output.txt" | sed "s|$DIR/||" | sort
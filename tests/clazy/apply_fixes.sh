@@ -0,0 +1,40 @@
+# Applies the fixits of two translation units including the same header, whose fixits must only be applied once.
+# The source files are modified, so they're copied to a temporary directory first.
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+cat > "$DIR/apply_fixes.h" <<'CPP'
+#pragma once
+struct Name
+{
+    Name();
+    Name(const Name &);
+    ~Name();
+};
+
+inline bool isEmpty(Name name) { return false; }
+CPP
+
+for i in 1 2; do
+    printf '#include "apply_fixes.h"\nvoid use%s(Name name) { isEmpty(name); }\n' $i > "$DIR/apply_fixes$i.cpp"
+done
+
+cat > "$DIR/compile_commands.json" <<JSON
+[
+    { "directory": "$DIR", "file": "$DIR/apply_fixes1.cpp", "command": "c++ -std=c++14 -c apply_fixes1.cpp" },
+    { "directory": "$DIR", "file": "$DIR/apply_fixes2.cpp", "command": "c++ -std=c++14 -c apply_fixes2.cpp" }
+]
+JSON
+
+${CLAZYSTANDALONE_CXX} -p "$DIR" -checks=function-args-by-ref -apply-fixes "$@" \
+    "$DIR/apply_fixes1.cpp" "$DIR/apply_fixes2.cpp" 2>&1 | grep "clazy: Applied"
+
+cat "$DIR/apply_fixes.h" "$DIR/apply_fixes1.cpp" "$DIR/apply_fixes2.cpp"
+
+# No temporary file is left behind
+ls "$DIR"
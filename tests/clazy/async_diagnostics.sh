@@ -0,0 +1,26 @@
+# Renders the diagnostics of two files, with their source lines and carets, on the printer thread of -async-diagnostics.
+# The output must be the same as when rendering them synchronously, with and without -j. The warning counts are
+# printed by clang as each file is done, so their position depends on -j and they aren't compared.
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+printf 'const char *g_name1 = "name";\nvoid foo();\nvoid test() { return foo(); }\n' > "$DIR/async_diagnostics1.cpp"
+printf 'void bar();\nvoid test2() { return bar(); }\nconst char *g_name2 = "name";\n' > "$DIR/async_diagnostics2.cpp"
+
+analyze() {
+    ${CLAZYSTANDALONE_CXX} -checks=global-const-char-pointer,returning-void-expression "$@" \
+        "$DIR/async_diagnostics1.cpp" "$DIR/async_diagnostics2.cpp" -- -std=c++14 2>&1 | grep -v "warnings generated" | sed "s|$DIR/||"
+}
+
+analyze | tee "$DIR/sync.txt"
+
+analyze -async-diagnostics > "$DIR/async.txt"
+cmp -s "$DIR/sync.txt" "$DIR/async.txt" && echo "Same output with -async-diagnostics"
+
+analyze -async-diagnostics -j2 > "$DIR/async_j2.txt"
+cmp -s "$DIR/sync.txt" "$DIR/async_j2.txt" && echo "Same output with -async-diagnostics -j2"
@@ -0,0 +1,7 @@
+#include <QtCore/QString>
+
+void test()
+{
+    qgetenv("Foo").isEmpty(); // Known, it's in baseline.clazy-baseline
+    qgetenv("Bar").isEmpty();
+}
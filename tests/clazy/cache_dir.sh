@@ -0,0 +1,36 @@
+# Runs clazy-standalone -cache-dir over two translation units: first filling the cache, then served from it,
+# then after changing a header only one of them includes, then with other checks, which don't share its entries.
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+printf 'typedef void Result;\n' > "$DIR/cache_dir.h"
+printf '#include "cache_dir.h"\n\nResult foo();\nResult test() { return foo(); }\n' > "$DIR/cache_dir1.cpp"
+printf 'const char *g_name = "name";\n' > "$DIR/cache_dir2.cpp"
+
+analyze() {
+    ${CLAZYSTANDALONE_CXX} "$DIR/cache_dir1.cpp" "$DIR/cache_dir2.cpp" -checks="$1" -cache-dir="$DIR/cache" \
+        -stats-json="$DIR/stats.json" -- -std=c++14 2>&1 | grep "warning:" | sed "s|$DIR/||"
+    grep '"result_cache"' "$DIR/stats.json" | sed 's/^ *//'
+}
+
+echo "Miss:"
+analyze global-const-char-pointer,returning-void-expression
+
+echo "Hit:"
+analyze global-const-char-pointer,returning-void-expression
+
+echo "Touched, but not changed:"
+touch "$DIR/cache_dir.h" "$DIR/cache_dir2.cpp"
+analyze global-const-char-pointer,returning-void-expression
+
+echo "Header changed:"
+printf 'typedef int Result;\n' > "$DIR/cache_dir.h"
+analyze global-const-char-pointer,returning-void-expression
+
+echo "Other checks:"
+analyze global-const-char-pointer
@@ -0,0 +1,27 @@
+# Runs twice with -check-history over a file where returning-void-expression doesn't warn, so the second run skips it.
+# Once the file changes, its directory is analyzed with every check again.
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+printf 'const char *g_name = "name";\n' > "$DIR/check_history.cpp"
+
+analyze() {
+    ${CLAZYSTANDALONE_CXX} -checks=global-const-char-pointer,returning-void-expression -check-history="$DIR/history.txt" \
+        -check-history-runs=1 -check-history-rerun=10 "$DIR/check_history.cpp" -- -std=c++14 2>&1 \
+        | grep -E "warning:|clazy-standalone:" | sed "s|$DIR/||"
+}
+
+echo "First run:"
+analyze
+
+echo "Second run:"
+analyze
+
+echo "File changed:"
+printf 'const char *g_name = "name";\nvoid foo();\nvoid test() { return foo(); }\n' > "$DIR/check_history.cpp"
+analyze
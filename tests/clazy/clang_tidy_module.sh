@@ -0,0 +1,22 @@
+# Runs the clazy checks as clang-tidy checks, with ClazyTidyModule. Needs CLAZY_TIDY_MODULE, the path of
+# ClazyTidyModule.so, which is only built with -DCLAZY_BUILD_CLANG_TIDY_MODULE=ON.
+
+if [ -z "${CLANG_TIDY}" ]; then
+    CLANG_TIDY=clang-tidy
+fi
+
+run_clang_tidy()
+{
+    ${CLANG_TIDY} --load="${CLAZY_TIDY_MODULE}" --quiet -checks="$1" clazy/clang_tidy_module.cpp -- -std=c++14 2>&1 \
+        | grep "warning:" | sed "s|$(pwd)/||"
+}
+
+# Both checks run, through a single traversal, and report as the clang-tidy check of the same name
+run_clang_tidy '-*,clazy-returning-void-expression,clazy-global-const-char-pointer'
+
+# Only the enabled ones run
+run_clang_tidy '-*,clazy-returning-void-expression'
+
+# Each clazy check is listed
+${CLANG_TIDY} --load="${CLAZY_TIDY_MODULE}" -checks='-*,clazy-*' --list-checks \
+    | grep -E '^ *clazy-(returning-void-expression|global-const-char-pointer)$'
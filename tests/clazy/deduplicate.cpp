@@ -0,0 +1,7 @@
+#include <QtCore/QString>
+
+void test()
+{
+    QString s1 = QLatin1String("é"); // Warning, only qlatin1string-non-ascii
+    QString s2 = QLatin1String("e"); // Warning
+}
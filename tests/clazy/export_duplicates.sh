@@ -0,0 +1,29 @@
+# Exports the fixes of two translation units including the same header. The header's diagnostic is only exported once.
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+cat > "$DIR/export_duplicates.h" <<'CPP'
+#pragma once
+struct Name
+{
+    Name();
+    Name(const Name &);
+    ~Name();
+};
+
+inline bool isEmpty(Name name) { return false; }
+CPP
+
+for i in 1 2; do
+    printf '#include "export_duplicates.h"\nvoid use%s(Name name) { isEmpty(name); }\n' $i > "$DIR/export_duplicates$i.cpp"
+done
+
+${CLAZYSTANDALONE_CXX} -checks=function-args-by-ref -export-fixes="$DIR/fixes.yaml" \
+    "$DIR/export_duplicates1.cpp" "$DIR/export_duplicates2.cpp" -- -std=c++14 2>&1 | grep "clazy:"
+
+echo "Exported diagnostics: $(grep -c "DiagnosticName" "$DIR/fixes.yaml")"
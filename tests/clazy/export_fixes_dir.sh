@@ -0,0 +1,23 @@
+# Passes a directory to -export-fixes, which gets a YAML file per translation unit with warnings, named after its main
+# source file.
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+printf 'const char *g_name1 = "name";\n' > "$DIR/export1.cpp"
+printf 'const char *g_name2 = "name";\nconst char *g_other2 = "other";\n' > "$DIR/export2.cpp"
+printf 'const char *const g_name3 = "name";\n' > "$DIR/export3.cpp"
+mkdir "$DIR/fixes"
+
+${CLAZYSTANDALONE_CXX} -checks=global-const-char-pointer -export-fixes="$DIR/fixes" \
+    "$DIR/export1.cpp" "$DIR/export2.cpp" "$DIR/export3.cpp" -- -std=c++14 > /dev/null 2>&1
+echo "Exit status: $?"
+
+for file in $(ls "$DIR/fixes"); do
+    echo "$file" | sed 's/-[0-9a-f]*\.yaml$/.yaml/'
+    grep "FilePath" "$DIR/fixes/$file" | sed "s|.*$DIR/||; s|['\"]||g"
+done
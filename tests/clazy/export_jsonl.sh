@@ -0,0 +1,18 @@
+# Exports the warnings of two translation units to the same CLAZY_EXPORT_JSONL file, which is appended to
+
+unset CLAZY_CHECKS
+
+if [ -z "${CLAZY_CXX}" ]; then
+    CLAZY_CXX=clazy
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+export CLAZY_EXPORT_JSONL="$DIR/warnings.jsonl"
+export CLAZY_CHECKS="global-const-char-pointer,returning-void-expression"
+
+${CLAZY_CXX} -c -o /dev/null clazy/exporters.cpp 2> /dev/null
+printf 'void bar();\nvoid test3() { return bar(); }\n' | ${CLAZY_CXX} -c -o /dev/null -xc++ - 2> /dev/null
+
+cat "$CLAZY_EXPORT_JSONL"
@@ -0,0 +1,30 @@
+# Exports the warnings of two translation units to CLAZY_EXPORT_SARIF, one log each, the second one with -Werror
+
+unset CLAZY_CHECKS
+
+if [ -z "${CLAZY_CXX}" ]; then
+    CLAZY_CXX=clazy
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+export CLAZY_EXPORT_SARIF="$DIR/sarif"
+export CLAZY_CHECKS="global-const-char-pointer,returning-void-expression"
+
+${CLAZY_CXX} -c -o /dev/null clazy/exporters.cpp 2> /dev/null
+printf 'void bar();\nvoid test3() { return bar(); }\n' > "$DIR/werror.cpp"
+${CLAZY_CXX} -c -o /dev/null -Werror "$DIR/werror.cpp" 2> /dev/null
+
+# The file names end with a hash of the main file's path
+python3 - "$CLAZY_EXPORT_SARIF" <<'PYTHON' | sed -e "s|file://$(pwd)/||" -e "s|file://$DIR/||"
+import json, os, sys
+for filename in sorted(os.listdir(sys.argv[1])):
+    print(filename.split('-')[0])
+    run = json.load(open(os.path.join(sys.argv[1], filename)))['runs'][0]
+    print('    rules: ' + ', '.join(sorted(rule['id'] for rule in run['tool']['driver']['rules'])))
+    for result in run['results']:
+        location = result['locations'][0]['physicalLocation']
+        print('    %s:%d:%d: %s: %s [%s]' % (location['artifactLocation']['uri'], location['region']['startLine'],
+                                         location['region']['startColumn'], result['level'], result['message']['text'], result['ruleId']))
+PYTHON
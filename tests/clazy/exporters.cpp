@@ -0,0 +1,13 @@
+void foo();
+
+const char *g_name = "name"; // Warning
+
+void test()
+{
+    return foo(); // Warning
+}
+
+void test2()
+{
+    const char *name = "name"; // OK, not a global
+}
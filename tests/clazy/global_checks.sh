@@ -0,0 +1,82 @@
+# Indexes two translation units with the clazyMiniAstDumper plugin, merges the indexes and runs the global checks over them.
+# Point's Q_DECLARE_TYPEINFO is only included by the second translation unit, so only the merged index knows about it when
+# the first one uses QVector<Point>. Then with -j4, which must give the same output.
+
+if [ -z "${CLAZY_CXX}" ]; then
+    CLAZY_CXX=clazy
+fi
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+# Just enough of Qt for the index
+cat > "$DIR/qt.h" <<'CPP'
+#pragma once
+#define Q_OBJECT
+#define signals public
+class QObject
+{
+    Q_OBJECT
+public:
+    virtual ~QObject();
+};
+template <typename T> class QVector { T *d; };
+template <typename T> class QTypeInfo { };
+#define Q_DECLARE_TYPEINFO(TYPE, FLAGS) template <> class QTypeInfo<TYPE> { }
+CPP
+
+cat > "$DIR/base.h" <<'CPP'
+#include "qt.h"
+class Base : public QObject
+{
+    Q_OBJECT
+signals:
+    virtual void changed();
+    void resized();
+};
+CPP
+
+cat > "$DIR/derived.h" <<'CPP'
+#include "base.h"
+class Derived : public Base
+{
+    Q_OBJECT
+public:
+    void resized();
+};
+CPP
+
+printf '#pragma once\nstruct Point { int x, y; };\n' > "$DIR/point.h"
+printf '#pragma once\n#include "point.h"\n#include "qt.h"\nQ_DECLARE_TYPEINFO(Point, Q_PRIMITIVE_TYPE);\n' > "$DIR/point_typeinfo.h"
+printf '#pragma once\nstruct Size { int width, height; };\n' > "$DIR/size.h"
+printf '#include "derived.h"\n#include "point.h"\n#include "size.h"\nQVector<Point> g_points;\nQVector<Size> g_sizes;\n' > "$DIR/global_checks1.cpp"
+printf '#include "derived.h"\n#include "point_typeinfo.h"\n#include "size.h"\nvoid test() { QVector<Size> sizes; }\n' > "$DIR/global_checks2.cpp"
+
+for i in 1 2; do
+    ${CLAZY_CXX} -std=c++14 -fsyntax-only -Xclang -add-plugin -Xclang clazyMiniAstDumper \
+        -Xclang -plugin-arg-clazyMiniAstDumper -Xclang index-dir="$DIR/index" "$DIR/global_checks$i.cpp" > /dev/null 2>&1
+done
+
+${CLAZYSTANDALONE_CXX} -merge-index="$DIR/project.clazy-index" "$DIR"/index/*.clazy-index --
+
+analyze() {
+    ${CLAZYSTANDALONE_CXX} -global-checks="$DIR/project.clazy-index" -checks=missing-typeinfo,overridden-signal,virtual-signal \
+        "$@" -- 2>&1 | sed "s|$DIR/||"
+}
+
+echo "One thread:"
+analyze | tee "$DIR/j1.txt"
+
+for i in 1 2 3; do
+    analyze -j4 > "$DIR/j4.txt"
+    if cmp -s "$DIR/j1.txt" "$DIR/j4.txt"; then
+        echo "Same output with -j4"
+    else
+        echo "Different output with -j4:"
+        cat "$DIR/j4.txt"
+    fi
+done
@@ -0,0 +1,24 @@
+#ifndef HEADER_CACHE_H
+#define HEADER_CACHE_H
+
+#include "header_cache_types.h"
+
+struct NonTrivial
+{
+    NonTrivial();
+    NonTrivial(const NonTrivial &);
+    ~NonTrivial();
+    int value;
+};
+
+const char *headerCacheName = "header_cache"; // Warning
+
+inline int byValue(NonTrivial n) { return n.value; } // Warning
+
+inline int typesByValue(Types t) { return t.value; } // Warning once Types is non-trivial
+
+#ifdef HEADER_CACHE_EXTRA
+inline int extraByValue(NonTrivial n) { return n.value; } // Warning with HEADER_CACHE_EXTRA
+#endif
+
+#endif
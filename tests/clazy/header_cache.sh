@@ -0,0 +1,41 @@
+# Runs twice over header_cache.h, which is in the cache the second time, then changes what it's keyed by:
+# a header it includes and a macro defined before it's included.
+# function-args-by-ref visits the cached header and only its warnings are suppressed, global-const-char-pointer
+# is cache_safe and skips it.
+
+unset CLAZY_CHECKS
+
+if [ -z "${CLAZY_CXX}" ]; then
+    CLAZY_CXX=clazy
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+cp clazy/header_cache.h clazy/header_cache_types.h "$DIR"
+
+export CLAZY_HEADER_CACHE_DIR="$DIR/cache"
+export CLAZY_CHECKS="function-args-by-ref,global-const-char-pointer"
+
+analyze() {
+    printf "$1" | ${CLAZY_CXX} -c -o /dev/null -xc++ -I"$DIR" - 2>&1 | grep "warning:" | sed "s|$DIR/||"
+    echo "Cache entries: $(ls "$CLAZY_HEADER_CACHE_DIR" | grep -c "clazy-cache$")"
+}
+
+echo "Miss:"
+analyze '#include "header_cache.h"\n'
+
+echo "Hit:"
+analyze '#include "header_cache.h"\n'
+
+echo "Included header changed:"
+printf '#ifndef HEADER_CACHE_TYPES_H\n#define HEADER_CACHE_TYPES_H\n\nstruct Types\n{\n    ~Types();\n    int value;\n};\n\n#endif\n' > "$DIR/header_cache_types.h"
+analyze '#include "header_cache.h"\n'
+
+echo "Hit:"
+analyze '#include "header_cache.h"\n'
+
+echo "Macro defined before the include:"
+analyze '#define HEADER_CACHE_EXTRA\n#include "header_cache.h"\n'
+
+echo "Hit:"
+analyze '#define HEADER_CACHE_EXTRA\n#include "header_cache.h"\n'
@@ -0,0 +1,9 @@
+#ifndef HEADER_CACHE_TYPES_H
+#define HEADER_CACHE_TYPES_H
+
+struct Types
+{
+    int value;
+};
+
+#endif
@@ -0,0 +1,29 @@
+#include <QtCore/QString>
+
+void cold()
+{
+    qgetenv("Foo").isEmpty(); // OK, ran fewer times than CLAZY_MIN_HOTNESS
+}
+
+void hot()
+{
+    qgetenv("Foo").isEmpty(); // Warning, with its count
+}
+
+void sampled()
+{
+    qgetenv("Foo").isEmpty(); // Warning, with its samples
+}
+
+static void internal()
+{
+    qgetenv("Foo").isEmpty(); // Warning, it's prefixed with its file in the profile
+}
+
+void notProfiled()
+{
+    qgetenv("Foo").isEmpty(); // OK, never ran
+    internal();
+}
+
+bool g_empty = qgetenv("Foo").isEmpty(); // Warning, not in a function
@@ -0,0 +1,15 @@
+# Mixes the formats clazy reads
+Counters:
+  _Z4coldv:
+    Hash: 0x0000000000000001
+    Counters: 1
+    Function count: 10
+  _Z3hotv:
+    Hash: 0x0000000000000002
+    Counters: 1
+    Function count: 5000
+Instrumentation level: Front-end
+Functions shown: 2
+_Z7sampledv:2400:12
+ 1: 2400
+hotness.cpp:_ZL8internalv 300
@@ -0,0 +1,31 @@
+# Analyzes three translation units including header_cache.h, the second one with a macro changing it, with
+# -in-memory-header-cache. The first and third share the cache entry, the second has its own. The warnings must be the
+# same as without the cache, with one job and with -j2.
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+unset CLAZY_HEADER_CACHE_DIR
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+cp clazy/header_cache.h clazy/header_cache_types.h "$DIR"
+
+printf '#include "header_cache.h"\n' > "$DIR/in_memory_header_cache1.cpp"
+printf '#define HEADER_CACHE_EXTRA\n#include "header_cache.h"\n' > "$DIR/in_memory_header_cache2.cpp"
+printf '#include "header_cache.h"\n' > "$DIR/in_memory_header_cache3.cpp"
+
+analyze() {
+    ${CLAZYSTANDALONE_CXX} -checks=function-args-by-ref,global-const-char-pointer "$@" "$DIR/in_memory_header_cache1.cpp" \
+        "$DIR/in_memory_header_cache2.cpp" "$DIR/in_memory_header_cache3.cpp" -- -std=c++14 2>&1 \
+        | grep -E "warning:|error:" | sed "s|$DIR/||"
+}
+
+analyze | tee "$DIR/without.txt"
+
+analyze -in-memory-header-cache > "$DIR/with.txt"
+cmp -s "$DIR/without.txt" "$DIR/with.txt" && echo "Same output with -in-memory-header-cache"
+
+analyze -in-memory-header-cache -j2 > "$DIR/with_j2.txt"
+cmp -s "$DIR/without.txt" "$DIR/with_j2.txt" && echo "Same output with -in-memory-header-cache -j2"
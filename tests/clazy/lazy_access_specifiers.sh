@@ -0,0 +1,43 @@
+# Runs virtual-signal, which needs the AccessSpecifierManager, over a translation unit without any Q_OBJECT, where the
+# manager must not record anything, and over one with a QObject, where it must record the access specifiers and the
+# virtual signal is found.
+
+unset CLAZY_CHECKS
+
+if [ -z "${CLAZY_CXX}" ]; then
+    CLAZY_CXX=clazy
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+cat > "$DIR/lazy_access_specifiers1.cpp" <<'CPP'
+#define Q_OBJECT
+#define signals public
+class Plain
+{
+public:
+    void f();
+private:
+    int m;
+};
+CPP
+
+cat "$DIR/lazy_access_specifiers1.cpp" - > "$DIR/lazy_access_specifiers2.cpp" <<'CPP'
+class QObject
+{
+    Q_OBJECT
+public:
+    virtual ~QObject();
+signals:
+    virtual void changed();
+};
+CPP
+
+export CLAZY_CHECKS="virtual-signal"
+
+for i in 1 2; do
+    ${CLAZY_CXX} -c -o /dev/null -Xclang -plugin-arg-clazy -Xclang print-stats "$DIR/lazy_access_specifiers$i.cpp" 2>&1 \
+        | grep -E "warning:|AccessSpecifierManager:" | sed "s|$DIR/||; s|^ *||" \
+        | sed -E "s/AccessSpecifierManager: [1-9][0-9]* classes, [1-9][0-9]* specifiers/AccessSpecifierManager: some classes and specifiers/"
+done
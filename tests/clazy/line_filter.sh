@@ -0,0 +1,45 @@
+# Only gets the warnings of some lines, with clazy-standalone's -line-filter and with CLAZY_LINE_FILTER for the plugin.
+# Files that aren't listed get no warnings, and an invalid filter is an error.
+
+unset CLAZY_CHECKS
+unset CLAZY_LINE_FILTER
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+if [ -z "${CLAZY_CXX}" ]; then
+    CLAZY_CXX=clazy
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+cat > "$DIR/line_filter.cpp" <<'CPP'
+const char *g_name = "name";
+void foo();
+void test1() { return foo(); }
+void test2() { return foo(); }
+void test3() { return foo(); }
+CPP
+
+analyze() {
+    ${CLAZYSTANDALONE_CXX} -checks=global-const-char-pointer,returning-void-expression -line-filter="$1" \
+        "$DIR/line_filter.cpp" -- -std=c++14 2>&1 | grep -E "warning:|clazy-standalone:" | sed "s|$DIR/||"
+}
+
+echo "Lines 1 and 4:"
+analyze '[{"name":"line_filter.cpp","lines":[[1,1],[4,4]]}]'
+
+echo "Whole file:"
+analyze '[{"name":"line_filter.cpp"}]'
+
+echo "Other file:"
+analyze '[{"name":"other.cpp"}]'
+
+echo "Invalid:"
+analyze '[{"lines":[[1,1]]}]'
+
+echo "Plugin, lines 3 to 5:"
+CLAZY_CHECKS="global-const-char-pointer,returning-void-expression" CLAZY_LINE_FILTER='[{"name":"line_filter.cpp","lines":[[3,5]]}]' \
+    ${CLAZY_CXX} -c -o /dev/null "$DIR/line_filter.cpp" 2>&1 | grep "warning:" | sed "s|$DIR/||"
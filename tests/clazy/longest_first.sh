@@ -0,0 +1,26 @@
+# Analyzes three files with -max-warnings=1, so only the first file analyzed warns. That's the biggest file, or the one
+# which took the longest according to -costs, not the first one passed.
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+printf 'const char *g_name1 = "name";\n' > "$DIR/longest1.cpp"
+printf '// Padding to make this the biggest file\nconst char *g_name2 = "name";\n' > "$DIR/longest2.cpp"
+printf 'const char *g_name3 = "name";\n' > "$DIR/longest3.cpp"
+
+analyze() {
+    ${CLAZYSTANDALONE_CXX} -checks=global-const-char-pointer -max-warnings=1 "$@" \
+        "$DIR/longest1.cpp" "$DIR/longest2.cpp" "$DIR/longest3.cpp" -- -std=c++14 2>&1 \
+        | grep -E "warning:|clazy-standalone:" | sed "s|$DIR/||"
+}
+
+echo "By size:"
+analyze
+
+echo "By costs:"
+printf '1 %s\n1 %s\n5 %s\n' "$DIR/longest1.cpp" "$DIR/longest2.cpp" "$DIR/longest3.cpp" > "$DIR/costs.txt"
+analyze -costs="$DIR/costs.txt"
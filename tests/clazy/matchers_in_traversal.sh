@@ -0,0 +1,36 @@
+# Runs qcolor-from-literal, which has an AST matcher for the QColor constructor and a VisitStmt() for setNamedColor(),
+# without and with -matchers-in-traversal. Both find the same warnings, but the matcher only runs after the traversal
+# by default, while it runs on the nodes of the traversal, so in source order, with -matchers-in-traversal.
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+cat > "$DIR/matchers_in_traversal.cpp" <<'CPP'
+class QColor
+{
+public:
+    QColor(const char *name);
+    void setNamedColor(const char *name);
+};
+
+void test()
+{
+    QColor c("#ff0000");
+    c.setNamedColor("#00ff00");
+}
+CPP
+
+analyze() {
+    ${CLAZYSTANDALONE_CXX} -checks=qcolor-from-literal "$@" "$DIR/matchers_in_traversal.cpp" -- -std=c++14 2>&1 \
+        | grep "warning:" | sed "s|$DIR/||"
+}
+
+echo "Second traversal:"
+analyze
+
+echo "In the traversal:"
+analyze -matchers-in-traversal
@@ -0,0 +1,26 @@
+# Runs three translation units with -j3 under a -max-memory budget smaller than clazy-standalone itself, so they can
+# only run one at a time, but must all be analyzed. How many had to wait depends on timing, so that message isn't
+# compared. -memory-costs records how much memory each one took.
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+for i in 1 2 3; do
+    printf 'const char *g_name%s = "name";\n' $i > "$DIR/max_memory$i.cpp"
+done
+
+${CLAZYSTANDALONE_CXX} -checks=global-const-char-pointer -j3 -max-memory=1 -memory-costs="$DIR/memory.txt" \
+    "$DIR/max_memory1.cpp" "$DIR/max_memory2.cpp" "$DIR/max_memory3.cpp" -- -std=c++14 > "$DIR/output.txt" 2>&1
+echo "Exit status: $?"
+grep -E "warning:|error:" "$DIR/output.txt" | sed "s|$DIR/||"
+
+# "<megabytes> <file>" lines
+sed "s|$DIR/||" "$DIR/memory.txt" | awk '{ print $2 ": " ($1 > 0 ? "measured" : "not measured") }' | sort
+
+echo "With -watch:"
+${CLAZYSTANDALONE_CXX} -checks=global-const-char-pointer -max-memory=1 -watch "$DIR/max_memory1.cpp" -- -std=c++14 2>&1 \
+    | grep "clazy-standalone:"
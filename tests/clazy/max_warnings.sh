@@ -0,0 +1,37 @@
+# Stops after two warnings with CLAZY_MAX_WARNINGS, within the translation unit, not counting the suppressed one.
+# Then stops after three warnings across the two translation units of a clazy-standalone run, which exits with 1.
+
+unset CLAZY_CHECKS
+unset CLAZY_MAX_WARNINGS
+
+if [ -z "${CLAZY_CXX}" ]; then
+    CLAZY_CXX=clazy
+fi
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+cat > "$DIR/max_warnings.cpp" <<'CPP'
+const char *g_name1 = "name"; // clazy:exclude=global-const-char-pointer
+const char *g_name2 = "name";
+const char *g_name3 = "name";
+const char *g_name4 = "name";
+CPP
+
+for i in 1 2; do
+    printf 'const char *g_a%s = "a";\nconst char *g_b%s = "b";\n' $i $i > "$DIR/max_warnings$i.cpp"
+done
+
+echo "Plugin:"
+CLAZY_CHECKS=global-const-char-pointer CLAZY_MAX_WARNINGS=2 ${CLAZY_CXX} -c -o /dev/null "$DIR/max_warnings.cpp" 2>&1 \
+    | grep "warning:" | sed "s|$DIR/||"
+
+echo "Standalone:"
+${CLAZYSTANDALONE_CXX} -checks=global-const-char-pointer -max-warnings=3 "$DIR/max_warnings1.cpp" "$DIR/max_warnings2.cpp" \
+    -- -std=c++14 > "$DIR/output.txt" 2>&1
+echo "Exit status: $?"
+grep -E "warning:|clazy-standalone:" "$DIR/output.txt" | sed "s|$DIR/||"
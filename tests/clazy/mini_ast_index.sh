@@ -0,0 +1,47 @@
+# Indexes two translation units including the same header with the clazyMiniAstDumper plugin, which writes each index
+# next to its source file. Merging them must drop the header's duplicate class, so the global check warns once. Merging
+# a file which isn't an index fails.
+
+if [ -z "${CLAZY_CXX}" ]; then
+    CLAZY_CXX=clazy
+fi
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+cat > "$DIR/mini_ast_index.h" <<'CPP'
+#pragma once
+#define Q_OBJECT
+#define signals public
+class QObject
+{
+    Q_OBJECT
+public:
+    virtual ~QObject();
+};
+
+class Base : public QObject
+{
+    Q_OBJECT
+signals:
+    virtual void changed();
+};
+CPP
+
+for i in 1 2; do
+    printf '#include "mini_ast_index.h"\nvoid test%s(Base *base) { base->changed(); }\n' $i > "$DIR/mini_ast_index$i.cpp"
+    ${CLAZY_CXX} -std=c++14 -fsyntax-only -Xclang -add-plugin -Xclang clazyMiniAstDumper "$DIR/mini_ast_index$i.cpp" > /dev/null 2>&1
+done
+
+ls "$DIR" | grep "clazy-index"
+
+${CLAZYSTANDALONE_CXX} -merge-index="$DIR/project.clazy-index" "$DIR/mini_ast_index1.cpp.clazy-index" "$DIR/mini_ast_index2.cpp.clazy-index" --
+echo "Exit status: $?"
+${CLAZYSTANDALONE_CXX} -global-checks="$DIR/project.clazy-index" -checks=virtual-signal -- 2>&1 | sed "s|$DIR/||"
+
+echo "Not an index:"
+${CLAZYSTANDALONE_CXX} -merge-index="$DIR/broken.clazy-index" "$DIR/mini_ast_index1.cpp" -- 2>&1 | sed "s|$DIR/||"
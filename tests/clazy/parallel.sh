@@ -0,0 +1,27 @@
+# Analyzes six translation units with -j3, one of them not compiling. The diagnostics must come out in the order the
+# files were passed, the same as without -j, and the exit status must tell about the failure.
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+for i in 1 2 4 5 6; do
+    printf 'const char *g_name%s = "name";\n' $i > "$DIR/parallel$i.cpp"
+done
+printf 'garbage g_name3;\n' > "$DIR/parallel3.cpp"
+
+analyze() {
+    ${CLAZYSTANDALONE_CXX} -checks=global-const-char-pointer "$@" "$DIR/parallel4.cpp" "$DIR/parallel1.cpp" "$DIR/parallel6.cpp" \
+        "$DIR/parallel3.cpp" "$DIR/parallel2.cpp" "$DIR/parallel5.cpp" -- -std=c++14 > "$DIR/output.txt" 2>&1
+    echo "Exit status: $?"
+    grep -E "warning:|error:" "$DIR/output.txt" | sed "s|$DIR/||"
+}
+
+echo "One job:"
+analyze
+
+echo "Three jobs:"
+analyze -j3
@@ -0,0 +1,27 @@
+# Prints the hardware counters of two checks with -perf-counters. The values vary from run to run, so only whether each
+# check's instructions were counted is compared. Needs a kernel and a CPU giving access to the counters, which virtual
+# machines often don't, so it only runs with CLAZY_TEST_PERF_COUNTERS set.
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+cat > "$DIR/perf_counters.cpp" <<'CPP'
+const char *g_name = "name";
+void foo();
+void test() { return foo(); }
+CPP
+
+${CLAZYSTANDALONE_CXX} -checks=global-const-char-pointer,returning-void-expression -perf-counters "$DIR/perf_counters.cpp" \
+    -- -std=c++14 > "$DIR/output.txt" 2>&1
+
+grep "Hardware performance counters aren't available" "$DIR/output.txt"
+grep "Hardware counters, in user space" "$DIR/output.txt" | sed "s|^ *||"
+
+# The rows after the counters' title
+sed -n '/Hardware counters, in user space/,$p' "$DIR/output.txt" \
+    | grep -E "^ +(global-const-char-pointer|returning-void-expression) " \
+    | awk '{ print $1 ": " ($2 > 0 && $3 > 0 ? "instructions and cycles counted" : "nothing counted") }' | sort
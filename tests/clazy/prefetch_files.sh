@@ -0,0 +1,40 @@
+# Analyzes two translation units sharing a header, and looking for a missing one, with -prefetch-files and -j2. The
+# output must be the same as without it. Then with -cache-dir, where the second run reads ahead the files of the
+# stale entry. -prefetch-files can't be used with -watch.
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+mkdir "$DIR/include"
+cat > "$DIR/include/prefetch_files.h" <<'CPP'
+#pragma once
+#if __has_include("prefetch_files_missing.h")
+#include "prefetch_files_missing.h"
+#endif
+typedef void Result;
+CPP
+
+for i in 1 2; do
+    printf '#include "prefetch_files.h"\nResult foo();\nResult test%s() { return foo(); }\n' $i > "$DIR/prefetch_files$i.cpp"
+done
+
+analyze() {
+    ${CLAZYSTANDALONE_CXX} -checks=returning-void-expression "$@" "$DIR/prefetch_files1.cpp" "$DIR/prefetch_files2.cpp" \
+        -- -std=c++17 -I"$DIR/include" 2>&1 | grep -E "warning:|error:|clazy-standalone:" | sed "s|$DIR/||"
+}
+
+analyze | tee "$DIR/without.txt"
+analyze -prefetch-files=4 -j2 > "$DIR/with.txt"
+cmp -s "$DIR/without.txt" "$DIR/with.txt" && echo "Same output with -prefetch-files"
+
+echo "With -cache-dir:"
+analyze -prefetch-files=4 -cache-dir="$DIR/cache" > /dev/null
+printf '#include "prefetch_files.h"\n\nResult foo();\nResult test2() { return foo(); }\n' > "$DIR/prefetch_files2.cpp"
+analyze -prefetch-files=4 -cache-dir="$DIR/cache"
+
+echo "With -watch:"
+analyze -prefetch-files=4 -watch
@@ -0,0 +1,26 @@
+# Only enables returning-void-expression, which visits ReturnStmts, so the bodies without a return statement are skipped
+# by the pre-screen, while the ones with a return, even a nested one, are still traversed.
+
+unset CLAZY_CHECKS
+
+if [ -z "${CLAZY_CXX}" ]; then
+    CLAZY_CXX=clazy
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+cat > "$DIR/prescreen.cpp" <<'CPP'
+void foo();
+void test() { return foo(); }
+void nested(bool b) { if (b) { return foo(); } }
+void noReturn() { foo(); }
+void noReturn2() { int i = 0; (void)i; }
+CPP
+
+export CLAZY_CHECKS="returning-void-expression"
+
+${CLAZY_CXX} -c -o /dev/null -Xclang -plugin-arg-clazy -Xclang print-stats "$DIR/prescreen.cpp" > "$DIR/output.txt" 2>&1
+
+grep "warning:" "$DIR/output.txt" | sed "s|$DIR/||"
+grep "Function bodies skipped by the pre-screen:" "$DIR/output.txt" | sed "s|^ *||"
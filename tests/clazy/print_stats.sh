@@ -0,0 +1,29 @@
+# Prints the stats of two checks with print-stats. The times vary from run to run, so only the file, the rows of
+# the checks and how often they were called are compared. The rows are sorted by time, so by name here.
+
+unset CLAZY_CHECKS
+
+if [ -z "${CLAZY_CXX}" ]; then
+    CLAZY_CXX=clazy
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+cat > "$DIR/print_stats.cpp" <<'CPP'
+const char *g_name = "name";
+const char *g_other = "other";
+void foo();
+void test() { return foo(); }
+void other() { foo(); }
+CPP
+
+export CLAZY_CHECKS="global-const-char-pointer,returning-void-expression"
+
+${CLAZY_CXX} -c -o /dev/null -Xclang -plugin-arg-clazy -Xclang print-stats "$DIR/print_stats.cpp" > "$DIR/output.txt" 2>&1
+
+grep "^clazy stats for" "$DIR/output.txt" | sed "s|$DIR/||"
+grep -E "^ +check +total\(ms\) +VisitStmt\(ms\) +calls +VisitDecl\(ms\) +calls" "$DIR/output.txt" | awk '{ print $1, $2, $3, $4, $5, $6 }'
+grep -E "^ +(global-const-char-pointer|returning-void-expression) " "$DIR/output.txt" \
+    | awk '{ print $1 ": VisitStmt calls " $4 ", VisitDecl calls " $6 }' | sort
+grep -c "warning:" "$DIR/output.txt"
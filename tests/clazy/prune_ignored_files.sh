@@ -0,0 +1,35 @@
+# Includes a header from a directory matched by CLAZY_IGNORE_DIRS. Its three declarations aren't traversed at all, which
+# print-stats counts, and its warnings aren't emitted. Without CLAZY_IGNORE_DIRS nothing is pruned.
+
+unset CLAZY_CHECKS
+unset CLAZY_IGNORE_DIRS
+unset CLAZY_HEADER_FILTER
+
+if [ -z "${CLAZY_CXX}" ]; then
+    CLAZY_CXX=clazy
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+mkdir "$DIR/3rdparty"
+cat > "$DIR/3rdparty/prune_ignored_files.h" <<'CPP'
+void bar();
+inline void baz() { return bar(); }
+struct Bar { void qux() { return bar(); } };
+CPP
+
+printf '#include "3rdparty/prune_ignored_files.h"\nvoid test() { return bar(); }\n' > "$DIR/prune_ignored_files.cpp"
+
+export CLAZY_CHECKS="returning-void-expression"
+
+analyze() {
+    ${CLAZY_CXX} -c -o /dev/null -Xclang -plugin-arg-clazy -Xclang print-stats "$DIR/prune_ignored_files.cpp" 2>&1 \
+        | grep -E "warning:|Declarations pruned" | sed "s|$DIR/||; s|^ *||"
+}
+
+echo "Ignored:"
+CLAZY_IGNORE_DIRS=".*3rdparty.*" analyze
+
+echo "Not ignored:"
+analyze
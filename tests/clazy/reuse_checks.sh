@@ -0,0 +1,33 @@
+# Analyzes three translation units in one clazy-standalone run, which reuses the check instances for the next one.
+# The second one is built with -Werror, so the diagnostic IDs of the previous translation unit mustn't be kept.
+# Then again with -j2, where each thread reuses its own instances.
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+for i in 1 2 3; do
+    printf 'const char *g_name%s = "name";\nvoid foo();\nvoid test%s() { return foo(); }\n' $i $i > "$DIR/reuse_checks$i.cpp"
+done
+
+cat > "$DIR/compile_commands.json" <<JSON
+[
+    { "directory": "$DIR", "file": "$DIR/reuse_checks1.cpp", "command": "c++ -std=c++14 -c reuse_checks1.cpp" },
+    { "directory": "$DIR", "file": "$DIR/reuse_checks2.cpp", "command": "c++ -std=c++14 -Werror -c reuse_checks2.cpp" },
+    { "directory": "$DIR", "file": "$DIR/reuse_checks3.cpp", "command": "c++ -std=c++14 -c reuse_checks3.cpp" }
+]
+JSON
+
+analyze() {
+    ${CLAZYSTANDALONE_CXX} -p "$DIR" -checks=global-const-char-pointer,returning-void-expression "$@" \
+        "$DIR/reuse_checks1.cpp" "$DIR/reuse_checks2.cpp" "$DIR/reuse_checks3.cpp" 2>&1 | grep -E "warning:|error:" | sed "s|$DIR/||"
+}
+
+echo "One thread:"
+analyze
+
+echo "Two threads:"
+analyze -j2
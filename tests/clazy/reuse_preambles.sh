@@ -0,0 +1,48 @@
+# Sends the same file to clazy-standalone -server -reuse-preambles after editing its body, whose preamble is reused,
+# and after editing the header it includes, whose preamble must be rebuilt.
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+DIR=$(mktemp -d)
+
+printf 'struct Name { Name(); Name(const Name &); ~Name(); };\n' > "$DIR/reuse_preambles.h"
+printf '#include "reuse_preambles.h"\nvoid use(Name name) {}\n' > "$DIR/reuse_preambles.cpp"
+
+${CLAZYSTANDALONE_CXX} -server="$DIR/socket" -reuse-preambles -checks=function-args-by-ref -- -std=c++14 2> /dev/null &
+SERVER_PID=$!
+trap 'kill $SERVER_PID; rm -rf "$DIR"' EXIT
+
+for i in $(seq 100); do
+    [ -S "$DIR/socket" ] && break
+    sleep 0.1
+done
+
+request() {
+    printf "$DIR/reuse_preambles.cpp\n\n" | python3 -c '
+import socket, sys
+client = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+client.connect(sys.argv[1])
+client.sendall(sys.stdin.buffer.read())
+client.shutdown(socket.SHUT_WR)
+reply = b""
+while True:
+    data = client.recv(4096)
+    if not data:
+        break
+    reply += data
+sys.stdout.write(reply.decode())
+' "$DIR/socket" | grep -E "warning:|error:|^exit:" | sed "s|$DIR/||"
+}
+
+echo "First request:"
+request
+
+echo "Body changed:"
+printf '#include "reuse_preambles.h"\n\nvoid use(Name name) {}\n' > "$DIR/reuse_preambles.cpp"
+request
+
+echo "Header changed:"
+printf 'struct Name { int id; };\n' > "$DIR/reuse_preambles.h"
+request
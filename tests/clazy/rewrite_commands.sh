@@ -0,0 +1,33 @@
+# The compilation database compiles the same file twice, into different object files, with an argument clang doesn't know
+# and a precompiled header which doesn't exist. -remove-arg-prefix and -strip-pch fix the commands, and the file is
+# only analyzed once.
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+printf 'const char *g_name = "name";\n' > "$DIR/rewrite_commands.cpp"
+
+cat > "$DIR/compile_commands.json" <<JSON
+[
+    { "directory": "$DIR", "file": "$DIR/rewrite_commands.cpp",
+      "command": "c++ -std=c++14 -fbogus-option -include-pch missing.pch -c rewrite_commands.cpp -o static.o" },
+    { "directory": "$DIR", "file": "$DIR/rewrite_commands.cpp",
+      "command": "c++ -std=c++14 -fbogus-option -include-pch missing.pch -c rewrite_commands.cpp -o shared.o" }
+]
+JSON
+
+analyze() {
+    ${CLAZYSTANDALONE_CXX} -p "$DIR" -checks=global-const-char-pointer "$@" "$DIR/rewrite_commands.cpp" > "$DIR/output.txt" 2>&1
+    echo "Exit status: $?"
+    grep "warning:" "$DIR/output.txt" | sed "s|$DIR/||"
+}
+
+echo "As is:"
+analyze
+
+echo "Rewritten:"
+analyze -remove-arg-prefix=-fbogus -strip-pch
@@ -0,0 +1,30 @@
+# Samples half of the files of a compilation database, per directory, and estimates the warnings of each check. All the
+# files of a directory warn the same way, so the estimates don't depend on which files are picked.
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+mkdir "$DIR/globals" "$DIR/returns"
+echo "[" > "$DIR/compile_commands.json"
+for i in 1 2 3 4; do
+    printf 'const char *g_name = "name";\n' > "$DIR/globals/sample$i.cpp"
+    echo "{ \"directory\": \"$DIR/globals\", \"file\": \"$DIR/globals/sample$i.cpp\", \"command\": \"c++ -std=c++14 -c sample$i.cpp\" }," >> "$DIR/compile_commands.json"
+done
+for i in 1 2; do
+    printf 'void foo();\nvoid test1() { return foo(); }\nvoid test2() { return foo(); }\n' > "$DIR/returns/sample$i.cpp"
+    echo "{ \"directory\": \"$DIR/returns\", \"file\": \"$DIR/returns/sample$i.cpp\", \"command\": \"c++ -std=c++14 -c sample$i.cpp\" }," >> "$DIR/compile_commands.json"
+done
+sed -i '$ s/,$//' "$DIR/compile_commands.json"
+echo "]" >> "$DIR/compile_commands.json"
+
+${CLAZYSTANDALONE_CXX} -p "$DIR" -checks=global-const-char-pointer,returning-void-expression -sample=0.5 > "$DIR/output.txt" 2>&1
+echo "Exit status: $?"
+echo "Warnings: $(grep -c "warning:" "$DIR/output.txt")"
+sed -n '/Estimated warnings per check/,$p' "$DIR/output.txt"
+
+echo "Invalid:"
+${CLAZYSTANDALONE_CXX} -p "$DIR" -checks=global-const-char-pointer -sample=2 2>&1 | grep "clazy-standalone:"
@@ -0,0 +1,53 @@
+# Starts clazy-standalone -server and sends it requests over its Unix socket: with its own checks, with the checks of the
+# request, after a file changed, for a file that doesn't exist and without any file.
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+DIR=$(mktemp -d)
+
+printf 'const char *g_name = "name";\nvoid foo();\nvoid test() { return foo(); }\n' > "$DIR/server1.cpp"
+printf 'void bar();\nvoid test2() { return bar(); }\n' > "$DIR/server2.cpp"
+
+${CLAZYSTANDALONE_CXX} -server="$DIR/socket" -checks=global-const-char-pointer -- -std=c++14 2> /dev/null &
+SERVER_PID=$!
+trap 'kill $SERVER_PID; rm -rf "$DIR"' EXIT
+
+for i in $(seq 100); do
+    [ -S "$DIR/socket" ] && break
+    sleep 0.1
+done
+
+request() {
+    printf "$1" | python3 -c '
+import socket, sys
+client = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+client.connect(sys.argv[1])
+client.sendall(sys.stdin.buffer.read())
+client.shutdown(socket.SHUT_WR)
+reply = b""
+while True:
+    data = client.recv(4096)
+    if not data:
+        break
+    reply += data
+sys.stdout.write(reply.decode())
+' "$DIR/socket" | grep -E "warning:|^exit:" | sed "s|$DIR/||"
+}
+
+echo "Server's checks:"
+request "$DIR/server1.cpp\n\n"
+
+echo "Request's checks:"
+request "checks=returning-void-expression\n$DIR/server1.cpp\n$DIR/server2.cpp\n\n"
+
+echo "File changed:"
+printf '\nconst char *g_name = "name";\n' > "$DIR/server1.cpp"
+request "$DIR/server1.cpp\n\n"
+
+echo "Missing file:"
+request "$DIR/missing.cpp\n\n"
+
+echo "No file:"
+request "\n"
@@ -0,0 +1,38 @@
+# Splits the files of a compilation database into two shards balanced by the costs of a previous run, analyzes each
+# shard with -export-fixes and merges their fixes with -merge-fixes.
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+for i in 1 2 3; do
+    printf 'const char *g_name%s = "name";\n' $i > "$DIR/shard$i.cpp"
+done
+
+cat > "$DIR/compile_commands.json" <<JSON
+[
+    { "directory": "$DIR", "file": "$DIR/shard1.cpp", "command": "c++ -std=c++14 -c shard1.cpp" },
+    { "directory": "$DIR", "file": "$DIR/shard2.cpp", "command": "c++ -std=c++14 -c shard2.cpp" },
+    { "directory": "$DIR", "file": "$DIR/shard3.cpp", "command": "c++ -std=c++14 -c shard3.cpp" }
+]
+JSON
+
+# shard1.cpp costs as much as the other two together
+printf '3 %s\n2 %s\n1 %s\n' "$DIR/shard1.cpp" "$DIR/shard2.cpp" "$DIR/shard3.cpp" > "$DIR/costs.txt"
+
+for shard in 1 2; do
+    echo "Shard $shard:"
+    ${CLAZYSTANDALONE_CXX} -p "$DIR" -checks=global-const-char-pointer -shard=$shard/2 -costs="$DIR/costs.txt" \
+        -export-fixes="$DIR/shard$shard.yaml" 2>&1 | grep "warning:" | sed "s|$DIR/||"
+done
+
+echo "Merged:"
+${CLAZYSTANDALONE_CXX} -merge-fixes="$DIR/merged.yaml" "$DIR/shard2.yaml" "$DIR/shard1.yaml"
+echo "Exit status: $?"
+grep "FilePath" "$DIR/merged.yaml" | sed "s|.*$DIR/||; s|['\"]||g"
+
+echo "Invalid shard:"
+${CLAZYSTANDALONE_CXX} -p "$DIR" -checks=global-const-char-pointer -shard=3/2 2>&1 | grep "clazy-standalone:"
@@ -0,0 +1,24 @@
+# The header has a function body which doesn't compile. With only checks ignoring function bodies, the bodies of the
+# headers aren't parsed, so there's no error. Another check needing the bodies brings the error back.
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+printf 'const char *g_header = "header";\ninline void broken() { garbage; }\n' > "$DIR/skip_function_bodies.h"
+printf '#include "skip_function_bodies.h"\nconst char *g_name = "name";\n' > "$DIR/skip_function_bodies.cpp"
+
+analyze() {
+    ${CLAZYSTANDALONE_CXX} -checks="$1" "$DIR/skip_function_bodies.cpp" -- -std=c++14 > "$DIR/output.txt" 2>&1
+    echo "Exit status: $?"
+    grep -E "warning:|error:" "$DIR/output.txt" | sed "s|$DIR/||"
+}
+
+echo "Declaration checks only:"
+analyze global-const-char-pointer
+
+echo "With a statement check:"
+analyze global-const-char-pointer,returning-void-expression
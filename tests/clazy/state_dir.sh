@@ -0,0 +1,43 @@
+# Interrupts a -state-dir run while it's stuck reading a FIFO in its third translation unit, after journaling the first
+# two. Resuming prints the journaled diagnostics of the first two, even though the first file changed meanwhile, and
+# only analyzes the third one. The journal is removed once the run completes.
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+DIR=$(mktemp -d)
+trap 'kill -9 $RUN_PID 2> /dev/null; rm -rf "$DIR"' EXIT
+
+printf 'const char *g_name1 = "name";\n' > "$DIR/state_dir1.cpp"
+printf 'const char *g_name2 = "name";\n' > "$DIR/state_dir2.cpp"
+printf '#include "state_dir3.inc"\n' > "$DIR/state_dir3.cpp"
+mkfifo "$DIR/state_dir3.inc"
+
+# Analyzed in this order, one at a time
+printf '3 %s\n2 %s\n1 %s\n' "$DIR/state_dir1.cpp" "$DIR/state_dir2.cpp" "$DIR/state_dir3.cpp" > "$DIR/costs.txt"
+
+analyze() {
+    ${CLAZYSTANDALONE_CXX} -checks=global-const-char-pointer -state-dir="$DIR/state" -costs="$DIR/costs.txt" \
+        "$DIR/state_dir1.cpp" "$DIR/state_dir2.cpp" "$DIR/state_dir3.cpp" -- -std=c++14
+}
+
+analyze > /dev/null 2>&1 &
+RUN_PID=$!
+
+for i in $(seq 100); do
+    [ "$(cat "$DIR"/state/*.journal 2> /dev/null | grep -c -E "^[0-9]+ [0-9]+ [0-9]+$")" -ge 2 ] && break
+    sleep 0.1
+done
+kill -9 $RUN_PID
+wait $RUN_PID 2> /dev/null
+
+rm "$DIR/state_dir3.inc"
+printf 'const char *g_name3 = "name";\n' > "$DIR/state_dir3.inc"
+printf '\nconst char *g_name1 = "name";\n' > "$DIR/state_dir1.cpp"
+
+echo "Resumed:"
+analyze > "$DIR/output.txt" 2>&1
+echo "Exit status: $?"
+grep -E "warning:|error:|clazy-standalone:" "$DIR/output.txt" | sed "s|$DIR/||"
+echo "Journals left: $(ls "$DIR/state" | wc -l)"
@@ -0,0 +1,28 @@
+# Writes the statistics of a run over three files with -stats-json. The times vary from run to run, so only the counts,
+# the warnings and their distribution over the translation units, and the slowest files' dominant check are compared.
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+printf 'const char *g_name1 = "name";\n' > "$DIR/stats_json1.cpp"
+printf 'const char *g_name2 = "name";\nconst char *g_other2 = "other";\n' > "$DIR/stats_json2.cpp"
+printf 'const char *const g_name3 = "name";\n' > "$DIR/stats_json3.cpp"
+
+${CLAZYSTANDALONE_CXX} -checks=global-const-char-pointer -stats-json="$DIR/stats.json" -stats-slowest=2 \
+    "$DIR/stats_json1.cpp" "$DIR/stats_json2.cpp" "$DIR/stats_json3.cpp" -- -std=c++14 > /dev/null 2>&1
+echo "Exit status: $?"
+
+python3 - "$DIR/stats.json" <<'PY'
+import json, sys
+stats = json.load(open(sys.argv[1]))
+print("translation_units: %d" % stats["translation_units"])
+print("warnings per translation unit: %s" % json.dumps(stats["per_translation_unit"]["warnings"], sort_keys=True))
+print("result_cache: %s" % json.dumps(stats["result_cache"], sort_keys=True))
+for name, check in sorted(stats["checks"].items()):
+    print("%s: %d warnings" % (name, check["warnings"]))
+print("slowest: %s" % ", ".join(tu["dominant_check"] for tu in stats["slowest_translation_units"]))
+PY
@@ -109,3 +109,10 @@ echo | $CLAZY_COMMAND_STDIN
 export CLAZY_CHECKS="no-qenums"
 echo | $CLAZY_COMMAND_STDIN
 
+
+# Only the cheap checks of a level, an explicitly requested check is kept regardless of its cost
+export CLAZY_CHECKS="level0,cheap"
+echo | $CLAZY_COMMAND_STDIN
+
+export CLAZY_CHECKS="level0,cheap,strict-iterators"
+echo | $CLAZY_COMMAND_STDIN
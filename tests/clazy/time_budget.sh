@@ -0,0 +1,31 @@
+# Analyzes a generated translation unit with a budget of 1 ms, which it's big enough to always exceed:
+# first for implicit-casts, which visits every statement, then for the whole traversal.
+# global-const-char-pointer warns about the last declaration, after the budget is used up.
+
+unset CLAZY_CHECKS
+
+if [ -z "${CLAZY_CXX}" ]; then
+    CLAZY_CXX=clazy
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+echo 'int g;' > "$DIR/time_budget.cpp"
+seq 20000 | sed 's|.*|int f&() { return g + g * 2 - g / 3 + &; }|' >> "$DIR/time_budget.cpp"
+echo 'const char *g_name = "name";' >> "$DIR/time_budget.cpp"
+
+export CLAZY_CHECKS="implicit-casts,global-const-char-pointer"
+
+analyze() {
+    ${CLAZY_CXX} -c -o /dev/null "$DIR/time_budget.cpp" 2>&1 | grep -E "^clazy:|warning:" | sed "s|$DIR/||"
+}
+
+echo "Check time budget:"
+CLAZY_CHECK_TIME_BUDGET=1 analyze
+
+echo "Time budget:"
+CLAZY_TIME_BUDGET=1 analyze
+
+echo "Invalid time budget:"
+CLAZY_TIME_BUDGET=1ms analyze
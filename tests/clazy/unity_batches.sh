@@ -0,0 +1,35 @@
+# Analyzes two source files with the same flags, which include the same header, with and without -unity-batch-size.
+# Batched, the header is only parsed once, so its warning is only emitted once, and the source files' warnings are
+# still reported in them.
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+printf '#pragma once\nconst char *g_shared = "shared";\n' > "$DIR/unity_batches.h"
+for i in 1 2; do
+    printf '#include "unity_batches.h"\nconst char *g_name%s = "name";\n' $i > "$DIR/unity_batches$i.cpp"
+done
+
+cat > "$DIR/compile_commands.json" <<JSON
+[
+    { "directory": "$DIR", "file": "$DIR/unity_batches1.cpp", "command": "c++ -std=c++14 -c unity_batches1.cpp" },
+    { "directory": "$DIR", "file": "$DIR/unity_batches2.cpp", "command": "c++ -std=c++14 -c unity_batches2.cpp" }
+]
+JSON
+
+analyze() {
+    ${CLAZYSTANDALONE_CXX} -p "$DIR" -checks=global-const-char-pointer "$@" "$DIR/unity_batches1.cpp" "$DIR/unity_batches2.cpp" \
+        > "$DIR/output.txt" 2>&1
+    echo "Exit status: $?"
+    grep -E "warning:|error:" "$DIR/output.txt" | sed "s|$DIR/||"
+}
+
+echo "Without batches:"
+analyze
+
+echo "One batch:"
+analyze -unity-batch-size=2
@@ -0,0 +1,16 @@
+#ifndef WASTE_REPORT_H
+#define WASTE_REPORT_H
+
+struct NonTrivial
+{
+    NonTrivial();
+    NonTrivial(const NonTrivial &);
+    ~NonTrivial();
+    int value;
+};
+
+namespace ns {
+inline int byValue(NonTrivial n) { return n.value; } // Counted once, though both translation units include it
+}
+
+#endif
@@ -0,0 +1,14 @@
+# Writes the -waste-report of two translation units including the same header, listing the 2 most wasteful
+# files and functions. An allocation counts as 256 bytes copied.
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+${CLAZYSTANDALONE_CXX} clazy/waste_report1.cpp clazy/waste_report2.cpp -checks=function-args-by-ref,global-const-char-pointer \
+    -waste-report="$DIR/waste.json" -waste-report-top=2 -- -std=c++14 2> /dev/null
+
+cat "$DIR/waste.json"
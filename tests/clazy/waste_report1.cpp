@@ -0,0 +1,8 @@
+#include "waste_report.h"
+
+struct Big
+{
+    char data[64];
+};
+
+int bigByValue(Big b) { return b.data[0]; }
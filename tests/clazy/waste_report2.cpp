@@ -0,0 +1,3 @@
+#include "waste_report.h"
+
+const char *g_name = "name"; // Not in a function
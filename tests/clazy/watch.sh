@@ -0,0 +1,33 @@
+# Starts clazy-standalone -watch, then modifies a header only the first file includes, then the second file.
+# Only the files depending on the modified one are analyzed again.
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+DIR=$(mktemp -d)
+
+printf 'const char *g_header = "header";\n' > "$DIR/watch.h"
+printf '#include "watch.h"\nvoid foo();\nvoid test() { return foo(); }\n' > "$DIR/watch1.cpp"
+printf 'const char *g_name = "name";\n' > "$DIR/watch2.cpp"
+
+${CLAZYSTANDALONE_CXX} -watch -checks=global-const-char-pointer,returning-void-expression "$DIR/watch1.cpp" "$DIR/watch2.cpp" \
+    -- -std=c++14 2> "$DIR/log" &
+WATCH_PID=$!
+trap 'kill $WATCH_PID; rm -rf "$DIR"' EXIT
+
+# Waits up to 30 seconds for a line of the output
+wait_for() {
+    for i in $(seq 300); do
+        grep -q "$1" "$DIR/log" && return
+        sleep 0.1
+    done
+}
+
+wait_for "Watching"
+printf '\nconst char *g_header = "header";\n' > "$DIR/watch.h"
+wait_for "watch.h:2:1"
+printf '\nconst char *g_name = "name";\n' > "$DIR/watch2.cpp"
+wait_for "watch2.cpp:2:1"
+
+grep -E "warning:|^clazy-standalone:" "$DIR/log" | sed "s|$DIR/||"
@@ -0,0 +1,86 @@
+# Starts clazy-standalone -worker and sends it requests over TCP: with a wrong secret, with flags it doesn't accept, without
+# the contents of a file, with them, and again without, as it kept them. The project's directory only exists in the requests.
+# Then a connection staying silent is closed after -worker-read-timeout, instead of blocking the next one.
+
+if [ -z "${CLAZYSTANDALONE_CXX}" ]; then
+    CLAZYSTANDALONE_CXX=clazy-standalone
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+echo "No secret:"
+${CLAZYSTANDALONE_CXX} -worker=127.0.0.1:0 -- 2>&1
+
+echo "Not a loopback address:"
+echo "secret" > "$DIR/secret"
+${CLAZYSTANDALONE_CXX} -worker=0.0.0.0:0 -worker-secret-file="$DIR/secret" -- 2>&1
+
+PORT=$(python3 -c 'import socket; s = socket.socket(); s.bind(("127.0.0.1", 0)); print(s.getsockname()[1])')
+${CLAZYSTANDALONE_CXX} -worker=127.0.0.1:$PORT -worker-secret-file="$DIR/secret" -worker-read-timeout=1 -checks=global-const-char-pointer -- 2> /dev/null &
+WORKER_PID=$!
+trap 'kill $WORKER_PID; rm -rf "$DIR"' EXIT
+
+python3 - $PORT <<'PYTHON'
+import hashlib, socket, sys, time
+
+source = b'const char *g_name = "name";\nvoid foo();\nvoid test() { return foo(); }\n'
+md5 = hashlib.md5(source).hexdigest()
+
+def connect():
+    for i in range(100):
+        try:
+            return socket.create_connection(('127.0.0.1', int(sys.argv[1])))
+        except OSError:
+            time.sleep(0.1)
+
+def reply(client):
+    data = b''
+    while not data.endswith(b'\n') or b'exit: ' not in data.splitlines()[-1]:
+        chunk = client.recv(4096)
+        if not chunk:
+            break
+        data += chunk
+    sys.stdout.write(data.decode().replace(md5, '<md5>'))
+
+request = 'directory=/virtual/project\narg=-std=c++14\nmain=worker.cpp\nfile=%s worker.cpp\n' % md5
+
+print('Wrong secret:')
+client = connect()
+client.sendall(b'secret=guess\n')
+reply(client)
+client.close()
+
+client = connect()
+client.sendall(b'secret=secret\n')
+
+print('Flags not accepted:')
+client.sendall(b'arg=-Xclang\narg=-load\narg=-Xclang\narg=plugin.so\nmain=worker.cpp\n\n')
+reply(client)
+
+print('Flag values:')
+client.sendall(b'arg=-I\narg=include\narg=-include\narg=evil.h\narg=-D\narg=FOO\nmain=worker.cpp\n\n')
+reply(client)
+
+print('Missing contents:')
+client.sendall(request.encode() + b'\n')
+reply(client)
+
+print('With the contents:')
+client.sendall(b'blob=%s %d\n' % (md5.encode(), len(source)) + source + b'checks=global-const-char-pointer,returning-void-expression\n' + request.encode() + b'\n')
+reply(client)
+
+print('Contents kept:')
+client.sendall(request.encode() + b'\n')
+reply(client)
+client.close()
+
+print('Silent connection:')
+silent = connect()
+client = connect()
+client.sendall(b'secret=secret\n' + request.encode() + b'\n')
+reply(client)
+client.close()
+reply(silent) # Timed out waiting for its secret
+silent.close()
+PYTHON
@@ -0,0 +1,39 @@
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+#include <array>
+#include <map>
+#include <string>
+#include <vector>
+
+enum Color { Red, Green };
+
+static const QStringList s_names = { QStringLiteral("red"), QStringLiteral("green") }; // Warning
+static const QHash<QString, int> s_levels = { { QStringLiteral("debug"), 0 }, { QStringLiteral("info"), 1 } }; // Warning
+static const std::string s_stdNames[] = { "red", "green" }; // Warning
+static const std::vector<std::string> s_stdVector = { "red", "green" }; // Warning
+static const std::map<std::string, Color> s_colors = { { "red", Red }, { "green", Green } }; // Warning
+static const QVector<int> s_sizes = { 1, 2, -3 }; // Warning
+static const std::array<int, 3> s_array = { { 1, 2, 3 } }; // OK, constant initialized
+static const int s_ints[] = { 1, 2, 3 }; // OK
+static QStringList s_mutable = { QStringLiteral("a") }; // OK, not const
+static const QStringList s_empty; // OK, no table
+static constexpr const char *s_literals[] = { "a", "b" }; // OK
+
+QString dynamicString();
+static const QStringList s_dynamic = { dynamicString() }; // OK, not only literals
+
+struct Holder
+{
+    static const QStringList s_member;
+};
+
+const QStringList Holder::s_member = { QStringLiteral("member") }; // Warning
+
+QString lookup(int i)
+{
+    static const QStringList names = { QStringLiteral("a"), QStringLiteral("b") }; // Warning
+    const QStringList local = { QStringLiteral("a") }; // OK, not static
+    return names.value(i) + local.value(i);
+}
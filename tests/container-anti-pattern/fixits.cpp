@@ -0,0 +1,63 @@
+#include <QtCore/QHash>
+#include <QtCore/QMap>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+void consume(int);
+void consume(const QString &);
+
+void testValues()
+{
+    QHash<QString, int> hash;
+    for (int v : hash.values()) // Warning, fixit
+        consume(v);
+
+    QMap<int, QString> map;
+    for (const QString &v : map.values()) { // Warning, fixit
+        consume(v);
+    }
+
+    const QMultiHash<int, int> multi;
+    for (auto v : multi.values()) // Warning, fixit
+        consume(v);
+
+    QVector<int> vec;
+    for (auto v : vec.toList()) // Warning, fixit
+        consume(v);
+}
+
+void testKeys()
+{
+    QHash<QString, int> hash;
+    for (const QString &k : hash.keys()) { // Warning, fixit
+        consume(k);
+        consume(hash.value(k));
+    }
+
+    QMultiMap<int, int> map;
+    for (auto k : map.keys()) { // Warning, fixit
+        consume(k);
+    }
+}
+
+void testNoFixit(QHash<int, int> &other)
+{
+    QHash<int, int> hash;
+    for (auto v : hash.values()) // Warning, modified inside the loop
+        hash.insert(v, v);
+
+    QMap<int, int> map;
+    for (int &v : map.values()) // Warning, non-const reference
+        v++;
+
+    for (auto k : other.keys()) // Warning, a reference
+        consume(k);
+
+    int kIt = 0;
+    for (auto k : hash.keys()) // Warning, no braces
+        consume(k + kIt);
+
+    for (auto k : hash.keys()) { // Warning, kIt already exists
+        consume(k + kIt);
+    }
+}
@@ -0,0 +1,42 @@
+#include <QtCore/QVector>
+#include <vector>
+#include <unordered_map>
+
+void hoisted(int n)
+{
+    for (int i = 0; i < n; ++i) {
+        QVector<int> v; // Warning, hoisted
+        v.append(i);
+    }
+
+    while (n--) {
+        std::vector<int> values; // Warning, hoisted
+        values.push_back(n);
+    }
+
+    do {
+        std::unordered_map<int, int> map; // Warning, hoisted
+        map[n] = n;
+    } while (n++ < 10);
+}
+
+void not_hoisted(int n)
+{
+    for (int i = 0; i < n; ++i) {
+        QVector<int> v; // Warning, no fixit, another v exists
+        v.append(i);
+    }
+    QVector<int> v;
+
+    for (int i = 0; i < n; ++i) {
+        std::vector<int> values; // Warning, no fixit, the address escapes
+        std::vector<int> *p = &values;
+        p->push_back(i);
+    }
+
+    for (int i = 0; i < n; ++i) {
+        std::vector<int> values; // Warning, no fixit, captured
+        auto lambda = [&values] { values.push_back(1); };
+        lambda();
+    }
+}
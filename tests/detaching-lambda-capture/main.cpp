@@ -0,0 +1,100 @@
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+int modifies()
+{
+    QList<int> list;
+    auto lambda = [list]() mutable { list.append(1); return list.size(); }; // Warn
+    return lambda();
+}
+
+int modifiesButUsedAfterwards()
+{
+    QList<int> list;
+    auto lambda = [list]() mutable { list.append(1); return list.size(); }; // OK, the copy is needed
+    return lambda() + list.size();
+}
+
+int detachingRead()
+{
+    QVector<int> vec = { 1, 2 };
+    auto lambda = [vec]() mutable { return vec.first() + vec.size(); }; // Warn
+    int result = lambda();
+    return result + vec.size();
+}
+
+int writesThroughSubscript()
+{
+    QVector<int> vec = { 1, 2 };
+    auto lambda = [vec]() mutable { vec[0] = 3; return vec.size(); }; // Warn
+    return lambda();
+}
+
+int readsThroughAsConst()
+{
+    QVector<int> vec = { 1, 2 };
+    auto lambda = [vec]() mutable { return qAsConst(vec).first(); }; // OK
+    return lambda();
+}
+
+int notMutable()
+{
+    QVector<int> vec = { 1, 2 };
+    auto lambda = [vec] { return vec.first(); }; // OK
+    return lambda();
+}
+
+int rangeLoop()
+{
+    QVector<int> vec = { 1, 2 };
+    auto lambda = [=]() mutable { int sum = 0; for (int v : vec) sum += v; return sum; }; // Warn
+    return lambda();
+}
+
+int strings()
+{
+    QString str;
+    auto lambda = [str]() mutable { str += QLatin1String("foo"); return str.size(); }; // Warn
+    return lambda();
+}
+
+int stringList()
+{
+    QStringList list;
+    auto lambda = [list]() mutable { list.append(QString()); return list.size(); }; // Warn
+    return lambda();
+}
+
+int byReference()
+{
+    QList<int> list;
+    auto lambda = [&list]() mutable { list.append(1); return list.size(); }; // OK
+    return lambda();
+}
+
+int constList()
+{
+    const QList<int> list;
+    auto lambda = [list]() mutable { return list.first(); }; // OK
+    return lambda();
+}
+
+int insideLoop()
+{
+    QList<int> list;
+    int total = 0;
+    for (int i = 0; i < 2; ++i) {
+        auto lambda = [list]() mutable { list.append(1); return list.size(); }; // OK, moving it would empty it
+        total += lambda();
+    }
+    return total;
+}
+
+int assigns()
+{
+    QList<int> list;
+    auto lambda = [list]() mutable { list = QList<int>(); return list.size(); }; // OK
+    return lambda();
+}
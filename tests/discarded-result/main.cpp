@@ -0,0 +1,27 @@
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QList>
+#include <QtCore/QVector>
+#include <QtCore/QMap>
+#include <QtCore/QHash>
+
+void test(QList<int> &list, const QMap<int, QString> &map, const QHash<QString, int> &hash, QStringList &strings)
+{
+    list.mid(1); // Warning
+    map.keys(); // Warning
+    list.toVector(); // Warning
+    if (!hash.isEmpty())
+        hash.values(); // Warning
+    strings.join(QLatin1Char(',')); // Warning
+
+    for (int i = 0; i < 3; ++i)
+        list.mid(i); // Warning
+
+    QList<int> tail = list.mid(1); // OK
+    (void)list.mid(1); // OK
+    list.append(1); // OK
+    const QVector<int> vec = list.toVector(); // OK
+    if (map.keys().isEmpty()) // OK
+        return;
+    list = list.mid(1); // OK
+}
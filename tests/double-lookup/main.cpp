@@ -0,0 +1,114 @@
+#include <QtCore/QHash>
+#include <QtCore/QMap>
+#include <QtCore/QString>
+#include <map>
+#include <unordered_map>
+#include <utility>
+
+int test_qt(QHash<QString, int> &hash, QMap<int, int> &map, const QString &key, int k)
+{
+    if (hash.contains(key))
+        return hash.value(key); // Warning
+
+    if (map.contains(k))
+        map[k] += 1; // Warning
+
+    if (hash.contains(QStringLiteral("foo")))
+        return 1; // OK
+
+    if (hash.contains(key))
+        return hash.value(QString()); // OK, another key
+
+    QHash<QString, int> other;
+    if (hash.contains(key))
+        return other.value(key); // OK, another container
+
+    if (map.contains(k)) {
+        map.insert(k + 1, 0);
+        return map.value(k); // OK, the container changed in between
+    }
+
+    if (map.contains(k)) {
+        k++;
+        return map.value(k); // OK, the key changed
+    }
+
+    auto it = map.find(k);
+    if (it != map.end())
+        return map[k]; // Warning
+
+    return 0;
+}
+
+int test_std(std::map<int, int> &m, std::unordered_map<int, int> &um, int k)
+{
+    if (m.count(k))
+        return m.at(k); // Warning
+
+    if (um.find(k) != um.end())
+        um[k] = 1; // Warning
+
+    if (um.count(k))
+        return 0; // OK
+
+    return 0;
+}
+
+void fill(QMap<int, int> &map);
+void appendTo(QString &s);
+
+int test_modified_by_calls(QHash<QString, int> &hash, QMap<int, int> &map, QString key, int k)
+{
+    QMap<int, int> other;
+    if (hash.contains(key)) {
+        key.append(QLatin1Char('x'));
+        return hash.value(key); // OK, the key changed
+    }
+
+    if (map.contains(k)) {
+        std::swap(map, other);
+        return map.value(k); // OK, the container changed
+    }
+
+    if (map.contains(k)) {
+        fill(map);
+        return map.value(k); // OK, the container can have changed
+    }
+
+    if (hash.contains(key)) {
+        appendTo(key);
+        return hash.value(key); // OK, the key can have changed
+    }
+
+    if (hash.contains(key)) {
+        const int n = key.size();
+        return hash.value(key) + n; // Warning, size() is const
+    }
+
+    return 0;
+}
+
+class Cache
+{
+public:
+    int lookup(const QString &key)
+    {
+        if (m_cache.contains(key)) {
+            rebuild();
+            return m_cache.value(key); // OK, rebuild() can change m_cache
+        }
+
+        if (m_cache.contains(key)) {
+            count();
+            return m_cache.value(key); // Warning, count() is const
+        }
+
+        return 0;
+    }
+
+    void rebuild();
+    int count() const;
+
+private:
+    QHash<QString, int> m_cache;
+};
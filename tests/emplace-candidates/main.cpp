@@ -0,0 +1,50 @@
+#include <QtCore/QString>
+#include <QtCore/QVector>
+#include <vector>
+#include <list>
+#include <map>
+#include <unordered_map>
+#include <utility>
+
+struct Point { int x; int y; };
+
+void testSequence(const QString &str)
+{
+    std::vector<QString> v;
+    v.push_back(QString(3, QLatin1Char('a'))); // Warning
+    v.push_back(QString()); // Warning
+    v.push_back(QString{str}); // Warning
+    v.push_back(QString(QLatin1String("foo"))); // Warning
+    v.push_back(str); // OK
+    v.push_back({}); // OK
+    v.emplace_back(3, QLatin1Char('a')); // OK
+
+    std::list<QString> l;
+    l.push_front(QString(2, QLatin1Char('b'))); // Warning
+
+    QVector<QString> qv;
+    qv.append(QString(3, QLatin1Char('a'))); // Warning
+    qv.push_back(QString(3, QLatin1Char('a'))); // Warning
+    qv.append(str); // OK
+
+    std::vector<Point> points;
+    points.push_back(Point{1, 2}); // OK, trivially copyable aggregate
+
+    std::vector<std::vector<int>> vectors;
+    vectors.push_back(std::vector<int>{1, 2}); // OK, initializer_list constructor
+}
+
+void testMaps(const QString &str)
+{
+    std::map<int, QString> m;
+    m.insert(std::make_pair(1, str)); // Warning
+    m.insert(std::pair<int, QString>(1, str)); // Warning
+    m.insert({1, str}); // OK
+    m.emplace(1, str); // OK
+
+    std::unordered_map<int, int> trivial;
+    trivial.insert(std::make_pair(1, 2)); // OK, trivially copyable
+
+    std::multimap<QString, int> multi;
+    multi.insert(std::make_pair(str, 1)); // Warning
+}
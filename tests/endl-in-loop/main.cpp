@@ -0,0 +1,35 @@
+#include <QtCore/QFile>
+#include <QtCore/QStringList>
+#include <QtCore/QTextStream>
+#include <iostream>
+#include <vector>
+
+void exportStd(const std::vector<int> &values)
+{
+    for (int value : values)
+        std::cout << value << std::endl; // Warning
+    std::cout << "done" << std::endl; // OK, not in a loop
+
+    for (int value : values) {
+        std::cout << value << '\n';
+        std::cout.flush(); // Warning
+    }
+
+    for (int value : values)
+        std::cout << value << std::flush; // Warning
+}
+
+void exportQt(const QStringList &lines, QFile *file)
+{
+    QTextStream out(file);
+    for (const QString &line : lines) {
+        out << line;
+        out.flush(); // Warning
+    }
+
+    for (const QString &line : lines) {
+        out << line << '\n'; // OK
+        file->flush(); // Warning
+    }
+    out.flush(); // OK
+}
@@ -0,0 +1,104 @@
+#include <QtCore/QList>
+#include <QtCore/QQueue>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+#include <vector>
+
+struct Item
+{
+    bool isDone() const { return false; }
+};
+
+void eraseInIteratorLoop(std::vector<Item> &v)
+{
+    for (auto it = v.begin(); it != v.end();) {
+        if (it->isDone())
+            it = v.erase(it); // Warning
+        else
+            ++it;
+    }
+}
+
+void removeInIndexLoop(QVector<int> &v, QList<QString> &list)
+{
+    for (int i = 0; i < v.size();) {
+        if (v.at(i) == 0)
+            v.remove(i); // Warning
+        else
+            ++i;
+    }
+
+    for (int i = 0; i < list.size(); ++i) {
+        if (list.at(i).isEmpty())
+            list.removeAt(i); // Warning
+    }
+
+    for (int i = list.count() - 1; i >= 0; --i) {
+        if (list.at(i).isEmpty())
+            list.takeAt(i); // Warning
+    }
+
+    Q_FOREACH (const QString &s, list) {
+        if (s.isEmpty())
+            list.removeOne(s); // Warning
+    }
+}
+
+void removeOnce(QVector<int> &v, int value)
+{
+    for (int i = 0; i < v.size(); ++i) {
+        if (v.at(i) == value) {
+            v.removeAt(i); // OK, only once
+            break;
+        }
+    }
+
+    for (auto it = v.begin(); it != v.end(); ++it) {
+        if (*it == value) {
+            v.erase(it); // OK
+            return;
+        }
+    }
+}
+
+void removeFromOther(QVector<int> &v, const QVector<int> &indexes)
+{
+    for (int index : indexes)
+        v.removeAt(index); // OK, not iterating v
+
+    for (int i = 0; i < v.size(); ++i)
+        v.remove(i, 2); // OK, removes a range
+
+    v.removeAt(0); // OK, not in a loop
+}
+
+void queues(QVector<int> &v, QList<int> &list, std::vector<int> &stdv, QQueue<int> &queue, const QVector<int> &input)
+{
+    while (!v.isEmpty())
+        v.takeFirst(); // Warning
+
+    while (!stdv.empty())
+        stdv.erase(stdv.begin()); // Warning
+
+    for (int i : input) {
+        v.prepend(i); // Warning
+        v.insert(0, i); // Warning
+        stdv.insert(stdv.begin(), i); // Warning
+        list.prepend(i); // OK, QList has free space at its front
+        queue.enqueue(i); // OK
+    }
+
+    while (!list.isEmpty())
+        list.removeAt(0); // OK
+
+    while (!queue.isEmpty())
+        queue.dequeue(); // OK
+}
+
+void lambdas(QVector<int> &v)
+{
+    for (int i = 0; i < v.size(); ++i) {
+        auto f = [&v] { v.removeFirst(); }; // OK, not run in the loop
+        f();
+    }
+}
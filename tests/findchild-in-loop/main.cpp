@@ -0,0 +1,43 @@
+#include <QtCore/QObject>
+#include <QtCore/QVariant>
+#include <QtCore/QList>
+#include <QtWidgets/QWidget>
+#include <QtWidgets/QLabel>
+
+void loops(QObject *root, const QList<QObject *> &objects)
+{
+    for (int i = 0; i < 10; ++i) {
+        root->findChild<QObject *>(QStringLiteral("foo")); // Warning
+    }
+
+    for (QObject *o : objects) {
+        o->findChildren<QObject *>(); // Warning
+        o->property("enabled"); // Warning
+        o->objectName(); // OK
+    }
+
+    root->findChild<QObject *>(QStringLiteral("foo")); // OK
+    root->property("enabled"); // OK
+}
+
+class MyWidget : public QWidget
+{
+public:
+    void paintEvent(QPaintEvent *) override
+    {
+        auto label = findChild<QLabel *>(); // Warning
+        property("text"); // Warning
+    }
+
+    void timerEvent(QTimerEvent *) override
+    {
+        findChildren<QLabel *>(); // Warning
+    }
+
+    void setup()
+    {
+        m_label = findChild<QLabel *>(); // OK
+    }
+
+    QLabel *m_label = nullptr;
+};
@@ -0,0 +1,82 @@
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <vector>
+
+QStringList names();
+std::vector<int> numbers();
+void use(const QString &);
+void modify(QStringList &);
+
+struct Holder
+{
+    void loopOverMember()
+    {
+        foreach (const QString &s, m_list) // Warn, no fixit
+            use(s);
+    }
+
+    QStringList m_list;
+};
+
+void local()
+{
+    QStringList list;
+    foreach (const QString &s, list) // Warn
+        use(s);
+}
+
+void constLocal()
+{
+    const QStringList list = names();
+    Q_FOREACH (const QString &s, list) { // Warn
+        use(s);
+    }
+}
+
+void modified()
+{
+    QStringList list;
+    foreach (const QString &s, list) // OK, the copy is needed
+        list.append(s);
+
+    foreach (const QString &s, list) { // OK
+        use(s);
+        modify(list);
+    }
+}
+
+void temporary()
+{
+    foreach (const QString &s, names()) // Warn
+        use(s);
+}
+
+void temporaryName(int container)
+{
+    foreach (const QString &s, names()) // Warn
+        use(s + QString::number(container));
+}
+
+void temporaryWithoutBlock(bool b)
+{
+    if (b)
+        foreach (const QString &s, names()) // Warn, no fixit
+            use(s);
+}
+
+int stlTemporary()
+{
+    int sum = 0;
+    foreach (int n, numbers()) // Warn
+        sum += n;
+    return sum;
+}
+
+void reusedVariable()
+{
+    QString s;
+    QStringList list;
+    foreach (s, list) // OK
+        use(s);
+}
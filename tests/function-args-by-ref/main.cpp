@@ -245,3 +245,9 @@ public:
     void virtualMethod2(NonTrivial) {}; // OK
     void nonVirtualMethod(NonTrivial) {}; // Warn
 };
+
+struct Setters
+{
+    void setMember(NonTrivial n) { m = std::move(n); } // Ok, a sink parameter
+    NonTrivial m;
+};
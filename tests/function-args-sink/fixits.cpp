@@ -0,0 +1,24 @@
+#include <QtCore/QString>
+#include <utility>
+
+class Item
+{
+public:
+    explicit Item(const QString &name);
+    void setName(const QString& name);
+    void setTitle(QString const &title) { m_title = title; } // Warning
+
+private:
+    QString m_name;
+    QString m_title;
+};
+
+Item::Item(const QString &name) // Warning
+    : m_name(name)
+{
+}
+
+void Item::setName(const QString& name) // Warning
+{
+    m_name = name;
+}
@@ -0,0 +1,69 @@
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <vector>
+
+struct Trivial
+{
+    int a;
+    int b;
+};
+
+class Model
+{
+public:
+    Model(const QString &name, const QStringList &tags) // Warning for name
+        : m_name(name)
+        , m_tags(tags)
+        , m_count(tags.size())
+    {
+    }
+
+    Model(const std::vector<int> &values, const Trivial &trivial) // Warning for values
+        : m_values(values)
+        , m_trivial(trivial)
+    {
+    }
+
+    void setName(const QString &name) // Warning
+    {
+        if (m_name == name)
+            return;
+        m_name = name;
+    }
+
+    void setTags(const QStringList &tags) // OK, used afterwards
+    {
+        m_tags = tags;
+        m_count = tags.size();
+    }
+
+    void setTitle(const QString &title) // OK, copied twice
+    {
+        m_name = title;
+        m_title = title;
+    }
+
+    void setTitleIf(const QString &title, bool cond) // OK, not a top-level statement
+    {
+        if (cond)
+            m_title = title;
+    }
+
+    void setLocal(const QString &title) // OK, not a member
+    {
+        QString local;
+        local = title;
+    }
+
+    virtual void setVirtual(const QString &title) // OK, virtual
+    {
+        m_title = title;
+    }
+
+    QString m_name;
+    QString m_title;
+    QStringList m_tags;
+    int m_count = 0;
+    std::vector<int> m_values;
+    Trivial m_trivial;
+};
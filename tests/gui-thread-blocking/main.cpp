@@ -0,0 +1,89 @@
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QProcess>
+#include <QtCore/QSettings>
+#include <QtCore/QThread>
+#include <QtWidgets/QWidget>
+
+static QByteArray readFile(const QString &fileName)
+{
+    QFile file(fileName);
+    file.open(QIODevice::ReadOnly);
+    return file.readAll();
+}
+
+static QByteArray loadConfig()
+{
+    return readFile(QStringLiteral("config.ini"));
+}
+
+static QByteArray deepLoad()
+{
+    return loadConfig();
+}
+
+class Widget : public QWidget
+{
+    Q_OBJECT
+public Q_SLOTS:
+    void load()
+    {
+        QFile file(QStringLiteral("data.txt"));
+        file.open(QIODevice::ReadOnly); // Warning
+        m_data = file.readAll(); // Warning
+        QSettings settings; // Warning
+    }
+
+    void run()
+    {
+        QProcess process;
+        process.start(QStringLiteral("ls"));
+        process.waitForFinished(); // Warning
+        for (int i = 0; i < 100; ++i)
+            QCoreApplication::processEvents(); // Warning
+        QThread::msleep(10); // Warning
+    }
+
+    void viaHelpers()
+    {
+        m_data = readFile(QStringLiteral("a")); // Warning
+        m_data = loadConfig(); // Warning
+        m_data = deepLoad(); // OK, too deep
+        other(); // OK, other() is warned about
+    }
+
+    void other()
+    {
+        QDir dir;
+        dir.entryList(); // Warning
+    }
+
+public:
+    void notASlot()
+    {
+        m_data = readFile(QStringLiteral("a")); // OK
+    }
+
+protected:
+    void showEvent(QShowEvent *) override
+    {
+        m_data = readFile(QStringLiteral("b")); // Warning
+    }
+
+private:
+    QByteArray m_data;
+};
+
+class NotAWidget : public QObject
+{
+    Q_OBJECT
+public Q_SLOTS:
+    void load()
+    {
+        m_data = readFile(QStringLiteral("c")); // OK
+    }
+
+private:
+    QByteArray m_data;
+};
@@ -0,0 +1,63 @@
+#include <QtCore/QScopedPointer>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QVector>
+#include <memory>
+#include <vector>
+
+struct SmallTrivial
+{
+    int v;
+};
+
+struct BigTrivial
+{
+    int v[10];
+};
+
+void consume(std::unique_ptr<SmallTrivial>);
+void consumeRaw(SmallTrivial *);
+
+void testSmartPointers()
+{
+    auto a = std::make_unique<SmallTrivial>(); // Warn
+    a->v = 1;
+    std::unique_ptr<SmallTrivial> b(new SmallTrivial()); // Warn
+    (*b).v = 1;
+    auto c = std::make_shared<SmallTrivial>(); // Warn
+    QScopedPointer<SmallTrivial> d(new SmallTrivial()); // Warn
+    d->v = 1;
+    auto e = QSharedPointer<SmallTrivial>::create(); // Warn
+    auto f = std::make_unique<BigTrivial>(); // OK, big
+    auto g = std::make_unique<SmallTrivial>(); // OK, moved
+    consume(std::move(g));
+    auto h = std::make_unique<SmallTrivial>(); // OK, escapes through get()
+    consumeRaw(h.get());
+    auto i = std::make_shared<SmallTrivial>(); // OK, copied
+    auto i2 = i;
+    std::unique_ptr<SmallTrivial> j; // OK, not allocated here
+}
+
+std::unique_ptr<SmallTrivial> returnsSmartPointer()
+{
+    auto a = std::make_unique<SmallTrivial>(); // OK, returned
+    return a;
+}
+
+struct Holder
+{
+    std::vector<std::unique_ptr<SmallTrivial>> m_unique; // Warn
+    QVector<QSharedPointer<SmallTrivial>> m_shared; // Warn
+    QVector<SmallTrivial*> m_raw; // OK, might not own them
+    std::vector<std::unique_ptr<BigTrivial>> m_big; // OK
+    QVector<SmallTrivial> m_values; // OK
+};
+
+void testContainers(SmallTrivial *existing)
+{
+    QVector<SmallTrivial*> owning; // Warn
+    owning.append(new SmallTrivial());
+    QVector<SmallTrivial*> nonOwning; // OK
+    nonOwning.append(existing);
+    std::vector<std::unique_ptr<SmallTrivial>> unique; // Warn
+    unique.push_back(std::make_unique<SmallTrivial>());
+}
@@ -0,0 +1,25 @@
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+struct StringHash
+{
+    using is_transparent = void;
+    size_t operator()(std::string_view str) const { return std::hash<std::string_view>()(str); }
+};
+
+bool test(std::string_view view)
+{
+    std::unordered_map<std::string, int> hash;
+    std::unordered_set<std::string> set;
+    std::map<std::string, int> map;
+    std::unordered_map<std::string, int, StringHash, std::equal_to<>> transparent;
+
+    return hash.find(std::string(view)) != hash.end() // Warning
+        || set.contains("foo") // Warning
+        || map.contains(std::string(view)) // Warning
+        || transparent.contains(view); // OK
+}
@@ -0,0 +1,39 @@
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+
+void useMap(const std::map<std::string, int> &);
+
+int test(const char *name)
+{
+    std::map<std::string, int> map;
+    auto it = map.find("foo"); // Warning, gets std::less<>
+    int n = map.count(name); // Warning
+    for (auto &entry : map)
+        n += entry.second;
+
+    const std::set<std::string> set = { "a", "b" };
+    n += set.count("a"); // Warning, gets std::less<>
+
+    std::multimap<std::string, int> multi;
+    n += multi.count("a"); // Warning, gets std::less<>
+    useMap(std::map<std::string, int>(multi.begin(), multi.end()));
+
+    std::map<std::string, int> passed;
+    if (passed.find("foo") != passed.end()) // Warning, no fixit, passed to a function
+        useMap(passed);
+
+    std::map<std::string, int, std::less<>> transparent;
+    n += transparent.count("foo"); // OK
+
+    const std::string key = "foo";
+    n += map.count(key); // OK
+    n += map.at("foo"); // OK, no heterogeneous at()
+    n += map["foo"]; // OK
+
+    std::map<int, int> intMap;
+    n += intMap.count(1); // OK
+
+    return n + (it != map.end());
+}
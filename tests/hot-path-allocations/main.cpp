@@ -0,0 +1,78 @@
+#include <QtWidgets/QWidget>
+#include <QtWidgets/QStyledItemDelegate>
+#include <QtGui/QIcon>
+#include <QtGui/QImage>
+#include <QtGui/QPainter>
+#include <QtGui/QPainterPath>
+#include <QtGui/QPixmap>
+#include <QtCore/QAbstractListModel>
+#include <QtCore/QFile>
+
+class MyWidget : public QWidget
+{
+public:
+    void paintEvent(QPaintEvent *) override
+    {
+        QPainter painter(this);
+        QFont font(QStringLiteral("Sans"), 12); // Warning
+        painter.setFont(font);
+        painter.setPen(QPen(Qt::red, 2)); // Warning, and for the implicit QBrush
+        QPainterPath path; // Warning
+        path.addEllipse(0, 0, 10, 10);
+        painter.drawPath(path);
+        QPixmap pixmap(QStringLiteral("icon.png")); // Warning
+        painter.drawPixmap(0, 0, pixmap);
+        painter.drawText(0, 0, QStringLiteral("%1 of %2").arg(1).arg(2)); // Warning
+        static const QFont cachedFont(QStringLiteral("Mono"), 10); // OK, static
+        painter.setFont(cachedFont);
+        painter.setFont(m_font); // OK, a copy
+        QFont defaultFont; // OK, default constructed
+        painter.setFont(defaultFont);
+    }
+
+    void resizeEvent(QResizeEvent *) override
+    {
+        QFile file(QStringLiteral("layout.txt"));
+        file.open(QIODevice::ReadOnly); // Warning
+    }
+
+    void mousePressEvent(QMouseEvent *) override
+    {
+        QFont font(QStringLiteral("Sans"), 12); // OK, not a hot method
+    }
+
+    QFont m_font;
+};
+
+class MyModel : public QAbstractListModel
+{
+public:
+    int rowCount(const QModelIndex &) const override { return 10; }
+
+    QVariant data(const QModelIndex &index, int role) const override
+    {
+        if (role == Qt::DecorationRole)
+            return QPixmap(QStringLiteral("row.png")); // Warning
+        return QString::number(index.row()); // OK, formatting text is data()'s job
+    }
+};
+
+class MyDelegate : public QStyledItemDelegate
+{
+public:
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &) const override
+    {
+        QIcon icon(QStringLiteral(":/icons/item.png")); // Warning
+        icon.paint(painter, option.rect);
+        painter->drawImage(option.rect, QImage(m_path)); // Warning
+    }
+
+protected:
+    void initStyleOption(QStyleOptionViewItem *option, const QModelIndex &index) const override
+    {
+        QStyledItemDelegate::initStyleOption(option, index);
+        option->icon = QIcon(m_path); // Warning
+    }
+
+    QString m_path;
+};
@@ -0,0 +1,79 @@
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <memory>
+#include <utility>
+#include <vector>
+
+struct Base
+{
+    virtual ~Base();
+};
+
+struct Derived : Base
+{
+};
+
+const QString constReturn(); // Warn
+const QString constReturn()
+{
+    return QString();
+}
+
+static const QStringList staticConstReturn() // Warn
+{
+    return {};
+}
+
+const int constInt(); // OK, trivially copyable
+QString nonConstReturn(); // OK
+
+struct Foo
+{
+    const QString name() const; // Warn
+    const QString &ref() const; // OK
+    QString m_name;
+};
+
+const QString Foo::name() const
+{
+    return m_name;
+}
+
+void take(QString);
+
+void moves(const QString &ref, const Foo &foo)
+{
+    const QString s;
+    take(std::move(s)); // Warn
+    take(std::move(ref)); // Warn
+    take(std::move(foo.m_name)); // Warn
+    QString s2;
+    take(std::move(s2)); // OK
+}
+
+QString returnsLocal()
+{
+    QString s = QStringLiteral("foo");
+    return std::move(s); // Warn
+}
+
+QString returnsParam(QString s)
+{
+    return std::move(s); // Warn
+}
+
+std::unique_ptr<Base> returnsDerived()
+{
+    std::unique_ptr<Derived> d(new Derived());
+    return std::move(d); // OK, different type
+}
+
+QString returnsMember(Foo &foo)
+{
+    return std::move(foo.m_name); // OK
+}
+
+QString returnsRvalueRef(QString &&s)
+{
+    return std::move(s); // OK
+}
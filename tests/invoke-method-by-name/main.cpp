@@ -0,0 +1,46 @@
+#include <QtCore/QObject>
+#include <QtCore/QMetaObject>
+#include <QtCore/QString>
+
+class MyObj : public QObject
+{
+    Q_OBJECT
+public:
+    void test();
+    Q_INVOKABLE void invokable();
+public Q_SLOTS:
+    void update();
+    virtual void refresh();
+    void setText(const QString &);
+    void overloaded();
+    void overloaded(int);
+private Q_SLOTS:
+    void privateSlot();
+};
+
+class Derived : public MyObj
+{
+    Q_OBJECT
+public Q_SLOTS:
+    void refresh() override;
+};
+
+void MyObj::test()
+{
+    QMetaObject::invokeMethod(this, "update"); // Warning
+    QMetaObject::invokeMethod(this, "privateSlot", Qt::QueuedConnection); // Warning
+    QMetaObject::invokeMethod(this, "setText", Q_ARG(QString, QString())); // Warning, no fixit
+    const char *name = "update";
+    QMetaObject::invokeMethod(this, name); // OK, not a literal
+    QMetaObject::invokeMethod(this, &MyObj::update); // OK
+}
+
+void test(MyObj *o, Derived *d, QObject *obj)
+{
+    QMetaObject::invokeMethod(o, "invokable", Qt::QueuedConnection); // Warning
+    QMetaObject::invokeMethod(d, "refresh"); // Warning
+    QMetaObject::invokeMethod(o, "overloaded"); // Warning, no fixit
+    QMetaObject::invokeMethod(o, "privateSlot"); // Warning, no fixit
+    QMetaObject::invokeMethod(obj, "deleteLater"); // Warning
+    QMetaObject::invokeMethod(o, [o] { o->update(); }); // OK
+}
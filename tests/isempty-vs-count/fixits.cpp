@@ -0,0 +1,34 @@
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <list>
+#include <string>
+#include <vector>
+
+struct Holder
+{
+    QList<int> *list;
+};
+
+void test(const QList<int> &list, const QString &str, const std::vector<int> &vec, const std::string &s,
+          const std::list<int> &stdList, const QHash<int, int> &hash, Holder holder)
+{
+    if (!list.count()) {} // Warn
+    if (list.size() == 0) {} // Warn
+    if (0 == list.size()) {} // Warn
+    if (list.count() > 0) {} // Warn
+    if (0 < str.length()) {} // Warn
+    if (str.size() != 0) {} // Warn
+    if (list.size() >= 1) {} // Warn
+    if (list.size() < 1) {} // Warn
+    if (list.size() == 1) {} // OK
+    if (list.count(1) > 0) {} // OK
+    if (list.count(1)) {} // OK
+    if (vec.size() == 0) {} // Warn
+    if (!s.length()) {} // Warn
+    if (stdList.size() > 0) {} // Warn
+    if (holder.list->size() == 0) {} // Warn
+    if (hash.keys().isEmpty()) {} // Warn
+    if (hash.values().isEmpty()) {} // Warn
+    if (vec.size()) {} // Warn
+}
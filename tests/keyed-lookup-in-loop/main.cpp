@@ -0,0 +1,66 @@
+#include <QtCore/QJsonObject>
+#include <QtCore/QList>
+#include <QtCore/QSettings>
+#include <QtCore/QString>
+#include <QtCore/QVariant>
+
+void use(const QVariant &) {}
+
+void settings(const QList<int> &items)
+{
+    QSettings settings;
+    const QString key = QStringLiteral("size");
+    for (int item : items) {
+        use(settings.value(QStringLiteral("iconSize"))); // Warning
+        use(settings.value(key, 10)); // Warning
+        use(settings.value(QStringLiteral("item%1").arg(item))); // OK, the key changes
+    }
+
+    for (int i = 0; i < items.size(); ++i) {
+        QSettings local; // Warning
+        use(local.value(QStringLiteral("a"))); // OK, built on each iteration anyway
+    }
+
+    const int size = settings.beginReadArray(QStringLiteral("items"));
+    for (int i = 0; i < size; ++i) {
+        settings.setArrayIndex(i);
+        use(settings.value(QStringLiteral("name"))); // OK, setArrayIndex() changes the result
+    }
+    settings.endArray();
+
+    QString changing;
+    for (int item : items) {
+        changing += QString::number(item);
+        use(settings.value(changing)); // OK, the key changes
+    }
+}
+
+void json(const QJsonObject &config, QJsonObject &writable, const QVariantMap &map, const QList<int> &items)
+{
+    for (int item : items) {
+        use(config.value(QLatin1String("theme")).toVariant()); // Warning
+        use(config[QLatin1String("theme")].toVariant()); // Warning
+        use(map.value(QStringLiteral("id"))); // Warning
+        use(map[QStringLiteral("id")]); // Warning
+        writable[QStringLiteral("count")] = item; // OK, not a lookup
+        use(map.value(QString::number(item))); // OK
+    }
+
+    use(config.value(QLatin1String("theme")).toVariant()); // OK, not in a loop
+
+    for (int item : items) {
+        auto f = [&config] { return config.value(QLatin1String("theme")); }; // OK, runs outside of the loop
+        f();
+        use(item);
+    }
+}
+
+struct Holder
+{
+    void run(const QList<int> &items)
+    {
+        for (int item : items)
+            use(m_config.value(QLatin1String("theme")).toVariant()); // OK, a member
+    }
+    QJsonObject m_config;
+};
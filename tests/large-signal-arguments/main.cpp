@@ -0,0 +1,46 @@
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+#include <QtGui/QImage>
+#include <string>
+#include <vector>
+
+struct Payload
+{
+    std::vector<int> values;
+    QString name;
+};
+
+struct Small
+{
+    int a;
+    int b;
+};
+
+class MyObj : public QObject
+{
+    Q_OBJECT
+public:
+    void notASignal(std::vector<int>); // OK
+signals:
+    void valuesChanged(std::vector<int> values); // Warning
+    void payloadChanged(Payload payload, int index); // Warning
+    void payloadRefChanged(const Payload &payload); // OK, by const-ref
+    void imageChanged(QImage image); // OK, implicitly shared
+    void vectorChanged(QVector<int> vector); // OK, implicitly shared
+    void smallChanged(Small small); // OK, small and trivial
+public slots:
+    void onPayload(const Payload &);
+    void onImage(const QImage &);
+};
+
+void test(MyObj *o)
+{
+    QObject::connect(o, &MyObj::payloadRefChanged, o, &MyObj::onPayload); // OK
+    QObject::connect(o, &MyObj::payloadRefChanged, o, &MyObj::onPayload, Qt::DirectConnection); // OK
+    QObject::connect(o, &MyObj::payloadRefChanged, o, &MyObj::onPayload, Qt::QueuedConnection); // Warning
+    QObject::connect(o, &MyObj::payloadRefChanged, o, [](const Payload &) {}, Qt::BlockingQueuedConnection); // Warning
+    QObject::connect(o, &MyObj::payloadRefChanged, o, &MyObj::onPayload,
+                     Qt::ConnectionType(Qt::QueuedConnection | Qt::UniqueConnection)); // Warning
+    QObject::connect(o, &MyObj::imageChanged, o, &MyObj::onImage, Qt::QueuedConnection); // OK
+}
@@ -0,0 +1,99 @@
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+#include <QtCore/QRegularExpression>
+#include <algorithm>
+#include <vector>
+
+void process(const QString &) {}
+
+void search(const QStringList &names, const QStringList &excluded, const QVector<int> &ids, const std::vector<int> &values)
+{
+    for (const QString &name : names) {
+        if (excluded.contains(name)) // Warning
+            continue;
+        process(name);
+    }
+
+    for (int i = 0; i < names.size(); ++i) {
+        if (ids.indexOf(i) != -1) // Warning
+            process(names.at(i));
+        if (excluded.lastIndexOf(names.at(i)) == 0) // Warning
+            process(names.at(i));
+    }
+
+    for (int value : values) {
+        if (std::find(values.cbegin(), values.cend(), value + 1) != values.cend()) // Warning
+            process(QString());
+        if (std::find(values.begin(), values.end(), value + 2) != values.end()) // Warning
+            process(QString());
+    }
+
+    if (excluded.contains(QStringLiteral("foo"))) // OK, not in a loop
+        process(QString());
+
+    for (const QString &name : names) {
+        if (excluded.contains(name, Qt::CaseInsensitive)) // OK, can't be a QSet
+            process(name);
+        if (excluded.indexOf(QRegularExpression(name)) != -1) // OK
+            process(name);
+        if (ids.indexOf(1, 2) != -1) // OK, has a start index
+            process(name);
+    }
+}
+
+void modified(const QStringList &names, std::vector<int> values)
+{
+    QStringList seen;
+    for (const QString &name : names) {
+        if (seen.contains(name)) // OK, appended to in the loop
+            continue;
+        seen.append(name);
+    }
+
+    for (int i = 0; i < 10; ++i) {
+        if (std::find(values.begin(), values.end(), i) != values.end()) // OK, non-const begin()
+            process(QString());
+    }
+
+    for (const QString &name : names) {
+        QStringList parts = name.split(QLatin1Char(','));
+        if (parts.contains(name)) // OK, declared in the loop
+            process(name);
+    }
+}
+
+struct Holder
+{
+    void run(const QStringList &names)
+    {
+        for (const QString &name : names) {
+            if (m_names.contains(name)) // OK, member
+                process(name);
+        }
+    }
+    QStringList m_names;
+};
+
+void lambdas(const QStringList &names, const QStringList &excluded)
+{
+    for (const QString &name : names) {
+        auto f = [&] { return excluded.contains(name); }; // OK, not run in the loop
+        f();
+    }
+}
+
+void runsOnce(const QStringList &names, const QStringList &excluded, const QVector<int> &ids)
+{
+    for (int i = names.indexOf(QStringLiteral("start")); i < names.size(); ++i) // OK, the init statement runs once
+        process(names.at(i));
+
+    for (int id : ids.mid(ids.indexOf(0))) // OK, the range is evaluated once
+        process(QString::number(id));
+
+    for (const QString &name : names) {
+        for (int i = excluded.indexOf(name); i < excluded.size(); ++i) // Warning, in the outer loop
+            process(excluded.at(i));
+    }
+}
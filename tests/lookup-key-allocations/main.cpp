@@ -0,0 +1,37 @@
+#include <QtCore/QHash>
+#include <QtCore/QMap>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+#include <QtCore/QByteArray>
+
+void test(const QByteArray &bytes, const QString &name)
+{
+    QHash<QString, int> hash;
+    QMap<QString, int> map;
+    QSet<QString> set;
+    static const QString staticKey = QStringLiteral("key");
+
+    hash.value("key"); // Warning
+    hash.value(QString("key")); // Warning
+    hash.contains(QLatin1String("key")); // Warning
+    hash.value(QString::fromLatin1("key")); // Warning
+    map[QString("x")] = 1; // Warning
+    map.value(bytes); // Warning
+    map.value(QString::fromUtf8(bytes)); // Warning
+    set.contains("x"); // Warning
+
+    hash.value(QStringLiteral("key")); // OK
+    hash.value(staticKey); // OK
+    hash.value(name); // OK
+    hash.value(QString(name)); // OK
+    hash.value(QString::number(1)); // OK
+    map[name] = 1; // OK
+
+    QHash<int, QString> byInt;
+    byInt.key("value"); // OK, not a lookup by key
+
+    for (int i = 0; i < 10; ++i) {
+        hash.value("key"); // Warning
+        map.find(QString::fromLatin1("x")); // Warning
+    }
+}
@@ -0,0 +1,74 @@
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+struct Model
+{
+    QList<int> items() const { return m_items; }
+    const QList<int> &itemsRef() const { return m_items; }
+    QList<int> takeItems() { return m_items; }
+    Model child() const { return *this; }
+    QList<int> m_items;
+};
+
+QString g_prefix;
+
+void use(const QString &) {}
+void use(int) {}
+
+void conditions(Model *model, const QString &str, int n)
+{
+    for (int i = 0; i < model->items().size(); ++i) // Warning
+        use(i);
+
+    for (int i = 0; i < model->itemsRef().size(); ++i) // OK, returns a reference
+        use(i);
+
+    for (int i = 0; i < model->takeItems().size(); ++i) // OK, not const
+        use(i);
+
+    while (str.toUtf8().size() > n) // Warning
+        --n;
+
+    for (int i = 0; i < model->child().items().size(); ++i) // Warning
+        use(i);
+}
+
+void bodies(const QStringList &list, const QString &prefix, Model *model)
+{
+    for (const QString &s : list) {
+        use(prefix.toUpper()); // Warning
+        use(QString::number(42)); // Warning
+        use(s.toUpper()); // OK, changes on each iteration
+        use(g_prefix.toUpper()); // OK, a global can change
+        auto f = [&prefix] { return prefix.toUpper(); }; // OK, runs outside of the loop
+        use(f());
+    }
+
+    QString name;
+    for (const QString &s : list) {
+        name += s;
+        use(name.toUpper()); // OK, modified in the loop
+    }
+
+    for (const QString &s : prefix.split(QLatin1Char(','))) // OK, runs once
+        use(s);
+
+    for (QList<int> items = model->items(); !items.isEmpty(); items.removeFirst()) // OK, runs once
+        use(items.first());
+
+    while (!list.isEmpty()) {
+        model = nullptr;
+        use(model->items().size()); // OK, model changes
+    }
+}
+
+struct Holder
+{
+    void run(const QStringList &list)
+    {
+        for (const QString &s : list)
+            use(s + m_prefix.toUpper()); // OK, a member
+    }
+    QString m_prefix;
+};
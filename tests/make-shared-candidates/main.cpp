@@ -0,0 +1,75 @@
+#include <QtCore/QSharedPointer>
+#include <QtCore/QString>
+#include <memory>
+
+struct Foo
+{
+    Foo() {}
+    Foo(int, const QString & = QString()) {}
+};
+
+struct Base
+{
+    virtual ~Base() {}
+};
+
+struct Derived : Base
+{
+};
+
+struct Point
+{
+    int x;
+    int y;
+};
+
+class Singleton
+{
+public:
+    static std::shared_ptr<Singleton> instance()
+    {
+        return std::shared_ptr<Singleton>(new Singleton()); // OK, private constructor
+    }
+private:
+    Singleton() {}
+};
+
+struct Pooled
+{
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr);
+};
+
+void deleteFoo(Foo *foo);
+
+class Holder
+{
+public:
+    Holder()
+        : m_foo(new Foo()) // Warning
+    {
+    }
+
+    std::shared_ptr<Foo> m_foo;
+};
+
+void test()
+{
+    std::shared_ptr<Foo> foo1(new Foo(1)); // Warning
+    auto foo2 = std::shared_ptr<Foo>(new Foo(1, QString())); // Warning
+    QSharedPointer<Foo> foo3(new Foo); // Warning
+    auto foo4 = QSharedPointer<Foo>(new Foo()); // Warning
+    std::shared_ptr<int> number(new int(5)); // Warning
+    std::shared_ptr<Base> base(new Derived()); // Warning, no fixit
+    std::shared_ptr<Point> point(new Point{1, 2}); // Warning, no fixit
+    std::shared_ptr<Foo> foo5(new Foo{1}); // Warning, no fixit
+
+    std::shared_ptr<Foo> foo6(new Foo(), deleteFoo); // OK, custom deleter
+    QSharedPointer<Foo> foo7(new Foo(), deleteFoo); // OK, custom deleter
+    std::shared_ptr<Pooled> pooled(new Pooled()); // OK, class specific operator new
+    std::unique_ptr<Foo> unique(new Foo()); // OK, not shared
+    auto foo8 = std::make_shared<Foo>(1); // OK
+    auto foo9 = QSharedPointer<Foo>::create(1); // OK
+    Foo *raw = new Foo();
+    std::shared_ptr<Foo> foo10(raw); // OK, not a new expression
+}
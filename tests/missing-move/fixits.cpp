@@ -0,0 +1,27 @@
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <utility>
+
+void takeString(QString);
+
+struct Item
+{
+    explicit Item(QString name)
+        : m_name(name) // Warning
+    {
+    }
+
+    void setTags(QStringList tags)
+    {
+        m_tags = tags; // Warning
+    }
+
+    QString m_name;
+    QStringList m_tags;
+};
+
+void test()
+{
+    QString s = QStringLiteral("foo");
+    takeString(s); // Warning
+}
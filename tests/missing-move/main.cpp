@@ -0,0 +1,114 @@
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+#include <QtCore/QSharedPointer>
+#include <string>
+#include <utility>
+#include <vector>
+
+void takeString(QString);
+void takeVector(std::vector<int>);
+void takeRef(const QString &);
+void takePointer(QSharedPointer<int>);
+
+struct Widget
+{
+    Widget(QString name, QStringList tags, QString title)
+        : m_name(name) // Warning
+        , m_tags(tags) // OK, used in the body
+        , m_title(title) // OK, used twice
+        , m_caption(title)
+    {
+        tags.clear();
+    }
+
+    void setName(QString name)
+    {
+        m_name = name; // Warning
+    }
+
+    QString m_name;
+    QStringList m_tags;
+    QString m_title;
+    QString m_caption;
+};
+
+void test(bool cond)
+{
+    QString s = QStringLiteral("foo");
+    takeString(s); // Warning
+
+    std::vector<int> values = { 1, 2, 3 };
+    takeVector(values); // Warning
+
+    QString used = QStringLiteral("bar");
+    takeString(used); // OK, used afterwards
+    takeRef(used);
+
+    QString twice = QStringLiteral("bar");
+    takeString(twice); // OK
+    takeString(twice); // Warning
+
+    QVector<int> vec;
+    QVector<int> copy;
+    copy = vec; // Warning
+    copy.append(1);
+
+    const QString constStr = QStringLiteral("const");
+    takeString(constStr); // OK, can't move a const
+
+    QSharedPointer<int> ptr(new int(1));
+    takePointer(ptr); // Warning
+
+    int i = 0;
+    int j = i; // OK, not a candidate type
+    (void)j;
+}
+
+void loops(const QStringList &list)
+{
+    QString outside;
+    for (int i = 0; i < 10; ++i)
+        takeString(outside); // OK, copied again on the next iteration
+
+    for (QString s : list)
+        takeString(s); // Warning
+
+    for (const QString &str : list) {
+        QString inner = str;
+        takeString(inner); // Warning
+    }
+}
+
+QString returned()
+{
+    QString s;
+    QString t = s; // OK, s is returned
+    takeString(t); // Warning
+    return s; // OK, NRVO
+}
+
+void escapes()
+{
+    QString s;
+    QString &ref = s;
+    takeString(s); // OK, ref is used afterwards
+    ref.clear();
+
+    QString s2;
+    auto lambda = [&s2] { s2.clear(); };
+    takeString(s2); // OK, captured by reference
+    lambda();
+
+    QString s3;
+    auto lambda2 = [s3] { takeString(s3); }; // OK, a capture
+    lambda2();
+
+    QString s4;
+    takeString(s4 + s4); // OK, not a copy
+
+    QString s5;
+    takeString(s5); // OK, the address is taken
+    QString *p = &s5;
+    p->clear();
+}
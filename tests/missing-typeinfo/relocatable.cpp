@@ -0,0 +1,67 @@
+#include <QtCore/QList>
+#include <QtCore/QVector>
+#include <QtCore/QQueue>
+#include <QtCore/QStack>
+#include <QtCore/QVarLengthArray>
+#include <QtCore/QString>
+#include <string>
+
+struct Trivial {
+    int v;
+};
+
+struct Named {
+    QString name;
+    int *p;
+};
+
+struct OneString {
+    QString name;
+};
+
+struct Nested {
+    QString names[2];
+    Named named;
+};
+
+struct WithStdString {
+    std::string s;
+};
+
+struct SelfTracking {
+    SelfTracking();
+    SelfTracking(const SelfTracking &);
+    QString s;
+};
+
+struct Polymorphic {
+    virtual ~Polymorphic();
+    QString s;
+};
+
+struct Declared {
+    QString s;
+};
+Q_DECLARE_TYPEINFO(Declared, Q_MOVABLE_TYPE);
+
+struct HoldsDeclared {
+    Declared d;
+    double x;
+};
+
+void test()
+{
+    QQueue<Trivial> q; // Warning
+    QStack<Trivial> s; // Warning
+    QVarLengthArray<Trivial, 4> a; // Warning
+
+    QVector<Named> v1; // Warning
+    QList<Named> l1; // OK, too big to be stored inline anyway
+    QList<OneString> l2; // Warning
+    QVector<Nested> v2; // Warning
+    QVector<WithStdString> v3; // OK
+    QVector<SelfTracking> v4; // OK
+    QVector<Polymorphic> v5; // OK
+    QVector<Declared> v6; // OK
+    QVector<HoldsDeclared> v7; // Warning
+}
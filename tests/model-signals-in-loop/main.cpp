@@ -0,0 +1,81 @@
+#include <QtCore/QAbstractListModel>
+#include <QtCore/QModelIndex>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+class MyModel : public QAbstractListModel
+{
+public:
+    int rowCount(const QModelIndex &) const override { return m_items.size(); }
+    QVariant data(const QModelIndex &, int) const override { return QVariant(); }
+
+    void append(const QVector<QString> &items)
+    {
+        for (const QString &item : items) {
+            const int row = m_items.size();
+            beginInsertRows(QModelIndex(), row, row); // Warning
+            m_items.append(item);
+            endInsertRows();
+        }
+    }
+
+    void appendBatched(const QVector<QString> &items)
+    {
+        beginInsertRows(QModelIndex(), m_items.size(), m_items.size() + items.size() - 1); // OK
+        for (const QString &item : items)
+            m_items.append(item);
+        endInsertRows();
+    }
+
+    void removeOdd()
+    {
+        for (int i = m_items.size() - 1; i >= 0; --i) {
+            if (i % 2 == 1) {
+                beginRemoveRows(QModelIndex(), i, i); // Warning
+                m_items.removeAt(i);
+                endRemoveRows();
+            }
+        }
+    }
+
+    void touchAll()
+    {
+        for (int i = 0; i < m_items.size(); ++i) {
+            m_items[i] += QLatin1Char('!');
+            emit dataChanged(index(i), index(i)); // Warning
+        }
+    }
+
+    void touchAllBatched()
+    {
+        for (int i = 0; i < m_items.size(); ++i)
+            m_items[i] += QLatin1Char('!');
+        emit dataChanged(index(0), index(m_items.size() - 1)); // OK
+    }
+
+    void touchWhile()
+    {
+        int i = 0;
+        while (i < m_items.size()) {
+            emit dataChanged(index(i), index(i)); // Warning
+            ++i;
+        }
+    }
+
+    void insertIntoParents(const QVector<QModelIndex> &parents)
+    {
+        for (const QModelIndex &parent : parents) {
+            beginInsertRows(parent, 0, 0); // OK, a different parent each time
+            endInsertRows();
+        }
+    }
+
+    void retry()
+    {
+        for (int attempt = 0; attempt < 3; ++attempt) {
+            emit dataChanged(index(0), index(m_items.size() - 1)); // OK, the same range each time
+        }
+    }
+
+    QVector<QString> m_items;
+};
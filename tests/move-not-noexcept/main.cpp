@@ -0,0 +1,74 @@
+#include <QtCore/QString>
+#include <QtCore/QVector>
+#include <utility>
+#include <vector>
+
+struct Simple
+{
+    Simple() = default;
+    Simple(Simple &&other) // Warning, fixit
+        : m_name(std::move(other.m_name))
+        , m_id(other.m_id)
+    {
+    }
+    Simple &operator=(Simple &&other); // Warning, fixit
+    Simple(const Simple &) = default;
+    Simple &operator=(const Simple &) = default;
+
+    QString m_name;
+    int m_id = 0;
+};
+
+Simple &Simple::operator=(Simple &&other)
+{
+    m_name = std::move(other.m_name);
+    m_id = std::exchange(other.m_id, 0);
+    return *this;
+}
+
+struct Allocating
+{
+    Allocating() = default;
+    Allocating(Allocating &&other) // Warning, but no fixit as it allocates
+        : m_data(new int(*other.m_data))
+    {
+    }
+    ~Allocating() { delete m_data; }
+
+    int *m_data = nullptr;
+};
+
+struct AlreadyNoexcept
+{
+    AlreadyNoexcept() = default;
+    AlreadyNoexcept(AlreadyNoexcept &&) noexcept {} // OK
+};
+
+struct Defaulted
+{
+    Defaulted(Defaulted &&) = default; // OK, noexcept when it can be
+    QString m_name;
+};
+
+struct NotStored
+{
+    NotStored(NotStored &&) {} // OK, not stored in a container
+};
+
+struct Declared
+{
+    Declared(Declared &&); // Warning, defined elsewhere so no fixit
+};
+
+class Holder
+{
+    QVector<Simple> m_simple;
+    std::vector<AlreadyNoexcept> m_alreadyNoexcept;
+    std::vector<Defaulted> m_defaulted;
+    QVector<Declared> m_declared;
+};
+
+void test()
+{
+    std::vector<Allocating> v;
+}
@@ -0,0 +1,48 @@
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QHash>
+#include <QtCore/QRegularExpression>
+
+struct Allocating
+{
+    Allocating() : m_data(new int[10]) {}
+    ~Allocating() { delete [] m_data; }
+    int *m_data;
+};
+
+struct Cheap
+{
+    Cheap() {}
+    ~Cheap() {}
+};
+
+static QString s1 = "foo"; // Warning
+static QString s2; // Warning
+static QString s3 = QStringLiteral("foo"); // Warning
+static QRegularExpression re(QStringLiteral("^\\d+$")); // Warning
+static QStringList list = { QStringLiteral("a"), QStringLiteral("b") }; // Warning
+static QHash<int, int> hash = { { 1, 2 } }; // Warning, no fixit because of the comma
+static Allocating allocating; // Warning
+static Cheap cheap; // Warning
+static const QString constString = QStringLiteral("foo"); // Warning, no fixit
+static QString a, b; // Warning x2, no fixit
+
+namespace ns {
+    static QString s4("bar"); // Warning
+}
+
+int use()
+{
+    s1.append(s2);
+    QString copy = s1 + s3;
+    list << copy;
+    re.match(s1);
+    ns::s4.clear();
+    return s2.size() + allocating.m_data[0] + hash.value(1) + constString.size() + a.size() + b.size();
+}
+
+void useCheap(const Cheap &c);
+void useCheap2()
+{
+    useCheap(cheap);
+}
@@ -0,0 +1,43 @@
+#include <QtCore/QDateTime>
+#include <QtCore/QFileInfo>
+
+void work();
+
+void testElapsed()
+{
+    const QDateTime start = QDateTime::currentDateTime();
+    work();
+    qint64 ms = start.msecsTo(QDateTime::currentDateTime()); // Warning
+
+    const QDateTime startUtc = QDateTime::currentDateTimeUtc();
+    const QDateTime end = QDateTime::currentDateTimeUtc();
+    ms = startUtc.secsTo(end); // Warning
+
+    const qint64 startMs = QDateTime::currentMSecsSinceEpoch();
+    work();
+    ms = QDateTime::currentMSecsSinceEpoch() - startMs; // Warning
+}
+
+void testOk(const QFileInfo &info, const QDateTime &other)
+{
+    qint64 age = info.lastModified().secsTo(QDateTime::currentDateTime()); // OK, not measuring
+    age = other.msecsTo(QDateTime::currentDateTime()); // OK
+    age = QDateTime::currentMSecsSinceEpoch() - other.toMSecsSinceEpoch(); // OK
+    if (QDateTime::currentDateTime() > other) // OK, not a loop
+        work();
+}
+
+void testPolling(const QDateTime &deadline, qint64 deadlineMs)
+{
+    while (QDateTime::currentDateTime() < deadline) // Warning
+        work();
+
+    for (int i = 0; QDateTime::currentMSecsSinceEpoch() < deadlineMs; ++i) // Warning
+        work();
+
+    const QDateTime now = QDateTime::currentDateTime();
+    for (int i = 0; i < 10; ++i) {
+        if (now > deadline) // OK, doesn't poll
+            break;
+    }
+}
@@ -0,0 +1,37 @@
+#include <QtCore/QDebug>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QStringList>
+#include <QtWidgets/QWidget>
+
+Q_LOGGING_CATEGORY(lcTest, "test")
+
+void loops(const QStringList &list)
+{
+    qDebug() << "start"; // OK
+    for (const QString &s : list) {
+        qDebug() << s; // Warning
+        qInfo("%s", qPrintable(s)); // Warning
+        qCDebug(lcTest) << s; // OK
+        qWarning() << s; // OK
+        if (lcTest().isDebugEnabled())
+            qDebug() << s; // OK
+    }
+
+    int i = 0;
+    while (i++ < 10)
+        qDebug("%d", i); // Warning
+}
+
+class Widget : public QWidget
+{
+protected:
+    void paintEvent(QPaintEvent *) override
+    {
+        qDebug() << "painting"; // Warning
+    }
+
+    void showEvent(QShowEvent *) override
+    {
+        qDebug() << "shown"; // OK
+    }
+};
@@ -0,0 +1,91 @@
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <functional>
+#include <string>
+#include <vector>
+
+struct Key
+{
+    QString name;
+    int id;
+};
+
+uint qHash(const Key &key, uint seed = 0)
+{
+    return qHash(key.name + QString::number(key.id), seed); // Warning
+}
+
+struct CaseInsensitiveKey
+{
+    QString name;
+};
+
+uint qHash(const CaseInsensitiveKey &key)
+{
+    return qHash(key.name.toLower()); // Warning
+}
+
+struct ListKey
+{
+    QStringList parts;
+};
+
+uint qHash(const ListKey &key)
+{
+    const QStringList parts = key.parts; // OK, implicitly shared
+    return qHash(parts.join(QLatin1Char('/'))); // Warning
+}
+
+struct GoodKey
+{
+    QString name;
+    int id;
+};
+
+uint qHash(const GoodKey &key, uint seed = 0)
+{
+    return qHash(key.name, seed) ^ qHash(key.id, seed); // OK
+}
+
+struct StdKey
+{
+    std::string name;
+    int id;
+};
+
+namespace std {
+template <>
+struct hash<StdKey>
+{
+    size_t operator()(const StdKey &key) const
+    {
+        return std::hash<std::string>()(key.name + std::to_string(key.id)); // Warning
+    }
+};
+}
+
+struct VectorKey
+{
+    std::vector<int> values;
+};
+
+struct VectorKeyHasher
+{
+    size_t operator()(const VectorKey &key) const
+    {
+        const std::vector<int> values = key.values; // Warning
+        size_t result = 0;
+        for (int value : values)
+            result ^= std::hash<int>()(value);
+        return result;
+    }
+};
+
+struct NotAHash
+{
+    size_t operator()(const StdKey &key) const
+    {
+        return (key.name + "x").size(); // OK, not a hash functor
+    }
+};
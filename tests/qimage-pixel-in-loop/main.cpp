@@ -0,0 +1,50 @@
+#include <QtGui/QImage>
+#include <QtGui/QColor>
+
+void grayscale(QImage &image)
+{
+    for (int y = 0; y < image.height(); ++y) {
+        for (int x = 0; x < image.width(); ++x) {
+            const QRgb rgb = image.pixel(x, y); // Warning
+            image.setPixel(x, y, qGray(rgb)); // Warning
+        }
+    }
+}
+
+int countOpaque(const QImage &image)
+{
+    int count = 0;
+    int y = 0;
+    while (y < image.height()) {
+        for (int x = 0; x < image.width(); ++x) {
+            if (image.pixelColor(x, y).alpha() == 255) // Warning
+                ++count;
+        }
+        ++y;
+    }
+    return count;
+}
+
+void fill(QImage *image, const QColor &color)
+{
+    for (int y = 0; y < image->height(); ++y)
+        for (int x = 0; x < image->width(); ++x)
+            image->setPixelColor(x, y, color); // Warning
+}
+
+void singleLoop(QImage &image)
+{
+    for (int x = 0; x < image.width(); ++x)
+        image.setPixel(x, 0, 0); // OK, a single row
+
+    image.pixel(0, 0); // OK
+}
+
+void scanLines(QImage &image)
+{
+    for (int y = 0; y < image.height(); ++y) {
+        QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+        for (int x = 0; x < image.width(); ++x)
+            line[x] = qGray(line[x]); // OK
+    }
+}
@@ -0,0 +1,70 @@
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+#include <QtCore/QVector>
+#include <QtCore/QString>
+
+class Item : public QObject
+{
+public:
+    explicit Item(QObject *parent = nullptr) : QObject(parent) {}
+    void changed() {}
+};
+
+void handler() {}
+
+struct NotQObject {};
+
+void createMany(const QVector<QString> &names, QObject *parent)
+{
+    for (const QString &name : names) {
+        auto item = new Item(parent); // Warning
+        item->setObjectName(name);
+        QObject::connect(item, &QObject::destroyed, parent, &handler); // Warning
+    }
+
+    for (int i = 0; i < names.size(); ++i) {
+        QTimer timer; // Warning
+        timer.start(i);
+        auto s = new NotQObject(); // OK
+        delete s;
+    }
+
+    int i = 0;
+    while (i++ < 100)
+        new QTimer(parent); // Warning
+}
+
+void createFew(QObject *parent)
+{
+    for (int i = 0; i < 3; ++i)
+        new Item(parent); // OK
+
+    for (int i = 4; i > 0; --i)
+        new Item(parent); // OK
+
+    for (QObject *receiver : { parent, parent->parent() })
+        QObject::connect(receiver, &QObject::destroyed, parent, &handler); // OK
+
+    QObject *receivers[2] = { parent, parent };
+    for (QObject *receiver : receivers)
+        new Item(receiver); // OK
+}
+
+void lambdas(const QVector<QObject*> &objects, QObject *parent)
+{
+    for (QObject *o : objects) {
+        // The lambda runs when the object is destroyed, not on every iteration
+        QObject::connect(o, &QObject::destroyed, parent, [parent] { new Item(parent); }); // Warning
+    }
+
+    auto createOne = [parent] { return new Item(parent); }; // OK
+    createOne();
+}
+
+void nested(const QVector<QObject*> &objects)
+{
+    for (QObject *o : objects) {
+        for (int i = 0; i < 2; ++i)
+            new Item(o); // Warning
+    }
+}
@@ -0,0 +1,93 @@
+#include <QtCore/QObject>
+#include <QtCore/QHash>
+#include <QtCore/QStringList>
+#include <QtCore/QVariant>
+#include <vector>
+#include <map>
+
+class Library : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QVariantList books READ books CONSTANT)
+    Q_PROPERTY(QVariantList cachedBooks READ cachedBooks CONSTANT)
+    Q_PROPERTY(QStringList titles READ titles CONSTANT)
+    Q_PROPERTY(QStringList names READ names CONSTANT)
+    Q_PROPERTY(QList<QObject*> children READ childObjects CONSTANT)
+    Q_PROPERTY(std::vector<int> ids READ ids CONSTANT)
+    Q_PROPERTY(std::vector<int> ids2 READ idsRef CONSTANT)
+    Q_PROPERTY(QStringList defaults READ defaults CONSTANT)
+    Q_PROPERTY(QStringList empty READ empty CONSTANT)
+    Q_PROPERTY(QStringList copied READ copied CONSTANT)
+public:
+    QVariantList books() const
+    {
+        QVariantList list;
+        for (int i = 0; i < 10; ++i)
+            list << i;
+        return list; // Warning
+    }
+
+    QVariantList cachedBooks() const
+    {
+        return m_books; // OK
+    }
+
+    QStringList titles() const
+    {
+        return m_titles.keys(); // Warning
+    }
+
+    QStringList names() const;
+
+    QList<QObject*> childObjects() const
+    {
+        return findChildren<QObject*>(); // Warning
+    }
+
+    std::vector<int> ids() const; // Warning
+    const std::vector<int> &idsRef() const; // OK
+
+    QStringList defaults() const
+    {
+        return { QStringLiteral("a"), QStringLiteral("b") }; // Warning
+    }
+
+    QStringList empty() const
+    {
+        return {}; // OK
+    }
+
+    QStringList copied() const
+    {
+        QStringList copy = m_names;
+        return copy; // OK
+    }
+
+    QStringList notAProperty() const
+    {
+        return m_titles.keys(); // OK
+    }
+
+private:
+    QVariantList m_books;
+    QHash<QString, int> m_titles;
+    QStringList m_names;
+    std::vector<int> m_ids;
+};
+
+QStringList Library::names() const
+{
+    QStringList result = m_names;
+    result.sort();
+    return result; // Warning
+}
+
+std::vector<int> Library::ids() const
+{
+    return m_ids;
+}
+
+const std::vector<int> &Library::idsRef() const
+{
+    return m_ids;
+}
@@ -0,0 +1,14 @@
+#include <QtCore/QString>
+
+void test(const QString &a, const QString &b, int n)
+{
+    QString s = QString("%1 %2").arg(a).arg(b); // Warning
+    s = QStringLiteral("Hello %1!").arg(a); // Warning
+    s = QString(QLatin1String("%2/%1")).arg(a, b); // Warning
+    s = QString("\"%1\"").arg(a); // Warning
+    s = QString("%1").arg(a); // Warning
+    s = QString("%1: %2").arg(a).arg(n); // OK, n is an int
+    s = QString("%1%1").arg(a); // OK, a is used twice
+    s = QString("%1 %2").arg(a, 5).arg(b); // OK, field width
+    s = QString("%1 %L2").arg(a).arg(b); // Warning, it's localized, so only multi-arg is suggested
+}
@@ -0,0 +1,11 @@
+#include <QtCore/QString>
+
+QString name();
+
+void test(const QString &a, const QString &b, const QString &c, const char *str)
+{
+    QString s = QString("%1 %2").arg(a).arg(b); // Warning, becomes .arg(a, b)
+    s = QString("%1 %2 %3").arg(a).arg(b).arg(name()); // Warning, becomes .arg(a, b, name())
+    s = QString("%1 %2 %3 %4").arg(a, b).arg(c).arg(s); // Warning, becomes .arg(a, b, c, s)
+    s = QString("%1 %2").arg(a).arg(str); // Warning, no fixit, str isn't a QString
+}
@@ -1,4 +1,10 @@
 #include <QtCore/QString>
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QStringList>
+#include <algorithm>
+#include <cctype>
+#include <string>
 
 void test()
 {
@@ -10,3 +16,42 @@ void test()
     s.compare("bar", Qt::CaseInsensitive); // OK
     s.contains("bar", Qt::CaseInsensitive); // OK
 }
+
+bool comparisons(const QString &s, const QString &other, const QByteArray &ba)
+{
+    if (s.toLower() == other) // Warning
+        return true;
+    if (other != s.toUpper()) // Warning
+        return true;
+    if (ba.toLower() == "foo") // Warning
+        return true;
+    if (ba.toLower().compare("foo") == 0) // Warning
+        return true;
+    if (ba.toLower().startsWith("foo")) // OK, no case insensitive alternative
+        return true;
+    return s.toLower().size() == other.size(); // OK
+}
+
+void keys(const QStringList &names, const QString &key, QHash<QString, int> &hash)
+{
+    for (const QString &name : names) {
+        hash[key.toLower()] += name.size(); // Warning
+        if (hash.contains(key.toUpper())) // Warning
+            continue;
+        hash[name.toLower()]++; // OK, changes on each iteration
+        hash.insert(key.toLower(), 1); // OK, not a lookup
+    }
+
+    hash[key.toLower()] = 0; // OK, not in a loop
+}
+
+bool stdStrings(const std::string &str, std::string byValue)
+{
+    std::string lower = str;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower); // Warning
+    std::transform(byValue.begin(), byValue.end(), byValue.begin(), [](unsigned char c) { return std::toupper(c); }); // Warning
+
+    std::string built(10, 'a');
+    std::transform(built.begin(), built.end(), built.begin(), ::tolower); // OK, not a copy
+    return lower == byValue;
+}
@@ -0,0 +1,28 @@
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QStringRef>
+#include <QtCore/QStringView>
+
+void test(const QString &s, QString *ptr)
+{
+    bool ok = false;
+    s.mid(1, 1).toInt(&ok); // Warning
+    ptr->left(2).isEmpty(); // Warning
+    QString s2;
+    s2.append(s.mid(1, 1)); // Warning
+    s.midRef(1).toInt(&ok); // Warning
+    const QStringRef ref = s.leftRef(2); // Warning
+    auto ref2 = s.rightRef(2); // Warning
+    s.mid(1); // OK
+}
+
+void testSplit(const QString &s)
+{
+    for (QStringView part : s.split(QLatin1Char(','))) // Warning
+        part.isEmpty();
+    for (const QString &part : s.split(QLatin1Char(','))) // Warning
+        part.isEmpty();
+    const QStringList parts = s.split(QLatin1Char(',')); // OK
+    for (const QString &part : parts) // OK
+        part.isEmpty();
+}
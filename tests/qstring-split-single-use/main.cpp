@@ -0,0 +1,28 @@
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+int test(const QString &str)
+{
+    QString first = str.split(QLatin1Char(',')).first(); // Warning
+    first = str.split(QLatin1Char(',')).at(0); // Warning
+    first = str.split(QLatin1Char(','))[0]; // Warning
+    first = str.split(QLatin1Char(',')).last(); // Warning
+    int n = str.split(QLatin1Char(',')).size(); // Warning
+    n += str.split(QLatin1Char(',')).count(); // Warning
+
+    const QStringList parts = str.split(QLatin1Char(';')); // Warning
+    if (!parts.isEmpty())
+        first = parts.first();
+
+    const QStringList fields = str.split(QLatin1Char(':')); // OK
+    first = fields.at(1);
+    first += fields.at(0);
+
+    const QStringList all = str.split(QLatin1Char('/')); // OK
+    for (const QString &part : all)
+        n += part.size();
+
+    first = str.split(QLatin1Char(',')).at(1); // OK
+    n += str.split(QLatin1Char(',')).count(QStringLiteral("a")); // OK
+    return n + first.size();
+}
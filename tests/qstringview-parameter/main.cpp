@@ -0,0 +1,57 @@
+#include <QtCore/QString>
+#include <QtCore/QHash>
+
+bool isKeyword(const QString &word) // Warning
+{
+    return word == QLatin1String("if") || word.startsWith(QLatin1Char('#'));
+}
+
+bool hasPrefix(const QString &str, const QString &prefix) // Warning
+{
+    return !prefix.isEmpty() && str.startsWith(prefix);
+}
+
+uint hashOf(const QString &str) // Warning
+{
+    return qHash(str);
+}
+
+QString stored;
+void store(const QString &str) // OK
+{
+    if (str != stored)
+        stored = str;
+}
+
+int lengthOf(const QString &str) // OK
+{
+    return str.trimmed().size();
+}
+
+void unused(const QString &) // OK
+{
+}
+
+bool isUnused(const QString &str) // OK, its address is taken
+{
+    return str.isEmpty();
+}
+
+class Foo
+{
+public:
+    virtual bool matches(const QString &name) const // OK
+    {
+        return name == QLatin1String("foo");
+    }
+};
+
+void test()
+{
+    isKeyword("else");
+    isKeyword(QLatin1String("for"));
+    isKeyword(QStringLiteral("while"));
+    hasPrefix(QString(), "--");
+    auto f = &isUnused;
+    f("");
+}
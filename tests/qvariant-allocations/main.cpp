@@ -0,0 +1,51 @@
+#include <QtCore/QAbstractListModel>
+#include <QtCore/QRect>
+#include <QtCore/QSize>
+#include <QtCore/QString>
+#include <QtCore/QVariant>
+#include <QtCore/QVector>
+
+void consume(const QVariant &);
+
+void testLoops(const QVector<QRect> &rects)
+{
+    for (const QRect &r : rects) {
+        consume(QVariant(r)); // Warning
+        consume(QVariant::fromValue(r)); // Warning
+        consume(r.size()); // OK, fits
+        consume(QString()); // OK, fits
+        consume(r.width()); // OK
+    }
+
+    QVariant v;
+    for (int i = 0; i < 10; ++i)
+        v.setValue(QRectF(0, 0, i, i)); // Warning
+
+    consume(QRect()); // OK, not in a loop
+}
+
+class MyModel : public QAbstractListModel
+{
+public:
+    int rowCount(const QModelIndex &) const override { return 10; }
+
+    QVariant data(const QModelIndex &index, int role) const override
+    {
+        if (role == Qt::SizeHintRole)
+            return QSize(10, 10); // OK, fits
+        if (role == Qt::UserRole)
+            return m_rect; // Warning
+        if (role == Qt::UserRole + 1)
+            return m_cached; // OK, copying a QVariant doesn't allocate
+        return QString::number(index.row()); // OK, fits
+    }
+
+    bool setData(const QModelIndex &, const QVariant &value, int) override
+    {
+        consume(QVariant::fromValue(value.toRect())); // Warning
+        return true;
+    }
+
+    QRect m_rect;
+    QVariant m_cached;
+};
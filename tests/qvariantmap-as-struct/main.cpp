@@ -0,0 +1,74 @@
+#include <QtCore/QVariant>
+#include <QtCore/QVariantMap>
+#include <QtCore/QVariantHash>
+#include <QtCore/QAbstractListModel>
+
+QVariantMap makeEntry(const QString &name, int size)
+{
+    QVariantMap entry; // Warning
+    entry[QStringLiteral("name")] = name;
+    entry.insert(QStringLiteral("size"), size);
+    return entry;
+}
+
+QVariantHash makeHash()
+{
+    QVariantHash hash = { { QStringLiteral("name"), 1 }, { QStringLiteral("size"), 2 } }; // Warning
+    return hash;
+}
+
+void readEntry(const QVariantMap &entry)
+{
+    const QString name = entry.value(QStringLiteral("name")).toString();
+    const int size = entry[QStringLiteral("size")].toInt();
+    Q_UNUSED(name);
+    Q_UNUSED(size);
+}
+
+QVariantMap makeUnread()
+{
+    QVariantMap entry; // OK, "color" is never read
+    entry[QStringLiteral("name")] = 1;
+    entry[QStringLiteral("color")] = 2;
+    return entry;
+}
+
+QVariantMap makeDynamic(const QString &key)
+{
+    QVariantMap entry; // OK, not a fixed set of keys
+    entry[QStringLiteral("name")] = 1;
+    entry[key] = 2;
+    return entry;
+}
+
+QVariantMap makeSingle()
+{
+    QVariantMap entry; // OK, only one key
+    entry[QStringLiteral("name")] = 1;
+    return entry;
+}
+
+QVariantList makeAll()
+{
+    QVariantList result;
+    for (int i = 0; i < 10; ++i) {
+        QVariantMap entry; // Warning
+        entry[QStringLiteral("name")] = QString::number(i);
+        entry[QStringLiteral("size")] = i;
+        result.append(entry);
+    }
+    return result;
+}
+
+class Model : public QAbstractListModel
+{
+public:
+    int rowCount(const QModelIndex &) const override { return 0; }
+    QVariant data(const QModelIndex &index, int) const override
+    {
+        QVariantMap entry; // Warning
+        entry[QStringLiteral("name")] = index.row();
+        entry[QStringLiteral("size")] = 1;
+        return entry;
+    }
+};
@@ -0,0 +1,18 @@
+#include <QtCore/QRegularExpression>
+#include <QtCore/QString>
+#include <regex>
+#include <string>
+
+bool test(const QString &str, const std::string &stdStr)
+{
+    QRegularExpression re(QStringLiteral("^\\d+$")); // Warning, becomes static const
+    const QRegularExpression re2(QStringLiteral("[a-z]")); // Warning, becomes static
+    auto re3 = QRegularExpression(QStringLiteral("[A-Z]")); // Warning, becomes static const
+    std::regex r("a+"); // Warning, becomes static const
+
+    QRegularExpression re4(QStringLiteral("foo")); // Warning, no fixit, modified
+    re4.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
+
+    return re.match(str).hasMatch() || re2.match(str).hasMatch() || re3.match(str).hasMatch()
+           || re4.match(str).hasMatch() || std::regex_match(stdStr, r);
+}
@@ -0,0 +1,17 @@
+#include <QtCore/QRegularExpression>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+int test(const QStringList &list)
+{
+    QRegularExpression re(QStringLiteral("^\\d+$")); // OK, not in a loop
+
+    int count = 0;
+    for (const QString &s : list) {
+        QRegularExpression inner(QStringLiteral("^[a-z]+$")); // Warning
+        if (inner.match(s).hasMatch() || re.match(s).hasMatch())
+            count++;
+    }
+
+    return count;
+}
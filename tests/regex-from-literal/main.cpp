@@ -0,0 +1,36 @@
+#include <QtCore/QRegularExpression>
+#include <QtCore/QRegExp>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <regex>
+#include <string>
+
+static const QString s_pattern = QStringLiteral("[a-z]+");
+
+bool test(const QString &str, const QStringList &list, const QString &userPattern)
+{
+    QRegularExpression re(QStringLiteral("^\\d+$")); // Warning
+    QRegularExpression re2("[0-9]", QRegularExpression::CaseInsensitiveOption); // Warning
+    QRegularExpression re3(s_pattern); // OK, no literal
+    QRegularExpression re4(userPattern); // OK
+    QRegularExpression re5(QLatin1String("^") + userPattern); // OK
+    static const QRegularExpression re6(QStringLiteral("foo")); // OK
+    QRegExp rx(QStringLiteral("a*b")); // Warning
+
+    for (const QString &s : list) {
+        if (s.contains(QRegularExpression(QStringLiteral("bar")))) // Warning
+            return true;
+        std::regex r("a+"); // Warning
+        if (std::regex_match(s.toStdString(), r))
+            return true;
+    }
+
+    return re.match(str).hasMatch() || re2.match(str).hasMatch() || rx.indexIn(str) != -1;
+}
+
+static const QRegularExpression s_regex(QStringLiteral("global")); // OK
+
+struct Foo
+{
+    QRegularExpression m_re = QRegularExpression(QStringLiteral("member")); // OK
+};
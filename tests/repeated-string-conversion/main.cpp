@@ -0,0 +1,54 @@
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+#include <string>
+
+void consume(const char *);
+void consume(const char *, int);
+void consume(const QString &);
+void consume(const std::string &);
+void modify(QString &);
+
+void testRoundTrips(const QString &s, const QByteArray &data)
+{
+    consume(QString::fromUtf8(s.toUtf8())); // Warning
+    consume(QString::fromUtf8(s.toUtf8().constData())); // Warning
+    consume(QString::fromStdString(s.toStdString())); // Warning
+    consume(QString::fromLatin1(data).toLatin1().constData()); // Warning
+    consume(QString::fromLatin1(s.toLatin1())); // OK, drops what Latin-1 can't represent
+    consume(QString::fromUtf8(s.toLatin1())); // OK, different encodings
+    consume(s.toUtf8().constData()); // OK
+}
+
+void testSameExpression(const QString &s, const QString &other)
+{
+    consume(s.toUtf8().constData(), s.toUtf8().size()); // Warning
+    consume(s.toUtf8().constData(), other.toUtf8().size()); // OK
+    consume(s.toUtf8().constData(), s.toLatin1().size()); // OK
+}
+
+void testLoops(const QString &s, const QByteArray &data, const QVector<QString> &list)
+{
+    for (int i = 0; i < 10; ++i)
+        consume(s.toStdString()); // Warning
+
+    for (int i = 0; i < 10; ++i)
+        consume(QString::fromUtf8(data)); // Warning
+
+    for (const QString &item : list)
+        consume(item.toUtf8().constData()); // OK, a different string each time
+
+    QString str = s;
+    for (int i = 0; i < 10; ++i) {
+        consume(str.toUtf8().constData()); // OK, modified below
+        str += QLatin1Char('a');
+    }
+
+    QString str2 = s;
+    for (int i = 0; i < 10; ++i) {
+        consume(str2.toUtf8().constData()); // OK, modified below
+        modify(str2);
+    }
+
+    consume(s.toUtf8().constData()); // OK, not in a loop
+}
@@ -0,0 +1,62 @@
+#include <QtCore/QVector>
+#include <QtCore/QList>
+#include <vector>
+
+void counted_loops(const QVector<int> &input, int n)
+{
+    QVector<int> v1;
+    for (int i = 0; i < 10; ++i)
+        v1.append(i); // Warning, reserve(10)
+
+    QVector<int> v2;
+    for (int i = 0; i < input.size(); ++i)
+        v2 << input[i]; // Warning, reserve(input.size())
+
+    std::vector<int> v3;
+    for (int i = 0; i != n; i++) {
+        v3.push_back(i); // Warning, reserve(2 * n)
+        v3.push_back(-i); // Warning
+    }
+
+    QVector<int> v4;
+    for (int i = 1; i < n; ++i)
+        v4 << i; // Warning, no fixit, doesn't start at 0
+}
+
+void range_loops(const QList<int> &input)
+{
+    QVector<int> v1;
+    for (int i : input)
+        v1.append(i); // Warning, reserve(input.size())
+
+    int array[4] = { 1, 2, 3, 4 };
+    QVector<int> v2;
+    for (int i : array)
+        v2 << i; // Warning, reserve(4)
+}
+
+void if_branches(const QList<int> &input)
+{
+    QVector<int> v1;
+    for (int i : input) {
+        if (i > 0)
+            v1.append(i); // Warning
+        else
+            v1.append(-i);
+    }
+
+    QVector<int> v2;
+    for (int i : input) {
+        if (i > 0)
+            v2.append(i); // OK, not appended unconditionally
+    }
+
+    QVector<int> v3, v4;
+    for (int i : input) {
+        if (i > 0) {
+            v3.append(i); // OK, the else branch appends to another container
+        } else {
+            v4.append(i);
+        }
+    }
+}
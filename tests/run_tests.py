@@ -1,7 +1,7 @@
 #!/usr/bin/env python3
 
 import sys, os, subprocess, string, re, json, threading, multiprocessing, argparse, io
-import shutil
+import shutil, hashlib, tempfile
 from threading import Thread
 from sys import platform as _platform
 import platform
@@ -42,10 +42,12 @@ class Test:
         self.qt4compat = False
         self.only_qt = False
         self.qt_developer = False
+        self.deduplicate_warnings = False
         self.header_filter = ""
         self.ignore_dirs = ""
         self.has_fixits = False
         self.should_run_fixits_test = False
+        self.requires_env = [] # Env variables which must be set for the test to run, like the path of an optional build artifact
 
     def filename(self):
         if len(self.filenames) == 1:
@@ -235,10 +237,14 @@ def load_json(check_name):
                 test.only_qt = t['only_qt']
             if 'qt_developer' in t:
                 test.qt_developer = t['qt_developer']
+            if 'deduplicate_warnings' in t:
+                test.deduplicate_warnings = t['deduplicate_warnings']
             if 'header_filter' in t:
                 test.header_filter = t['header_filter']
             if 'ignore_dirs' in t:
                 test.ignore_dirs = t['ignore_dirs']
+            if 'requires_env' in t:
+                test.requires_env = t['requires_env']
 
             if not test.checks:
                 test.checks.append(test.check.name)
@@ -310,6 +316,9 @@ def clazy_standalone_command(test, qt):
     if test.qt_developer:
         result = " -qt-developer " + result
 
+    if test.deduplicate_warnings:
+        result = " -deduplicate-warnings " + result
+
     if test.header_filter:
         result = " -header-filter " + test.header_filter + " " + result
 
@@ -337,6 +346,9 @@ def clazy_command(qt, test, filename):
     if test.qt_developer:
         result = result + " -Xclang -plugin-arg-clazy -Xclang qt-developer "
 
+    if test.deduplicate_warnings:
+        result = result + " -Xclang -plugin-arg-clazy -Xclang deduplicate-warnings "
+
     if test.link and _platform.startswith('linux'): # Linking on one platform is enough. Won't waste time on macOS and Windows.
         result = result + " " + link_flags()
     else:
@@ -349,9 +361,14 @@ def clazy_command(qt, test, filename):
 
     return result
 
-def dump_ast_command(test):
+def dump_ast_command(test, ast_filename = ""):
+    if ast_filename:
+        return "clang -fsyntax-only -Xclang -ast-dump -fno-color-diagnostics " + ast_filename
     return "clang -std=c++14 -fsyntax-only -Xclang -ast-dump -fno-color-diagnostics -c " + qt_installation(test.qt_major_version).compiler_flags() + " " + test.flags + " " + test.filename()
 
+def emit_ast_command(test, qt, filename, ast_filename):
+    return os.getenv('CLANGXX', 'clang') + " -x c++ -emit-ast -o " + ast_filename + " " + clazy_cpp_args() + qt.compiler_flags() + " " + test.flags + " " + filename
+
 def compiler_name():
     if 'CLAZY_CXX' in os.environ:
         return os.environ['CLAZY_CXX'] # so we can set clazy.bat instead
@@ -366,7 +383,16 @@ parser.add_argument("--no-standalone", action='store_true', help="Don\'t run cla
 parser.add_argument("--no-fixits", action='store_true', help='Don\'t run fixits')
 parser.add_argument("--only-standalone", action='store_true', help='Only run clazy-standalone')
 parser.add_argument("--dump-ast", action='store_true', help='Dump a unit-test AST to file')
+parser.add_argument("--ast-cache", default='', help='Directory where the tests are kept serialized with clang -emit-ast, so clazy-standalone and --dump-ast don\'t parse the Qt headers again')
 parser.add_argument("--exclude", help='Comma separated list of checks to ignore')
+parser.add_argument("-j", "--jobs", type=int, default=multiprocessing.cpu_count(), help='Number of tests to run concurrently. Defaults to the number of CPUs')
+parser.add_argument("--no-cache", action='store_true', help='Run all tests, even those which passed before and didn\'t change')
+parser.add_argument("--perf", action='store_true', help='Instead of comparing the output, time the checks of each test and compare against --perf-baseline')
+parser.add_argument("--perf-baseline", default='perf_baseline.json', help='Baseline of --perf, relative to the tests directory. Defaults to perf_baseline.json')
+parser.add_argument("--save-perf-baseline", action='store_true', help='With --perf, write the times measured to --perf-baseline instead of comparing')
+parser.add_argument("--perf-repeat", type=int, default=5, help='With --perf, runs per test, the fastest one is kept. Defaults to 5')
+parser.add_argument("--perf-threshold", type=float, default=0.25, help='With --perf, relative slowdown considered a regression, unless the baseline has a tolerance for the check. Defaults to 0.25')
+parser.add_argument("--perf-min-ms", type=float, default=2.0, help='With --perf, ignore slowdowns smaller than this, in milliseconds. Defaults to 2')
 parser.add_argument("check_names", nargs='*', help="The name of the check whose unit-tests will be run. Defaults to running all checks.")
 args = parser.parse_args()
 
@@ -383,12 +409,16 @@ _verbose = args.verbose
 _no_standalone = args.no_standalone
 _no_fixits = args.no_fixits
 _only_standalone = args.only_standalone
-_num_threads = multiprocessing.cpu_count()
+_num_threads = max(1, args.jobs)
+_use_cache = not args.no_cache
 _lock = threading.Lock()
 _was_successful = True
 _qt5_installation = find_qt_installation(5, ["QT_SELECT=5 qmake", "qmake-qt5", "qmake"])
 _qt4_installation = find_qt_installation(4, ["QT_SELECT=4 qmake", "qmake-qt4", "qmake"])
 _excluded_checks = args.exclude.split(',') if args.exclude is not None else []
+_perf = args.perf
+_ast_cache = os.path.abspath(args.ast_cache) if args.ast_cache else ''
+_checks_without_ast_support = set() # Checks needing the preprocessor, see ast_file()
 
 #-------------------------------------------------------------------------------
 # utility functions #2
@@ -516,9 +546,9 @@ def patch_fixit_yaml_file(test, is_standalone):
 
     return True
 
-def run_clang_apply_replacements():
+def run_clang_apply_replacements(directory):
     command = os.getenv('CLAZY_CLANG_APPLY_REPLACEMENTS', 'clang-apply-replacements')
-    return run_command(command + ' .')
+    return run_command(command + ' ' + directory)
 
 def cleanup_fixit_files(checks):
     for check in checks:
@@ -558,6 +588,55 @@ def file_contains(filename, text):
     f.close()
     return text in contents
 
+def ast_cache_key(test, qt, filename):
+    # Tests rarely change, but their headers, next to them, and the Qt installation are part of the AST too
+    hasher = hashlib.sha1()
+    for info in [version, os.getenv('CLANGXX', 'clang'), qt.int_version, qt.qmake_header_path, qt.compiler_flags(), clazy_cpp_args(), test.flags, filename]:
+        hasher.update((str(info) + '\n').encode('utf-8'))
+    hash_file(filename, hasher)
+    directory = os.path.dirname(filename) or '.'
+    for name in sorted(os.listdir(directory)):
+        if name.endswith(('.h', '.hpp')):
+            hasher.update(name.encode('utf-8'))
+            hash_file(os.path.join(directory, name), hasher)
+    return hasher.hexdigest()
+
+def ast_file(test, qt, filename):
+    # Returns the test serialized by clang -emit-ast, from --ast-cache, or None if it can't be used
+    if not _ast_cache or test.isScript() or test.must_fail or test.has_fixits or not test.filename():
+        return None
+
+    with _lock:
+        if any(check in _checks_without_ast_support for check in test.checks):
+            return None
+
+    ast_filename = os.path.join(_ast_cache, ast_cache_key(test, qt, filename) + '.ast')
+    if os.path.exists(ast_filename):
+        return ast_filename
+
+    if not os.path.isdir(_ast_cache):
+        try:
+            os.makedirs(_ast_cache)
+        except OSError:
+            pass # Created by another test meanwhile
+
+    # Concurrent tests never see a partial file
+    tmp_filename = ast_filename + '.' + str(os.getpid()) + '-' + str(threading.current_thread().ident)
+    if not run_command(emit_ast_command(test, qt, filename, tmp_filename), tmp_filename + '.out'):
+        remove_files([tmp_filename, tmp_filename + '.out'])
+        return None
+
+    remove_files([tmp_filename + '.out'])
+    os.rename(tmp_filename, ast_filename)
+    return ast_filename
+
+def remove_files(filenames):
+    for filename in filenames:
+        if os.path.exists(filename):
+            os.remove(filename)
+
+_no_ast_support_re = re.compile(r"clazy: (\S+) needs the preprocessor, so it doesn't run on AST files")
+
 def run_unit_test(test, is_standalone):
     if test.check.clazy_standalone_only and not is_standalone:
         return True
@@ -579,6 +658,12 @@ def run_unit_test(test, is_standalone):
             print("Skipping " + test.check.name + " because it is blacklisted for this platform")
         return True
 
+    missing_env = [name for name in test.requires_env if not os.environ.get(name)]
+    if missing_env:
+        if (_verbose):
+            print("Skipping " + test.check.name + " because " + ", ".join(missing_env) + " isn't set")
+        return True
+
     checkname = test.check.name
     filename = checkname + "/" + test.filename()
 
@@ -593,8 +678,9 @@ def run_unit_test(test, is_standalone):
     if is_standalone and test.isScript():
         return True
 
+    ast_filename = ast_file(test, qt, filename) if is_standalone else None
     if is_standalone:
-        cmd_to_run = clazy_standalone_binary() + " " + filename + " " + clazy_standalone_command(test, qt)
+        cmd_to_run = clazy_standalone_binary() + " " + (ast_filename or filename) + " " + clazy_standalone_command(test, qt)
     else:
         cmd_to_run = clazy_command(qt, test, filename)
 
@@ -605,6 +691,17 @@ def run_unit_test(test, is_standalone):
 
     cmd_success = run_command(cmd_to_run, output_file, test.env)
 
+    if ast_filename and not cmd_success:
+        # Checks using the preprocessor don't support AST files. Otherwise a header changed behind our back.
+        with io.open(output_file, 'r', encoding='utf-8') as f:
+            unsupported = _no_ast_support_re.findall(f.read())
+        with _lock:
+            _checks_without_ast_support.update(unsupported)
+        if not unsupported:
+            remove_files([ast_filename])
+        cmd_to_run = clazy_standalone_binary() + " " + filename + " " + clazy_standalone_command(test, qt)
+        cmd_success = run_command(cmd_to_run, output_file, test.env)
+
     if file_contains(output_file, 'Invalid check: '):
         return True
 
@@ -631,95 +728,271 @@ def run_unit_test(test, is_standalone):
 
     return True
 
-def run_unit_tests(tests):
+def run_fixit_test(test, is_standalone):
+    if (is_standalone and _no_standalone) or (not is_standalone and _only_standalone):
+        # Nothing to do
+        return True
+
+    yamlfilename = test.yamlFilename(is_standalone)
+    if not os.path.exists(yamlfilename):
+        print("[FAIL] " + yamlfilename + " is missing!!")
+        return False
+
+    if not patch_fixit_yaml_file(test, is_standalone):
+        print("[FAIL] Could not patch " + yamlfilename)
+        return False
+
+    # clang-apply-replacements applies every .yaml file it finds, so give it a directory with only this one.
+    # That way tests can run their fixits concurrently.
+    yaml_dir = tempfile.mkdtemp(prefix='clazy-fixits-')
+    try:
+        shutil.move(yamlfilename, os.path.join(yaml_dir, os.path.basename(yamlfilename)))
+        if not run_clang_apply_replacements(yaml_dir):
+            return False
+    finally:
+        shutil.rmtree(yaml_dir, ignore_errors=True)
+
+    return compare_fixit_results(test, is_standalone)
+
+def run_test(test):
+    # Runs everything for a test file: clazy, clazy-standalone and then their fixits
     result = True
-    for test in tests:
-        test_result = True
-        if not _only_standalone:
-            test_result = run_unit_test(test, False)
-            result = result and test_result
+    if not _only_standalone:
+        result = run_unit_test(test, False)
 
-        if not _no_standalone:
-            test_result = test_result and run_unit_test(test, True)
-            result = result and test_result
+    if not _no_standalone:
+        result = result and run_unit_test(test, True)
 
-        if not test_result:
-            test.removeYamlFiles()
+    if result and not _no_fixits and test.should_run_fixits_test:
+        result = run_fixit_test(test, is_standalone=False)
+        result = run_fixit_test(test, is_standalone=True) and result
 
-    global _was_successful, _lock
-    with _lock:
-        _was_successful = _was_successful and result
+    if not result:
+        test.removeYamlFiles()
 
-def patch_yaml_files(requested_checks, is_standalone):
-    if (is_standalone and _no_standalone) or (not is_standalone and _only_standalone):
-        # Nothing to do
-        return True
+    return result
 
-    success = True
-    for check in requested_checks:
-        for test in check.tests:
-            if test.should_run_fixits_test:
-                yamlfilename = test.yamlFilename(is_standalone)
-                if not os.path.exists(yamlfilename):
-                    print("[FAIL] " + yamlfilename + " is missing!!")
-                    success = False
-                    continue
-                if not patch_fixit_yaml_file(test, is_standalone):
-                    print("[FAIL] Could not patch " + yamlfilename)
-                    success = False
+#-------------------------------------------------------------------------------
+# Caching of passed tests
+
+_cache_filename = '.run_tests_cache.json'
+
+def hash_file(filename, hasher):
+    with open(filename, 'rb') as f:
+        for chunk in iter(lambda: f.read(1 << 20), b''):
+            hasher.update(chunk)
+
+def find_in_paths(name, env_variables):
+    if os.path.isabs(name):
+        return name if os.path.exists(name) else None
+
+    for variable in env_variables:
+        for path in os.environ.get(variable, '').split(os.pathsep):
+            candidate = os.path.join(path, name)
+            if path and os.path.isfile(candidate):
+                return candidate
+    return None
+
+def binaries_hash():
+    # Hash of what runs the tests. Returns None if a binary can't be found, so tests aren't wrongly reused.
+    hasher = hashlib.sha1()
+    for info in [version, _qt5_installation.int_version, _qt5_installation.qmake_header_path,
+                 _qt4_installation.int_version, _qt4_installation.qmake_header_path]:
+        hasher.update((str(info) + '\n').encode('utf-8'))
+
+    binaries = []
+    if not _only_standalone:
+        if 'CLAZY_CXX' in os.environ:
+            binaries.append(find_in_paths(os.environ['CLAZY_CXX'].split()[0], ['PATH']))
+        else:
+            binaries.append(find_in_paths(libraryName(), ['LD_LIBRARY_PATH', 'DYLD_LIBRARY_PATH', 'PATH']))
+    if not _no_standalone:
+        binaries.append(find_in_paths(clazy_standalone_binary().split()[0], ['PATH']))
+
+    for binary in binaries:
+        if not binary:
+            return None
+        hasher.update(binary.encode('utf-8'))
+        hash_file(binary, hasher)
+
+    return hasher.hexdigest()
+
+_generated_suffixes = ('.out', '.result', '.fixed', '.yaml', '.ast')
+
+def check_hash(check, base_hash):
+    # Covers all the check's inputs: sources, headers, config.json and expected files
+    hasher = hashlib.sha1(base_hash.encode('utf-8'))
+    for root, dirs, files in sorted(os.walk(check.name)):
+        dirs.sort()
+        for name in sorted(files):
+            if name.endswith(_generated_suffixes):
+                continue
+            filename = os.path.join(root, name)
+            hasher.update(filename.encode('utf-8'))
+            hash_file(filename, hasher)
+    return hasher.hexdigest()
+
+def test_cache_key(test, check_hashes):
+    # A test's own env comes from its config.json, already hashed. Only look at the env variables affecting clazy.
+    options = [str(_only_standalone), str(_no_standalone), str(_no_fixits)]
+    options += sorted(key + '=' + str(value) for key, value in os.environ.items() if key.startswith('CLAZY') or key == 'CLANGXX')
+    return hashlib.sha1((check_hashes[test.check.name] + '\n'.join(options)).encode('utf-8')).hexdigest()
+
+def load_cache():
+    try:
+        with open(_cache_filename, 'r') as f:
+            return json.load(f)
+    except (IOError, ValueError):
+        return {}
+
+def save_cache(cache):
+    with open(_cache_filename, 'w') as f:
+        json.dump(cache, f, indent=1, sort_keys=True)
+
+#-------------------------------------------------------------------------------
+# Scheduler
+
+def run_tests_concurrently(tests, cache, check_hashes):
+    # Each worker picks the next test file when done, instead of working on a fixed chunk
+    pending = list(reversed(tests))
+    num_skipped = [0]
+
+    def worker():
+        global _was_successful
+        while True:
+            with _lock:
+                if not pending:
+                    return
+                test = pending.pop()
+
+            key = test_cache_key(test, check_hashes) if check_hashes else None
+            test_name = test.relativeFilename()
+            with _lock:
+                if key and cache.get(test_name) == key:
+                    num_skipped[0] += 1
                     continue
-    return success
 
-def compare_fixit_results(test, is_standalone):
+            result = run_test(test)
+            with _lock:
+                _was_successful = _was_successful and result
+                if result and key:
+                    cache[test_name] = key
+                else:
+                    cache.pop(test_name, None)
 
-    if (is_standalone and _no_standalone) or (not is_standalone and _only_standalone):
-        # Nothing to do
-        return True
+    threads = [Thread(target=worker) for _ in range(min(_num_threads, len(tests)))]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
 
-    # Check that the rewritten file is identical to the expected one
-    if not compare_files(False, test.expectedFixedFilename(), test.fixedFilename(is_standalone), test.printableName(is_standalone, True)):
-        return False
+    if num_skipped[0] and _verbose:
+        print("Skipped " + str(num_skipped[0]) + " unchanged tests which passed before. Pass --no-cache to run them.")
 
-    # Some fixed cpp files have an header that was also fixed. Compare it here too.
-    possible_headerfile_expected = test.expectedFixedFilename().replace('.cpp', '.h')
-    if os.path.exists(possible_headerfile_expected):
-        possible_headerfile = test.fixedFilename(is_standalone).replace('.cpp', '.h')
-        if not compare_files(False, possible_headerfile_expected, possible_headerfile, test.printableName(is_standalone, True).replace('.cpp', '.h')):
-            return False
+#-------------------------------------------------------------------------------
+# Performance gate, --perf
 
-    return True
+# A row of the print-stats table, the second column is the total time of the check, in ms
+_stats_row_re = re.compile(r'^    (\S+)\s+([0-9.]+)\s+[0-9.]+\s+[0-9]+\s+[0-9.]+\s+[0-9]+\s+[0-9.]+\s+[0-9.]+\s+[0-9]+\s+[0-9.]+$')
 
-# This is run sequentially, due to races. As clang-apply-replacements just applies all .yaml files it can find.
-# We run a single clang-apply-replacements invocation, which changes all files in the tests/ directory.
-def run_fixit_tests(requested_checks):
+def perf_command(test, is_standalone):
+    # The test's command printing the stats, or None if the test doesn't run in this configuration
+    if test.isScript() or test.must_fail or not test.filename():
+        return None
 
-    success = patch_yaml_files(requested_checks, is_standalone=False)
-    success = patch_yaml_files(requested_checks, is_standalone=True) and success
+    if test.check.clazy_standalone_only and not is_standalone:
+        return None
 
-    # Call clazy-apply-replacements[.exe]
-    if not run_clang_apply_replacements():
-        return False
+    qt = qt_installation(test.qt_major_version)
+    if qt.int_version < test.minimum_qt_version or qt.int_version > test.maximum_qt_version or CLANG_VERSION < test.minimum_clang_version:
+        return None
 
-    # Now compare all the *.fixed files with the *.fixed.expected counterparts
+    if _platform in test.blacklist_platforms:
+        return None
 
-    for check in requested_checks:
-        for test in check.tests:
-            if test.should_run_fixits_test:
-                # Check that the rewritten file is identical to the expected one
-                if not compare_fixit_results(test, is_standalone=False):
-                    success = False
-                    continue
+    filename = test.check.name + "/" + test.filename()
+    if is_standalone:
+        return clazy_standalone_binary() + " " + filename + " -print-stats " + clazy_standalone_command(test, qt)
+    return clazy_command(qt, test, filename) + " -Xclang -plugin-arg-clazy -Xclang print-stats"
+
+def measure_checks_ms(test, cmd):
+    # Only the time inside the checks, parsing the Qt headers would hide their slowdowns in the noise.
+    # Returns the fastest of the runs, or None if the test failed to build.
+    best = None
+    for _ in range(max(1, args.perf_repeat)):
+        output, success = get_command_output(cmd, test.env)
+        if not success:
+            return None
+        total = 0.0
+        for line in output.splitlines():
+            match = _stats_row_re.match(line)
+            if match and match.group(1) != 'check':
+                total += float(match.group(2))
+        best = total if best is None else min(best, total)
+    return best
+
+def run_perf_gate(tests):
+    try:
+        with open(args.perf_baseline, 'r') as f:
+            baseline = json.load(f)
+    except (IOError, ValueError):
+        baseline = {}
+
+    # Checks with noisier tests can have a tolerance of their own in the baseline, for example "tolerances": { "qstring-arg": 0.5 }
+    tolerances = baseline.get('tolerances', {})
+    old_results = baseline.get('results', {})
+    results = {}
+    check_names = {}
+
+    # One at a time, concurrent tests would slow each other down
+    configurations = [is_standalone for is_standalone in (False, True)
+                      if not (is_standalone and _no_standalone) and not (not is_standalone and _only_standalone)]
+    success = True
+    for test in tests:
+        for is_standalone in configurations:
+            cmd = perf_command(test, is_standalone)
+            if not cmd:
+                continue
+            name = test.printableName(is_standalone, False)
+            ms = measure_checks_ms(test, cmd)
+            test.removeYamlFiles()
+            if ms is None:
+                print("[FAIL] " + name + " (Failed to build test)")
+                success = False
+                continue
+            results[name] = round(ms, 3)
+            check_names[name] = test.check.name
+            if _verbose:
+                print("%s: %.3fms" % (name, ms))
+
+    if args.save_perf_baseline:
+        old_results.update(results)
+        with open(args.perf_baseline, 'w') as f:
+            json.dump({ 'tolerances': tolerances, 'results': old_results }, f, indent=1, sort_keys=True)
+        print("Perf baseline written to " + args.perf_baseline)
+        return success
+
+    if not old_results:
+        print("No perf baseline in " + args.perf_baseline + ", create it with --save-perf-baseline")
+        return False
 
-                if not compare_fixit_results(test, is_standalone=True):
-                    success = False
-                    continue
+    for name in sorted(results.keys()):
+        old_ms = old_results.get(name)
+        if old_ms is None:
+            continue
+        tolerance = tolerances.get(check_names[name], args.perf_threshold)
+        ms = results[name]
+        if ms > old_ms * (1 + tolerance) and ms - old_ms > args.perf_min_ms:
+            print("[PERF] %s: %.2fms -> %.2fms, more than %d%% slower" % (name, old_ms, ms, tolerance * 100))
+            success = False
 
     return success
 
 def dump_ast(check):
     for test in check.tests:
         ast_filename = test.filename() + ".ast"
-        run_command(dump_ast_command(test) + " > " + ast_filename)
+        cached_ast = ast_file(test, qt_installation(test.qt_major_version), test.filename()) if test.filename() else None
+        run_command(dump_ast_command(test, cached_ast) + " > " + ast_filename)
         print("Dumped AST to " + os.getcwd() + "/" + ast_filename)
 #-------------------------------------------------------------------------------
 def load_checks(all_check_names):
@@ -759,35 +1032,31 @@ if not requested_check_names:
 requested_checks = list(filter(lambda check: check.name in requested_check_names and check.name not in _excluded_checks, all_checks))
 requested_checks = list(filter(lambda check: check.minimum_clang_version <= CLANG_VERSION, requested_checks))
 
-threads = []
-
 if _dump_ast:
     for check in requested_checks:
         os.chdir(check.name)
         dump_ast(check)
         os.chdir("..")
+elif _perf:
+    tests = [test for check in requested_checks for test in check.tests]
+    _was_successful = run_perf_gate(tests)
 else:
-    cleanup_fixit_files(all_checks) # Remove stale stuff from all checks, as clang-apply-replacements will apply all .yaml files it can find, even checks that werent requested
-    list_of_chunks = [[] for x in range(_num_threads)]  # Each list is a list of Test to be worked on by a thread
-    i = _num_threads
-    for check in requested_checks:
-        for test in check.tests:
-            i = (i + 1) % _num_threads
-            list_of_chunks[i].append(test)
-
-    for tests in list_of_chunks:
-        if not tests:
-            continue
-
-        t = Thread(target=run_unit_tests, args=(tests,))
-        t.start()
-        threads.append(t)
-
-for thread in threads:
-    thread.join()
-
-if not _no_fixits and not run_fixit_tests(requested_checks):
-    _was_successful = False
+    cleanup_fixit_files(all_checks) # Remove stale stuff from all checks
+
+    cache = load_cache() if _use_cache else {}
+    check_hashes = {}
+    base_hash = binaries_hash() if _use_cache else None
+    if base_hash:
+        for check in requested_checks:
+            check_hashes[check.name] = check_hash(check, base_hash)
+    elif _use_cache and _verbose:
+        print("Couldn't find the clazy binaries to hash, not caching test results")
+
+    tests = [test for check in requested_checks for test in check.tests]
+    run_tests_concurrently(tests, cache, check_hashes)
+
+    if check_hashes:
+        save_cache(cache)
 
 if _was_successful:
     print("SUCCESS")
@@ -0,0 +1,29 @@
+#include <QtCore/QObject>
+#include <memory>
+#include <utility>
+#include <vector>
+
+struct Data
+{
+    int value() const { return v; }
+    int v = 0;
+};
+
+int readValue(std::shared_ptr<Data> data) // Warn
+{
+    return data->value();
+}
+
+int loop(const std::vector<std::shared_ptr<Data>> &list)
+{
+    int total = 0;
+    for (auto data : list) // Warn
+        total += data->value();
+    return total;
+}
+
+void lambda(QObject *sender)
+{
+    auto data = std::make_shared<Data>();
+    QObject::connect(sender, &QObject::destroyed, [data] { data->value(); }); // Warn
+}
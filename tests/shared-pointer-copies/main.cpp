@@ -0,0 +1,104 @@
+#include <QtCore/QObject>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QVector>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace QtConcurrent {
+template <typename Functor>
+void run(Functor functor) { functor(); }
+}
+
+struct Data
+{
+    int value() const { return v; }
+    int v = 0;
+};
+
+class Holder : public QObject
+{
+public:
+    void setData(std::shared_ptr<Data> data) // OK, stored
+    {
+        m_data = data;
+    }
+
+    std::shared_ptr<Data> m_data;
+};
+
+int readValue(std::shared_ptr<Data> data) // Warn
+{
+    if (!data)
+        return 0;
+    return data->value() + (*data).value() + data.get()->v;
+}
+
+int readQt(QSharedPointer<Data> data) // Warn
+{
+    return data.isNull() ? 0 : data->value();
+}
+
+void passesOn(std::shared_ptr<Data> data, Holder *holder) // OK, stored by the callee
+{
+    holder->setData(data);
+}
+
+void resets(std::shared_ptr<Data> data) // OK, modified
+{
+    data.reset();
+}
+
+int byRef(const std::shared_ptr<Data> &data) // OK
+{
+    return data->value();
+}
+
+class Base
+{
+public:
+    virtual int virtualRead(std::shared_ptr<Data> data) { return data->value(); } // OK, virtual
+};
+
+int loops(const std::vector<std::shared_ptr<Data>> &list, const QVector<QSharedPointer<Data>> &qtList, Holder *holder)
+{
+    int total = 0;
+    for (auto data : list) // Warn
+        total += data->value();
+    for (QSharedPointer<Data> data : qtList) // Warn
+        total += data->value();
+    for (const auto &data : list) // OK
+        total += data->value();
+    for (auto data : list) // OK, stored
+        holder->setData(data);
+    return total;
+}
+
+void lambdas(QObject *sender, const std::shared_ptr<Data> &ref)
+{
+    auto data = std::make_shared<Data>();
+    QObject::connect(sender, &QObject::destroyed, [data] { data->value(); }); // Warn
+
+    auto data2 = std::make_shared<Data>();
+    QObject::connect(sender, &QObject::destroyed, [data2] { data2->value(); }); // OK, used afterwards
+    data2->value();
+
+    auto data3 = std::make_shared<Data>();
+    QtConcurrent::run([data3] { data3->value(); }); // Warn
+
+    auto data4 = std::make_shared<Data>();
+    QObject::connect(sender, &QObject::destroyed, [=] { data4->value(); }); // Warn, no fixit
+
+    QObject::connect(sender, &QObject::destroyed, [ref] { ref->value(); }); // OK, a reference
+
+    auto data5 = std::make_shared<Data>();
+    QObject::connect(sender, &QObject::destroyed, [data5 = std::move(data5)] { data5->value(); }); // OK, moved
+
+    auto data6 = std::make_shared<Data>();
+    for (int i = 0; i < 2; ++i)
+        QObject::connect(sender, &QObject::destroyed, [data6] { data6->value(); }); // OK, inside a loop
+
+    auto data7 = std::make_shared<Data>();
+    auto lambda = [data7] { data7->value(); }; // OK, not connected
+    lambda();
+}
@@ -0,0 +1,92 @@
+#include <QtCore/QPointF>
+#include <QtCore/QVector>
+#include <vector>
+
+void consume(const QVector<int> &) {}
+QVector<int> produce() { return {}; }
+
+double corners(const QPointF &topLeft, const QPointF &bottomRight)
+{
+    QVector<QPointF> points; // Warning
+    points.append(topLeft);
+    points.append(bottomRight);
+    points << QPointF(topLeft.x(), bottomRight.y());
+
+    std::vector<double> coordinates(3); // Warning
+    coordinates[0] = topLeft.x();
+
+    QVector<int> weights = { 1, 2, 4 }; // Warning
+    int sum = 0;
+    for (int weight : weights)
+        sum += weight;
+
+    QVector<int> squares; // Warning
+    for (int i = 0; i < 4; ++i)
+        squares.push_back(i * i);
+
+    std::vector<int> grid; // Warning
+    for (int row = 0; row < 2; ++row) {
+        for (int column : { 1, 2, 3 })
+            grid.emplace_back(row * column);
+    }
+
+    for (int i = 0; i < 100; ++i) {
+        QVector<int> pair; // Warning
+        pair.append(i);
+        pair.append(i + 1);
+        sum += pair.size();
+    }
+
+    return points.first().x() + coordinates.at(0) + sum + squares.last() + grid.back();
+}
+
+int notCandidates(int n, const QVector<int> &input)
+{
+    QVector<int> unbounded; // OK, the trip count isn't a constant
+    for (int i = 0; i < n; ++i)
+        unbounded.append(i);
+
+    QVector<int> large; // OK, too many elements
+    for (int i = 0; i < 1000; ++i)
+        large.append(i);
+
+    QVector<int> passed; // OK, passed to a function
+    passed.append(1);
+    consume(passed);
+
+    QVector<int> copied = input; // OK, the size isn't known
+    copied.append(1);
+
+    QVector<int> appendsVector; // OK, appends a whole container
+    appendsVector.append(input);
+
+    QVector<int> reserved; // OK, resizes to an unknown size
+    reserved.resize(n);
+
+    QVector<int> fromFunction = produce(); // OK
+
+    QVector<int> empty; // OK, never holds anything
+    if (empty.isEmpty())
+        return 0;
+
+    QVector<int> whileLoop; // OK
+    while (whileLoop.size() < 3)
+        whileLoop.append(1);
+
+    QVector<int> captured; // OK, captured by a lambda
+    captured.append(1);
+    auto lambda = [captured] { return captured.size(); };
+
+    static QVector<int> staticLocal; // OK
+    staticLocal.append(1);
+
+    return unbounded.size() + large.size() + copied.size() + appendsVector.size() + reserved.size()
+           + fromFunction.size() + whileLoop.size() + lambda();
+}
+
+QVector<int> returnsIt()
+{
+    QVector<int> v; // OK
+    v.append(1);
+    return v;
+}
@@ -0,0 +1,82 @@
+#include <QtCore/QCoreApplication>
+#include <QtCore/QSettings>
+#include <QtCore/QStandardPaths>
+#include <QtCore/QFile>
+#include <QtCore/QString>
+#include <QtCore/QTimer>
+#include <fstream>
+
+static QByteArray s_debug = qgetenv("MY_APP_DEBUG"); // Warning
+
+struct Config
+{
+    Config()
+        : path(QStandardPaths::writableLocation(QStandardPaths::ConfigLocation)) // Warning, Config is used by s_config
+    {
+        QFile file(path);
+        file.open(QIODevice::ReadOnly); // Warning
+    }
+
+    QString path;
+};
+
+static Config s_config;
+
+static bool s_verbose = [] {
+    return qEnvironmentVariableIsSet("MY_APP_VERBOSE"); // Warning
+}();
+
+static int s_answer = 42; // OK
+
+class Manager
+{
+public:
+    static Manager *instance()
+    {
+        static Manager manager;
+        return &manager;
+    }
+
+private:
+    Manager()
+    {
+        QSettings settings;
+        m_theme = settings.value(QStringLiteral("theme")).toString(); // Warning
+        std::ifstream stream("manager.txt"); // Warning
+    }
+
+    QString m_theme;
+};
+
+class NotASingleton
+{
+public:
+    NotASingleton()
+    {
+        QSettings settings;
+        m_theme = settings.value(QStringLiteral("theme")).toString(); // OK
+    }
+
+    QString m_theme;
+};
+
+QString lazyTheme()
+{
+    QSettings settings;
+    return settings.value(QStringLiteral("theme")).toString(); // OK
+}
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+    QSettings settings;
+    const bool fullscreen = settings.value(QStringLiteral("fullscreen")).toBool(); // Warning
+    QTimer::singleShot(0, [] {
+        qgetenv("MY_APP_LATER"); // OK, runs in the event loop
+    });
+
+    const int ret = app.exec();
+    settings.setValue(QStringLiteral("fullscreen"), fullscreen);
+    qgetenv("AFTER"); // OK
+    return ret;
+}
@@ -0,0 +1,68 @@
+#include <QtCore/QString>
+#include <functional>
+#include <vector>
+
+void forEachItem(const std::vector<int> &items, const std::function<void(int)> &callback) // Warning
+{
+    for (int item : items)
+        callback(item);
+}
+
+void maybeCall(std::function<void()> callback) // Warning
+{
+    if (callback)
+        callback();
+}
+
+template <typename T>
+void forEachT(const std::vector<T> &items, std::function<void(const T &)> callback) // Warning
+{
+    for (const T &item : items)
+        callback(item);
+}
+
+template <typename Callback>
+void forEachTemplate(const std::vector<int> &items, Callback callback) // OK
+{
+    for (int item : items)
+        callback(item);
+}
+
+std::vector<std::function<void()>> s_callbacks;
+
+void registerCallback(std::function<void()> callback) // OK, stored
+{
+    callback();
+    s_callbacks.push_back(callback);
+}
+
+struct Base
+{
+    virtual ~Base();
+    virtual void visit(const std::function<void(int)> &callback) // OK, virtual
+    {
+        callback(1);
+    }
+};
+
+class Widget
+{
+public:
+    Widget(const QString &a, const QString &b)
+        : m_small([this] { update(); })
+        , m_big([this, a, b] { update(); }) // Warning
+    {
+    }
+
+    void setCallbacks(const QString &a, const QString &b, const QString &c)
+    {
+        m_small = [this, a] { update(); }; // OK, fits
+        m_big = [a, b, c] { }; // Warning
+    }
+
+    void update();
+
+    std::function<void()> m_small;
+    std::function<void()> m_big;
+    std::function<void()> m_default = [this, s = QString(), t = QString()] { update(); }; // Warning
+};
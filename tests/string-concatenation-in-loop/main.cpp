@@ -0,0 +1,47 @@
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <string>
+
+void test(const QStringList &list, QString param)
+{
+    QString s;
+    for (const QString &str : list)
+        s = s + str; // Warning
+
+    QString s2;
+    for (const QString &str : list)
+        s2 += str + QLatin1Char(','); // Warning
+
+    QString s3;
+    for (const QString &str : list)
+        s3 += str; // OK
+
+    QString s4;
+    s4.reserve(100);
+    for (const QString &str : list)
+        s4 += str + QLatin1Char(','); // OK, reserved
+
+    for (const QString &str : list) {
+        QString s5;
+        s5 = s5 + str; // OK, declared inside the loop
+    }
+
+    QString s6;
+    for (const QString &str : list)
+        s6 = str + QLatin1Char(' ') + s6; // Warning, prepending
+
+    for (const QString &str : list)
+        param = param + str; // Warning
+
+    QByteArray ba;
+    for (int i = 0; i < 10; ++i)
+        ba = ba + "x"; // Warning
+
+    std::string stds;
+    for (int i = 0; i < 10; ++i)
+        stds += std::string("a") + "b"; // Warning
+
+    QString s7 = s + s2; // OK, not in a loop
+    s7 = s7 + s; // OK, not in a loop
+}
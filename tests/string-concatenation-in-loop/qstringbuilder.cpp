@@ -0,0 +1,18 @@
+#define QT_USE_QSTRINGBUILDER
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+void test(const QStringList &list)
+{
+    QString s;
+    for (const QString &str : list)
+        s = s + str; // Warning, still copies s
+
+    QString s2;
+    for (const QString &str : list)
+        s2 += str + QLatin1Char(','); // OK, appends a QStringBuilder
+
+    QString s3;
+    for (const QString &str : list)
+        s3 += QString(str + QLatin1Char(',')); // OK, no concatenation
+}
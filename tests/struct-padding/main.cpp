@@ -0,0 +1,69 @@
+#include <QtCore/QVector>
+#include <QtCore/QTypeInfo>
+#include <vector>
+
+struct Padded // Warning
+{
+    char a;
+    double b;
+    char c;
+    int d;
+};
+
+struct Packed // OK, already optimal
+{
+    double b;
+    int d;
+    char a;
+    char c;
+};
+
+struct TailPadding // OK, reordering doesn't help
+{
+    int a;
+    char b;
+};
+
+struct Declared // Warning
+{
+    bool enabled;
+    void *ptr;
+    short id;
+};
+Q_DECLARE_TYPEINFO(Declared, Q_MOVABLE_TYPE);
+
+struct InStdVector // Warning
+{
+    char a;
+    long long b;
+    char c;
+};
+
+struct NotStored // OK, not in a container
+{
+    char a;
+    double b;
+    char c;
+};
+
+struct BitFields // OK, not handled
+{
+    char a;
+    double b;
+    int c : 3;
+};
+
+class Holder
+{
+    QVector<Padded> m_padded;
+    QVector<Packed> m_packed;
+    QVector<TailPadding> m_tail;
+    QVector<BitFields> m_bitFields;
+};
+
+void test()
+{
+    std::vector<InStdVector> v;
+    QVector<Padded> again;
+    NotStored n;
+}
@@ -0,0 +1,23 @@
+#include <QtCore/QVector>
+
+struct Small // OK, smaller than CLAZY_STRUCT_PADDING_MIN_SIZE
+{
+    char a;
+    int b;
+    char c;
+};
+
+struct Big // Warning
+{
+    char a;
+    double b;
+    char c;
+    double d;
+    char e;
+};
+
+void test()
+{
+    QVector<Small> small;
+    QVector<Big> big;
+}
@@ -0,0 +1,40 @@
+#include <QtCore/QVector>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace QtConcurrent {
+template <typename Functor, typename... Args>
+void run(Functor functor, Args... args) { functor(args...); }
+}
+
+struct Settings
+{
+    std::string name;
+    std::vector<int> values;
+};
+
+void process(const std::vector<int> &);
+
+void test(const std::vector<int> &data, const QVector<int> &qdata, const Settings &settings, std::shared_ptr<std::vector<int>> shared)
+{
+    QtConcurrent::run([data] { process(data); }); // Warning
+    QtConcurrent::run([=] { process(settings.values); }); // Warning
+    QtConcurrent::run([qdata] { qdata.size(); }); // OK, implicitly shared
+    QtConcurrent::run([shared] { process(*shared); }); // OK
+    QtConcurrent::run([&data] { process(data); }); // OK, by reference
+
+    std::vector<int> local = data;
+    QtConcurrent::run([local = std::move(local)] { process(local); }); // OK, moved in
+    QtConcurrent::run(process, data); // Warning
+
+    std::thread t([settings] { process(settings.values); }); // Warning
+    t.join();
+
+    std::vector<int> values = data;
+    auto future = std::async(std::launch::async, process, std::move(values)); // OK
+    auto future2 = std::async(std::launch::async, process, data); // Warning
+}
@@ -0,0 +1,82 @@
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVariant>
+#include <QtCore/QMetaMethod>
+
+class Loader : public QObject
+{
+    Q_OBJECT
+public:
+    void load(const QString &fileName, int percent);
+    void loadGuarded(const QString &fileName);
+    void loadEarlyReturn(const QString &fileName);
+    void report(const QStringList &files);
+    void cheap(const QString &fileName, int percent);
+    QString name() const;
+signals:
+    void progress(const QString &message);
+    void percentChanged(int percent);
+    void stateChanged(const QVariantMap &state);
+    void filesChanged(const QStringList &files);
+};
+
+void Loader::load(const QString &fileName, int percent)
+{
+    emit progress("Loading " + fileName); // Warning
+    emit progress(QString::number(percent)); // Warning
+    emit progress(QString("%1%").arg(percent)); // Warning
+    emit stateChanged({ { "file", fileName } }); // Warning
+    emit progress(QVariant(percent).toString()); // Warning
+
+    QVariantMap state;
+    state.insert("file", fileName);
+    state.insert("percent", percent);
+    emit stateChanged(state); // Warning
+}
+
+void Loader::loadGuarded(const QString &fileName)
+{
+    if (isSignalConnected(QMetaMethod::fromSignal(&Loader::progress)))
+        emit progress("Loading " + fileName); // OK
+}
+
+void Loader::loadEarlyReturn(const QString &fileName)
+{
+    if (receivers(SIGNAL(progress(QString))) == 0)
+        return;
+    emit progress("Loading " + fileName); // OK
+}
+
+void Loader::report(const QStringList &files)
+{
+    QStringList sorted = files;
+    sorted.sort();
+    emit filesChanged(sorted); // Warning
+
+    QStringList kept = files;
+    kept.removeDuplicates();
+    emit filesChanged(kept); // OK, still used afterwards
+    kept.clear();
+
+    QString message;
+    for (const QString &file : files) {
+        message += file;
+        emit progress(message); // OK, the next iteration uses it
+    }
+}
+
+void Loader::cheap(const QString &fileName, int percent)
+{
+    emit progress(fileName); // OK
+    emit progress(name()); // OK
+    emit percentChanged(percent * 2); // OK
+    emit progress(QStringLiteral("done")); // OK
+    const QString copy = fileName;
+    emit progress(copy); // OK
+}
+
+void emitOther(Loader *loader, const QString &fileName)
+{
+    emit loader->progress("Loading " + fileName); // OK, can't call isSignalConnected() from here
+}
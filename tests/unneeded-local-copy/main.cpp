@@ -0,0 +1,68 @@
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+#include <vector>
+#include <string>
+
+struct Point
+{
+    int x;
+    int y;
+};
+
+void takesRef(QStringList &list);
+
+class Model
+{
+public:
+    void constMethod() const;
+    void nonConstMethod();
+    const QStringList &names() const { return m_names; }
+    QString title() const { return m_title; }
+private:
+    QStringList m_names;
+    std::vector<std::string> m_values;
+    QString m_title;
+    Point m_point;
+    mutable QString m_cache;
+};
+
+void Model::constMethod() const
+{
+    const QStringList namesCopy = m_names; // Warning
+    const auto values = m_values; // Warning
+    QStringList sorted = m_names; // Warning
+    for (const QString &name : sorted)
+        name.size();
+
+    const QString heading = title(); // OK, returned by value
+    const QStringList viaGetter = names(); // Warning
+    const Point point = m_point; // OK, small and trivial
+    const QString cache = m_cache; // OK, mutable
+
+    QStringList modified = m_names; // OK, modified
+    modified.append(QString());
+    QStringList passed = m_names; // OK, passed by non-const reference
+    takesRef(passed);
+    QStringList iterated = m_names; // OK, iterated by non-const reference
+    for (QString &name : iterated)
+        name.clear();
+    QStringList captured = m_names; // OK, captured by reference
+    auto lambda = [&captured] { captured.clear(); };
+    lambda();
+}
+
+void Model::nonConstMethod()
+{
+    const QStringList names = m_names; // OK, m_names could be modified meanwhile
+    m_names.clear();
+}
+
+void params(const QString &str, const std::vector<std::string> &values, QString byValue)
+{
+    const QString copy = str; // Warning
+    const std::vector<std::string> valuesCopy = values; // Warning
+    const std::string first = values.at(0); // Warning
+    const QString copyOfByValue = byValue; // OK, byValue isn't const
+    const QString fromTemporary = str + str; // OK, not a copy
+}
@@ -0,0 +1,106 @@
+#include <QtCore/QMap>
+#include <QtCore/QString>
+#include <map>
+#include <string>
+
+struct Point
+{
+    int x;
+    int y;
+};
+bool operator<(Point, Point);
+
+void consume(const QMap<int, int> &);
+
+static const QMap<QString, int> s_table = { { "a", 1 }, { "b", 2 } }; // Warning
+QMap<int, int> g_exported; // OK, other translation units might iterate it
+
+namespace {
+QMap<int, QString> s_registry; // Warning
+}
+
+void registerName(int id, const QString &name)
+{
+    s_registry.insert(id, name);
+}
+
+QString nameFor(int id)
+{
+    return s_registry.value(id) + QString::number(s_table.value(QStringLiteral("a"))) + QString::number(g_exported.value(id));
+}
+
+class Cache
+{
+public:
+    Cache();
+    int lookup(const QString &key) const;
+    void add(const QString &key, int value);
+    int firstOrdered() const;
+private:
+    QMap<QString, int> m_values; // Warning
+    QMap<int, QString> m_ordered; // OK, iterated in key order
+    QMap<QString, int> m_names = { { "a", 1 }, { "b", 2 } }; // Warning
+    QMap<Point, int> m_points; // OK, no qHash(Point)
+    std::map<std::string, int> m_std; // Warning
+};
+
+Cache::Cache()
+{
+    m_values.insert(QStringLiteral("x"), 1);
+}
+
+int Cache::lookup(const QString &key) const
+{
+    if (m_values.contains(key))
+        return m_values.value(key);
+
+    return m_names.value(key) + m_points.value(Point{ 1, 2 }) + m_std.at(key.toStdString()) + int(m_std.count("x"));
+}
+
+void Cache::add(const QString &key, int value)
+{
+    m_values[key] = value;
+    m_ordered.insert(value, key);
+    m_std[key.toStdString()] = value;
+}
+
+int Cache::firstOrdered() const
+{
+    return m_ordered.firstKey();
+}
+
+class NotAllDefined
+{
+public:
+    int defined() const { return m_map.value(1); }
+    void elsewhere();
+private:
+    QMap<int, int> m_map; // OK, elsewhere() might iterate it
+};
+
+int locals(const QString &key)
+{
+    QMap<QString, int> counts; // Warning
+    counts[key] = 1;
+    counts.insert(QStringLiteral("b"), 2);
+
+    const QMap<int, int> small = { { 1, 2 }, { 3, 4 } }; // Warning
+
+    QMap<int, int> iterated = { { 1, 2 } }; // OK
+    int sum = 0;
+    for (int v : iterated)
+        sum += v;
+
+    QMap<int, int> passed; // OK
+    passed.insert(1, 1);
+    consume(passed);
+
+    QMap<int, int> bounded; // OK
+    bounded.insert(1, 2);
+    sum += bounded.lowerBound(1).value();
+
+    std::map<int, int> stdLocal; // Warning
+    stdLocal[1] = 2;
+
+    return counts.value(key) + small.value(1) + sum + stdLocal.find(1)->second;
+}
@@ -0,0 +1,104 @@
+#include <QtCore/QVector>
+
+class Shape
+{
+public:
+    virtual ~Shape();
+    virtual double area() const;
+    virtual double perimeter() const;
+    virtual void draw() = 0;
+};
+
+class Circle : public Shape
+{
+public:
+    double area() const override;
+    void draw() override;
+};
+
+class Square : public Shape
+{
+public:
+    double area() const override;
+    double perimeter() const override;
+    void draw() override;
+};
+
+class Triangle final : public Shape
+{
+public:
+    double area() const override;
+    void draw() override;
+};
+
+class Polygon : public Shape
+{
+public:
+    double area() const override;
+    double perimeter() const final;
+    virtual int corners() const;
+    void draw() override;
+    Polygon();
+    ~Polygon();
+};
+
+class Hexagon : public Polygon
+{
+public:
+    int corners() const override;
+};
+
+double total(const QVector<Shape *> &shapes, const QVector<Circle *> &circles, const QVector<Triangle *> &triangles)
+{
+    double sum = 0;
+    for (Shape *shape : shapes)
+        sum += shape->area(); // OK, subclassed
+
+    for (Circle *circle : circles) {
+        sum += circle->area(); // Warning
+        sum += circle->perimeter(); // Warning
+        circle->draw(); // Warning
+        sum += circle->Shape::area(); // OK, qualified
+    }
+
+    for (Triangle *triangle : triangles)
+        sum += triangle->area(); // OK, final
+
+    return sum;
+}
+
+void byValueAndReference(Circle &circle, Circle localCircle, QVector<Polygon *> polygons)
+{
+    for (int i = 0; i < 10; ++i) {
+        circle.area(); // Warning
+        localCircle.area(); // OK, called directly
+    }
+
+    circle.area(); // OK, not in a loop
+
+    for (Polygon *polygon : polygons) {
+        polygon->area(); // Warning
+        polygon->perimeter(); // OK, final
+        polygon->corners(); // OK, overridden
+    }
+}
+
+Polygon::Polygon()
+{
+    int i = 0;
+    while (i < 3)
+        i += corners(); // OK, resolved during construction
+}
+
+Polygon::~Polygon()
+{
+}
+
+int squareCorners(Square *square, int n)
+{
+    int total = 0;
+    do {
+        total += square->perimeter(); // Warning
+    } while (--n);
+    return total;
+}
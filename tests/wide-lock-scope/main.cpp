@@ -0,0 +1,75 @@
+#include <QtCore/QObject>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QFile>
+#include <QtCore/QDebug>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+
+class Worker : public QObject
+{
+    Q_OBJECT
+public:
+    void process();
+    void processNarrow();
+    void processStd();
+    void processDeferred();
+    void processLambda();
+    void update() {}
+Q_SIGNALS:
+    void progress(int);
+private:
+    QMutex m_mutex;
+    std::mutex m_stdMutex;
+    QFile m_log;
+    int m_value = 0;
+    std::function<void()> m_callback;
+};
+
+void Worker::process()
+{
+    QMutexLocker locker(&m_mutex);
+    m_value++;
+    emit progress(m_value); // Warning
+    m_log.write("done"); // Warning
+    if (m_value > 10)
+        qDebug() << "many"; // Warning
+    update(); // OK
+}
+
+void Worker::processNarrow()
+{
+    int value = 0;
+    {
+        QMutexLocker locker(&m_mutex);
+        value = ++m_value;
+    }
+    emit progress(value); // OK
+    m_log.write("done"); // OK
+}
+
+void Worker::processStd()
+{
+    std::lock_guard<std::mutex> guard(m_stdMutex);
+    fprintf(stderr, "processing\n"); // Warning
+}
+
+void Worker::processDeferred()
+{
+    std::unique_lock<std::mutex> lock(m_stdMutex, std::defer_lock);
+    emit progress(0); // OK, not locked yet
+
+    QMutexLocker locker(&m_mutex);
+    const int value = m_value;
+    locker.unlock();
+    emit progress(value); // OK, unlocked
+}
+
+void Worker::processLambda()
+{
+    QMutexLocker locker(&m_mutex);
+    m_callback = [this] {
+        emit progress(m_value); // OK, runs later
+    };
+}